@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class BranchyLoopsBenchmark {
+    private static final int ARRAY_SIZE = 4096;
+
+    private static final byte[] bytes = new byte[ARRAY_SIZE];
+    private static final short[] shorts = new short[ARRAY_SIZE];
+    private static final int[] ints1 = new int[ARRAY_SIZE];
+    private static final int[] ints2 = new int[ARRAY_SIZE];
+    private static final int[] ints3 = new int[ARRAY_SIZE];
+    private static final long[] longs1 = new long[ARRAY_SIZE];
+    private static final long[] longs2 = new long[ARRAY_SIZE];
+
+    static {
+        // Pseudo-random data, so that the branches are unpredictable.
+        int seed = 12345;
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            seed = seed * 1103515245 + 12345;
+            bytes[i] = (byte) (seed >> 16);
+            shorts[i] = (short) (seed >> 8);
+            ints1[i] = seed;
+            ints2[i] = seed >>> 7;
+            longs1[i] = ((long) seed << 16) ^ i;
+            longs2[i] = i;
+        }
+    }
+
+    public static long sink;
+
+    public void timeByteThreshold(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$byteThreshold(bytes, (byte) 17);
+        }
+        sink = bytes[1];
+    }
+
+    public void timeShortClamp(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$shortClamp(shorts);
+        }
+        sink = shorts[1];
+    }
+
+    public void timeIntSelect(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$intSelect(ints1, ints2, ints3);
+        }
+        sink = ints3[1];
+    }
+
+    public void timeIntConditionalSum(int count) {
+        long result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$intConditionalSum(ints1);
+        }
+        sink = result;
+    }
+
+    public void timeIntCount(int count) {
+        long result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$intCount(ints1, ints2);
+        }
+        sink = result;
+    }
+
+    public void timeLongMax(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$longMax(longs1, longs2);
+        }
+        sink = longs2[1];
+    }
+
+    private static void $noinline$byteThreshold(byte[] a, byte threshold) {
+        for (int i = 0; i < a.length; ++i) {
+            if (a[i] < threshold) {
+                a[i] = 0;
+            } else {
+                a[i] = (byte) (a[i] - 1);
+            }
+        }
+    }
+
+    private static void $noinline$shortClamp(short[] a) {
+        for (int i = 0; i < a.length; ++i) {
+            short x = a[i];
+            if (x > 1000) {
+                x = -1000;
+            }
+            a[i] = x;
+        }
+    }
+
+    private static void $noinline$intSelect(int[] a, int[] b, int[] c) {
+        for (int i = 0; i < c.length; ++i) {
+            int x = a[i];
+            int y = b[i];
+            c[i] = (x > y) ? x - y : y + 1;
+        }
+    }
+
+    private static int $noinline$intConditionalSum(int[] a) {
+        int sum = 0;
+        for (int i = 0; i < a.length; ++i) {
+            if (a[i] >= 0) {
+                sum += a[i];
+            }
+        }
+        return sum;
+    }
+
+    private static int $noinline$intCount(int[] a, int[] b) {
+        int count = 0;
+        for (int i = 0; i < a.length; ++i) {
+            if (a[i] != b[i]) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    private static void $noinline$longMax(long[] a, long[] b) {
+        for (int i = 0; i < b.length; ++i) {
+            long x = a[i];
+            long y = b[i];
+            b[i] = (x > y) ? x : y;
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class GcScalingBenchmark {
+    private static final int[] DEFAULT_LIVE_SIZES_MB = { 16, 64, 256 };
+    private static final int GC_ROUNDS = 10;
+    // Approximate size of a Node including its payload.
+    private static final int NODE_SIZE = 64;
+    // Every DROP_INTERVAL'th subtree is dropped before each round.
+    private static final int DROP_INTERVAL = 8;
+
+    static class Node {
+        Node left;
+        Node right;
+        Object payload;
+        int value;
+
+        Node(int value) {
+            this.value = value;
+            this.payload = new int[4];
+        }
+    }
+
+    private static int nextValue;
+
+    // Builds a balanced tree of 'count' nodes. The nodes are allocated depth
+    // first, so the subtrees near the root end up far apart in the heap.
+    private static Node buildTree(int count) {
+        if (count == 0) {
+            return null;
+        }
+        Node node = new Node(nextValue++);
+        int remaining = count - 1;
+        node.left = buildTree(remaining / 2);
+        node.right = buildTree(remaining - remaining / 2);
+        return node;
+    }
+
+    private static Node[] buildForest(long liveBytes) {
+        // Keep the trees shallow to avoid deep recursion when building them.
+        final int nodesPerTree = 1 << 14;
+        int trees = (int) Math.max(1, liveBytes / NODE_SIZE / nodesPerTree);
+        Node[] forest = new Node[trees];
+        for (int i = 0; i < trees; ++i) {
+            forest[i] = buildTree(nodesPerTree);
+        }
+        return forest;
+    }
+
+    private static void refill(Node[] forest, int round) {
+        for (int i = round % DROP_INTERVAL; i < forest.length; i += DROP_INTERVAL) {
+            forest[i].left = buildTree(1 << 13);
+        }
+    }
+
+    private static long measureGcTimeNs(int liveMb) {
+        Node[] forest = buildForest(liveMb * 1024L * 1024L);
+        Runtime.getRuntime().gc();
+        long totalNs = 0;
+        for (int round = 0; round < GC_ROUNDS; ++round) {
+            refill(forest, round);
+            long start = System.nanoTime();
+            Runtime.getRuntime().gc();
+            totalNs += System.nanoTime() - start;
+        }
+        sink = forest;
+        return totalNs / GC_ROUNDS;
+    }
+
+    public static Object sink;
+
+    public static void main(String[] args) {
+        int[] sizes = DEFAULT_LIVE_SIZES_MB;
+        if (args.length > 0) {
+            sizes = new int[args.length];
+            for (int i = 0; i < args.length; ++i) {
+                sizes[i] = Integer.parseInt(args[i]);
+            }
+        }
+        for (int liveMb : sizes) {
+            long timeNs = measureGcTimeNs(liveMb);
+            sink = null;
+            System.out.println("GcScalingBenchmark: " + liveMb + " MB live, average GC time "
+                    + (timeNs / 1000) + " us");
+        }
+    }
+}
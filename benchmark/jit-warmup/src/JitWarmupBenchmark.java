@@ -0,0 +1,370 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class JitWarmupBenchmark {
+    private static final int NUM_KERNELS = 32;
+    private static final int ARRAY_LENGTH = 256;
+    // Number of consecutive rounds within STEADY_STATE_TOLERANCE of the best round seen so far
+    // for the workload to be considered at steady state.
+    private static final int STEADY_STATE_ROUNDS = 20;
+    private static final double STEADY_STATE_TOLERANCE = 1.10;
+    private static final int MAX_ROUNDS = 100000;
+
+    private static final int[] array = new int[ARRAY_LENGTH];
+    static {
+        for (int i = 0; i < ARRAY_LENGTH; ++i) {
+            array[i] = i * 7 + 1;
+        }
+    }
+
+    public static int sink;
+
+    private static int $noinline$kernel00(int[] a) {
+        int s = 0;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] * 3;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel01(int[] a) {
+        int s = 1;
+        for (int i = 0; i < a.length; ++i) {
+            s ^= a[i] + 4;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel02(int[] a) {
+        int s = 2;
+        for (int i = 0; i < a.length; ++i) {
+            s = s * 31 + (a[i] >> 5);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel03(int[] a) {
+        int s = 3;
+        for (int i = 0; i < a.length; ++i) {
+            s -= a[i] | 6;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel04(int[] a) {
+        int s = 4;
+        for (int i = 0; i < a.length; ++i) {
+            s += (a[i] & 7) << 1;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel05(int[] a) {
+        int s = 5;
+        for (int i = 0; i < a.length; ++i) {
+            s = (s << 3) ^ (a[i] * 8);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel06(int[] a) {
+        int s = 6;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] % 10;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel07(int[] a) {
+        int s = 7;
+        for (int i = 0; i < a.length; ++i) {
+            s = Math.max(s, a[i] - 10);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel08(int[] a) {
+        int s = 8;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] * 11;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel09(int[] a) {
+        int s = 9;
+        for (int i = 0; i < a.length; ++i) {
+            s ^= a[i] + 12;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel10(int[] a) {
+        int s = 10;
+        for (int i = 0; i < a.length; ++i) {
+            s = s * 31 + (a[i] >> 5);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel11(int[] a) {
+        int s = 11;
+        for (int i = 0; i < a.length; ++i) {
+            s -= a[i] | 14;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel12(int[] a) {
+        int s = 12;
+        for (int i = 0; i < a.length; ++i) {
+            s += (a[i] & 15) << 1;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel13(int[] a) {
+        int s = 13;
+        for (int i = 0; i < a.length; ++i) {
+            s = (s << 3) ^ (a[i] * 16);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel14(int[] a) {
+        int s = 14;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] % 18;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel15(int[] a) {
+        int s = 15;
+        for (int i = 0; i < a.length; ++i) {
+            s = Math.max(s, a[i] - 18);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel16(int[] a) {
+        int s = 16;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] * 19;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel17(int[] a) {
+        int s = 17;
+        for (int i = 0; i < a.length; ++i) {
+            s ^= a[i] + 20;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel18(int[] a) {
+        int s = 18;
+        for (int i = 0; i < a.length; ++i) {
+            s = s * 31 + (a[i] >> 5);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel19(int[] a) {
+        int s = 19;
+        for (int i = 0; i < a.length; ++i) {
+            s -= a[i] | 22;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel20(int[] a) {
+        int s = 20;
+        for (int i = 0; i < a.length; ++i) {
+            s += (a[i] & 23) << 1;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel21(int[] a) {
+        int s = 21;
+        for (int i = 0; i < a.length; ++i) {
+            s = (s << 3) ^ (a[i] * 24);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel22(int[] a) {
+        int s = 22;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] % 26;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel23(int[] a) {
+        int s = 23;
+        for (int i = 0; i < a.length; ++i) {
+            s = Math.max(s, a[i] - 26);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel24(int[] a) {
+        int s = 24;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] * 27;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel25(int[] a) {
+        int s = 25;
+        for (int i = 0; i < a.length; ++i) {
+            s ^= a[i] + 28;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel26(int[] a) {
+        int s = 26;
+        for (int i = 0; i < a.length; ++i) {
+            s = s * 31 + (a[i] >> 5);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel27(int[] a) {
+        int s = 27;
+        for (int i = 0; i < a.length; ++i) {
+            s -= a[i] | 30;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel28(int[] a) {
+        int s = 28;
+        for (int i = 0; i < a.length; ++i) {
+            s += (a[i] & 31) << 1;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel29(int[] a) {
+        int s = 29;
+        for (int i = 0; i < a.length; ++i) {
+            s = (s << 3) ^ (a[i] * 32);
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel30(int[] a) {
+        int s = 30;
+        for (int i = 0; i < a.length; ++i) {
+            s += a[i] % 34;
+        }
+        return s;
+    }
+
+    private static int $noinline$kernel31(int[] a) {
+        int s = 31;
+        for (int i = 0; i < a.length; ++i) {
+            s = Math.max(s, a[i] - 34);
+        }
+        return s;
+    }
+
+    private static int runKernel(int k, int[] a) {
+        switch (k) {
+            case 0: return $noinline$kernel00(a);
+            case 1: return $noinline$kernel01(a);
+            case 2: return $noinline$kernel02(a);
+            case 3: return $noinline$kernel03(a);
+            case 4: return $noinline$kernel04(a);
+            case 5: return $noinline$kernel05(a);
+            case 6: return $noinline$kernel06(a);
+            case 7: return $noinline$kernel07(a);
+            case 8: return $noinline$kernel08(a);
+            case 9: return $noinline$kernel09(a);
+            case 10: return $noinline$kernel10(a);
+            case 11: return $noinline$kernel11(a);
+            case 12: return $noinline$kernel12(a);
+            case 13: return $noinline$kernel13(a);
+            case 14: return $noinline$kernel14(a);
+            case 15: return $noinline$kernel15(a);
+            case 16: return $noinline$kernel16(a);
+            case 17: return $noinline$kernel17(a);
+            case 18: return $noinline$kernel18(a);
+            case 19: return $noinline$kernel19(a);
+            case 20: return $noinline$kernel20(a);
+            case 21: return $noinline$kernel21(a);
+            case 22: return $noinline$kernel22(a);
+            case 23: return $noinline$kernel23(a);
+            case 24: return $noinline$kernel24(a);
+            case 25: return $noinline$kernel25(a);
+            case 26: return $noinline$kernel26(a);
+            case 27: return $noinline$kernel27(a);
+            case 28: return $noinline$kernel28(a);
+            case 29: return $noinline$kernel29(a);
+            case 30: return $noinline$kernel30(a);
+            case 31: return $noinline$kernel31(a);
+            default: throw new AssertionError();
+        }
+    }
+
+    private static int runRound() {
+        int s = 0;
+        for (int k = 0; k < NUM_KERNELS; ++k) {
+            s += runKernel(k, array);
+        }
+        return s;
+    }
+
+    // Returns the time in nanoseconds until the rounds reach steady state.
+    public static long measureTimeToSteadyState() {
+        long start = System.nanoTime();
+        long best = Long.MAX_VALUE;
+        int stable = 0;
+        for (int round = 0; round < MAX_ROUNDS; ++round) {
+            long roundStart = System.nanoTime();
+            sink += runRound();
+            long roundTime = System.nanoTime() - roundStart;
+            if (roundTime < best) {
+                best = roundTime;
+            }
+            if (roundTime <= best * STEADY_STATE_TOLERANCE) {
+                if (++stable == STEADY_STATE_ROUNDS) {
+                    return System.nanoTime() - start;
+                }
+            } else {
+                stable = 0;
+            }
+        }
+        return System.nanoTime() - start;
+    }
+
+    public void timeSteadyStateRound(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink += runRound();
+        }
+    }
+
+    public static void main(String[] args) {
+        long timeNs = measureTimeToSteadyState();
+        System.out.println("JitWarmupBenchmark: time to steady state " + (timeNs / 1000000) + " ms");
+    }
+}
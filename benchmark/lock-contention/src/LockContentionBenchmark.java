@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.concurrent.atomic.AtomicBoolean;
+
+public class LockContentionBenchmark {
+    private static final int[] THREAD_COUNTS = { 2, 4, 8, 16, 32, 64 };
+    private static final int SHORT_HOLD_ITERATIONS = 20;
+    private static final int LONG_HOLD_ITERATIONS = 20000;
+    private static final int DEFAULT_SECONDS = 2;
+    private static final int DEFAULT_MONITORS = 1;
+
+    static class Counter {
+        long value;
+    }
+
+    static class Worker extends Thread {
+        private final AtomicBoolean stop;
+        private final Counter[] monitors;
+        private final int holdIterations;
+        private final int firstMonitor;
+        long acquisitions;
+
+        Worker(AtomicBoolean stop, Counter[] monitors, int holdIterations, int index) {
+            this.stop = stop;
+            this.monitors = monitors;
+            this.holdIterations = holdIterations;
+            this.firstMonitor = index;  // Spread the workers over the monitors.
+        }
+
+        @Override
+        public void run() {
+            long acquired = 0;
+            int next = firstMonitor;
+            while (!stop.get()) {
+                Counter monitor = monitors[next++ % monitors.length];
+                synchronized (monitor) {
+                    monitor.value = work(monitor.value, holdIterations);
+                }
+                acquired++;
+            }
+            acquisitions = acquired;
+        }
+
+        private static long work(long value, int iterations) {
+            for (int i = 0; i < iterations; ++i) {
+                value = value * 6364136223846793005L + 1442695040888963407L;
+            }
+            return value;
+        }
+    }
+
+    // Runs `threads` workers for `seconds` and returns the number of critical sections per second.
+    private static long run(int threads, int monitorCount, int holdIterations, int seconds)
+            throws InterruptedException {
+        Counter[] monitors = new Counter[monitorCount];
+        for (int i = 0; i < monitorCount; ++i) {
+            monitors[i] = new Counter();
+        }
+        AtomicBoolean stop = new AtomicBoolean(false);
+        Worker[] workers = new Worker[threads];
+        for (int i = 0; i < threads; ++i) {
+            workers[i] = new Worker(stop, monitors, holdIterations, i);
+            workers[i].start();
+        }
+        Thread.sleep(seconds * 1000L);
+        stop.set(true);
+        long acquisitions = 0;
+        for (Worker worker : workers) {
+            worker.join();
+            acquisitions += worker.acquisitions;
+        }
+        return acquisitions / seconds;
+    }
+
+    public static void main(String[] args) throws Exception {
+        int seconds = (args.length > 0) ? Integer.parseInt(args[0]) : DEFAULT_SECONDS;
+        int monitors = (args.length > 1) ? Integer.parseInt(args[1]) : DEFAULT_MONITORS;
+
+        // Warm up so that all measured runs execute compiled code.
+        run(THREAD_COUNTS[0], monitors, SHORT_HOLD_ITERATIONS, 1);
+        run(THREAD_COUNTS[0], monitors, LONG_HOLD_ITERATIONS, 1);
+
+        for (int holdIterations : new int[] { SHORT_HOLD_ITERATIONS, LONG_HOLD_ITERATIONS }) {
+            for (int threads : THREAD_COUNTS) {
+                long throughput = run(threads, monitors, holdIterations, seconds);
+                System.out.println("LockContentionBenchmark: hold=" + holdIterations
+                        + " monitors=" + monitors
+                        + " threads=" + threads
+                        + " acquisitions_per_s=" + throughput);
+            }
+        }
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class MegamorphicDispatchBenchmark {
+    public void timeInterfaceSkewed(int count) {
+        int sum = 0;
+        Shape[] shapes = skewedShapes;
+        for (int i = 0; i < count; ++i) {
+            sum += shapes[i & 1023].area();
+        }
+        result = sum;
+    }
+
+    public void timeInterfaceUniform(int count) {
+        int sum = 0;
+        Shape[] shapes = uniformShapes;
+        for (int i = 0; i < count; ++i) {
+            sum += shapes[i & 1023].area();
+        }
+        result = sum;
+    }
+
+    public void timeVirtualSkewed(int count) {
+        int sum = 0;
+        AbstractShape[] shapes = skewedShapes;
+        for (int i = 0; i < count; ++i) {
+            sum += shapes[i & 1023].perimeter();
+        }
+        result = sum;
+    }
+
+    public void timeVirtualUniform(int count) {
+        int sum = 0;
+        AbstractShape[] shapes = uniformShapes;
+        for (int i = 0; i < count; ++i) {
+            sum += shapes[i & 1023].perimeter();
+        }
+        result = sum;
+    }
+
+    public static void main(String[] args) {
+        MegamorphicDispatchBenchmark benchmark = new MegamorphicDispatchBenchmark();
+        long before = System.currentTimeMillis();
+        benchmark.timeInterfaceSkewed(100000000);
+        benchmark.timeInterfaceUniform(100000000);
+        benchmark.timeVirtualSkewed(100000000);
+        benchmark.timeVirtualUniform(100000000);
+        long after = System.currentTimeMillis();
+        System.out.println("MegamorphicDispatchBenchmark: " + (after - before));
+    }
+
+    interface Shape {
+        int area();
+    }
+
+    abstract static class AbstractShape implements Shape {
+        AbstractShape(int size) {
+            this.size = size;
+        }
+
+        abstract int perimeter();
+
+        final int size;
+    }
+
+    static class Square extends AbstractShape {
+        Square(int size) { super(size); }
+        public int area() { return size * size; }
+        int perimeter() { return 4 * size; }
+    }
+
+    static class Rectangle extends AbstractShape {
+        Rectangle(int size) { super(size); }
+        public int area() { return size * (size + 1); }
+        int perimeter() { return 4 * size + 2; }
+    }
+
+    static class Triangle extends AbstractShape {
+        Triangle(int size) { super(size); }
+        public int area() { return (size * size) >> 1; }
+        int perimeter() { return 3 * size; }
+    }
+
+    static class Hexagon extends AbstractShape {
+        Hexagon(int size) { super(size); }
+        public int area() { return (5 * size * size) >> 1; }
+        int perimeter() { return 6 * size; }
+    }
+
+    static class Octagon extends AbstractShape {
+        Octagon(int size) { super(size); }
+        public int area() { return 5 * size * size; }
+        int perimeter() { return 8 * size; }
+    }
+
+    static class Circle extends AbstractShape {
+        Circle(int size) { super(size); }
+        public int area() { return 3 * size * size; }
+        int perimeter() { return 6 * size; }
+    }
+
+    static class Line extends AbstractShape {
+        Line(int size) { super(size); }
+        public int area() { return 0; }
+        int perimeter() { return 2 * size; }
+    }
+
+    static class Point extends AbstractShape {
+        Point(int size) { super(size); }
+        public int area() { return 0; }
+        int perimeter() { return 0; }
+    }
+
+    static AbstractShape newShape(int kind, int size) {
+        switch (kind) {
+            case 0: return new Square(size);
+            case 1: return new Rectangle(size);
+            case 2: return new Triangle(size);
+            case 3: return new Hexagon(size);
+            case 4: return new Octagon(size);
+            case 5: return new Circle(size);
+            case 6: return new Line(size);
+            default: return new Point(size);
+        }
+    }
+
+    // 90% of the receivers are one of the last two types, the rest is spread over
+    // six other types, so the call sites are megamorphic but dominated by two types.
+    // The array starts with the rare types, so the first receiver types recorded by
+    // the inline caches are not the hot ones.
+    static AbstractShape[] skewedShapes = new AbstractShape[1024];
+    // All eight types are equally likely.
+    static AbstractShape[] uniformShapes = new AbstractShape[1024];
+
+    static {
+        for (int i = 0; i < 1024; ++i) {
+            int bucket = i % 20;
+            int kind = (i < 6 || bucket < 2) ? (i % 6) : 6 + (bucket & 1);
+            skewedShapes[i] = newShape(kind, i & 15);
+            uniformShapes[i] = newShape(i & 7, i & 15);
+        }
+    }
+
+    int result;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+public class RootScanBenchmark {
+    private static final int DEFAULT_THREADS = 32;
+    private static final int DEFAULT_DEPTH = 500;
+    private static final int WARMUP_CALLS = 20000;
+    private static final int GC_ROUNDS = 20;
+
+    static class Worker extends Thread {
+        private final int depth;
+        private final CountDownLatch ready;
+        private final CountDownLatch done;
+
+        Worker(int depth, CountDownLatch ready, CountDownLatch done) {
+            this.depth = depth;
+            this.ready = ready;
+            this.done = done;
+        }
+
+        @Override
+        public void run() {
+            sink = recurse(depth, new Object(), "frame");
+        }
+
+        // Alternate between two methods, so that the stacks hold frames with
+        // a few live references at a couple of different return PCs.
+        Object recurse(int remaining, Object a, String b) {
+            if (remaining == 0) {
+                await();
+                return a;
+            }
+            Object c = new int[1];
+            Object result = recurseOther(remaining - 1, c, b);
+            return (result == a) ? c : result;
+        }
+
+        Object recurseOther(int remaining, Object a, String b) {
+            if (remaining == 0) {
+                await();
+                return a;
+            }
+            Object[] c = { a, b };
+            Object result = recurse(remaining - 1, c, b);
+            return (result == c) ? a : result;
+        }
+
+        private void await() {
+            if (ready == null) {
+                return;  // Warm-up call.
+            }
+            ready.countDown();
+            try {
+                done.await();
+            } catch (InterruptedException e) {
+                throw new Error(e);
+            }
+        }
+    }
+
+    public static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        int threads = (args.length > 0) ? Integer.parseInt(args[0]) : DEFAULT_THREADS;
+        int depth = (args.length > 1) ? Integer.parseInt(args[1]) : DEFAULT_DEPTH;
+
+        // Warm up so that the recursive methods get compiled.
+        Worker warmup = new Worker(1, null, null);
+        for (int i = 0; i < WARMUP_CALLS; ++i) {
+            sink = warmup.recurse(8, warmup, "warmup");
+        }
+
+        CountDownLatch ready = new CountDownLatch(threads);
+        CountDownLatch done = new CountDownLatch(1);
+        Worker[] workers = new Worker[threads];
+        for (int i = 0; i < threads; ++i) {
+            workers[i] = new Worker(depth, ready, done);
+            workers[i].start();
+        }
+        ready.await();
+
+        Runtime.getRuntime().gc();
+        long totalNs = 0;
+        for (int round = 0; round < GC_ROUNDS; ++round) {
+            long start = System.nanoTime();
+            Runtime.getRuntime().gc();
+            totalNs += System.nanoTime() - start;
+        }
+        done.countDown();
+        for (Worker worker : workers) {
+            worker.join();
+        }
+        System.out.println("RootScanBenchmark: threads=" + threads
+                + " depth=" + depth
+                + " average GC time " + (totalNs / GC_ROUNDS / 1000) + " us");
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import dalvik.system.VMDebug;
+
+import java.io.File;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+public class SamplingProfilerBenchmark {
+    private static final int DEFAULT_THREADS = 100;
+    private static final int DEFAULT_INTERVAL_US = 1000;
+    private static final int DEFAULT_SECONDS = 5;
+
+    static class Worker extends Thread {
+        private final AtomicBoolean stop;
+        long iterations;
+        int result;
+
+        Worker(AtomicBoolean stop) {
+            this.stop = stop;
+        }
+
+        @Override
+        public void run() {
+            while (!stop.get()) {
+                result += recurse(8, (int) iterations);
+                iterations++;
+            }
+        }
+
+        // Keep a few frames on the stack so that samples have something to walk.
+        private static int recurse(int depth, int value) {
+            if (depth == 0) {
+                return value * 31 + 7;
+            }
+            return recurse(depth - 1, value + depth) ^ depth;
+        }
+    }
+
+    // Runs `threads` workers for `seconds` and returns the total number of iterations.
+    private static long run(int threads, int seconds) throws InterruptedException {
+        AtomicBoolean stop = new AtomicBoolean(false);
+        Worker[] workers = new Worker[threads];
+        for (int i = 0; i < threads; ++i) {
+            workers[i] = new Worker(stop);
+            workers[i].start();
+        }
+        Thread.sleep(seconds * 1000L);
+        stop.set(true);
+        long iterations = 0;
+        for (Worker worker : workers) {
+            worker.join();
+            iterations += worker.iterations;
+        }
+        return iterations;
+    }
+
+    public static void main(String[] args) throws Exception {
+        int threads = (args.length > 0) ? Integer.parseInt(args[0]) : DEFAULT_THREADS;
+        int intervalUs = (args.length > 1) ? Integer.parseInt(args[1]) : DEFAULT_INTERVAL_US;
+        int seconds = (args.length > 2) ? Integer.parseInt(args[2]) : DEFAULT_SECONDS;
+
+        // Warm up so that both measured runs execute compiled code.
+        run(threads, 1);
+
+        long baseline = run(threads, seconds);
+
+        File traceFile = File.createTempFile("sampling-profiler-benchmark", ".trace");
+        try {
+            VMDebug.startMethodTracing(traceFile.getPath(), 0, 0, true, intervalUs);
+            long sampled;
+            try {
+                sampled = run(threads, seconds);
+            } finally {
+                VMDebug.stopMethodTracing();
+            }
+            double overhead = 100.0 * (baseline - sampled) / baseline;
+            System.out.println("SamplingProfilerBenchmark: threads=" + threads
+                    + " interval_us=" + intervalUs
+                    + " baseline=" + baseline
+                    + " sampled=" + sampled
+                    + " overhead=" + String.format("%.2f", overhead) + "%");
+        } finally {
+            traceFile.delete();
+        }
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class SchedulerLoopsBenchmark {
+    private static final int ARRAY_SIZE = 1024;
+
+    private static final int[] ints = new int[ARRAY_SIZE];
+    private static final long[] longs = new long[ARRAY_SIZE];
+    private static final float[] floats = new float[ARRAY_SIZE];
+    private static final double[] doubles = new double[ARRAY_SIZE];
+
+    static {
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            ints[i] = i * 7 + 1;
+            longs[i] = i * 31L + 3;
+            floats[i] = i * 0.5f + 1.0f;
+            doubles[i] = i * 0.25 + 1.0;
+        }
+    }
+
+    public static int sink;
+
+    // Loads whose results are used right away in the source order.
+    public void timeLoadUse(int count) {
+        int[] a = ints;
+        int result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$loadUse(a);
+        }
+        sink = result;
+    }
+
+    // Several independent read-modify-write sequences on the same array.
+    public void timeArrayUpdate(int count) {
+        int[] a = ints;
+        for (int n = 0; n < count; ++n) {
+            $noinline$arrayUpdate(a, n & 7);
+        }
+        sink = a[0];
+    }
+
+    // An integer division with independent work around it.
+    public void timeIntDiv(int count) {
+        int[] a = ints;
+        int result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$intDiv(a);
+        }
+        sink = result;
+    }
+
+    // 64-bit multiplications, which expand to several instructions on x86.
+    public void timeLongMul(int count) {
+        long[] a = longs;
+        long result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$longMul(a);
+        }
+        sink = (int) result;
+    }
+
+    // Floating point arithmetic mixed with conversions.
+    public void timeFloatMix(int count) {
+        float[] f = floats;
+        double[] d = doubles;
+        double result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$floatMix(f, d);
+        }
+        sink = (int) result;
+    }
+
+    private static int $noinline$loadUse(int[] a) {
+        int sum = 0;
+        for (int i = 0; i < a.length - 1; i += 2) {
+            sum += a[i];
+            sum ^= a[i + 1];
+        }
+        return sum;
+    }
+
+    private static void $noinline$arrayUpdate(int[] a, int i) {
+        for (int j = 0; j < 100; ++j) {
+            a[i + 1]++;
+            a[i + 2]++;
+            a[i + 3]++;
+        }
+    }
+
+    private static int $noinline$intDiv(int[] a) {
+        int sum = 0;
+        int acc = 0;
+        for (int i = 0; i < a.length; ++i) {
+            int x = a[i];
+            sum += sum / x;
+            acc += x * 3;
+            acc ^= i;
+        }
+        return sum + acc;
+    }
+
+    private static long $noinline$longMul(long[] a) {
+        long sum = 0;
+        for (int i = 0; i < a.length; ++i) {
+            long x = a[i];
+            sum += x * x;
+            sum ^= i;
+        }
+        return sum;
+    }
+
+    private static double $noinline$floatMix(float[] f, double[] d) {
+        double sum = 0;
+        for (int i = 0; i < f.length; ++i) {
+            float x = f[i];
+            double y = d[i];
+            sum += (int) (x * 1.5f) + y / 3.0;
+        }
+        return sum;
+    }
+}
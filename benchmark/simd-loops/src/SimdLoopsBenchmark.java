@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class SimdLoopsBenchmark {
+    private static final int ARRAY_SIZE = 4096;
+
+    private static final byte[] bytes1 = new byte[ARRAY_SIZE];
+    private static final byte[] bytes2 = new byte[ARRAY_SIZE];
+    private static final short[] shorts1 = new short[ARRAY_SIZE];
+    private static final short[] shorts2 = new short[ARRAY_SIZE];
+    private static final char[] chars = new char[ARRAY_SIZE];
+    private static final int[] ints1 = new int[ARRAY_SIZE];
+    private static final int[] ints2 = new int[ARRAY_SIZE];
+    private static final long[] longs1 = new long[ARRAY_SIZE];
+    private static final long[] longs2 = new long[ARRAY_SIZE];
+    private static final float[] floats1 = new float[ARRAY_SIZE];
+    private static final float[] floats2 = new float[ARRAY_SIZE];
+    private static final double[] doubles1 = new double[ARRAY_SIZE];
+    private static final double[] doubles2 = new double[ARRAY_SIZE];
+    private static final String string;
+
+    static {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            bytes1[i] = (byte) i;
+            bytes2[i] = (byte) (i * 3);
+            shorts1[i] = (short) i;
+            shorts2[i] = (short) (i * 5);
+            ints1[i] = i;
+            ints2[i] = i * 7;
+            longs1[i] = i;
+            longs2[i] = i * 11L;
+            floats1[i] = i * 0.5f;
+            floats2[i] = i * 0.25f;
+            doubles1[i] = i * 0.5;
+            doubles2[i] = i * 0.125;
+            sb.append((char) ('a' + (i % 26)));
+        }
+        string = sb.toString();  // Compressed when string compression is enabled.
+    }
+
+    public static int sink;
+
+    public void timeByteAdd(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$byteAdd(bytes1, bytes2);
+        }
+        sink = bytes1[1];
+    }
+
+    public void timeShortMul(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$shortMul(shorts1, shorts2);
+        }
+        sink = shorts1[1];
+    }
+
+    public void timeIntMulAdd(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$intMulAdd(ints1, ints2);
+        }
+        sink = ints1[1];
+    }
+
+    public void timeIntShift(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$intShift(ints1, ints2);
+        }
+        sink = ints1[1];
+    }
+
+    public void timeIntSum(int count) {
+        int result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$intSum(ints2);
+        }
+        sink = result;
+    }
+
+    public void timeLongSum(int count) {
+        long result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$longSum(longs2);
+        }
+        sink = (int) result;
+    }
+
+    public void timeLongAdd(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$longAdd(longs1, longs2);
+        }
+        sink = (int) longs1[1];
+    }
+
+    public void timeDotProduct(int count) {
+        int result = 0;
+        for (int n = 0; n < count; ++n) {
+            result += $noinline$dotProduct(shorts1, shorts2);
+        }
+        sink = result;
+    }
+
+    public void timeFloatMul(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$floatMul(floats1, floats2);
+        }
+        sink = (int) floats1[1];
+    }
+
+    public void timeDoubleAbs(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$doubleAbs(doubles1, doubles2);
+        }
+        sink = (int) doubles1[1];
+    }
+
+    public void timeStringToChars(int count) {
+        for (int n = 0; n < count; ++n) {
+            $noinline$stringToChars(string, chars);
+        }
+        sink = chars[1];
+    }
+
+    private static void $noinline$byteAdd(byte[] a, byte[] b) {
+        for (int i = 0; i < a.length; ++i) {
+            a[i] += b[i];
+        }
+    }
+
+    private static void $noinline$shortMul(short[] a, short[] b) {
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = (short) (a[i] * b[i]);
+        }
+    }
+
+    private static void $noinline$intMulAdd(int[] a, int[] b) {
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = a[i] * 3 + b[i];
+        }
+    }
+
+    private static void $noinline$intShift(int[] a, int[] b) {
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = (b[i] << 2) ^ (b[i] >>> 3);
+        }
+    }
+
+    private static int $noinline$intSum(int[] a) {
+        int sum = 0;
+        for (int i = 0; i < a.length; ++i) {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    private static long $noinline$longSum(long[] a) {
+        long sum = 0;
+        for (int i = 0; i < a.length; ++i) {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    private static void $noinline$longAdd(long[] a, long[] b) {
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = b[i] - a[i];
+        }
+    }
+
+    private static int $noinline$dotProduct(short[] a, short[] b) {
+        int sum = 0;
+        for (int i = 0; i < a.length; ++i) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    private static void $noinline$floatMul(float[] a, float[] b) {
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = b[i] * 1.5f - a[i];
+        }
+    }
+
+    private static void $noinline$doubleAbs(double[] a, double[] b) {
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = Math.abs(b[i] - a[i]);
+        }
+    }
+
+    private static void $noinline$stringToChars(String s, char[] c) {
+        for (int i = 0; i < c.length; ++i) {
+            c[i] = s.charAt(i);
+        }
+    }
+}
@@ -113,6 +113,88 @@ public class StringIndexOfBenchmark {
         }
     }
 
+    // Search loops with an early exit, which the loop optimizer vectorizes, compared
+    // against the String.indexOf() intrinsic on a long string with the match at the end.
+    public static final int LENGTH = 1024;
+    public static final String longString;
+    public static final char[] chars = new char[LENGTH];
+    public static final byte[] bytes = new byte[LENGTH];
+    public static final int[] ints = new int[LENGTH];
+
+    static {
+        for (int i = 0; i < LENGTH; ++i) {
+            chars[i] = string36.charAt(i % 35);  // never 'Z'
+            bytes[i] = (byte) chars[i];
+            ints[i] = chars[i];
+        }
+        chars[LENGTH - 1] = 'Z';
+        bytes[LENGTH - 1] = (byte) 'Z';
+        ints[LENGTH - 1] = 'Z';
+        longString = new String(chars);
+    }
+
+    public void timeLongIndexOf(int count) {
+        final char c = 'Z';
+        String s = longString;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeCharArraySearch(int count) {
+        final char c = 'Z';
+        char[] a = chars;
+        for (int i = 0; i < count; ++i) {
+            $noinline$search(a, c);
+        }
+    }
+
+    public void timeByteArraySearch(int count) {
+        final byte b = (byte) 'Z';
+        byte[] a = bytes;
+        for (int i = 0; i < count; ++i) {
+            $noinline$search(a, b);
+        }
+    }
+
+    public void timeIntArraySearch(int count) {
+        final int x = 'Z';
+        int[] a = ints;
+        for (int i = 0; i < count; ++i) {
+            $noinline$search(a, x);
+        }
+    }
+
+    static int $noinline$search(char[] a, char c) {
+        if (doThrow) { throw new Error(); }
+        for (int i = 0; i < a.length; ++i) {
+            if (a[i] == c) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static int $noinline$search(byte[] a, byte b) {
+        if (doThrow) { throw new Error(); }
+        for (int i = 0; i < a.length; ++i) {
+            if (a[i] == b) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static int $noinline$search(int[] a, int x) {
+        if (doThrow) { throw new Error(); }
+        for (int i = 0; i < a.length; ++i) {
+            if (a[i] == x) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
     static int $noinline$indexOf(String s, char c) {
         if (doThrow) { throw new Error(); }
         return s.indexOf(c);
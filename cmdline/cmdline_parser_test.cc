@@ -481,6 +481,14 @@ TEST_F(CmdlineParserTest, TestJitOptions) {
   {
     EXPECT_SINGLE_PARSE_VALUE(12345u, "-Xjitthreshold:12345", M::JITOptimizeThreshold);
   }
+  {
+    EXPECT_SINGLE_PARSE_VALUE(4u, "-Xjitthreads:4", M::JITPoolThreads);
+  }
+ /*
+  * Test failures
+  */
+  EXPECT_SINGLE_PARSE_FAIL("-Xjitthreads:0", CmdlineResult::kOutOfRange);
+  EXPECT_SINGLE_PARSE_FAIL("-Xjitthreads:1000", CmdlineResult::kOutOfRange);
 }  // TEST_F
 
 /*
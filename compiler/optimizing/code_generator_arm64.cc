@@ -1012,6 +1012,11 @@ CodeGeneratorARM64::CodeGeneratorARM64(HGraph* graph,
   if (use_sve) {
     location_builder_ = &location_builder_sve_;
     instruction_visitor_ = &instruction_visitor_sve_;
+    // The register allocator does not handle predicate registers, so the ones besides the
+    // loop predicate p0 are VIXL temps, for predicates that live within a single instruction.
+    CPURegList* scratch_p_registers = GetVIXLAssembler()->GetScratchPRegisterList();
+    scratch_p_registers->Combine(CPURegList(p1, p2, p3, p4));
+    scratch_p_registers->Combine(CPURegList(p5, p6, p7));
   } else {
     location_builder_ = &location_builder_neon_;
     instruction_visitor_ = &instruction_visitor_neon_;
@@ -4576,12 +4581,18 @@ void CodeGeneratorARM64::MaybeGenerateInlineCacheCheck(HInstruction* instruction
     DCHECK(info != nullptr);
     InlineCache* cache = info->GetInlineCache(instruction->GetDexPc());
     uint64_t address = reinterpret_cast64<uint64_t>(cache);
-    vixl::aarch64::Label done;
+    vixl::aarch64::Label update, done;
     __ Mov(x8, address);
     __ Ldr(x9, MemOperand(x8, InlineCache::ClassesOffset().Int32Value()));
-    // Fast path for a monomorphic cache.
+    // Fast path for a monomorphic cache: only count the call, saturating the count.
     __ Cmp(klass, x9);
-    __ B(eq, &done);
+    __ B(ne, &update);
+    __ Ldr(w9, MemOperand(x8, InlineCache::CountsOffset().Int32Value()));
+    __ Adds(w9, w9, 1);
+    __ Csinv(w9, w9, wzr, cc);
+    __ Str(w9, MemOperand(x8, InlineCache::CountsOffset().Int32Value()));
+    __ B(&done);
+    __ Bind(&update);
     InvokeRuntime(kQuickUpdateInlineCache, instruction, instruction->GetDexPc());
     __ Bind(&done);
   }
@@ -1392,6 +1392,184 @@ void InstructionCodeGeneratorARM64Neon::VisitVecDotProd(HVecDotProd* instruction
   }
 }
 
+void LocationsBuilderARM64Neon::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetInAt(2, Location::RequiresFpuRegister());
+      locations->SetInAt(3, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kOutputOverlap);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorARM64Neon::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  VRegister false_value = VRegisterFrom(locations->InAt(0));
+  VRegister true_value = VRegisterFrom(locations->InAt(1));
+  VRegister left = VRegisterFrom(locations->InAt(2));
+  VRegister right = VRegisterFrom(locations->InAt(3));
+  VRegister dst = VRegisterFrom(locations->Out());
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+      DCHECK_EQ(16u, instruction->GetVectorLength());
+      left = left.V16B();
+      right = right.V16B();
+      dst = dst.V16B();
+      break;
+    case DataType::Type::kInt16:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      left = left.V8H();
+      right = right.V8H();
+      dst = dst.V8H();
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      left = left.V4S();
+      right = right.V4S();
+      dst = dst.V4S();
+      break;
+    case DataType::Type::kInt64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      left = left.V2D();
+      right = right.V2D();
+      dst = dst.V2D();
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  // Compute the lane mask in dst, then let BSL pick the true value where it is set.
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      __ Cmeq(dst, left, right);
+      break;
+    case kCondNE:
+      __ Cmeq(dst, left, right);
+      std::swap(true_value, false_value);
+      break;
+    case kCondLT:
+      __ Cmgt(dst, right, left);
+      break;
+    case kCondLE:
+      __ Cmge(dst, right, left);
+      break;
+    case kCondGT:
+      __ Cmgt(dst, left, right);
+      break;
+    case kCondGE:
+      __ Cmge(dst, left, right);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  __ Bsl(dst.V16B(), true_value.V16B(), false_value.V16B());
+}
+
+void LocationsBuilderARM64Neon::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorARM64Neon::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  VRegister left = VRegisterFrom(locations->InAt(0));
+  VRegister right = VRegisterFrom(locations->InAt(1));
+  VRegister tmp = VRegisterFrom(locations->GetTemp(0));
+  Register out = OutputRegister(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      DCHECK_EQ(16u, instruction->GetVectorLength());
+      left = left.V16B();
+      right = right.V16B();
+      tmp = tmp.V16B();
+      break;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      left = left.V8H();
+      right = right.V8H();
+      tmp = tmp.V8H();
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      left = left.V4S();
+      right = right.V4S();
+      tmp = tmp.V4S();
+      break;
+    case DataType::Type::kInt64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      left = left.V2D();
+      right = right.V2D();
+      tmp = tmp.V2D();
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  // Compute the lane mask in tmp. Inequality is tested as any element that is not equal.
+  bool is_negated = false;
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      __ Cmeq(tmp, left, right);
+      break;
+    case kCondNE:
+      __ Cmeq(tmp, left, right);
+      is_negated = true;
+      break;
+    case kCondLT:
+      __ Cmgt(tmp, right, left);
+      break;
+    case kCondLE:
+      __ Cmge(tmp, right, left);
+      break;
+    case kCondGT:
+      __ Cmgt(tmp, left, right);
+      break;
+    case kCondGE:
+      __ Cmge(tmp, left, right);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  // The maximum byte of the mask is set if any element compares true,
+  // and the minimum byte is clear if any element compares false.
+  if (is_negated) {
+    __ Uminv(tmp.B(), tmp.V16B());
+  } else {
+    __ Umaxv(tmp.B(), tmp.V16B());
+  }
+  __ Umov(out, tmp.V16B(), 0);
+  __ Cmp(out, 0);
+  __ Cset(out, is_negated ? eq : ne);
+}
+
 // Helper to set up locations for vector memory operations.
 static void CreateVecMemLocations(ArenaAllocator* allocator,
                                   HVecMemoryOperation* instruction,
@@ -1059,6 +1059,165 @@ void InstructionCodeGeneratorARM64Sve::VisitVecDotProd(HVecDotProd* instruction)
   }
 }
 
+void LocationsBuilderARM64Sve::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetInAt(2, Location::RequiresFpuRegister());
+      locations->SetInAt(3, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorARM64Sve::VisitVecSelect(HVecSelect* instruction) {
+  DCHECK(instruction->IsPredicated());
+  LocationSummary* locations = instruction->GetLocations();
+  const ZRegister false_value = ZRegisterFrom(locations->InAt(0));
+  const ZRegister true_value = ZRegisterFrom(locations->InAt(1));
+  const ZRegister left = ZRegisterFrom(locations->InAt(2));
+  const ZRegister right = ZRegisterFrom(locations->InAt(3));
+  const ZRegister dst = ZRegisterFrom(locations->Out());
+  const PRegisterZ p_reg = LoopPReg().Zeroing();
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  const PRegister p_cond = temps.AcquireP();
+  ValidateVectorLength(instruction);
+  // Compare the active elements into a predicate and select on that predicate, which
+  // leaves the inactive elements of dst with the false value.
+  auto compare = [&](const PRegisterWithLaneSize& pd, const ZRegister& zn, const ZRegister& zm) {
+    switch (instruction->GetCondition()) {
+      case kCondEQ:
+        __ Cmpeq(pd, p_reg, zn, zm);
+        break;
+      case kCondNE:
+        __ Cmpne(pd, p_reg, zn, zm);
+        break;
+      case kCondLT:
+        __ Cmpgt(pd, p_reg, zm, zn);
+        break;
+      case kCondLE:
+        __ Cmpge(pd, p_reg, zm, zn);
+        break;
+      case kCondGT:
+        __ Cmpgt(pd, p_reg, zn, zm);
+        break;
+      case kCondGE:
+        __ Cmpge(pd, p_reg, zn, zm);
+        break;
+      default:
+        LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+        UNREACHABLE();
+    }
+  };
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+      compare(p_cond.VnB(), left.VnB(), right.VnB());
+      __ Sel(dst.VnB(), p_cond, true_value.VnB(), false_value.VnB());
+      break;
+    case DataType::Type::kInt16:
+      compare(p_cond.VnH(), left.VnH(), right.VnH());
+      __ Sel(dst.VnH(), p_cond, true_value.VnH(), false_value.VnH());
+      break;
+    case DataType::Type::kInt32:
+      compare(p_cond.VnS(), left.VnS(), right.VnS());
+      __ Sel(dst.VnS(), p_cond, true_value.VnS(), false_value.VnS());
+      break;
+    case DataType::Type::kInt64:
+      compare(p_cond.VnD(), left.VnD(), right.VnD());
+      __ Sel(dst.VnD(), p_cond, true_value.VnD(), false_value.VnD());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void LocationsBuilderARM64Sve::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorARM64Sve::VisitVecCompareAny(HVecCompareAny* instruction) {
+  DCHECK(instruction->IsPredicated());
+  LocationSummary* locations = instruction->GetLocations();
+  const ZRegister left = ZRegisterFrom(locations->InAt(0));
+  const ZRegister right = ZRegisterFrom(locations->InAt(1));
+  const Register out = OutputRegister(instruction);
+  const PRegisterZ p_reg = LoopPReg().Zeroing();
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  const PRegister p_cond = temps.AcquireP();
+  ValidateVectorLength(instruction);
+  // The compare sets the flags as a PTEST of the result, where Z is clear
+  // if the condition holds for any of the active elements.
+  auto compare = [&](const PRegisterWithLaneSize& pd, const ZRegister& zn, const ZRegister& zm) {
+    switch (instruction->GetCondition()) {
+      case kCondEQ:
+        __ Cmpeq(pd, p_reg, zn, zm);
+        break;
+      case kCondNE:
+        __ Cmpne(pd, p_reg, zn, zm);
+        break;
+      case kCondLT:
+        __ Cmpgt(pd, p_reg, zm, zn);
+        break;
+      case kCondLE:
+        __ Cmpge(pd, p_reg, zm, zn);
+        break;
+      case kCondGT:
+        __ Cmpgt(pd, p_reg, zn, zm);
+        break;
+      case kCondGE:
+        __ Cmpge(pd, p_reg, zn, zm);
+        break;
+      default:
+        LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+        UNREACHABLE();
+    }
+  };
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      compare(p_cond.VnB(), left.VnB(), right.VnB());
+      break;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      compare(p_cond.VnH(), left.VnH(), right.VnH());
+      break;
+    case DataType::Type::kInt32:
+      compare(p_cond.VnS(), left.VnS(), right.VnS());
+      break;
+    case DataType::Type::kInt64:
+      compare(p_cond.VnD(), left.VnD(), right.VnD());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  __ Cset(out, ne);
+}
+
 // Helper to set up locations for vector memory operations.
 static void CreateVecMemLocations(ArenaAllocator* allocator,
                                   HVecMemoryOperation* instruction,
@@ -862,6 +862,168 @@ void InstructionCodeGeneratorARMVIXL::VisitVecDotProd(HVecDotProd* instruction)
   LOG(FATAL) << "No SIMD for " << instruction->GetId();
 }
 
+void LocationsBuilderARMVIXL::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetInAt(2, Location::RequiresFpuRegister());
+      locations->SetInAt(3, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kOutputOverlap);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorARMVIXL::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  vixl32::DRegister false_value = DRegisterFrom(locations->InAt(0));
+  vixl32::DRegister true_value = DRegisterFrom(locations->InAt(1));
+  vixl32::DRegister left = DRegisterFrom(locations->InAt(2));
+  vixl32::DRegister right = DRegisterFrom(locations->InAt(3));
+  vixl32::DRegister dst = DRegisterFrom(locations->Out());
+  vixl32::DataType eq_type = DataTypeValue::I8;
+  vixl32::DataType signed_type = DataTypeValue::S8;
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      break;
+    case DataType::Type::kInt16:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      eq_type = DataTypeValue::I16;
+      signed_type = DataTypeValue::S16;
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      eq_type = DataTypeValue::I32;
+      signed_type = DataTypeValue::S32;
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  // Compute the lane mask in dst, then let VBSL pick the true value where it is set.
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      __ Vceq(eq_type, dst, left, right);
+      break;
+    case kCondNE:
+      __ Vceq(eq_type, dst, left, right);
+      std::swap(true_value, false_value);
+      break;
+    case kCondLT:
+      __ Vcgt(signed_type, dst, right, left);
+      break;
+    case kCondLE:
+      __ Vcge(signed_type, dst, right, left);
+      break;
+    case kCondGT:
+      __ Vcgt(signed_type, dst, left, right);
+      break;
+    case kCondGE:
+      __ Vcge(signed_type, dst, left, right);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  __ Vbsl(DataTypeValue::I8, dst, true_value, false_value);
+}
+
+void LocationsBuilderARMVIXL::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorARMVIXL::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  vixl32::DRegister left = DRegisterFrom(locations->InAt(0));
+  vixl32::DRegister right = DRegisterFrom(locations->InAt(1));
+  vixl32::DRegister mask = DRegisterFrom(locations->GetTemp(0));
+  vixl32::Register mask_hi = RegisterFrom(locations->GetTemp(1));
+  vixl32::Register out = OutputRegister(instruction);
+  vixl32::DataType eq_type = DataTypeValue::I8;
+  vixl32::DataType signed_type = DataTypeValue::S8;
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      break;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      eq_type = DataTypeValue::I16;
+      signed_type = DataTypeValue::S16;
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      eq_type = DataTypeValue::I32;
+      signed_type = DataTypeValue::S32;
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  // Compute the lane mask. Inequality is tested as any element that is not equal.
+  bool is_negated = false;
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      __ Vceq(eq_type, mask, left, right);
+      break;
+    case kCondNE:
+      __ Vceq(eq_type, mask, left, right);
+      is_negated = true;
+      break;
+    case kCondLT:
+      __ Vcgt(signed_type, mask, right, left);
+      break;
+    case kCondLE:
+      __ Vcge(signed_type, mask, right, left);
+      break;
+    case kCondGT:
+      __ Vcgt(signed_type, mask, left, right);
+      break;
+    case kCondGE:
+      __ Vcge(signed_type, mask, left, right);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  // Fold the mask into a word that is non-zero if any element compares true
+  // (or, when negated, false), then convert it into a boolean: out = (out != 0).
+  __ Vmov(out, mask_hi, mask);
+  if (is_negated) {
+    __ And(out, out, mask_hi);
+    __ Mvn(out, out);
+  } else {
+    __ Orr(out, out, mask_hi);
+  }
+  __ Clz(out, out);
+  __ Lsr(out, out, 5);
+  __ Eor(out, out, 1);
+}
+
 // Return whether the vector memory access operation is guaranteed to be word-aligned (ARM word
 // size equals to 4).
 static bool IsWordAligned(HVecMemoryOperation* instruction) {
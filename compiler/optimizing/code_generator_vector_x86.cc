@@ -1235,6 +1235,179 @@ void InstructionCodeGeneratorX86::VisitVecDotProd(HVecDotProd* instruction) {
   }
 }
 
+void LocationsBuilderX86::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetInAt(2, Location::RequiresFpuRegister());
+      locations->SetInAt(3, Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kOutputOverlap);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorX86::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XmmRegister false_value = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  XmmRegister true_value = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister left = locations->InAt(2).AsFpuRegister<XmmRegister>();
+  XmmRegister right = locations->InAt(3).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  // There are only equal and signed greater than compares: express the
+  // other conditions by swapping the compared and/or the selected values.
+  bool is_equality = false;
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      is_equality = true;
+      break;
+    case kCondNE:
+      is_equality = true;
+      std::swap(true_value, false_value);
+      break;
+    case kCondLT:
+      std::swap(left, right);
+      break;
+    case kCondLE:
+      std::swap(true_value, false_value);
+      break;
+    case kCondGT:
+      break;
+    case kCondGE:
+      std::swap(left, right);
+      std::swap(true_value, false_value);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  // Compute the lane mask in dst, then blend as dst = (true & mask) | (false & ~mask).
+  __ movaps(dst, left);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+      DCHECK_EQ(16u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqb(dst, right) : __ pcmpgtb(dst, right);
+      break;
+    case DataType::Type::kInt16:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqw(dst, right) : __ pcmpgtw(dst, right);
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqd(dst, right) : __ pcmpgtd(dst, right);
+      break;
+    case DataType::Type::kInt64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqq(dst, right) : __ pcmpgtq(dst, right);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  __ movaps(tmp, true_value);
+  __ pand(tmp, dst);
+  __ pandn(dst, false_value);
+  __ por(dst, tmp);
+}
+
+void LocationsBuilderX86::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorX86::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XmmRegister left = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  XmmRegister right = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  Register mask = locations->GetTemp(1).AsRegister<Register>();
+  Register out = locations->Out().AsRegister<Register>();
+  // There are only equal and signed greater than compares: express the other
+  // conditions by swapping the compared values and/or by testing for any
+  // element on which the opposite condition fails.
+  bool is_equality = false;
+  bool is_negated = false;
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      is_equality = true;
+      break;
+    case kCondNE:
+      is_equality = true;
+      is_negated = true;
+      break;
+    case kCondLT:
+      std::swap(left, right);
+      break;
+    case kCondLE:
+      is_negated = true;
+      break;
+    case kCondGT:
+      break;
+    case kCondGE:
+      std::swap(left, right);
+      is_negated = true;
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  const int32_t all_ones = 0xffff;
+  __ movaps(tmp, left);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      DCHECK_EQ(16u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqb(tmp, right) : __ pcmpgtb(tmp, right);
+      break;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqw(tmp, right) : __ pcmpgtw(tmp, right);
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqd(tmp, right) : __ pcmpgtd(tmp, right);
+      break;
+    case DataType::Type::kInt64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqq(tmp, right) : __ pcmpgtq(tmp, right);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  __ pmovmskb(mask, tmp);
+  // The byte mask of the lane mask has all bits set if the compare holds for all elements.
+  __ xorl(out, out);
+  __ cmpl(mask, Immediate(is_negated ? all_ones : 0));
+  __ setb(kNotEqual, out);
+}
+
 // Helper to set up locations for vector memory operations.
 static void CreateVecMemLocations(ArenaAllocator* allocator,
                                   HVecMemoryOperation* instruction,
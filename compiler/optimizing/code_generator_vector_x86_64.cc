@@ -25,6 +25,12 @@ namespace x86_64 {
 // NOLINT on __ macro to suppress wrong warning/fix (misc-macro-parentheses) from clang-tidy.
 #define __ down_cast<X86_64Assembler*>(GetAssembler())->  // NOLINT
 
+// With AVX2 the loop vectorizer uses 256-bit vectors, which operate on the YMM view of the
+// allocated XMM registers.
+static bool Is256BitVector(HVecOperation* instruction) {
+  return instruction->GetVectorNumberOfBytes() == 32u;
+}
+
 void LocationsBuilderX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
   HInstruction* input = instruction->InputAt(0);
@@ -58,6 +64,53 @@ void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
 
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm(dst);
+    if (IsZeroBitPattern(instruction->InputAt(0))) {
+      __ vpxor(ymm, ymm, ymm);
+      return;
+    }
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        DCHECK_EQ(32u, instruction->GetVectorLength());
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastb(ymm, dst);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        DCHECK_EQ(16u, instruction->GetVectorLength());
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastw(ymm, dst);
+        break;
+      case DataType::Type::kInt32:
+        DCHECK_EQ(8u, instruction->GetVectorLength());
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastd(ymm, dst);
+        break;
+      case DataType::Type::kInt64:
+        DCHECK_EQ(4u, instruction->GetVectorLength());
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ true);
+        __ vpbroadcastq(ymm, dst);
+        break;
+      case DataType::Type::kFloat32:
+        DCHECK_EQ(8u, instruction->GetVectorLength());
+        DCHECK(locations->InAt(0).Equals(locations->Out()));
+        __ vbroadcastss(ymm, dst);
+        break;
+      case DataType::Type::kFloat64:
+        DCHECK_EQ(4u, instruction->GetVectorLength());
+        DCHECK(locations->InAt(0).Equals(locations->Out()));
+        __ vbroadcastsd(ymm, dst);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   bool cpu_has_avx = CpuHasAvxFeatureFlag();
   // Shorthand for any type of zero.
   if (IsZeroBitPattern(instruction->InputAt(0))) {
@@ -144,17 +197,19 @@ void InstructionCodeGeneratorX86_64::VisitVecExtractScalar(HVecExtractScalar* in
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_LE(4u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), 8u);
       __ movd(locations->Out().AsRegister<CpuRegister>(), src, /*64-bit*/ false);
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_LE(2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), 4u);
       __ movd(locations->Out().AsRegister<CpuRegister>(), src, /*64-bit*/ true);
       break;
     case DataType::Type::kFloat32:
     case DataType::Type::kFloat64:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 4u);
+      DCHECK_LE(instruction->GetVectorLength(), 8u);
       DCHECK(locations->InAt(0).Equals(locations->Out()));  // no code required
       break;
     default:
@@ -187,8 +242,9 @@ static void CreateVecUnOpLocations(ArenaAllocator* allocator, HVecUnaryOperation
 
 void LocationsBuilderX86_64::VisitVecReduce(HVecReduce* instruction) {
   CreateVecUnOpLocations(GetGraph()->GetAllocator(), instruction);
-  // Long reduction or min/max require a temporary.
+  // Long reduction, 256-bit reduction or min/max require a temporary.
   if (instruction->GetPackedType() == DataType::Type::kInt64 ||
+      Is256BitVector(instruction) ||
       instruction->GetReductionKind() == HVecReduce::kMin ||
       instruction->GetReductionKind() == HVecReduce::kMax) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
@@ -199,6 +255,32 @@ void InstructionCodeGeneratorX86_64::VisitVecReduce(HVecReduce* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    // Fold the upper 128 bits into the lower ones, then finish as for a 128-bit vector.
+    XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+    DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kInt32:
+        DCHECK_EQ(8u, instruction->GetVectorLength());
+        __ vextracti128(tmp, YmmRegister(src), Immediate(1));
+        __ vpaddd(dst, tmp, src);
+        __ phaddd(dst, dst);
+        __ phaddd(dst, dst);
+        break;
+      case DataType::Type::kInt64:
+        DCHECK_EQ(4u, instruction->GetVectorLength());
+        __ vextracti128(tmp, YmmRegister(src), Immediate(1));
+        __ vpaddq(dst, tmp, src);
+        __ movaps(tmp, dst);
+        __ punpckhqdq(tmp, tmp);
+        __ paddq(dst, tmp);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt32:
       DCHECK_EQ(4u, instruction->GetVectorLength());
@@ -248,6 +330,11 @@ void InstructionCodeGeneratorX86_64::VisitVecCnv(HVecCnv* instruction) {
   DataType::Type from = instruction->GetInputType();
   DataType::Type to = instruction->GetResultType();
   if (from == DataType::Type::kInt32 && to == DataType::Type::kFloat32) {
+    if (Is256BitVector(instruction)) {
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      __ vcvtdq2ps(YmmRegister(dst), YmmRegister(src));
+      return;
+    }
     DCHECK_EQ(4u, instruction->GetVectorLength());
     __ cvtdq2ps(dst, src);
   } else {
@@ -263,6 +350,42 @@ void InstructionCodeGeneratorX86_64::VisitVecNeg(HVecNeg* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt64:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubq(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vxorps(ymm_dst, ymm_dst, ymm_dst);
+        __ vsubps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vxorpd(ymm_dst, ymm_dst, ymm_dst);
+        __ vsubpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
@@ -314,6 +437,29 @@ void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kInt32:
+        __ vpabsd(ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vpsrld(ymm_dst, ymm_dst, Immediate(1));
+        __ vandps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vpsrlq(ymm_dst, ymm_dst, Immediate(1));
+        __ vandpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt32: {
       DCHECK_EQ(4u, instruction->GetVectorLength());
@@ -355,6 +501,41 @@ void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool: {  // special case boolean-not
+        YmmRegister ymm_tmp(locations->GetTemp(0).AsFpuRegister<XmmRegister>());
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpcmpeqb(ymm_tmp, ymm_tmp, ymm_tmp);  // all ones
+        __ vpsubb(ymm_dst, ymm_dst, ymm_tmp);  // 32 x one
+        __ vpxor(ymm_dst, ymm_dst, ymm_src);
+        break;
+      }
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vpxor(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vxorps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vxorpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool: {  // special case boolean-not
       DCHECK_EQ(16u, instruction->GetVectorLength());
@@ -452,6 +633,37 @@ void InstructionCodeGeneratorX86_64::VisitVecAdd(HVecAdd* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpaddb(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpaddw(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kInt32:
+        __ vpaddd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kInt64:
+        __ vpaddq(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat32:
+        __ vaddps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vaddpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
@@ -494,6 +706,28 @@ void InstructionCodeGeneratorX86_64::VisitVecSaturationAdd(HVecSaturationAdd* in
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpaddusb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpaddsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpaddusw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpaddsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
       DCHECK_EQ(16u, instruction->GetVectorLength());
@@ -526,6 +760,22 @@ void InstructionCodeGeneratorX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instruct
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpavgb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpavgw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
 
   DCHECK(instruction->IsRounded());
 
@@ -559,6 +809,37 @@ void InstructionCodeGeneratorX86_64::VisitVecSub(HVecSub* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpsubb(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsubw(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kInt32:
+        __ vpsubd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kInt64:
+        __ vpsubq(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat32:
+        __ vsubps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vsubpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
@@ -601,6 +882,28 @@ void InstructionCodeGeneratorX86_64::VisitVecSaturationSub(HVecSaturationSub* in
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpsubusb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpsubsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpsubusw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpsubsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
       DCHECK_EQ(16u, instruction->GetVectorLength());
@@ -639,6 +942,30 @@ void InstructionCodeGeneratorX86_64::VisitVecMul(HVecMul* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpmullw(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kInt32:
+        __ vpmulld(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat32:
+        __ vmulps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vmulpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -678,6 +1005,23 @@ void InstructionCodeGeneratorX86_64::VisitVecDiv(HVecDiv* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kFloat32:
+        __ vdivps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vdivpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kFloat32:
       DCHECK_EQ(4u, instruction->GetVectorLength());
@@ -702,6 +1046,40 @@ void InstructionCodeGeneratorX86_64::VisitVecMin(HVecMin* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpminub(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpminsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpminuw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpminsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint32:
+        __ vpminud(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpminsd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vminps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vminpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
       DCHECK_EQ(16u, instruction->GetVectorLength());
@@ -751,6 +1129,40 @@ void InstructionCodeGeneratorX86_64::VisitVecMax(HVecMax* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpmaxub(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpmaxsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpmaxuw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpmaxsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint32:
+        __ vpmaxud(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpmaxsd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vmaxps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vmaxpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
       DCHECK_EQ(16u, instruction->GetVectorLength());
@@ -806,6 +1218,32 @@ void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpand(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat32:
+        __ vandps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vandpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -847,6 +1285,32 @@ void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpandn(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat32:
+        __ vandnps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vandnpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -888,6 +1352,32 @@ void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpor(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat32:
+        __ vorps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vorpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -929,6 +1419,32 @@ void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_src1(other_src);
+    YmmRegister ymm_src2(src);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpxor(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat32:
+        __ vxorps(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      case DataType::Type::kFloat64:
+        __ vxorpd(ymm_dst, ymm_src1, ymm_src2);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -982,6 +1498,25 @@ void InstructionCodeGeneratorX86_64::VisitVecShl(HVecShl* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsllw(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt32:
+        __ vpslld(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt64:
+        __ vpsllq(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -1011,6 +1546,22 @@ void InstructionCodeGeneratorX86_64::VisitVecShr(HVecShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsraw(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt32:
+        __ vpsrad(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -1036,6 +1587,25 @@ void InstructionCodeGeneratorX86_64::VisitVecUShr(HVecUShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsrlw(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt32:
+        __ vpsrld(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt64:
+        __ vpsrlq(ymm_dst, ymm_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -1094,8 +1664,9 @@ void InstructionCodeGeneratorX86_64::VisitVecSetScalars(HVecSetScalars* instruct
 
   DCHECK_EQ(1u, instruction->InputCount());  // only one input currently implemented
 
-  // Zero out all other elements first.
-  bool cpu_has_avx = CpuHasAvxFeatureFlag();
+  // Zero out all other elements first. The VEX encoded xor also clears the upper half of
+  // a 256-bit vector.
+  bool cpu_has_avx = CpuHasAvxFeatureFlag() || Is256BitVector(instruction);
   cpu_has_avx ? __ vxorps(dst, dst, dst) : __ xorps(dst, dst);
 
   // Shorthand for any type of zero.
@@ -1113,19 +1684,23 @@ void InstructionCodeGeneratorX86_64::VisitVecSetScalars(HVecSetScalars* instruct
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_LE(4u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), 8u);
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>());
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_LE(2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), 4u);
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>());  // is 64-bit
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_LE(4u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), 8u);
       __ movss(dst, locations->InAt(0).AsFpuRegister<XmmRegister>());
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_LE(2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), 4u);
       __ movsd(dst, locations->InAt(0).AsFpuRegister<XmmRegister>());
       break;
     default:
@@ -1190,8 +1765,14 @@ void InstructionCodeGeneratorX86_64::VisitVecDotProd(HVecDotProd* instruction) {
   XmmRegister right = locations->InAt(2).AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt32: {
-      DCHECK_EQ(4u, instruction->GetVectorLength());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+      if (Is256BitVector(instruction)) {
+        DCHECK_EQ(8u, instruction->GetVectorLength());
+        __ vpmaddwd(YmmRegister(tmp), YmmRegister(left), YmmRegister(right));
+        __ vpaddd(YmmRegister(acc), YmmRegister(acc), YmmRegister(tmp));
+        break;
+      }
+      DCHECK_EQ(4u, instruction->GetVectorLength());
       if (!cpu_has_avx) {
         __ movaps(tmp, right);
         __ pmaddwd(tmp, left);
@@ -1208,6 +1789,240 @@ void InstructionCodeGeneratorX86_64::VisitVecDotProd(HVecDotProd* instruction) {
   }
 }
 
+void LocationsBuilderX86_64::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetInAt(2, Location::RequiresFpuRegister());
+      locations->SetInAt(3, Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kOutputOverlap);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorX86_64::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XmmRegister false_value = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  XmmRegister true_value = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister left = locations->InAt(2).AsFpuRegister<XmmRegister>();
+  XmmRegister right = locations->InAt(3).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  // There are only equal and signed greater than compares: express the
+  // other conditions by swapping the compared and/or the selected values.
+  bool is_equality = false;
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      is_equality = true;
+      break;
+    case kCondNE:
+      is_equality = true;
+      std::swap(true_value, false_value);
+      break;
+    case kCondLT:
+      std::swap(left, right);
+      break;
+    case kCondLE:
+      std::swap(true_value, false_value);
+      break;
+    case kCondGT:
+      break;
+    case kCondGE:
+      std::swap(left, right);
+      std::swap(true_value, false_value);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  // Compute the lane mask in dst, then blend as dst = (true & mask) | (false & ~mask).
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    YmmRegister ymm_left(left);
+    YmmRegister ymm_right(right);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kInt8:
+        is_equality ? __ vpcmpeqb(ymm_dst, ymm_left, ymm_right)
+                    : __ vpcmpgtb(ymm_dst, ymm_left, ymm_right);
+        break;
+      case DataType::Type::kInt16:
+        is_equality ? __ vpcmpeqw(ymm_dst, ymm_left, ymm_right)
+                    : __ vpcmpgtw(ymm_dst, ymm_left, ymm_right);
+        break;
+      case DataType::Type::kInt32:
+        is_equality ? __ vpcmpeqd(ymm_dst, ymm_left, ymm_right)
+                    : __ vpcmpgtd(ymm_dst, ymm_left, ymm_right);
+        break;
+      case DataType::Type::kInt64:
+        is_equality ? __ vpcmpeqq(ymm_dst, ymm_left, ymm_right)
+                    : __ vpcmpgtq(ymm_dst, ymm_left, ymm_right);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    __ vpand(YmmRegister(tmp), ymm_dst, YmmRegister(true_value));
+    __ vpandn(ymm_dst, ymm_dst, YmmRegister(false_value));
+    __ vpor(ymm_dst, ymm_dst, YmmRegister(tmp));
+    return;
+  }
+  __ movaps(dst, left);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt8:
+      DCHECK_EQ(16u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqb(dst, right) : __ pcmpgtb(dst, right);
+      break;
+    case DataType::Type::kInt16:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqw(dst, right) : __ pcmpgtw(dst, right);
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqd(dst, right) : __ pcmpgtd(dst, right);
+      break;
+    case DataType::Type::kInt64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      is_equality ? __ pcmpeqq(dst, right) : __ pcmpgtq(dst, right);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  __ movaps(tmp, true_value);
+  __ pand(tmp, dst);
+  __ pandn(dst, false_value);
+  __ por(dst, tmp);
+}
+
+void LocationsBuilderX86_64::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorX86_64::VisitVecCompareAny(HVecCompareAny* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XmmRegister left = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  XmmRegister right = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  CpuRegister mask = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  // There are only equal and signed greater than compares: express the other
+  // conditions by swapping the compared values and/or by testing for any
+  // element on which the opposite condition fails.
+  bool is_equality = false;
+  bool is_negated = false;
+  switch (instruction->GetCondition()) {
+    case kCondEQ:
+      is_equality = true;
+      break;
+    case kCondNE:
+      is_equality = true;
+      is_negated = true;
+      break;
+    case kCondLT:
+      std::swap(left, right);
+      break;
+    case kCondLE:
+      is_negated = true;
+      break;
+    case kCondGT:
+      break;
+    case kCondGE:
+      std::swap(left, right);
+      is_negated = true;
+      break;
+    default:
+      LOG(FATAL) << "Unexpected condition " << instruction->GetCondition();
+      UNREACHABLE();
+  }
+  int32_t all_ones = 0xffff;
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm_tmp(tmp);
+    YmmRegister ymm_left(left);
+    YmmRegister ymm_right(right);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        is_equality ? __ vpcmpeqb(ymm_tmp, ymm_left, ymm_right)
+                    : __ vpcmpgtb(ymm_tmp, ymm_left, ymm_right);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        is_equality ? __ vpcmpeqw(ymm_tmp, ymm_left, ymm_right)
+                    : __ vpcmpgtw(ymm_tmp, ymm_left, ymm_right);
+        break;
+      case DataType::Type::kInt32:
+        is_equality ? __ vpcmpeqd(ymm_tmp, ymm_left, ymm_right)
+                    : __ vpcmpgtd(ymm_tmp, ymm_left, ymm_right);
+        break;
+      case DataType::Type::kInt64:
+        is_equality ? __ vpcmpeqq(ymm_tmp, ymm_left, ymm_right)
+                    : __ vpcmpgtq(ymm_tmp, ymm_left, ymm_right);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    __ vpmovmskb(mask, ymm_tmp);
+    all_ones = -1;
+  } else {
+    __ movaps(tmp, left);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        DCHECK_EQ(16u, instruction->GetVectorLength());
+        is_equality ? __ pcmpeqb(tmp, right) : __ pcmpgtb(tmp, right);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        DCHECK_EQ(8u, instruction->GetVectorLength());
+        is_equality ? __ pcmpeqw(tmp, right) : __ pcmpgtw(tmp, right);
+        break;
+      case DataType::Type::kInt32:
+        DCHECK_EQ(4u, instruction->GetVectorLength());
+        is_equality ? __ pcmpeqd(tmp, right) : __ pcmpgtd(tmp, right);
+        break;
+      case DataType::Type::kInt64:
+        DCHECK_EQ(2u, instruction->GetVectorLength());
+        is_equality ? __ pcmpeqq(tmp, right) : __ pcmpgtq(tmp, right);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    __ pmovmskb(mask, tmp);
+  }
+  // The byte mask of the lane mask has all bits set if the compare holds for all elements.
+  __ xorl(out, out);
+  __ cmpl(mask, Immediate(is_negated ? all_ones : 0));
+  __ setcc(kNotEqual, out);
+}
+
 // Helper to set up locations for vector memory operations.
 static void CreateVecMemLocations(ArenaAllocator* allocator,
                                   HVecMemoryOperation* instruction,
@@ -1257,8 +2072,11 @@ static Address VecAddress(LocationSummary* locations, size_t size, bool is_strin
 
 void LocationsBuilderX86_64::VisitVecLoad(HVecLoad* instruction) {
   CreateVecMemLocations(GetGraph()->GetAllocator(), instruction, /*is_load*/ true);
-  // String load requires a temporary for the compressed load.
-  if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
+  // String load requires a temporary for the compressed load, unless it can zero extend
+  // directly from memory.
+  if (mirror::kUseStringCompression &&
+      instruction->IsStringCharAt() &&
+      !Is256BitVector(instruction)) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
   }
 }
@@ -1268,6 +2086,51 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
   size_t size = DataType::Size(instruction->GetPackedType());
   Address address = VecAddress(locations, size, instruction->IsStringCharAt());
   XmmRegister reg = locations->Out().AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm(reg);
+    bool is_aligned32 = instruction->GetAlignment().IsAlignedAt(32);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kInt16:
+      case DataType::Type::kUint16:
+        DCHECK_EQ(16u, instruction->GetVectorLength());
+        // Special handling of compressed/uncompressed string load.
+        if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
+          NearLabel done, not_compressed;
+          static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
+                        "Expecting 0=compressed, 1=uncompressed");
+          uint32_t count_offset = mirror::String::CountOffset().Uint32Value();
+          __ testb(Address(locations->InAt(0).AsRegister<CpuRegister>(), count_offset),
+                   Immediate(1));
+          __ j(kNotZero, &not_compressed);
+          // Zero extend 16 compressed bytes into 16 chars.
+          __ vpmovzxbw(ymm, VecAddress(locations, 1, instruction->IsStringCharAt()));
+          __ jmp(&done);
+          // Load 16 direct uncompressed chars.
+          __ Bind(&not_compressed);
+          is_aligned32 ? __ vmovdqa(ymm, address) : __ vmovdqu(ymm, address);
+          __ Bind(&done);
+          return;
+        }
+        FALLTHROUGH_INTENDED;
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        is_aligned32 ? __ vmovdqa(ymm, address) : __ vmovdqu(ymm, address);
+        break;
+      case DataType::Type::kFloat32:
+        is_aligned32 ? __ vmovaps(ymm, address) : __ vmovups(ymm, address);
+        break;
+      case DataType::Type::kFloat64:
+        is_aligned32 ? __ vmovapd(ymm, address) : __ vmovupd(ymm, address);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt16:  // (short) s.charAt(.) can yield HVecLoad/Int16/StringCharAt.
@@ -1327,6 +2190,31 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
   size_t size = DataType::Size(instruction->GetPackedType());
   Address address = VecAddress(locations, size, /*is_string_char_at*/ false);
   XmmRegister reg = locations->InAt(2).AsFpuRegister<XmmRegister>();
+  if (Is256BitVector(instruction)) {
+    YmmRegister ymm(reg);
+    bool is_aligned32 = instruction->GetAlignment().IsAlignedAt(32);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        is_aligned32 ? __ vmovdqa(address, ymm) : __ vmovdqu(address, ymm);
+        break;
+      case DataType::Type::kFloat32:
+        is_aligned32 ? __ vmovaps(address, ymm) : __ vmovups(address, ymm);
+        break;
+      case DataType::Type::kFloat64:
+        is_aligned32 ? __ vmovapd(address, ymm) : __ vmovupd(address, ymm);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
@@ -1455,7 +1455,9 @@ size_t CodeGeneratorX86_64::RestoreCoreRegister(size_t stack_index, uint32_t reg
 }
 
 size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (Uses256BitSIMD()) {
+    __ vmovups(Address(CpuRegister(RSP), stack_index), YmmRegister(XmmRegister(reg_id)));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
   } else {
     __ movsd(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
@@ -1464,7 +1466,9 @@ size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32
 }
 
 size_t CodeGeneratorX86_64::RestoreFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (Uses256BitSIMD()) {
+    __ vmovups(YmmRegister(XmmRegister(reg_id)), Address(CpuRegister(RSP), stack_index));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
   } else {
     __ movsd(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
@@ -1815,6 +1819,10 @@ void CodeGeneratorX86_64::GenerateFrameExit() {
       }
     }
   }
+  if (Uses256BitSIMD()) {
+    // Avoid the AVX-SSE transition penalty in the caller.
+    __ vzeroupper();
+  }
   __ ret();
   __ cfi().RestoreState();
   __ cfi().DefCFAOffset(GetFrameSize());
@@ -3005,11 +3013,16 @@ void CodeGeneratorX86_64::MaybeGenerateInlineCacheCheck(HInstruction* instructio
     DCHECK(info != nullptr);
     InlineCache* cache = info->GetInlineCache(instruction->GetDexPc());
     uint64_t address = reinterpret_cast64<uint64_t>(cache);
-    NearLabel done;
+    NearLabel update, done;
     __ movq(CpuRegister(TMP), Immediate(address));
-    // Fast path for a monomorphic cache.
+    // Fast path for a monomorphic cache: only count the call, saturating the count.
     __ cmpl(Address(CpuRegister(TMP), InlineCache::ClassesOffset().Int32Value()), klass);
-    __ j(kEqual, &done);
+    __ j(kNotEqual, &update);
+    __ addl(Address(CpuRegister(TMP), InlineCache::CountsOffset().Int32Value()), Immediate(1));
+    __ j(kCarryClear, &done);
+    __ movl(Address(CpuRegister(TMP), InlineCache::CountsOffset().Int32Value()), Immediate(-1));
+    __ jmp(&done);
+    __ Bind(&update);
     GenerateInvokeRuntime(
         GetThreadOffset<kX86_64PointerSize>(kQuickUpdateInlineCache).Int32Value());
     __ Bind(&done);
@@ -6197,15 +6210,22 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsSIMDStackSlot()) {
     if (destination.IsFpuRegister()) {
-      __ movups(destination.AsFpuRegister<XmmRegister>(),
-                Address(CpuRegister(RSP), source.GetStackIndex()));
+      if (codegen_->Uses256BitSIMD()) {
+        __ vmovups(YmmRegister(destination.AsFpuRegister<XmmRegister>()),
+                   Address(CpuRegister(RSP), source.GetStackIndex()));
+      } else {
+        __ movups(destination.AsFpuRegister<XmmRegister>(),
+                  Address(CpuRegister(RSP), source.GetStackIndex()));
+      }
     } else {
       DCHECK(destination.IsSIMDStackSlot());
-      size_t high = kX86_64WordSize;
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex()));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex()), CpuRegister(TMP));
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + high));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + high), CpuRegister(TMP));
+      for (size_t offset = 0;
+           offset != codegen_->GetSIMDRegisterWidth();
+           offset += kX86_64WordSize) {
+        __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + offset));
+        __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + offset),
+                CpuRegister(TMP));
+      }
     }
   } else if (source.IsConstant()) {
     HConstant* constant = source.GetConstant();
@@ -6253,13 +6273,23 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsFpuRegister()) {
     if (destination.IsFpuRegister()) {
-      __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      if (codegen_->Uses256BitSIMD()) {
+        // The register may hold a 256-bit vector, which a VEX.128 move would truncate.
+        __ vmovaps(YmmRegister(destination.AsFpuRegister<XmmRegister>()),
+                   YmmRegister(source.AsFpuRegister<XmmRegister>()));
+      } else {
+        __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      }
     } else if (destination.IsStackSlot()) {
       __ movss(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
     } else if (destination.IsDoubleStackSlot()) {
       __ movsd(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
+    } else if (codegen_->Uses256BitSIMD()) {
+      DCHECK(destination.IsSIMDStackSlot());
+      __ vmovups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                 YmmRegister(source.AsFpuRegister<XmmRegister>()));
     } else {
        DCHECK(destination.IsSIMDStackSlot());
       __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
@@ -6307,6 +6337,15 @@ void ParallelMoveResolverX86_64::Exchange128(XmmRegister reg, int mem) {
   __ addq(CpuRegister(RSP), Immediate(extra_slot));
 }
 
+void ParallelMoveResolverX86_64::Exchange256(XmmRegister reg, int mem) {
+  size_t extra_slot = 4 * kX86_64WordSize;
+  __ subq(CpuRegister(RSP), Immediate(extra_slot));
+  __ vmovups(Address(CpuRegister(RSP), 0), YmmRegister(reg));
+  ExchangeMemory64(0, mem + extra_slot, 4);
+  __ vmovups(YmmRegister(reg), Address(CpuRegister(RSP), 0));
+  __ addq(CpuRegister(RSP), Immediate(extra_slot));
+}
+
 void ParallelMoveResolverX86_64::ExchangeMemory32(int mem1, int mem2) {
   ScratchRegisterScope ensure_scratch(
       this, TMP, RAX, codegen_->GetNumberOfCoreRegisters());
@@ -6359,6 +6398,14 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
     Exchange64(destination.AsRegister<CpuRegister>(), source.GetStackIndex());
   } else if (source.IsDoubleStackSlot() && destination.IsDoubleStackSlot()) {
     ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 1);
+  } else if (source.IsFpuRegister() && destination.IsFpuRegister() &&
+             codegen_->Uses256BitSIMD()) {
+    // Swap the full 256 bits with the xor trick, there is no free vector register.
+    YmmRegister src(source.AsFpuRegister<XmmRegister>());
+    YmmRegister dst(destination.AsFpuRegister<XmmRegister>());
+    __ vxorps(src, src, dst);
+    __ vxorps(dst, dst, src);
+    __ vxorps(src, src, dst);
   } else if (source.IsFpuRegister() && destination.IsFpuRegister()) {
     __ movd(CpuRegister(TMP), source.AsFpuRegister<XmmRegister>());
     __ movaps(source.AsFpuRegister<XmmRegister>(), destination.AsFpuRegister<XmmRegister>());
@@ -6372,11 +6419,21 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
   } else if (source.IsDoubleStackSlot() && destination.IsFpuRegister()) {
     Exchange64(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
   } else if (source.IsSIMDStackSlot() && destination.IsSIMDStackSlot()) {
-    ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 2);
+    ExchangeMemory64(destination.GetStackIndex(),
+                     source.GetStackIndex(),
+                     codegen_->GetSIMDRegisterWidth() / kX86_64WordSize);
   } else if (source.IsFpuRegister() && destination.IsSIMDStackSlot()) {
-    Exchange128(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    if (codegen_->Uses256BitSIMD()) {
+      Exchange256(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    } else {
+      Exchange128(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    }
   } else if (destination.IsFpuRegister() && source.IsSIMDStackSlot()) {
-    Exchange128(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    if (codegen_->Uses256BitSIMD()) {
+      Exchange256(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    } else {
+      Exchange128(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    }
   } else {
     LOG(FATAL) << "Unimplemented swap between " << source << " and " << destination;
   }
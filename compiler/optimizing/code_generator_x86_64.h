@@ -216,6 +216,7 @@ class ParallelMoveResolverX86_64 : public ParallelMoveResolverWithSwap {
   void Exchange64(CpuRegister reg, int mem);
   void Exchange64(XmmRegister reg, int mem);
   void Exchange128(XmmRegister reg, int mem);
+  void Exchange256(XmmRegister reg, int mem);
   void ExchangeMemory32(int mem1, int mem2);
   void ExchangeMemory64(int mem1, int mem2, int num_of_qwords);
 
@@ -437,8 +438,15 @@ class CodeGeneratorX86_64 : public CodeGenerator {
     return 1 * kX86_64WordSize;
   }
 
+  // With AVX2 all vector code uses the full 256-bit YMM registers. The loop vectorizer and the
+  // register allocator assume a single vector width per method, so there is no mixing with
+  // 128-bit vectors.
   size_t GetSIMDRegisterWidth() const override {
-    return 2 * kX86_64WordSize;
+    return GetInstructionSetFeatures().HasAVX2() ? 4 * kX86_64WordSize : 2 * kX86_64WordSize;
+  }
+
+  bool Uses256BitSIMD() const {
+    return GetGraph()->HasSIMD() && GetSIMDRegisterWidth() == 4 * kX86_64WordSize;
   }
 
   HGraphVisitor* GetLocationBuilder() override {
@@ -631,6 +631,16 @@ class HGraphVisualizerPrinter : public HGraphDelegateVisitor {
                                     DataType::ToSigned(arg_type));
   }
 
+  void VisitVecSelect(HVecSelect* instruction) override {
+    VisitVecOperation(instruction);
+    StartAttributeStream("cond") << instruction->GetCondition();
+  }
+
+  void VisitVecCompareAny(HVecCompareAny* instruction) override {
+    VisitVecOperation(instruction);
+    StartAttributeStream("cond") << instruction->GetCondition();
+  }
+
 #if defined(ART_ENABLE_CODEGEN_arm) || defined(ART_ENABLE_CODEGEN_arm64)
   void VisitMultiplyAccumulate(HMultiplyAccumulate* instruction) override {
     StartAttributeStream("kind") << instruction->GetOpKind();
@@ -16,6 +16,9 @@
 
 #include "inliner.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "art_method-inl.h"
 #include "base/enums.h"
 #include "base/logging.h"
@@ -69,6 +72,15 @@ static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 // recursive calls at all.
 static constexpr size_t kMaximumNumberOfPolymorphicRecursiveCalls = 0;
 
+// Number of receiver types we try to inline at a megamorphic call site. The original
+// invoke is kept as the fallback for all other types, so each extra target only adds
+// a type check on the slow path.
+static constexpr size_t kMaximumNumberOfMegamorphicInlinedTargets = 2;
+
+// Minimum share of the calls recorded by the inline cache, in percent, that a receiver
+// type of a megamorphic call site must have to be inlined.
+static constexpr uint64_t kMinimumMegamorphicTargetPercentage = 20;
+
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
@@ -590,12 +602,14 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
   }
 
   StackHandleScope<InlineCache::kIndividualCacheSize> classes(Thread::Current());
+  // Call counts of the classes, only recorded by the JIT inline caches.
+  std::array<uint32_t, InlineCache::kIndividualCacheSize> counts = {};
   // The Zygote JIT compiles based on a profile, so we shouldn't use runtime inline caches
   // for it.
   InlineCacheType inline_cache_type =
       (Runtime::Current()->IsAotCompiler() || Runtime::Current()->IsZygote())
           ? GetInlineCacheAOT(invoke_instruction, &classes)
-          : GetInlineCacheJIT(invoke_instruction, &classes);
+          : GetInlineCacheJIT(invoke_instruction, &classes, &counts);
 
   switch (inline_cache_type) {
     case kInlineCacheNoData: {
@@ -628,11 +642,14 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
     }
 
     case kInlineCacheMegamorphic: {
+      MaybeRecordStat(stats_, MethodCompilationStat::kMegamorphicCall);
+      if (TryInlineMegamorphicCall(invoke_instruction, classes, counts)) {
+        return true;
+      }
       LOG_FAIL_NO_STAT()
           << "Interface or virtual call to "
           << invoke_instruction->GetMethodReference().PrettyMethod()
           << " is megamorphic and not inlined";
-      MaybeRecordStat(stats_, MethodCompilationStat::kMegamorphicCall);
       return false;
     }
 
@@ -649,7 +666,8 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
 
 HInliner::InlineCacheType HInliner::GetInlineCacheJIT(
     HInvoke* invoke_instruction,
-    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes) {
+    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+    /*out*/std::array<uint32_t, InlineCache::kIndividualCacheSize>* counts) {
   DCHECK(codegen_->GetCompilerOptions().IsJitCompiler());
 
   ArtMethod* caller = graph_->GetArtMethod();
@@ -660,10 +678,12 @@ HInliner::InlineCacheType HInliner::GetInlineCacheJIT(
     return kInlineCacheNoData;
   }
 
-  Runtime::Current()->GetJit()->GetCodeCache()->CopyInlineCacheInto(
+  bool is_megamorphic = Runtime::Current()->GetJit()->GetCodeCache()->CopyInlineCacheInto(
       *profiling_info->GetInlineCache(invoke_instruction->GetDexPc()),
-      classes);
-  return GetInlineCacheType(*classes);
+      classes,
+      counts);
+  // A megamorphic inline cache can have empty entries, see `InlineCache::kEvictionCount`.
+  return is_megamorphic ? kInlineCacheMegamorphic : GetInlineCacheType(*classes);
 }
 
 HInliner::InlineCacheType HInliner::GetInlineCacheAOT(
@@ -950,13 +970,63 @@ static void MaybeReplaceAndRemove(HInstruction* new_instruction, HInstruction* o
   old_instruction->GetBlock()->RemoveInstruction(old_instruction);
 }
 
+bool HInliner::TryInlineMegamorphicCall(
+    HInvoke* invoke_instruction,
+    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+    const std::array<uint32_t, InlineCache::kIndividualCacheSize>& counts) {
+  // Only the JIT inline caches record the receiver types of a megamorphic call site,
+  // profiles only record that the call site is megamorphic.
+  if (!codegen_->GetCompilerOptions().IsJitCompiler()) {
+    return false;
+  }
+  size_t number_of_types = InlineCache::kIndividualCacheSize - classes.RemainingSlots();
+  if (number_of_types < 2u) {
+    return false;
+  }
+
+  // The last entry of the inline cache is overwritten by every new receiver type, and its
+  // count is for all of them, so only the other entries are candidates for inlining. They
+  // hold distinct types, JitCodeCache::CopyInlineCacheInto() merged the duplicate entries.
+  std::array<size_t, InlineCache::kIndividualCacheSize - 1u> candidates;
+  size_t number_of_candidates = number_of_types - 1u;
+  std::iota(candidates.begin(), candidates.begin() + number_of_candidates, 0u);
+  std::stable_sort(candidates.begin(),
+                   candidates.begin() + number_of_candidates,
+                   [&counts](size_t lhs, size_t rhs) { return counts[lhs] > counts[rhs]; });
+  uint64_t total_count = std::accumulate(counts.begin(), counts.end(), UINT64_C(0));
+
+  StackHandleScope<InlineCache::kIndividualCacheSize> hot_classes(Thread::Current());
+  size_t number_of_targets =
+      std::min(number_of_candidates, kMaximumNumberOfMegamorphicInlinedTargets);
+  for (size_t i = 0; i != number_of_targets; ++i) {
+    size_t index = candidates[i];
+    // Types with a small share of the calls are better served by the original invoke.
+    if (static_cast<uint64_t>(counts[index]) * 100u <
+            total_count * kMinimumMegamorphicTargetPercentage) {
+      break;
+    }
+    DCHECK(classes.GetReference(index) != nullptr);
+    hot_classes.NewHandle(classes.GetReference(index)->AsClass());
+  }
+  if (hot_classes.RemainingSlots() == InlineCache::kIndividualCacheSize) {
+    LOG_FAIL_NO_STAT()
+        << "Megamorphic call to " << invoke_instruction->GetMethodReference().PrettyMethod()
+        << " has no receiver type with enough calls to be inlined";
+    return false;
+  }
+  return TryInlinePolymorphicCall(invoke_instruction, hot_classes, /* is_megamorphic= */ true);
+}
+
 bool HInliner::TryInlinePolymorphicCall(
     HInvoke* invoke_instruction,
-    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes) {
+    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+    bool is_megamorphic) {
   DCHECK(invoke_instruction->IsInvokeVirtual() || invoke_instruction->IsInvokeInterface())
       << invoke_instruction->DebugName();
 
-  if (TryInlinePolymorphicCallToSameTarget(invoke_instruction, classes)) {
+  // A megamorphic call site will see other receiver types than the ones recorded, so we
+  // must not deoptimize when none of the inlined types match.
+  if (!is_megamorphic && TryInlinePolymorphicCallToSameTarget(invoke_instruction, classes)) {
     return true;
   }
 
@@ -989,7 +1059,7 @@ bool HInliner::TryInlinePolymorphicCall(
 
     // In monomorphic cases when UseOnlyPolymorphicInliningWithNoDeopt() is true, we call
     // `TryInlinePolymorphicCall` even though we are monomorphic.
-    const bool actually_monomorphic = number_of_types == 1;
+    const bool actually_monomorphic = !is_megamorphic && number_of_types == 1;
     DCHECK_IMPLIES(actually_monomorphic, UseOnlyPolymorphicInliningWithNoDeopt());
 
     // We only want to limit recursive polymorphic cases, not monomorphic ones.
@@ -1021,7 +1091,8 @@ bool HInliner::TryInlinePolymorphicCall(
 
       // If we have inlined all targets before, and this receiver is the last seen,
       // we deoptimize instead of keeping the original invoke instruction.
-      bool deoptimize = !UseOnlyPolymorphicInliningWithNoDeopt() &&
+      bool deoptimize = !is_megamorphic &&
+          !UseOnlyPolymorphicInliningWithNoDeopt() &&
           all_targets_inlined &&
           (i + 1 == number_of_types);
 
@@ -1048,7 +1119,9 @@ bool HInliner::TryInlinePolymorphicCall(
     return false;
   }
 
-  MaybeRecordStat(stats_, MethodCompilationStat::kInlinedPolymorphicCall);
+  MaybeRecordStat(stats_,
+                  is_megamorphic ? MethodCompilationStat::kInlinedMegamorphicCall
+                                 : MethodCompilationStat::kInlinedPolymorphicCall);
 
   // Run type propagation to get the guards typed.
   ReferenceTypePropagation rtp_fixup(graph_,
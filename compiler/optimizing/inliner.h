@@ -17,6 +17,8 @@
 #ifndef ART_COMPILER_OPTIMIZING_INLINER_H_
 #define ART_COMPILER_OPTIMIZING_INLINER_H_
 
+#include <array>
+
 #include "base/macros.h"
 #include "dex/dex_file_types.h"
 #include "dex/invoke_type.h"
@@ -183,9 +185,11 @@ class HInliner : public HOptimization {
   // Try getting the inline cache from JIT code cache.
   // Return true if the inline cache was successfully allocated and the
   // invoke info was found in the profile info.
+  // Also return in `counts` the number of calls seen for each of the classes.
   InlineCacheType GetInlineCacheJIT(
       HInvoke* invoke_instruction,
-      /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes)
+      /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+      /*out*/std::array<uint32_t, InlineCache::kIndividualCacheSize>* counts)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Try getting the inline cache from AOT offline profile.
@@ -209,9 +213,23 @@ class HInliner : public HOptimization {
                                 const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Try to inline targets of a polymorphic call.
+  // Try to inline targets of a polymorphic call. If `is_megamorphic` is true, the original
+  // invoke is kept for the receiver types that are not in `classes`.
   bool TryInlinePolymorphicCall(HInvoke* invoke_instruction,
-                                const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
+                                const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+                                bool is_megamorphic = false)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Try to inline the most frequent targets of a megamorphic call according to the call
+  // counts of the inline cache, guarded by type checks that fall back to the original invoke.
+  // If successful, the code in the graph will look like:
+  // if (receiver.getClass() == hottest class) ... // inlined code
+  // else if (receiver.getClass() == second hottest class) ... // inlined code
+  // else invoke
+  bool TryInlineMegamorphicCall(
+      HInvoke* invoke_instruction,
+      const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+      const std::array<uint32_t, InlineCache::kIndividualCacheSize>& counts)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   bool TryInlinePolymorphicCallToSameTarget(
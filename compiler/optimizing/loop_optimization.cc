@@ -32,6 +32,10 @@ namespace art HIDDEN {
 // Enables vectorization (SIMDization) in the loop optimizer.
 static constexpr bool kEnableVectorization = true;
 
+// Maximum number of instructions in a branch of an if-then-else in the loop-body
+// that is flattened into selects, since both branches then execute every iteration.
+static constexpr size_t kMaxIfConversionInstructions = 4;
+
 //
 // Static helpers.
 //
@@ -82,6 +86,149 @@ static bool IsEarlyExit(HLoopInformation* loop_info) {
   return false;
 }
 
+// Detect a read that is also done unconditionally by an instruction in the given block,
+// i.e. an array element that has already been accessed (with bounds and null checks)
+// before the end of the block. Such a read can safely be executed speculatively.
+static bool IsReadBefore(HInstruction* read, HBasicBlock* block) {
+  if (!read->IsArrayGet()) {
+    return false;
+  }
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if ((instruction->IsArrayGet() || instruction->IsArraySet()) &&
+        instruction->InputAt(0) == read->InputAt(0) &&
+        instruction->InputAt(1) == read->InputAt(1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Detect a branch of an if-then-else ending block `head` in the loop-body that can be
+// executed unconditionally: it has a single predecessor and successor, and contains only
+// a few cheap movable instructions that have no side effects and cannot throw. Reads are
+// only accepted if they were done before in `head`, so no masked loads are needed.
+static bool IsIfConvertibleBranch(HLoopInformation* loop_info,
+                                  HBasicBlock* block,
+                                  HBasicBlock* head) {
+  if (!loop_info->Contains(*block) ||
+      block->GetPredecessors().size() != 1u ||
+      block->GetSuccessors().size() != 1u) {
+    return false;
+  }
+  DCHECK(block->GetPhis().IsEmpty());
+  size_t num_instructions = 0u;
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction->IsGoto()) {
+      return true;
+    } else if (!instruction->CanBeMoved() ||
+               instruction->HasSideEffects() ||
+               instruction->CanThrow() ||
+               instruction->IsDiv() ||  // expensive, or even trapping on zero
+               instruction->IsRem() ||
+               (instruction->GetSideEffects().DoesAnyRead() && !IsReadBefore(instruction, head)) ||
+               ++num_instructions > kMaxIfConversionInstructions) {
+      return false;
+    }
+  }
+  return false;
+}
+
+// Detect an accumulation x + y or x - y into the given base x, which has no other uses.
+// Returns the index of the y operand on success.
+static bool IsAccumulationInto(HInstruction* update,
+                               HInstruction* base,
+                               /*out*/ size_t* addend_index) {
+  if ((update->IsAdd() || update->IsSub()) &&
+      DataType::IsIntegralType(update->GetType()) &&
+      update->GetUses().HasExactlyOneElement() &&
+      !update->HasEnvironmentUses()) {
+    if (update->InputAt(0) == base) {
+      *addend_index = 1;
+      return true;
+    } else if (update->IsAdd() && update->InputAt(1) == base) {
+      *addend_index = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Detect a comparison a OP b that a vector select of the given type can evaluate, which
+// requires a signed integral type for the compared operands (or constants that fit), and
+// a signed or equality comparison OP.
+static bool IsVectorizableSelectCondition(HInstruction* condition, DataType::Type type) {
+  if (!condition->IsCondition() ||
+      condition->AsCondition()->GetCondition() > kCondGE ||
+      !DataType::IsIntegralType(type) ||
+      type != HVecOperation::ToSignedType(type)) {
+    return false;
+  }
+  for (HInstruction* input : condition->GetInputs()) {
+    int64_t value = 0;
+    if (IsInt64AndGet(input, /*out*/ &value)) {
+      if (value < DataType::MinValueOfIntegralType(type) ||
+          value > DataType::MaxValueOfIntegralType(type)) {
+        return false;
+      }
+    } else if (input->GetType() != type) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Detect a comparison a OP b that takes the early exit of a search loop and that a vector
+// any-compare can evaluate, which requires an integral type for the compared operands (or
+// constants that fit), and a signed or equality comparison OP. Unsigned types are only
+// compared for (in)equality. Sets the compared type on success.
+static bool IsVectorizableExitCondition(HInstruction* condition, /*out*/ DataType::Type* type) {
+  if (!condition->IsCondition() || condition->AsCondition()->GetCondition() > kCondGE) {
+    return false;
+  }
+  HInstruction* left = condition->InputAt(0);
+  HInstruction* right = condition->InputAt(1);
+  *type = left->IsConstant() ? right->GetType() : left->GetType();
+  if (!DataType::IsIntegralType(*type) ||
+      *type == DataType::Type::kBool ||
+      (*type != HVecOperation::ToSignedType(*type) &&
+       condition->AsCondition()->GetCondition() > kCondNE)) {
+    return false;
+  }
+  for (HInstruction* input : condition->GetInputs()) {
+    int64_t value = 0;
+    if (IsInt64AndGet(input, /*out*/ &value)) {
+      if (value < DataType::MinValueOfIntegralType(*type) ||
+          value > DataType::MaxValueOfIntegralType(*type)) {
+        return false;
+      }
+    } else if (input->GetType() != *type) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Creates the signed or equality comparison left OP right.
+static HCondition* NewCondition(ArenaAllocator* allocator,
+                                IfCondition cond,
+                                HInstruction* left,
+                                HInstruction* right,
+                                uint32_t dex_pc) {
+  switch (cond) {
+    case kCondEQ: return new (allocator) HEqual(left, right, dex_pc);
+    case kCondNE: return new (allocator) HNotEqual(left, right, dex_pc);
+    case kCondLT: return new (allocator) HLessThan(left, right, dex_pc);
+    case kCondLE: return new (allocator) HLessThanOrEqual(left, right, dex_pc);
+    case kCondGT: return new (allocator) HGreaterThan(left, right, dex_pc);
+    case kCondGE: return new (allocator) HGreaterThanOrEqual(left, right, dex_pc);
+    default:
+      LOG(FATAL) << "Unexpected condition " << cond;
+      UNREACHABLE();
+  }
+}
+
 // Forward declaration.
 static bool IsZeroExtensionAndGet(HInstruction* instruction,
                                   DataType::Type type,
@@ -472,6 +619,9 @@ HLoopOptimization::HLoopOptimization(HGraph* graph,
       last_loop_(nullptr),
       iset_(nullptr),
       reductions_(nullptr),
+      if_conversions_(nullptr),
+      if_converted_instructions_(nullptr),
+      if_converted_phis_(nullptr),
       simplified_(false),
       predicated_vectorization_mode_(codegen.SupportsPredicatedSIMD()),
       vector_length_(0),
@@ -537,6 +687,9 @@ bool HLoopOptimization::LocalRun() {
   ScopedArenaSet<HInstruction*> iset(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSafeMap<HInstruction*, HInstruction*> reds(
       std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ScopedArenaVector<IfConversion> convs(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ScopedArenaVector<HInstruction*> moved(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ScopedArenaVector<IfConvertedPhi> phis(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSet<ArrayReference> refs(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSafeMap<HInstruction*, HInstruction*> map(
       std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
@@ -545,6 +698,9 @@ bool HLoopOptimization::LocalRun() {
   // Attach.
   iset_ = &iset;
   reductions_ = &reds;
+  if_conversions_ = &convs;
+  if_converted_instructions_ = &moved;
+  if_converted_phis_ = &phis;
   vector_refs_ = &refs;
   vector_map_ = &map;
   vector_permanent_map_ = &perm;
@@ -553,6 +709,9 @@ bool HLoopOptimization::LocalRun() {
   // Detach.
   iset_ = nullptr;
   reductions_ = nullptr;
+  if_conversions_ = nullptr;
+  if_converted_instructions_ = nullptr;
+  if_converted_phis_ = nullptr;
   vector_refs_ = nullptr;
   vector_map_ = nullptr;
   vector_permanent_map_ = nullptr;
@@ -787,6 +946,218 @@ void HLoopOptimization::SimplifyBlocks(LoopNode* node) {
   }
 }
 
+bool HLoopOptimization::TryIfConvertLoopBody(LoopNode* node) {
+  // Only a loop-body that consists of a single basic block is vectorized, so flatten
+  // if-then-else control flow in the loop-body into selects, which are vectorized as
+  // a blend (or a predicated select) of the values computed by both branches. This
+  // is recorded, so that it can be undone when the loop is not vectorized after all.
+  if_conversions_->clear();
+  if_converted_instructions_->clear();
+  if_converted_phis_->clear();
+  if (!kEnableVectorization || graph_->IsDebuggable()) {
+    return false;
+  }
+  HBasicBlock* header = node->loop_info->GetHeader();
+  bool changed = false;
+  bool converted;
+  do {
+    converted = false;
+    for (HBlocksInLoopIterator it(*node->loop_info); !it.Done(); it.Advance()) {
+      HBasicBlock* block = it.Current();
+      if (block != header && block->EndsWithIf() && TryIfConvertDiamond(node, block)) {
+        converted = changed = true;
+        break;  // restart, since the blocks of the loop-body changed
+      }
+    }
+  } while (converted);
+  if (changed) {
+    induction_range_.ReVisit(node->loop_info);
+  }
+  return changed;
+}
+
+bool HLoopOptimization::TryIfConvertDiamond(LoopNode* node, HBasicBlock* block) {
+  HIf* if_instruction = block->GetLastInstruction()->AsIf();
+  HBasicBlock* true_block = if_instruction->IfTrueSuccessor();
+  HBasicBlock* false_block = if_instruction->IfFalseSuccessor();
+  if (true_block == false_block ||
+      !IsIfConvertibleBranch(node->loop_info, true_block, block) ||
+      !IsIfConvertibleBranch(node->loop_info, false_block, block) ||
+      true_block->GetSingleSuccessor() != false_block->GetSingleSuccessor()) {
+    return false;
+  }
+  HBasicBlock* merge_block = true_block->GetSingleSuccessor();
+  if (merge_block == node->loop_info->GetHeader() ||
+      merge_block->GetPredecessors().size() != 2u ||
+      // Undoing the if-conversion needs an instruction in front of the merged blocks.
+      (block->GetFirstInstruction() == if_instruction &&
+       true_block->IsSingleGoto() &&
+       false_block->IsSingleGoto())) {
+    return false;
+  }
+  IfConversion conversion = {};
+  conversion.condition = if_instruction->InputAt(0);
+  conversion.dex_pc = if_instruction->GetDexPc();
+  conversion.true_dex_pc = true_block->GetDexPc();
+  conversion.false_dex_pc = false_block->GetDexPc();
+
+  // Execute both branches unconditionally, in front of the If.
+  while (!true_block->IsSingleGoto()) {
+    if_converted_instructions_->push_back(true_block->GetFirstInstruction());
+    true_block->GetFirstInstruction()->MoveBefore(if_instruction);
+    ++conversion.num_true_instructions;
+  }
+  while (!false_block->IsSingleGoto()) {
+    if_converted_instructions_->push_back(false_block->GetFirstInstruction());
+    false_block->GetFirstInstruction()->MoveBefore(if_instruction);
+    ++conversion.num_false_instructions;
+  }
+
+  // Select the resulting value of every phi. A conditional accumulation c ? x + y : x is
+  // rewritten into x + (c ? y : 0), which keeps the accumulation recognizable as a reduction.
+  HInstruction* condition = conversion.condition;
+  size_t predecessor_index_true = merge_block->GetPredecessorIndexOf(true_block);
+  size_t predecessor_index_false = merge_block->GetPredecessorIndexOf(false_block);
+  for (HInstructionIterator it(merge_block->GetPhis()); !it.Done(); it.Advance()) {
+    HPhi* phi = it.Current()->AsPhi();
+    HInstruction* true_value = phi->InputAt(predecessor_index_true);
+    HInstruction* false_value = phi->InputAt(predecessor_index_false);
+    HInstruction* value = nullptr;
+    HSelect* select = nullptr;
+    size_t addend_index = 0;
+    if (IsAccumulationInto(true_value, false_value, &addend_index) &&
+        condition->StrictlyDominates(true_value)) {
+      HInstruction* addend = true_value->InputAt(addend_index);
+      select = new (global_allocator_) HSelect(
+          condition,
+          addend,
+          graph_->GetConstant(true_value->GetType(), 0),
+          if_instruction->GetDexPc());
+      true_value->GetBlock()->InsertInstructionBefore(select, true_value);
+      true_value->ReplaceInput(select, addend_index);
+      value = true_value;
+    } else if (IsAccumulationInto(false_value, true_value, &addend_index) &&
+               condition->StrictlyDominates(false_value)) {
+      HInstruction* addend = false_value->InputAt(addend_index);
+      select = new (global_allocator_) HSelect(
+          condition,
+          graph_->GetConstant(false_value->GetType(), 0),
+          addend,
+          if_instruction->GetDexPc());
+      false_value->GetBlock()->InsertInstructionBefore(select, false_value);
+      false_value->ReplaceInput(select, addend_index);
+      value = false_value;
+    } else {
+      select = new (global_allocator_) HSelect(
+          condition, true_value, false_value, if_instruction->GetDexPc());
+      if (phi->GetType() == DataType::Type::kReference) {
+        select->SetReferenceTypeInfoIfValid(phi->GetReferenceTypeInfo());
+      }
+      block->InsertInstructionBefore(select, if_instruction);
+      value = select;
+    }
+    phi->ReplaceInput(value, predecessor_index_false);
+    if_converted_phis_->push_back(IfConvertedPhi{value,
+                                                 select,
+                                                 true_value,
+                                                 false_value,
+                                                 addend_index,
+                                                 phi->GetRegNumber(),
+                                                 phi->GetType()});
+    ++conversion.num_phis;
+  }
+  conversion.split_after = if_instruction->GetPrevious();
+  DCHECK(conversion.split_after != nullptr);
+  if_conversions_->push_back(conversion);
+
+  // Removing the true branch also removes the phis, now that the merge block has a
+  // single predecessor left. Then merge the remaining blocks which are connected by Gotos.
+  true_block->DisconnectAndDelete();
+  DCHECK_EQ(block->GetSingleSuccessor(), false_block);
+  block->MergeWith(false_block);
+  DCHECK_EQ(block->GetSingleSuccessor(), merge_block);
+  DCHECK(merge_block->GetPhis().IsEmpty());
+  block->MergeWith(merge_block);
+  return true;
+}
+
+void HLoopOptimization::UndoIfConversion(LoopNode* node) {
+  // Undo the if-conversions in reverse order, so that each one finds the loop-body
+  // as it left it.
+  while (!if_conversions_->empty()) {
+    const IfConversion& conversion = if_conversions_->back();
+
+    // Split the merged blocks off again, and reconnect them through new branches.
+    HBasicBlock* block = conversion.split_after->GetBlock();
+    HBasicBlock* merge_block = block->SplitBefore(conversion.split_after->GetNext(),
+                                                  /*require_graph_not_in_ssa_form=*/ false);
+    graph_->UpdateLoopAndTryInformationOfNewBlock(
+        merge_block, block, /*replace_if_back_edge=*/ true);
+    block->RemoveSuccessor(merge_block);
+    merge_block->RemovePredecessor(block);
+    auto new_branch = [&](uint32_t dex_pc) {
+      HBasicBlock* branch = new (global_allocator_) HBasicBlock(graph_, dex_pc);
+      graph_->AddBlock(branch);
+      branch->AddInstruction(new (global_allocator_) HGoto(dex_pc));
+      graph_->UpdateLoopAndTryInformationOfNewBlock(
+          branch, block, /*replace_if_back_edge=*/ false);
+      block->AddSuccessor(branch);
+      branch->AddSuccessor(merge_block);
+      return branch;
+    };
+    HBasicBlock* true_block = new_branch(conversion.true_dex_pc);
+    HBasicBlock* false_block = new_branch(conversion.false_dex_pc);
+    block->ReplaceAndRemoveInstructionWith(
+        block->GetLastInstruction(),
+        new (global_allocator_) HIf(conversion.condition, conversion.dex_pc));
+
+    // Move the instructions of both branches back.
+    size_t false_begin = if_converted_instructions_->size() - conversion.num_false_instructions;
+    size_t true_begin = false_begin - conversion.num_true_instructions;
+    for (size_t i = true_begin; i != false_begin; ++i) {
+      (*if_converted_instructions_)[i]->MoveBefore(true_block->GetLastInstruction());
+    }
+    for (size_t i = false_begin; i != if_converted_instructions_->size(); ++i) {
+      (*if_converted_instructions_)[i]->MoveBefore(false_block->GetLastInstruction());
+    }
+    if_converted_instructions_->resize(true_begin);
+
+    // Restore the phis, in place of the values that replaced them.
+    size_t phis_begin = if_converted_phis_->size() - conversion.num_phis;
+    for (size_t i = phis_begin; i != if_converted_phis_->size(); ++i) {
+      const IfConvertedPhi& converted = (*if_converted_phis_)[i];
+      HSelect* select = converted.select;
+      if (converted.value != select) {
+        HInstruction* addend = (converted.value == converted.true_value)
+            ? select->GetTrueValue()
+            : select->GetFalseValue();
+        converted.value->ReplaceInput(addend, converted.addend_index);
+      }
+      HPhi* phi = new (global_allocator_) HPhi(global_allocator_,
+                                               converted.reg_number,
+                                               0,
+                                               converted.type);
+      merge_block->AddPhi(phi);
+      converted.value->ReplaceWith(phi);
+      phi->AddInput(converted.true_value);
+      phi->AddInput(converted.false_value);
+      if (converted.type == DataType::Type::kReference) {
+        phi->SetReferenceTypeInfoIfValid(select->GetReferenceTypeInfo());
+      }
+      select->GetBlock()->RemoveInstruction(select);
+    }
+    if_converted_phis_->resize(phis_begin);
+    if_conversions_->pop_back();
+  }
+  DCHECK(if_converted_instructions_->empty());
+  DCHECK(if_converted_phis_->empty());
+
+  // Recompute dominance, since the loop-body has new blocks.
+  graph_->ClearDominanceInformation();
+  graph_->ComputeDominanceInformation();
+  induction_range_.ReVisit(node->loop_info);
+}
+
 bool HLoopOptimization::TryOptimizeInnerLoopFinite(LoopNode* node) {
   HBasicBlock* header = node->loop_info->GetHeader();
   HBasicBlock* preheader = node->loop_info->GetPreHeader();
@@ -862,8 +1233,216 @@ bool HLoopOptimization::TryOptimizeInnerLoopFinite(LoopNode* node) {
   return false;
 }
 
+bool HLoopOptimization::TryVectorizeEarlyExitLoop(LoopNode* node) {
+  // Recognize a search loop
+  //
+  //   header: i = phi(lo, i'); if (i >= hi) goto exit;
+  //   body:   if (a[i] OP x) goto early_exit;   // no side effects
+  //   latch:  i' = i + 1; goto header;
+  //
+  // and insert a vector loop in front of it that skips all vectors of iterations
+  // that do not take the early exit:
+  //
+  //   for (j = 0, found = false; j < vtc && !found; j += VL)
+  //     found = any(a[j:j+VL] OP x);
+  //   i = lo + (found ? j - VL : j);
+  //
+  // The original loop then serves as the cleanup loop that finds the exact
+  // iteration taking the exit, or that executes the remaining iterations.
+  // Since the skipped iterations have no side effects, this merely reduces
+  // the number of iterations executed by the original loop.
+  if (!kEnableVectorization || graph_->IsDebuggable()) {
+    return false;
+  }
+  HLoopInformation* loop_info = node->loop_info;
+  HBasicBlock* header = loop_info->GetHeader();
+  HBasicBlock* preheader = loop_info->GetPreHeader();
+  int64_t trip_count = 0;
+  HPhi* main_phi = nullptr;
+  if (!induction_range_.IsFinite(loop_info, &trip_count) ||
+      !TrySetSimpleLoopHeader(header, &main_phi) ||
+      !reductions_->empty()) {
+    return false;
+  }
+  // Ensure the loop consists of the header, a body ending in the early exit and a latch.
+  size_t num_blocks = 0;
+  for (HBlocksInLoopIterator it(*loop_info); !it.Done(); it.Advance()) {
+    ++num_blocks;
+  }
+  HBasicBlock* body = loop_info->Contains(*header->GetSuccessors()[0])
+      ? header->GetSuccessors()[0]
+      : header->GetSuccessors()[1];
+  if (num_blocks != 3u || body->GetPredecessors().size() != 1u || !body->EndsWithIf()) {
+    return false;
+  }
+  HIf* exit_if = body->GetLastInstruction()->AsIf();
+  HBasicBlock* latch = exit_if->IfFalseSuccessor();
+  HBasicBlock* exit = exit_if->IfTrueSuccessor();
+  bool exits_on_true = !loop_info->Contains(*exit);
+  if (!exits_on_true) {
+    std::swap(latch, exit);
+  }
+  if (loop_info->Contains(*exit) ||
+      !loop_info->Contains(*latch) ||
+      latch->GetPredecessors().size() != 1u ||
+      latch->GetSuccessors().size() != 1u ||
+      !IsEmptyBody(latch)) {
+    return false;
+  }
+  DCHECK_EQ(latch->GetSingleSuccessor(), header);
+  // Ensure the skipped iterations are not observable.
+  for (HInstructionIterator it(body->GetInstructions()); !it.Done(); it.Advance()) {
+    if (it.Current()->HasSideEffects() || it.Current()->CanThrow()) {
+      return false;
+    }
+  }
+  HInstruction* condition = exit_if->InputAt(0);
+  DataType::Type type = DataType::Type::kVoid;
+  if (condition->GetBlock() != body || !IsVectorizableExitCondition(condition, &type)) {
+    return false;
+  }
+  IfCondition cond = exits_on_true
+      ? condition->AsCondition()->GetCondition()
+      : condition->AsCondition()->GetOppositeCondition();
+  HInstruction* left = condition->InputAt(0);
+  HInstruction* right = condition->InputAt(1);
+
+  // Reset vector bookkeeping.
+  vector_length_ = 0;
+  vector_refs_->clear();
+  vector_static_peeling_factor_ = 0;
+  vector_dynamic_peeling_candidate_ = nullptr;
+  vector_runtime_test_a_ =
+  vector_runtime_test_b_ = nullptr;
+
+  // Test the comparison for vectorization, and require a unit stride main induction
+  // i = j + offset, so that the original loop can resume at any iteration j.
+  DataType::Type induc_type = main_phi->GetType();
+  uint64_t restrictions = kNone;
+  HInstruction* offset = nullptr;
+  if (!TrySetVectorType(type, &restrictions) ||
+      HasVectorRestrictions(restrictions, kNoCompare) ||
+      !VectorizeUse(node, left, /*generate_code*/ false, type, restrictions) ||
+      !VectorizeUse(node, right, /*generate_code*/ false, type, restrictions) ||
+      (trip_count != 0 && trip_count < 2 * static_cast<int64_t>(vector_length_)) ||
+      !induction_range_.IsUnitStride(header, main_phi, graph_, &offset) ||
+      offset->GetType() != induc_type) {
+    return false;
+  }
+
+  // Generate loop control:
+  // stc = <trip-count>;
+  // vtc = stc - stc % VL;
+  HInstruction* stc = induction_range_.GenerateTripCount(loop_info, graph_, preheader);
+  if (stc == nullptr) {
+    return false;
+  }
+  DCHECK(IsPowerOfTwo(vector_length_));
+  HInstruction* rem = Insert(
+      preheader, new (global_allocator_) HAnd(induc_type,
+                                              stc,
+                                              graph_->GetConstant(induc_type, vector_length_ - 1)));
+  HInstruction* vtc = Insert(preheader, new (global_allocator_) HSub(induc_type, stc, rem));
+
+  // Generate the vector loop header:
+  // for (j = 0, found = false; !(j >= vtc || found); j += VL)
+  vector_preheader_ = preheader;
+  vector_header_ = graph_->TransformLoopForEarlyExitVectorization(header);
+  vector_body_ = vector_header_->GetSuccessors()[1];
+  HBasicBlock* new_preheader = vector_header_->GetSuccessors()[0];
+  HPhi* phi = new (global_allocator_) HPhi(global_allocator_,
+                                           kNoRegNumber,
+                                           0,
+                                           HPhi::ToPhiType(induc_type));
+  HPhi* found = new (global_allocator_) HPhi(global_allocator_,
+                                             kNoRegNumber,
+                                             0,
+                                             HPhi::ToPhiType(DataType::Type::kBool));
+  vector_header_->AddPhi(phi);
+  vector_header_->AddPhi(found);
+  HInstruction* done = new (global_allocator_) HAboveOrEqual(phi, vtc);
+  vector_header_->AddInstruction(done);
+  HInstruction* stop = new (global_allocator_) HOr(DataType::Type::kInt32, done, found);
+  vector_header_->AddInstruction(stop);
+  vector_header_->AddInstruction(new (global_allocator_) HIf(stop));
+
+  // Generate the vector loop body:
+  // found = any(a[j:j+VL] OP x);
+  vector_mode_ = kVector;
+  vector_index_ = phi;
+  vector_map_->clear();
+  vector_permanent_map_->clear();
+  HVecPredSetAll* set_pred = nullptr;
+  if (IsInPredicatedVectorizationMode()) {
+    set_pred = new (global_allocator_) HVecPredSetAll(global_allocator_,
+                                                      graph_->GetIntConstant(1),
+                                                      type,
+                                                      vector_length_,
+                                                      0u);
+    Insert(vector_body_, set_pred);
+  }
+  bool vectorized_left = VectorizeUse(node, left, /*generate_code*/ true, type, restrictions);
+  bool vectorized_right = VectorizeUse(node, right, /*generate_code*/ true, type, restrictions);
+  DCHECK(vectorized_left && vectorized_right);
+  for (HInstructionIterator it(body->GetInstructions()); !it.Done(); it.Advance()) {
+    auto i = vector_map_->find(it.Current());
+    if (i != vector_map_->end() && !i->second->IsInBlock()) {
+      Insert(vector_body_, i->second);
+      if (set_pred != nullptr && i->second->IsVecOperation()) {
+        i->second->AsVecOperation()->SetMergingGoverningPredicate(set_pred);
+      }
+    }
+  }
+  HVecCompareAny* any = new (global_allocator_) HVecCompareAny(global_allocator_,
+                                                               vector_map_->Get(left),
+                                                               vector_map_->Get(right),
+                                                               cond,
+                                                               type,
+                                                               vector_length_,
+                                                               exit_if->GetDexPc());
+  Insert(vector_body_, any);
+  if (set_pred != nullptr) {
+    any->SetMergingGoverningPredicate(set_pred);
+  }
+  HInstruction* next = Insert(vector_body_, new (global_allocator_) HAdd(
+      induc_type, phi, graph_->GetConstant(induc_type, vector_length_)));
+  phi->AddInput(graph_->GetConstant(induc_type, 0));
+  phi->AddInput(next);
+  found->AddInput(graph_->GetIntConstant(0));
+  found->AddInput(any);
+
+  // Resume the original loop at the first iteration of the vector that takes
+  // the early exit, if any:
+  // i = (found ? j - VL : j) + offset;
+  HInstruction* previous = Insert(new_preheader, new (global_allocator_) HSub(
+      induc_type, phi, graph_->GetConstant(induc_type, vector_length_)));
+  HInstruction* start = Insert(new_preheader,
+                               new (global_allocator_) HSelect(found, previous, phi, kNoDexPc));
+  if (!IsInt64Value(offset, 0)) {
+    start = Insert(new_preheader, new (global_allocator_) HAdd(induc_type, start, offset));
+  }
+  main_phi->ReplaceInput(start, 0);
+  induction_range_.ReVisit(loop_info);
+
+  graph_->SetHasSIMD(true);  // flag SIMD usage
+  MaybeRecordStat(stats_, MethodCompilationStat::kLoopVectorizedEarlyExit);
+  return true;
+}
+
 bool HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
-  return TryOptimizeInnerLoopFinite(node) || TryLoopScalarOpts(node);
+  // Keep a flattened loop-body only when it is vectorized, since executing both branches
+  // of every if-then-else is not a gain otherwise.
+  if (TryIfConvertLoopBody(node)) {
+    if (TryOptimizeInnerLoopFinite(node)) {
+      MaybeRecordStat(
+          stats_, MethodCompilationStat::kLoopBodyIfConverted, if_conversions_->size());
+      return true;
+    }
+    UndoIfConversion(node);
+  }
+  return TryOptimizeInnerLoopFinite(node) ||
+         TryVectorizeEarlyExitLoop(node) ||
+         TryLoopScalarOpts(node);
 }
 
 //
@@ -1098,7 +1677,7 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
       uint32_t vote = (offset == 0)
           ? 0
           : ((desired_alignment - offset) >> DataType::SizeShift(i->type));
-      DCHECK_LT(vote, 16u);
+      DCHECK_LT(vote, desired_alignment);
       ++peeling_votes[vote];
     } else if (BaseAlignment() >= desired_alignment &&
                num_same_alignment > max_num_same_alignment) {
@@ -1661,6 +2240,29 @@ bool HLoopOptimization::VectorizeUse(LoopNode* node,
       }
       return true;
     }
+  } else if (instruction->IsSelect()) {
+    // Deal with vector restrictions.
+    if (HasVectorRestrictions(restrictions, kNoCompare)) {
+      return false;
+    }
+    // Accept a select c ? x : y on a comparison c = a OP b for
+    // (1) signed integral vector type, which the compared operands share,
+    // (2) signed or equality comparison OP,
+    // (3) vectorizable operands x, y, a, and b.
+    HSelect* select = instruction->AsSelect();
+    HInstruction* condition = select->GetCondition();
+    if (IsVectorizableSelectCondition(condition, type) &&
+        (condition->GetBlock() == select->GetBlock() ||
+         node->loop_info->IsDefinedOutOfTheLoop(condition)) &&
+        VectorizeUse(node, condition->InputAt(0), generate_code, type, restrictions) &&
+        VectorizeUse(node, condition->InputAt(1), generate_code, type, restrictions) &&
+        VectorizeUse(node, select->GetFalseValue(), generate_code, type, restrictions) &&
+        VectorizeUse(node, select->GetTrueValue(), generate_code, type, restrictions)) {
+      if (generate_code) {
+        GenerateVecSelect(select, type);
+      }
+      return true;
+    }
   }
   return false;
 }
@@ -1766,7 +2368,8 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
       }
     case InstructionSet::kX86:
     case InstructionSet::kX86_64:
-      // Allow vectorization for SSE4.1-enabled X86 devices only (128-bit SIMD).
+      // Allow vectorization for SSE4.1-enabled X86 devices only. The vector length follows the
+      // SIMD register width of the code generator: 128-bit, or 256-bit on AVX2-enabled X86_64.
       if (features->AsX86InstructionSetFeatures()->HasSSE4_1()) {
         switch (type) {
           case DataType::Type::kBool:
@@ -1780,7 +2383,7 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoUnroundedHAdd |
                              kNoSAD |
                              kNoDotProd;
-            return TrySetVectorLength(type, 16);
+            return TrySetVectorLength(type, simd_register_size_ / DataType::Size(type));
           case DataType::Type::kUint16:
             *restrictions |= kNoDiv |
                              kNoAbs |
@@ -1788,26 +2391,29 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoUnroundedHAdd |
                              kNoSAD |
                              kNoDotProd;
-            return TrySetVectorLength(type, 8);
+            return TrySetVectorLength(type, simd_register_size_ / DataType::Size(type));
           case DataType::Type::kInt16:
             *restrictions |= kNoDiv |
                              kNoAbs |
                              kNoSignedHAdd |
                              kNoUnroundedHAdd |
                              kNoSAD;
-            return TrySetVectorLength(type, 8);
+            return TrySetVectorLength(type, simd_register_size_ / DataType::Size(type));
           case DataType::Type::kInt32:
             *restrictions |= kNoDiv | kNoSAD;
-            return TrySetVectorLength(type, 4);
+            return TrySetVectorLength(type, simd_register_size_ / DataType::Size(type));
           case DataType::Type::kInt64:
             *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD;
-            return TrySetVectorLength(type, 2);
+            if (!features->AsX86InstructionSetFeatures()->HasSSE4_2()) {
+              *restrictions |= kNoCompare;  // no pcmpgtq
+            }
+            return TrySetVectorLength(type, simd_register_size_ / DataType::Size(type));
           case DataType::Type::kFloat32:
             *restrictions |= kNoReduction;
-            return TrySetVectorLength(type, 4);
+            return TrySetVectorLength(type, simd_register_size_ / DataType::Size(type));
           case DataType::Type::kFloat64:
             *restrictions |= kNoReduction;
-            return TrySetVectorLength(type, 2);
+            return TrySetVectorLength(type, simd_register_size_ / DataType::Size(type));
           default:
             break;
         }  // switch type
@@ -2139,6 +2745,44 @@ void HLoopOptimization::GenerateVecOp(HInstruction* org,
 
 #undef GENERATE_VEC
 
+void HLoopOptimization::GenerateVecSelect(HSelect* org, DataType::Type type) {
+  HInstruction* condition = org->GetCondition();
+  HInstruction* false_value = vector_map_->Get(org->GetFalseValue());
+  HInstruction* true_value = vector_map_->Get(org->GetTrueValue());
+  HInstruction* left = vector_map_->Get(condition->InputAt(0));
+  HInstruction* right = vector_map_->Get(condition->InputAt(1));
+  HInstruction* vector = nullptr;
+  if (vector_mode_ == kVector) {
+    // The comparison is folded into the vector select.
+    vector = new (global_allocator_) HVecSelect(global_allocator_,
+                                                false_value,
+                                                true_value,
+                                                left,
+                                                right,
+                                                condition->AsCondition()->GetCondition(),
+                                                type,
+                                                vector_length_,
+                                                org->GetDexPc());
+  } else {
+    DCHECK(vector_mode_ == kSequential);
+    // A comparison in the loop-body is recreated once (it is inserted in program
+    // order, and may be shared between selects); a loop invariant one is reused.
+    if (vector_map_->find(condition) == vector_map_->end()) {
+      vector_map_->Put(condition,
+                       condition->GetBlock() != org->GetBlock()
+                           ? condition
+                           : NewCondition(global_allocator_,
+                                          condition->AsCondition()->GetCondition(),
+                                          left,
+                                          right,
+                                          condition->GetDexPc()));
+    }
+    vector = new (global_allocator_)
+        HSelect(vector_map_->Get(condition), true_value, false_value, org->GetDexPc());
+  }
+  vector_map_->Put(org, vector);
+}
+
 //
 // Vectorization idioms.
 //
@@ -101,6 +101,7 @@ class HLoopOptimization : public HOptimization {
     kNoSAD           = 1 << 11,  // no sum of absolute differences (SAD)
     kNoWideSAD       = 1 << 12,  // no sum of absolute differences (SAD) with operand widening
     kNoDotProd       = 1 << 13,  // no dot product
+    kNoCompare       = 1 << 14,  // no comparison (select, early exit)
   };
 
   /*
@@ -136,6 +137,35 @@ class HLoopOptimization : public HOptimization {
     bool is_string_char_at;  // compressed string read
   };
 
+  /*
+   * Representation of an if-then-else flattened by if-conversion, with what is needed
+   * to undo it. The instructions moved out of the branches and the replaced phis are
+   * kept in separate lists, in the order of the if-conversions.
+   */
+  struct IfConversion {
+    HInstruction* split_after;      // last instruction in front of the merged blocks
+    HInstruction* condition;        // condition of the removed if
+    uint32_t dex_pc;                // dex pc of the removed if
+    uint32_t true_dex_pc;           // dex pc of the removed true branch
+    uint32_t false_dex_pc;          // dex pc of the removed false branch
+    size_t num_true_instructions;   // instructions moved out of the true branch
+    size_t num_false_instructions;  // instructions moved out of the false branch
+    size_t num_phis;                // phis replaced in the merge block
+  };
+
+  /*
+   * Representation of a phi replaced by if-conversion.
+   */
+  struct IfConvertedPhi {
+    HInstruction* value;        // replacement of the phi
+    HSelect* select;            // select added for the phi
+    HInstruction* true_value;   // phi input from the true branch
+    HInstruction* false_value;  // phi input from the false branch
+    size_t addend_index;        // input of an accumulation replaced by the select
+    uint32_t reg_number;        // dex register of the phi
+    DataType::Type type;        // type of the phi
+  };
+
   //
   // Loop setup and traversal.
   //
@@ -160,10 +190,25 @@ class HLoopOptimization : public HOptimization {
   void SimplifyInduction(LoopNode* node);
   void SimplifyBlocks(LoopNode* node);
 
+  // Flattens if-then-else control flow in the loop-body of an inner loop into selects.
+  // Returns true if anything changed.
+  bool TryIfConvertLoopBody(LoopNode* node);
+
+  // Flattens the if-then-else that ends `block`, if both branches are small and free of side
+  // effects, by executing both branches and selecting the results. Returns true on success.
+  bool TryIfConvertDiamond(LoopNode* node, HBasicBlock* block);
+
+  // Restores the if-then-else control flow flattened by TryIfConvertLoopBody().
+  void UndoIfConversion(LoopNode* node);
+
   // Performs optimizations specific to inner loop with finite header logic (empty loop removal,
   // unrolling, vectorization). Returns true if anything changed.
   bool TryOptimizeInnerLoopFinite(LoopNode* node);
 
+  // Vectorizes a search loop with a single early exit by means of a vector loop that skips
+  // ahead to the first vector that takes the exit. Returns true on success.
+  bool TryVectorizeEarlyExitLoop(LoopNode* node);
+
   // Performs optimizations specific to inner loop. Returns true if anything changed.
   bool OptimizeInnerLoop(LoopNode* node);
 
@@ -243,6 +288,7 @@ class HLoopOptimization : public HOptimization {
                      HInstruction* opa,
                      HInstruction* opb,
                      DataType::Type type);
+  void GenerateVecSelect(HSelect* org, DataType::Type type);
 
   // Vectorization idioms.
   bool VectorizeSaturationIdiom(LoopNode* node,
@@ -338,6 +384,13 @@ class HLoopOptimization : public HOptimization {
   // Contents reside in phase-local heap memory.
   ScopedArenaSafeMap<HInstruction*, HInstruction*>* reductions_;
 
+  // Temporary bookkeeping of the if-conversions in the current inner loop, which are
+  // undone when they do not lead to vectorization.
+  // Contents reside in phase-local heap memory.
+  ScopedArenaVector<IfConversion>* if_conversions_;
+  ScopedArenaVector<HInstruction*>* if_converted_instructions_;
+  ScopedArenaVector<IfConvertedPhi>* if_converted_phis_;
+
   // Flag that tracks if any simplifications have occurred.
   bool simplified_;
 
@@ -3188,6 +3188,67 @@ HBasicBlock* HGraph::TransformLoopForVectorization(HBasicBlock* header,
   return new_pre_header;
 }
 
+HBasicBlock* HGraph::TransformLoopForEarlyExitVectorization(HBasicBlock* header) {
+  DCHECK(header->IsLoopHeader());
+  HLoopInformation* loop = header->GetLoopInformation();
+  HBasicBlock* old_pre_header = loop->GetPreHeader();
+  DCHECK_EQ(header->GetDominator(), old_pre_header);
+
+  // Add new loop blocks.
+  HBasicBlock* new_header = new (allocator_) HBasicBlock(this, header->GetDexPc());
+  HBasicBlock* new_body = new (allocator_) HBasicBlock(this, header->GetDexPc());
+  HBasicBlock* new_pre_header = new (allocator_) HBasicBlock(this, header->GetDexPc());
+  AddBlock(new_header);
+  AddBlock(new_body);
+  AddBlock(new_pre_header);
+
+  // Set up control flow, keeping the preheader as first predecessor of the header.
+  header->ReplacePredecessor(old_pre_header, new_pre_header);
+  old_pre_header->AddSuccessor(new_header);
+  new_header->AddSuccessor(new_pre_header);
+  new_header->AddSuccessor(new_body);
+  new_body->AddSuccessor(new_header);
+
+  // Set up dominators.
+  old_pre_header->ReplaceDominatedBlock(header, new_header);
+  new_header->SetDominator(old_pre_header);
+  new_header->dominated_blocks_.push_back(new_body);
+  new_body->SetDominator(new_header);
+  new_header->dominated_blocks_.push_back(new_pre_header);
+  new_pre_header->SetDominator(new_header);
+  new_pre_header->dominated_blocks_.push_back(header);
+  header->SetDominator(new_pre_header);
+
+  // Fix reverse post order.
+  size_t index_of_header = IndexOfElement(reverse_post_order_, header);
+  MakeRoomFor(&reverse_post_order_, 3, index_of_header - 1);
+  reverse_post_order_[index_of_header++] = new_header;
+  reverse_post_order_[index_of_header++] = new_body;
+  reverse_post_order_[index_of_header++] = new_pre_header;
+
+  // Add gotos and suspend check (client must add conditional in header).
+  new_pre_header->AddInstruction(new (allocator_) HGoto());
+  HSuspendCheck* suspend_check = new (allocator_) HSuspendCheck(header->GetDexPc());
+  new_header->AddInstruction(suspend_check);
+  new_body->AddInstruction(new (allocator_) HGoto());
+  DCHECK(loop->GetSuspendCheck() != nullptr);
+  suspend_check->CopyEnvironmentFromWithLoopPhiAdjustment(
+      loop->GetSuspendCheck()->GetEnvironment(), header);
+
+  // Update loop information.
+  new_header->AddBackEdge(new_body);
+  new_header->GetLoopInformation()->SetSuspendCheck(suspend_check);
+  new_header->GetLoopInformation()->Populate();
+  new_pre_header->SetLoopInformation(old_pre_header->GetLoopInformation());  // outward
+  HLoopInformationOutwardIterator it(*new_header);
+  for (it.Advance(); !it.Done(); it.Advance()) {
+    it.Current()->Add(new_header);
+    it.Current()->Add(new_body);
+    it.Current()->Add(new_pre_header);
+  }
+  return new_header;
+}
+
 static void CheckAgainstUpperBound(ReferenceTypeInfo rti, ReferenceTypeInfo upper_bound_rti)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   if (rti.IsValid()) {
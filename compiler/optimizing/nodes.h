@@ -133,6 +133,8 @@ enum IfCondition {
   kCondLast = kCondAE,
 };
 
+std::ostream& operator<<(std::ostream& os, IfCondition rhs);
+
 enum GraphAnalysisResult {
   kAnalysisSkipped,
   kAnalysisInvalidBytecode,
@@ -503,6 +505,10 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
                                              HBasicBlock* body,
                                              HBasicBlock* exit);
 
+  // Adds a new loop directly before the loop with the given header, which gets a new
+  // preheader that is the single exit of the new loop. Returns the new header.
+  HBasicBlock* TransformLoopForEarlyExitVectorization(HBasicBlock* header);
+
   // Removes `block` from the graph. Assumes `block` has been disconnected from
   // other blocks and has no instructions or phis.
   void DeleteDeadEmptyBlock(HBasicBlock* block);
@@ -1632,6 +1638,8 @@ class HLoopInformationOutwardIterator : public ValueObject {
   M(VecMultiplyAccumulate, VecOperation)                                \
   M(VecSADAccumulate, VecOperation)                                     \
   M(VecDotProd, VecOperation)                                           \
+  M(VecSelect, VecOperation)                                            \
+  M(VecCompareAny, VecOperation)                                        \
   M(VecLoad, VecMemoryOperation)                                        \
   M(VecStore, VecMemoryOperation)                                       \
   M(VecPredSetAll, VecPredSetOperation)                                 \
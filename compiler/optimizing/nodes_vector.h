@@ -1149,6 +1149,127 @@ class HVecDotProd final : public HVecOperation {
   static_assert(kNumberOfHDotProdPackedBits <= kMaxNumberOfPackedBits, "Too many packed fields.");
 };
 
+// Selects every component from one of two vectors, depending on the outcome of comparing the
+// corresponding components of two other vectors,
+// viz. select([ f1, .. , fn ], [ t1, .. , tn ], [ x1, .. , xn ], [ y1, .. , yn ], OP) =
+//          [ x1 OP y1 ? t1 : f1, .. , xn OP yn ? tn : fn ],
+//      for signed integral operands and a signed or equality condition OP.
+//
+// Like HSelect, the false value comes first to allow a SameAsFirstInput policy.
+class HVecSelect final : public HVecOperation {
+ public:
+  HVecSelect(ArenaAllocator* allocator,
+             HInstruction* false_value,
+             HInstruction* true_value,
+             HInstruction* left,
+             HInstruction* right,
+             IfCondition condition,
+             DataType::Type packed_type,
+             size_t vector_length,
+             uint32_t dex_pc)
+      : HVecOperation(kVecSelect,
+                      allocator,
+                      packed_type,
+                      SideEffects::None(),
+                      /* number_of_inputs= */ 4,
+                      vector_length,
+                      dex_pc) {
+    DCHECK(HasConsistentPackedTypes(false_value, packed_type));
+    DCHECK(HasConsistentPackedTypes(true_value, packed_type));
+    DCHECK(HasConsistentPackedTypes(left, packed_type));
+    DCHECK(HasConsistentPackedTypes(right, packed_type));
+    DCHECK(DataType::IsIntegralType(packed_type));
+    DCHECK_LE(condition, kCondGE);
+    SetRawInputAt(0, false_value);
+    SetRawInputAt(1, true_value);
+    SetRawInputAt(2, left);
+    SetRawInputAt(3, right);
+    SetPackedField<ConditionField>(condition);
+  }
+
+  HInstruction* GetFalseValue() const { return InputAt(0); }
+  HInstruction* GetTrueValue() const { return InputAt(1); }
+  HInstruction* GetLeft() const { return InputAt(2); }
+  HInstruction* GetRight() const { return InputAt(3); }
+  IfCondition GetCondition() const { return GetPackedField<ConditionField>(); }
+
+  bool CanBeMoved() const override { return true; }
+
+  bool InstructionDataEquals(const HInstruction* other) const override {
+    DCHECK(other->IsVecSelect());
+    const HVecSelect* o = other->AsVecSelect();
+    return HVecOperation::InstructionDataEquals(o) && GetCondition() == o->GetCondition();
+  }
+
+  DECLARE_INSTRUCTION(VecSelect);
+
+ protected:
+  DEFAULT_COPY_CONSTRUCTOR(VecSelect);
+
+ private:
+  // Additional packed bits.
+  static constexpr size_t kFieldCondition = HVecOperation::kNumberOfVectorOpPackedBits;
+  static constexpr size_t kFieldConditionSize = MinimumBitsToStore(static_cast<size_t>(kCondLast));
+  static constexpr size_t kNumberOfVecSelectPackedBits = kFieldCondition + kFieldConditionSize;
+  static_assert(kNumberOfVecSelectPackedBits <= kMaxNumberOfPackedBits, "Too many packed fields.");
+  using ConditionField = BitField<IfCondition, kFieldCondition, kFieldConditionSize>;
+};
+
+// Tests a comparison on all elements for any that holds, viz. any-compare(OP, [ x1, .. , xn ],
+// [ y1, .. , yn ]) yields the scalar boolean x1 OP y1 || .. || xn OP yn. Unsigned packed types
+// are only compared for (in)equality.
+class HVecCompareAny final : public HVecOperation {
+ public:
+  HVecCompareAny(ArenaAllocator* allocator,
+                 HInstruction* left,
+                 HInstruction* right,
+                 IfCondition condition,
+                 DataType::Type packed_type,
+                 size_t vector_length,
+                 uint32_t dex_pc)
+      : HVecOperation(kVecCompareAny,
+                      allocator,
+                      packed_type,
+                      SideEffects::None(),
+                      /* number_of_inputs= */ 2,
+                      vector_length,
+                      dex_pc) {
+    DCHECK(HasConsistentPackedTypes(left, packed_type));
+    DCHECK(HasConsistentPackedTypes(right, packed_type));
+    DCHECK(DataType::IsIntegralType(packed_type));
+    DCHECK(condition <= kCondNE ||
+           (condition <= kCondGE && packed_type == ToSignedType(packed_type)));
+    SetRawInputAt(0, left);
+    SetRawInputAt(1, right);
+    SetPackedField<ConditionField>(condition);
+    // Overrides the kSIMDType set by the VecOperation constructor.
+    SetPackedField<TypeField>(DataType::Type::kBool);
+  }
+
+  HInstruction* GetLeft() const { return InputAt(0); }
+  HInstruction* GetRight() const { return InputAt(1); }
+  IfCondition GetCondition() const { return GetPackedField<ConditionField>(); }
+
+  // A test needs to stay in place, since SIMD registers are not
+  // kept alive across vector loop boundaries (yet).
+  bool CanBeMoved() const override { return false; }
+
+  DECLARE_INSTRUCTION(VecCompareAny);
+
+ protected:
+  DEFAULT_COPY_CONSTRUCTOR(VecCompareAny);
+
+ private:
+  // Additional packed bits.
+  static constexpr size_t kFieldCondition = HVecOperation::kNumberOfVectorOpPackedBits;
+  static constexpr size_t kFieldConditionSize = MinimumBitsToStore(static_cast<size_t>(kCondLast));
+  static constexpr size_t kNumberOfVecCompareAnyPackedBits =
+      kFieldCondition + kFieldConditionSize;
+  static_assert(kNumberOfVecCompareAnyPackedBits <= kMaxNumberOfPackedBits,
+                "Too many packed fields.");
+  using ConditionField = BitField<IfCondition, kFieldCondition, kFieldConditionSize>;
+};
+
 // Loads a vector from memory, viz. load(mem, 1)
 // yield the vector [ mem(1), .. , mem(n) ].
 class HVecLoad final : public HVecMemoryOperation {
@@ -414,4 +414,32 @@ TEST_F(NodesVectorTest, VectorKindMattersOnReduce) {
   EXPECT_FALSE(v1->Equals(v3));
 }
 
+TEST_F(NodesVectorTest, VectorConditionMattersOnSelect) {
+  HVecOperation* v0 = new (GetAllocator())
+      HVecReplicateScalar(GetAllocator(), int32_parameter_, DataType::Type::kInt32, 4, kNoDexPc);
+
+  HVecSelect* v1 = new (GetAllocator()) HVecSelect(
+      GetAllocator(), v0, v0, v0, v0, kCondLT, DataType::Type::kInt32, 4, kNoDexPc);
+  HVecSelect* v2 = new (GetAllocator()) HVecSelect(
+      GetAllocator(), v0, v0, v0, v0, kCondEQ, DataType::Type::kInt32, 4, kNoDexPc);
+  HVecSelect* v3 = new (GetAllocator()) HVecSelect(
+      GetAllocator(), v0, v0, v0, v0, kCondLT, DataType::Type::kInt32, 2, kNoDexPc);
+
+  EXPECT_FALSE(v0->CanBeMoved());
+  EXPECT_TRUE(v1->CanBeMoved());
+  EXPECT_TRUE(v2->CanBeMoved());
+  EXPECT_TRUE(v3->CanBeMoved());
+
+  EXPECT_EQ(kCondLT, v1->GetCondition());
+  EXPECT_EQ(kCondEQ, v2->GetCondition());
+  EXPECT_EQ(kCondLT, v3->GetCondition());
+
+  EXPECT_TRUE(v1->Equals(v1));
+  EXPECT_TRUE(v2->Equals(v2));
+  EXPECT_TRUE(v3->Equals(v3));
+
+  EXPECT_FALSE(v1->Equals(v2));  // different conditions
+  EXPECT_FALSE(v1->Equals(v3));  // different vector lengths
+}
+
 }  // namespace art
@@ -66,6 +66,7 @@ enum class MethodCompilationStat {
   kNotCompiledPhiEquivalentInOsr,
   kInlinedMonomorphicCall,
   kInlinedPolymorphicCall,
+  kInlinedMegamorphicCall,
   kMonomorphicCall,
   kPolymorphicCall,
   kMegamorphicCall,
@@ -74,6 +75,8 @@ enum class MethodCompilationStat {
   kLoopInvariantMoved,
   kLoopVectorized,
   kLoopVectorizedIdiom,
+  kLoopBodyIfConverted,
+  kLoopVectorizedEarlyExit,
   kSelectGenerated,
   kRemovedInstanceOf,
   kPropagatedIfValue,
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scheduler_x86.h"
+
+namespace art HIDDEN {
+namespace x86 {
+
+void SchedulingLatencyVisitorX86::VisitBinaryOperation(HBinaryOperation* instr) {
+  if (instr->GetResultType() != DataType::Type::kInt64) {
+    SchedulingLatencyVisitorX86Shared::VisitBinaryOperation(instr);
+    return;
+  }
+  if (instr->IsShl() || instr->IsShr() || instr->IsUShr() || instr->IsRor()) {
+    // `shld`/`shrd` followed by a fix-up for shift distances of 32 and above.
+    last_visited_internal_latency_ =
+        instr->InputAt(1)->IsConstant() ? kX86IntegerOpLatency : 3 * kX86IntegerOpLatency;
+  } else {
+    // An operation on the low half followed by one on the high half, e.g. add/adc.
+    last_visited_internal_latency_ = kX86IntegerOpLatency;
+  }
+  last_visited_latency_ = kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::HandleLongDivRemRuntimeCall(HBinaryOperation* instr) {
+  DCHECK_EQ(instr->GetResultType(), DataType::Type::kInt64);
+  // Even division by a constant calls the runtime.
+  last_visited_internal_latency_ = kX86CallInternalLatency;
+  last_visited_latency_ = kX86CallLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitDiv(HDiv* instr) {
+  if (instr->GetResultType() == DataType::Type::kInt64) {
+    HandleLongDivRemRuntimeCall(instr);
+  } else {
+    SchedulingLatencyVisitorX86Shared::VisitDiv(instr);
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitMul(HMul* instr) {
+  if (instr->GetResultType() == DataType::Type::kInt64) {
+    // Three multiplications of the halves, and two additions of their results.
+    last_visited_internal_latency_ = 2 * kX86MulIntegerLatency + kX86IntegerOpLatency;
+    last_visited_latency_ = kX86IntegerOpLatency;
+  } else {
+    SchedulingLatencyVisitorX86Shared::VisitMul(instr);
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitRem(HRem* instr) {
+  if (instr->GetResultType() == DataType::Type::kInt64) {
+    HandleLongDivRemRuntimeCall(instr);
+  } else {
+    SchedulingLatencyVisitorX86Shared::VisitRem(instr);
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitTypeConversion(HTypeConversion* instr) {
+  DataType::Type result_type = instr->GetResultType();
+  DataType::Type input_type = instr->GetInputType();
+  if ((result_type == DataType::Type::kInt64 && DataType::IsFloatingPointType(input_type)) ||
+      (input_type == DataType::Type::kInt64 && DataType::IsFloatingPointType(result_type))) {
+    // Performed with a runtime call or with the x87 FPU through the stack.
+    last_visited_internal_latency_ = kX86CallInternalLatency;
+    last_visited_latency_ = kX86CallLatency;
+  } else {
+    SchedulingLatencyVisitorX86Shared::VisitTypeConversion(instr);
+  }
+}
+
+}  // namespace x86
+}  // namespace art
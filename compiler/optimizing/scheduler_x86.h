@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SCHEDULER_X86_H_
+#define ART_COMPILER_OPTIMIZING_SCHEDULER_X86_H_
+
+#include "base/macros.h"
+#include "scheduler_x86_shared.h"
+
+namespace art HIDDEN {
+namespace x86 {
+
+// On x86, 64-bit integer values live in register pairs, so most long operations
+// expand to several instructions and long division is a runtime call.
+class SchedulingLatencyVisitorX86 final : public SchedulingLatencyVisitorX86Shared {
+ public:
+  void VisitBinaryOperation(HBinaryOperation* instr) override;
+  void VisitDiv(HDiv* instr) override;
+  void VisitMul(HMul* instr) override;
+  void VisitRem(HRem* instr) override;
+  void VisitTypeConversion(HTypeConversion* instr) override;
+
+ private:
+  void HandleLongDivRemRuntimeCall(HBinaryOperation* instr);
+};
+
+class HSchedulerX86 : public HSchedulerX86Shared {
+ public:
+  explicit HSchedulerX86(SchedulingNodeSelector* selector)
+      : HSchedulerX86Shared(&x86_latency_visitor_, selector) {}
+  ~HSchedulerX86() override {}
+
+ private:
+  SchedulingLatencyVisitorX86 x86_latency_visitor_;
+  DISALLOW_COPY_AND_ASSIGN(HSchedulerX86);
+};
+
+}  // namespace x86
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SCHEDULER_X86_H_
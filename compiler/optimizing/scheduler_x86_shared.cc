@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scheduler_x86_shared.h"
+
+#include "code_generator_utils.h"
+#include "mirror/array-inl.h"
+#include "mirror/string.h"
+
+namespace art HIDDEN {
+
+void SchedulingLatencyVisitorX86Shared::VisitBinaryOperation(HBinaryOperation* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? kX86FloatingPointOpLatency
+      : kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitX86AndNot(HX86AndNot* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitX86MaskOrResetLeastSetBit(
+    HX86MaskOrResetLeastSetBit* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitArrayGet(HArrayGet* instruction) {
+  if (instruction->IsStringCharAt() && mirror::kUseStringCompression) {
+    // Test the compression flag and branch to the appropriate load.
+    last_visited_internal_latency_ = kX86MemoryLoadLatency + kX86BranchLatency;
+  }
+  // The address computation is folded into the addressing mode.
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitArrayLength(HArrayLength* ATTRIBUTE_UNUSED) {
+  // Note that `X86MemoryOperandGeneration`, which runs after the scheduler, may
+  // fold this load into the compare of a following HBoundsCheck.
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitArraySet(HArraySet* instruction) {
+  if (instruction->NeedsTypeCheck()) {
+    // Load the classes of the array and the value to compare them.
+    last_visited_internal_latency_ = 2 * kX86MemoryLoadLatency + kX86BranchLatency;
+  }
+  last_visited_latency_ = kX86MemoryStoreLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitBoundsCheck(HBoundsCheck* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86IntegerOpLatency;
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86Shared::HandleDivRemConstantIntegral(
+    HBinaryOperation* instruction) {
+  // Follow the code path used by code generation.
+  int64_t imm = Int64FromConstant(instruction->InputAt(1)->AsConstant());
+  if (imm == 0) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = 0;
+  } else if (imm == 1 || imm == -1) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = kX86IntegerOpLatency;
+  } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+    last_visited_internal_latency_ = 3 * kX86IntegerOpLatency;
+    last_visited_latency_ = kX86IntegerOpLatency;
+  } else {
+    // Multiplication by a magic number, followed by shifts and adds.
+    DCHECK(imm <= -2 || imm >= 2);
+    last_visited_internal_latency_ = kX86MulIntegerLatency + 3 * kX86IntegerOpLatency;
+    last_visited_latency_ = kX86IntegerOpLatency;
+  }
+  if (instruction->IsRem() && imm != 0 && imm != 1 && imm != -1) {
+    // Compute the remainder from the quotient.
+    last_visited_internal_latency_ += last_visited_latency_ + kX86MulIntegerLatency;
+    last_visited_latency_ = kX86IntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitDiv(HDiv* instr) {
+  DataType::Type type = instr->GetResultType();
+  switch (type) {
+    case DataType::Type::kFloat32:
+      last_visited_latency_ = kX86DivFloatLatency;
+      break;
+    case DataType::Type::kFloat64:
+      last_visited_latency_ = kX86DivDoubleLatency;
+      break;
+    default:
+      if (instr->GetRight()->IsConstant()) {
+        HandleDivRemConstantIntegral(instr);
+      } else {
+        last_visited_latency_ =
+            (type == DataType::Type::kInt64) ? kX86DivLongLatency : kX86DivIntegerLatency;
+      }
+      break;
+  }
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitInstanceFieldGet(
+    HInstanceFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitInstanceOf(HInstanceOf* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86CallInternalLatency;
+  last_visited_latency_ = kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitInvoke(HInvoke* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86CallInternalLatency;
+  last_visited_latency_ = kX86CallLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitLoadString(HLoadString* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86LoadStringInternalLatency;
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitMul(HMul* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? kX86MulFloatingPointLatency
+      : kX86MulIntegerLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitNewArray(HNewArray* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86IntegerOpLatency + kX86CallInternalLatency;
+  last_visited_latency_ = kX86CallLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitNewInstance(HNewInstance* instruction) {
+  if (instruction->IsStringAlloc()) {
+    last_visited_internal_latency_ = 2 + kX86MemoryLoadLatency + kX86CallInternalLatency;
+  } else {
+    last_visited_internal_latency_ = kX86CallInternalLatency;
+  }
+  last_visited_latency_ = kX86CallLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitRem(HRem* instruction) {
+  DataType::Type type = instruction->GetResultType();
+  if (DataType::IsFloatingPointType(type)) {
+    // Computed with an x87 `fprem` loop.
+    last_visited_internal_latency_ = kX86CallInternalLatency;
+    last_visited_latency_ = kX86CallLatency;
+  } else if (instruction->GetRight()->IsConstant()) {
+    HandleDivRemConstantIntegral(instruction);
+  } else {
+    // The remainder is produced by the same `idiv` instruction as the quotient.
+    last_visited_latency_ =
+        (type == DataType::Type::kInt64) ? kX86DivLongLatency : kX86DivIntegerLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitStaticFieldGet(HStaticFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitSuspendCheck(HSuspendCheck* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  DCHECK_IMPLIES(block->GetLoopInformation() == nullptr,
+                 block->IsEntryBlock() && instruction->GetNext()->IsGoto());
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitTypeConversion(HTypeConversion* instr) {
+  if (DataType::IsFloatingPointType(instr->GetResultType()) ||
+      DataType::IsFloatingPointType(instr->GetInputType())) {
+    last_visited_latency_ = kX86TypeConversionFloatingPointIntegerLatency;
+    if (DataType::IsIntegralType(instr->GetResultType())) {
+      // Java semantics require explicit handling of NaN and out of range values.
+      last_visited_internal_latency_ = 2 * kX86FloatingPointOpLatency + kX86BranchLatency;
+    }
+  } else {
+    last_visited_latency_ = kX86IntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86Shared::HandleSimpleArithmeticSIMD(HVecOperation* instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = kX86SIMDFloatingPointOpLatency;
+  } else {
+    last_visited_latency_ = kX86SIMDIntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecReplicateScalar(
+    HVecReplicateScalar* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDReplicateOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecExtractScalar(HVecExtractScalar* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecReduce(HVecReduce* instr ATTRIBUTE_UNUSED) {
+  // Reductions are a sequence of shuffles and horizontal operations.
+  last_visited_latency_ = kX86SIMDReduceOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecCnv(HVecCnv* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDTypeConversionInt2FPLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecNeg(HVecNeg* instr) {
+  // Negation is a subtraction from a zeroed register.
+  last_visited_internal_latency_ = kX86SIMDIntegerOpLatency;
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecAbs(HVecAbs* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecNot(HVecNot* instr) {
+  // Materialize an all-ones (or, for booleans, all-1s bytes) constant first.
+  last_visited_internal_latency_ = kX86SIMDIntegerOpLatency;
+  if (instr->GetPackedType() == DataType::Type::kBool) {
+    last_visited_internal_latency_ += kX86SIMDIntegerOpLatency;
+  }
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecAdd(HVecAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecHalvingAdd(HVecHalvingAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecSub(HVecSub* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecMul(HVecMul* instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = kX86SIMDMulFloatingPointLatency;
+  } else {
+    last_visited_latency_ = kX86SIMDMulIntegerLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecDiv(HVecDiv* instr) {
+  if (instr->GetPackedType() == DataType::Type::kFloat32) {
+    last_visited_latency_ = kX86SIMDDivFloatLatency;
+  } else {
+    DCHECK(instr->GetPackedType() == DataType::Type::kFloat64);
+    last_visited_latency_ = kX86SIMDDivDoubleLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecMin(HVecMin* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecMax(HVecMax* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecAnd(HVecAnd* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecAndNot(HVecAndNot* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecOr(HVecOr* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecXor(HVecXor* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecShl(HVecShl* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecShr(HVecShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecUShr(HVecUShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecSetScalars(HVecSetScalars* instr) {
+  // A zeroing of the register followed by a move into its lowest lane.
+  last_visited_internal_latency_ = kX86SIMDIntegerOpLatency;
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+// Unlike on ARM64, the scaled index of vector memory operations is folded into
+// the addressing mode, so there is no separate address computation.
+void SchedulingLatencyVisitorX86Shared::VisitVecLoad(HVecLoad* instr) {
+  if (instr->GetPackedType() == DataType::Type::kUint16
+      && mirror::kUseStringCompression
+      && instr->IsStringCharAt()) {
+    // Set latencies for the uncompressed case.
+    last_visited_internal_latency_ = kX86MemoryLoadLatency + kX86BranchLatency;
+  }
+  last_visited_latency_ = kX86SIMDMemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86Shared::VisitVecStore(HVecStore* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDMemoryStoreLatency;
+}
+
+}  // namespace art
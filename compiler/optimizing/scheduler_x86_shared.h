@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SCHEDULER_X86_SHARED_H_
+#define ART_COMPILER_OPTIMIZING_SCHEDULER_X86_SHARED_H_
+
+#include "base/macros.h"
+#include "scheduler.h"
+
+namespace art HIDDEN {
+
+static constexpr uint32_t kX86MemoryLoadLatency = 5;
+static constexpr uint32_t kX86MemoryStoreLatency = 1;
+
+static constexpr uint32_t kX86CallInternalLatency = 10;
+static constexpr uint32_t kX86CallLatency = 5;
+
+// x86 and x86-64 instruction latency.
+// The figures are modelled after recent out-of-order Intel and AMD cores, which
+// are close enough to each other for the purpose of list scheduling.
+static constexpr uint32_t kX86IntegerOpLatency = 1;
+static constexpr uint32_t kX86FloatingPointOpLatency = 4;
+
+static constexpr uint32_t kX86DivDoubleLatency = 14;
+static constexpr uint32_t kX86DivFloatLatency = 11;
+static constexpr uint32_t kX86DivIntegerLatency = 26;
+static constexpr uint32_t kX86DivLongLatency = 42;
+static constexpr uint32_t kX86LoadStringInternalLatency = 7;
+static constexpr uint32_t kX86MulFloatingPointLatency = 4;
+static constexpr uint32_t kX86MulIntegerLatency = 3;
+static constexpr uint32_t kX86TypeConversionFloatingPointIntegerLatency = 6;
+static constexpr uint32_t kX86BranchLatency = kX86IntegerOpLatency;
+
+static constexpr uint32_t kX86SIMDFloatingPointOpLatency = 4;
+static constexpr uint32_t kX86SIMDIntegerOpLatency = 1;
+static constexpr uint32_t kX86SIMDMemoryLoadLatency = 6;
+static constexpr uint32_t kX86SIMDMemoryStoreLatency = 1;
+static constexpr uint32_t kX86SIMDMulFloatingPointLatency = 4;
+static constexpr uint32_t kX86SIMDMulIntegerLatency = 10;
+static constexpr uint32_t kX86SIMDReplicateOpLatency = 3;
+static constexpr uint32_t kX86SIMDReduceOpLatency = 6;
+static constexpr uint32_t kX86SIMDDivDoubleLatency = 14;
+static constexpr uint32_t kX86SIMDDivFloatLatency = 11;
+static constexpr uint32_t kX86SIMDTypeConversionInt2FPLatency = 4;
+
+// Latency model shared by the x86 and x86-64 schedulers. It assumes 64-bit
+// integer operations are as cheap as 32-bit ones, which is only true on x86-64.
+class SchedulingLatencyVisitorX86Shared : public SchedulingLatencyVisitor {
+ public:
+  // Default visitor for instructions not handled specifically below.
+  void VisitInstruction(HInstruction* ATTRIBUTE_UNUSED) override {
+    last_visited_latency_ = kX86IntegerOpLatency;
+  }
+
+// We add a second unused parameter to be able to use this macro like the others
+// defined in `nodes.h`.
+#define FOR_EACH_SCHEDULED_COMMON_INSTRUCTION_X86(M) \
+  M(ArrayGet             , unused)                   \
+  M(ArrayLength          , unused)                   \
+  M(ArraySet             , unused)                   \
+  M(BoundsCheck          , unused)                   \
+  M(Div                  , unused)                   \
+  M(InstanceFieldGet     , unused)                   \
+  M(InstanceOf           , unused)                   \
+  M(LoadString           , unused)                   \
+  M(Mul                  , unused)                   \
+  M(NewArray             , unused)                   \
+  M(NewInstance          , unused)                   \
+  M(Rem                  , unused)                   \
+  M(StaticFieldGet       , unused)                   \
+  M(SuspendCheck         , unused)                   \
+  M(TypeConversion       , unused)                   \
+  M(VecReplicateScalar   , unused)                   \
+  M(VecExtractScalar     , unused)                   \
+  M(VecReduce            , unused)                   \
+  M(VecCnv               , unused)                   \
+  M(VecNeg               , unused)                   \
+  M(VecAbs               , unused)                   \
+  M(VecNot               , unused)                   \
+  M(VecAdd               , unused)                   \
+  M(VecHalvingAdd        , unused)                   \
+  M(VecSub               , unused)                   \
+  M(VecMul               , unused)                   \
+  M(VecDiv               , unused)                   \
+  M(VecMin               , unused)                   \
+  M(VecMax               , unused)                   \
+  M(VecAnd               , unused)                   \
+  M(VecAndNot            , unused)                   \
+  M(VecOr                , unused)                   \
+  M(VecXor               , unused)                   \
+  M(VecShl               , unused)                   \
+  M(VecShr               , unused)                   \
+  M(VecUShr              , unused)                   \
+  M(VecSetScalars        , unused)                   \
+  M(VecLoad              , unused)                   \
+  M(VecStore             , unused)
+
+#define FOR_EACH_SCHEDULED_ABSTRACT_INSTRUCTION_X86(M) \
+  M(BinaryOperation      , unused)                     \
+  M(Invoke               , unused)
+
+#define DECLARE_VISIT_INSTRUCTION(type, unused)  \
+  void Visit##type(H##type* instruction) override;
+
+  FOR_EACH_SCHEDULED_COMMON_INSTRUCTION_X86(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_SCHEDULED_ABSTRACT_INSTRUCTION_X86(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(DECLARE_VISIT_INSTRUCTION)
+
+#undef DECLARE_VISIT_INSTRUCTION
+
+ protected:
+  void HandleDivRemConstantIntegral(HBinaryOperation* instruction);
+  void HandleSimpleArithmeticSIMD(HVecOperation* instr);
+};
+
+class HSchedulerX86Shared : public HScheduler {
+ public:
+  HSchedulerX86Shared(SchedulingLatencyVisitorX86Shared* latency_visitor,
+                      SchedulingNodeSelector* selector)
+      : HScheduler(latency_visitor, selector) {}
+  ~HSchedulerX86Shared() override {}
+
+  // The x86 specific instructions created by `PcRelativeFixupsX86` are not
+  // listed, as the scheduler runs before that pass.
+  bool IsSchedulable(const HInstruction* instruction) const override {
+#define CASE_INSTRUCTION_KIND(type, unused) case \
+  HInstruction::InstructionKind::k##type:
+    switch (instruction->GetKind()) {
+      FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(CASE_INSTRUCTION_KIND)
+        return true;
+      FOR_EACH_SCHEDULED_COMMON_INSTRUCTION_X86(CASE_INSTRUCTION_KIND)
+        return true;
+      default:
+        return HScheduler::IsSchedulable(instruction);
+    }
+#undef CASE_INSTRUCTION_KIND
+  }
+
+  // As on ARM64, treat as scheduling barriers those vector instructions whose
+  // live ranges exceed the vectorized loop boundaries: the compiler has no
+  // notion of SIMD register and all XMM registers are caller-saved, so don't
+  // reorder such vector instructions around calls.
+  bool IsSchedulingBarrier(const HInstruction* instr) const override {
+    return HScheduler::IsSchedulingBarrier(instr) ||
+           instr->IsVecReduce() ||
+           instr->IsVecExtractScalar() ||
+           instr->IsVecSetScalars() ||
+           instr->IsVecReplicateScalar();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HSchedulerX86Shared);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SCHEDULER_X86_SHARED_H_
@@ -145,6 +145,15 @@ class AssemblerTestBase : public testing::Test {
         return {FindTool("clang"), "--compile", "-target", "i386-linux-gnu"};
       case InstructionSet::kX86_64:
         return {FindTool("clang"), "--compile", "-target", "x86_64-linux-gnu"};
+      case InstructionSet::kRiscv64:
+        // The ART assembler does not emit compressed instructions and resolves all
+        // local branches itself, so disable both C and linker relaxation.
+        return {FindTool("clang"),
+                "--compile",
+                "-target",
+                "riscv64-linux-gnu",
+                "-march=rv64imafd_zba_zbb",
+                "-mno-relax"};
       default:
         LOG(FATAL) << "Unknown instruction set: " << isa;
         UNREACHABLE();
@@ -0,0 +1,1145 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "assembler_riscv64.h"
+
+#include "base/bit_utils.h"
+#include "base/casts.h"
+
+namespace art HIDDEN {
+namespace riscv64 {
+
+// Major opcodes.
+static constexpr uint32_t kOpcodeLoad = 0x03;
+static constexpr uint32_t kOpcodeLoadFp = 0x07;
+static constexpr uint32_t kOpcodeMiscMem = 0x0f;
+static constexpr uint32_t kOpcodeOpImm = 0x13;
+static constexpr uint32_t kOpcodeAuipc = 0x17;
+static constexpr uint32_t kOpcodeOpImm32 = 0x1b;
+static constexpr uint32_t kOpcodeStore = 0x23;
+static constexpr uint32_t kOpcodeStoreFp = 0x27;
+static constexpr uint32_t kOpcodeAmo = 0x2f;
+static constexpr uint32_t kOpcodeOp = 0x33;
+static constexpr uint32_t kOpcodeLui = 0x37;
+static constexpr uint32_t kOpcodeOp32 = 0x3b;
+static constexpr uint32_t kOpcodeMadd = 0x43;
+static constexpr uint32_t kOpcodeMsub = 0x47;
+static constexpr uint32_t kOpcodeNmsub = 0x4b;
+static constexpr uint32_t kOpcodeNmadd = 0x4f;
+static constexpr uint32_t kOpcodeOpFp = 0x53;
+static constexpr uint32_t kOpcodeBranch = 0x63;
+static constexpr uint32_t kOpcodeJalr = 0x67;
+static constexpr uint32_t kOpcodeJal = 0x6f;
+static constexpr uint32_t kOpcodeSystem = 0x73;
+
+// Floating-point format field, in the low bits of funct7 (or funct2 for R4-type).
+static constexpr uint32_t kFmtS = 0x0;
+static constexpr uint32_t kFmtD = 0x1;
+
+static constexpr uint32_t ToRm(FPRoundingMode frm) {
+  return static_cast<uint32_t>(frm);
+}
+
+// Returns the low 12 bits of `value`, sign-extended, as used by I-type immediates.
+static constexpr int64_t SignExtendLow12(int64_t value) {
+  return static_cast<int64_t>(static_cast<uint64_t>(value) << 52) >> 52;
+}
+
+/////////////////////////////// RV64I ///////////////////////////////
+
+void Riscv64Assembler::Lui(XRegister rd, uint32_t imm20) {
+  EmitU(imm20, rd, kOpcodeLui);
+}
+
+void Riscv64Assembler::Auipc(XRegister rd, uint32_t imm20) {
+  EmitU(imm20, rd, kOpcodeAuipc);
+}
+
+void Riscv64Assembler::Jal(XRegister rd, int32_t offset) {
+  EmitJ(offset, rd, kOpcodeJal);
+}
+
+void Riscv64Assembler::Jalr(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x0, rd, kOpcodeJalr);
+}
+
+void Riscv64Assembler::Beq(XRegister rs1, XRegister rs2, int32_t offset) {
+  EmitB(offset, rs2, rs1, 0x0, kOpcodeBranch);
+}
+
+void Riscv64Assembler::Bne(XRegister rs1, XRegister rs2, int32_t offset) {
+  EmitB(offset, rs2, rs1, 0x1, kOpcodeBranch);
+}
+
+void Riscv64Assembler::Blt(XRegister rs1, XRegister rs2, int32_t offset) {
+  EmitB(offset, rs2, rs1, 0x4, kOpcodeBranch);
+}
+
+void Riscv64Assembler::Bge(XRegister rs1, XRegister rs2, int32_t offset) {
+  EmitB(offset, rs2, rs1, 0x5, kOpcodeBranch);
+}
+
+void Riscv64Assembler::Bltu(XRegister rs1, XRegister rs2, int32_t offset) {
+  EmitB(offset, rs2, rs1, 0x6, kOpcodeBranch);
+}
+
+void Riscv64Assembler::Bgeu(XRegister rs1, XRegister rs2, int32_t offset) {
+  EmitB(offset, rs2, rs1, 0x7, kOpcodeBranch);
+}
+
+void Riscv64Assembler::Lb(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x0, rd, kOpcodeLoad);
+}
+
+void Riscv64Assembler::Lh(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x1, rd, kOpcodeLoad);
+}
+
+void Riscv64Assembler::Lw(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x2, rd, kOpcodeLoad);
+}
+
+void Riscv64Assembler::Ld(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x3, rd, kOpcodeLoad);
+}
+
+void Riscv64Assembler::Lbu(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x4, rd, kOpcodeLoad);
+}
+
+void Riscv64Assembler::Lhu(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x5, rd, kOpcodeLoad);
+}
+
+void Riscv64Assembler::Lwu(XRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x6, rd, kOpcodeLoad);
+}
+
+void Riscv64Assembler::Sb(XRegister rs2, XRegister rs1, int32_t offset) {
+  EmitS(offset, rs2, rs1, 0x0, kOpcodeStore);
+}
+
+void Riscv64Assembler::Sh(XRegister rs2, XRegister rs1, int32_t offset) {
+  EmitS(offset, rs2, rs1, 0x1, kOpcodeStore);
+}
+
+void Riscv64Assembler::Sw(XRegister rs2, XRegister rs1, int32_t offset) {
+  EmitS(offset, rs2, rs1, 0x2, kOpcodeStore);
+}
+
+void Riscv64Assembler::Sd(XRegister rs2, XRegister rs1, int32_t offset) {
+  EmitS(offset, rs2, rs1, 0x3, kOpcodeStore);
+}
+
+void Riscv64Assembler::Addi(XRegister rd, XRegister rs1, int32_t imm12) {
+  EmitI(imm12, rs1, 0x0, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Slti(XRegister rd, XRegister rs1, int32_t imm12) {
+  EmitI(imm12, rs1, 0x2, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Sltiu(XRegister rd, XRegister rs1, int32_t imm12) {
+  EmitI(imm12, rs1, 0x3, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Xori(XRegister rd, XRegister rs1, int32_t imm12) {
+  EmitI(imm12, rs1, 0x4, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Ori(XRegister rd, XRegister rs1, int32_t imm12) {
+  EmitI(imm12, rs1, 0x6, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Andi(XRegister rd, XRegister rs1, int32_t imm12) {
+  EmitI(imm12, rs1, 0x7, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Slli(XRegister rd, XRegister rs1, int32_t shamt) {
+  EmitI6(0x0, shamt, rs1, 0x1, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Srli(XRegister rd, XRegister rs1, int32_t shamt) {
+  EmitI6(0x0, shamt, rs1, 0x5, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Srai(XRegister rd, XRegister rs1, int32_t shamt) {
+  EmitI6(0x10, shamt, rs1, 0x5, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Add(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x0, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Sub(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x20, rs2, rs1, 0x0, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Slt(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x2, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Sltu(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x3, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Xor(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x4, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Or(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x6, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::And(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x7, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Sll(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x1, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Srl(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x5, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Sra(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x20, rs2, rs1, 0x5, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Addiw(XRegister rd, XRegister rs1, int32_t imm12) {
+  EmitI(imm12, rs1, 0x0, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::Slliw(XRegister rd, XRegister rs1, int32_t shamt) {
+  CHECK(IsUint<5>(shamt)) << shamt;
+  EmitR(0x0, shamt, rs1, 0x1, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::Srliw(XRegister rd, XRegister rs1, int32_t shamt) {
+  CHECK(IsUint<5>(shamt)) << shamt;
+  EmitR(0x0, shamt, rs1, 0x5, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::Sraiw(XRegister rd, XRegister rs1, int32_t shamt) {
+  CHECK(IsUint<5>(shamt)) << shamt;
+  EmitR(0x20, shamt, rs1, 0x5, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::Addw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x0, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Subw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x20, rs2, rs1, 0x0, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Sllw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x1, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Srlw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x0, rs2, rs1, 0x5, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Sraw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x20, rs2, rs1, 0x5, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Ecall() {
+  EmitI(0x0, Zero, 0x0, Zero, kOpcodeSystem);
+}
+
+void Riscv64Assembler::Ebreak() {
+  EmitI(0x1, Zero, 0x0, Zero, kOpcodeSystem);
+}
+
+void Riscv64Assembler::Fence(uint32_t pred, uint32_t succ) {
+  CHECK(IsUint<4>(pred)) << pred;
+  CHECK(IsUint<4>(succ)) << succ;
+  EmitI(static_cast<int32_t>((pred << 4) | succ), Zero, 0x0, Zero, kOpcodeMiscMem);
+}
+
+/////////////////////////////// RV64M ///////////////////////////////
+
+void Riscv64Assembler::Mul(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x0, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Mulh(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x1, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Mulhsu(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x2, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Mulhu(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x3, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Div(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x4, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Divu(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x5, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Rem(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x6, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Remu(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x7, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Mulw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x0, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Divw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x4, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Divuw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x5, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Remw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x6, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Remuw(XRegister rd, XRegister rs1, XRegister rs2) {
+  EmitR(0x1, rs2, rs1, 0x7, rd, kOpcodeOp32);
+}
+
+/////////////////////////////// RV64A ///////////////////////////////
+
+void Riscv64Assembler::LrW(XRegister rd, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x2, aqrl, Zero, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::LrD(XRegister rd, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x2, aqrl, Zero, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::ScW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x3, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::ScD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x3, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoSwapW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x1, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoSwapD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x1, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoAddW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x0, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoAddD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x0, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoXorW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x4, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoXorD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x4, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoAndW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0xc, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoAndD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0xc, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoOrW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x8, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoOrD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x8, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoMinW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x10, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoMinD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x10, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoMaxW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x14, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoMaxD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x14, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoMinuW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x18, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoMinuD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x18, aqrl, rs2, rs1, 0x3, rd);
+}
+
+void Riscv64Assembler::AmoMaxuW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x1c, aqrl, rs2, rs1, 0x2, rd);
+}
+
+void Riscv64Assembler::AmoMaxuD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl) {
+  EmitAmo(0x1c, aqrl, rs2, rs1, 0x3, rd);
+}
+
+/////////////////////////////// RV64F/RV64D ///////////////////////////////
+
+void Riscv64Assembler::FLw(FRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x2, rd, kOpcodeLoadFp);
+}
+
+void Riscv64Assembler::FLd(FRegister rd, XRegister rs1, int32_t offset) {
+  EmitI(offset, rs1, 0x3, rd, kOpcodeLoadFp);
+}
+
+void Riscv64Assembler::FSw(FRegister rs2, XRegister rs1, int32_t offset) {
+  EmitS(offset, rs2, rs1, 0x2, kOpcodeStoreFp);
+}
+
+void Riscv64Assembler::FSd(FRegister rs2, XRegister rs1, int32_t offset) {
+  EmitS(offset, rs2, rs1, 0x3, kOpcodeStoreFp);
+}
+
+void Riscv64Assembler::FMAddS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeMadd);
+}
+
+void Riscv64Assembler::FMAddD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeMadd);
+}
+
+void Riscv64Assembler::FMSubS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeMsub);
+}
+
+void Riscv64Assembler::FMSubD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeMsub);
+}
+
+void Riscv64Assembler::FNMSubS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeNmsub);
+}
+
+void Riscv64Assembler::FNMSubD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeNmsub);
+}
+
+void Riscv64Assembler::FNMAddS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeNmadd);
+}
+
+void Riscv64Assembler::FNMAddD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3) {
+  EmitR4(rs3, kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeNmadd);
+}
+
+void Riscv64Assembler::FAddS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x0 | kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FAddD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x0 | kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSubS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x4 | kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSubD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x4 | kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMulS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x8 | kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMulD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x8 | kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FDivS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0xc | kFmtS, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FDivD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0xc | kFmtD, rs2, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSqrtS(FRegister rd, FRegister rs1) {
+  EmitR(0x2c | kFmtS, 0x0, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSqrtD(FRegister rd, FRegister rs1) {
+  EmitR(0x2c | kFmtD, 0x0, rs1, ToRm(FPRoundingMode::kDYN), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSgnjS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x10 | kFmtS, rs2, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSgnjD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x10 | kFmtD, rs2, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSgnjnS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x10 | kFmtS, rs2, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSgnjnD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x10 | kFmtD, rs2, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSgnjxS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x10 | kFmtS, rs2, rs1, 0x2, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FSgnjxD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x10 | kFmtD, rs2, rs1, 0x2, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMinS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x14 | kFmtS, rs2, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMinD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x14 | kFmtD, rs2, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMaxS(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x14 | kFmtS, rs2, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMaxD(FRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x14 | kFmtD, rs2, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FEqS(XRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x50 | kFmtS, rs2, rs1, 0x2, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FEqD(XRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x50 | kFmtD, rs2, rs1, 0x2, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FLtS(XRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x50 | kFmtS, rs2, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FLtD(XRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x50 | kFmtD, rs2, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FLeS(XRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x50 | kFmtS, rs2, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FLeD(XRegister rd, FRegister rs1, FRegister rs2) {
+  EmitR(0x50 | kFmtD, rs2, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FClassS(XRegister rd, FRegister rs1) {
+  EmitR(0x70 | kFmtS, 0x0, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FClassD(XRegister rd, FRegister rs1) {
+  EmitR(0x70 | kFmtD, 0x0, rs1, 0x1, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtSD(FRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x20 | kFmtS, 0x1, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+// Widening and int32-to-double conversions are exact; like the GNU and LLVM
+// assemblers, encode them with the RNE rounding mode.
+void Riscv64Assembler::FCvtDS(FRegister rd, FRegister rs1) {
+  EmitR(0x20 | kFmtD, 0x0, rs1, ToRm(FPRoundingMode::kRNE), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtWS(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtS, 0x0, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtWD(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtD, 0x0, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtWuS(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtS, 0x1, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtWuD(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtD, 0x1, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtLS(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtS, 0x2, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtLD(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtD, 0x2, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtLuS(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtS, 0x3, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtLuD(XRegister rd, FRegister rs1, FPRoundingMode frm) {
+  EmitR(0x60 | kFmtD, 0x3, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtSW(FRegister rd, XRegister rs1, FPRoundingMode frm) {
+  EmitR(0x68 | kFmtS, 0x0, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtDW(FRegister rd, XRegister rs1) {
+  EmitR(0x68 | kFmtD, 0x0, rs1, ToRm(FPRoundingMode::kRNE), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtSWu(FRegister rd, XRegister rs1, FPRoundingMode frm) {
+  EmitR(0x68 | kFmtS, 0x1, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtDWu(FRegister rd, XRegister rs1) {
+  EmitR(0x68 | kFmtD, 0x1, rs1, ToRm(FPRoundingMode::kRNE), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtSL(FRegister rd, XRegister rs1, FPRoundingMode frm) {
+  EmitR(0x68 | kFmtS, 0x2, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtDL(FRegister rd, XRegister rs1, FPRoundingMode frm) {
+  EmitR(0x68 | kFmtD, 0x2, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtSLu(FRegister rd, XRegister rs1, FPRoundingMode frm) {
+  EmitR(0x68 | kFmtS, 0x3, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FCvtDLu(FRegister rd, XRegister rs1, FPRoundingMode frm) {
+  EmitR(0x68 | kFmtD, 0x3, rs1, ToRm(frm), rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMvXW(XRegister rd, FRegister rs1) {
+  EmitR(0x70 | kFmtS, 0x0, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMvXD(XRegister rd, FRegister rs1) {
+  EmitR(0x70 | kFmtD, 0x0, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMvWX(FRegister rd, XRegister rs1) {
+  EmitR(0x78 | kFmtS, 0x0, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+void Riscv64Assembler::FMvDX(FRegister rd, XRegister rs1) {
+  EmitR(0x78 | kFmtD, 0x0, rs1, 0x0, rd, kOpcodeOpFp);
+}
+
+/////////////////////////////// Zba ///////////////////////////////
+
+void Riscv64Assembler::AddUw(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZba());
+  EmitR(0x4, rs2, rs1, 0x0, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Sh1Add(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZba());
+  EmitR(0x10, rs2, rs1, 0x2, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Sh1AddUw(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZba());
+  EmitR(0x10, rs2, rs1, 0x2, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Sh2Add(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZba());
+  EmitR(0x10, rs2, rs1, 0x4, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Sh2AddUw(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZba());
+  EmitR(0x10, rs2, rs1, 0x4, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Sh3Add(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZba());
+  EmitR(0x10, rs2, rs1, 0x6, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Sh3AddUw(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZba());
+  EmitR(0x10, rs2, rs1, 0x6, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::SlliUw(XRegister rd, XRegister rs1, int32_t shamt) {
+  DCHECK(HasZba());
+  EmitI6(0x2, shamt, rs1, 0x1, rd, kOpcodeOpImm32);
+}
+
+/////////////////////////////// Zbb ///////////////////////////////
+
+void Riscv64Assembler::Andn(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x20, rs2, rs1, 0x7, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Orn(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x20, rs2, rs1, 0x6, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Xnor(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x20, rs2, rs1, 0x4, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Clz(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x0, rs1, 0x1, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Clzw(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x0, rs1, 0x1, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::Ctz(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x1, rs1, 0x1, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Ctzw(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x1, rs1, 0x1, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::Cpop(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x2, rs1, 0x1, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Cpopw(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x2, rs1, 0x1, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::Min(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x5, rs2, rs1, 0x4, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Minu(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x5, rs2, rs1, 0x5, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Max(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x5, rs2, rs1, 0x6, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Maxu(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x5, rs2, rs1, 0x7, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Rol(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x30, rs2, rs1, 0x1, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Rolw(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x30, rs2, rs1, 0x1, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Ror(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x30, rs2, rs1, 0x5, rd, kOpcodeOp);
+}
+
+void Riscv64Assembler::Rorw(XRegister rd, XRegister rs1, XRegister rs2) {
+  DCHECK(HasZbb());
+  EmitR(0x30, rs2, rs1, 0x5, rd, kOpcodeOp32);
+}
+
+void Riscv64Assembler::Rori(XRegister rd, XRegister rs1, int32_t shamt) {
+  DCHECK(HasZbb());
+  EmitI6(0x18, shamt, rs1, 0x5, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Roriw(XRegister rd, XRegister rs1, int32_t shamt) {
+  DCHECK(HasZbb());
+  CHECK(IsUint<5>(shamt)) << shamt;
+  EmitR(0x30, shamt, rs1, 0x5, rd, kOpcodeOpImm32);
+}
+
+void Riscv64Assembler::OrcB(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitI(0x287, rs1, 0x5, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::Rev8(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitI(0x6b8, rs1, 0x5, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::SextB(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x4, rs1, 0x1, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::SextH(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x30, 0x5, rs1, 0x1, rd, kOpcodeOpImm);
+}
+
+void Riscv64Assembler::ZextH(XRegister rd, XRegister rs1) {
+  DCHECK(HasZbb());
+  EmitR(0x4, 0x0, rs1, 0x4, rd, kOpcodeOp32);
+}
+
+/////////////////////////////// Pseudo-instructions ///////////////////////////////
+
+void Riscv64Assembler::Nop() { Addi(Zero, Zero, 0); }
+
+void Riscv64Assembler::Li(XRegister rd, int64_t imm) {
+  LoadConst64(rd, imm);
+}
+
+void Riscv64Assembler::Mv(XRegister rd, XRegister rs) { Addi(rd, rs, 0); }
+
+void Riscv64Assembler::Not(XRegister rd, XRegister rs) { Xori(rd, rs, -1); }
+
+void Riscv64Assembler::Neg(XRegister rd, XRegister rs) { Sub(rd, Zero, rs); }
+
+void Riscv64Assembler::NegW(XRegister rd, XRegister rs) { Subw(rd, Zero, rs); }
+
+void Riscv64Assembler::SextW(XRegister rd, XRegister rs) { Addiw(rd, rs, 0); }
+
+void Riscv64Assembler::ZextB(XRegister rd, XRegister rs) { Andi(rd, rs, 0xff); }
+
+void Riscv64Assembler::ZextW(XRegister rd, XRegister rs) {
+  if (HasZba()) {
+    AddUw(rd, rs, Zero);
+  } else {
+    Slli(rd, rs, 32);
+    Srli(rd, rd, 32);
+  }
+}
+
+void Riscv64Assembler::Seqz(XRegister rd, XRegister rs) { Sltiu(rd, rs, 1); }
+
+void Riscv64Assembler::Snez(XRegister rd, XRegister rs) { Sltu(rd, Zero, rs); }
+
+void Riscv64Assembler::Sltz(XRegister rd, XRegister rs) { Slt(rd, rs, Zero); }
+
+void Riscv64Assembler::Sgtz(XRegister rd, XRegister rs) { Slt(rd, Zero, rs); }
+
+void Riscv64Assembler::FMvS(FRegister rd, FRegister rs) { FSgnjS(rd, rs, rs); }
+
+void Riscv64Assembler::FMvD(FRegister rd, FRegister rs) { FSgnjD(rd, rs, rs); }
+
+void Riscv64Assembler::FAbsS(FRegister rd, FRegister rs) { FSgnjxS(rd, rs, rs); }
+
+void Riscv64Assembler::FAbsD(FRegister rd, FRegister rs) { FSgnjxD(rd, rs, rs); }
+
+void Riscv64Assembler::FNegS(FRegister rd, FRegister rs) { FSgnjnS(rd, rs, rs); }
+
+void Riscv64Assembler::FNegD(FRegister rd, FRegister rs) { FSgnjnD(rd, rs, rs); }
+
+void Riscv64Assembler::Beqz(XRegister rs, int32_t offset) { Beq(rs, Zero, offset); }
+
+void Riscv64Assembler::Bnez(XRegister rs, int32_t offset) { Bne(rs, Zero, offset); }
+
+void Riscv64Assembler::Blez(XRegister rs, int32_t offset) { Bge(Zero, rs, offset); }
+
+void Riscv64Assembler::Bgez(XRegister rs, int32_t offset) { Bge(rs, Zero, offset); }
+
+void Riscv64Assembler::Bltz(XRegister rs, int32_t offset) { Blt(rs, Zero, offset); }
+
+void Riscv64Assembler::Bgtz(XRegister rs, int32_t offset) { Blt(Zero, rs, offset); }
+
+void Riscv64Assembler::Bgt(XRegister rs, XRegister rt, int32_t offset) { Blt(rt, rs, offset); }
+
+void Riscv64Assembler::Ble(XRegister rs, XRegister rt, int32_t offset) { Bge(rt, rs, offset); }
+
+void Riscv64Assembler::Bgtu(XRegister rs, XRegister rt, int32_t offset) { Bltu(rt, rs, offset); }
+
+void Riscv64Assembler::Bleu(XRegister rs, XRegister rt, int32_t offset) { Bgeu(rt, rs, offset); }
+
+void Riscv64Assembler::J(int32_t offset) { Jal(Zero, offset); }
+
+void Riscv64Assembler::Jal(int32_t offset) { Jal(RA, offset); }
+
+void Riscv64Assembler::Jr(XRegister rs) { Jalr(Zero, rs, 0); }
+
+void Riscv64Assembler::Jalr(XRegister rs) { Jalr(RA, rs, 0); }
+
+void Riscv64Assembler::Ret() { Jalr(Zero, RA, 0); }
+
+/////////////////////////////// Labels ///////////////////////////////
+
+void Riscv64Assembler::Beq(XRegister rs1, XRegister rs2, Label* label) {
+  EmitBranch(rs1, rs2, 0x0, label);
+}
+
+void Riscv64Assembler::Bne(XRegister rs1, XRegister rs2, Label* label) {
+  EmitBranch(rs1, rs2, 0x1, label);
+}
+
+void Riscv64Assembler::Blt(XRegister rs1, XRegister rs2, Label* label) {
+  EmitBranch(rs1, rs2, 0x4, label);
+}
+
+void Riscv64Assembler::Bge(XRegister rs1, XRegister rs2, Label* label) {
+  EmitBranch(rs1, rs2, 0x5, label);
+}
+
+void Riscv64Assembler::Bltu(XRegister rs1, XRegister rs2, Label* label) {
+  EmitBranch(rs1, rs2, 0x6, label);
+}
+
+void Riscv64Assembler::Bgeu(XRegister rs1, XRegister rs2, Label* label) {
+  EmitBranch(rs1, rs2, 0x7, label);
+}
+
+void Riscv64Assembler::Beqz(XRegister rs, Label* label) { Beq(rs, Zero, label); }
+
+void Riscv64Assembler::Bnez(XRegister rs, Label* label) { Bne(rs, Zero, label); }
+
+void Riscv64Assembler::Blez(XRegister rs, Label* label) { Bge(Zero, rs, label); }
+
+void Riscv64Assembler::Bgez(XRegister rs, Label* label) { Bge(rs, Zero, label); }
+
+void Riscv64Assembler::Bltz(XRegister rs, Label* label) { Blt(rs, Zero, label); }
+
+void Riscv64Assembler::Bgtz(XRegister rs, Label* label) { Blt(Zero, rs, label); }
+
+void Riscv64Assembler::Bgt(XRegister rs, XRegister rt, Label* label) { Blt(rt, rs, label); }
+
+void Riscv64Assembler::Ble(XRegister rs, XRegister rt, Label* label) { Bge(rt, rs, label); }
+
+void Riscv64Assembler::Bgtu(XRegister rs, XRegister rt, Label* label) { Bltu(rt, rs, label); }
+
+void Riscv64Assembler::Bleu(XRegister rs, XRegister rt, Label* label) { Bgeu(rt, rs, label); }
+
+void Riscv64Assembler::Jal(XRegister rd, Label* label) { EmitJump(rd, label); }
+
+void Riscv64Assembler::J(Label* label) { EmitJump(Zero, label); }
+
+void Riscv64Assembler::Jal(Label* label) { EmitJump(RA, label); }
+
+void Riscv64Assembler::Bind(Label* label) {
+  int bound = buffer_.Size();
+  CHECK(!label->IsBound());  // Labels can only be bound once.
+  while (label->IsLinked()) {
+    int position = label->LinkPosition();
+    const Branch& branch = branches_[buffer_.Load<uint32_t>(position)];
+    int32_t offset = bound - position;
+    uint32_t encoded_offset =
+        branch.is_conditional ? EncodeBOffset(offset) : EncodeJOffset(offset);
+    buffer_.Store<uint32_t>(position, branch.encoding | encoded_offset);
+    label->position_ = branch.next_link;
+  }
+  label->BindTo(bound);
+}
+
+void Riscv64Assembler::EmitBranch(XRegister rs1, XRegister rs2, uint32_t funct3, Label* label) {
+  uint32_t encoding = (static_cast<uint32_t>(rs2) << 20) | (static_cast<uint32_t>(rs1) << 15) |
+                      (funct3 << 12) | kOpcodeBranch;
+  EmitLabelReference(encoding, /*is_conditional=*/ true, label);
+}
+
+void Riscv64Assembler::EmitJump(XRegister rd, Label* label) {
+  uint32_t encoding = (static_cast<uint32_t>(rd) << 7) | kOpcodeJal;
+  EmitLabelReference(encoding, /*is_conditional=*/ false, label);
+}
+
+void Riscv64Assembler::EmitLabelReference(uint32_t encoding, bool is_conditional, Label* label) {
+  int position = buffer_.Size();
+  if (label->IsBound()) {
+    int32_t offset = label->Position() - position;
+    Emit32(encoding | (is_conditional ? EncodeBOffset(offset) : EncodeJOffset(offset)));
+  } else {
+    // Chain the branch into the label's link list; the instruction word temporarily
+    // holds the index of the `Branch` record that remembers the real encoding.
+    uint32_t index = dchecked_integral_cast<uint32_t>(branches_.size());
+    branches_.push_back(Branch{encoding, label->position_, is_conditional});
+    Emit32(index);
+    label->LinkTo(position);
+  }
+}
+
+/////////////////////////////// Encoding ///////////////////////////////
+
+void Riscv64Assembler::LoadConst64(XRegister rd, int64_t imm) {
+  if (IsInt<32>(imm)) {
+    int32_t lo12 = static_cast<int32_t>(SignExtendLow12(imm));
+    uint32_t hi20 = static_cast<uint32_t>((imm + 0x800) >> 12) & 0xfffffu;
+    if (hi20 == 0u) {
+      Addi(rd, Zero, lo12);
+    } else {
+      Lui(rd, hi20);
+      if (lo12 != 0) {
+        // Use ADDIW so that a carry into bit 31 is sign-extended correctly.
+        Addiw(rd, rd, lo12);
+      }
+    }
+    return;
+  }
+
+  // Materialize the upper bits recursively, then shift them into place and add
+  // the sign-extended low 12 bits.
+  int64_t lo12 = SignExtendLow12(imm);
+  int64_t hi52 = static_cast<int64_t>(static_cast<uint64_t>(imm) + 0x800u) >> 12;
+  DCHECK_NE(hi52, 0);
+  int shift = 12 + CTZ(static_cast<uint64_t>(hi52));
+  hi52 >>= (shift - 12);
+  LoadConst64(rd, hi52);
+  Slli(rd, rd, shift);
+  if (lo12 != 0) {
+    Addi(rd, rd, dchecked_integral_cast<int32_t>(lo12));
+  }
+}
+
+uint32_t Riscv64Assembler::EncodeBOffset(int32_t offset) {
+  CHECK(IsInt<13>(offset)) << "Branch offset out of range: " << offset;
+  CHECK_ALIGNED(offset, 2);
+  uint32_t imm = static_cast<uint32_t>(offset);
+  return (((imm >> 12) & 0x1u) << 31) |
+         (((imm >> 5) & 0x3fu) << 25) |
+         (((imm >> 1) & 0xfu) << 8) |
+         (((imm >> 11) & 0x1u) << 7);
+}
+
+uint32_t Riscv64Assembler::EncodeJOffset(int32_t offset) {
+  CHECK(IsInt<21>(offset)) << "Jump offset out of range: " << offset;
+  CHECK_ALIGNED(offset, 2);
+  uint32_t imm = static_cast<uint32_t>(offset);
+  return (((imm >> 20) & 0x1u) << 31) |
+         (((imm >> 1) & 0x3ffu) << 21) |
+         (((imm >> 11) & 0x1u) << 20) |
+         (((imm >> 12) & 0xffu) << 12);
+}
+
+void Riscv64Assembler::Emit32(uint32_t value) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  buffer_.Emit<uint32_t>(value);
+}
+
+void Riscv64Assembler::EmitR(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3,
+                             uint32_t rd, uint32_t opcode) {
+  DCHECK(IsUint<7>(funct7));
+  DCHECK(IsUint<5>(rs2));
+  DCHECK(IsUint<5>(rs1));
+  DCHECK(IsUint<3>(funct3));
+  DCHECK(IsUint<5>(rd));
+  Emit32((funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode);
+}
+
+void Riscv64Assembler::EmitR4(uint32_t rs3, uint32_t funct2, uint32_t rs2, uint32_t rs1,
+                              uint32_t funct3, uint32_t rd, uint32_t opcode) {
+  DCHECK(IsUint<5>(rs3));
+  DCHECK(IsUint<2>(funct2));
+  DCHECK(IsUint<5>(rs2));
+  DCHECK(IsUint<5>(rs1));
+  DCHECK(IsUint<3>(funct3));
+  DCHECK(IsUint<5>(rd));
+  Emit32((rs3 << 27) | (funct2 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) |
+         opcode);
+}
+
+void Riscv64Assembler::EmitI(int32_t imm12, uint32_t rs1, uint32_t funct3, uint32_t rd,
+                             uint32_t opcode) {
+  CHECK(IsInt<12>(imm12)) << imm12;
+  DCHECK(IsUint<5>(rs1));
+  DCHECK(IsUint<3>(funct3));
+  DCHECK(IsUint<5>(rd));
+  Emit32(((static_cast<uint32_t>(imm12) & 0xfffu) << 20) | (rs1 << 15) | (funct3 << 12) |
+         (rd << 7) | opcode);
+}
+
+void Riscv64Assembler::EmitI6(uint32_t funct6, uint32_t imm6, uint32_t rs1, uint32_t funct3,
+                              uint32_t rd, uint32_t opcode) {
+  DCHECK(IsUint<6>(funct6));
+  CHECK(IsUint<6>(imm6)) << imm6;
+  DCHECK(IsUint<5>(rs1));
+  DCHECK(IsUint<3>(funct3));
+  DCHECK(IsUint<5>(rd));
+  Emit32((funct6 << 26) | (imm6 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode);
+}
+
+void Riscv64Assembler::EmitS(int32_t imm12, uint32_t rs2, uint32_t rs1, uint32_t funct3,
+                             uint32_t opcode) {
+  CHECK(IsInt<12>(imm12)) << imm12;
+  DCHECK(IsUint<5>(rs2));
+  DCHECK(IsUint<5>(rs1));
+  DCHECK(IsUint<3>(funct3));
+  uint32_t imm = static_cast<uint32_t>(imm12);
+  Emit32((((imm >> 5) & 0x7fu) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+         ((imm & 0x1fu) << 7) | opcode);
+}
+
+void Riscv64Assembler::EmitB(int32_t offset, uint32_t rs2, uint32_t rs1, uint32_t funct3,
+                             uint32_t opcode) {
+  DCHECK(IsUint<5>(rs2));
+  DCHECK(IsUint<5>(rs1));
+  DCHECK(IsUint<3>(funct3));
+  Emit32(EncodeBOffset(offset) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | opcode);
+}
+
+void Riscv64Assembler::EmitU(uint32_t imm20, uint32_t rd, uint32_t opcode) {
+  CHECK(IsUint<20>(imm20)) << imm20;
+  DCHECK(IsUint<5>(rd));
+  Emit32((imm20 << 12) | (rd << 7) | opcode);
+}
+
+void Riscv64Assembler::EmitJ(int32_t offset, uint32_t rd, uint32_t opcode) {
+  DCHECK(IsUint<5>(rd));
+  Emit32(EncodeJOffset(offset) | (rd << 7) | opcode);
+}
+
+void Riscv64Assembler::EmitAmo(uint32_t funct5, AqRl aqrl, XRegister rs2, XRegister rs1,
+                               uint32_t funct3, XRegister rd) {
+  DCHECK(IsUint<5>(funct5));
+  EmitR((funct5 << 2) | static_cast<uint32_t>(aqrl), rs2, rs1, funct3, rd, kOpcodeAmo);
+}
+
+}  // namespace riscv64
+}  // namespace art
@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_UTILS_RISCV64_ASSEMBLER_RISCV64_H_
+#define ART_COMPILER_UTILS_RISCV64_ASSEMBLER_RISCV64_H_
+
+#include <stdint.h>
+
+#include "arch/riscv64/instruction_set_features_riscv64.h"
+#include "base/arena_containers.h"
+#include "base/macros.h"
+#include "managed_register_riscv64.h"
+#include "utils/assembler.h"
+#include "utils/label.h"
+
+namespace art HIDDEN {
+namespace riscv64 {
+
+// Rounding mode field of floating-point instructions.
+enum class FPRoundingMode : uint32_t {
+  kRNE = 0x0,  // Round to Nearest, ties to Even
+  kRTZ = 0x1,  // Round towards Zero
+  kRDN = 0x2,  // Round Down (towards -Infinity)
+  kRUP = 0x3,  // Round Up (towards +Infinity)
+  kRMM = 0x4,  // Round to Nearest, ties to Max Magnitude
+  kDYN = 0x7,  // Dynamic rounding mode, taken from the `frm` CSR
+};
+
+// Ordering bits of the A extension instructions.
+enum class AqRl : uint32_t {
+  kNone    = 0x0,
+  kRelease = 0x1,
+  kAcquire = 0x2,
+  kAqRl    = kRelease | kAcquire,
+};
+
+// Predecessor and successor sets of the FENCE instruction.
+enum FenceType : uint32_t {
+  kFenceWrite = 1,
+  kFenceRead = 2,
+  kFenceOutput = 4,
+  kFenceInput = 8,
+  kFenceDefault = 0xf,
+};
+
+// Assembler for RV64G, optionally extended with Zba and Zbb when the target
+// `Riscv64InstructionSetFeatures` allow it.
+//
+// Only the standard 32-bit encodings are emitted; the assembler never uses the C
+// extension, so that every instruction and branch target stays 4-byte aligned and
+// label fixups only ever need to patch full instruction words.
+class Riscv64Assembler final : public Assembler {
+ public:
+  explicit Riscv64Assembler(ArenaAllocator* allocator,
+                            const Riscv64InstructionSetFeatures* instruction_set_features = nullptr)
+      : Assembler(allocator),
+        branches_(allocator->Adapter(kArenaAllocAssembler)),
+        has_zba_(instruction_set_features != nullptr && instruction_set_features->HasZba()),
+        has_zbb_(instruction_set_features != nullptr && instruction_set_features->HasZbb()) {}
+  virtual ~Riscv64Assembler() {}
+
+  bool HasZba() const { return has_zba_; }
+  bool HasZbb() const { return has_zbb_; }
+
+  /*
+   * Emit Machine Instructions.
+   */
+
+  // RV64I: upper immediates, jumps and branches. Offsets are in bytes.
+  void Lui(XRegister rd, uint32_t imm20);
+  void Auipc(XRegister rd, uint32_t imm20);
+
+  void Jal(XRegister rd, int32_t offset);
+  void Jalr(XRegister rd, XRegister rs1, int32_t offset);
+
+  void Beq(XRegister rs1, XRegister rs2, int32_t offset);
+  void Bne(XRegister rs1, XRegister rs2, int32_t offset);
+  void Blt(XRegister rs1, XRegister rs2, int32_t offset);
+  void Bge(XRegister rs1, XRegister rs2, int32_t offset);
+  void Bltu(XRegister rs1, XRegister rs2, int32_t offset);
+  void Bgeu(XRegister rs1, XRegister rs2, int32_t offset);
+
+  // RV64I: loads and stores.
+  void Lb(XRegister rd, XRegister rs1, int32_t offset);
+  void Lh(XRegister rd, XRegister rs1, int32_t offset);
+  void Lw(XRegister rd, XRegister rs1, int32_t offset);
+  void Ld(XRegister rd, XRegister rs1, int32_t offset);
+  void Lbu(XRegister rd, XRegister rs1, int32_t offset);
+  void Lhu(XRegister rd, XRegister rs1, int32_t offset);
+  void Lwu(XRegister rd, XRegister rs1, int32_t offset);
+
+  void Sb(XRegister rs2, XRegister rs1, int32_t offset);
+  void Sh(XRegister rs2, XRegister rs1, int32_t offset);
+  void Sw(XRegister rs2, XRegister rs1, int32_t offset);
+  void Sd(XRegister rs2, XRegister rs1, int32_t offset);
+
+  // RV64I: register-immediate operations.
+  void Addi(XRegister rd, XRegister rs1, int32_t imm12);
+  void Slti(XRegister rd, XRegister rs1, int32_t imm12);
+  void Sltiu(XRegister rd, XRegister rs1, int32_t imm12);
+  void Xori(XRegister rd, XRegister rs1, int32_t imm12);
+  void Ori(XRegister rd, XRegister rs1, int32_t imm12);
+  void Andi(XRegister rd, XRegister rs1, int32_t imm12);
+  void Slli(XRegister rd, XRegister rs1, int32_t shamt);
+  void Srli(XRegister rd, XRegister rs1, int32_t shamt);
+  void Srai(XRegister rd, XRegister rs1, int32_t shamt);
+
+  // RV64I: register-register operations.
+  void Add(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sub(XRegister rd, XRegister rs1, XRegister rs2);
+  void Slt(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sltu(XRegister rd, XRegister rs1, XRegister rs2);
+  void Xor(XRegister rd, XRegister rs1, XRegister rs2);
+  void Or(XRegister rd, XRegister rs1, XRegister rs2);
+  void And(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sll(XRegister rd, XRegister rs1, XRegister rs2);
+  void Srl(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sra(XRegister rd, XRegister rs1, XRegister rs2);
+
+  // RV64I: 32-bit operations, sign-extending the result to 64 bits.
+  void Addiw(XRegister rd, XRegister rs1, int32_t imm12);
+  void Slliw(XRegister rd, XRegister rs1, int32_t shamt);
+  void Srliw(XRegister rd, XRegister rs1, int32_t shamt);
+  void Sraiw(XRegister rd, XRegister rs1, int32_t shamt);
+  void Addw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Subw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sllw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Srlw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sraw(XRegister rd, XRegister rs1, XRegister rs2);
+
+  // RV64I: environment and memory ordering.
+  void Ecall();
+  void Ebreak();
+  void Fence(uint32_t pred = kFenceDefault, uint32_t succ = kFenceDefault);
+
+  // RV64M: multiplication and division.
+  void Mul(XRegister rd, XRegister rs1, XRegister rs2);
+  void Mulh(XRegister rd, XRegister rs1, XRegister rs2);
+  void Mulhsu(XRegister rd, XRegister rs1, XRegister rs2);
+  void Mulhu(XRegister rd, XRegister rs1, XRegister rs2);
+  void Div(XRegister rd, XRegister rs1, XRegister rs2);
+  void Divu(XRegister rd, XRegister rs1, XRegister rs2);
+  void Rem(XRegister rd, XRegister rs1, XRegister rs2);
+  void Remu(XRegister rd, XRegister rs1, XRegister rs2);
+  void Mulw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Divw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Divuw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Remw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Remuw(XRegister rd, XRegister rs1, XRegister rs2);
+
+  // RV64A: atomics. The address is in `rs1`.
+  void LrW(XRegister rd, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void LrD(XRegister rd, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void ScW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void ScD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoSwapW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoSwapD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoAddW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoAddD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoXorW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoXorD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoAndW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoAndD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoOrW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoOrD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMinW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMinD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMaxW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMaxD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMinuW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMinuD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMaxuW(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+  void AmoMaxuD(XRegister rd, XRegister rs2, XRegister rs1, AqRl aqrl = AqRl::kNone);
+
+  // RV64F/RV64D: loads and stores.
+  void FLw(FRegister rd, XRegister rs1, int32_t offset);
+  void FLd(FRegister rd, XRegister rs1, int32_t offset);
+  void FSw(FRegister rs2, XRegister rs1, int32_t offset);
+  void FSd(FRegister rs2, XRegister rs1, int32_t offset);
+
+  // RV64F/RV64D: arithmetic. These use the dynamic rounding mode.
+  void FMAddS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FMAddD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FMSubS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FMSubD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FNMSubS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FNMSubD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FNMAddS(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FNMAddD(FRegister rd, FRegister rs1, FRegister rs2, FRegister rs3);
+  void FAddS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FAddD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSubS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSubD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FMulS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FMulD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FDivS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FDivD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSqrtS(FRegister rd, FRegister rs1);
+  void FSqrtD(FRegister rd, FRegister rs1);
+  void FSgnjS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSgnjD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSgnjnS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSgnjnD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSgnjxS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FSgnjxD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FMinS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FMinD(FRegister rd, FRegister rs1, FRegister rs2);
+  void FMaxS(FRegister rd, FRegister rs1, FRegister rs2);
+  void FMaxD(FRegister rd, FRegister rs1, FRegister rs2);
+
+  // RV64F/RV64D: comparisons and classification.
+  void FEqS(XRegister rd, FRegister rs1, FRegister rs2);
+  void FEqD(XRegister rd, FRegister rs1, FRegister rs2);
+  void FLtS(XRegister rd, FRegister rs1, FRegister rs2);
+  void FLtD(XRegister rd, FRegister rs1, FRegister rs2);
+  void FLeS(XRegister rd, FRegister rs1, FRegister rs2);
+  void FLeD(XRegister rd, FRegister rs1, FRegister rs2);
+  void FClassS(XRegister rd, FRegister rs1);
+  void FClassD(XRegister rd, FRegister rs1);
+
+  // RV64F/RV64D: conversions. Inexact conversions take an explicit rounding mode,
+  // defaulting to the dynamic one; Java semantics for FP-to-integer need `kRTZ`.
+  void FCvtSD(FRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtDS(FRegister rd, FRegister rs1);
+  void FCvtWS(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtWD(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtWuS(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtWuD(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtLS(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtLD(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtLuS(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtLuD(XRegister rd, FRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtSW(FRegister rd, XRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtDW(FRegister rd, XRegister rs1);
+  void FCvtSWu(FRegister rd, XRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtDWu(FRegister rd, XRegister rs1);
+  void FCvtSL(FRegister rd, XRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtDL(FRegister rd, XRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtSLu(FRegister rd, XRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+  void FCvtDLu(FRegister rd, XRegister rs1, FPRoundingMode frm = FPRoundingMode::kDYN);
+
+  // RV64F/RV64D: bit-exact moves between register files.
+  void FMvXW(XRegister rd, FRegister rs1);
+  void FMvXD(XRegister rd, FRegister rs1);
+  void FMvWX(FRegister rd, XRegister rs1);
+  void FMvDX(FRegister rd, XRegister rs1);
+
+  // Zba: address generation. Only available if `HasZba()`.
+  void AddUw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sh1Add(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sh1AddUw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sh2Add(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sh2AddUw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sh3Add(XRegister rd, XRegister rs1, XRegister rs2);
+  void Sh3AddUw(XRegister rd, XRegister rs1, XRegister rs2);
+  void SlliUw(XRegister rd, XRegister rs1, int32_t shamt);
+
+  // Zbb: basic bit manipulation. Only available if `HasZbb()`.
+  void Andn(XRegister rd, XRegister rs1, XRegister rs2);
+  void Orn(XRegister rd, XRegister rs1, XRegister rs2);
+  void Xnor(XRegister rd, XRegister rs1, XRegister rs2);
+  void Clz(XRegister rd, XRegister rs1);
+  void Clzw(XRegister rd, XRegister rs1);
+  void Ctz(XRegister rd, XRegister rs1);
+  void Ctzw(XRegister rd, XRegister rs1);
+  void Cpop(XRegister rd, XRegister rs1);
+  void Cpopw(XRegister rd, XRegister rs1);
+  void Min(XRegister rd, XRegister rs1, XRegister rs2);
+  void Minu(XRegister rd, XRegister rs1, XRegister rs2);
+  void Max(XRegister rd, XRegister rs1, XRegister rs2);
+  void Maxu(XRegister rd, XRegister rs1, XRegister rs2);
+  void Rol(XRegister rd, XRegister rs1, XRegister rs2);
+  void Rolw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Ror(XRegister rd, XRegister rs1, XRegister rs2);
+  void Rorw(XRegister rd, XRegister rs1, XRegister rs2);
+  void Rori(XRegister rd, XRegister rs1, int32_t shamt);
+  void Roriw(XRegister rd, XRegister rs1, int32_t shamt);
+  void OrcB(XRegister rd, XRegister rs1);
+  void Rev8(XRegister rd, XRegister rs1);
+  void SextB(XRegister rd, XRegister rs1);
+  void SextH(XRegister rd, XRegister rs1);
+  void ZextH(XRegister rd, XRegister rs1);
+
+  /*
+   * Pseudo-instructions, as defined by the RISC-V assembly programmer's manual.
+   */
+
+  void Nop();
+  // Materialize an arbitrary 64-bit constant, using at most 8 instructions.
+  void Li(XRegister rd, int64_t imm);
+  void Mv(XRegister rd, XRegister rs);
+  void Not(XRegister rd, XRegister rs);
+  void Neg(XRegister rd, XRegister rs);
+  void NegW(XRegister rd, XRegister rs);
+  void SextW(XRegister rd, XRegister rs);
+  void ZextB(XRegister rd, XRegister rs);
+  // Uses `add.uw` with Zba, a shift pair otherwise.
+  void ZextW(XRegister rd, XRegister rs);
+  void Seqz(XRegister rd, XRegister rs);
+  void Snez(XRegister rd, XRegister rs);
+  void Sltz(XRegister rd, XRegister rs);
+  void Sgtz(XRegister rd, XRegister rs);
+  void FMvS(FRegister rd, FRegister rs);
+  void FMvD(FRegister rd, FRegister rs);
+  void FAbsS(FRegister rd, FRegister rs);
+  void FAbsD(FRegister rd, FRegister rs);
+  void FNegS(FRegister rd, FRegister rs);
+  void FNegD(FRegister rd, FRegister rs);
+
+  void Beqz(XRegister rs, int32_t offset);
+  void Bnez(XRegister rs, int32_t offset);
+  void Blez(XRegister rs, int32_t offset);
+  void Bgez(XRegister rs, int32_t offset);
+  void Bltz(XRegister rs, int32_t offset);
+  void Bgtz(XRegister rs, int32_t offset);
+  void Bgt(XRegister rs, XRegister rt, int32_t offset);
+  void Ble(XRegister rs, XRegister rt, int32_t offset);
+  void Bgtu(XRegister rs, XRegister rt, int32_t offset);
+  void Bleu(XRegister rs, XRegister rt, int32_t offset);
+
+  void J(int32_t offset);
+  void Jal(int32_t offset);
+  void Jr(XRegister rs);
+  void Jalr(XRegister rs);
+  void Ret();
+
+  // Label-based branches and jumps. Conditional branches reach +/-4KiB and jumps
+  // +/-1MiB; exceeding that range when the label is bound is a fatal error.
+  void Beq(XRegister rs1, XRegister rs2, Label* label);
+  void Bne(XRegister rs1, XRegister rs2, Label* label);
+  void Blt(XRegister rs1, XRegister rs2, Label* label);
+  void Bge(XRegister rs1, XRegister rs2, Label* label);
+  void Bltu(XRegister rs1, XRegister rs2, Label* label);
+  void Bgeu(XRegister rs1, XRegister rs2, Label* label);
+  void Beqz(XRegister rs, Label* label);
+  void Bnez(XRegister rs, Label* label);
+  void Blez(XRegister rs, Label* label);
+  void Bgez(XRegister rs, Label* label);
+  void Bltz(XRegister rs, Label* label);
+  void Bgtz(XRegister rs, Label* label);
+  void Bgt(XRegister rs, XRegister rt, Label* label);
+  void Ble(XRegister rs, XRegister rt, Label* label);
+  void Bgtu(XRegister rs, XRegister rt, Label* label);
+  void Bleu(XRegister rs, XRegister rt, Label* label);
+  void Jal(XRegister rd, Label* label);
+  void J(Label* label);
+  void Jal(Label* label);
+
+  //
+  // Misc. functionality
+  //
+  void Bind(Label* label) override;
+  void Jump(Label* label) override {
+    J(label);
+  }
+
+ private:
+  // An unresolved branch or jump to a label. The instruction word in the buffer
+  // holds the index of its `Branch` record until the label is bound.
+  struct Branch {
+    uint32_t encoding;       // The instruction, with a zero offset.
+    int32_t next_link;       // The label's link before this branch was added.
+    bool is_conditional;     // B-type if true, J-type otherwise.
+  };
+
+  void Emit32(uint32_t value);
+
+  void EmitR(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd,
+             uint32_t opcode);
+  void EmitR4(uint32_t rs3, uint32_t funct2, uint32_t rs2, uint32_t rs1, uint32_t funct3,
+              uint32_t rd, uint32_t opcode);
+  void EmitI(int32_t imm12, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode);
+  void EmitI6(uint32_t funct6, uint32_t imm6, uint32_t rs1, uint32_t funct3, uint32_t rd,
+              uint32_t opcode);
+  void EmitS(int32_t imm12, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t opcode);
+  void EmitB(int32_t offset, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t opcode);
+  void EmitU(uint32_t imm20, uint32_t rd, uint32_t opcode);
+  void EmitJ(int32_t offset, uint32_t rd, uint32_t opcode);
+
+  void EmitAmo(uint32_t funct5, AqRl aqrl, XRegister rs2, XRegister rs1, uint32_t funct3,
+               XRegister rd);
+
+  void EmitBranch(XRegister rs1, XRegister rs2, uint32_t funct3, Label* label);
+  void EmitJump(XRegister rd, Label* label);
+  void EmitLabelReference(uint32_t encoding, bool is_conditional, Label* label);
+
+  static uint32_t EncodeBOffset(int32_t offset);
+  static uint32_t EncodeJOffset(int32_t offset);
+
+  void LoadConst64(XRegister rd, int64_t imm);
+
+  ArenaVector<Branch> branches_;
+
+  const bool has_zba_;
+  const bool has_zbb_;
+
+  DISALLOW_COPY_AND_ASSIGN(Riscv64Assembler);
+};
+
+}  // namespace riscv64
+}  // namespace art
+
+#endif  // ART_COMPILER_UTILS_RISCV64_ASSEMBLER_RISCV64_H_
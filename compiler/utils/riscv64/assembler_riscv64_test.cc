@@ -0,0 +1,901 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "assembler_riscv64.h"
+
+#include <inttypes.h>
+
+#include <map>
+
+#include "base/bit_utils.h"
+#include "base/macros.h"
+#include "base/malloc_arena_pool.h"
+#include "base/stl_util.h"
+#include "utils/assembler_test.h"
+
+namespace art HIDDEN {
+namespace riscv64 {
+
+TEST(AssemblerRiscv64, CreateBuffer) {
+  MallocArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  AssemblerBuffer buffer(&allocator);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer);
+  buffer.Emit<uint32_t>(0x00000013u);  // nop
+  ASSERT_EQ(static_cast<size_t>(4), buffer.Size());
+}
+
+//
+// Test fixture.
+//
+
+class AssemblerRiscv64Test : public AssemblerTest<Riscv64Assembler,
+                                                  uint32_t,
+                                                  XRegister,
+                                                  FRegister,
+                                                  int64_t> {
+ public:
+  using Base = AssemblerTest<Riscv64Assembler, uint32_t, XRegister, FRegister, int64_t>;
+
+ protected:
+  InstructionSet GetIsa() override {
+    return InstructionSet::kRiscv64;
+  }
+
+  Riscv64Assembler* CreateAssembler(ArenaAllocator* allocator) override {
+    // Test with every extension the assembler knows about.
+    instruction_set_features_ = Riscv64InstructionSetFeatures::FromBitmap(
+        Riscv64InstructionSetFeatures::kExtGeneric |
+        Riscv64InstructionSetFeatures::kExtZba |
+        Riscv64InstructionSetFeatures::kExtZbb);
+    return new (allocator) Riscv64Assembler(allocator, instruction_set_features_.get());
+  }
+
+  void SetUpHelpers() override {
+    if (registers_.size() == 0) {
+      for (size_t i = 0; i != kNumberOfXRegisters; ++i) {
+        registers_.push_back(new XRegister(static_cast<XRegister>(i)));
+      }
+      for (size_t i = 0; i != kNumberOfFRegisters; ++i) {
+        fp_registers_.push_back(new FRegister(static_cast<FRegister>(i)));
+      }
+    }
+  }
+
+  void TearDown() override {
+    AssemblerTest::TearDown();
+    STLDeleteElements(&registers_);
+    STLDeleteElements(&fp_registers_);
+  }
+
+  std::vector<uint32_t> GetAddresses() override {
+    UNIMPLEMENTED(FATAL) << "Riscv64 addresses are a base register and an offset";
+    UNREACHABLE();
+  }
+
+  std::vector<XRegister*> GetRegisters() override {
+    return registers_;
+  }
+
+  std::vector<FRegister*> GetFPRegisters() override {
+    return fp_registers_;
+  }
+
+  int64_t CreateImmediate(int64_t imm_value) override {
+    return imm_value;
+  }
+
+  // Drive an instruction taking a rounding mode with every (dst, src) register pair,
+  // for both the dynamic and the round-towards-zero mode.
+  template <typename DstReg, typename SrcReg>
+  std::string RepeatWithRoundingMode(void (Riscv64Assembler::*f)(DstReg, SrcReg, FPRoundingMode),
+                                     const std::vector<DstReg*>& dst_registers,
+                                     const std::vector<SrcReg*>& src_registers,
+                                     const std::string& mnemonic) {
+    std::string str;
+    for (FPRoundingMode frm : {FPRoundingMode::kDYN, FPRoundingMode::kRTZ}) {
+      for (DstReg* dst : dst_registers) {
+        for (SrcReg* src : src_registers) {
+          (GetAssembler()->*f)(*dst, *src, frm);
+          std::ostringstream oss;
+          oss << mnemonic << " " << *dst << ", " << *src;
+          if (frm == FPRoundingMode::kRTZ) {
+            oss << ", rtz";
+          }
+          str += oss.str() + "\n";
+        }
+      }
+    }
+    return str;
+  }
+
+ private:
+  std::unique_ptr<const Riscv64InstructionSetFeatures> instruction_set_features_;
+  std::vector<XRegister*> registers_;
+  std::vector<FRegister*> fp_registers_;
+};
+
+TEST_F(AssemblerRiscv64Test, Toolchain) {
+  EXPECT_TRUE(CheckTools());
+}
+
+TEST_F(AssemblerRiscv64Test, Lui) {
+  DriverStr(RepeatRIb(&Riscv64Assembler::Lui, 20, "lui {reg}, {imm}"), "Lui");
+}
+
+TEST_F(AssemblerRiscv64Test, Auipc) {
+  DriverStr(RepeatRIb(&Riscv64Assembler::Auipc, 20, "auipc {reg}, {imm}"), "Auipc");
+}
+
+TEST_F(AssemblerRiscv64Test, Jalr) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Jalr, -12, "jalr {reg1}, {imm}({reg2})"), "Jalr");
+}
+
+TEST_F(AssemblerRiscv64Test, Lb) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Lb, -12, "lb {reg1}, {imm}({reg2})"), "Lb");
+}
+
+TEST_F(AssemblerRiscv64Test, Lh) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Lh, -12, "lh {reg1}, {imm}({reg2})"), "Lh");
+}
+
+TEST_F(AssemblerRiscv64Test, Lw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Lw, -12, "lw {reg1}, {imm}({reg2})"), "Lw");
+}
+
+TEST_F(AssemblerRiscv64Test, Ld) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Ld, -12, "ld {reg1}, {imm}({reg2})"), "Ld");
+}
+
+TEST_F(AssemblerRiscv64Test, Lbu) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Lbu, -12, "lbu {reg1}, {imm}({reg2})"), "Lbu");
+}
+
+TEST_F(AssemblerRiscv64Test, Lhu) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Lhu, -12, "lhu {reg1}, {imm}({reg2})"), "Lhu");
+}
+
+TEST_F(AssemblerRiscv64Test, Lwu) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Lwu, -12, "lwu {reg1}, {imm}({reg2})"), "Lwu");
+}
+
+TEST_F(AssemblerRiscv64Test, Sb) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Sb, -12, "sb {reg1}, {imm}({reg2})"), "Sb");
+}
+
+TEST_F(AssemblerRiscv64Test, Sh) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Sh, -12, "sh {reg1}, {imm}({reg2})"), "Sh");
+}
+
+TEST_F(AssemblerRiscv64Test, Sw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Sw, -12, "sw {reg1}, {imm}({reg2})"), "Sw");
+}
+
+TEST_F(AssemblerRiscv64Test, Sd) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Sd, -12, "sd {reg1}, {imm}({reg2})"), "Sd");
+}
+
+TEST_F(AssemblerRiscv64Test, Addi) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Addi, -12, "addi {reg1}, {reg2}, {imm}"), "Addi");
+}
+
+TEST_F(AssemblerRiscv64Test, Slti) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Slti, -12, "slti {reg1}, {reg2}, {imm}"), "Slti");
+}
+
+TEST_F(AssemblerRiscv64Test, Sltiu) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Sltiu, -12, "sltiu {reg1}, {reg2}, {imm}"), "Sltiu");
+}
+
+TEST_F(AssemblerRiscv64Test, Xori) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Xori, -12, "xori {reg1}, {reg2}, {imm}"), "Xori");
+}
+
+TEST_F(AssemblerRiscv64Test, Ori) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Ori, -12, "ori {reg1}, {reg2}, {imm}"), "Ori");
+}
+
+TEST_F(AssemblerRiscv64Test, Andi) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Andi, -12, "andi {reg1}, {reg2}, {imm}"), "Andi");
+}
+
+TEST_F(AssemblerRiscv64Test, Slli) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Slli, 6, "slli {reg1}, {reg2}, {imm}"), "Slli");
+}
+
+TEST_F(AssemblerRiscv64Test, Srli) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Srli, 6, "srli {reg1}, {reg2}, {imm}"), "Srli");
+}
+
+TEST_F(AssemblerRiscv64Test, Srai) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Srai, 6, "srai {reg1}, {reg2}, {imm}"), "Srai");
+}
+
+TEST_F(AssemblerRiscv64Test, Add) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Add, "add {reg1}, {reg2}, {reg3}"), "Add");
+}
+
+TEST_F(AssemblerRiscv64Test, Sub) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sub, "sub {reg1}, {reg2}, {reg3}"), "Sub");
+}
+
+TEST_F(AssemblerRiscv64Test, Slt) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Slt, "slt {reg1}, {reg2}, {reg3}"), "Slt");
+}
+
+TEST_F(AssemblerRiscv64Test, Sltu) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sltu, "sltu {reg1}, {reg2}, {reg3}"), "Sltu");
+}
+
+TEST_F(AssemblerRiscv64Test, Xor) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Xor, "xor {reg1}, {reg2}, {reg3}"), "Xor");
+}
+
+TEST_F(AssemblerRiscv64Test, Or) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Or, "or {reg1}, {reg2}, {reg3}"), "Or");
+}
+
+TEST_F(AssemblerRiscv64Test, And) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::And, "and {reg1}, {reg2}, {reg3}"), "And");
+}
+
+TEST_F(AssemblerRiscv64Test, Sll) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sll, "sll {reg1}, {reg2}, {reg3}"), "Sll");
+}
+
+TEST_F(AssemblerRiscv64Test, Srl) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Srl, "srl {reg1}, {reg2}, {reg3}"), "Srl");
+}
+
+TEST_F(AssemblerRiscv64Test, Sra) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sra, "sra {reg1}, {reg2}, {reg3}"), "Sra");
+}
+
+TEST_F(AssemblerRiscv64Test, Addiw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Addiw, -12, "addiw {reg1}, {reg2}, {imm}"), "Addiw");
+}
+
+TEST_F(AssemblerRiscv64Test, Slliw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Slliw, 5, "slliw {reg1}, {reg2}, {imm}"), "Slliw");
+}
+
+TEST_F(AssemblerRiscv64Test, Srliw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Srliw, 5, "srliw {reg1}, {reg2}, {imm}"), "Srliw");
+}
+
+TEST_F(AssemblerRiscv64Test, Sraiw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Sraiw, 5, "sraiw {reg1}, {reg2}, {imm}"), "Sraiw");
+}
+
+TEST_F(AssemblerRiscv64Test, Addw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Addw, "addw {reg1}, {reg2}, {reg3}"), "Addw");
+}
+
+TEST_F(AssemblerRiscv64Test, Subw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Subw, "subw {reg1}, {reg2}, {reg3}"), "Subw");
+}
+
+TEST_F(AssemblerRiscv64Test, Sllw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sllw, "sllw {reg1}, {reg2}, {reg3}"), "Sllw");
+}
+
+TEST_F(AssemblerRiscv64Test, Srlw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Srlw, "srlw {reg1}, {reg2}, {reg3}"), "Srlw");
+}
+
+TEST_F(AssemblerRiscv64Test, Sraw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sraw, "sraw {reg1}, {reg2}, {reg3}"), "Sraw");
+}
+
+TEST_F(AssemblerRiscv64Test, SystemAndFence) {
+  GetAssembler()->Ecall();
+  GetAssembler()->Ebreak();
+  GetAssembler()->Fence();
+  GetAssembler()->Fence(kFenceRead | kFenceWrite, kFenceWrite);
+  GetAssembler()->Fence(kFenceInput | kFenceOutput, kFenceRead);
+  const char* expected =
+      "ecall\n"
+      "ebreak\n"
+      "fence\n"
+      "fence rw, w\n"
+      "fence io, r\n";
+  DriverStr(expected, "SystemAndFence");
+}
+
+TEST_F(AssemblerRiscv64Test, Mul) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Mul, "mul {reg1}, {reg2}, {reg3}"), "Mul");
+}
+
+TEST_F(AssemblerRiscv64Test, Mulh) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Mulh, "mulh {reg1}, {reg2}, {reg3}"), "Mulh");
+}
+
+TEST_F(AssemblerRiscv64Test, Mulhsu) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Mulhsu, "mulhsu {reg1}, {reg2}, {reg3}"), "Mulhsu");
+}
+
+TEST_F(AssemblerRiscv64Test, Mulhu) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Mulhu, "mulhu {reg1}, {reg2}, {reg3}"), "Mulhu");
+}
+
+TEST_F(AssemblerRiscv64Test, Div) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Div, "div {reg1}, {reg2}, {reg3}"), "Div");
+}
+
+TEST_F(AssemblerRiscv64Test, Divu) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Divu, "divu {reg1}, {reg2}, {reg3}"), "Divu");
+}
+
+TEST_F(AssemblerRiscv64Test, Rem) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Rem, "rem {reg1}, {reg2}, {reg3}"), "Rem");
+}
+
+TEST_F(AssemblerRiscv64Test, Remu) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Remu, "remu {reg1}, {reg2}, {reg3}"), "Remu");
+}
+
+TEST_F(AssemblerRiscv64Test, Mulw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Mulw, "mulw {reg1}, {reg2}, {reg3}"), "Mulw");
+}
+
+TEST_F(AssemblerRiscv64Test, Divw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Divw, "divw {reg1}, {reg2}, {reg3}"), "Divw");
+}
+
+TEST_F(AssemblerRiscv64Test, Divuw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Divuw, "divuw {reg1}, {reg2}, {reg3}"), "Divuw");
+}
+
+TEST_F(AssemblerRiscv64Test, Remw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Remw, "remw {reg1}, {reg2}, {reg3}"), "Remw");
+}
+
+TEST_F(AssemblerRiscv64Test, Remuw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Remuw, "remuw {reg1}, {reg2}, {reg3}"), "Remuw");
+}
+
+TEST_F(AssemblerRiscv64Test, Atomics) {
+  static const std::map<AqRl, const char*> kSuffixes = {
+      {AqRl::kNone, ""}, {AqRl::kRelease, ".rl"}, {AqRl::kAcquire, ".aq"}, {AqRl::kAqRl, ".aqrl"}};
+  std::string expected;
+  for (const auto& [aqrl, suffix] : kSuffixes) {
+    GetAssembler()->LrW(A0, A1, aqrl);
+    GetAssembler()->LrD(T0, S11, aqrl);
+    GetAssembler()->ScW(A0, A2, A1, aqrl);
+    GetAssembler()->ScD(T6, Zero, SP, aqrl);
+    GetAssembler()->AmoSwapW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoSwapD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoAddW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoAddD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoXorW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoXorD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoAndW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoAndD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoOrW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoOrD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMinW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMinD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMaxW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMaxD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMinuW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMinuD(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMaxuW(A0, A2, A1, aqrl);
+    GetAssembler()->AmoMaxuD(A0, A2, A1, aqrl);
+    std::string s(suffix);
+    expected += "lr.w" + s + " a0, (a1)\n" +
+                "lr.d" + s + " t0, (s11)\n" +
+                "sc.w" + s + " a0, a2, (a1)\n" +
+                "sc.d" + s + " t6, zero, (sp)\n" +
+                "amoswap.w" + s + " a0, a2, (a1)\n" +
+                "amoswap.d" + s + " a0, a2, (a1)\n" +
+                "amoadd.w" + s + " a0, a2, (a1)\n" +
+                "amoadd.d" + s + " a0, a2, (a1)\n" +
+                "amoxor.w" + s + " a0, a2, (a1)\n" +
+                "amoxor.d" + s + " a0, a2, (a1)\n" +
+                "amoand.w" + s + " a0, a2, (a1)\n" +
+                "amoand.d" + s + " a0, a2, (a1)\n" +
+                "amoor.w" + s + " a0, a2, (a1)\n" +
+                "amoor.d" + s + " a0, a2, (a1)\n" +
+                "amomin.w" + s + " a0, a2, (a1)\n" +
+                "amomin.d" + s + " a0, a2, (a1)\n" +
+                "amomax.w" + s + " a0, a2, (a1)\n" +
+                "amomax.d" + s + " a0, a2, (a1)\n" +
+                "amominu.w" + s + " a0, a2, (a1)\n" +
+                "amominu.d" + s + " a0, a2, (a1)\n" +
+                "amomaxu.w" + s + " a0, a2, (a1)\n" +
+                "amomaxu.d" + s + " a0, a2, (a1)\n";
+  }
+  DriverStr(expected, "Atomics");
+}
+
+TEST_F(AssemblerRiscv64Test, FLw) {
+  DriverStr(RepeatFRIb(&Riscv64Assembler::FLw, -12, "flw {reg1}, {imm}({reg2})"), "FLw");
+}
+
+TEST_F(AssemblerRiscv64Test, FLd) {
+  DriverStr(RepeatFRIb(&Riscv64Assembler::FLd, -12, "fld {reg1}, {imm}({reg2})"), "FLd");
+}
+
+TEST_F(AssemblerRiscv64Test, FSw) {
+  DriverStr(RepeatFRIb(&Riscv64Assembler::FSw, -12, "fsw {reg1}, {imm}({reg2})"), "FSw");
+}
+
+TEST_F(AssemblerRiscv64Test, FSd) {
+  DriverStr(RepeatFRIb(&Riscv64Assembler::FSd, -12, "fsd {reg1}, {imm}({reg2})"), "FSd");
+}
+
+TEST_F(AssemblerRiscv64Test, FusedMultiplyAdd) {
+  std::string expected;
+  for (FRegister* reg : GetFPRegisters()) {
+    FRegister rd = *reg;
+    FRegister rs1 = static_cast<FRegister>((rd + 1) % kNumberOfFRegisters);
+    FRegister rs2 = static_cast<FRegister>((rd + 7) % kNumberOfFRegisters);
+    FRegister rs3 = static_cast<FRegister>((rd + 13) % kNumberOfFRegisters);
+    GetAssembler()->FMAddS(rd, rs1, rs2, rs3);
+    GetAssembler()->FMAddD(rd, rs1, rs2, rs3);
+    GetAssembler()->FMSubS(rd, rs1, rs2, rs3);
+    GetAssembler()->FMSubD(rd, rs1, rs2, rs3);
+    GetAssembler()->FNMSubS(rd, rs1, rs2, rs3);
+    GetAssembler()->FNMSubD(rd, rs1, rs2, rs3);
+    GetAssembler()->FNMAddS(rd, rs1, rs2, rs3);
+    GetAssembler()->FNMAddD(rd, rs1, rs2, rs3);
+    std::ostringstream oss;
+    oss << " " << rd << ", " << rs1 << ", " << rs2 << ", " << rs3 << "\n";
+    std::string operands = oss.str();
+    expected += "fmadd.s" + operands + "fmadd.d" + operands +
+                "fmsub.s" + operands + "fmsub.d" + operands +
+                "fnmsub.s" + operands + "fnmsub.d" + operands +
+                "fnmadd.s" + operands + "fnmadd.d" + operands;
+  }
+  DriverStr(expected, "FusedMultiplyAdd");
+}
+
+TEST_F(AssemblerRiscv64Test, FAddS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FAddS, "fadd.s {reg1}, {reg2}, {reg3}"), "FAddS");
+}
+
+TEST_F(AssemblerRiscv64Test, FAddD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FAddD, "fadd.d {reg1}, {reg2}, {reg3}"), "FAddD");
+}
+
+TEST_F(AssemblerRiscv64Test, FSubS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSubS, "fsub.s {reg1}, {reg2}, {reg3}"), "FSubS");
+}
+
+TEST_F(AssemblerRiscv64Test, FSubD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSubD, "fsub.d {reg1}, {reg2}, {reg3}"), "FSubD");
+}
+
+TEST_F(AssemblerRiscv64Test, FMulS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FMulS, "fmul.s {reg1}, {reg2}, {reg3}"), "FMulS");
+}
+
+TEST_F(AssemblerRiscv64Test, FMulD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FMulD, "fmul.d {reg1}, {reg2}, {reg3}"), "FMulD");
+}
+
+TEST_F(AssemblerRiscv64Test, FDivS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FDivS, "fdiv.s {reg1}, {reg2}, {reg3}"), "FDivS");
+}
+
+TEST_F(AssemblerRiscv64Test, FDivD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FDivD, "fdiv.d {reg1}, {reg2}, {reg3}"), "FDivD");
+}
+
+TEST_F(AssemblerRiscv64Test, FSqrtS) {
+  DriverStr(RepeatFF(&Riscv64Assembler::FSqrtS, "fsqrt.s {reg1}, {reg2}"), "FSqrtS");
+}
+
+TEST_F(AssemblerRiscv64Test, FSqrtD) {
+  DriverStr(RepeatFF(&Riscv64Assembler::FSqrtD, "fsqrt.d {reg1}, {reg2}"), "FSqrtD");
+}
+
+TEST_F(AssemblerRiscv64Test, FSgnjS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSgnjS, "fsgnj.s {reg1}, {reg2}, {reg3}"), "FSgnjS");
+}
+
+TEST_F(AssemblerRiscv64Test, FSgnjD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSgnjD, "fsgnj.d {reg1}, {reg2}, {reg3}"), "FSgnjD");
+}
+
+TEST_F(AssemblerRiscv64Test, FSgnjnS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSgnjnS, "fsgnjn.s {reg1}, {reg2}, {reg3}"), "FSgnjnS");
+}
+
+TEST_F(AssemblerRiscv64Test, FSgnjnD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSgnjnD, "fsgnjn.d {reg1}, {reg2}, {reg3}"), "FSgnjnD");
+}
+
+TEST_F(AssemblerRiscv64Test, FSgnjxS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSgnjxS, "fsgnjx.s {reg1}, {reg2}, {reg3}"), "FSgnjxS");
+}
+
+TEST_F(AssemblerRiscv64Test, FSgnjxD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FSgnjxD, "fsgnjx.d {reg1}, {reg2}, {reg3}"), "FSgnjxD");
+}
+
+TEST_F(AssemblerRiscv64Test, FMinS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FMinS, "fmin.s {reg1}, {reg2}, {reg3}"), "FMinS");
+}
+
+TEST_F(AssemblerRiscv64Test, FMinD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FMinD, "fmin.d {reg1}, {reg2}, {reg3}"), "FMinD");
+}
+
+TEST_F(AssemblerRiscv64Test, FMaxS) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FMaxS, "fmax.s {reg1}, {reg2}, {reg3}"), "FMaxS");
+}
+
+TEST_F(AssemblerRiscv64Test, FMaxD) {
+  DriverStr(RepeatFFF(&Riscv64Assembler::FMaxD, "fmax.d {reg1}, {reg2}, {reg3}"), "FMaxD");
+}
+
+TEST_F(AssemblerRiscv64Test, FCompare) {
+  std::string expected;
+  for (XRegister* reg : GetRegisters()) {
+    XRegister rd = *reg;
+    FRegister rs1 = static_cast<FRegister>((rd + 3) % kNumberOfFRegisters);
+    FRegister rs2 = static_cast<FRegister>((rd + 17) % kNumberOfFRegisters);
+    GetAssembler()->FEqS(rd, rs1, rs2);
+    GetAssembler()->FEqD(rd, rs1, rs2);
+    GetAssembler()->FLtS(rd, rs1, rs2);
+    GetAssembler()->FLtD(rd, rs1, rs2);
+    GetAssembler()->FLeS(rd, rs1, rs2);
+    GetAssembler()->FLeD(rd, rs1, rs2);
+    GetAssembler()->FClassS(rd, rs1);
+    GetAssembler()->FClassD(rd, rs2);
+    std::ostringstream oss;
+    oss << "feq.s " << rd << ", " << rs1 << ", " << rs2 << "\n"
+        << "feq.d " << rd << ", " << rs1 << ", " << rs2 << "\n"
+        << "flt.s " << rd << ", " << rs1 << ", " << rs2 << "\n"
+        << "flt.d " << rd << ", " << rs1 << ", " << rs2 << "\n"
+        << "fle.s " << rd << ", " << rs1 << ", " << rs2 << "\n"
+        << "fle.d " << rd << ", " << rs1 << ", " << rs2 << "\n"
+        << "fclass.s " << rd << ", " << rs1 << "\n"
+        << "fclass.d " << rd << ", " << rs2 << "\n";
+    expected += oss.str();
+  }
+  DriverStr(expected, "FCompare");
+}
+
+TEST_F(AssemblerRiscv64Test, FCvtSD) {
+  DriverStr(RepeatWithRoundingMode(
+                &Riscv64Assembler::FCvtSD, GetFPRegisters(), GetFPRegisters(), "fcvt.s.d"),
+            "FCvtSD");
+}
+
+TEST_F(AssemblerRiscv64Test, FCvtDS) {
+  DriverStr(RepeatFF(&Riscv64Assembler::FCvtDS, "fcvt.d.s {reg1}, {reg2}"), "FCvtDS");
+}
+
+TEST_F(AssemblerRiscv64Test, FCvtFPToInteger) {
+  std::string expected =
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtWS, GetRegisters(), GetFPRegisters(),
+                             "fcvt.w.s") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtWD, GetRegisters(), GetFPRegisters(),
+                             "fcvt.w.d") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtWuS, GetRegisters(), GetFPRegisters(),
+                             "fcvt.wu.s") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtWuD, GetRegisters(), GetFPRegisters(),
+                             "fcvt.wu.d") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtLS, GetRegisters(), GetFPRegisters(),
+                             "fcvt.l.s") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtLD, GetRegisters(), GetFPRegisters(),
+                             "fcvt.l.d") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtLuS, GetRegisters(), GetFPRegisters(),
+                             "fcvt.lu.s") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtLuD, GetRegisters(), GetFPRegisters(),
+                             "fcvt.lu.d");
+  DriverStr(expected, "FCvtFPToInteger");
+}
+
+TEST_F(AssemblerRiscv64Test, FCvtIntegerToFP) {
+  std::string expected =
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtSW, GetFPRegisters(), GetRegisters(),
+                             "fcvt.s.w") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtSWu, GetFPRegisters(), GetRegisters(),
+                             "fcvt.s.wu") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtSL, GetFPRegisters(), GetRegisters(),
+                             "fcvt.s.l") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtDL, GetFPRegisters(), GetRegisters(),
+                             "fcvt.d.l") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtSLu, GetFPRegisters(), GetRegisters(),
+                             "fcvt.s.lu") +
+      RepeatWithRoundingMode(&Riscv64Assembler::FCvtDLu, GetFPRegisters(), GetRegisters(),
+                             "fcvt.d.lu") +
+      RepeatFR(&Riscv64Assembler::FCvtDW, "fcvt.d.w {reg1}, {reg2}") +
+      RepeatFR(&Riscv64Assembler::FCvtDWu, "fcvt.d.wu {reg1}, {reg2}");
+  DriverStr(expected, "FCvtIntegerToFP");
+}
+
+TEST_F(AssemblerRiscv64Test, FMvXW) {
+  DriverStr(RepeatRF(&Riscv64Assembler::FMvXW, "fmv.x.w {reg1}, {reg2}"), "FMvXW");
+}
+
+TEST_F(AssemblerRiscv64Test, FMvXD) {
+  DriverStr(RepeatRF(&Riscv64Assembler::FMvXD, "fmv.x.d {reg1}, {reg2}"), "FMvXD");
+}
+
+TEST_F(AssemblerRiscv64Test, FMvWX) {
+  DriverStr(RepeatFR(&Riscv64Assembler::FMvWX, "fmv.w.x {reg1}, {reg2}"), "FMvWX");
+}
+
+TEST_F(AssemblerRiscv64Test, FMvDX) {
+  DriverStr(RepeatFR(&Riscv64Assembler::FMvDX, "fmv.d.x {reg1}, {reg2}"), "FMvDX");
+}
+
+TEST_F(AssemblerRiscv64Test, AddUw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::AddUw, "add.uw {reg1}, {reg2}, {reg3}"), "AddUw");
+}
+
+TEST_F(AssemblerRiscv64Test, Sh1Add) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sh1Add, "sh1add {reg1}, {reg2}, {reg3}"), "Sh1Add");
+}
+
+TEST_F(AssemblerRiscv64Test, Sh1AddUw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sh1AddUw, "sh1add.uw {reg1}, {reg2}, {reg3}"),
+            "Sh1AddUw");
+}
+
+TEST_F(AssemblerRiscv64Test, Sh2Add) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sh2Add, "sh2add {reg1}, {reg2}, {reg3}"), "Sh2Add");
+}
+
+TEST_F(AssemblerRiscv64Test, Sh2AddUw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sh2AddUw, "sh2add.uw {reg1}, {reg2}, {reg3}"),
+            "Sh2AddUw");
+}
+
+TEST_F(AssemblerRiscv64Test, Sh3Add) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sh3Add, "sh3add {reg1}, {reg2}, {reg3}"), "Sh3Add");
+}
+
+TEST_F(AssemblerRiscv64Test, Sh3AddUw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Sh3AddUw, "sh3add.uw {reg1}, {reg2}, {reg3}"),
+            "Sh3AddUw");
+}
+
+TEST_F(AssemblerRiscv64Test, SlliUw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::SlliUw, 6, "slli.uw {reg1}, {reg2}, {imm}"), "SlliUw");
+}
+
+TEST_F(AssemblerRiscv64Test, Andn) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Andn, "andn {reg1}, {reg2}, {reg3}"), "Andn");
+}
+
+TEST_F(AssemblerRiscv64Test, Orn) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Orn, "orn {reg1}, {reg2}, {reg3}"), "Orn");
+}
+
+TEST_F(AssemblerRiscv64Test, Xnor) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Xnor, "xnor {reg1}, {reg2}, {reg3}"), "Xnor");
+}
+
+TEST_F(AssemblerRiscv64Test, Clz) {
+  DriverStr(RepeatRR(&Riscv64Assembler::Clz, "clz {reg1}, {reg2}"), "Clz");
+}
+
+TEST_F(AssemblerRiscv64Test, Clzw) {
+  DriverStr(RepeatRR(&Riscv64Assembler::Clzw, "clzw {reg1}, {reg2}"), "Clzw");
+}
+
+TEST_F(AssemblerRiscv64Test, Ctz) {
+  DriverStr(RepeatRR(&Riscv64Assembler::Ctz, "ctz {reg1}, {reg2}"), "Ctz");
+}
+
+TEST_F(AssemblerRiscv64Test, Ctzw) {
+  DriverStr(RepeatRR(&Riscv64Assembler::Ctzw, "ctzw {reg1}, {reg2}"), "Ctzw");
+}
+
+TEST_F(AssemblerRiscv64Test, Cpop) {
+  DriverStr(RepeatRR(&Riscv64Assembler::Cpop, "cpop {reg1}, {reg2}"), "Cpop");
+}
+
+TEST_F(AssemblerRiscv64Test, Cpopw) {
+  DriverStr(RepeatRR(&Riscv64Assembler::Cpopw, "cpopw {reg1}, {reg2}"), "Cpopw");
+}
+
+TEST_F(AssemblerRiscv64Test, Min) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Min, "min {reg1}, {reg2}, {reg3}"), "Min");
+}
+
+TEST_F(AssemblerRiscv64Test, Minu) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Minu, "minu {reg1}, {reg2}, {reg3}"), "Minu");
+}
+
+TEST_F(AssemblerRiscv64Test, Max) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Max, "max {reg1}, {reg2}, {reg3}"), "Max");
+}
+
+TEST_F(AssemblerRiscv64Test, Maxu) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Maxu, "maxu {reg1}, {reg2}, {reg3}"), "Maxu");
+}
+
+TEST_F(AssemblerRiscv64Test, Rol) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Rol, "rol {reg1}, {reg2}, {reg3}"), "Rol");
+}
+
+TEST_F(AssemblerRiscv64Test, Rolw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Rolw, "rolw {reg1}, {reg2}, {reg3}"), "Rolw");
+}
+
+TEST_F(AssemblerRiscv64Test, Ror) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Ror, "ror {reg1}, {reg2}, {reg3}"), "Ror");
+}
+
+TEST_F(AssemblerRiscv64Test, Rorw) {
+  DriverStr(RepeatRRR(&Riscv64Assembler::Rorw, "rorw {reg1}, {reg2}, {reg3}"), "Rorw");
+}
+
+TEST_F(AssemblerRiscv64Test, Rori) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Rori, 6, "rori {reg1}, {reg2}, {imm}"), "Rori");
+}
+
+TEST_F(AssemblerRiscv64Test, Roriw) {
+  DriverStr(RepeatRRIb(&Riscv64Assembler::Roriw, 5, "roriw {reg1}, {reg2}, {imm}"), "Roriw");
+}
+
+TEST_F(AssemblerRiscv64Test, OrcB) {
+  DriverStr(RepeatRR(&Riscv64Assembler::OrcB, "orc.b {reg1}, {reg2}"), "OrcB");
+}
+
+TEST_F(AssemblerRiscv64Test, Rev8) {
+  DriverStr(RepeatRR(&Riscv64Assembler::Rev8, "rev8 {reg1}, {reg2}"), "Rev8");
+}
+
+TEST_F(AssemblerRiscv64Test, SextB) {
+  DriverStr(RepeatRR(&Riscv64Assembler::SextB, "sext.b {reg1}, {reg2}"), "SextB");
+}
+
+TEST_F(AssemblerRiscv64Test, SextH) {
+  DriverStr(RepeatRR(&Riscv64Assembler::SextH, "sext.h {reg1}, {reg2}"), "SextH");
+}
+
+TEST_F(AssemblerRiscv64Test, ZextH) {
+  DriverStr(RepeatRR(&Riscv64Assembler::ZextH, "zext.h {reg1}, {reg2}"), "ZextH");
+}
+
+TEST_F(AssemblerRiscv64Test, PseudoInstructions) {
+  GetAssembler()->Nop();
+  GetAssembler()->Mv(A0, S11);
+  GetAssembler()->Not(T0, T1);
+  GetAssembler()->Neg(A0, A1);
+  GetAssembler()->NegW(A0, A1);
+  GetAssembler()->SextW(A0, A1);
+  GetAssembler()->ZextB(A0, A1);
+  GetAssembler()->ZextW(A0, A1);
+  GetAssembler()->Seqz(A0, A1);
+  GetAssembler()->Snez(A0, A1);
+  GetAssembler()->Sltz(A0, A1);
+  GetAssembler()->Sgtz(A0, A1);
+  GetAssembler()->FMvS(FA0, FT11);
+  GetAssembler()->FMvD(FA0, FT11);
+  GetAssembler()->FAbsS(FA0, FA1);
+  GetAssembler()->FAbsD(FA0, FA1);
+  GetAssembler()->FNegS(FA0, FA1);
+  GetAssembler()->FNegD(FA0, FA1);
+  GetAssembler()->Jr(T0);
+  GetAssembler()->Jalr(T1);
+  GetAssembler()->Ret();
+  const char* expected =
+      "nop\n"
+      "mv a0, s11\n"
+      "not t0, t1\n"
+      "neg a0, a1\n"
+      "negw a0, a1\n"
+      "sext.w a0, a1\n"
+      "zext.b a0, a1\n"
+      "zext.w a0, a1\n"
+      "seqz a0, a1\n"
+      "snez a0, a1\n"
+      "sltz a0, a1\n"
+      "sgtz a0, a1\n"
+      "fmv.s fa0, ft11\n"
+      "fmv.d fa0, ft11\n"
+      "fabs.s fa0, fa1\n"
+      "fabs.d fa0, fa1\n"
+      "fneg.s fa0, fa1\n"
+      "fneg.d fa0, fa1\n"
+      "jr t0\n"
+      "jalr t1\n"
+      "ret\n";
+  DriverStr(expected, "PseudoInstructions");
+}
+
+TEST_F(AssemblerRiscv64Test, Li) {
+  // Only values fitting in 32 bits: the reference assembler may pick a different,
+  // equally long, sequence for wider constants.
+  static constexpr int64_t kValues[] = {
+      0, 1, -1, 2047, -2048, 2048, -2049, 4096, 0x12345678, -0x12345678,
+      0x7ffff7ff, 0x7ffff800, 0x7fffffff, -0x80000000LL, -0x7ffff801,
+  };
+  std::string expected;
+  for (int64_t value : kValues) {
+    GetAssembler()->Li(A0, value);
+    expected += "li a0, " + std::to_string(value) + "\n";
+  }
+  DriverStr(expected, "Li");
+}
+
+TEST_F(AssemblerRiscv64Test, Branches) {
+  Riscv64Assembler* assembler = GetAssembler();
+  Label label1, label2;
+  assembler->Bind(&label1);
+  assembler->Beq(A0, A1, &label2);
+  assembler->Bne(A0, A1, &label2);
+  assembler->Blt(A0, A1, &label2);
+  assembler->Bge(A0, A1, &label2);
+  assembler->Bltu(A0, A1, &label2);
+  assembler->Bgeu(A0, A1, &label2);
+  assembler->Beqz(A0, &label2);
+  assembler->Bnez(A0, &label2);
+  assembler->Blez(A0, &label2);
+  assembler->Bgez(A0, &label2);
+  assembler->Bltz(A0, &label2);
+  assembler->Bgtz(A0, &label2);
+  assembler->Bgt(A0, A1, &label2);
+  assembler->Ble(A0, A1, &label2);
+  assembler->Bgtu(A0, A1, &label2);
+  assembler->Bleu(A0, A1, &label2);
+  assembler->J(&label2);
+  assembler->Jal(&label2);
+  assembler->Jal(T0, &label2);
+  for (size_t i = 0; i != 100; ++i) {
+    assembler->Nop();
+  }
+  assembler->Bind(&label2);
+  assembler->Beq(A0, A1, &label1);
+  assembler->Bgtu(A0, A1, &label1);
+  assembler->J(&label1);
+  assembler->Jal(&label1);
+  assembler->Jump(&label1);
+
+  std::string expected =
+      "1:\n"
+      "beq a0, a1, 2f\n"
+      "bne a0, a1, 2f\n"
+      "blt a0, a1, 2f\n"
+      "bge a0, a1, 2f\n"
+      "bltu a0, a1, 2f\n"
+      "bgeu a0, a1, 2f\n"
+      "beqz a0, 2f\n"
+      "bnez a0, 2f\n"
+      "blez a0, 2f\n"
+      "bgez a0, 2f\n"
+      "bltz a0, 2f\n"
+      "bgtz a0, 2f\n"
+      "bgt a0, a1, 2f\n"
+      "ble a0, a1, 2f\n"
+      "bgtu a0, a1, 2f\n"
+      "bleu a0, a1, 2f\n"
+      "j 2f\n"
+      "jal 2f\n"
+      "jal t0, 2f\n";
+  for (size_t i = 0; i != 100; ++i) {
+    expected += "nop\n";
+  }
+  expected +=
+      "2:\n"
+      "beq a0, a1, 1b\n"
+      "bgtu a0, a1, 1b\n"
+      "j 1b\n"
+      "jal 1b\n"
+      "j 1b\n";
+  DriverStr(expected, "Branches");
+}
+
+}  // namespace riscv64
+}  // namespace art
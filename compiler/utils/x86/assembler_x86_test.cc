@@ -1220,6 +1220,10 @@ TEST_F(AssemblerX86Test, PCmpgtQ) {
   DriverStr(RepeatFF(&x86::X86Assembler::pcmpgtq, "pcmpgtq %{reg2}, %{reg1}"), "cmpgtq");
 }
 
+TEST_F(AssemblerX86Test, PMovmskB) {
+  DriverStr(RepeatRF(&x86::X86Assembler::pmovmskb, "pmovmskb %{reg2}, %{reg1}"), "pmovmskb");
+}
+
 TEST_F(AssemblerX86Test, ShufPS) {
   DriverStr(RepeatFFI(&x86::X86Assembler::shufps, 1, "shufps ${imm}, %{reg2}, %{reg1}"), "shufps");
 }
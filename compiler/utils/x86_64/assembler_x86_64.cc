@@ -32,6 +32,10 @@ std::ostream& operator<<(std::ostream& os, const XmmRegister& reg) {
   return os << reg.AsFloatRegister();
 }
 
+std::ostream& operator<<(std::ostream& os, const YmmRegister& reg) {
+  return os << "YMM" << static_cast<int>(reg.AsFloatRegister());
+}
+
 std::ostream& operator<<(std::ostream& os, const X87Register& reg) {
   return os << "ST" << static_cast<int>(reg);
 }
@@ -3509,6 +3513,15 @@ void X86_64Assembler::pcmpgtq(XmmRegister dst, XmmRegister src) {
   EmitXmmRegisterOperand(dst.LowBits(), src);
 }
 
+void X86_64Assembler::pmovmskb(CpuRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0xD7);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+}
+
 void X86_64Assembler::shufpd(XmmRegister dst, XmmRegister src, const Immediate& imm) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -3728,6 +3741,654 @@ void X86_64Assembler::psrldq(XmmRegister reg, const Immediate& shift_count) {
   EmitUint8(shift_count.value());
 }
 
+void X86_64Assembler::vmovdqa(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Move(SET_VEX_PP_66, 0x6F, 0x7F, dst, src);
+}
+
+void X86_64Assembler::vmovdqa(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x6F,
+             dst.AsFloatRegister(), kNoVexRegister, src);
+}
+
+void X86_64Assembler::vmovdqa(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x7F,
+             src.AsFloatRegister(), kNoVexRegister, dst);
+}
+
+void X86_64Assembler::vmovdqu(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Move(SET_VEX_PP_F3, 0x6F, 0x7F, dst, src);
+}
+
+void X86_64Assembler::vmovdqu(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_F3, 0x6F,
+             dst.AsFloatRegister(), kNoVexRegister, src);
+}
+
+void X86_64Assembler::vmovdqu(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_F3, 0x7F,
+             src.AsFloatRegister(), kNoVexRegister, dst);
+}
+
+void X86_64Assembler::vmovaps(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Move(SET_VEX_PP_NONE, 0x28, 0x29, dst, src);
+}
+
+void X86_64Assembler::vmovaps(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x28,
+             dst.AsFloatRegister(), kNoVexRegister, src);
+}
+
+void X86_64Assembler::vmovaps(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x29,
+             src.AsFloatRegister(), kNoVexRegister, dst);
+}
+
+void X86_64Assembler::vmovups(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Move(SET_VEX_PP_NONE, 0x10, 0x11, dst, src);
+}
+
+void X86_64Assembler::vmovups(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x10,
+             dst.AsFloatRegister(), kNoVexRegister, src);
+}
+
+void X86_64Assembler::vmovups(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x11,
+             src.AsFloatRegister(), kNoVexRegister, dst);
+}
+
+void X86_64Assembler::vmovapd(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Move(SET_VEX_PP_66, 0x28, 0x29, dst, src);
+}
+
+void X86_64Assembler::vmovapd(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x28,
+             dst.AsFloatRegister(), kNoVexRegister, src);
+}
+
+void X86_64Assembler::vmovapd(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x29,
+             src.AsFloatRegister(), kNoVexRegister, dst);
+}
+
+void X86_64Assembler::vmovupd(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Move(SET_VEX_PP_66, 0x10, 0x11, dst, src);
+}
+
+void X86_64Assembler::vmovupd(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x10,
+             dst.AsFloatRegister(), kNoVexRegister, src);
+}
+
+void X86_64Assembler::vmovupd(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x11,
+             src.AsFloatRegister(), kNoVexRegister, dst);
+}
+
+void X86_64Assembler::vpaddb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFC,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFD,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFE,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD4,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xF8,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xF9,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFA,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFB,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmullw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD5,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmulld(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x40,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaddwd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xF5,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddusb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDC,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEC,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddusw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDD,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xED,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubusb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD8,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE8,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubusw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD9,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE9,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpavgb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE0,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpavgw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE3,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x38,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3C,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEA,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEE,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminsd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x39,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxsd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3D,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminub(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDA,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxub(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDE,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminuw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3A,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxuw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3E,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminud(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3B,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxud(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3F,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpeqb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x74,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpeqw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x75,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpeqd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x76,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpeqq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x29,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpgtb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x64,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpgtw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x65,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpgtd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x66,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpgtq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x37,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmovmskb(CpuRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD7,
+             dst.AsRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpand(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDB,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpandn(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDF,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEB,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpxor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEF,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vaddps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x58,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vsubps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5C,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmulps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x59,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vdivps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5E,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vminps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5D,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmaxps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5F,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x54,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandnps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x55,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x56,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vxorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x57,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vaddpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x58,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vsubpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5C,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmulpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x59,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vdivpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5E,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vminpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5D,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmaxpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5F,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x54,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandnpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x55,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x56,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vxorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x57,
+             dst.AsFloatRegister(), src1.AsFloatRegister(), src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpabsb(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x1C,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpabsw(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x1D,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpabsd(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x1E,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vcvtdq2ps(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5B,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsllw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x71,
+             6, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpslld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x72,
+             6, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsllq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x73,
+             6, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsraw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x71,
+             4, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrad(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x72,
+             4, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrlw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x71,
+             2, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x72,
+             2, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrlq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x73,
+             2, dst.AsFloatRegister(), src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpbroadcastb(YmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x78,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpbroadcastw(YmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x79,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpbroadcastd(YmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x58,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpbroadcastq(YmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x59,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vbroadcastss(YmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x18,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vbroadcastsd(YmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x19,
+             dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmovzxbw(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x30,
+             dst.AsFloatRegister(), kNoVexRegister, src);
+}
+
+void X86_64Assembler::vextracti128(XmmRegister dst, YmmRegister src, const Immediate& imm) {
+  DCHECK(imm.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_3A, SET_VEX_PP_66, 0x39,
+             src.AsFloatRegister(), kNoVexRegister, dst.AsFloatRegister());
+  EmitUint8(imm.value());
+}
+
+/**VEX.128.0F.WIG 77 VZEROUPPER */
+void X86_64Assembler::vzeroupper() {
+  DCHECK(CpuHasAVXorAVX2FeatureFlag());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(EmitVexPrefixByteZero(/*is_twobyte_form=*/ true));
+  EmitUint8(EmitVexPrefixByteOne(/*R=*/ false,
+                                 ManagedRegister::NoRegister().AsX86_64(),
+                                 SET_VEX_L_128,
+                                 SET_VEX_PP_NONE));
+  EmitUint8(0x77);
+}
+
 
 void X86_64Assembler::fldl(const Address& src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
@@ -5784,5 +6445,51 @@ uint8_t X86_64Assembler::EmitVexPrefixByteTwo(bool W,
   return vex_prefix;
 }
 
+void X86_64Assembler::EmitVex256Prefix(int vex_m, int vex_pp, bool R, bool X, bool B, int vvvv) {
+  DCHECK(CpuHasAVXorAVX2FeatureFlag());
+  X86_64ManagedRegister vvvv_reg = (vvvv == kNoVexRegister)
+      ? ManagedRegister::NoRegister().AsX86_64()
+      : X86_64ManagedRegister::FromXmmRegister(static_cast<FloatRegister>(vvvv));
+  // The two byte form can only encode the 0F opcode map and REX.R.
+  bool is_twobyte_form = (vex_m == SET_VEX_M_0F) && !X && !B;
+  EmitUint8(EmitVexPrefixByteZero(is_twobyte_form));
+  if (is_twobyte_form) {
+    EmitUint8(EmitVexPrefixByteOne(R, vvvv_reg, SET_VEX_L_256, vex_pp));
+  } else {
+    EmitUint8(EmitVexPrefixByteOne(R, X, B, vex_m));
+    EmitUint8((vvvv == kNoVexRegister)
+        ? EmitVexPrefixByteTwo(/*W=*/ false, SET_VEX_L_256, vex_pp)
+        : EmitVexPrefixByteTwo(/*W=*/ false, vvvv_reg, SET_VEX_L_256, vex_pp));
+  }
+}
+
+void X86_64Assembler::EmitVex256(
+    int vex_m, int vex_pp, uint8_t opcode, int reg, int vvvv, int rm) {
+  EmitVex256Prefix(vex_m, vex_pp, /*R=*/ reg > 7, /*X=*/ false, /*B=*/ rm > 7, vvvv);
+  EmitUint8(opcode);
+  EmitUint8(0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+void X86_64Assembler::EmitVex256(
+    int vex_m, int vex_pp, uint8_t opcode, int reg, int vvvv, const Address& rm) {
+  uint8_t rex = rm.rex();
+  EmitVex256Prefix(vex_m, vex_pp, /*R=*/ reg > 7, rex & GET_REX_X, rex & GET_REX_B, vvvv);
+  EmitUint8(opcode);
+  EmitOperand(reg & 7, rm);
+}
+
+void X86_64Assembler::EmitVex256Move(
+    int vex_pp, uint8_t load_opcode, uint8_t store_opcode, YmmRegister dst, YmmRegister src) {
+  // Like the XMM moves, prefer the store form when only the source needs REX, so that the two
+  // byte VEX prefix can be used.
+  if (src.NeedsRex() && !dst.NeedsRex()) {
+    EmitVex256(SET_VEX_M_0F, vex_pp, store_opcode,
+               src.AsFloatRegister(), kNoVexRegister, dst.AsFloatRegister());
+  } else {
+    EmitVex256(SET_VEX_M_0F, vex_pp, load_opcode,
+               dst.AsFloatRegister(), kNoVexRegister, src.AsFloatRegister());
+  }
+}
+
 }  // namespace x86_64
 }  // namespace art
@@ -722,6 +722,8 @@ class X86_64Assembler final : public Assembler {
   void pcmpgtd(XmmRegister dst, XmmRegister src);
   void pcmpgtq(XmmRegister dst, XmmRegister src);  // SSE4.2
 
+  void pmovmskb(CpuRegister dst, XmmRegister src);
+
   void shufpd(XmmRegister dst, XmmRegister src, const Immediate& imm);
   void shufps(XmmRegister dst, XmmRegister src, const Immediate& imm);
   void pshufd(XmmRegister dst, XmmRegister src, const Immediate& imm);
@@ -749,6 +751,121 @@ class X86_64Assembler final : public Assembler {
   void psrlq(XmmRegister reg, const Immediate& shift_count);
   void psrldq(XmmRegister reg, const Immediate& shift_count);
 
+  // 256-bit AVX/AVX2 instructions.
+  void vmovdqa(YmmRegister dst, YmmRegister src);
+  void vmovdqa(YmmRegister dst, const Address& src);
+  void vmovdqa(const Address& dst, YmmRegister src);
+  void vmovdqu(YmmRegister dst, YmmRegister src);
+  void vmovdqu(YmmRegister dst, const Address& src);
+  void vmovdqu(const Address& dst, YmmRegister src);
+  void vmovaps(YmmRegister dst, YmmRegister src);
+  void vmovaps(YmmRegister dst, const Address& src);
+  void vmovaps(const Address& dst, YmmRegister src);
+  void vmovups(YmmRegister dst, YmmRegister src);
+  void vmovups(YmmRegister dst, const Address& src);
+  void vmovups(const Address& dst, YmmRegister src);
+  void vmovapd(YmmRegister dst, YmmRegister src);
+  void vmovapd(YmmRegister dst, const Address& src);
+  void vmovapd(const Address& dst, YmmRegister src);
+  void vmovupd(YmmRegister dst, YmmRegister src);
+  void vmovupd(YmmRegister dst, const Address& src);
+  void vmovupd(const Address& dst, YmmRegister src);
+
+  void vpaddb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmullw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmulld(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaddwd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddusb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddusw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubusb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubusw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpavgb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpavgw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminsd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxsd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminub(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxub(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminuw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxuw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminud(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxud(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpeqb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpeqw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpeqd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpeqq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpgtb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpgtw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpgtd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpgtq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmovmskb(CpuRegister dst, YmmRegister src);
+  void vpand(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpandn(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpor(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpxor(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vaddps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vsubps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmulps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vdivps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vminps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmaxps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandnps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vorps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vxorps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vaddpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vsubpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmulpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vdivpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vminpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmaxpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandnpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vxorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+
+  void vpabsb(YmmRegister dst, YmmRegister src);
+  void vpabsw(YmmRegister dst, YmmRegister src);
+  void vpabsd(YmmRegister dst, YmmRegister src);
+  void vcvtdq2ps(YmmRegister dst, YmmRegister src);
+
+  void vpsllw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpslld(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsllq(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsraw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrad(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrlw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrld(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrlq(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+
+  void vpbroadcastb(YmmRegister dst, XmmRegister src);
+  void vpbroadcastw(YmmRegister dst, XmmRegister src);
+  void vpbroadcastd(YmmRegister dst, XmmRegister src);
+  void vpbroadcastq(YmmRegister dst, XmmRegister src);
+  void vbroadcastss(YmmRegister dst, XmmRegister src);
+  void vbroadcastsd(YmmRegister dst, XmmRegister src);
+
+  void vpmovzxbw(YmmRegister dst, const Address& src);
+  void vextracti128(XmmRegister dst, YmmRegister src, const Immediate& imm);
+
+  // Clear the upper halves of all YMM registers, to avoid the AVX-SSE transition penalty
+  // when code using 256-bit registers returns or calls into code using SSE.
+  void vzeroupper();
+
   void flds(const Address& src);
   void fstps(const Address& dst);
   void fsts(const Address& dst);
@@ -1175,6 +1292,17 @@ class X86_64Assembler final : public Assembler {
                                int SET_VEX_L,
                                int SET_VEX_PP);
 
+  // Emit the VEX.256.W0 prefix, `opcode` and ModRM for an instruction with register (0-15) or
+  // memory `rm` operand. `reg` is either a register or an opcode extension, `vvvv` is the
+  // additional source register or kNoVexRegister. The caller must ensure buffer capacity.
+  static constexpr int kNoVexRegister = -1;
+  void EmitVex256(int vex_m, int vex_pp, uint8_t opcode, int reg, int vvvv, int rm);
+  void EmitVex256(int vex_m, int vex_pp, uint8_t opcode, int reg, int vvvv, const Address& rm);
+  void EmitVex256Prefix(int vex_m, int vex_pp, bool R, bool X, bool B, int vvvv);
+  // Emit a register to register move, using either the load or the store opcode.
+  void EmitVex256Move(
+      int vex_pp, uint8_t load_opcode, uint8_t store_opcode, YmmRegister dst, YmmRegister src);
+
   // Helper function to emit a shorter variant of XCHG if at least one operand is RAX/EAX/AX.
   bool try_xchg_rax(CpuRegister dst,
                     CpuRegister src,
@@ -19,6 +19,7 @@
 #include <inttypes.h>
 #include <map>
 #include <random>
+#include <sstream>
 
 #include "base/bit_utils.h"
 #include "base/macros.h"
@@ -343,7 +344,162 @@ class AssemblerX86_64AVXTest : public AssemblerX86_64Test {
   x86_64::X86_64Assembler* CreateAssembler(ArenaAllocator* allocator) override {
     return new (allocator) x86_64::X86_64Assembler(allocator, instruction_set_features_.get());
   }
+
+  // Repeat drivers for the VEX.256 instructions. YMM registers alias the XMM registers, so they
+  // use all the XMM registers provided by the fixture, in every operand position.
+  using Ymm = x86_64::YmmRegister;
+
+  std::string RepeatYY(void (x86_64::X86_64Assembler::*f)(Ymm, Ymm), const std::string& fmt) {
+    std::string str;
+    for (x86_64::XmmRegister* reg1 : GetFPRegisters()) {
+      for (x86_64::XmmRegister* reg2 : GetFPRegisters()) {
+        (GetAssembler()->*f)(Ymm(*reg1), Ymm(*reg2));
+        std::string base = fmt;
+        Replace(REG1_TOKEN, GetYmmName(*reg1), &base);
+        Replace(REG2_TOKEN, GetYmmName(*reg2), &base);
+        str += base;
+        str += "\n";
+      }
+    }
+    return str;
+  }
+
+  std::string RepeatYYY(void (x86_64::X86_64Assembler::*f)(Ymm, Ymm, Ymm),
+                        const std::string& fmt) {
+    std::string str;
+    for (x86_64::XmmRegister* reg1 : GetFPRegisters()) {
+      for (x86_64::XmmRegister* reg2 : GetFPRegisters()) {
+        for (x86_64::XmmRegister* reg3 : GetFPRegisters()) {
+          (GetAssembler()->*f)(Ymm(*reg1), Ymm(*reg2), Ymm(*reg3));
+          std::string base = fmt;
+          Replace(REG1_TOKEN, GetYmmName(*reg1), &base);
+          Replace(REG2_TOKEN, GetYmmName(*reg2), &base);
+          Replace(REG3_TOKEN, GetYmmName(*reg3), &base);
+          str += base;
+          str += "\n";
+        }
+      }
+    }
+    return str;
+  }
+
+  std::string RepeatYYI(void (x86_64::X86_64Assembler::*f)(Ymm, Ymm, const x86_64::Immediate&),
+                        const std::string& fmt) {
+    std::string str;
+    for (x86_64::XmmRegister* reg1 : GetFPRegisters()) {
+      for (x86_64::XmmRegister* reg2 : GetFPRegisters()) {
+        for (int64_t imm : {0, 1, 7, 15, 31, 63}) {
+          (GetAssembler()->*f)(Ymm(*reg1), Ymm(*reg2), x86_64::Immediate(imm));
+          std::string base = fmt;
+          Replace(REG1_TOKEN, GetYmmName(*reg1), &base);
+          Replace(REG2_TOKEN, GetYmmName(*reg2), &base);
+          Replace(IMM_TOKEN, std::to_string(imm), &base);
+          str += base;
+          str += "\n";
+        }
+      }
+    }
+    return str;
+  }
+
+  std::string RepeatYF(void (x86_64::X86_64Assembler::*f)(Ymm, x86_64::XmmRegister),
+                       const std::string& fmt) {
+    std::string str;
+    for (x86_64::XmmRegister* reg1 : GetFPRegisters()) {
+      for (x86_64::XmmRegister* reg2 : GetFPRegisters()) {
+        (GetAssembler()->*f)(Ymm(*reg1), *reg2);
+        std::string base = fmt;
+        Replace(REG1_TOKEN, GetYmmName(*reg1), &base);
+        Replace(REG2_TOKEN, GetFPRegName(*reg2), &base);
+        str += base;
+        str += "\n";
+      }
+    }
+    return str;
+  }
+
+  std::string RepeatFYI(
+      void (x86_64::X86_64Assembler::*f)(x86_64::XmmRegister, Ymm, const x86_64::Immediate&),
+      const std::string& fmt) {
+    std::string str;
+    for (x86_64::XmmRegister* reg1 : GetFPRegisters()) {
+      for (x86_64::XmmRegister* reg2 : GetFPRegisters()) {
+        for (int64_t imm : {0, 1}) {
+          (GetAssembler()->*f)(*reg1, Ymm(*reg2), x86_64::Immediate(imm));
+          std::string base = fmt;
+          Replace(REG1_TOKEN, GetFPRegName(*reg1), &base);
+          Replace(REG2_TOKEN, GetYmmName(*reg2), &base);
+          Replace(IMM_TOKEN, std::to_string(imm), &base);
+          str += base;
+          str += "\n";
+        }
+      }
+    }
+    return str;
+  }
+
+  std::string RepeatrY(void (x86_64::X86_64Assembler::*f)(x86_64::CpuRegister, Ymm),
+                       const std::string& fmt) {
+    std::string str;
+    for (x86_64::CpuRegister* reg1 : GetRegisters()) {
+      for (x86_64::XmmRegister* reg2 : GetFPRegisters()) {
+        (GetAssembler()->*f)(*reg1, Ymm(*reg2));
+        std::string base = fmt;
+        Replace(REG1_TOKEN, GetSecondaryRegisterName(*reg1), &base);
+        Replace(REG2_TOKEN, GetYmmName(*reg2), &base);
+        str += base;
+        str += "\n";
+      }
+    }
+    return str;
+  }
+
+  std::string RepeatYA(void (x86_64::X86_64Assembler::*f)(Ymm, const x86_64::Address&),
+                       const std::string& fmt) {
+    std::string str;
+    for (x86_64::XmmRegister* reg : GetFPRegisters()) {
+      for (const x86_64::Address& addr : GetAddresses()) {
+        (GetAssembler()->*f)(Ymm(*reg), addr);
+        std::string base = fmt;
+        Replace(REG_TOKEN, GetYmmName(*reg), &base);
+        Replace(ADDRESS_TOKEN, GetAddrName(addr), &base);
+        str += base;
+        str += "\n";
+      }
+    }
+    return str;
+  }
+
+  std::string RepeatAY(void (x86_64::X86_64Assembler::*f)(const x86_64::Address&, Ymm),
+                       const std::string& fmt) {
+    std::string str;
+    for (const x86_64::Address& addr : GetAddresses()) {
+      for (x86_64::XmmRegister* reg : GetFPRegisters()) {
+        (GetAssembler()->*f)(addr, Ymm(*reg));
+        std::string base = fmt;
+        Replace(ADDRESS_TOKEN, GetAddrName(addr), &base);
+        Replace(REG_TOKEN, GetYmmName(*reg), &base);
+        str += base;
+        str += "\n";
+      }
+    }
+    return str;
+  }
+
  private:
+  static std::string GetYmmName(const x86_64::XmmRegister& reg) {
+    std::ostringstream sreg;
+    sreg << Ymm(reg);
+    return sreg.str();
+  }
+
+  static void Replace(const char* token, const std::string& replacement, std::string* str) {
+    size_t index;
+    while ((index = str->find(token)) != std::string::npos) {
+      str->replace(index, ConstexprStrLen(token), replacement);
+    }
+  }
+
   std::unique_ptr<const X86_64InstructionSetFeatures> instruction_set_features_;
 };
 
@@ -1879,6 +2035,510 @@ TEST_F(AssemblerX86_64AVXTest, VPmaddwd) {
                       "vpmaddwd %{reg3}, %{reg2}, %{reg1}"), "vpmaddwd");
 }
 
+TEST_F(AssemblerX86_64AVXTest, VMovdqaYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vmovdqa, "vmovdqa %{reg2}, %{reg1}"), "vmovdqa_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdqaLoadYmm) {
+  DriverStr(RepeatYA(&x86_64::X86_64Assembler::vmovdqa, "vmovdqa {mem}, %{reg}"), "vmovdqa_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdqaStoreYmm) {
+  DriverStr(RepeatAY(&x86_64::X86_64Assembler::vmovdqa, "vmovdqa %{reg}, {mem}"), "vmovdqa_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdquYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vmovdqu, "vmovdqu %{reg2}, %{reg1}"), "vmovdqu_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdquLoadYmm) {
+  DriverStr(RepeatYA(&x86_64::X86_64Assembler::vmovdqu, "vmovdqu {mem}, %{reg}"), "vmovdqu_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdquStoreYmm) {
+  DriverStr(RepeatAY(&x86_64::X86_64Assembler::vmovdqu, "vmovdqu %{reg}, {mem}"), "vmovdqu_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovapsYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vmovaps, "vmovaps %{reg2}, %{reg1}"), "vmovaps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovapsLoadYmm) {
+  DriverStr(RepeatYA(&x86_64::X86_64Assembler::vmovaps, "vmovaps {mem}, %{reg}"), "vmovaps_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovapsStoreYmm) {
+  DriverStr(RepeatAY(&x86_64::X86_64Assembler::vmovaps, "vmovaps %{reg}, {mem}"), "vmovaps_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupsYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vmovups, "vmovups %{reg2}, %{reg1}"), "vmovups_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupsLoadYmm) {
+  DriverStr(RepeatYA(&x86_64::X86_64Assembler::vmovups, "vmovups {mem}, %{reg}"), "vmovups_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupsStoreYmm) {
+  DriverStr(RepeatAY(&x86_64::X86_64Assembler::vmovups, "vmovups %{reg}, {mem}"), "vmovups_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovapdYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vmovapd, "vmovapd %{reg2}, %{reg1}"), "vmovapd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovapdLoadYmm) {
+  DriverStr(RepeatYA(&x86_64::X86_64Assembler::vmovapd, "vmovapd {mem}, %{reg}"), "vmovapd_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovapdStoreYmm) {
+  DriverStr(RepeatAY(&x86_64::X86_64Assembler::vmovapd, "vmovapd %{reg}, {mem}"), "vmovapd_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupdYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vmovupd, "vmovupd %{reg2}, %{reg1}"), "vmovupd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupdLoadYmm) {
+  DriverStr(RepeatYA(&x86_64::X86_64Assembler::vmovupd, "vmovupd {mem}, %{reg}"), "vmovupd_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupdStoreYmm) {
+  DriverStr(RepeatAY(&x86_64::X86_64Assembler::vmovupd, "vmovupd %{reg}, {mem}"), "vmovupd_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddb,
+                      "vpaddb %{reg3}, %{reg2}, %{reg1}"), "vpaddb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddw,
+                      "vpaddw %{reg3}, %{reg2}, %{reg1}"), "vpaddw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPadddYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddd,
+                      "vpaddd %{reg3}, %{reg2}, %{reg1}"), "vpaddd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddqYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddq,
+                      "vpaddq %{reg3}, %{reg2}, %{reg1}"), "vpaddq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubb,
+                      "vpsubb %{reg3}, %{reg2}, %{reg1}"), "vpsubb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubw,
+                      "vpsubw %{reg3}, %{reg2}, %{reg1}"), "vpsubw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubd,
+                      "vpsubd %{reg3}, %{reg2}, %{reg1}"), "vpsubd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubqYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubq,
+                      "vpsubq %{reg3}, %{reg2}, %{reg1}"), "vpsubq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmullwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmullw,
+                      "vpmullw %{reg3}, %{reg2}, %{reg1}"), "vpmullw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmulldYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmulld,
+                      "vpmulld %{reg3}, %{reg2}, %{reg1}"), "vpmulld_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaddwdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmaddwd,
+                      "vpmaddwd %{reg3}, %{reg2}, %{reg1}"), "vpmaddwd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddusbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddusb,
+                      "vpaddusb %{reg3}, %{reg2}, %{reg1}"), "vpaddusb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddsbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddsb,
+                      "vpaddsb %{reg3}, %{reg2}, %{reg1}"), "vpaddsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPadduswYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddusw,
+                      "vpaddusw %{reg3}, %{reg2}, %{reg1}"), "vpaddusw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddswYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpaddsw,
+                      "vpaddsw %{reg3}, %{reg2}, %{reg1}"), "vpaddsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubusbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubusb,
+                      "vpsubusb %{reg3}, %{reg2}, %{reg1}"), "vpsubusb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubsbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubsb,
+                      "vpsubsb %{reg3}, %{reg2}, %{reg1}"), "vpsubsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubuswYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubusw,
+                      "vpsubusw %{reg3}, %{reg2}, %{reg1}"), "vpsubusw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubswYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpsubsw,
+                      "vpsubsw %{reg3}, %{reg2}, %{reg1}"), "vpsubsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPavgbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpavgb,
+                      "vpavgb %{reg3}, %{reg2}, %{reg1}"), "vpavgb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPavgwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpavgw,
+                      "vpavgw %{reg3}, %{reg2}, %{reg1}"), "vpavgw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminsbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpminsb,
+                      "vpminsb %{reg3}, %{reg2}, %{reg1}"), "vpminsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxsbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmaxsb,
+                      "vpmaxsb %{reg3}, %{reg2}, %{reg1}"), "vpmaxsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminswYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpminsw,
+                      "vpminsw %{reg3}, %{reg2}, %{reg1}"), "vpminsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxswYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmaxsw,
+                      "vpmaxsw %{reg3}, %{reg2}, %{reg1}"), "vpmaxsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminsdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpminsd,
+                      "vpminsd %{reg3}, %{reg2}, %{reg1}"), "vpminsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxsdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmaxsd,
+                      "vpmaxsd %{reg3}, %{reg2}, %{reg1}"), "vpmaxsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminubYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpminub,
+                      "vpminub %{reg3}, %{reg2}, %{reg1}"), "vpminub_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxubYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmaxub,
+                      "vpmaxub %{reg3}, %{reg2}, %{reg1}"), "vpmaxub_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminuwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpminuw,
+                      "vpminuw %{reg3}, %{reg2}, %{reg1}"), "vpminuw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxuwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmaxuw,
+                      "vpmaxuw %{reg3}, %{reg2}, %{reg1}"), "vpmaxuw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminudYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpminud,
+                      "vpminud %{reg3}, %{reg2}, %{reg1}"), "vpminud_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxudYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpmaxud,
+                      "vpmaxud %{reg3}, %{reg2}, %{reg1}"), "vpmaxud_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpeqbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpeqb,
+                      "vpcmpeqb %{reg3}, %{reg2}, %{reg1}"), "vpcmpeqb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpeqwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpeqw,
+                      "vpcmpeqw %{reg3}, %{reg2}, %{reg1}"), "vpcmpeqw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpeqdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpeqd,
+                      "vpcmpeqd %{reg3}, %{reg2}, %{reg1}"), "vpcmpeqd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpeqqYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpeqq,
+                      "vpcmpeqq %{reg3}, %{reg2}, %{reg1}"), "vpcmpeqq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpgtbYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpgtb,
+                      "vpcmpgtb %{reg3}, %{reg2}, %{reg1}"), "vpcmpgtb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpgtwYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpgtw,
+                      "vpcmpgtw %{reg3}, %{reg2}, %{reg1}"), "vpcmpgtw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpgtdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpgtd,
+                      "vpcmpgtd %{reg3}, %{reg2}, %{reg1}"), "vpcmpgtd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpgtqYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpcmpgtq,
+                      "vpcmpgtq %{reg3}, %{reg2}, %{reg1}"), "vpcmpgtq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmovmskbYmm) {
+  DriverStr(RepeatrY(&x86_64::X86_64Assembler::vpmovmskb,
+                     "vpmovmskb %{reg2}, %{reg1}"), "vpmovmskb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPandYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpand,
+                      "vpand %{reg3}, %{reg2}, %{reg1}"), "vpand_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPandnYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpandn,
+                      "vpandn %{reg3}, %{reg2}, %{reg1}"), "vpandn_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPorYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpor,
+                      "vpor %{reg3}, %{reg2}, %{reg1}"), "vpor_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPxorYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vpxor,
+                      "vpxor %{reg3}, %{reg2}, %{reg1}"), "vpxor_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VAddpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vaddps,
+                      "vaddps %{reg3}, %{reg2}, %{reg1}"), "vaddps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VSubpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vsubps,
+                      "vsubps %{reg3}, %{reg2}, %{reg1}"), "vsubps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMulpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vmulps,
+                      "vmulps %{reg3}, %{reg2}, %{reg1}"), "vmulps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VDivpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vdivps,
+                      "vdivps %{reg3}, %{reg2}, %{reg1}"), "vdivps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMinpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vminps,
+                      "vminps %{reg3}, %{reg2}, %{reg1}"), "vminps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMaxpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vmaxps,
+                      "vmaxps %{reg3}, %{reg2}, %{reg1}"), "vmaxps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VAndpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vandps,
+                      "vandps %{reg3}, %{reg2}, %{reg1}"), "vandps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VAndnpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vandnps,
+                      "vandnps %{reg3}, %{reg2}, %{reg1}"), "vandnps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VOrpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vorps,
+                      "vorps %{reg3}, %{reg2}, %{reg1}"), "vorps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VXorpsYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vxorps,
+                      "vxorps %{reg3}, %{reg2}, %{reg1}"), "vxorps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VAddpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vaddpd,
+                      "vaddpd %{reg3}, %{reg2}, %{reg1}"), "vaddpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VSubpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vsubpd,
+                      "vsubpd %{reg3}, %{reg2}, %{reg1}"), "vsubpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMulpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vmulpd,
+                      "vmulpd %{reg3}, %{reg2}, %{reg1}"), "vmulpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VDivpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vdivpd,
+                      "vdivpd %{reg3}, %{reg2}, %{reg1}"), "vdivpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMinpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vminpd,
+                      "vminpd %{reg3}, %{reg2}, %{reg1}"), "vminpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMaxpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vmaxpd,
+                      "vmaxpd %{reg3}, %{reg2}, %{reg1}"), "vmaxpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VAndpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vandpd,
+                      "vandpd %{reg3}, %{reg2}, %{reg1}"), "vandpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VAndnpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vandnpd,
+                      "vandnpd %{reg3}, %{reg2}, %{reg1}"), "vandnpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VOrpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vorpd,
+                      "vorpd %{reg3}, %{reg2}, %{reg1}"), "vorpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VXorpdYmm) {
+  DriverStr(RepeatYYY(&x86_64::X86_64Assembler::vxorpd,
+                      "vxorpd %{reg3}, %{reg2}, %{reg1}"), "vxorpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPabsbYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vpabsb, "vpabsb %{reg2}, %{reg1}"), "vpabsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPabswYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vpabsw, "vpabsw %{reg2}, %{reg1}"), "vpabsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPabsdYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vpabsd, "vpabsd %{reg2}, %{reg1}"), "vpabsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VCvtdq2psYmm) {
+  DriverStr(RepeatYY(&x86_64::X86_64Assembler::vcvtdq2ps,
+                     "vcvtdq2ps %{reg2}, %{reg1}"), "vcvtdq2ps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsllwYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpsllw,
+                      "vpsllw ${imm}, %{reg2}, %{reg1}"), "vpsllw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPslldYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpslld,
+                      "vpslld ${imm}, %{reg2}, %{reg1}"), "vpslld_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsllqYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpsllq,
+                      "vpsllq ${imm}, %{reg2}, %{reg1}"), "vpsllq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrawYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpsraw,
+                      "vpsraw ${imm}, %{reg2}, %{reg1}"), "vpsraw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsradYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpsrad,
+                      "vpsrad ${imm}, %{reg2}, %{reg1}"), "vpsrad_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrlwYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpsrlw,
+                      "vpsrlw ${imm}, %{reg2}, %{reg1}"), "vpsrlw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrldYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpsrld,
+                      "vpsrld ${imm}, %{reg2}, %{reg1}"), "vpsrld_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrlqYmm) {
+  DriverStr(RepeatYYI(&x86_64::X86_64Assembler::vpsrlq,
+                      "vpsrlq ${imm}, %{reg2}, %{reg1}"), "vpsrlq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastbYmm) {
+  DriverStr(RepeatYF(&x86_64::X86_64Assembler::vpbroadcastb,
+                     "vpbroadcastb %{reg2}, %{reg1}"), "vpbroadcastb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastwYmm) {
+  DriverStr(RepeatYF(&x86_64::X86_64Assembler::vpbroadcastw,
+                     "vpbroadcastw %{reg2}, %{reg1}"), "vpbroadcastw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastdYmm) {
+  DriverStr(RepeatYF(&x86_64::X86_64Assembler::vpbroadcastd,
+                     "vpbroadcastd %{reg2}, %{reg1}"), "vpbroadcastd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastqYmm) {
+  DriverStr(RepeatYF(&x86_64::X86_64Assembler::vpbroadcastq,
+                     "vpbroadcastq %{reg2}, %{reg1}"), "vpbroadcastq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VBroadcastssYmm) {
+  DriverStr(RepeatYF(&x86_64::X86_64Assembler::vbroadcastss,
+                     "vbroadcastss %{reg2}, %{reg1}"), "vbroadcastss_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VBroadcastsdYmm) {
+  DriverStr(RepeatYF(&x86_64::X86_64Assembler::vbroadcastsd,
+                     "vbroadcastsd %{reg2}, %{reg1}"), "vbroadcastsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmovzxbwLoadYmm) {
+  DriverStr(RepeatYA(&x86_64::X86_64Assembler::vpmovzxbw,
+                     "vpmovzxbw {mem}, %{reg}"), "vpmovzxbw_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VExtracti128Ymm) {
+  DriverStr(RepeatFYI(&x86_64::X86_64Assembler::vextracti128,
+                      "vextracti128 ${imm}, %{reg2}, %{reg1}"), "vextracti128_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VZeroupper) {
+  GetAssembler()->vzeroupper();
+  DriverStr("vzeroupper\n", "vzeroupper");
+}
+
 TEST_F(AssemblerX86_64AVXTest, VFmadd213ss) {
   DriverStr(RepeatFFF(&x86_64::X86_64Assembler::vfmadd213ss,
                       "vfmadd213ss %{reg3}, %{reg2}, %{reg1}"), "vfmadd213ss");
@@ -2017,6 +2677,10 @@ TEST_F(AssemblerX86_64Test, PCmpgtq) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pcmpgtq, "pcmpgtq %{reg2}, %{reg1}"), "pcmpgtq");
 }
 
+TEST_F(AssemblerX86_64Test, Pmovmskb) {
+  DriverStr(RepeatrF(&x86_64::X86_64Assembler::pmovmskb, "pmovmskb %{reg2}, %{reg1}"), "pmovmskb");
+}
+
 TEST_F(AssemblerX86_64Test, Shufps) {
   DriverStr(RepeatFFI(&x86_64::X86_64Assembler::shufps, /*imm_bytes*/ 1U,
                       "shufps ${imm}, %{reg2}, %{reg1}"), "shufps");
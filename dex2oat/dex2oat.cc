@@ -523,6 +523,7 @@ class Dex2Oat final {
         input_vdex_fd_(-1),
         output_vdex_fd_(-1),
         input_vdex_file_(nullptr),
+        allow_partial_input_vdex_(false),
         dm_fd_(-1),
         zip_fd_(-1),
         image_fd_(-1),
@@ -1087,6 +1088,7 @@ class Dex2Oat final {
     AssignIfExists(args, M::InputVdexFd, &input_vdex_fd_);
     AssignIfExists(args, M::OutputVdexFd, &output_vdex_fd_);
     AssignIfExists(args, M::InputVdex, &input_vdex_);
+    AssignTrueIfExists(args, M::AllowPartialInputVdex, &allow_partial_input_vdex_);
     AssignIfExists(args, M::OutputVdex, &output_vdex_);
     AssignIfExists(args, M::DmFd, &dm_fd_);
     AssignIfExists(args, M::DmFile, &dm_file_location_);
@@ -1509,9 +1511,10 @@ class Dex2Oat final {
         std::vector<MemMap> opened_dex_files_map;
         std::vector<std::unique_ptr<const DexFile>> opened_dex_files;
         // No need to verify the dex file when we have a vdex file, which means it was already
-        // verified.
+        // verified, unless some of the dex files may have changed since.
         const bool verify =
-            (input_vdex_file_ == nullptr) && !compiler_options_->AssumeDexFilesAreVerified();
+            (input_vdex_file_ == nullptr || allow_partial_input_vdex_) &&
+            !compiler_options_->AssumeDexFilesAreVerified();
         if (!oat_writers_[i]->WriteAndOpenDexFiles(
             vdex_files_[i].get(),
             verify,
@@ -1764,7 +1767,11 @@ class Dex2Oat final {
     if (!DoProfileGuidedOptimizations() && input_vdex_file_ != nullptr) {
       std::unique_ptr<verifier::VerifierDeps> verifier_deps(
           new verifier::VerifierDeps(dex_files, /*output_only=*/ false));
-      if (!verifier_deps->ParseStoredData(dex_files, input_vdex_file_->GetVerifierDepsData())) {
+      if (!verifier_deps->ParseStoredData(dex_files,
+                                          input_vdex_file_->GetVerifierDepsData(),
+                                          allow_partial_input_vdex_
+                                              ? &input_vdex_reusable_dex_files_
+                                              : nullptr)) {
         return dex2oat::ReturnCode::kOther;
       }
       // We can do fast verification.
@@ -1783,6 +1790,8 @@ class Dex2Oat final {
   // contain a dex section (e.g. when they come from .dm files).
   // If the input vdex does contain dex files, the dex files will be opened from there
   // and so this check is redundant.
+  // With --allow-partial-input-vdex, mismatching dex files are only recorded in
+  // `input_vdex_reusable_dex_files_`, and will be verified again.
   bool ValidateInputVdexChecksums() {
     if (input_vdex_file_ == nullptr) {
       // Nothing to validate
@@ -1790,17 +1799,30 @@ class Dex2Oat final {
     }
     if (input_vdex_file_->GetNumberOfDexFiles()
           != compiler_options_->dex_files_for_oat_file_.size()) {
+      if (allow_partial_input_vdex_ && !use_existing_vdex_) {
+        LOG(WARNING) << "Ignoring input vdex with a different number of dex files than the source."
+            << " vdex_num=" << input_vdex_file_->GetNumberOfDexFiles()
+            << " dex_source_num=" << compiler_options_->dex_files_for_oat_file_.size();
+        input_vdex_file_.reset();
+        return true;
+      }
       LOG(ERROR) << "Vdex file contains a different number of dex files than the source. "
           << " vdex_num=" << input_vdex_file_->GetNumberOfDexFiles()
           << " dex_source_num=" << compiler_options_->dex_files_for_oat_file_.size();
       return false;
     }
 
+    size_t num_reusable = 0u;
+    input_vdex_reusable_dex_files_.assign(compiler_options_->dex_files_for_oat_file_.size(), false);
     for (size_t i = 0; i < compiler_options_->dex_files_for_oat_file_.size(); i++) {
       uint32_t dex_source_checksum =
           compiler_options_->dex_files_for_oat_file_[i]->GetLocationChecksum();
       uint32_t vdex_checksum = input_vdex_file_->GetLocationChecksum(i);
       if (dex_source_checksum != vdex_checksum) {
+        if (allow_partial_input_vdex_ && !use_existing_vdex_) {
+          VLOG(compiler) << "Not reusing the input vdex for changed dex file at position " << i;
+          continue;
+        }
         LOG(ERROR) << "Vdex file checksum different than source dex checksum for position " << i
           << std::hex
           << " vdex_checksum=0x" << vdex_checksum
@@ -1808,6 +1830,12 @@ class Dex2Oat final {
           << std::dec;
         return false;
       }
+      input_vdex_reusable_dex_files_[i] = true;
+      ++num_reusable;
+    }
+    if (allow_partial_input_vdex_) {
+      LOG(INFO) << "Reusing verification results of " << num_reusable << " out of "
+                << input_vdex_reusable_dex_files_.size() << " dex files from the input vdex";
     }
     return true;
   }
@@ -2624,6 +2652,11 @@ class Dex2Oat final {
   bool AddDexFileSources() {
     TimingLogger::ScopedTiming t2("AddDexFileSources", timings_);
     if (input_vdex_file_ != nullptr && input_vdex_file_->HasDexSection()) {
+      if (allow_partial_input_vdex_) {
+        // The dex files in the vdex may be stale, we want to compile the given ones.
+        LOG(ERROR) << "--allow-partial-input-vdex requires an input vdex without dex files";
+        return false;
+      }
       DCHECK_EQ(oat_writers_.size(), 1u);
       const std::string& name = zip_location_.empty() ? dex_locations_[0] : zip_location_;
       DCHECK(!name.empty());
@@ -2966,6 +2999,11 @@ class Dex2Oat final {
   std::string input_vdex_;
   std::string output_vdex_;
   std::unique_ptr<VdexFile> input_vdex_file_;
+  // Whether dex files which do not match the input vdex can be verified, instead of
+  // failing the compilation.
+  bool allow_partial_input_vdex_;
+  // For each dex file, whether its verification results from the input vdex can be reused.
+  std::vector<bool> input_vdex_reusable_dex_files_;
   int dm_fd_;
   std::string dm_file_location_;
   std::unique_ptr<ZipArchive> dm_file_;
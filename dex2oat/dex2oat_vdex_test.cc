@@ -17,6 +17,7 @@
 #include <string>
 #include <vector>
 
+#include "base/stl_util.h"
 #include "common_runtime_test.h"
 #include "dex2oat_environment_test.h"
 #include "vdex_file.h"
@@ -273,4 +274,52 @@ TEST_F(Dex2oatVdexTest, VerifyInputDmWithMismatchedChecksums) {
       << output_;
 }
 
+// Check that --allow-partial-input-vdex reuses the verification results of the unchanged
+// dex files, and verifies the other ones again.
+TEST_F(Dex2oatVdexTest, VerifyPartialInputVdex) {
+  std::vector<std::unique_ptr<const DexFile>> dex_files = OpenTestDexFiles("MultiDex");
+  ASSERT_EQ(2u, dex_files.size());
+  ASSERT_TRUE(RunDex2oat(dex_files[0]->GetLocation(),
+                         GetOdex(dex_files[0]),
+                         /*public_sdk=*/nullptr,
+                         /*copy_dex_files=*/false))
+      << output_;
+
+  // The primary dex file is the same, but the secondary one changed.
+  std::vector<std::unique_ptr<const DexFile>> modified_dex_files =
+      OpenTestDexFiles("MultiDexModifiedSecondary");
+  ASSERT_EQ(2u, modified_dex_files.size());
+  ASSERT_EQ(dex_files[0]->GetLocationChecksum(), modified_dex_files[0]->GetLocationChecksum());
+  ASSERT_NE(dex_files[1]->GetLocationChecksum(), modified_dex_files[1]->GetLocationChecksum());
+
+  std::vector<std::string> extra_args;
+  extra_args.push_back("--input-vdex=" + GetVdex(dex_files[0]));
+  ASSERT_FALSE(RunDex2oat(modified_dex_files[0]->GetLocation(),
+                          GetOdex(modified_dex_files[0], "v2"),
+                          /*public_sdk=*/nullptr,
+                          /*copy_dex_files=*/false,
+                          extra_args))
+      << output_;
+
+  extra_args.push_back("--allow-partial-input-vdex");
+  ASSERT_TRUE(RunDex2oat(modified_dex_files[0]->GetLocation(),
+                         GetOdex(modified_dex_files[0], "v2"),
+                         /*public_sdk=*/nullptr,
+                         /*copy_dex_files=*/false,
+                         extra_args))
+      << output_;
+
+  // Both the reused and the verified again dex files have their classes verified.
+  std::unique_ptr<VdexFile> vdex(VdexFile::Open(GetVdex(modified_dex_files[0], "v2"),
+                                                /*writable=*/false,
+                                                /*low_4gb=*/false,
+                                                &error_msg_));
+  ASSERT_TRUE(vdex != nullptr) << error_msg_;
+  std::vector<const DexFile*> modified = MakeNonOwningPointerVector(modified_dex_files);
+  std::unique_ptr<VerifierDeps> deps(new VerifierDeps(modified, /*output_only=*/false));
+  ASSERT_TRUE(deps->ParseStoredData(modified, vdex->GetVerifierDepsData()));
+  ASSERT_TRUE(HasVerifiedClass(deps, "LMain;", *modified_dex_files[0]));
+  ASSERT_TRUE(HasVerifiedClass(deps, "LSecond;", *modified_dex_files[1]));
+}
+
 }  // namespace art
@@ -1722,15 +1722,33 @@ static void LoadAndUpdateStatus(const ClassAccessor& accessor,
 
 bool CompilerDriver::FastVerify(jobject jclass_loader,
                                 const std::vector<const DexFile*>& dex_files,
-                                TimingLogger* timings) {
+                                TimingLogger* timings,
+                                /*out*/ std::vector<const DexFile*>* dex_files_to_verify) {
+  DCHECK(dex_files_to_verify->empty());
   CompilerCallbacks* callbacks = Runtime::Current()->GetCompilerCallbacks();
   verifier::VerifierDeps* verifier_deps = callbacks->GetVerifierDeps();
   // If there exist VerifierDeps that aren't the ones we just created to output, use them to verify.
   if (verifier_deps == nullptr || verifier_deps->OutputOnly()) {
+    *dex_files_to_verify = dex_files;
     return false;
   }
   TimingLogger::ScopedTiming t("Fast Verify", timings);
 
+  // With a partially reused input vdex, only the dex files which did not change have
+  // stored dependencies. The other ones need to be verified again.
+  std::vector<const DexFile*> dex_files_to_validate;
+  for (const DexFile* dex_file : dex_files) {
+    if (verifier_deps->HasStoredData(*dex_file)) {
+      dex_files_to_validate.push_back(dex_file);
+    } else {
+      dex_files_to_verify->push_back(dex_file);
+    }
+  }
+  if (!dex_files_to_verify->empty()) {
+    VLOG(compiler) << "Reusing VerifierDeps of " << dex_files_to_validate.size() << " out of "
+                   << dex_files.size() << " dex files";
+  }
+
   ScopedObjectAccess soa(Thread::Current());
   StackHandleScope<2> hs(soa.Self());
   Handle<mirror::ClassLoader> class_loader(
@@ -1740,12 +1758,13 @@ bool CompilerDriver::FastVerify(jobject jclass_loader,
   if (!verifier_deps->ValidateDependencies(
       soa.Self(),
       class_loader,
-      dex_files,
+      dex_files_to_validate,
       &error_msg)) {
     // Clear the information we have as we are going to re-verify and we do not
     // want to keep that a class is verified.
     verifier_deps->ClearData(dex_files);
     LOG(WARNING) << "Fast verification failed: " << error_msg;
+    *dex_files_to_verify = dex_files;
     return false;
   }
 
@@ -1758,7 +1777,7 @@ bool CompilerDriver::FastVerify(jobject jclass_loader,
   // could not be fully verified; we could try again, but that would hurt verification
   // time. So instead we assume these classes still need to be verified at
   // runtime.
-  for (const DexFile* dex_file : dex_files) {
+  for (const DexFile* dex_file : dex_files_to_validate) {
     // Fetch the list of verified classes.
     const std::vector<bool>& verified_classes = verifier_deps->GetVerifiedClasses(*dex_file);
     DCHECK_EQ(verified_classes.size(), dex_file->NumClassDefs());
@@ -1794,13 +1813,14 @@ bool CompilerDriver::FastVerify(jobject jclass_loader,
       }
     }
   }
-  return true;
+  return dex_files_to_verify->empty();
 }
 
 void CompilerDriver::Verify(jobject jclass_loader,
                             const std::vector<const DexFile*>& dex_files,
                             TimingLogger* timings) {
-  if (FastVerify(jclass_loader, dex_files, timings)) {
+  std::vector<const DexFile*> dex_files_to_verify;
+  if (FastVerify(jclass_loader, dex_files, timings, &dex_files_to_verify)) {
     return;
   }
 
@@ -1828,7 +1848,7 @@ void CompilerDriver::Verify(jobject jclass_loader,
   ThreadPool* verify_thread_pool =
       force_determinism ? single_thread_pool_.get() : parallel_thread_pool_.get();
   size_t verify_thread_count = force_determinism ? 1U : parallel_thread_count_;
-  for (const DexFile* dex_file : dex_files) {
+  for (const DexFile* dex_file : dex_files_to_verify) {
     CHECK(dex_file != nullptr);
     VerifyDexFile(jclass_loader,
                   *dex_file,
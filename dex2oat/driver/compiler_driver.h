@@ -246,10 +246,13 @@ class CompilerDriver {
       REQUIRES(!Locks::mutator_lock_);
 
   // Do fast verification through VerifierDeps if possible. Return whether
-  // verification was successful.
+  // verification was successful. Dex files without stored VerifierDeps data
+  // (from a partially reused input vdex) are not fast verified and are put in
+  // `dex_files_to_verify` instead; on failure, this contains all `dex_files`.
   bool FastVerify(jobject class_loader,
                   const std::vector<const DexFile*>& dex_files,
-                  TimingLogger* timings);
+                  TimingLogger* timings,
+                  /*out*/ std::vector<const DexFile*>* dex_files_to_verify);
 
   void Verify(jobject class_loader,
               const std::vector<const DexFile*>& dex_files,
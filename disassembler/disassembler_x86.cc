@@ -280,12 +280,274 @@ static constexpr uint8_t kNops[][10] = {
   return 0;
 }
 
+// Operand forms of the VEX encoded instructions, named after the operand order in the Intel
+// manual: R is ModRM.reg, M is ModRM.rm, V is VEX.vvvv and I is an 8-bit immediate.
+enum class VexForm {
+  kRVM,  // Vector dst, vector src1, vector or memory src2.
+  kRM,   // Vector dst, vector or memory src.
+  kMR,   // Vector or memory dst, vector src.
+  kVMI,  // Vector dst, vector src, immediate; ModRM.reg selects the operation.
+  kMRI,  // 128-bit vector or memory dst, vector src, immediate.
+  kRMX,  // Vector dst, 128-bit vector or memory src.
+  kGM,   // General purpose register dst, vector src.
+  kGVM,  // General purpose register dst, src1, src2 or memory.
+  kVMG,  // General purpose register dst, src or memory; ModRM.reg selects the operation.
+  kNone,
+};
+
+struct VexOpcode {
+  uint8_t map;
+  uint8_t pp;
+  uint8_t opcode;
+  VexForm form;
+  const char* name;  // For kVMI and kVMG, indexed by ModRM.reg in `names`.
+  const char* const* names;
+};
+
+static const char* const gVex71Names[] = {
+  nullptr, nullptr, "vpsrlw", nullptr, "vpsraw", nullptr, "vpsllw", nullptr
+};
+static const char* const gVex72Names[] = {
+  nullptr, nullptr, "vpsrld", nullptr, "vpsrad", nullptr, "vpslld", nullptr
+};
+static const char* const gVex73Names[] = {
+  nullptr, nullptr, "vpsrlq", "vpsrldq", nullptr, nullptr, "vpsllq", "vpslldq"
+};
+static const char* const gVexF3Names[] = {
+  nullptr, "blsr", "blsmsk", "blsi", nullptr, nullptr, nullptr, nullptr
+};
+
+// The VEX encoded instructions emitted by the code generators, as 128-bit or 256-bit vectors.
+static const VexOpcode gVexOpcodes[] = {
+  { VEX_M_0F, VEX_PP_66, 0x6F, VexForm::kRM, "vmovdqa", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x7F, VexForm::kMR, "vmovdqa", nullptr },
+  { VEX_M_0F, VEX_PP_F3, 0x6F, VexForm::kRM, "vmovdqu", nullptr },
+  { VEX_M_0F, VEX_PP_F3, 0x7F, VexForm::kMR, "vmovdqu", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x28, VexForm::kRM, "vmovaps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x29, VexForm::kMR, "vmovaps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x10, VexForm::kRM, "vmovups", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x11, VexForm::kMR, "vmovups", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x28, VexForm::kRM, "vmovapd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x29, VexForm::kMR, "vmovapd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x10, VexForm::kRM, "vmovupd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x11, VexForm::kMR, "vmovupd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xFC, VexForm::kRVM, "vpaddb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xFD, VexForm::kRVM, "vpaddw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xFE, VexForm::kRVM, "vpaddd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xD4, VexForm::kRVM, "vpaddq", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xF8, VexForm::kRVM, "vpsubb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xF9, VexForm::kRVM, "vpsubw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xFA, VexForm::kRVM, "vpsubd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xFB, VexForm::kRVM, "vpsubq", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xD5, VexForm::kRVM, "vpmullw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xF5, VexForm::kRVM, "vpmaddwd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xDC, VexForm::kRVM, "vpaddusb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xEC, VexForm::kRVM, "vpaddsb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xDD, VexForm::kRVM, "vpaddusw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xED, VexForm::kRVM, "vpaddsw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xD8, VexForm::kRVM, "vpsubusb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xE8, VexForm::kRVM, "vpsubsb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xD9, VexForm::kRVM, "vpsubusw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xE9, VexForm::kRVM, "vpsubsw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xE0, VexForm::kRVM, "vpavgb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xE3, VexForm::kRVM, "vpavgw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xEA, VexForm::kRVM, "vpminsw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xEE, VexForm::kRVM, "vpmaxsw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xDA, VexForm::kRVM, "vpminub", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xDE, VexForm::kRVM, "vpmaxub", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x74, VexForm::kRVM, "vpcmpeqb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x75, VexForm::kRVM, "vpcmpeqw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x76, VexForm::kRVM, "vpcmpeqd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x64, VexForm::kRVM, "vpcmpgtb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x65, VexForm::kRVM, "vpcmpgtw", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x66, VexForm::kRVM, "vpcmpgtd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xD7, VexForm::kGM, "vpmovmskb", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xDB, VexForm::kRVM, "vpand", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xDF, VexForm::kRVM, "vpandn", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xEB, VexForm::kRVM, "vpor", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0xEF, VexForm::kRVM, "vpxor", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x71, VexForm::kVMI, nullptr, gVex71Names },
+  { VEX_M_0F, VEX_PP_66, 0x72, VexForm::kVMI, nullptr, gVex72Names },
+  { VEX_M_0F, VEX_PP_66, 0x73, VexForm::kVMI, nullptr, gVex73Names },
+  { VEX_M_0F, VEX_PP_NONE, 0x58, VexForm::kRVM, "vaddps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x5C, VexForm::kRVM, "vsubps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x59, VexForm::kRVM, "vmulps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x5E, VexForm::kRVM, "vdivps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x5D, VexForm::kRVM, "vminps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x5F, VexForm::kRVM, "vmaxps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x54, VexForm::kRVM, "vandps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x55, VexForm::kRVM, "vandnps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x56, VexForm::kRVM, "vorps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x57, VexForm::kRVM, "vxorps", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x58, VexForm::kRVM, "vaddpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x5C, VexForm::kRVM, "vsubpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x59, VexForm::kRVM, "vmulpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x5E, VexForm::kRVM, "vdivpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x5D, VexForm::kRVM, "vminpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x5F, VexForm::kRVM, "vmaxpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x54, VexForm::kRVM, "vandpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x55, VexForm::kRVM, "vandnpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x56, VexForm::kRVM, "vorpd", nullptr },
+  { VEX_M_0F, VEX_PP_66, 0x57, VexForm::kRVM, "vxorpd", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x5B, VexForm::kRM, "vcvtdq2ps", nullptr },
+  { VEX_M_0F, VEX_PP_NONE, 0x77, VexForm::kNone, "vzeroupper", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x40, VexForm::kRVM, "vpmulld", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x38, VexForm::kRVM, "vpminsb", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x3C, VexForm::kRVM, "vpmaxsb", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x39, VexForm::kRVM, "vpminsd", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x3D, VexForm::kRVM, "vpmaxsd", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x3A, VexForm::kRVM, "vpminuw", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x3E, VexForm::kRVM, "vpmaxuw", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x3B, VexForm::kRVM, "vpminud", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x3F, VexForm::kRVM, "vpmaxud", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x29, VexForm::kRVM, "vpcmpeqq", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x37, VexForm::kRVM, "vpcmpgtq", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x1C, VexForm::kRM, "vpabsb", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x1D, VexForm::kRM, "vpabsw", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x1E, VexForm::kRM, "vpabsd", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x78, VexForm::kRMX, "vpbroadcastb", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x79, VexForm::kRMX, "vpbroadcastw", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x58, VexForm::kRMX, "vpbroadcastd", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x59, VexForm::kRMX, "vpbroadcastq", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x18, VexForm::kRMX, "vbroadcastss", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x19, VexForm::kRMX, "vbroadcastsd", nullptr },
+  { VEX_M_0F_38, VEX_PP_66, 0x30, VexForm::kRMX, "vpmovzxbw", nullptr },
+  { VEX_M_0F_38, VEX_PP_NONE, 0xF2, VexForm::kGVM, "andn", nullptr },
+  { VEX_M_0F_38, VEX_PP_NONE, 0xF3, VexForm::kVMG, nullptr, gVexF3Names },
+  { VEX_M_0F_3A, VEX_PP_66, 0x39, VexForm::kMRI, "vextracti128", nullptr },
+};
+
+size_t DisassemblerX86::DumpVexInstruction(std::ostream& os, const uint8_t* instr) {
+  const uint8_t* begin_instr = instr;
+  bool rex_r;
+  bool rex_x = false;
+  bool rex_b = false;
+  bool vex_w = false;
+  uint8_t map = VEX_M_0F;
+  uint8_t vex_byte;
+  if (*instr == TWO_BYTE_VEX) {
+    vex_byte = instr[1];
+    instr += 2;
+    rex_r = (vex_byte & 0x80) == 0;
+  } else {
+    DCHECK_EQ(*instr, THREE_BYTE_VEX);
+    rex_r = (instr[1] & 0x80) == 0;
+    rex_x = (instr[1] & 0x40) == 0;
+    rex_b = (instr[1] & 0x20) == 0;
+    map = instr[1] & 0x1F;
+    vex_byte = instr[2];
+    vex_w = (vex_byte & 0x80) != 0;
+    instr += 3;
+  }
+  uint8_t vvvv = (~vex_byte >> 3) & 0xF;
+  bool vex_l = (vex_byte & 0x04) != 0;
+  uint8_t pp = vex_byte & 0x3;
+  uint8_t opcode = *instr;
+  instr++;
+
+  const VexOpcode* entry = nullptr;
+  for (const VexOpcode& candidate : gVexOpcodes) {
+    if (candidate.map == map && candidate.pp == pp && candidate.opcode == opcode) {
+      entry = &candidate;
+      break;
+    }
+  }
+
+  std::string opcode_tmp;
+  const char* name;
+  std::ostringstream args;
+  if (entry == nullptr) {
+    opcode_tmp = StringPrintf("unknown vex opcode '%02X'", opcode);
+    name = opcode_tmp.c_str();
+  } else if (entry->form == VexForm::kNone) {
+    name = vex_l ? "vzeroall" : entry->name;
+  } else {
+    uint8_t modrm = *instr;
+    instr++;
+    uint8_t mod = modrm >> 6;
+    uint8_t reg = ((modrm >> 3) & 7) + (rex_r ? 8 : 0);
+    uint8_t rm = modrm & 7;
+    name = (entry->names != nullptr) ? entry->names[(modrm >> 3) & 7] : entry->name;
+    if (name == nullptr) {
+      opcode_tmp = StringPrintf("unknown vex opcode '%02X' /%d", opcode, (modrm >> 3) & 7);
+      name = opcode_tmp.c_str();
+    }
+    // Vector registers are YMM with VEX.L set, except for the operands that are always 128-bit.
+    const char* vector = vex_l ? "ymm" : "xmm";
+    bool gpr = entry->form == VexForm::kGVM || entry->form == VexForm::kVMG;
+    const char* const* gpr_names = (vex_w && supports_rex_) ? gReg64Names : gReg32Names;
+    std::string address;
+    if (mod == 3) {
+      size_t rm_reg = rm + (rex_b ? 8 : 0);
+      if (gpr) {
+        address = gpr_names[rm_reg];
+      } else {
+        bool xmm = entry->form == VexForm::kRMX || entry->form == VexForm::kMRI;
+        address = StringPrintf("%s%zu", xmm ? "xmm" : vector, rm_reg);
+      }
+    } else {
+      uint8_t prefix[4] = {0, 0, 0, 0};
+      uint8_t rex64 = supports_rex_ ? (0x40 | (rex_x ? REX_X : 0) | (rex_b ? REX_B : 0)) : 0;
+      uint32_t address_bits = 0;
+      address = DumpAddress(mod, rm, rex64, rex64, /*no_ops=*/ false, /*byte_operand=*/ false,
+                            /*byte_second_operand=*/ false, prefix, /*load=*/ true,
+                            SSE, SSE, &instr, &address_bits);
+    }
+    switch (entry->form) {
+      case VexForm::kRVM:
+        args << vector << static_cast<int>(reg) << ", " << vector << static_cast<int>(vvvv)
+             << ", " << address;
+        break;
+      case VexForm::kRM:
+      case VexForm::kRMX:
+        args << vector << static_cast<int>(reg) << ", " << address;
+        break;
+      case VexForm::kMR:
+        args << address << ", " << vector << static_cast<int>(reg);
+        break;
+      case VexForm::kVMI:
+        args << vector << static_cast<int>(vvvv) << ", " << address << ", "
+             << static_cast<int>(*instr);
+        instr++;
+        break;
+      case VexForm::kMRI:
+        args << address << ", " << vector << static_cast<int>(reg) << ", "
+             << static_cast<int>(*instr);
+        instr++;
+        break;
+      case VexForm::kGM:
+        args << gReg32Names[reg] << ", " << address;
+        break;
+      case VexForm::kGVM:
+        args << gpr_names[reg] << ", " << gpr_names[vvvv] << ", " << address;
+        break;
+      case VexForm::kVMG:
+        args << gpr_names[vvvv] << ", " << address;
+        break;
+      case VexForm::kNone:
+        LOG(FATAL) << "Unreachable";
+        UNREACHABLE();
+    }
+  }
+  os << FormatInstructionPointer(begin_instr)
+     << StringPrintf(": %22s    \t%-7s%s ", DumpCodeHex(begin_instr, instr).c_str(), "", name)
+     << args.str() << '\n';
+  return instr - begin_instr;
+}
+
 size_t DisassemblerX86::DumpInstruction(std::ostream& os, const uint8_t* instr) {
   size_t nop_size = DumpNops(os, instr);
   if (nop_size != 0u) {
     return nop_size;
   }
 
+  // In 32-bit mode, C4 and C5 are only VEX prefixes when the following byte has ModRM.mod 11b,
+  // otherwise they are LES and LDS.
+  if ((*instr == TWO_BYTE_VEX || *instr == THREE_BYTE_VEX) &&
+      (supports_rex_ || (instr[1] & 0xC0) == 0xC0)) {
+    return DumpVexInstruction(os, instr);
+  }
+
   const uint8_t* begin_instr = instr;
   bool have_prefixes = true;
   uint8_t prefix[4] = {0, 0, 0, 0};
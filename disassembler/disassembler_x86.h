@@ -35,6 +35,7 @@ class DisassemblerX86 final : public Disassembler {
  private:
   size_t DumpNops(std::ostream& os, const uint8_t* instr);
   size_t DumpInstruction(std::ostream& os, const uint8_t* instr);
+  size_t DumpVexInstruction(std::ostream& os, const uint8_t* instr);
 
   std::string DumpAddress(uint8_t mod, uint8_t rm, uint8_t rex64, uint8_t rex_w, bool no_ops,
                           bool byte_operand, bool byte_second_operand, uint8_t* prefix, bool load,
@@ -67,7 +67,15 @@
   METRIC(YoungGcDuration, MetricsCounter)                           \
   METRIC(FullGcScannedBytes, MetricsCounter)                        \
   METRIC(FullGcFreedBytes, MetricsCounter)                          \
-  METRIC(FullGcDuration, MetricsCounter)
+  METRIC(FullGcDuration, MetricsCounter)                            \
+  METRIC(TimeToSuspendAll, MetricsHistogram, 15, 0, 15'000)         \
+  METRIC(TimeToSuspendThreadFlip, MetricsHistogram, 15, 0, 15'000)  \
+  METRIC(TimeToSuspendThread, MetricsHistogram, 15, 0, 15'000)      \
+  METRIC(TimeToRunCheckpoint, MetricsHistogram, 15, 0, 15'000)      \
+  METRIC(SlowSuspendAllCount, MetricsCounter)                       \
+  METRIC(SlowSuspendAllTime, MetricsCounter)                        \
+  METRIC(MonitorContentionCount, MetricsCounter)                    \
+  METRIC(MonitorContentionTime, MetricsHistogram, 15, 0, 100'000)
 
 // Increasing counter metrics, reported as Value Metrics in delta increments.
 #define ART_VALUE_METRICS(METRIC)                              \
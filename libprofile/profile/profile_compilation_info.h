@@ -49,7 +49,8 @@ struct ProfileMethodInfo {
     ProfileInlineCache(uint32_t pc,
                        bool missing_types,
                        const std::vector<TypeReference>& profile_classes,
-                       // Only used by profman for creating profiles from text
+                       // Used by profman for creating profiles from text, and by the JIT
+                       // for inline caches that had entries replaced
                        bool megamorphic = false)
         : dex_pc(pc),
           is_missing_types(missing_types),
@@ -18,6 +18,7 @@
 
 #include <sys/system_properties.h>
 
+#include <algorithm>
 #include <functional>
 #include <initializer_list>
 #include <regex>
@@ -38,6 +39,13 @@ namespace {
 using ::android::base::Result;
 
 using ::fmt::literals::operator""_format;  // NOLINT
+
+// Upper bound on the dex2oat invocations running at the same time. There are rarely more
+// independent compilations than this.
+constexpr size_t kMaxConcurrentCompilations = 4;
+
+// Conservative estimate of the memory used by a dex2oat invocation compiling a boot image.
+constexpr uint64_t kEstimatedDex2oatMemoryBytes = 1024ull * 1024 * 1024;
 }
 
 std::string QuotePath(std::string_view path) { return "'{}'"_format(path); }
@@ -75,6 +83,18 @@ bool ShouldDisableRefresh(const std::string& sdk_version_str) {
   return sdk_version >= 32;
 }
 
+size_t ComputeMaxConcurrentCompilations(size_t num_cpus,
+                                        size_t threads_per_invocation,
+                                        uint64_t available_memory_bytes) {
+  if (threads_per_invocation == 0 || threads_per_invocation > num_cpus) {
+    threads_per_invocation = num_cpus;
+  }
+  size_t cpu_budget = threads_per_invocation == 0 ? 1 : num_cpus / threads_per_invocation;
+  uint64_t memory_budget = available_memory_bytes / kEstimatedDex2oatMemoryBytes;
+  return static_cast<size_t>(std::clamp<uint64_t>(
+      std::min<uint64_t>(cpu_budget, memory_budget), 1, kMaxConcurrentCompilations));
+}
+
 void SystemPropertyForeach(std::function<void(const char* name, const char* value)> action) {
   __system_property_foreach(
       [](const prop_info* pi, void* cookie) {
@@ -17,6 +17,8 @@
 #ifndef ART_ODREFRESH_ODR_COMMON_H_
 #define ART_ODREFRESH_ODR_COMMON_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <string>
 #include <string_view>
@@ -41,6 +43,13 @@ bool ShouldDisablePartialCompilation(const std::string& security_patch_str);
 // `ro.build.version.sdk`, which represents the SDK version.
 bool ShouldDisableRefresh(const std::string& sdk_version_str);
 
+// Returns how many dex2oat invocations can run at the same time without using more than `num_cpus`
+// CPUs or `available_memory_bytes` of memory. `threads_per_invocation` is the value passed to
+// dex2oat with `-j`, or 0 if dex2oat picks it, in which case it uses all the CPUs.
+size_t ComputeMaxConcurrentCompilations(size_t num_cpus,
+                                        size_t threads_per_invocation,
+                                        uint64_t available_memory_bytes);
+
 // Passes the name and the value for each system property to the provided callback.
 void SystemPropertyForeach(std::function<void(const char* name, const char* value)> action);
 
@@ -55,5 +55,22 @@ TEST(OdrCommonTest, ShouldDisableRefresh) {
   EXPECT_FALSE(ShouldDisableRefresh("invalid"));
 }
 
+TEST(OdrCommonTest, ComputeMaxConcurrentCompilations) {
+  constexpr uint64_t kGiB = 1024ull * 1024 * 1024;
+  // Bounded by CPUs.
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(8, 4, 16 * kGiB), 2u);
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(8, 3, 16 * kGiB), 2u);
+  // dex2oat uses all the CPUs by default.
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(8, 0, 16 * kGiB), 1u);
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(4, 8, 16 * kGiB), 1u);
+  // Bounded by memory.
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(8, 2, 3 * kGiB), 3u);
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(8, 2, kGiB / 2), 1u);
+  // Bounded by the maximum.
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(64, 1, 64 * kGiB), 4u);
+  // Always at least one.
+  EXPECT_EQ(ComputeMaxConcurrentCompilations(0, 0, 0), 1u);
+}
+
 }  // namespace odrefresh
 }  // namespace art
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "odr_compilation_scheduler.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "android-base/logging.h"
+
+namespace art {
+namespace odrefresh {
+
+OdrCompilationScheduler::OdrCompilationScheduler(size_t max_concurrent_jobs)
+    : max_concurrent_jobs_(std::max<size_t>(max_concurrent_jobs, 1u)) {}
+
+OdrCompilationScheduler::JobId OdrCompilationScheduler::AddJob(
+    Job job, const std::vector<JobId>& dependencies) {
+  std::lock_guard<std::mutex> guard(lock_);
+  JobId id = jobs_.size();
+  for (JobId dependency : dependencies) {
+    // Only depending on earlier jobs makes cycles impossible.
+    CHECK_LT(dependency, id);
+  }
+  jobs_.push_back({.job = std::move(job), .dependencies = dependencies});
+  ++num_pending_jobs_;
+  return id;
+}
+
+void OdrCompilationScheduler::Run() {
+  size_t num_threads;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    num_threads = std::min(max_concurrent_jobs_, num_pending_jobs_);
+  }
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back([this]() { RunJobs(); });
+  }
+  RunJobs();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+OdrCompilationScheduler::JobState OdrCompilationScheduler::GetJobState(JobId id) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  CHECK_LT(id, jobs_.size());
+  return jobs_[id].state;
+}
+
+void OdrCompilationScheduler::RunJobs() {
+  std::unique_lock<std::mutex> lock(lock_);
+  while (num_pending_jobs_ != 0) {
+    JobId id;
+    if (!FindRunnableJobLocked(&id)) {
+      if (num_pending_jobs_ != 0) {
+        // Wait for a running job to complete, it may be a dependency of the pending ones.
+        job_completed_.wait(lock);
+      }
+      continue;
+    }
+    JobInfo& info = jobs_[id];
+    info.state = JobState::kRunning;
+    --num_pending_jobs_;
+    Job job = std::move(info.job);
+    lock.unlock();
+    bool succeeded = job();
+    lock.lock();
+    jobs_[id].state = succeeded ? JobState::kSucceeded : JobState::kFailed;
+    job_completed_.notify_all();
+  }
+  // Wake up the threads waiting for the jobs that got skipped.
+  job_completed_.notify_all();
+}
+
+bool OdrCompilationScheduler::FindRunnableJobLocked(/*out*/ JobId* id) {
+  for (JobId i = 0; i < jobs_.size(); ++i) {
+    JobInfo& info = jobs_[i];
+    if (info.state != JobState::kPending) {
+      continue;
+    }
+    bool ready = true;
+    bool skip = false;
+    for (JobId dependency : info.dependencies) {
+      JobState state = jobs_[dependency].state;
+      if (state == JobState::kFailed || state == JobState::kSkipped) {
+        skip = true;
+        break;
+      }
+      if (state != JobState::kSucceeded) {
+        ready = false;
+      }
+    }
+    if (skip) {
+      // Dependencies come first, so the jobs depending on this one are only checked after it.
+      info.state = JobState::kSkipped;
+      info.job = nullptr;
+      --num_pending_jobs_;
+    } else if (ready) {
+      *id = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace odrefresh
+}  // namespace art
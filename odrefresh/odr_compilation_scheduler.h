@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_ODREFRESH_ODR_COMPILATION_SCHEDULER_H_
+#define ART_ODREFRESH_ODR_COMPILATION_SCHEDULER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace art {
+namespace odrefresh {
+
+// Runs compilation jobs, such as dex2oat invocations, on up to a given number of threads.
+//
+// A job may depend on jobs added before it. It only starts once all of its dependencies have
+// succeeded, and it is skipped if any of them failed or was skipped. Jobs that are ready to run are
+// started in the order they were added.
+class OdrCompilationScheduler final {
+ public:
+  using JobId = size_t;
+  // Returns true if the job succeeded.
+  using Job = std::function<bool()>;
+
+  enum class JobState {
+    kPending,
+    kRunning,
+    kSucceeded,
+    kFailed,
+    kSkipped,
+  };
+
+  explicit OdrCompilationScheduler(size_t max_concurrent_jobs);
+
+  // Adds a job that runs after `dependencies` have succeeded. Must not be called during `Run()`.
+  JobId AddJob(Job job, const std::vector<JobId>& dependencies = {});
+
+  // Runs all the jobs added and returns once they have completed or have been skipped. The
+  // calling thread runs jobs as well, so no thread is created if at most one job runs at a time.
+  void Run();
+
+  JobState GetJobState(JobId id) const;
+
+  size_t GetMaxConcurrentJobs() const { return max_concurrent_jobs_; }
+
+ private:
+  struct JobInfo {
+    Job job;
+    std::vector<JobId> dependencies;
+    JobState state = JobState::kPending;
+  };
+
+  void RunJobs();
+
+  // Returns the first pending job whose dependencies have all succeeded, skipping the jobs that
+  // can no longer run on the way. Returns false if no job can start yet.
+  bool FindRunnableJobLocked(/*out*/ JobId* id);
+
+  const size_t max_concurrent_jobs_;
+
+  mutable std::mutex lock_;
+  std::condition_variable job_completed_;
+  std::vector<JobInfo> jobs_;
+  size_t num_pending_jobs_ = 0;
+};
+
+}  // namespace odrefresh
+}  // namespace art
+
+#endif  // ART_ODREFRESH_ODR_COMPILATION_SCHEDULER_H_
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "odr_compilation_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace art {
+namespace odrefresh {
+
+namespace {
+
+using ::testing::ElementsAre;
+using JobState = OdrCompilationScheduler::JobState;
+
+}  // namespace
+
+TEST(OdrCompilationSchedulerTest, RunsDependenciesFirst) {
+  OdrCompilationScheduler scheduler(/*max_concurrent_jobs=*/4);
+  std::mutex lock;
+  std::vector<int> order;
+  auto record = [&](int value) {
+    return [&, value]() {
+      std::lock_guard<std::mutex> guard(lock);
+      order.push_back(value);
+      return true;
+    };
+  };
+  OdrCompilationScheduler::JobId first = scheduler.AddJob(record(1));
+  OdrCompilationScheduler::JobId second = scheduler.AddJob(record(2), {first});
+  scheduler.AddJob(record(3), {first, second});
+  scheduler.Run();
+  EXPECT_THAT(order, ElementsAre(1, 2, 3));
+}
+
+TEST(OdrCompilationSchedulerTest, SkipsDependentsOfFailedJobs) {
+  OdrCompilationScheduler scheduler(/*max_concurrent_jobs=*/2);
+  OdrCompilationScheduler::JobId failed = scheduler.AddJob([]() { return false; });
+  OdrCompilationScheduler::JobId succeeded = scheduler.AddJob([]() { return true; });
+  OdrCompilationScheduler::JobId dependent = scheduler.AddJob([]() { return true; }, {failed});
+  OdrCompilationScheduler::JobId transitive =
+      scheduler.AddJob([]() { return true; }, {succeeded, dependent});
+  OdrCompilationScheduler::JobId independent =
+      scheduler.AddJob([]() { return true; }, {succeeded});
+  scheduler.Run();
+  EXPECT_EQ(scheduler.GetJobState(failed), JobState::kFailed);
+  EXPECT_EQ(scheduler.GetJobState(succeeded), JobState::kSucceeded);
+  EXPECT_EQ(scheduler.GetJobState(dependent), JobState::kSkipped);
+  EXPECT_EQ(scheduler.GetJobState(transitive), JobState::kSkipped);
+  EXPECT_EQ(scheduler.GetJobState(independent), JobState::kSucceeded);
+}
+
+TEST(OdrCompilationSchedulerTest, RespectsMaxConcurrentJobs) {
+  static constexpr size_t kMaxConcurrentJobs = 3;
+  OdrCompilationScheduler scheduler(kMaxConcurrentJobs);
+  std::atomic<size_t> running = 0;
+  std::atomic<size_t> max_running = 0;
+  for (size_t i = 0; i < 16; ++i) {
+    scheduler.AddJob([&]() {
+      size_t now_running = ++running;
+      size_t expected = max_running.load();
+      while (expected < now_running && !max_running.compare_exchange_weak(expected, now_running)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      --running;
+      return true;
+    });
+  }
+  scheduler.Run();
+  EXPECT_LE(max_running.load(), kMaxConcurrentJobs);
+  EXPECT_GE(max_running.load(), 1u);
+}
+
+TEST(OdrCompilationSchedulerTest, RunsIndependentJobsConcurrently) {
+  OdrCompilationScheduler scheduler(/*max_concurrent_jobs=*/2);
+  // Each job waits for the other one to start, which only completes if they run concurrently.
+  std::atomic<size_t> started = 0;
+  auto job = [&]() {
+    ++started;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (started.load() < 2u && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return started.load() == 2u;
+  };
+  OdrCompilationScheduler::JobId first = scheduler.AddJob(job);
+  OdrCompilationScheduler::JobId second = scheduler.AddJob(job);
+  scheduler.Run();
+  EXPECT_EQ(scheduler.GetJobState(first), JobState::kSucceeded);
+  EXPECT_EQ(scheduler.GetJobState(second), JobState::kSucceeded);
+}
+
+TEST(OdrCompilationSchedulerTest, RunsOnCallingThreadWhenSerial) {
+  OdrCompilationScheduler scheduler(/*max_concurrent_jobs=*/1);
+  std::thread::id caller = std::this_thread::get_id();
+  bool on_caller = false;
+  scheduler.AddJob([&]() {
+    on_caller = std::this_thread::get_id() == caller;
+    return true;
+  });
+  scheduler.Run();
+  EXPECT_TRUE(on_caller);
+}
+
+}  // namespace odrefresh
+}  // namespace art
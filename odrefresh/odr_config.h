@@ -111,6 +111,7 @@ class OdrConfig final {
   std::string standalone_system_server_jars_;
   bool compilation_os_mode_ = false;
   bool minimal_ = false;
+  std::optional<size_t> max_concurrent_compilations_;
 
   // The current values of system properties listed in `kSystemProperties`.
   std::unordered_map<std::string, std::string> system_properties_;
@@ -209,6 +210,11 @@ class OdrConfig final {
   }
   bool GetCompilationOsMode() const { return compilation_os_mode_; }
   bool GetMinimal() const { return minimal_; }
+  // The maximum number of dex2oat invocations running at the same time, or `std::nullopt` to
+  // derive it from the CPUs and the memory available.
+  std::optional<size_t> GetMaxConcurrentCompilations() const {
+    return max_concurrent_compilations_;
+  }
   const std::unordered_map<std::string, std::string>& GetSystemProperties() const {
     return system_properties_;
   }
@@ -266,6 +272,8 @@ class OdrConfig final {
 
   void SetMinimal(bool value) { minimal_ = value; }
 
+  void SetMaxConcurrentCompilations(size_t value) { max_concurrent_compilations_ = value; }
+
   std::unordered_map<std::string, std::string>* MutableSystemProperties() {
     return &system_properties_;
   }
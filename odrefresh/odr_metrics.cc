@@ -153,6 +153,7 @@ OdrMetricsRecord OdrMetrics::ToRecord() const {
       .system_server_dex2oat_result = ConvertExecResult(system_server_dex2oat_result_),
       .primary_bcp_compilation_type = static_cast<int32_t>(primary_bcp_compilation_type_),
       .secondary_bcp_compilation_type = static_cast<int32_t>(secondary_bcp_compilation_type_),
+      .total_compilation_millis = total_compilation_millis_,
   };
 }
 
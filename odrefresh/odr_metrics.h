@@ -129,6 +129,12 @@ class OdrMetrics final {
                         int64_t compilation_time,
                         const std::optional<ExecResult>& dex2oat_result);
 
+  // Sets the wall time spent compiling. Compilations may run concurrently, so this can be less
+  // than the sum of the compilation times of the stages.
+  void SetTotalCompilationTime(int64_t compilation_time_ms) {
+    total_compilation_millis_ = static_cast<int32_t>(compilation_time_ms);
+  }
+
   // Sets the BCP compilation type.
   void SetBcpCompilationType(Stage stage, BcpCompilationType type);
 
@@ -186,6 +192,9 @@ class OdrMetrics final {
   // The result of the last dex2oat invocation for compiling system server, or `std::nullopt` if
   // dex2oat is not invoked.
   std::optional<ExecResult> system_server_dex2oat_result_;
+
+  // The wall time spent on all the compilations.
+  int32_t total_compilation_millis_ = 0;
 };
 
 // Generated ostream operators.
@@ -143,6 +143,7 @@ android::base::Result<void> OdrMetricsRecord::ReadFromFile(const std::string& fi
   system_server_dex2oat_result = OR_RETURN(ReadExecResult(metrics, "system_server_dex2oat_result"));
   primary_bcp_compilation_type = OR_RETURN(ReadInt32(metrics, "primary_bcp_compilation_type"));
   secondary_bcp_compilation_type = OR_RETURN(ReadInt32(metrics, "secondary_bcp_compilation_type"));
+  total_compilation_millis = OR_RETURN(ReadInt32(metrics, "total_compilation_millis"));
 
   return {};
 }
@@ -168,6 +169,7 @@ android::base::Result<void> OdrMetricsRecord::WriteToFile(const std::string& fil
   AddResult(metrics, "system_server_dex2oat_result", system_server_dex2oat_result);
   AddMetric(metrics, "primary_bcp_compilation_type", primary_bcp_compilation_type);
   AddMetric(metrics, "secondary_bcp_compilation_type", secondary_bcp_compilation_type);
+  AddMetric(metrics, "total_compilation_millis", total_compilation_millis);
 
   tinyxml2::XMLError result = xml_document.SaveFile(filename.data(), /*compact=*/true);
   if (result == tinyxml2::XML_SUCCESS) {
@@ -31,7 +31,7 @@ namespace odrefresh {
 constexpr const char* kOdrefreshMetricsFile = "/data/misc/odrefresh/odrefresh-metrics.xml";
 
 // Initial OdrefreshMetrics version
-static constexpr int32_t kOdrefreshMetricsVersion = 4;
+static constexpr int32_t kOdrefreshMetricsVersion = 5;
 
 // Constant value used in ExecResult when the process was not run at all.
 // Mirrors EXEC_RESULT_STATUS_NOT_RUN contained in frameworks/proto_logging/atoms.proto.
@@ -74,6 +74,8 @@ struct OdrMetricsRecord {
   Dex2OatExecResult system_server_dex2oat_result;
   int32_t primary_bcp_compilation_type;
   int32_t secondary_bcp_compilation_type;
+  // Not reported to statsd yet.
+  int32_t total_compilation_millis;
 
   // Reads a `MetricsRecord` from an XML file.
   // Returns an error if the XML document was not found or parsed correctly.
@@ -93,6 +93,7 @@ TEST_F(OdrMetricsRecordTest, HappyPath) {
   expected.system_server_dex2oat_result = OdrMetricsRecord::Dex2OatExecResult(3, -1, 9);
   expected.primary_bcp_compilation_type = 0x82837192;
   expected.secondary_bcp_compilation_type = 0x91827312;
+  expected.total_compilation_millis = 0x62636465;
 
   ASSERT_THAT(expected.WriteToFile(file_path_), Ok());
 
@@ -127,6 +128,7 @@ TEST_F(OdrMetricsRecordTest, HappyPath) {
             actual.system_server_dex2oat_result.signal);
   ASSERT_EQ(expected.primary_bcp_compilation_type, actual.primary_bcp_compilation_type);
   ASSERT_EQ(expected.secondary_bcp_compilation_type, actual.secondary_bcp_compilation_type);
+  ASSERT_EQ(expected.total_compilation_millis, actual.total_compilation_millis);
   ASSERT_EQ(0, memcmp(&expected, &actual, sizeof(expected)));
 }
 
@@ -197,5 +197,15 @@ TEST_F(OdrMetricsTest, SystemServerResultWithValue) {
   EXPECT_EQ(record.system_server_dex2oat_result.signal, 9);
 }
 
+TEST_F(OdrMetricsTest, TotalCompilationTime) {
+  OdrMetrics metrics(GetCacheDirectory(), GetMetricsFilePath());
+  EXPECT_EQ(metrics.ToRecord().total_compilation_millis, 0);
+  // Concurrent compilations take less than the sum of their times.
+  metrics.SetDex2OatResult(OdrMetrics::Stage::kPrimaryBootClasspath, 100, std::nullopt);
+  metrics.SetDex2OatResult(OdrMetrics::Stage::kSecondaryBootClasspath, 200, std::nullopt);
+  metrics.SetTotalCompilationTime(250);
+  EXPECT_EQ(metrics.ToRecord().total_compilation_millis, 250);
+}
+
 }  // namespace odrefresh
 }  // namespace art
@@ -40,6 +40,7 @@
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <set>
@@ -109,6 +110,7 @@ using ::android::base::Join;
 using ::android::base::ParseBool;
 using ::android::base::ParseBoolResult;
 using ::android::base::ParseInt;
+using ::android::base::ParseUint;
 using ::android::base::Result;
 using ::android::base::SetProperty;
 using ::android::base::Split;
@@ -146,19 +148,19 @@ void EraseFiles(const std::vector<std::unique_ptr<File>>& files) {
   }
 }
 
-// Moves `files` to the directory `output_directory_path`.
+// Moves `files` to `output_file_paths`, respectively.
 //
 // If any of the files cannot be moved, then all copies of the files are removed from both
 // the original location and the output location.
 //
 // Returns true if all files are moved, false otherwise.
 bool MoveOrEraseFiles(const std::vector<std::unique_ptr<File>>& files,
-                      std::string_view output_directory_path) {
+                      const std::vector<std::string>& output_file_paths) {
+  DCHECK_EQ(files.size(), output_file_paths.size());
   std::vector<std::unique_ptr<File>> output_files;
-  for (auto& file : files) {
-    std::string file_basename(Basename(file->GetPath()));
-    std::string output_file_path = "{}/{}"_format(output_directory_path, file_basename);
-    std::string input_file_path = file->GetPath();
+  for (size_t i = 0; i < files.size(); ++i) {
+    const std::unique_ptr<File>& file = files[i];
+    const std::string& output_file_path = output_file_paths[i];
 
     output_files.emplace_back(OS::CreateEmptyFileWriteOnly(output_file_path.c_str()));
     if (output_files.back() == nullptr) {
@@ -410,30 +412,36 @@ bool IsCpuSetSpecValid(const std::string& cpu_set) {
   return true;
 }
 
-Result<void> AddDex2OatConcurrencyArguments(/*inout*/ std::vector<std::string>& args,
-                                            bool is_compilation_os) {
-  std::string threads;
+std::string GetDex2OatThreads(bool is_compilation_os) {
   if (is_compilation_os) {
-    threads = GetProperty("dalvik.vm.background-dex2oat-threads", "");
+    std::string threads = GetProperty("dalvik.vm.background-dex2oat-threads", "");
     if (threads.empty()) {
       threads = GetProperty("dalvik.vm.dex2oat-threads", "");
     }
-  } else {
-    threads = GetProperty("dalvik.vm.boot-dex2oat-threads", "");
-  }
-  if (!threads.empty()) {
-    args.push_back("-j" + threads);
+    return threads;
   }
+  return GetProperty("dalvik.vm.boot-dex2oat-threads", "");
+}
 
-  std::string cpu_set;
+std::string GetDex2OatCpuSet(bool is_compilation_os) {
   if (is_compilation_os) {
-    cpu_set = GetProperty("dalvik.vm.background-dex2oat-cpu-set", "");
+    std::string cpu_set = GetProperty("dalvik.vm.background-dex2oat-cpu-set", "");
     if (cpu_set.empty()) {
       cpu_set = GetProperty("dalvik.vm.dex2oat-cpu-set", "");
     }
-  } else {
-    cpu_set = GetProperty("dalvik.vm.boot-dex2oat-cpu-set", "");
+    return cpu_set;
   }
+  return GetProperty("dalvik.vm.boot-dex2oat-cpu-set", "");
+}
+
+Result<void> AddDex2OatConcurrencyArguments(/*inout*/ std::vector<std::string>& args,
+                                            bool is_compilation_os) {
+  std::string threads = GetDex2OatThreads(is_compilation_os);
+  if (!threads.empty()) {
+    args.push_back("-j" + threads);
+  }
+
+  std::string cpu_set = GetDex2OatCpuSet(is_compilation_os);
   if (!cpu_set.empty()) {
     if (!IsCpuSetSpecValid(cpu_set)) {
       return Errorf("Invalid CPU set spec '{}'", cpu_set);
@@ -586,7 +594,9 @@ void AddCompiledBootClasspathFdsIfAny(
 }
 
 std::string GetStagingLocation(const std::string& staging_dir, const std::string& path) {
-  return staging_dir + "/" + Basename(path);
+  // Artifacts for different ISAs have the same names and may be compiled at the same time, so the
+  // name of the ISA directory is kept as a prefix.
+  return staging_dir + "/" + Basename(Dirname(path)) + "@" + Basename(path);
 }
 
 WARN_UNUSED bool CheckCompilationSpace() {
@@ -705,6 +715,24 @@ time_t OnDeviceRefresh::GetSubprocessTimeout() const {
   return std::min(GetExecutionTimeRemaining(), kMaxChildProcessSeconds);
 }
 
+size_t OnDeviceRefresh::GetMaxConcurrentCompilations() const {
+  std::optional<size_t> max_concurrent_compilations = config_.GetMaxConcurrentCompilations();
+  if (max_concurrent_compilations.has_value()) {
+    return max_concurrent_compilations.value();
+  }
+
+  size_t num_cpus = static_cast<size_t>(std::max(sysconf(_SC_NPROCESSORS_ONLN), 1L));
+  std::string cpu_set = GetDex2OatCpuSet(config_.GetCompilationOsMode());
+  if (!cpu_set.empty()) {
+    num_cpus = Split(cpu_set, ",").size();
+  }
+  size_t threads = 0;
+  ParseUint(GetDex2OatThreads(config_.GetCompilationOsMode()), &threads);
+  uint64_t available_memory_bytes = static_cast<uint64_t>(sysconf(_SC_AVPHYS_PAGES)) *
+                                    static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  return ComputeMaxConcurrentCompilations(num_cpus, threads, available_memory_bytes);
+}
+
 std::optional<std::vector<apex::ApexInfo>> OnDeviceRefresh::GetApexInfoList() const {
   std::optional<apex::ApexInfoList> info_list =
       apex::readApexInfoList(config_.GetApexInfoListFile().c_str());
@@ -1699,6 +1727,7 @@ WARN_UNUSED CompilationResult OnDeviceRefresh::RunDex2oat(
       std::make_pair(artifacts.OatPath(), "oat"),
       std::make_pair(artifacts.VdexPath(), "output-vdex")};
   std::vector<std::unique_ptr<File>> staging_files;
+  std::vector<std::string> output_locations;
   for (const auto& [location, kind] : location_kind_pairs) {
     std::string staging_location = GetStagingLocation(staging_dir, location);
     std::unique_ptr<File> staging_file(OS::CreateEmptyFile(staging_location.c_str()));
@@ -1712,6 +1741,7 @@ WARN_UNUSED CompilationResult OnDeviceRefresh::RunDex2oat(
     staging_file->MarkUnchecked();
     args.emplace_back(StringPrintf("--%s-fd=%d", kind, staging_file->Fd()));
     staging_files.emplace_back(std::move(staging_file));
+    output_locations.push_back(location);
   }
 
   std::string install_location = Dirname(artifacts.OatPath());
@@ -1744,7 +1774,7 @@ WARN_UNUSED CompilationResult OnDeviceRefresh::RunDex2oat(
         dex2oat_result);
   }
 
-  if (!MoveOrEraseFiles(staging_files, install_location)) {
+  if (!MoveOrEraseFiles(staging_files, output_locations)) {
     return CompilationResult::Error(OdrMetrics::Status::kIoError,
                                     "Failed to commit artifacts to '{}'"_format(install_location));
   }
@@ -1970,39 +2000,49 @@ WARN_UNUSED CompilationResult OnDeviceRefresh::RunDex2oatForSystemServer(
                     readonly_files_raii);
 }
 
-WARN_UNUSED CompilationResult
-OnDeviceRefresh::CompileSystemServer(const std::string& staging_dir,
-                                     const std::set<std::string>& system_server_jars_to_compile,
-                                     const std::function<void()>& on_dex2oat_success) const {
+void OnDeviceRefresh::CompileSystemServer(
+    const std::string& staging_dir,
+    const std::set<std::string>& system_server_jars_to_compile,
+    const std::function<void()>& on_dex2oat_success,
+    const std::vector<OdrCompilationScheduler::JobId>& dependencies,
+    /*inout*/ OdrCompilationScheduler& scheduler,
+    /*out*/ std::vector<CompilationResult>* results) const {
   DCHECK(!system_server_jars_to_compile.empty());
 
-  CompilationResult result = CompilationResult::Ok();
+  // Reserved up front, the jobs keep pointers to their results.
+  results->clear();
+  results->reserve(system_server_jars_to_compile.size());
   std::vector<std::string> classloader_context;
 
-  if (!CheckCompilationSpace()) {
-    LOG(ERROR) << "Compilation of system_server failed: Insufficient space";
-    return CompilationResult::Error(OdrMetrics::Status::kNoSpace, "Insufficient space");
-  }
-
+  // The class loader context only refers to the dex files of the jars before, not to their
+  // artifacts, so the jars can be compiled in any order.
   for (const std::string& jar : all_systemserver_jars_) {
     if (ContainsElement(system_server_jars_to_compile, jar)) {
-      CompilationResult current_result =
-          RunDex2oatForSystemServer(staging_dir, jar, classloader_context);
-      result.Merge(current_result);
-
-      if (current_result.IsOk()) {
-        on_dex2oat_success();
-      } else {
-        LOG(ERROR) << "Compilation of {} failed: {}"_format(Basename(jar), result.error_msg);
-      }
+      CompilationResult* result = &results->emplace_back(CompilationResult::Ok());
+      scheduler.AddJob(
+          // Captures copies, the arguments don't outlive this call.
+          [this, staging_dir, on_dex2oat_success, jar, classloader_context, result]() {
+            if (!CheckCompilationSpace()) {
+              LOG(ERROR) << "Compilation of {} failed: Insufficient space"_format(Basename(jar));
+              *result =
+                  CompilationResult::Error(OdrMetrics::Status::kNoSpace, "Insufficient space");
+              return false;
+            }
+            *result = RunDex2oatForSystemServer(staging_dir, jar, classloader_context);
+            if (!result->IsOk()) {
+              LOG(ERROR) << "Compilation of {} failed: {}"_format(Basename(jar), result->error_msg);
+              return false;
+            }
+            on_dex2oat_success();
+            return true;
+          },
+          dependencies);
     }
 
     if (ContainsElement(systemserver_classpath_jars_, jar)) {
       classloader_context.emplace_back(jar);
     }
   }
-
-  return result;
 }
 
 WARN_UNUSED ExitCode OnDeviceRefresh::Compile(OdrMetrics& metrics,
@@ -2049,7 +2089,9 @@ WARN_UNUSED ExitCode OnDeviceRefresh::Compile(OdrMetrics& metrics,
   uint32_t dex2oat_invocation_count = 0;
   uint32_t total_dex2oat_invocation_count = compilation_options.CompilationUnitCount();
   ReportNextBootAnimationProgress(dex2oat_invocation_count, total_dex2oat_invocation_count);
+  std::mutex progress_lock;
   auto advance_animation_progress = [&]() {
+    std::lock_guard<std::mutex> guard(progress_lock);
     ReportNextBootAnimationProgress(++dex2oat_invocation_count, total_dex2oat_invocation_count);
   };
 
@@ -2057,31 +2099,73 @@ WARN_UNUSED ExitCode OnDeviceRefresh::Compile(OdrMetrics& metrics,
   DCHECK(!bcp_instruction_sets.empty() && bcp_instruction_sets.size() <= 2);
   InstructionSet system_server_isa = config_.GetSystemServerIsa();
 
-  bool system_server_isa_failed = false;
+  // Independent dex2oat invocations run concurrently: the boot images for different ISAs, and the
+  // system server jars once the boot images for their ISA are compiled.
+  OdrCompilationScheduler scheduler(GetMaxConcurrentCompilations());
+  LOG(INFO) << "Running up to {} compilations concurrently"_format(
+      scheduler.GetMaxConcurrentJobs());
+
+  const auto& boot_images_to_generate_for_isas =
+      compilation_options.boot_images_to_generate_for_isas;
+  std::vector<CompilationResult> bcp_results(boot_images_to_generate_for_isas.size(),
+                                             CompilationResult::Ok());
+  std::vector<OdrCompilationScheduler::JobId> system_server_dependencies;
+  for (size_t i = 0; i < boot_images_to_generate_for_isas.size(); ++i) {
+    const auto& [isa, boot_images_to_generate] = boot_images_to_generate_for_isas[i];
+    OdrCompilationScheduler::JobId job = scheduler.AddJob(
+        [&, isa = isa, boot_images_to_generate = boot_images_to_generate, i]() {
+          bcp_results[i] = CompileBootClasspath(
+              staging_dir, isa, boot_images_to_generate, advance_animation_progress);
+          return bcp_results[i].IsOk();
+        });
+    if (isa == system_server_isa) {
+      // Don't compile system server if the compilation of BCP failed.
+      system_server_dependencies.push_back(job);
+    }
+  }
+
+  std::vector<CompilationResult> ss_results;
+  if (!compilation_options.system_server_jars_to_compile.empty()) {
+    CompileSystemServer(staging_dir,
+                        compilation_options.system_server_jars_to_compile,
+                        advance_animation_progress,
+                        system_server_dependencies,
+                        scheduler,
+                        &ss_results);
+  }
+
+  Timer timer;
+  scheduler.Run();
+  metrics.SetTotalCompilationTime(timer.duration().count());
+
+  // Report the results in the order of the stages, regardless of the order they completed in.
   std::optional<std::pair<OdrMetrics::Stage, OdrMetrics::Status>> first_failure;
 
-  for (const auto& [isa, boot_images_to_generate] :
-       compilation_options.boot_images_to_generate_for_isas) {
+  for (size_t i = 0; i < boot_images_to_generate_for_isas.size(); ++i) {
+    const auto& [isa, boot_images_to_generate] = boot_images_to_generate_for_isas[i];
     OdrMetrics::Stage stage = (isa == bcp_instruction_sets.front()) ?
                                   OdrMetrics::Stage::kPrimaryBootClasspath :
                                   OdrMetrics::Stage::kSecondaryBootClasspath;
-    CompilationResult bcp_result =
-        CompileBootClasspath(staging_dir, isa, boot_images_to_generate, advance_animation_progress);
+    const CompilationResult& bcp_result = bcp_results[i];
     metrics.SetDex2OatResult(stage, bcp_result.elapsed_time_ms, bcp_result.dex2oat_result);
     metrics.SetBcpCompilationType(stage, boot_images_to_generate.GetTypeForMetrics());
     if (!bcp_result.IsOk()) {
-      if (isa == system_server_isa) {
-        system_server_isa_failed = true;
-      }
       first_failure = first_failure.value_or(std::make_pair(stage, bcp_result.status));
     }
   }
 
-  // Don't compile system server if the compilation of BCP failed.
-  if (!system_server_isa_failed && !compilation_options.system_server_jars_to_compile.empty()) {
+  bool system_server_skipped = std::any_of(
+      system_server_dependencies.begin(),
+      system_server_dependencies.end(),
+      [&](OdrCompilationScheduler::JobId job) {
+        return scheduler.GetJobState(job) != OdrCompilationScheduler::JobState::kSucceeded;
+      });
+  if (!ss_results.empty() && !system_server_skipped) {
     OdrMetrics::Stage stage = OdrMetrics::Stage::kSystemServerClasspath;
-    CompilationResult ss_result = CompileSystemServer(
-        staging_dir, compilation_options.system_server_jars_to_compile, advance_animation_progress);
+    CompilationResult ss_result = CompilationResult::Ok();
+    for (const CompilationResult& result : ss_results) {
+      ss_result.Merge(result);
+    }
     metrics.SetDex2OatResult(stage, ss_result.elapsed_time_ms, ss_result.dex2oat_result);
     if (!ss_result.IsOk()) {
       first_failure = first_failure.value_or(std::make_pair(stage, ss_result.status));
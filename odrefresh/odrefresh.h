@@ -32,6 +32,7 @@
 #include "com_android_art.h"
 #include "exec_utils.h"
 #include "odr_artifacts.h"
+#include "odr_compilation_scheduler.h"
 #include "odr_config.h"
 #include "odr_metrics.h"
 #include "odrefresh/odrefresh.h"
@@ -190,6 +191,9 @@ class OnDeviceRefresh final {
 
   time_t GetSubprocessTimeout() const;
 
+  // Returns how many dex2oat invocations can run at the same time.
+  size_t GetMaxConcurrentCompilations() const;
+
   // Gets the `ApexInfo` for active APEXes.
   std::optional<std::vector<com::android::apex::ApexInfo>> GetApexInfoList() const;
 
@@ -354,10 +358,14 @@ class OnDeviceRefresh final {
                             const std::string& dex_file,
                             const std::vector<std::string>& classloader_context) const;
 
-  WARN_UNUSED CompilationResult
-  CompileSystemServer(const std::string& staging_dir,
-                      const std::set<std::string>& system_server_jars_to_compile,
-                      const std::function<void()>& on_dex2oat_success) const;
+  // Adds a job compiling each of `system_server_jars_to_compile` to `scheduler`, to run once
+  // `dependencies` have succeeded. The jobs store their results in `results`, in classpath order.
+  void CompileSystemServer(const std::string& staging_dir,
+                           const std::set<std::string>& system_server_jars_to_compile,
+                           const std::function<void()>& on_dex2oat_success,
+                           const std::vector<OdrCompilationScheduler::JobId>& dependencies,
+                           /*inout*/ OdrCompilationScheduler& scheduler,
+                           /*out*/ std::vector<CompilationResult>* results) const;
 
   // Configuration to use.
   const OdrConfig& config_;
@@ -20,6 +20,7 @@
 #include <string_view>
 #include <unordered_map>
 
+#include "android-base/parseint.h"
 #include "android-base/properties.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
@@ -161,6 +162,13 @@ int InitializeConfig(int argc, char** argv, OdrConfig* config) {
       config->SetRefresh(false);
     } else if (ArgumentEquals(arg, "--minimal")) {
       config->SetMinimal(true);
+    } else if (ArgumentMatches(arg, "--max-concurrent-compilations=", &value)) {
+      size_t max_concurrent_compilations;
+      if (!android::base::ParseUint(value, &max_concurrent_compilations) ||
+          max_concurrent_compilations == 0) {
+        ArgumentError("Invalid value for --max-concurrent-compilations: '%s'", value.c_str());
+      }
+      config->SetMaxConcurrentCompilations(max_concurrent_compilations);
     } else {
       ArgumentError("Unrecognized argument: '%s'", arg);
     }
@@ -245,6 +253,10 @@ NO_RETURN void UsageHelp(const char* argv0) {
   UsageMsg("                                 Compiler filter that overrides");
   UsageMsg("                                 dalvik.vm.systemservercompilerfilter");
   UsageMsg("--minimal                        Generate a minimal boot image only.");
+  UsageMsg("--max-concurrent-compilations=<N>");
+  UsageMsg("                                 Maximum number of dex2oat invocations running at");
+  UsageMsg("                                 the same time. Default: derived from the CPUs and");
+  UsageMsg("                                 the memory available");
 
   exit(EX_USAGE);
 }
@@ -227,6 +227,8 @@ class OdRefreshTest : public CommonArtTest {
     config_.SetZygoteKind(ZygoteKind::kZygote64_32);
     config_.SetSystemServerCompilerFilter("");
     config_.SetArtifactDirectory(dalvik_cache_dir_);
+    // Run independent compilations concurrently, as on devices with enough CPUs and memory.
+    config_.SetMaxConcurrentCompilations(2);
 
     std::string staging_dir = dalvik_cache_dir_ + "/staging";
     ASSERT_TRUE(EnsureDirectoryExists(staging_dir));
@@ -16,6 +16,11 @@
 
 #include "instruction_set_features_riscv64.h"
 
+#if defined(ART_TARGET_ANDROID) && defined(__riscv)
+#include <sys/auxv.h>
+#include <sys/hwprobe.h>
+#endif
+
 #include <fstream>
 #include <sstream>
 
@@ -31,10 +36,16 @@ constexpr uint32_t BasicFeatures() {
 
 Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromVariant(
     const std::string& variant, std::string* error_msg ATTRIBUTE_UNUSED) {
-  if (variant != "generic") {
+  // The RVA22U64 profile mandates Zba and Zbb, RVA23U64 adds the vector extension.
+  uint32_t bits = BasicFeatures();
+  if (variant == "rva22u64") {
+    bits |= kExtZba | kExtZbb;
+  } else if (variant == "rva23u64") {
+    bits |= kExtVector | kExtZba | kExtZbb;
+  } else if (variant != "generic") {
     LOG(WARNING) << "Unexpected CPU variant for Riscv64 using defaults: " << variant;
   }
-  return Riscv64FeaturesUniquePtr(new Riscv64InstructionSetFeatures(BasicFeatures()));
+  return Riscv64FeaturesUniquePtr(new Riscv64InstructionSetFeatures(bits));
 }
 
 Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromBitmap(uint32_t bitmap) {
@@ -42,17 +53,99 @@ Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromBitmap(uint32_t bitm
 }
 
 Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromCppDefines() {
-  return Riscv64FeaturesUniquePtr(new Riscv64InstructionSetFeatures(BasicFeatures()));
+  uint32_t bits = BasicFeatures();
+#if defined(__riscv_vector)
+  bits |= kExtVector;
+#endif
+#if defined(__riscv_zba)
+  bits |= kExtZba;
+#endif
+#if defined(__riscv_zbb)
+  bits |= kExtZbb;
+#endif
+  return Riscv64FeaturesUniquePtr(new Riscv64InstructionSetFeatures(bits));
+}
+
+Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromIsaString(const std::string& isa) {
+  // The single letter extensions come first, the multi-letter ones follow, separated by
+  // underscores, e.g. "rv64imafdc_zicsr_zba_zbb".
+  std::vector<std::string> extensions = android::base::Split(android::base::Trim(isa), "_");
+  uint32_t bits = 0u;
+  if (android::base::StartsWith(extensions[0], "rv64")) {
+    std::string letters = extensions[0].substr(4u);
+    auto has_letter = [&](char letter) { return letters.find(letter) != std::string::npos; };
+    if (has_letter('g') ||
+        (has_letter('i') && has_letter('m') && has_letter('a') && has_letter('f') &&
+         has_letter('d'))) {
+      bits |= kExtGeneric;
+    }
+    if (has_letter('c')) {
+      bits |= kExtCompressed;
+    }
+    if (has_letter('v')) {
+      bits |= kExtVector;
+    }
+  }
+  for (const std::string& extension : extensions) {
+    if (extension == "zba") {
+      bits |= kExtZba;
+    } else if (extension == "zbb") {
+      bits |= kExtZbb;
+    }
+  }
+  return Riscv64FeaturesUniquePtr(new Riscv64InstructionSetFeatures(bits));
 }
 
 Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromCpuInfo() {
-  UNIMPLEMENTED(WARNING);
+  // Look in /proc/cpuinfo for the ISA string, e.g. "isa : rv64imafdc_zba_zbb".
+  std::ifstream in("/proc/cpuinfo");
+  if (in.fail()) {
+    LOG(ERROR) << "Failed to open /proc/cpuinfo";
+    return FromCppDefines();
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    if (android::base::StartsWith(line, "isa")) {
+      size_t colon = line.find(':');
+      if (colon != std::string::npos) {
+        return FromIsaString(line.substr(colon + 1u));
+      }
+    }
+  }
+  LOG(ERROR) << "No ISA string in /proc/cpuinfo";
   return FromCppDefines();
 }
 
 Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromHwcap() {
-  UNIMPLEMENTED(WARNING);
-  return FromCppDefines();
+  uint32_t bits = 0u;
+
+#if defined(ART_TARGET_ANDROID) && defined(__riscv)
+  // AT_HWCAP has a bit per single letter extension, the others are queried with riscv_hwprobe.
+  auto has_letter = [hwcaps = getauxval(AT_HWCAP)](char letter) {
+    return (hwcaps & (UINT64_C(1) << (letter - 'a'))) != 0u;
+  };
+  if (has_letter('i') && has_letter('m') && has_letter('a') && has_letter('f') &&
+      has_letter('d')) {
+    bits |= kExtGeneric;
+  }
+  if (has_letter('c')) {
+    bits |= kExtCompressed;
+  }
+  if (has_letter('v')) {
+    bits |= kExtVector;
+  }
+  riscv_hwprobe probe = {RISCV_HWPROBE_KEY_IMA_EXT_0, 0u};
+  if (__riscv_hwprobe(&probe, 1u, 0u, nullptr, 0u) == 0) {
+    if ((probe.value & RISCV_HWPROBE_EXT_ZBA) != 0u) {
+      bits |= kExtZba;
+    }
+    if ((probe.value & RISCV_HWPROBE_EXT_ZBB) != 0u) {
+      bits |= kExtZbb;
+    }
+  }
+#endif
+
+  return Riscv64FeaturesUniquePtr(new Riscv64InstructionSetFeatures(bits));
 }
 
 Riscv64FeaturesUniquePtr Riscv64InstructionSetFeatures::FromAssembly() {
@@ -85,15 +178,42 @@ std::string Riscv64InstructionSetFeatures::GetFeatureString() const {
   if (bits_ & kExtVector) {
     result += "v";
   }
+  if (bits_ & kExtZba) {
+    result += "_zba";
+  }
+  if (bits_ & kExtZbb) {
+    result += "_zbb";
+  }
   return result;
 }
 
 std::unique_ptr<const InstructionSetFeatures>
 Riscv64InstructionSetFeatures::AddFeaturesFromSplitString(
-    const std::vector<std::string>& features ATTRIBUTE_UNUSED,
-    std::string* error_msg ATTRIBUTE_UNUSED) const {
-  UNIMPLEMENTED(WARNING);
-  return std::unique_ptr<const InstructionSetFeatures>(new Riscv64InstructionSetFeatures(bits_));
+    const std::vector<std::string>& features, std::string* error_msg) const {
+  // This 'features' string is from '--instruction-set-features=' option in ART.
+  // The extension names follow the ISA string and the -march option of other compilers.
+  uint32_t bits = bits_;
+  for (const std::string& feature : features) {
+    DCHECK_EQ(android::base::Trim(feature), feature)
+        << "Feature name is not trimmed: '" << feature << "'";
+    if (feature == "v") {
+      bits |= kExtVector;
+    } else if (feature == "-v") {
+      bits &= ~kExtVector;
+    } else if (feature == "zba") {
+      bits |= kExtZba;
+    } else if (feature == "-zba") {
+      bits &= ~kExtZba;
+    } else if (feature == "zbb") {
+      bits |= kExtZbb;
+    } else if (feature == "-zbb") {
+      bits &= ~kExtZbb;
+    } else {
+      *error_msg = "Unknown instruction set feature: '" + feature + "'";
+      return nullptr;
+    }
+  }
+  return std::unique_ptr<const InstructionSetFeatures>(new Riscv64InstructionSetFeatures(bits));
 }
 
 }  // namespace art
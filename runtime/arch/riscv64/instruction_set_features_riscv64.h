@@ -31,7 +31,9 @@ class Riscv64InstructionSetFeatures final : public InstructionSetFeatures {
   enum {
     kExtGeneric = (1 << 0),     // G extension covers the basic set IMAFD
     kExtCompressed = (1 << 1),  // C extension adds compressed instructions
-    kExtVector = (1 << 2)       // V extension adds vector instructions
+    kExtVector = (1 << 2),      // V extension adds vector instructions
+    kExtZba = (1 << 3),         // Zba extension adds address generation bit-manipulation
+    kExtZbb = (1 << 4),         // Zbb extension adds basic bit-manipulation
   };
 
   static Riscv64FeaturesUniquePtr FromVariant(const std::string& variant, std::string* error_msg);
@@ -42,6 +44,9 @@ class Riscv64InstructionSetFeatures final : public InstructionSetFeatures {
   // Turn C pre-processor #defines into the equivalent instruction set features.
   static Riscv64FeaturesUniquePtr FromCppDefines();
 
+  // Parse an ISA string such as "rv64imafdc_zba_zbb", as found in /proc/cpuinfo.
+  static Riscv64FeaturesUniquePtr FromIsaString(const std::string& isa);
+
   // Process /proc/cpuinfo and use kRuntimeISA to produce InstructionSetFeatures.
   static Riscv64FeaturesUniquePtr FromCpuInfo();
 
@@ -64,6 +69,10 @@ class Riscv64InstructionSetFeatures final : public InstructionSetFeatures {
 
   std::string GetFeatureString() const override;
 
+  bool HasZba() const { return (bits_ & kExtZba) != 0; }
+
+  bool HasZbb() const { return (bits_ & kExtZbb) != 0; }
+
   virtual ~Riscv64InstructionSetFeatures() {}
 
  protected:
@@ -35,4 +35,73 @@ TEST(Riscv64InstructionSetFeaturesTest, Riscv64FeaturesFromDefaultVariant) {
   EXPECT_EQ(riscv64_features->AsBitmap(), expected_extensions);  // rv64gc, aka rv64imafdc
 }
 
+TEST(Riscv64InstructionSetFeaturesTest, Riscv64FeaturesFromBitmapWithBitManipulation) {
+  uint32_t extensions = Riscv64InstructionSetFeatures::kExtGeneric |
+                        Riscv64InstructionSetFeatures::kExtCompressed |
+                        Riscv64InstructionSetFeatures::kExtZba |
+                        Riscv64InstructionSetFeatures::kExtZbb;
+  Riscv64FeaturesUniquePtr riscv64_features = Riscv64InstructionSetFeatures::FromBitmap(extensions);
+  ASSERT_TRUE(riscv64_features.get() != nullptr);
+
+  EXPECT_TRUE(riscv64_features->HasZba());
+  EXPECT_TRUE(riscv64_features->HasZbb());
+  EXPECT_EQ(riscv64_features->AsBitmap(), extensions);
+  EXPECT_STREQ("rv64gc_zba_zbb", riscv64_features->GetFeatureString().c_str());
+
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> generic_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kRiscv64, "generic", &error_msg));
+  ASSERT_TRUE(generic_features.get() != nullptr) << error_msg;
+  EXPECT_FALSE(generic_features->AsRiscv64InstructionSetFeatures()->HasZba());
+  EXPECT_FALSE(generic_features->AsRiscv64InstructionSetFeatures()->HasZbb());
+  EXPECT_FALSE(riscv64_features->Equals(generic_features.get()));
+}
+
+
+TEST(Riscv64InstructionSetFeaturesTest, Riscv64FeaturesFromProfileVariants) {
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> rva22_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kRiscv64, "rva22u64", &error_msg));
+  ASSERT_TRUE(rva22_features.get() != nullptr) << error_msg;
+  EXPECT_STREQ("rv64gc_zba_zbb", rva22_features->GetFeatureString().c_str());
+
+  std::unique_ptr<const InstructionSetFeatures> rva23_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kRiscv64, "rva23u64", &error_msg));
+  ASSERT_TRUE(rva23_features.get() != nullptr) << error_msg;
+  EXPECT_STREQ("rv64gcv_zba_zbb", rva23_features->GetFeatureString().c_str());
+}
+
+TEST(Riscv64InstructionSetFeaturesTest, Riscv64FeaturesFromIsaString) {
+  Riscv64FeaturesUniquePtr features =
+      Riscv64InstructionSetFeatures::FromIsaString(" rv64imafdc_zicsr_zifencei_zba_zbb");
+  EXPECT_STREQ("rv64gc_zba_zbb", features->GetFeatureString().c_str());
+
+  features = Riscv64InstructionSetFeatures::FromIsaString("rv64gcv");
+  EXPECT_STREQ("rv64gcv", features->GetFeatureString().c_str());
+
+  // Without the D extension the ISA is not rv64g.
+  features = Riscv64InstructionSetFeatures::FromIsaString("rv64imafc_zbb");
+  EXPECT_STREQ("rv64c_zbb", features->GetFeatureString().c_str());
+}
+
+TEST(Riscv64InstructionSetFeaturesTest, Riscv64AddFeaturesFromString) {
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> generic_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kRiscv64, "generic", &error_msg));
+  ASSERT_TRUE(generic_features.get() != nullptr) << error_msg;
+
+  std::unique_ptr<const InstructionSetFeatures> features(
+      generic_features->AddFeaturesFromString("zba,zbb", &error_msg));
+  ASSERT_TRUE(features.get() != nullptr) << error_msg;
+  EXPECT_STREQ("rv64gc_zba_zbb", features->GetFeatureString().c_str());
+
+  features = features->AddFeaturesFromString("-zba,v", &error_msg);
+  ASSERT_TRUE(features.get() != nullptr) << error_msg;
+  EXPECT_STREQ("rv64gcv_zbb", features->GetFeatureString().c_str());
+
+  features = generic_features->AddFeaturesFromString("zbs", &error_msg);
+  EXPECT_TRUE(features.get() == nullptr);
+  EXPECT_EQ("Unknown instruction set feature: 'zbs'", error_msg);
+}
+
 }  // namespace art
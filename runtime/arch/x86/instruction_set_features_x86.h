@@ -30,7 +30,7 @@
 #define SET_VEX_M_0F_3A 0x03
 #define SET_VEX_W       0x80
 #define SET_VEX_L_128   0x00
-#define SET_VEL_L_256   0x04
+#define SET_VEX_L_256   0x04
 #define SET_VEX_PP_NONE 0x00
 #define SET_VEX_PP_66   0x01
 #define SET_VEX_PP_F3   0x02
@@ -88,6 +88,8 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
 
   bool HasSSE4_1() const { return has_SSE4_1_; }
 
+  bool HasSSE4_2() const { return has_SSE4_2_; }
+
   bool HasPopCnt() const { return has_POPCNT_; }
 
   bool HasAVX2() const { return has_AVX2_; }
@@ -209,4 +209,28 @@ TEST(X86InstructionSetFeaturesTest, X86FeaturesFromKabylakeVariant) {
 
   EXPECT_FALSE(x86_64_features->Equals(x86_features.get()));
 }
+
+TEST(X86InstructionSetFeaturesTest, X86FeaturesFromBitmap) {
+  // AVX and AVX2 are independent bits of the bitmap.
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> avx_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kX86_64, "sandybridge", &error_msg));
+  ASSERT_TRUE(avx_features.get() != nullptr) << error_msg;
+  std::unique_ptr<const InstructionSetFeatures> avx_only_features(
+      avx_features->AddFeaturesFromString("avx", &error_msg));
+  ASSERT_TRUE(avx_only_features.get() != nullptr) << error_msg;
+  std::unique_ptr<const InstructionSetFeatures> from_bitmap(
+      InstructionSetFeatures::FromBitmap(InstructionSet::kX86_64, avx_only_features->AsBitmap()));
+  EXPECT_TRUE(from_bitmap->AsX86InstructionSetFeatures()->HasAVX());
+  EXPECT_FALSE(from_bitmap->AsX86InstructionSetFeatures()->HasAVX2());
+  EXPECT_TRUE(from_bitmap->Equals(avx_only_features.get()));
+
+  std::unique_ptr<const InstructionSetFeatures> kabylake_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kX86_64, "kabylake", &error_msg));
+  ASSERT_TRUE(kabylake_features.get() != nullptr) << error_msg;
+  from_bitmap = InstructionSetFeatures::FromBitmap(InstructionSet::kX86_64,
+                                                   kabylake_features->AsBitmap());
+  EXPECT_TRUE(from_bitmap->AsX86InstructionSetFeatures()->HasAVX2());
+  EXPECT_TRUE(from_bitmap->Equals(kabylake_features.get()));
+}
 }  // namespace art
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_BASE_SAMPLED_SITE_TABLE_H_
+#define ART_RUNTIME_BASE_SAMPLED_SITE_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace art {
+
+// Mix the bits of a 64-bit value (the splitmix64 finalizer), to make keys out of pointers and
+// hashes.
+inline uint64_t Mix64(uint64_t value) {
+  value ^= value >> 30;
+  value *= UINT64_C(0xbf58476d1ce4e5b9);
+  value ^= value >> 27;
+  value *= UINT64_C(0x94d049bb133111eb);
+  value ^= value >> 31;
+  return value;
+}
+
+// A fixed size open addressing table aggregating sampled runtime events by site, used by the
+// profilers that are cheap enough to leave on: nothing is allocated or locked for a known site.
+//
+// A site is claimed by CAS-ing its key into an empty slot; the claiming thread then fills in the
+// printable names and publishes the site. Counters are updated with relaxed atomics and may be
+// bumped before the names are published. Samples for new sites are dropped (and counted) once
+// the probe sequence is full.
+//
+// `Site` holds the counters and names of a site, and clears its counters in `Reset()`.
+template <typename Site, size_t kSize, size_t kMaxProbes = 32u>
+class SampledSiteTable {
+ public:
+  // The table is too big for the stack, keep it out of the objects embedding it.
+  SampledSiteTable() : entries_(new Entry[kSize]) {}
+
+  // Returns the site of `key`. For a new key an empty slot is claimed, and `init` is called
+  // with its site, to fill in the names, before it is published. Returns null if the probe
+  // sequence is full.
+  template <typename Init>
+  Site* FindOrClaim(uint64_t key, Init&& init) {
+    key = NonZeroKey(key);
+    for (size_t i = 0; i != kMaxProbes; ++i) {
+      Entry& entry = entries_[(key + i) % kSize];
+      uint64_t existing = entry.key.load(std::memory_order_relaxed);
+      if (existing == 0u) {
+        if (entry.key.compare_exchange_strong(existing, key, std::memory_order_relaxed)) {
+          init(&entry.site);
+          entry.published.store(true, std::memory_order_release);
+          return &entry.site;
+        }
+        // On failure `existing` holds the key of the winning thread.
+      }
+      if (existing == key) {
+        return &entry.site;
+      }
+    }
+    dropped_samples_.fetch_add(1u, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  // Returns the site of `key`, or null if it was never claimed.
+  Site* Find(uint64_t key) {
+    key = NonZeroKey(key);
+    for (size_t i = 0; i != kMaxProbes; ++i) {
+      Entry& entry = entries_[(key + i) % kSize];
+      uint64_t existing = entry.key.load(std::memory_order_relaxed);
+      if (existing == key) {
+        return &entry.site;
+      }
+      if (existing == 0u) {
+        break;
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns up to `n` values made by `make` from the published sites, ordered by `compare`.
+  template <typename T, typename Make, typename Compare>
+  std::vector<T> GetTop(size_t n, Make&& make, Compare&& compare) const {
+    std::vector<T> values;
+    for (size_t i = 0; i != kSize; ++i) {
+      const Entry& entry = entries_[i];
+      if (entry.published.load(std::memory_order_acquire)) {
+        values.push_back(make(entry.site));
+      }
+    }
+    if (values.size() > n) {
+      std::partial_sort(values.begin(), values.begin() + n, values.end(), compare);
+      values.resize(n);
+    } else {
+      std::sort(values.begin(), values.end(), compare);
+    }
+    return values;
+  }
+
+  // Number of samples for new sites that did not fit in the table.
+  uint64_t GetDroppedSamples() const {
+    return dropped_samples_.load(std::memory_order_relaxed);
+  }
+
+  // Clear all the sites. Not safe to call concurrently with the other methods.
+  void Reset() {
+    for (size_t i = 0; i != kSize; ++i) {
+      Entry& entry = entries_[i];
+      entry.published.store(false, std::memory_order_relaxed);
+      entry.key.store(0u, std::memory_order_relaxed);
+      entry.site.Reset();
+    }
+    dropped_samples_.store(0u, std::memory_order_relaxed);
+  }
+
+ private:
+  struct Entry {
+    std::atomic<uint64_t> key{0u};
+    std::atomic<bool> published{false};
+    // The names are written once by the thread that claims `key`, read only after `published`.
+    Site site;
+  };
+
+  static uint64_t NonZeroKey(uint64_t key) {
+    return key != 0u ? key : 1u;  // Zero marks an empty slot.
+  }
+
+  std::atomic<uint64_t> dropped_samples_{0u};
+  std::unique_ptr<Entry[]> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampledSiteTable);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_BASE_SAMPLED_SITE_TABLE_H_
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sampled_site_table.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "base/common_art_test.h"
+
+namespace art {
+
+class SampledSiteTableTest : public CommonArtTest {};
+
+namespace {
+
+struct TestSite {
+  std::atomic<uint64_t> count{0u};
+  std::string name;
+
+  void Reset() {
+    count.store(0u, std::memory_order_relaxed);
+  }
+};
+
+struct NamedCount {
+  std::string name;
+  uint64_t count;
+};
+
+// Small enough for colliding keys to exhaust the probe sequence.
+using TestTable = SampledSiteTable<TestSite, /*kSize=*/ 4u, /*kMaxProbes=*/ 2u>;
+
+TestSite* Record(TestTable* table, uint64_t key, const std::string& name, size_t* inits) {
+  TestSite* site = table->FindOrClaim(key, [&](TestSite* new_site) {
+    new_site->name = name;
+    ++*inits;
+  });
+  if (site != nullptr) {
+    site->count.fetch_add(1u, std::memory_order_relaxed);
+  }
+  return site;
+}
+
+std::vector<NamedCount> GetTop(const TestTable& table, size_t n) {
+  return table.GetTop<NamedCount>(
+      n,
+      [](const TestSite& site) {
+        return NamedCount{site.name, site.count.load(std::memory_order_relaxed)};
+      },
+      [](const NamedCount& lhs, const NamedCount& rhs) { return lhs.count > rhs.count; });
+}
+
+}  // namespace
+
+TEST_F(SampledSiteTableTest, ClaimsOncePerKey) {
+  TestTable table;
+  size_t inits = 0u;
+  TestSite* site = Record(&table, 1u, "a", &inits);
+  ASSERT_TRUE(site != nullptr);
+  EXPECT_EQ(site, Record(&table, 1u, "not a", &inits));
+  EXPECT_EQ(1u, inits);
+  EXPECT_EQ("a", site->name);
+  EXPECT_EQ(2u, site->count.load(std::memory_order_relaxed));
+
+  // Key zero marks an empty slot and shares the site of key one.
+  EXPECT_EQ(site, Record(&table, 0u, "zero", &inits));
+  EXPECT_EQ(1u, inits);
+
+  EXPECT_EQ(site, table.Find(1u));
+  EXPECT_TRUE(table.Find(2u) == nullptr);
+}
+
+TEST_F(SampledSiteTableTest, DropsWhenProbesAreFull) {
+  TestTable table;
+  size_t inits = 0u;
+  // Keys 1, 5 and 9 all start probing at slot 1; the third does not fit in two probes.
+  TestSite* first = Record(&table, 1u, "1", &inits);
+  TestSite* second = Record(&table, 5u, "5", &inits);
+  ASSERT_TRUE(first != nullptr);
+  ASSERT_TRUE(second != nullptr);
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(Record(&table, 9u, "9", &inits) == nullptr);
+  EXPECT_TRUE(Record(&table, 9u, "9", &inits) == nullptr);
+  EXPECT_EQ(2u, inits);
+  EXPECT_EQ(2u, table.GetDroppedSamples());
+  EXPECT_EQ(second, table.Find(5u));
+  EXPECT_TRUE(table.Find(9u) == nullptr);
+}
+
+TEST_F(SampledSiteTableTest, GetTopAndReset) {
+  TestTable table;
+  size_t inits = 0u;
+  Record(&table, 1u, "once", &inits);
+  for (size_t i = 0; i != 3u; ++i) {
+    Record(&table, 2u, "thrice", &inits);
+  }
+  Record(&table, 3u, "twice", &inits);
+  Record(&table, 3u, "twice", &inits);
+
+  std::vector<NamedCount> top = GetTop(table, 10u);
+  ASSERT_EQ(3u, top.size());
+  EXPECT_EQ("thrice", top[0].name);
+  EXPECT_EQ("twice", top[1].name);
+  EXPECT_EQ("once", top[2].name);
+
+  top = GetTop(table, 1u);
+  ASSERT_EQ(1u, top.size());
+  EXPECT_EQ(3u, top[0].count);
+
+  Record(&table, 9u, "dropped", &inits);
+  Record(&table, 13u, "dropped", &inits);
+  EXPECT_NE(0u, table.GetDroppedSamples());
+
+  table.Reset();
+  EXPECT_TRUE(GetTop(table, 10u).empty());
+  EXPECT_EQ(0u, table.GetDroppedSamples());
+  EXPECT_TRUE(table.Find(2u) == nullptr);
+  // A reset site is claimed again with fresh counters.
+  TestSite* site = Record(&table, 2u, "again", &inits);
+  ASSERT_TRUE(site != nullptr);
+  EXPECT_EQ("again", site->name);
+  EXPECT_EQ(1u, site->count.load(std::memory_order_relaxed));
+}
+
+}  // namespace art
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dex_cache_miss_profiler.h"
+
+#include <ostream>
+
+#include "android-base/logging.h"
+#include "base/macros.h"
+#include "dex/dex_file.h"
+
+namespace art {
+
+namespace {
+
+// Also key on the checksum, so that a dex file allocated at the address of an unloaded one
+// is unlikely to reuse its site.
+uint64_t DexFileKey(const DexFile* dex_file) {
+  return Mix64(reinterpret_cast<uintptr_t>(dex_file) ^
+               (static_cast<uint64_t>(dex_file->GetLocationChecksum()) << 32));
+}
+
+size_t NumIds(const DexFile* dex_file, DexCacheArrayKind kind) {
+  switch (kind) {
+    case DexCacheArrayKind::kStrings:
+      return dex_file->NumStringIds();
+    case DexCacheArrayKind::kTypes:
+      return dex_file->NumTypeIds();
+    case DexCacheArrayKind::kMethods:
+      return dex_file->NumMethodIds();
+    case DexCacheArrayKind::kFields:
+      return dex_file->NumFieldIds();
+    case DexCacheArrayKind::kMethodTypes:
+      return dex_file->NumProtoIds();
+  }
+  UNREACHABLE();
+}
+
+const char* ArrayName(DexCacheArrayKind kind) {
+  switch (kind) {
+    case DexCacheArrayKind::kStrings:
+      return "strings";
+    case DexCacheArrayKind::kTypes:
+      return "types";
+    case DexCacheArrayKind::kMethods:
+      return "methods";
+    case DexCacheArrayKind::kFields:
+      return "fields";
+    case DexCacheArrayKind::kMethodTypes:
+      return "method types";
+  }
+  UNREACHABLE();
+}
+
+}  // namespace
+
+DexCacheMissProfiler::DexCacheMissProfiler(uint32_t sampling_interval,
+                                           uint32_t promotion_miss_rate)
+    : sampling_interval_(sampling_interval), promotion_miss_rate_(promotion_miss_rate) {
+  CHECK_NE(sampling_interval_, 0u);
+  CHECK_LE(promotion_miss_rate_, 100u);
+}
+
+void DexCacheMissProfiler::RecordLookup(const DexFile* dex_file,
+                                        DexCacheArrayKind kind,
+                                        DexCacheLookup lookup) {
+  Site* site = dex_files_.FindOrClaim(DexFileKey(dex_file), [&](Site* new_site) {
+    new_site->location = dex_file->GetLocation();
+  });
+  if (site == nullptr) {
+    return;
+  }
+  ArrayCounters& counters = site->arrays[static_cast<size_t>(kind)];
+  counters.sampled_lookups.fetch_add(1u, std::memory_order_relaxed);
+  if (lookup != DexCacheLookup::kHit) {
+    counters.sampled_misses.fetch_add(1u, std::memory_order_relaxed);
+  }
+  if (lookup == DexCacheLookup::kConflictMiss) {
+    counters.sampled_conflict_misses.fetch_add(1u, std::memory_order_relaxed);
+    counters.window_conflict_misses.fetch_add(1u, std::memory_order_relaxed);
+  }
+  if (counters.window_lookups.fetch_add(1u, std::memory_order_relaxed) + 1u != kPromotionWindow) {
+    return;
+  }
+  // Close the window. Samples racing with this are attributed to either window, which is fine.
+  uint32_t window_conflict_misses =
+      counters.window_conflict_misses.exchange(0u, std::memory_order_relaxed);
+  counters.window_lookups.store(0u, std::memory_order_relaxed);
+  if (promotion_miss_rate_ != 0u &&
+      window_conflict_misses * 100u >= promotion_miss_rate_ * kPromotionWindow &&
+      NumIds(dex_file, kind) <= kMaxPromotedArrayLength) {
+    counters.promotion_requested.store(true, std::memory_order_relaxed);
+  }
+}
+
+bool DexCacheMissProfiler::ConsumePromotionRequest(const DexFile* dex_file,
+                                                   DexCacheArrayKind kind) {
+  Site* site = dex_files_.Find(DexFileKey(dex_file));
+  if (site == nullptr) {
+    return false;
+  }
+  ArrayCounters& counters = site->arrays[static_cast<size_t>(kind)];
+  if (!counters.promotion_requested.exchange(false, std::memory_order_relaxed)) {
+    return false;
+  }
+  counters.promotions.fetch_add(1u, std::memory_order_relaxed);
+  return true;
+}
+
+uint64_t DexCacheMissProfiler::DexFileStats::SampledMisses() const {
+  uint64_t misses = 0u;
+  for (const ArrayStats& stats : arrays) {
+    misses += stats.sampled_misses;
+  }
+  return misses;
+}
+
+std::vector<DexCacheMissProfiler::DexFileStats> DexCacheMissProfiler::GetTopDexFiles(
+    size_t n) const {
+  return dex_files_.GetTop<DexFileStats>(
+      n,
+      [](const Site& site) {
+        DexFileStats stats;
+        stats.location = site.location;
+        for (size_t i = 0; i != kNumDexCacheArrayKinds; ++i) {
+          const ArrayCounters& counters = site.arrays[i];
+          stats.arrays[i] =
+              ArrayStats{counters.sampled_lookups.load(std::memory_order_relaxed),
+                         counters.sampled_misses.load(std::memory_order_relaxed),
+                         counters.sampled_conflict_misses.load(std::memory_order_relaxed),
+                         counters.promotions.load(std::memory_order_relaxed)};
+        }
+        return stats;
+      },
+      [](const DexFileStats& lhs, const DexFileStats& rhs) {
+        return lhs.SampledMisses() > rhs.SampledMisses();
+      });
+}
+
+void DexCacheMissProfiler::Dump(std::ostream& os, size_t n) const {
+  os << "Dex cache misses (1 in " << sampling_interval_ << " pair array lookups sampled, "
+     << dex_files_.GetDroppedSamples() << " samples dropped):\n";
+  for (const DexFileStats& dex_file : GetTopDexFiles(n)) {
+    os << "  " << dex_file.location << ":";
+    const char* separator = " ";
+    for (size_t i = 0; i != kNumDexCacheArrayKinds; ++i) {
+      const ArrayStats& stats = dex_file.arrays[i];
+      if (stats.sampled_lookups == 0u) {
+        continue;
+      }
+      os << separator << ArrayName(static_cast<DexCacheArrayKind>(i)) << " "
+         << (stats.sampled_misses * 100u / stats.sampled_lookups) << "% missed ("
+         << (stats.sampled_conflict_misses * 100u / stats.sampled_lookups) << "% conflicts) in "
+         << stats.sampled_lookups << " samples";
+      if (stats.promotions != 0u) {
+        os << " (promoted to a full array)";
+      }
+      separator = ", ";
+    }
+    os << "\n";
+  }
+}
+
+void DexCacheMissProfiler::Site::Reset() {
+  for (ArrayCounters& counters : arrays) {
+    counters.sampled_lookups.store(0u, std::memory_order_relaxed);
+    counters.sampled_misses.store(0u, std::memory_order_relaxed);
+    counters.sampled_conflict_misses.store(0u, std::memory_order_relaxed);
+    counters.window_lookups.store(0u, std::memory_order_relaxed);
+    counters.window_conflict_misses.store(0u, std::memory_order_relaxed);
+    counters.promotion_requested.store(false, std::memory_order_relaxed);
+    counters.promotions.store(0u, std::memory_order_relaxed);
+  }
+}
+
+void DexCacheMissProfiler::Reset() {
+  dex_files_.Reset();
+}
+
+}  // namespace art
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_DEX_CACHE_MISS_PROFILER_H_
+#define ART_RUNTIME_DEX_CACHE_MISS_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/sampled_site_table.h"
+
+namespace art {
+
+class DexFile;
+
+// The dex cache arrays that may be hashed pair arrays, see mirror::DexCache.
+enum class DexCacheArrayKind : uint8_t {
+  kStrings,
+  kTypes,
+  kMethods,
+  kFields,
+  kMethodTypes,
+  kLast = kMethodTypes,
+};
+
+static constexpr size_t kNumDexCacheArrayKinds = static_cast<size_t>(DexCacheArrayKind::kLast) + 1u;
+
+// The outcome of a lookup in a pair array.
+enum class DexCacheLookup : uint8_t {
+  kHit,
+  kMiss,          // The slot is empty.
+  kConflictMiss,  // The slot holds the entry of another index.
+};
+
+// Samples the lookups in the fixed size hashed pair arrays of the dex caches, per dex file and
+// per array, and decides when such an array thrashes enough to be replaced by a full array.
+// Dex caches with more ids than the pair array size keep only one entry per slot, so a large
+// dex file can keep missing in its dex cache and going through the ClassLinker slow paths.
+//
+// Each thread samples one in every sampling interval lookups in a pair array, with a thread
+// local countdown, so unsampled lookups do not touch shared memory. The conflict miss rate of an
+// array is evaluated over windows of kPromotionWindow samples; when a window reaches the promotion
+// miss rate, a promotion is requested and carried out by the next thread that resolves an entry of
+// that array, see mirror::DexCache::ShouldPromoteToFullArray(). Misses on empty slots do not
+// count towards promotions, since a full array would miss on them too.
+class DexCacheMissProfiler {
+ public:
+  // Sample one in every `sampling_interval` pair array lookups of each thread. A
+  // `promotion_miss_rate` of zero disables the promotions.
+  DexCacheMissProfiler(uint32_t sampling_interval, uint32_t promotion_miss_rate);
+
+  uint32_t GetSamplingInterval() const {
+    return sampling_interval_;
+  }
+
+  // Record a sampled lookup in the pair array of `kind` of the dex cache of `dex_file`.
+  void RecordLookup(const DexFile* dex_file, DexCacheArrayKind kind, DexCacheLookup lookup);
+
+  // Returns true if a promotion of the pair array of `kind` of `dex_file` was requested, and
+  // clears the request. The caller is expected to promote the array.
+  bool ConsumePromotionRequest(const DexFile* dex_file, DexCacheArrayKind kind);
+
+  struct ArrayStats {
+    uint64_t sampled_lookups;
+    uint64_t sampled_misses;
+    uint64_t sampled_conflict_misses;
+    uint32_t promotions;
+  };
+
+  struct DexFileStats {
+    std::string location;
+    std::array<ArrayStats, kNumDexCacheArrayKinds> arrays;
+
+    uint64_t SampledMisses() const;
+  };
+
+  // Return up to `n` published dex files, ordered by decreasing number of sampled misses.
+  std::vector<DexFileStats> GetTopDexFiles(size_t n) const;
+
+  // Print the miss rates of the top dex files, used for SIGQUIT.
+  void Dump(std::ostream& os, size_t n = kDefaultDumpedDexFiles) const;
+
+  // Clear all the recorded data. Not safe to call concurrently with RecordLookup().
+  void Reset();
+
+  static constexpr size_t kTableSize = 512;
+  static constexpr size_t kMaxProbes = 32;
+  static constexpr size_t kDefaultDumpedDexFiles = 10;
+  static constexpr uint32_t kDefaultPromotionMissRate = 25;  // In percent.
+  // Number of samples over which the miss rate of an array is evaluated.
+  static constexpr uint32_t kPromotionWindow = 256;
+  // Arrays with more ids than this are never promoted, to bound the memory cost.
+  static constexpr size_t kMaxPromotedArrayLength = 64 * 1024;
+
+ private:
+  struct ArrayCounters {
+    std::atomic<uint64_t> sampled_lookups{0u};
+    std::atomic<uint64_t> sampled_misses{0u};
+    std::atomic<uint64_t> sampled_conflict_misses{0u};
+    std::atomic<uint32_t> window_lookups{0u};
+    std::atomic<uint32_t> window_conflict_misses{0u};
+    std::atomic<bool> promotion_requested{false};
+    std::atomic<uint32_t> promotions{0u};
+  };
+
+  struct Site {
+    std::array<ArrayCounters, kNumDexCacheArrayKinds> arrays;
+    std::string location;
+
+    void Reset();
+  };
+
+  const uint32_t sampling_interval_;
+  const uint32_t promotion_miss_rate_;
+  SampledSiteTable<Site, kTableSize, kMaxProbes> dex_files_;
+
+  DISALLOW_COPY_AND_ASSIGN(DexCacheMissProfiler);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_DEX_CACHE_MISS_PROFILER_H_
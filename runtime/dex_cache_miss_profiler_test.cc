@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dex_cache_miss_profiler.h"
+
+#include <sstream>
+
+#include "common_runtime_test.h"
+#include "dex/dex_file.h"
+
+namespace art {
+
+class DexCacheMissProfilerTest : public CommonRuntimeTest {
+ protected:
+  // Record a window of samples for the types of `dex_file`, one in every `miss_period` being a
+  // `miss`.
+  static void RecordWindow(DexCacheMissProfiler* profiler,
+                           const DexFile* dex_file,
+                           size_t miss_period,
+                           DexCacheLookup miss = DexCacheLookup::kConflictMiss) {
+    for (size_t i = 0; i != DexCacheMissProfiler::kPromotionWindow; ++i) {
+      DexCacheLookup lookup = (i % miss_period != 0u) ? DexCacheLookup::kHit : miss;
+      profiler->RecordLookup(dex_file, DexCacheArrayKind::kTypes, lookup);
+    }
+  }
+};
+
+TEST_F(DexCacheMissProfilerTest, PromotionRequest) {
+  ASSERT_TRUE(java_lang_dex_file_ != nullptr);
+  DexCacheMissProfiler profiler(/*sampling_interval=*/ 1u, /*promotion_miss_rate=*/ 50u);
+  EXPECT_FALSE(profiler.ConsumePromotionRequest(java_lang_dex_file_, DexCacheArrayKind::kTypes));
+
+  // 25% of misses is below the promotion miss rate.
+  RecordWindow(&profiler, java_lang_dex_file_, /*miss_period=*/ 4u);
+  EXPECT_FALSE(profiler.ConsumePromotionRequest(java_lang_dex_file_, DexCacheArrayKind::kTypes));
+
+  RecordWindow(&profiler, java_lang_dex_file_, /*miss_period=*/ 2u);
+  EXPECT_FALSE(profiler.ConsumePromotionRequest(java_lang_dex_file_, DexCacheArrayKind::kMethods));
+  EXPECT_TRUE(profiler.ConsumePromotionRequest(java_lang_dex_file_, DexCacheArrayKind::kTypes));
+  // The request is consumed.
+  EXPECT_FALSE(profiler.ConsumePromotionRequest(java_lang_dex_file_, DexCacheArrayKind::kTypes));
+
+  std::vector<DexCacheMissProfiler::DexFileStats> dex_files = profiler.GetTopDexFiles(10);
+  ASSERT_EQ(1u, dex_files.size());
+  EXPECT_EQ(java_lang_dex_file_->GetLocation(), dex_files[0].location);
+  const DexCacheMissProfiler::ArrayStats& types =
+      dex_files[0].arrays[static_cast<size_t>(DexCacheArrayKind::kTypes)];
+  EXPECT_EQ(2u * DexCacheMissProfiler::kPromotionWindow, types.sampled_lookups);
+  EXPECT_EQ(192u, types.sampled_misses);
+  EXPECT_EQ(192u, types.sampled_conflict_misses);
+  EXPECT_EQ(1u, types.promotions);
+  EXPECT_EQ(192u, dex_files[0].SampledMisses());
+
+  std::ostringstream oss;
+  profiler.Dump(oss);
+  EXPECT_NE(std::string::npos, oss.str().find(java_lang_dex_file_->GetLocation()));
+  EXPECT_NE(std::string::npos,
+            oss.str().find("types 37% missed (37% conflicts) in 512 samples"
+                           " (promoted to a full array)"));
+}
+
+TEST_F(DexCacheMissProfilerTest, NoPromotionForMissesOnEmptySlots) {
+  ASSERT_TRUE(java_lang_dex_file_ != nullptr);
+  DexCacheMissProfiler profiler(/*sampling_interval=*/ 1u, /*promotion_miss_rate=*/ 50u);
+  // Filling the pair array misses on empty slots, which a full array would miss on too.
+  RecordWindow(&profiler, java_lang_dex_file_, /*miss_period=*/ 1u, DexCacheLookup::kMiss);
+  EXPECT_FALSE(profiler.ConsumePromotionRequest(java_lang_dex_file_, DexCacheArrayKind::kTypes));
+
+  std::vector<DexCacheMissProfiler::DexFileStats> dex_files = profiler.GetTopDexFiles(1);
+  ASSERT_EQ(1u, dex_files.size());
+  const DexCacheMissProfiler::ArrayStats& types =
+      dex_files[0].arrays[static_cast<size_t>(DexCacheArrayKind::kTypes)];
+  EXPECT_EQ(DexCacheMissProfiler::kPromotionWindow, types.sampled_misses);
+  EXPECT_EQ(0u, types.sampled_conflict_misses);
+}
+
+TEST_F(DexCacheMissProfilerTest, PromotionDisabled) {
+  ASSERT_TRUE(java_lang_dex_file_ != nullptr);
+  DexCacheMissProfiler profiler(/*sampling_interval=*/ 1u, /*promotion_miss_rate=*/ 0u);
+  RecordWindow(&profiler, java_lang_dex_file_, /*miss_period=*/ 1u);
+  EXPECT_FALSE(profiler.ConsumePromotionRequest(java_lang_dex_file_, DexCacheArrayKind::kTypes));
+  EXPECT_EQ(DexCacheMissProfiler::kPromotionWindow, profiler.GetTopDexFiles(1)[0].SampledMisses());
+}
+
+}  // namespace art
@@ -148,6 +148,9 @@ class GarbageCollector : public RootVisitor, public IsMarkedVisitor, public Mark
   virtual void RunPhases() = 0;
   // Revoke all the thread-local buffers.
   virtual void RevokeAllThreadLocalBuffers() = 0;
+  // Point the metrics below at either the young or the full GC metrics and
+  // mark them as initialized.
+  void InitializeGcMetrics(bool young_gen);
 
   static constexpr size_t kPauseBucketSize = 500;
   static constexpr size_t kPauseBucketCount = 32;
@@ -20,13 +20,27 @@
 #include "gc/space/bump_pointer_space.h"
 #include "mark_compact.h"
 #include "mirror/object-inl.h"
+#include "thread-current-inl.h"
 
 namespace art {
 namespace gc {
 namespace collector {
 
+template <bool kParallel>
 inline void MarkCompact::UpdateClassAfterObjectMap(mirror::Object* obj) {
   mirror::Class* klass = obj->GetClass<kVerifyNone, kWithoutReadBarrier>();
+  if (kParallel) {
+    // Filter out the common case without consulting walk_super_class_cache_,
+    // which, like the maps, is only accessed with lock_ held by the workers.
+    if (LIKELY(
+            !(std::less<mirror::Object*>{}(obj, klass) && bump_pointer_space_->HasAddress(klass)) &&
+            klass->GetReferenceInstanceOffsets<kVerifyNone>() != mirror::Class::kClassWalkSuper)) {
+      return;
+    }
+    MutexLock mu(Thread::Current(), lock_);
+    UpdateClassAfterObjectMap</*kParallel=*/false>(obj);
+    return;
+  }
   // Track a class if it needs walking super-classes for visiting references or
   // if it's higher in address order than its objects and is in moving space.
   if (UNLIKELY(
@@ -65,7 +79,7 @@ inline void MarkCompact::UpdateClassAfterObjectMap(mirror::Object* obj) {
   }
 }
 
-template <size_t kAlignment>
+template <size_t kAlignment> template <bool kAtomic>
 inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_t begin,
                                                                         size_t size) {
   const uintptr_t begin_bit_idx = MemRangeBitmap::BitIndexFromAddr(begin);
@@ -79,8 +93,16 @@ inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_
   uintptr_t mask = Bitmap::BitIndexToMask(begin_bit_idx);
   // Bits that needs to be set in the first word, if it's not also the last word
   mask = ~(mask - 1);
+  // Only the first and the last words may be shared with other objects.
+  auto set_bits = [](uintptr_t* word, uintptr_t bits) {
+    if (kAtomic) {
+      reinterpret_cast<Atomic<uintptr_t>*>(word)->fetch_or(bits, std::memory_order_relaxed);
+    } else {
+      *word |= bits;
+    }
+  };
   if (diff > 0) {
-    *begin_bm_address |= mask;
+    set_bits(begin_bm_address, mask);
     mask = ~0;
     // Even though memset can handle the (diff == 1) case but we should avoid the
     // overhead of a function call for this, highly likely (as most of the objects
@@ -91,7 +113,7 @@ inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_
     }
   }
   uintptr_t end_mask = Bitmap::BitIndexToMask(end_bit_idx);
-  *end_bm_address |= mask & (end_mask | (end_mask - 1));
+  set_bits(end_bm_address, mask & (end_mask | (end_mask - 1)));
   return begin_bit_idx;
 }
 
@@ -52,6 +52,7 @@
 #include "jit/jit_code_cache.h"
 #include "mark_compact-inl.h"
 #include "mirror/object-refvisitor-inl.h"
+#include "monitor.h"
 #include "read_barrier_config.h"
 #include "scoped_thread_state_change-inl.h"
 #include "sigchain.h"
@@ -285,6 +286,11 @@ static constexpr bool kCheckLocks = kDebugLocking;
 static constexpr bool kVerifyRootsMarked = kIsDebugBuild;
 // Two threads should suffice on devices.
 static constexpr size_t kMaxNumUffdWorkers = 2;
+// Minimum mark-stack size for it to be worth processing with multiple threads.
+static constexpr size_t kMinParallelMarkStackSize = 128;
+// Minimum number of moving-space pages for it to be worth compacting them with
+// multiple threads.
+static constexpr size_t kMinParallelCompactionPages = 256;
 // Number of compaction buffers reserved for mutator threads in SIGBUS feature
 // case. It's extremely unlikely that we will ever have more than these number
 // of mutator threads trying to access the moving-space during one compaction
@@ -372,13 +378,22 @@ MarkCompact::MarkCompact(Heap* heap)
       lock_("mark compact lock", kGenericBottomLock),
       bump_pointer_space_(heap->GetBumpPointerSpace()),
       moving_space_bitmap_(bump_pointer_space_->GetMarkBitmap()),
+      old_gen_end_(nullptr),
+      next_old_gen_end_(nullptr),
+      old_gen_objects_(0),
       moving_to_space_fd_(kFdUnused),
       moving_from_space_fd_(kFdUnused),
       uffd_(kFdUnused),
       sigbus_in_progress_count_(kSigbusCounterCompactionDoneMask),
       compaction_in_progress_count_(0),
+      helper_compaction_page_idx_(0),
       thread_pool_counter_(0),
       compacting_(false),
+      use_generational_(heap->GetUseGenerationalCMC()),
+      young_gen_(false),
+      full_gc_freed_bytes_(0),
+      full_gc_time_ns_(0),
+      full_gc_iterations_(0),
       uffd_initialized_(false),
       uffd_minor_fault_supported_(false),
       use_uffd_sigbus_(IsSigbusFeatureAvailable()),
@@ -498,21 +513,9 @@ MarkCompact::MarkCompact(Heap* heap)
 
   // Initialize GC metrics.
   metrics::ArtMetrics* metrics = GetMetrics();
-  // The mark-compact collector supports only full-heap collections at the moment.
-  gc_time_histogram_ = metrics->FullGcCollectionTime();
-  metrics_gc_count_ = metrics->FullGcCount();
-  metrics_gc_count_delta_ = metrics->FullGcCountDelta();
-  gc_throughput_histogram_ = metrics->FullGcThroughput();
-  gc_tracing_throughput_hist_ = metrics->FullGcTracingThroughput();
-  gc_throughput_avg_ = metrics->FullGcThroughputAvg();
-  gc_tracing_throughput_avg_ = metrics->FullGcTracingThroughputAvg();
-  gc_scanned_bytes_ = metrics->FullGcScannedBytes();
-  gc_scanned_bytes_delta_ = metrics->FullGcScannedBytesDelta();
-  gc_freed_bytes_ = metrics->FullGcFreedBytes();
-  gc_freed_bytes_delta_ = metrics->FullGcFreedBytesDelta();
-  gc_duration_ = metrics->FullGcDuration();
-  gc_duration_delta_ = metrics->FullGcDurationDelta();
-  are_metrics_initialized_ = true;
+  // In generational mode InitializePhase() switches to the young GC metrics for
+  // the young collections. The first collection is always a full one.
+  InitializeGcMetrics(/*young_gen=*/ false);
 }
 
 void MarkCompact::AddLinearAllocSpaceData(uint8_t* begin, size_t len) {
@@ -594,18 +597,45 @@ void MarkCompact::BindAndResetBitmaps() {
     } else {
       CHECK(!space->IsZygoteSpace());
       CHECK(!space->IsImageSpace());
+      uint8_t* clear_begin = space->Begin();
+      if (young_gen_) {
+        // In a young collection the old generation, i.e. the non-moving space
+        // and the beginning of the moving space, is treated as marked and isn't
+        // traversed. Its dirty cards are the only record of references into the
+        // young generation. So age them to be scanned in MarkReachableObjects().
+        // The cards left aged by a previous cycle don't refer to any young
+        // object anymore, as everything it marked got promoted. Clear them.
+        clear_begin = space == bump_pointer_space_
+                      ? AlignUp(old_gen_end_, accounting::CardTable::kCardSize)
+                      : space->Limit();
+        card_table->ModifyCardsAtomic(space->Begin(),
+                                      clear_begin,
+                                      AgeCardVisitor(),
+                                      /* card modified visitor */ VoidFunctor());
+      }
       // The card-table corresponding to bump-pointer and non-moving space can
       // be cleared, because we are going to traverse all the reachable objects
       // in these spaces. This card-table will eventually be used to track
       // mutations while concurrent marking is going on.
-      card_table->ClearCardRange(space->Begin(), space->Limit());
+      card_table->ClearCardRange(clear_begin, space->Limit());
       if (space != bump_pointer_space_) {
         CHECK_EQ(space, heap_->GetNonMovingSpace());
         non_moving_space_ = space;
+        if (young_gen_) {
+          // Binding the bitmaps makes all the objects which survived the
+          // previous GC marked, and keeps the space from being swept.
+          space->AsContinuousMemMapAllocSpace()->BindLiveToMarkBitmap();
+        }
         non_moving_space_bitmap_ = space->GetMarkBitmap();
       }
     }
   }
+  if (young_gen_) {
+    for (const auto& space : GetHeap()->GetDiscontinuousSpaces()) {
+      CHECK(space->IsLargeObjectSpace());
+      space->AsLargeObjectSpace()->CopyLiveToMarked();
+    }
+  }
 }
 
 void MarkCompact::MarkZygoteLargeObjects() {
@@ -645,6 +675,14 @@ void MarkCompact::InitializePhase() {
   from_space_slide_diff_ = from_space_begin_ - bump_pointer_space_->Begin();
   black_allocations_begin_ = bump_pointer_space_->Limit();
   walk_super_class_cache_ = nullptr;
+  // A young collection needs the old generation retained by the previous cycle.
+  young_gen_ = young_gen_ && old_gen_end_ != nullptr;
+  if (!young_gen_ && old_gen_end_ != nullptr) {
+    // Drop the old generation's mark-bits as everything is traversed again.
+    moving_space_bitmap_->Clear();
+    old_gen_end_ = nullptr;
+  }
+  InitializeGcMetrics(young_gen_);
   // TODO: Would it suffice to read it once in the constructor, which is called
   // in zygote process?
   pointer_size_ = Runtime::Current()->GetClassLinker()->GetImagePointerSize();
@@ -736,6 +774,17 @@ void MarkCompact::RunPhases() {
   FinishPhase();
   thread_running_gc_ = nullptr;
   GetHeap()->PostGcVerification(this);
+  if (!young_gen_) {
+    const Iteration* iteration = GetCurrentIteration();
+    full_gc_freed_bytes_ += iteration->GetFreedBytes() + iteration->GetFreedLargeObjectBytes();
+    full_gc_time_ns_ += GetTimings()->GetTotalNs();
+    ++full_gc_iterations_;
+  }
+}
+
+uint64_t MarkCompact::GetEstimatedFullGcMeanThroughput() const {
+  // Add 1ms to prevent possible division by 0.
+  return (full_gc_freed_bytes_ * 1000) / (NsToMs(full_gc_time_ns_) + 1);
 }
 
 void MarkCompact::InitMovingSpaceFirstObjects(const size_t vec_len) {
@@ -919,10 +968,37 @@ class MarkCompact::ConcurrentCompactionGcTask : public SelfDeletingTask {
   size_t index_;
 };
 
+class MarkCompact::CompactionHelperTask : public SelfDeletingTask {
+ public:
+  explicit CompactionHelperTask(MarkCompact* collector) : collector_(collector) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) override REQUIRES_SHARED(Locks::mutator_lock_) {
+    size_t nr_moving_space_used_pages =
+        collector_->moving_first_objs_count_ + collector_->black_page_count_;
+    if (collector_->CanCompactMovingSpaceWithMinorFault()) {
+      collector_->HelpCompactMovingSpace<MarkCompact::kMinorFaultMode>(nr_moving_space_used_pages);
+    } else {
+      collector_->HelpCompactMovingSpace<MarkCompact::kCopyMode>(nr_moving_space_used_pages);
+    }
+  }
+
+ private:
+  MarkCompact* const collector_;
+};
+
 void MarkCompact::PrepareForCompaction() {
   uint8_t* space_begin = bump_pointer_space_->Begin();
   size_t vector_len = (black_allocations_begin_ - space_begin) / kOffsetChunkSize;
   DCHECK_LE(vector_len, vector_length_);
+  if (young_gen_ && old_gen_end_ > space_begin) {
+    // The old generation was compacted densely by the previous GC and isn't
+    // traversed in a young GC. So account all of it as live.
+    size_t old_gen_size = old_gen_end_ - space_begin;
+    live_words_bitmap_->SetLiveWords(reinterpret_cast<uintptr_t>(space_begin), old_gen_size);
+    size_t full_chunks = old_gen_size / kOffsetChunkSize;
+    std::fill_n(chunk_info_vec_, full_chunks, kOffsetChunkSize);
+    chunk_info_vec_[full_chunks] += old_gen_size % kOffsetChunkSize;
+  }
   for (size_t i = 0; i < vector_len; i++) {
     DCHECK_LE(chunk_info_vec_[i], kOffsetChunkSize);
     DCHECK_EQ(chunk_info_vec_[i], live_words_bitmap_->LiveBytesInBitmapWord(i));
@@ -971,6 +1047,8 @@ void MarkCompact::PrepareForCompaction() {
     DCHECK_EQ(chunk_info_vec_[i], 0u);
   }
   post_compact_end_ = AlignUp(space_begin + total, kPageSize);
+  // Everything marked in this GC gets promoted. Black allocations stay young.
+  next_old_gen_end_ = space_begin + total;
   CHECK_EQ(post_compact_end_, space_begin + moving_first_objs_count_ * kPageSize);
   black_objs_slide_diff_ = black_allocations_begin_ - post_compact_end_;
   // How do we handle compaction of heap portion used for allocations after the
@@ -1017,7 +1095,10 @@ void MarkCompact::PrepareForCompaction() {
         heap_->CreateThreadPool(std::min(heap_->GetParallelGCThreadCount(), kMaxNumUffdWorkers));
         pool = heap_->GetThreadPool();
       }
-      size_t num_threads = pool->GetThreadCount();
+      // The pool may be bigger than required if created for parallel marking.
+      size_t num_threads = std::min({pool->GetThreadCount(),
+                                     heap_->GetParallelGCThreadCount(),
+                                     kMaxNumUffdWorkers});
       thread_pool_counter_ = num_threads;
       for (size_t i = 0; i < num_threads; i++) {
         pool->AddTask(thread_running_gc_, new ConcurrentCompactionGcTask(this, i + 1));
@@ -1234,6 +1315,15 @@ void MarkCompact::MarkingPause() {
   TimingLogger::ScopedTiming t("(Paused)MarkingPause", GetTimings());
   Runtime* runtime = Runtime::Current();
   Locks::mutator_lock_->AssertExclusiveHeld(thread_running_gc_);
+  {
+    // The mutators are suspended anyway, deflate the monitors nobody acquired since the
+    // previous GC. Objects don't move before the compaction pause, so their lock words can be
+    // updated in place.
+    TimingLogger::ScopedTiming t2("(Paused)DeflateIdleMonitors", GetTimings());
+    size_t count = runtime->GetMonitorList()->DeflateMonitors(/*only_idle=*/ true);
+    MonitorList::StartIdleInterval();
+    VLOG(heap) << "Deflated " << count << " idle monitors";
+  }
   {
     // Handle the dirty objects as we are a concurrent GC
     WriterMutexLock mu(thread_running_gc_, *Locks::heap_bitmap_lock_);
@@ -1254,6 +1344,10 @@ void MarkCompact::MarkingPause() {
     // Fetch only the accumulated objects-allocated count as it is guaranteed to
     // be up-to-date after the TLAB revocation above.
     freed_objects_ += bump_pointer_space_->GetAccumulatedObjectsAllocated();
+    if (young_gen_) {
+      // Old generation objects are implicitly live and never discovered.
+      freed_objects_ -= old_gen_objects_;
+    }
     // Capture 'end' of moving-space at this point. Every allocation beyond this
     // point will be considered as black.
     // Align-up to page boundary so that black allocations happen from next page
@@ -1317,6 +1411,9 @@ void MarkCompact::Sweep(bool swap_bitmaps) {
     // Mark everything allocated since the last GC as live so that we can sweep
     // concurrently, knowing that new allocations won't be marked as live.
     accounting::ObjectStack* live_stack = heap_->GetLiveStack();
+    if (use_generational_) {
+      SweepAllocStack(live_stack);
+    }
     heap_->MarkAllocStackAsLive(live_stack);
     live_stack->Reset();
     DCHECK(mark_stack_->IsEmpty());
@@ -1333,6 +1430,44 @@ void MarkCompact::Sweep(bool swap_bitmaps) {
   SweepLargeObjects(swap_bitmaps);
 }
 
+void MarkCompact::SweepAllocStack(accounting::ObjectStack* stack) {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  DCHECK(use_generational_);
+  // The objects allocated in the non-moving and large-object spaces since the
+  // last GC are not in the live bitmaps yet. The unreachable ones must be freed
+  // here, instead of being marked live below, as they may refer to young
+  // objects which are reclaimed in this cycle and would otherwise be visited
+  // while scanning the old generation's cards in a subsequent young GC.
+  space::LargeObjectSpace* los = heap_->GetLargeObjectsSpace();
+  accounting::LargeObjectBitmap* los_bitmap = los != nullptr ? los->GetMarkBitmap() : nullptr;
+  std::vector<mirror::Object*> dead_objects;
+  ObjectBytePair freed_los;
+  StackReference<mirror::Object>* out = stack->Begin();
+  for (StackReference<mirror::Object>* it = stack->Begin(); it != stack->End(); ++it) {
+    mirror::Object* obj = it->AsMirrorPtr();
+    if (obj != nullptr && non_moving_space_bitmap_->HasAddress(obj)) {
+      if (!non_moving_space_bitmap_->Test(obj)) {
+        dead_objects.push_back(obj);
+        continue;
+      }
+    } else if (obj != nullptr && los_bitmap != nullptr && los_bitmap->HasAddress(obj)) {
+      if (!los_bitmap->Test(obj)) {
+        ++freed_los.objects;
+        freed_los.bytes += los->Free(thread_running_gc_, obj);
+        continue;
+      }
+    }
+    *out++ = *it;
+  }
+  stack->PopBackCount(static_cast<int32_t>(stack->End() - out));
+  if (!dead_objects.empty()) {
+    size_t freed_bytes = non_moving_space_->AsMallocSpace()->FreeList(
+        thread_running_gc_, dead_objects.size(), dead_objects.data());
+    RecordFree(ObjectBytePair(dead_objects.size(), freed_bytes));
+  }
+  RecordFreeLOS(freed_los);
+}
+
 void MarkCompact::SweepLargeObjects(bool swap_bitmaps) {
   space::LargeObjectSpace* los = heap_->GetLargeObjectsSpace();
   if (los != nullptr) {
@@ -2136,6 +2271,12 @@ void MarkCompact::FreeFromSpacePages(size_t cur_page_idx, int mode) {
     // lower than the reclaim range.
     break;
   }
+  if (young_gen_) {
+    // Old generation objects weren't visited during marking, so their classes
+    // aren't in 'class_after_obj_map_'. Retain the old generation's from-space
+    // pages until the compaction is finished.
+    reclaim_begin = std::max(reclaim_begin, AlignUp(old_gen_end_, kPageSize));
+  }
 
   ssize_t size = last_reclaimed_page_ - reclaim_begin;
   if (size >= kMinFromSpaceMadviseSize) {
@@ -2685,6 +2826,9 @@ void MarkCompact::CompactionPause() {
     // TODO: We can reduce the time spent on this in a pause by performing one
     // round of this concurrently prior to the pause.
     UpdateMovingSpaceBlackAllocations();
+    if (use_generational_) {
+      UpdateMovingSpaceCards();
+    }
     // TODO: If we want to avoid this allocation in a pause then we will have to
     // allocate an array for the entire moving-space size, which can be made
     // part of info_map_.
@@ -3252,6 +3396,26 @@ void MarkCompact::ConcurrentlyProcessMovingPage(uint8_t* fault_page,
   }
 }
 
+template <int kMode>
+void MarkCompact::HelpCompactMovingSpace(size_t nr_moving_space_used_pages) {
+  Thread* self = Thread::Current();
+  for (size_t idx = helper_compaction_page_idx_.fetch_add(1, std::memory_order_relaxed);
+       idx < nr_moving_space_used_pages;
+       idx = helper_compaction_page_idx_.fetch_add(1, std::memory_order_relaxed)) {
+    // Like the gc-thread, leave the unused pages alone. Also skip pages which
+    // are already claimed to avoid waiting for them to be mapped.
+    if (first_objs_moving_space_[idx].IsNull() ||
+        moving_pages_status_[idx].load(std::memory_order_relaxed) != PageState::kUnprocessed) {
+      continue;
+    }
+    // In copy-mode the buffer is claimed, and then cached, on the first call.
+    ConcurrentlyProcessMovingPage<kMode>(bump_pointer_space_->Begin() + idx * kPageSize,
+                                         kMode == kCopyMode ? self->GetThreadLocalGcBuffer()
+                                                            : nullptr,
+                                         nr_moving_space_used_pages);
+  }
+}
+
 void MarkCompact::MapUpdatedLinearAllocPage(uint8_t* page,
                                             uint8_t* shadow_page,
                                             Atomic<PageState>& state,
@@ -3514,12 +3678,39 @@ void MarkCompact::CompactionPhase() {
     RecordFree(ObjectBytePair(freed_objects_, freed_bytes));
   }
 
+  // With the SIGBUS feature the thread-pool isn't needed for handling
+  // userfaults. Use it instead to compact the moving space from the other end.
+  size_t num_helpers = 0;
+  if (use_uffd_sigbus_ &&
+      moving_first_objs_count_ + black_page_count_ >= kMinParallelCompactionPages) {
+    MaybeCreateThreadPool();
+    num_helpers = GetThreadCount(/*paused=*/false) - 1;
+  }
+  ThreadPool* pool = heap_->GetThreadPool();
+  if (num_helpers > 0) {
+    helper_compaction_page_idx_.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < num_helpers; i++) {
+      pool->AddTask(thread_running_gc_, new CompactionHelperTask(this));
+    }
+    pool->SetMaxActiveWorkers(num_helpers);
+    pool->StartWorkers(thread_running_gc_);
+  }
+
   if (CanCompactMovingSpaceWithMinorFault()) {
     CompactMovingSpace<kMinorFaultMode>(/*page=*/nullptr);
   } else {
     CompactMovingSpace<kCopyMode>(compaction_buffers_map_.Begin());
   }
 
+  if (num_helpers > 0) {
+    // All the pages are claimed by now. Stop the helpers from looking for more.
+    helper_compaction_page_idx_.store(moving_first_objs_count_ + black_page_count_,
+                                      std::memory_order_relaxed);
+    pool->Wait(thread_running_gc_, /*do_work=*/false, /*may_hold_locks=*/true);
+    pool->StopWorkers(thread_running_gc_);
+    pool->SetMaxActiveWorkers(pool->GetThreadCount());
+  }
+
   // Make sure no mutator is reading from the from-space before unregistering
   // userfaultfd from moving-space and then zapping from-space. The mutator
   // and GC may race to set a page state to processing or further along. The two
@@ -3801,8 +3992,27 @@ void MarkCompact::UpdateAndMarkModUnion() {
   }
 }
 
+void MarkCompact::ScanOldGenCards() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  ScanObjectVisitor visitor(this);
+  card_table->Scan</*kClearCard*/ false>(moving_space_bitmap_,
+                                         bump_pointer_space_->Begin(),
+                                         AlignUp(old_gen_end_, accounting::CardTable::kCardSize),
+                                         visitor,
+                                         accounting::CardTable::kCardAged);
+  card_table->Scan</*kClearCard*/ false>(non_moving_space_bitmap_,
+                                         non_moving_space_->Begin(),
+                                         non_moving_space_->End(),
+                                         visitor,
+                                         accounting::CardTable::kCardAged);
+}
+
 void MarkCompact::MarkReachableObjects() {
   UpdateAndMarkModUnion();
+  if (young_gen_) {
+    ScanOldGenCards();
+  }
   // Recursively mark all the non-image bits set in the mark bitmap.
   ProcessMarkStack();
 }
@@ -3852,7 +4062,10 @@ void MarkCompact::ScanDirtyObjects(bool paused, uint8_t minimum_age) {
     const bool is_immune_space = space->IsZygoteSpace() || space->IsImageSpace();
     if (paused) {
       DCHECK_EQ(minimum_age, gc::accounting::CardTable::kCardDirty);
-      // We can clear the card-table for any non-immune space.
+      // We can clear the card-table for any non-immune space. This holds in
+      // generational mode as well: every object referred from these cards gets
+      // marked, and thereby promoted, in this cycle. Only the cards dirtied
+      // after this pause may refer to black allocations, which remain young.
       if (is_immune_space) {
         card_table->Scan</*kClearCard*/false>(space->GetMarkBitmap(),
                                               space->Begin(),
@@ -4017,26 +4230,38 @@ size_t MarkCompact::LiveWordsBitmap<kAlignment>::LiveBytesInBitmapWord(size_t ch
   return words * kAlignment;
 }
 
+template <bool kParallel>
 void MarkCompact::UpdateLivenessInfo(mirror::Object* obj, size_t obj_size) {
   DCHECK(obj != nullptr);
   DCHECK_EQ(obj_size, obj->SizeOf<kDefaultVerifyFlags>());
   uintptr_t obj_begin = reinterpret_cast<uintptr_t>(obj);
-  UpdateClassAfterObjectMap(obj);
+  UpdateClassAfterObjectMap<kParallel>(obj);
   size_t size = RoundUp(obj_size, kAlignment);
-  uintptr_t bit_index = live_words_bitmap_->SetLiveWords(obj_begin, size);
+  uintptr_t bit_index = live_words_bitmap_->SetLiveWords<kParallel>(obj_begin, size);
   size_t chunk_idx = (obj_begin - live_words_bitmap_->Begin()) / kOffsetChunkSize;
   // Compute the bit-index within the chunk-info vector word.
   bit_index %= kBitsPerVectorWord;
   size_t first_chunk_portion = std::min(size, (kBitsPerVectorWord - bit_index) * kAlignment);
+  // The first and the last chunks may be shared with other objects.
+  auto add_to_chunk = [this](size_t idx, size_t bytes) {
+    if (kParallel) {
+      reinterpret_cast<Atomic<uint32_t>*>(&chunk_info_vec_[idx])
+          ->fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+      chunk_info_vec_[idx] += bytes;
+    }
+  };
 
-  chunk_info_vec_[chunk_idx++] += first_chunk_portion;
+  add_to_chunk(chunk_idx++, first_chunk_portion);
   DCHECK_LE(first_chunk_portion, size);
   for (size -= first_chunk_portion; size > kOffsetChunkSize; size -= kOffsetChunkSize) {
     DCHECK_EQ(chunk_info_vec_[chunk_idx], 0u);
     chunk_info_vec_[chunk_idx++] = kOffsetChunkSize;
   }
-  chunk_info_vec_[chunk_idx] += size;
-  freed_objects_--;
+  add_to_chunk(chunk_idx, size);
+  if (!kParallel) {
+    freed_objects_--;
+  }
 }
 
 template <bool kUpdateLiveWords>
@@ -4055,9 +4280,179 @@ void MarkCompact::ScanObject(mirror::Object* obj) {
   obj->VisitReferences(visitor, visitor);
 }
 
+// Holds a portion of the mark-stack for processing by a thread-pool worker (or
+// the gc-thread) during parallel marking. Whenever the local stack overflows,
+// half of it is handed over to the thread-pool as a new task, which any idle
+// thread can then pick up.
+class MarkCompact::MarkStackTask : public Task {
+ public:
+  static constexpr size_t kMaxSize = 1 * KB;
+
+  MarkStackTask(ThreadPool* thread_pool,
+                MarkCompact* mark_compact,
+                size_t mark_stack_size,
+                StackReference<mirror::Object>* mark_stack)
+      : mark_compact_(mark_compact), thread_pool_(thread_pool), mark_stack_pos_(mark_stack_size) {
+    DCHECK_LE(mark_stack_size, kMaxSize);
+    std::copy(mark_stack, mark_stack + mark_stack_size, mark_stack_);
+  }
+
+  ~MarkStackTask() {
+    DCHECK_EQ(mark_stack_pos_, 0u);
+  }
+
+  // The gc-thread holds the heap-bitmap and mutator locks on behalf of the
+  // workers for the duration of parallel marking.
+  void Run(Thread* self) override
+      REQUIRES(Locks::heap_bitmap_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    RefFieldsVisitor visitor(this);
+    uint64_t bytes_scanned = 0;
+    int32_t live_objects = 0;
+    while (mark_stack_pos_ > 0) {
+      mirror::Object* obj = mark_stack_[--mark_stack_pos_].AsMirrorPtr();
+      DCHECK(obj != nullptr);
+      DCHECK(mark_compact_->IsMarked(obj)) << "Scanning unmarked object " << obj;
+      size_t obj_size = obj->SizeOf<kDefaultVerifyFlags>();
+      bytes_scanned += obj_size;
+      if (mark_compact_->moving_space_bitmap_->HasAddress(obj)) {
+        mark_compact_->UpdateLivenessInfo</*kParallel=*/true>(obj, obj_size);
+        live_objects++;
+      }
+      obj->VisitReferences(visitor, visitor);
+    }
+    MutexLock mu(self, mark_compact_->lock_);
+    mark_compact_->bytes_scanned_ += bytes_scanned;
+    mark_compact_->freed_objects_ -= live_objects;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  class RefFieldsVisitor {
+   public:
+    ALWAYS_INLINE explicit RefFieldsVisitor(MarkStackTask* task) : task_(task) {}
+
+    ALWAYS_INLINE void operator()(mirror::Object* obj,
+                                  MemberOffset offset,
+                                  bool is_static ATTRIBUTE_UNUSED) const
+        REQUIRES(Locks::heap_bitmap_lock_)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      Mark(obj->GetFieldObject<mirror::Object>(offset), obj, offset);
+    }
+
+    void operator()(ObjPtr<mirror::Class> klass, ObjPtr<mirror::Reference> ref) const
+        REQUIRES(Locks::heap_bitmap_lock_)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      task_->mark_compact_->DelayReferenceReferent(klass, ref);
+    }
+
+    void VisitRootIfNonNull(mirror::CompressedReference<mirror::Object>* root) const
+        REQUIRES(Locks::heap_bitmap_lock_)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      if (!root->IsNull()) {
+        VisitRoot(root);
+      }
+    }
+
+    void VisitRoot(mirror::CompressedReference<mirror::Object>* root) const
+        REQUIRES(Locks::heap_bitmap_lock_)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      Mark(root->AsMirrorPtr(), nullptr, MemberOffset(0));
+    }
+
+   private:
+    ALWAYS_INLINE void Mark(mirror::Object* ref, mirror::Object* holder, MemberOffset offset) const
+        REQUIRES(Locks::heap_bitmap_lock_)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      if (ref != nullptr &&
+          task_->mark_compact_->MarkObjectNonNullNoPush</*kParallel*/true>(ref, holder, offset)) {
+        task_->Push(ref);
+      }
+    }
+
+    MarkStackTask* const task_;
+  };
+
+  void Push(mirror::Object* obj) {
+    if (UNLIKELY(mark_stack_pos_ == kMaxSize)) {
+      // Give away the older half of the stack so that others can steal it.
+      mark_stack_pos_ /= 2;
+      thread_pool_->AddTask(Thread::Current(),
+                            new MarkStackTask(thread_pool_,
+                                              mark_compact_,
+                                              kMaxSize - mark_stack_pos_,
+                                              mark_stack_ + mark_stack_pos_));
+    }
+    mark_stack_[mark_stack_pos_++].Assign(obj);
+  }
+
+  MarkCompact* const mark_compact_;
+  ThreadPool* const thread_pool_;
+  StackReference<mirror::Object> mark_stack_[kMaxSize];
+  size_t mark_stack_pos_;
+};
+
+void MarkCompact::MaybeCreateThreadPool() {
+  // The heap's thread-pool is shared by parallel marking, compaction helpers
+  // (SIGBUS feature) and uffd workers. It's created only once a GC has enough
+  // work for the former two, so that small processes don't pay for the threads.
+  // Zygote creates it only for uffd workers, see PrepareForCompaction(), so that
+  // it doesn't have to be torn down before fork.
+  Runtime* runtime = Runtime::Current();
+  if (heap_->GetThreadPool() == nullptr &&
+      !runtime->IsZygote() &&
+      runtime->InJankPerceptibleProcessState()) {
+    heap_->CreateThreadPool();
+  }
+}
+
+size_t MarkCompact::GetThreadCount(bool paused) const {
+  // Leave the CPUs to the foreground apps when in background.
+  ThreadPool* pool = heap_->GetThreadPool();
+  if (pool == nullptr || !Runtime::Current()->InJankPerceptibleProcessState()) {
+    return 1;
+  }
+  size_t count = paused ? heap_->GetParallelGCThreadCount() : heap_->GetConcGCThreadCount();
+  return std::min(count, pool->GetThreadCount()) + 1;
+}
+
+void MarkCompact::ProcessMarkStackParallel(size_t thread_count) {
+  Thread* self = Thread::Current();
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  const size_t chunk_size =
+      std::min(mark_stack_->Size() / thread_count + 1, MarkStackTask::kMaxSize);
+  for (auto* it = mark_stack_->Begin(), *end = mark_stack_->End(); it < end;) {
+    const size_t delta = std::min(static_cast<size_t>(end - it), chunk_size);
+    thread_pool->AddTask(self, new MarkStackTask(thread_pool, this, delta, it));
+    it += delta;
+  }
+  mark_stack_->Reset();
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /*do_work=*/true, /*may_hold_locks=*/true);
+  thread_pool->StopWorkers(self);
+  thread_pool->SetMaxActiveWorkers(thread_pool->GetThreadCount());
+}
+
 // Scan anything that's on the mark stack.
 void MarkCompact::ProcessMarkStack() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  if (mark_stack_->Size() >= kMinParallelMarkStackSize) {
+    const bool paused = Locks::mutator_lock_->IsExclusiveHeld(Thread::Current());
+    if (!paused) {
+      // Workers created in a pause couldn't attach until it's over.
+      MaybeCreateThreadPool();
+    }
+    size_t thread_count = GetThreadCount(paused);
+    if (thread_count > 1) {
+      ProcessMarkStackParallel(thread_count);
+      DCHECK(mark_stack_->IsEmpty());
+      return;
+    }
+  }
   // TODO: try prefetch like in CMS
   while (!mark_stack_->IsEmpty()) {
     mirror::Object* obj = mark_stack_->PopBack();
@@ -4234,6 +4629,109 @@ void MarkCompact::DelayReferenceReferent(ObjPtr<mirror::Class> klass,
   heap_->GetReferenceProcessor()->DelayReferenceReferent(klass, ref, this);
 }
 
+// Finds whether an object refers to the young generation, which after this
+// cycle consists of the black allocations.
+class MarkCompact::YoungRefsVisitor {
+ public:
+  explicit YoungRefsVisitor(MarkCompact* const mark_compact)
+      : mark_compact_(mark_compact), has_young_refs_(false) {}
+
+  bool HasYoungRefs() const { return has_young_refs_; }
+
+  void operator()(mirror::Object* obj, MemberOffset offset, bool is_static ATTRIBUTE_UNUSED) const
+      REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    Check(obj->GetFieldObject<mirror::Object, kVerifyNone, kWithoutReadBarrier>(offset));
+  }
+
+  void operator()(ObjPtr<mirror::Class> klass ATTRIBUTE_UNUSED, ObjPtr<mirror::Reference> ref) const
+      REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    Check(ref->GetReferent<kWithoutReadBarrier>());
+  }
+
+  void VisitRootIfNonNull(mirror::CompressedReference<mirror::Object>* root) const
+      REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    if (!root->IsNull()) {
+      VisitRoot(root);
+    }
+  }
+
+  void VisitRoot(mirror::CompressedReference<mirror::Object>* root) const
+      REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    Check(root->AsMirrorPtr());
+  }
+
+ private:
+  void Check(mirror::Object* ref) const
+      REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    if (ref == nullptr || has_young_refs_) {
+      return;
+    }
+    if (mark_compact_->moving_space_bitmap_->HasAddress(ref)) {
+      has_young_refs_ = reinterpret_cast<uint8_t*>(ref) >= mark_compact_->black_allocations_begin_;
+    } else if (!mark_compact_->immune_spaces_.ContainsObject(ref)) {
+      // Non-moving and large objects allocated since the marking-pause are not
+      // marked yet.
+      has_young_refs_ = mark_compact_->IsMarked(ref) == nullptr;
+    }
+  }
+
+  MarkCompact* const mark_compact_;
+  mutable bool has_young_refs_;
+};
+
+void MarkCompact::UpdateMovingSpaceCards() {
+  TimingLogger::ScopedTiming t("(Paused)UpdateMovingSpaceCards", GetTimings());
+  // Cards dirtied since the marking-pause may hold references to black
+  // allocations, which remain young. Move the cards of the objects which do
+  // refer to the young generation to their post-compact addresses, and clear
+  // the rest. As objects only slide towards the beginning of the space,
+  // visiting the cards in ascending order never clears a card that has already
+  // been marked.
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  uint8_t* const card_end = card_table->CardFromAddr(black_allocations_begin_);
+  for (uint8_t* card = card_table->CardFromAddr(bump_pointer_space_->Begin());
+       card < card_end;
+       card++) {
+    if (*card == accounting::CardTable::kCardClean) {
+      continue;
+    }
+    *card = accounting::CardTable::kCardClean;
+    uintptr_t start = reinterpret_cast<uintptr_t>(card_table->AddrFromCard(card));
+    moving_space_bitmap_->VisitMarkedRange(
+        start,
+        start + accounting::CardTable::kCardSize,
+        [this, card_table](mirror::Object* obj)
+            REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+          YoungRefsVisitor visitor(this);
+          obj->VisitReferences</*kVisitNativeRoots=*/true, kVerifyNone, kWithoutReadBarrier>(
+              visitor, visitor);
+          if (visitor.HasYoungRefs()) {
+            card_table->MarkCard(PostCompactOldObjAddr(obj));
+          }
+        });
+  }
+}
+
+void MarkCompact::UpdateOldGenMarkBitmap() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  // All the objects marked in this GC are promoted. Move their mark-bits to the
+  // post-compact addresses. The old generation, if any, didn't move.
+  uint8_t* begin = young_gen_ ? old_gen_end_ : bump_pointer_space_->Begin();
+  int32_t count = young_gen_ ? old_gen_objects_ : 0;
+  moving_space_bitmap_->VisitMarkedRange(
+      reinterpret_cast<uintptr_t>(begin),
+      reinterpret_cast<uintptr_t>(black_allocations_begin_),
+      [this, &count](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+        moving_space_bitmap_->Clear(obj);
+        moving_space_bitmap_->Set(PostCompactOldObjAddr(obj));
+        count++;
+      });
+  moving_space_bitmap_->ClearRange(reinterpret_cast<mirror::Object*>(black_allocations_begin_),
+                                   reinterpret_cast<mirror::Object*>(bump_pointer_space_->Limit()));
+  old_gen_end_ = next_old_gen_end_;
+  old_gen_objects_ = count;
+}
+
 void MarkCompact::FinishPhase() {
   GetCurrentIteration()->SetScannedBytes(bytes_scanned_);
   bool is_zygote = Runtime::Current()->IsZygote();
@@ -4254,13 +4752,22 @@ void MarkCompact::FinishPhase() {
     // unmap the buffers used by worker threads.
     compaction_buffers_map_.SetSize(kPageSize);
   }
+  if (use_generational_ && !is_zygote) {
+    // Retain the mark-bits of the promoted objects, at their post-compact
+    // addresses, for the next young GC. This requires the live-words bitmap and
+    // the chunk-info vector, so it must be done before they are cleared.
+    ReaderMutexLock mu(thread_running_gc_, *Locks::mutator_lock_);
+    UpdateOldGenMarkBitmap();
+  } else {
+    // TODO: We can clear this bitmap right before compaction pause. But in that
+    // case we need to ensure that we don't assert on this bitmap afterwards.
+    // Also, we would still need to clear it here again as we may have to use the
+    // bitmap for black-allocations (see UpdateMovingSpaceBlackAllocations()).
+    moving_space_bitmap_->Clear();
+    old_gen_end_ = nullptr;
+  }
   info_map_.MadviseDontNeedAndZero();
   live_words_bitmap_->ClearBitmap();
-  // TODO: We can clear this bitmap right before compaction pause. But in that
-  // case we need to ensure that we don't assert on this bitmap afterwards.
-  // Also, we would still need to clear it here again as we may have to use the
-  // bitmap for black-allocations (see UpdateMovingSpaceBlackAllocations()).
-  moving_space_bitmap_->Clear();
 
   if (UNLIKELY(is_zygote && IsValidFd(uffd_))) {
     heap_->DeleteThreadPool();
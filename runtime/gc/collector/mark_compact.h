@@ -88,7 +88,23 @@ class MarkCompact final : public GarbageCollector {
   bool SigbusHandler(siginfo_t* info) REQUIRES(!lock_) NO_THREAD_SAFETY_ANALYSIS;
 
   GcType GetGcType() const override {
-    return kGcTypeFull;
+    return young_gen_ ? kGcTypeSticky : kGcTypeFull;
+  }
+
+  // Request a young-generation collection for the next cycle. It falls back to
+  // a full collection if the previous cycle didn't retain an old generation.
+  void SetYoungGen(bool young_gen) {
+    young_gen_ = young_gen;
+  }
+
+  // Returns the estimated throughput of the full collections in bytes / second. With generational
+  // collection, the young collections are run by this collector too and are left out, so that
+  // they can be compared against the full ones.
+  uint64_t GetEstimatedFullGcMeanThroughput() const;
+
+  // Returns how many full collections have been run.
+  size_t NumberOfFullGcIterations() const {
+    return full_gc_iterations_;
   }
 
   CollectorType GetCollectorType() const override {
@@ -196,7 +212,9 @@ class MarkCompact final : public GarbageCollector {
     // Return offset (within the indexed chunk-info) of the nth live word.
     uint32_t FindNthLiveWordOffset(size_t chunk_idx, uint32_t n) const;
     // Sets all bits in the bitmap corresponding to the given range. Also
-    // returns the bit-index of the first word.
+    // returns the bit-index of the first word. kAtomic must be true if other
+    // threads may be setting bits of neighbouring objects simultaneously.
+    template <bool kAtomic = false>
     ALWAYS_INLINE uintptr_t SetLiveWords(uintptr_t begin, size_t size);
     // Count number of live words upto the given bit-index. This is to be used
     // to compute the post-compact address of an old reference.
@@ -352,6 +370,14 @@ class MarkCompact final : public GarbageCollector {
   // Update first-object info from allocation-stack for non-moving space black
   // allocations.
   void UpdateNonMovingSpaceBlackAllocations() REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  // Move the dirty cards of the objects being compacted to their post-compact
+  // addresses, so that old-to-young references created since the marking pause
+  // are found by the next young collection. The other cards are cleared.
+  void UpdateMovingSpaceCards() REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  // Set the mark-bits of the objects compacted in this cycle at their
+  // post-compact addresses. These bits identify the old generation in the next
+  // young collection.
+  void UpdateOldGenMarkBitmap() REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Slides (retain the empty holes, which are usually part of some in-use TLAB)
   // black page in the moving space. 'first_obj' is the object that overlaps with
@@ -393,6 +419,10 @@ class MarkCompact final : public GarbageCollector {
   // spaces.
   void UpdateAndMarkModUnion() REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
+  // In a young collection, scan the objects on the aged cards of the old
+  // generation (moving and non-moving spaces) for references into the young one.
+  void ScanOldGenCards() REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_);
   // Scan mod-union and card tables, covering all the spaces, to identify dirty objects.
   // These are in 'minimum age' cards, which is 'kCardAged' in case of concurrent (second round)
   // marking and kCardDirty during the STW pause.
@@ -406,6 +436,16 @@ class MarkCompact final : public GarbageCollector {
   // Go through all the objects in the mark-stack until it's empty.
   void ProcessMarkStack() override REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
+  // Split the mark-stack into tasks for the heap's thread-pool and process them
+  // with 'thread_count' threads, including the gc-thread.
+  void ProcessMarkStackParallel(size_t thread_count) REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_);
+  // Create the heap's thread-pool for parallel marking and compaction, unless
+  // it already exists or this process shouldn't use one.
+  void MaybeCreateThreadPool();
+  // Number of threads, including the gc-thread, to be used for marking or
+  // compacting. Returns 1 if the heap's thread-pool isn't available.
+  size_t GetThreadCount(bool paused) const;
   void ExpandMarkStack() REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
 
@@ -421,7 +461,9 @@ class MarkCompact final : public GarbageCollector {
 
   // Update the live-words bitmap as well as add the object size to the
   // chunk-info vector. Both are required for computation of post-compact addresses.
-  // Also updates freed_objects_ counter.
+  // Also updates freed_objects_ counter, unless kParallel is true in which case
+  // the caller is expected to account for it.
+  template <bool kParallel = false>
   void UpdateLivenessInfo(mirror::Object* obj, size_t obj_size)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -450,6 +492,11 @@ class MarkCompact final : public GarbageCollector {
       REQUIRES(Locks::heap_bitmap_lock_);
   void SweepLargeObjects(bool swap_bitmaps) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
+  // Free the unmarked non-moving and large objects allocated since the last GC
+  // and remove them from the given allocation stack. Used in generational mode.
+  void SweepAllocStack(accounting::ObjectStack* stack)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_);
 
   // Perform all kernel operations required for concurrent compaction. Includes
   // mremap to move pre-compact pages to from-space, followed by userfaultfd
@@ -476,6 +523,13 @@ class MarkCompact final : public GarbageCollector {
                                      uint8_t* buf,
                                      size_t nr_moving_space_used_pages)
       REQUIRES_SHARED(Locks::mutator_lock_);
+  // Called by thread-pool workers, when using the SIGBUS feature, to compact
+  // moving-space pages in ascending order while the gc-thread does so in
+  // descending order in CompactMovingSpace(). The pages are claimed like a
+  // mutator would in the SIGBUS handler.
+  template <int kMode>
+  void HelpCompactMovingSpace(size_t nr_moving_space_used_pages)
+      REQUIRES_SHARED(Locks::mutator_lock_);
   // Called by thread-pool workers to process and copy/map the fault page in
   // linear-alloc.
   template <int kMode>
@@ -504,7 +558,8 @@ class MarkCompact final : public GarbageCollector {
 
   bool IsValidFd(int fd) const { return fd >= 0; }
   // Add/update <class, obj> pair if class > obj and obj is the lowest address
-  // object of class.
+  // object of class. kParallel must be true if invoked from multiple threads.
+  template <bool kParallel = false>
   ALWAYS_INLINE void UpdateClassAfterObjectMap(mirror::Object* obj)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -700,6 +755,15 @@ class MarkCompact final : public GarbageCollector {
   // Cache (black_allocations_begin_ - post_compact_end_) for post-compact
   // address computations.
   ptrdiff_t black_objs_slide_diff_;
+  // End of the old generation in the moving space. Objects below it survived
+  // the previous GC, are densely packed, and have their mark-bits retained
+  // across cycles. Null if the previous cycle didn't retain an old generation.
+  uint8_t* old_gen_end_;
+  // End of the live objects after compaction, which becomes old_gen_end_ at the
+  // end of the cycle. Unlike post_compact_end_ it's not aligned up to page size.
+  uint8_t* next_old_gen_end_;
+  // Number of objects below old_gen_end_.
+  int32_t old_gen_objects_;
   // Cache (from_space_begin_ - bump_pointer_space_->Begin()) so that we can
   // compute from-space address of a given pre-comapct addr efficiently.
   ptrdiff_t from_space_slide_diff_;
@@ -737,10 +801,22 @@ class MarkCompact final : public GarbageCollector {
   // When using SIGBUS feature, this counter is used by mutators to claim a page
   // out of compaction buffers to be used for the entire compaction cycle.
   std::atomic<uint16_t> compaction_buffer_counter_;
+  // Next moving-space page to be claimed by HelpCompactMovingSpace(). Set to
+  // the number of used pages by the gc-thread once it's done with compaction.
+  std::atomic<size_t> helper_compaction_page_idx_;
   // Used to exit from compaction loop at the end of concurrent compaction
   uint8_t thread_pool_counter_;
   // True while compacting.
   bool compacting_;
+  // True if generational collection is enabled. See Heap::GetUseGenerationalCMC().
+  const bool use_generational_;
+  // True if the current cycle only collects the young generation, i.e. the
+  // objects allocated since the previous GC.
+  bool young_gen_;
+  // Cumulative statistics of the full collections, see GetEstimatedFullGcMeanThroughput().
+  int64_t full_gc_freed_bytes_;
+  uint64_t full_gc_time_ns_;
+  size_t full_gc_iterations_;
   // Flag indicating whether one-time uffd initialization has been done. It will
   // be false on the first GC for non-zygote processes, and always for zygote.
   // Its purpose is to minimize the userfaultfd overhead to the minimal in
@@ -770,12 +846,15 @@ class MarkCompact final : public GarbageCollector {
   template<size_t kBufferSize> class ThreadRootsVisitor;
   class CardModifiedVisitor;
   class RefFieldsVisitor;
+  class YoungRefsVisitor;
   template <bool kCheckBegin, bool kCheckEnd> class RefsUpdateVisitor;
   class ArenaPoolPageUpdater;
   class ClassLoaderRootsUpdater;
   class LinearAllocPageUpdater;
   class ImmuneSpaceUpdateObjVisitor;
   class ConcurrentCompactionGcTask;
+  class MarkStackTask;
+  class CompactionHelperTask;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MarkCompact);
 };
@@ -155,6 +155,10 @@ inline mirror::Object* Heap::AllocObjectWithAllocator(Thread* self,
                                      &bytes_tl_bulk_allocated,
                                      &klass);
         if (obj == nullptr) {
+          // Do not attribute a sample taken for the failed allocation to the next one.
+          if (UNLIKELY(allocation_site_profiler_ != nullptr)) {
+            heap_sampler_.TakePendingSiteSample();
+          }
           // The only way that we can get a null return if there is no pending exception is if the
           // allocator or instrumentation changed.
           if (!self->IsExceptionPending()) {
@@ -215,6 +219,10 @@ inline mirror::Object* Heap::AllocObjectWithAllocator(Thread* self,
       }
       GetMetrics()->TotalBytesAllocated()->Add(bytes_tl_bulk_allocated);
       GetMetrics()->TotalBytesAllocatedDelta()->Add(bytes_tl_bulk_allocated);
+      // Sampled allocations always refill the TLAB or bypass it, so they end up here.
+      if (UNLIKELY(allocation_site_profiler_ != nullptr)) {
+        RecordAllocationSiteSample(self, obj);
+      }
     }
   }
   if (kIsDebugBuild && Runtime::Current()->IsStarted()) {
@@ -293,6 +301,9 @@ inline mirror::Object* Heap::AllocLargeObject(Thread* self,
                         (self, *klass, byte_count, kAllocatorTypeLOS, pre_fence_visitor);
   // Java Heap Profiler check and sample allocation.
   JHPCheckNonTlabSampleAllocation(self, obj, byte_count);
+  if (UNLIKELY(allocation_site_profiler_ != nullptr)) {
+    RecordAllocationSiteSample(self, obj);
+  }
   return obj;
 }
 
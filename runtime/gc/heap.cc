@@ -34,6 +34,7 @@
 #include "backtrace_helper.h"
 #include "base/allocator.h"
 #include "base/arena_allocator.h"
+#include "base/casts.h"
 #include "base/dumpable.h"
 #include "base/file_utils.h"
 #include "base/histogram-inl.h"
@@ -101,10 +102,12 @@
 #endif
 #include "reflection.h"
 #include "runtime.h"
+#include "javaheapprof/allocation_site_profiler.h"
 #include "javaheapprof/javaheapsampler.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread-inl.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 #include "verify_object-inl.h"
 #include "well_known_classes.h"
 
@@ -295,6 +298,7 @@ Heap::Heap(size_t initial_size,
            bool measure_gc_performance,
            bool use_homogeneous_space_compaction_for_oom,
            bool use_generational_cc,
+           bool use_generational_cmc,
            uint64_t min_interval_homogeneous_space_compaction_by_oom,
            bool dump_region_info_before_gc,
            bool dump_region_info_after_gc)
@@ -394,6 +398,7 @@ Heap::Heap(size_t initial_size,
       pending_heap_trim_(nullptr),
       use_homogeneous_space_compaction_for_oom_(use_homogeneous_space_compaction_for_oom),
       use_generational_cc_(use_generational_cc),
+      use_generational_cmc_(use_generational_cmc),
       running_collection_is_blocking_(false),
       blocking_gc_count_(0U),
       blocking_gc_time_(0U),
@@ -1116,7 +1121,9 @@ void Heap::CreateThreadPool(size_t num_threads) {
     num_threads = std::max(parallel_gc_threads_, conc_gc_threads_);
   }
   if (num_threads != 0) {
-    thread_pool_.reset(new ThreadPool("Heap thread pool", num_threads));
+    // GC tasks commonly split up their work into new tasks, which then stay local to the
+    // worker unless an idle one steals them.
+    thread_pool_.reset(new WorkStealingThreadPool("Heap thread pool", num_threads));
   }
 }
 
@@ -2257,6 +2264,9 @@ void Heap::ChangeCollector(CollectorType collector_type) {
         break;
       }
       case kCollectorTypeCMC: {
+        if (use_generational_cmc_) {
+          gc_plan_.push_back(collector::kGcTypeSticky);
+        }
         gc_plan_.push_back(collector::kGcTypeFull);
         if (use_tlab_) {
           ChangeAllocator(kAllocatorTypeTLAB);
@@ -2775,6 +2785,9 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
         collector = semi_space_collector_;
         break;
       case kCollectorTypeCMC:
+        // The same collector performs both the young and full collections. It
+        // falls back to a full collection if there is no old generation yet.
+        mark_compact_->SetYoungGen(use_generational_cmc_ && gc_type == collector::kGcTypeSticky);
         collector = mark_compact_;
         break;
       case kCollectorTypeCC:
@@ -3640,6 +3653,9 @@ void Heap::DumpForSigQuit(std::ostream& os) {
     }
   }
   DumpGcPerformanceInfo(os);
+  if (allocation_site_profiler_ != nullptr) {
+    allocation_site_profiler_->Dump(os);
+  }
 }
 
 size_t Heap::GetPercentFree() {
@@ -3721,6 +3737,18 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
       }
       CHECK(non_sticky_collector != nullptr);
     }
+    uint64_t non_sticky_gc_throughput;
+    size_t non_sticky_gc_iterations;
+    if (use_generational_cmc_ && non_sticky_collector == nullptr) {
+      // Young and full CMC collections are performed by the same collector, which keeps the
+      // statistics of the full ones apart.
+      DCHECK_EQ(collector_ran, mark_compact_);
+      non_sticky_gc_throughput = mark_compact_->GetEstimatedFullGcMeanThroughput();
+      non_sticky_gc_iterations = mark_compact_->NumberOfFullGcIterations();
+    } else {
+      non_sticky_gc_throughput = non_sticky_collector->GetEstimatedMeanThroughput();
+      non_sticky_gc_iterations = non_sticky_collector->NumberOfIterations();
+    }
     double sticky_gc_throughput_adjustment = GetStickyGcThroughputAdjustment(use_generational_cc_);
 
     // If the throughput of the current sticky GC >= throughput of the non sticky collector, then
@@ -3731,8 +3759,8 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     // if the sticky GC throughput always remained >= the full/partial throughput.
     size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
     if (current_gc_iteration_.GetEstimatedThroughput() * sticky_gc_throughput_adjustment >=
-        non_sticky_collector->GetEstimatedMeanThroughput() &&
-        non_sticky_collector->NumberOfIterations() > 0 &&
+        non_sticky_gc_throughput &&
+        non_sticky_gc_iterations > 0 &&
         bytes_allocated <= (IsGcConcurrent() ? concurrent_start_bytes_ : target_footprint)) {
       next_gc_type_ = collector::kGcTypeSticky;
     } else {
@@ -4341,6 +4369,27 @@ int Heap::CheckPerfettoJHPEnabled() {
   return GetHeapSampler().IsEnabled();
 }
 
+void Heap::StartAllocationSiteProfiler(size_t sampling_interval) {
+  DCHECK(allocation_site_profiler_ == nullptr);
+  allocation_site_profiler_ = std::make_unique<AllocationSiteProfiler>();
+  heap_sampler_.SetSamplingInterval(dchecked_integral_cast<int>(sampling_interval));
+  heap_sampler_.SetAllocationSiteProfiler(allocation_site_profiler_.get());
+  VLOG(heap) << "Allocation site profiler started, sampling interval " << sampling_interval;
+}
+
+void Heap::RecordAllocationSiteSample(Thread* self, ObjPtr<mirror::Object> obj) {
+  size_t byte_count = heap_sampler_.TakePendingSiteSample();
+  if (byte_count == 0u || obj == nullptr) {
+    return;
+  }
+  // Only the top frame is needed, which keeps the cost of a sample to a short stack walk.
+  uint32_t dex_pc = dex::kDexNoIndex;
+  ArtMethod* method =
+      self->GetCurrentMethod(&dex_pc, /*check_suspended=*/ false, /*abort_on_error=*/ false);
+  allocation_site_profiler_->Record(
+      method, dex_pc, obj->GetClass(), byte_count, heap_sampler_.GetSamplingInterval());
+}
+
 void Heap::JHPCheckNonTlabSampleAllocation(Thread* self, mirror::Object* obj, size_t alloc_size) {
   bool take_sample = false;
   size_t bytes_until_sample = 0;
@@ -48,6 +48,7 @@
 
 namespace art {
 
+class AllocationSiteProfiler;
 class ConditionVariable;
 enum class InstructionSet;
 class IsMarkedVisitor;
@@ -228,6 +229,7 @@ class Heap {
        bool measure_gc_performance,
        bool use_homogeneous_space_compaction,
        bool use_generational_cc,
+       bool use_generational_cmc,
        uint64_t min_interval_homogeneous_space_compaction_by_oom,
        bool dump_region_info_before_gc,
        bool dump_region_info_after_gc);
@@ -271,6 +273,9 @@ class Heap {
                                                                   pre_fence_visitor);
     // Java Heap Profiler check and sample allocation.
     JHPCheckNonTlabSampleAllocation(self, obj, num_bytes);
+    if (UNLIKELY(allocation_site_profiler_ != nullptr)) {
+      RecordAllocationSiteSample(self, obj);
+    }
     return obj;
   }
 
@@ -554,6 +559,10 @@ class Heap {
     return use_generational_cc_;
   }
 
+  bool GetUseGenerationalCMC() const {
+    return use_generational_cmc_;
+  }
+
   // Returns the number of objects currently allocated.
   size_t GetObjectsAllocated() const
       REQUIRES(!Locks::heap_bitmap_lock_);
@@ -898,6 +907,18 @@ class Heap {
 
   void InitPerfettoJavaHeapProf();
   int CheckPerfettoJHPEnabled();
+
+  // Aggregate allocations by site, sampling on average one allocation every
+  // `sampling_interval` bytes. Must be called before any thread but the current one starts.
+  void StartAllocationSiteProfiler(size_t sampling_interval);
+  // Returns null unless -Xallocsitesampling was given.
+  AllocationSiteProfiler* GetAllocationSiteProfiler() const {
+    return allocation_site_profiler_.get();
+  }
+  // Record the allocation site of `obj` if its allocation was sampled. Called once `obj`
+  // is initialized.
+  void RecordAllocationSiteSample(Thread* self, ObjPtr<mirror::Object> obj)
+      REQUIRES_SHARED(Locks::mutator_lock_);
   // In NonTlab case: Check whether we should report a sample allocation and if so report it.
   // Also update state (bytes_until_sample).
   // By calling JHPCheckNonTlabSampleAllocation from different functions for Large allocations and
@@ -1653,6 +1674,11 @@ class Heap {
   // for major collections. Set in Heap constructor.
   const bool use_generational_cc_;
 
+  // If true, enable generational collection when using the Concurrent
+  // Mark-Compact (CMC) collector, i.e. use young-generation CMC for minor
+  // collections and (full) CMC for major collections. Set in Heap constructor.
+  const bool use_generational_cmc_;
+
   // True if the currently running collection has made some thread wait.
   bool running_collection_is_blocking_ GUARDED_BY(gc_complete_lock_);
   // The number of blocking GC runs.
@@ -1684,6 +1710,7 @@ class Heap {
 
   // Perfetto Java Heap Profiler support.
   HeapSampler heap_sampler_;
+  std::unique_ptr<AllocationSiteProfiler> allocation_site_profiler_;
 
   // GC stress related data structures.
   Mutex* backtrace_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
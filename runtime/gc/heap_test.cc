@@ -17,15 +17,18 @@
 #include <algorithm>
 
 #include "base/metrics/metrics.h"
+#include "base/metrics/metrics_test.h"
 #include "class_linker-inl.h"
 #include "common_runtime_test.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/accounting/space_bitmap-inl.h"
+#include "gc/collector/mark_compact.h"
 #include "handle_scope-inl.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
 #include "mirror/object_array-alloc-inl.h"
 #include "mirror/object_array-inl.h"
+#include "mirror/string-alloc-inl.h"
 #include "scoped_thread_state_change-inl.h"
 
 namespace art {
@@ -254,6 +257,68 @@ TEST_F(HeapTest, GCMetrics) {
   }
 }
 
+class GenerationalCMCHeapTest : public HeapTest {
+ public:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    HeapTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-Xgc:generational_cmc", nullptr));
+  }
+};
+
+TEST_F(GenerationalCMCHeapTest, YoungGcKeepsObjectsReachableFromOldGeneration) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  if (heap->CurrentCollectorType() != kCollectorTypeCMC || !heap->GetUseGenerationalCMC()) {
+    GTEST_SKIP() << "Generational mark-compact collection is not in use";
+  }
+  constexpr size_t kNumYoungObjects = 512;
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<2> hs(soa.Self());
+  Handle<mirror::Class> c(
+      hs.NewHandle(class_linker_->FindSystemClass(soa.Self(), "[Ljava/lang/Object;")));
+  Handle<mirror::ObjectArray<mirror::Object>> old_array(hs.NewHandle(
+      mirror::ObjectArray<mirror::Object>::Alloc(soa.Self(), c.Get(), kNumYoungObjects)));
+  ASSERT_TRUE(old_array != nullptr);
+  {
+    // The first collection is a full one, which promotes the array.
+    ScopedThreadSuspension sts(soa.Self(), ThreadState::kNative);
+    heap->CollectGarbage(/* clear_soft_references= */ false);
+  }
+  collector::MarkCompact* mark_compact = heap->MarkCompactCollector();
+  const size_t iterations = mark_compact->NumberOfIterations();
+  const size_t full_gc_iterations = mark_compact->NumberOfFullGcIterations();
+  EXPECT_GT(full_gc_iterations, 0u);
+  const uint64_t young_gc_count =
+      metrics::test::CounterValue(*Runtime::Current()->GetMetrics()->YoungGcCount());
+  for (size_t round = 0; round < 3; ++round) {
+    // The strings are referred only from the old array.
+    for (size_t i = 0; i < kNumYoungObjects; ++i) {
+      std::string value = std::to_string(round) + ":" + std::to_string(i);
+      old_array->Set(i, mirror::String::AllocFromModifiedUtf8(soa.Self(), value.c_str()));
+    }
+    {
+      // Collections requested in the background follow a full one with young ones.
+      ScopedThreadSuspension sts(soa.Self(), ThreadState::kNative);
+      heap->ConcurrentGC(
+          soa.Self(), kGcCauseBackground, /*force_full=*/ false, heap->GetCurrentGcNum() + 1);
+    }
+    for (size_t i = 0; i < kNumYoungObjects; ++i) {
+      std::string value = std::to_string(round) + ":" + std::to_string(i);
+      ObjPtr<mirror::Object> obj = old_array->Get(i);
+      ASSERT_TRUE(obj != nullptr);
+      ASSERT_TRUE(obj->IsString());
+      EXPECT_TRUE(obj->AsString()->Equals(value.c_str())) << value;
+    }
+  }
+  const uint64_t young_gcs =
+      metrics::test::CounterValue(*Runtime::Current()->GetMetrics()->YoungGcCount()) -
+      young_gc_count;
+  EXPECT_GT(young_gcs, 0u);
+  // Young collections are kept out of the full collection statistics, which they are compared
+  // against when choosing the type of the next collection.
+  EXPECT_EQ(mark_compact->NumberOfIterations() - iterations,
+            mark_compact->NumberOfFullGcIterations() - full_gc_iterations + young_gcs);
+}
+
 class ZygoteHeapTest : public CommonRuntimeTest {
  public:
   ZygoteHeapTest() {
@@ -57,6 +57,7 @@
 #include "image-inl.h"
 #include "image.h"
 #include "intern_table-inl.h"
+#include "lazy_image_decompressor.h"
 #include "mirror/class-inl.h"
 #include "mirror/executable-inl.h"
 #include "mirror/object-inl.h"
@@ -749,6 +750,7 @@ class ImageSpace::Loader {
     // avoid reading proc maps for a mapping failure and slowing everything down.
     // For the boot image, we have already reserved the memory and we load the image
     // into the `image_reservation`.
+    std::unique_ptr<LazyImageDecompressor> lazy_decompressor;
     MemMap map = LoadImageFile(
         image_filename,
         image_location,
@@ -757,6 +759,7 @@ class ImageSpace::Loader {
         allow_direct_mapping,
         logger,
         image_reservation,
+        &lazy_decompressor,
         error_msg);
     if (!map.IsValid()) {
       DCHECK(!error_msg->empty());
@@ -805,6 +808,7 @@ class ImageSpace::Loader {
                                                      std::move(map),
                                                      std::move(bitmap),
                                                      image_end));
+    space->lazy_decompressor_ = std::move(lazy_decompressor);
     return space;
   }
 
@@ -992,6 +996,7 @@ class ImageSpace::Loader {
                               bool allow_direct_mapping,
                               TimingLogger* logger,
                               /*inout*/MemMap* image_reservation,
+                              /*out*/std::unique_ptr<LazyImageDecompressor>* lazy_decompressor,
                               /*out*/std::string* error_msg)
         REQUIRES_SHARED(Locks::mutator_lock_) {
     TimingLogger::ScopedTiming timing("MapImageFile", logger);
@@ -1046,6 +1051,42 @@ class ImageSpace::Loader {
                                      image_filename);
       }
 
+      // Images mapped at their compiled address need no relocation, which would touch every
+      // page, so their blocks can be decompressed on first touch instead.
+      if (is_compressed &&
+          runtime != nullptr &&
+          runtime->IsLazyImageDecompressionEnabled() &&
+          !runtime->IsAotCompiler() &&
+          image_header.GetBlockCount() >= 2u &&
+          map.Begin() == image_header.GetImageBegin()) {
+        TimingLogger::ScopedTiming timing2("LazyDecompressImage", logger);
+        // Prefetch the blocks read at startup, in the order they are read: the class roots at
+        // the start of the objects, and the tables used to set up the intern table and the
+        // class linker.
+        const ImageSection hot_sections[] = {
+            ImageSection(image_header.GetObjectsSection().Offset(), kPageSize),
+            image_header.GetInternedStringsSection(),
+            image_header.GetClassTableSection(),
+            image_header.GetImageStringReferenceOffsetsSection(),
+            image_header.GetImageSection(ImageHeader::kSectionDexCacheArrays),
+        };
+        IterationRange<const ImageHeader::Block*> blocks = image_header.GetBlocks(temp_map.Begin());
+        std::string lazy_error_msg;
+        *lazy_decompressor = LazyImageDecompressor::Create(
+            image_location,
+            &map,
+            ArrayRef<const uint8_t>(reinterpret_cast<const uint8_t*>(&image_header),
+                                    sizeof(ImageHeader)),
+            ArrayRef<const ImageHeader::Block>(blocks.begin(), image_header.GetBlockCount()),
+            std::move(temp_map),
+            ArrayRef<const ImageSection>(hot_sections),
+            &lazy_error_msg);
+        if (*lazy_decompressor != nullptr) {
+          return map;
+        }
+        VLOG(image) << "Decompressing image " << image_filename << " eagerly: " << lazy_error_msg;
+      }
+
       if (is_compressed) {
         memcpy(map.Begin(), &image_header, sizeof(ImageHeader));
 
@@ -3775,6 +3816,12 @@ void ImageSpace::DumpSections(std::ostream& os) const {
   }
 }
 
+void ImageSpace::FinishLazyDecompression() {
+  if (lazy_decompressor_ != nullptr) {
+    lazy_decompressor_->Finish();
+  }
+}
+
 void ImageSpace::ReleaseMetadata() {
   const ImageSection& metadata = GetImageHeader().GetMetadataSection();
   VLOG(image) << "Releasing " << metadata.Size() << " image metadata bytes";
@@ -34,6 +34,8 @@ class OatHeader;
 namespace gc {
 namespace space {
 
+class LazyImageDecompressor;
+
 // An image space is a space backed with a memory mapped image.
 class ImageSpace : public MemMapSpace {
  public:
@@ -304,6 +306,10 @@ class ImageSpace : public MemMapSpace {
 
   void ReleaseMetadata() REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Decompress the rest of a lazily decompressed image, see -Xlazyimagedecompression.
+  // Must be done before forking. Does nothing if the image was not decompressed lazily.
+  void FinishLazyDecompression();
+
   static void AppendImageChecksum(uint32_t component_count,
                                   uint32_t checksum,
                                   /*inout*/ std::string* checksums);
@@ -516,6 +522,9 @@ class ImageSpace : public MemMapSpace {
   const std::string image_location_;
   const std::vector<std::string> profile_files_;
 
+  // Serves the faults on the image while it is decompressed lazily, null otherwise.
+  std::unique_ptr<LazyImageDecompressor> lazy_decompressor_;
+
   friend class Space;
 
  private:
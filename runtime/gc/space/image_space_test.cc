@@ -14,16 +14,22 @@
  * limitations under the License.
  */
 
+#include <limits>
+
 #include <gtest/gtest.h>
 
 #include "android-base/logging.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 #include "base/globals.h"
+#include "base/os.h"
 #include "base/stl_util.h"
+#include "base/time_utils.h"
+#include "base/utils.h"
 #include "class_linker.h"
 #include "dex/utf.h"
 #include "dexopt_test.h"
+#include "image.h"
 #include "intern_table-inl.h"
 #include "noop_compiler_callbacks.h"
 #include "oat_file.h"
@@ -224,6 +230,67 @@ TEST_F(ImageSpaceTest, StringDeduplication) {
   EXPECT_FALSE(contains_test_string(app_image_space.get()));
 }
 
+// Microbenchmark comparing the decompression time of the boot image stored with each
+// compressed storage mode, in a single block like dex2oat writes it by default, and in the
+// blocks of runtime app images. Sized to run with the other tests, the timings are only logged.
+TEST_F(ImageSpaceTest, DecompressionBenchmark) {
+  static constexpr ImageHeader::StorageMode kStorageModes[] = {
+      ImageHeader::kStorageModeLZ4, ImageHeader::kStorageModeLZ4HC, ImageHeader::kStorageModeZstd};
+  static constexpr uint32_t kMaxImageBlockSizes[] = {
+      std::numeric_limits<uint32_t>::max(), 512 * KB};
+  ScratchDir scratch;
+  const std::string image_filename = scratch.GetPath() + "boot.art";
+  const std::vector<ImageSpace*>& boot_image_spaces =
+      Runtime::Current()->GetHeap()->GetBootImageSpaces();
+  ASSERT_FALSE(boot_image_spaces.empty());
+  // The primary boot image component holds most of the data.
+  const ImageSpace* space = boot_image_spaces[0];
+  const ImageHeader& space_header = space->GetImageHeader();
+  const size_t image_size = space_header.GetImageSize();
+  std::vector<uint8_t> bitmap_data(space_header.GetImageBitmapSection().Size(), 0u);
+  std::vector<uint8_t> image_data(image_size);
+  for (ImageHeader::StorageMode storage_mode : kStorageModes) {
+    for (uint32_t max_image_block_size : kMaxImageBlockSizes) {
+      ImageHeader image_header = space_header;
+      std::string error_msg;
+      ImageFileGuard image_file;
+      image_file.reset(OS::CreateEmptyFileWriteOnly(image_filename.c_str()));
+      ASSERT_TRUE(image_file != nullptr);
+      ASSERT_TRUE(image_header.WriteData(image_file,
+                                         space->Begin(),
+                                         bitmap_data.data(),
+                                         storage_mode,
+                                         max_image_block_size,
+                                         /*update_checksum=*/ false,
+                                         &error_msg)) << error_msg;
+      ASSERT_TRUE(image_file.WriteHeaderAndClose(image_filename, &image_header, &error_msg))
+          << error_msg;
+
+      std::unique_ptr<File> file(OS::OpenFileForReading(image_filename.c_str()));
+      ASSERT_TRUE(file != nullptr);
+      std::vector<uint8_t> stored_data(sizeof(ImageHeader) + image_header.GetDataSize());
+      ASSERT_TRUE(file->ReadFully(stored_data.data(), stored_data.size()));
+      const uint64_t start = NanoTime();
+      for (const ImageHeader::Block& block : image_header.GetBlocks(stored_data.data())) {
+        ASSERT_TRUE(block.Decompress(image_data.data(), stored_data.data(), &error_msg))
+            << error_msg;
+      }
+      const uint64_t time = NanoTime() - start;
+      EXPECT_EQ(0, memcmp(image_data.data() + sizeof(ImageHeader),
+                          space->Begin() + sizeof(ImageHeader),
+                          image_size - sizeof(ImageHeader)));
+      // Add 1 ns to prevent a division by zero.
+      LOG(INFO) << "Storage mode: " << storage_mode
+                << " Blocks: " << image_header.GetBlockCount()
+                << " Stored: " << PrettySize(image_header.GetDataSize()) << " of "
+                << PrettySize(image_size)
+                << " Decompression: " << PrettyDuration(time) << " ("
+                << PrettySize(static_cast<uint64_t>(image_size) * MsToNs(1000) / (time + 1))
+                << "/s)";
+    }
+  }
+}
+
 TEST_F(DexoptTest, ValidateOatFile) {
   std::string dex1 = GetScratchDir() + "/Dex1.jar";
   std::string multidex1 = GetScratchDir() + "/MultiDex1.jar";
@@ -0,0 +1,428 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lazy_image_decompressor.h"
+
+#include <fcntl.h>
+#include <linux/userfaultfd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "android-base/logging.h"
+#include "base/bit_utils.h"
+#include "base/globals.h"
+#include "base/logging.h"
+#include "base/time_utils.h"
+#include "base/utils.h"
+
+namespace art {
+namespace gc {
+namespace space {
+
+static android::base::unique_fd CreateUserfaultfd(/*out*/std::string* error_msg) {
+#ifdef __NR_userfaultfd
+  int fd = syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY);
+  // Host kernels may not have the patches restricting userfaultfd to user mode faults, which
+  // is not a security concern there. Retry without the flag, like the mark-compact collector.
+  if (!kIsTargetAndroid && fd == -1 && errno == EINVAL) {
+    fd = syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK);
+  }
+  if (fd == -1) {
+    *error_msg = std::string("userfaultfd failed: ") + strerror(errno);
+    return android::base::unique_fd();
+  }
+  android::base::unique_fd uffd(fd);
+  struct uffdio_api api = {.api = UFFD_API, .features = 0, .ioctls = 0};
+  if (ioctl(uffd.get(), UFFDIO_API, &api) != 0) {
+    *error_msg = std::string("ioctl_userfaultfd: API: ") + strerror(errno);
+    return android::base::unique_fd();
+  }
+  return uffd;
+#else
+  *error_msg = "userfaultfd is not supported";
+  return android::base::unique_fd();
+#endif
+}
+
+std::unique_ptr<LazyImageDecompressor> LazyImageDecompressor::Create(
+    const std::string& name,
+    MemMap* image_map,
+    ArrayRef<const uint8_t> header,
+    ArrayRef<const ImageHeader::Block> blocks,
+    MemMap&& compressed_map,
+    ArrayRef<const ImageSection> hot_sections,
+    /*out*/std::string* error_msg) {
+  const uint64_t start = NanoTime();
+  const size_t image_size = RoundUp(image_map->Size(), kPageSize);
+  DCHECK_ALIGNED(image_map->Begin(), kPageSize);
+  android::base::unique_fd uffd = CreateUserfaultfd(error_msg);
+  if (uffd.get() == -1) {
+    return nullptr;
+  }
+  android::base::unique_fd event_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+  if (event_fd.get() == -1) {
+    *error_msg = std::string("eventfd failed: ") + strerror(errno);
+    return nullptr;
+  }
+  MemMap staging_map = MemMap::MapAnonymous((name + " staging").c_str(),
+                                            image_size,
+                                            PROT_READ | PROT_WRITE,
+                                            /*low_4gb=*/ false,
+                                            error_msg);
+  if (!staging_map.IsValid()) {
+    return nullptr;
+  }
+  DCHECK_LE(header.size(), image_size);
+  memcpy(staging_map.Begin(), header.data(), header.size());
+
+  struct uffdio_register uffd_register;
+  uffd_register.range.start = reinterpret_cast<uintptr_t>(image_map->Begin());
+  uffd_register.range.len = image_size;
+  uffd_register.mode = UFFDIO_REGISTER_MODE_MISSING;
+  if (ioctl(uffd.get(), UFFDIO_REGISTER, &uffd_register) != 0) {
+    *error_msg = std::string("ioctl_userfaultfd: register image: ") + strerror(errno);
+    return nullptr;
+  }
+
+  std::vector<ImageHeader::Block> sorted_blocks(blocks.begin(), blocks.end());
+  std::sort(sorted_blocks.begin(),
+            sorted_blocks.end(),
+            [](const ImageHeader::Block& lhs, const ImageHeader::Block& rhs) {
+              return lhs.GetImageOffset() < rhs.GetImageOffset();
+            });
+  std::unique_ptr<LazyImageDecompressor> decompressor(
+      new LazyImageDecompressor(name,
+                                image_map->Begin(),
+                                image_size,
+                                std::move(sorted_blocks),
+                                std::move(compressed_map),
+                                std::move(staging_map),
+                                std::move(uffd),
+                                std::move(event_fd)));
+  for (const ImageSection& section : hot_sections) {
+    if (section.Size() == 0u) {
+      continue;
+    }
+    size_t first = decompressor->GetBlocksOverlapping(section.Offset() / kPageSize).first;
+    for (size_t i = first; i != decompressor->blocks_.size(); ++i) {
+      if (decompressor->blocks_[i].GetImageOffset() >= section.End()) {
+        break;
+      }
+      decompressor->hot_blocks_.push_back(i);
+    }
+  }
+  CHECK_PTHREAD_CALL(pthread_create,
+                     (&decompressor->pthread_, nullptr, &Run, decompressor.get()),
+                     "lazy image decompression thread");
+  VLOG(image) << "Lazily decompressing image " << name << ": " << decompressor->blocks_.size()
+              << " blocks, " << decompressor->hot_blocks_.size() << " hot, set up in "
+              << PrettyDuration(NanoTime() - start);
+  return decompressor;
+}
+
+LazyImageDecompressor::LazyImageDecompressor(const std::string& name,
+                                             uint8_t* image_begin,
+                                             size_t image_size,
+                                             std::vector<ImageHeader::Block>&& blocks,
+                                             MemMap&& compressed_map,
+                                             MemMap&& staging_map,
+                                             android::base::unique_fd&& uffd,
+                                             android::base::unique_fd&& event_fd)
+    : name_(name),
+      image_begin_(image_begin),
+      num_pages_(image_size / kPageSize),
+      blocks_(std::move(blocks)),
+      compressed_map_(std::move(compressed_map)),
+      staging_map_(std::move(staging_map)),
+      uffd_(std::move(uffd)),
+      event_fd_(std::move(event_fd)),
+      decompressed_blocks_(blocks_.size(), false),
+      populated_pages_(num_pages_, false) {}
+
+LazyImageDecompressor::~LazyImageDecompressor() {
+  if (!joined_) {
+    stop_requested_.store(true, std::memory_order_relaxed);
+    WakeHandler();
+    JoinHandler();
+    DumpStats("Stopped");
+  }
+}
+
+void LazyImageDecompressor::Finish() {
+  if (finished_) {
+    return;
+  }
+  const uint64_t start = NanoTime();
+  finish_requested_.store(true, std::memory_order_relaxed);
+  WakeHandler();
+  JoinHandler();
+  CHECK_EQ(num_populated_pages_, num_pages_) << name_;
+  struct uffdio_range range;
+  range.start = reinterpret_cast<uintptr_t>(image_begin_);
+  range.len = num_pages_ * kPageSize;
+  CHECK_EQ(ioctl(uffd_.get(), UFFDIO_UNREGISTER, &range), 0)
+      << "ioctl_userfaultfd: unregister image: " << strerror(errno);
+  uffd_.reset();
+  event_fd_.reset();
+  staging_map_.Reset();
+  compressed_map_.Reset();
+  finished_ = true;
+  VLOG(image) << "Finished lazy decompression of image " << name_ << " in "
+              << PrettyDuration(NanoTime() - start);
+  DumpStats("Finished");
+}
+
+void LazyImageDecompressor::WakeHandler() {
+  uint64_t value = 1u;
+  CHECK_EQ(TEMP_FAILURE_RETRY(write(event_fd_.get(), &value, sizeof(value))),
+           static_cast<ssize_t>(sizeof(value)))
+      << "Failed to wake the lazy image decompression thread: " << strerror(errno);
+}
+
+void LazyImageDecompressor::JoinHandler() {
+  CHECK(!joined_);
+  CHECK_PTHREAD_CALL(pthread_join, (pthread_, nullptr), "lazy image decompression thread");
+  joined_ = true;
+}
+
+void* LazyImageDecompressor::Run(void* arg) {
+  reinterpret_cast<LazyImageDecompressor*>(arg)->HandleFaults();
+  return nullptr;
+}
+
+void LazyImageDecompressor::HandleFaults() {
+  struct pollfd fds[2] = {{uffd_.get(), POLLIN, 0}, {event_fd_.get(), POLLIN, 0}};
+  bool finishing = false;
+  // Keep serving faults once all the pages are populated, as released metadata pages fault
+  // again, until the image is unregistered.
+  while (!stop_requested_.load(std::memory_order_relaxed)) {
+    if (!finishing && finish_requested_.load(std::memory_order_relaxed)) {
+      finishing = true;
+      num_pages_before_finish_ = num_populated_pages_;
+    }
+    if (finishing && num_populated_pages_ == num_pages_) {
+      return;
+    }
+    // Serve the faults first, prefetch when there are none.
+    const bool prefetch = finishing || next_hot_block_ != hot_blocks_.size();
+    int ret = TEMP_FAILURE_RETRY(poll(fds, arraysize(fds), prefetch ? 0 : -1));
+    CHECK_GE(ret, 0) << "poll on userfaultfd failed: " << strerror(errno);
+    if ((fds[1].revents & POLLIN) != 0) {
+      uint64_t value;
+      UNUSED(TEMP_FAILURE_RETRY(read(event_fd_.get(), &value, sizeof(value))));
+      continue;
+    }
+    bool mapped = ((fds[0].revents & POLLIN) != 0) ? ServeFaults() : Prefetch(finishing);
+    if (!mapped) {
+      return;
+    }
+  }
+}
+
+bool LazyImageDecompressor::ServeFaults() {
+  while (true) {
+    struct uffd_msg msg;
+    ssize_t nread = TEMP_FAILURE_RETRY(read(uffd_.get(), &msg, sizeof(msg)));
+    if (nread == -1 && errno == EAGAIN) {
+      return true;
+    }
+    CHECK_EQ(nread, static_cast<ssize_t>(sizeof(msg)))
+        << "Failed to read from userfaultfd: " << strerror(errno);
+    CHECK_EQ(msg.event, UFFD_EVENT_PAGEFAULT);
+    ++num_faults_;
+    uintptr_t fault_offset = msg.arg.pagefault.address - reinterpret_cast<uintptr_t>(image_begin_);
+    if (!ServePage(fault_offset / kPageSize)) {
+      return false;
+    }
+  }
+}
+
+bool LazyImageDecompressor::ServePage(size_t page) {
+  DCHECK_LT(page, num_pages_);
+  if (populated_pages_[page]) {
+    // Either another thread faulted on the page before it was copied, or the page was released
+    // with MADV_DONTNEED since, see ImageSpace::ReleaseMetadata(). A released page reads as
+    // zeros, like in an eagerly decompressed image.
+    return ZeroPage(page);
+  }
+  auto [first, end] = GetBlocksOverlapping(page);
+  for (size_t i = first; i != end; ++i) {
+    if (!decompressed_blocks_[i]) {
+      ++num_blocks_on_fault_;
+      if (!DecompressBlock(i)) {
+        return false;
+      }
+    }
+  }
+  // Pages not overlapping any block, past the header, only hold zeros.
+  return populated_pages_[page] || CopyPages(page, /*count=*/ 1u);
+}
+
+bool LazyImageDecompressor::Prefetch(bool finishing) {
+  while (next_hot_block_ != hot_blocks_.size()) {
+    size_t index = hot_blocks_[next_hot_block_];
+    ++next_hot_block_;
+    if (!decompressed_blocks_[index]) {
+      ++num_blocks_prefetched_;
+      return DecompressBlock(index);
+    }
+  }
+  if (!finishing) {
+    return true;
+  }
+  while (next_block_ != blocks_.size()) {
+    size_t index = next_block_;
+    ++next_block_;
+    if (!decompressed_blocks_[index]) {
+      ++num_blocks_at_finish_;
+      return DecompressBlock(index);
+    }
+  }
+  // All blocks are decompressed, copy the pages they do not overlap.
+  return CopyCompletePages(0u, num_pages_);
+}
+
+bool LazyImageDecompressor::DecompressBlock(size_t index) {
+  const ImageHeader::Block& block = blocks_[index];
+  const uint64_t start = NanoTime();
+  std::string error_msg;
+  // The thread that touched the image cannot be given an error.
+  CHECK(block.Decompress(staging_map_.Begin(), compressed_map_.Begin(), &error_msg))
+      << "Failed to decompress block of image " << name_ << ": " << error_msg;
+  decompression_ns_ += NanoTime() - start;
+  decompressed_blocks_[index] = true;
+  const size_t begin_page = block.GetImageOffset() / kPageSize;
+  const size_t end_page =
+      RoundUp(static_cast<size_t>(block.GetImageOffset()) + block.GetImageSize(), kPageSize) /
+      kPageSize;
+  return CopyCompletePages(begin_page, end_page);
+}
+
+bool LazyImageDecompressor::CopyCompletePages(size_t begin_page, size_t end_page) {
+  size_t page = begin_page;
+  while (page != end_page) {
+    if (populated_pages_[page] || !IsPageComplete(page)) {
+      ++page;
+      continue;
+    }
+    size_t first_page = page;
+    do {
+      ++page;
+    } while (page != end_page && !populated_pages_[page] && IsPageComplete(page));
+    if (!CopyPages(first_page, page - first_page)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LazyImageDecompressor::CopyPages(size_t first_page, size_t count) {
+  uint8_t* const src = staging_map_.Begin() + first_page * kPageSize;
+  size_t done = 0u;
+  const size_t length = count * kPageSize;
+  while (done != length) {
+    struct uffdio_copy uffd_copy;
+    uffd_copy.src = reinterpret_cast<uintptr_t>(src + done);
+    uffd_copy.dst = reinterpret_cast<uintptr_t>(image_begin_ + first_page * kPageSize + done);
+    uffd_copy.len = length - done;
+    uffd_copy.mode = 0;
+    uffd_copy.copy = 0;
+    if (ioctl(uffd_.get(), UFFDIO_COPY, &uffd_copy) == 0) {
+      break;
+    }
+    if (errno == ENOENT) {
+      return false;  // The image was unmapped.
+    }
+    // The copy may be interrupted and stop part way.
+    CHECK_EQ(errno, EAGAIN) << "ioctl_userfaultfd: copy failed: " << strerror(errno);
+    if (uffd_copy.copy > 0) {
+      done += static_cast<size_t>(uffd_copy.copy);
+    }
+  }
+  std::fill_n(populated_pages_.begin() + first_page, count, true);
+  num_populated_pages_ += count;
+  // The staging pages are complete, so no block will be decompressed into them again.
+  madvise(src, length, MADV_DONTNEED);
+  return true;
+}
+
+bool LazyImageDecompressor::ZeroPage(size_t page) {
+  struct uffdio_zeropage uffd_zeropage;
+  uffd_zeropage.range.start = reinterpret_cast<uintptr_t>(image_begin_ + page * kPageSize);
+  uffd_zeropage.range.len = kPageSize;
+  uffd_zeropage.mode = 0;
+  if (ioctl(uffd_.get(), UFFDIO_ZEROPAGE, &uffd_zeropage) == 0) {
+    return true;
+  }
+  if (errno == ENOENT) {
+    return false;  // The image was unmapped.
+  }
+  // The page is present, the faulting thread just needs waking.
+  CHECK_EQ(errno, EEXIST) << "ioctl_userfaultfd: zeropage failed: " << strerror(errno);
+  CHECK_EQ(ioctl(uffd_.get(), UFFDIO_WAKE, &uffd_zeropage.range), 0)
+      << "ioctl_userfaultfd: wake failed: " << strerror(errno);
+  return true;
+}
+
+bool LazyImageDecompressor::IsPageComplete(size_t page) const {
+  auto [first, end] = GetBlocksOverlapping(page);
+  for (size_t i = first; i != end; ++i) {
+    if (!decompressed_blocks_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::pair<size_t, size_t> LazyImageDecompressor::GetBlocksOverlapping(size_t page) const {
+  const size_t page_begin = page * kPageSize;
+  const size_t page_end = page_begin + kPageSize;
+  // The first block ending after the start of the page.
+  auto it = std::upper_bound(blocks_.begin(),
+                             blocks_.end(),
+                             page_begin,
+                             [](size_t offset, const ImageHeader::Block& block) {
+                               return offset <
+                                   static_cast<size_t>(block.GetImageOffset()) +
+                                       block.GetImageSize();
+                             });
+  const size_t first = std::distance(blocks_.begin(), it);
+  size_t end = first;
+  while (end != blocks_.size() && blocks_[end].GetImageOffset() < page_end) {
+    ++end;
+  }
+  return {first, end};
+}
+
+void LazyImageDecompressor::DumpStats(const char* what) const {
+  VLOG(image) << what << " lazy decompression of image " << name_ << ": "
+              << num_blocks_on_fault_ << " blocks decompressed on first touch (" << num_faults_
+              << " faults), " << num_blocks_prefetched_ << " prefetched and "
+              << num_blocks_at_finish_ << " when finishing, out of " << blocks_.size()
+              << ", taking " << PrettyDuration(decompression_ns_) << "; "
+              << PrettySize(num_pages_before_finish_ * kPageSize) << " of "
+              << PrettySize(num_pages_ * kPageSize) << " populated before finishing";
+}
+
+}  // namespace space
+}  // namespace gc
+}  // namespace art
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_GC_SPACE_LAZY_IMAGE_DECOMPRESSOR_H_
+#define ART_RUNTIME_GC_SPACE_LAZY_IMAGE_DECOMPRESSOR_H_
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "android-base/unique_fd.h"
+#include "base/array_ref.h"
+#include "base/macros.h"
+#include "base/mem_map.h"
+#include "image.h"
+
+namespace art {
+namespace gc {
+namespace space {
+
+// Decompresses the blocks of a compressed image on first touch rather than when the image is
+// loaded. The image mapping is registered with userfaultfd in missing mode and a handler thread
+// serves the faults: it decompresses the blocks backing the faulting page into a staging mapping
+// and copies the pages it completed into the image. A page straddling two blocks is copied once
+// both are decompressed. Between faults, the handler prefetches the blocks of the hot sections.
+//
+// Like for the mark-compact collector, the userfaultfd only handles user mode faults where the
+// kernel allows it, so system calls reading pages not decompressed yet fail with EFAULT.
+// Lazy decompression must be finished before forking, as the child would see these pages as
+// zeros.
+class LazyImageDecompressor {
+ public:
+  // Register `image_map`, which must not have been touched yet, and start the handler thread.
+  // The image starts with `header`, followed by the `blocks` stored in `compressed_map`. The
+  // blocks overlapping `hot_sections` are prefetched, in order. Takes ownership of
+  // `compressed_map` and returns the decompressor on success. Returns null if userfaultfd is not
+  // available, in which case the caller should decompress the image eagerly.
+  static std::unique_ptr<LazyImageDecompressor> Create(const std::string& name,
+                                                       MemMap* image_map,
+                                                       ArrayRef<const uint8_t> header,
+                                                       ArrayRef<const ImageHeader::Block> blocks,
+                                                       MemMap&& compressed_map,
+                                                       ArrayRef<const ImageSection> hot_sections,
+                                                       /*out*/std::string* error_msg);
+
+  // Stop the handler thread. Pages not decompressed yet must not be touched afterwards, so
+  // this is only done when the image is unmapped, otherwise call Finish() first.
+  ~LazyImageDecompressor();
+
+  // Decompress the blocks not touched yet, stop the handler thread and unregister the image.
+  // Does nothing if already finished.
+  void Finish();
+
+  bool IsFinished() const {
+    return finished_;
+  }
+
+ private:
+  LazyImageDecompressor(const std::string& name,
+                        uint8_t* image_begin,
+                        size_t image_size,
+                        std::vector<ImageHeader::Block>&& blocks,
+                        MemMap&& compressed_map,
+                        MemMap&& staging_map,
+                        android::base::unique_fd&& uffd,
+                        android::base::unique_fd&& event_fd);
+
+  static void* Run(void* arg);
+
+  // Wake the handler thread to look at `finish_requested_` and `stop_requested_`.
+  void WakeHandler();
+  void JoinHandler();
+
+  // The handler thread loop, and its helpers. They return false if the image was unmapped.
+  void HandleFaults();
+  bool ServeFaults();
+  bool ServePage(size_t page);
+  bool Prefetch(bool finishing);
+  bool DecompressBlock(size_t index);
+  bool CopyCompletePages(size_t begin_page, size_t end_page);
+  bool CopyPages(size_t first_page, size_t count);
+  bool ZeroPage(size_t page);
+  bool IsPageComplete(size_t page) const;
+
+  // Return the range of `blocks_` overlapping the page.
+  std::pair<size_t, size_t> GetBlocksOverlapping(size_t page) const;
+
+  void DumpStats(const char* what) const;
+
+  const std::string name_;
+  uint8_t* const image_begin_;
+  const size_t num_pages_;
+  // Sorted by image offset.
+  const std::vector<ImageHeader::Block> blocks_;
+  MemMap compressed_map_;
+  // Decompressed blocks, with the header, before they are copied into the image.
+  MemMap staging_map_;
+  android::base::unique_fd uffd_;
+  // Written to wake the handler thread.
+  android::base::unique_fd event_fd_;
+  pthread_t pthread_;
+  bool joined_ = false;
+  bool finished_ = false;
+  std::atomic<bool> finish_requested_{false};
+  std::atomic<bool> stop_requested_{false};
+
+  // State of the handler thread, only read by other threads after it is joined.
+  std::vector<bool> decompressed_blocks_;
+  std::vector<bool> populated_pages_;
+  std::vector<size_t> hot_blocks_;
+  size_t next_hot_block_ = 0u;
+  size_t next_block_ = 0u;
+  size_t num_populated_pages_ = 0u;
+  size_t num_faults_ = 0u;
+  size_t num_blocks_on_fault_ = 0u;
+  size_t num_blocks_prefetched_ = 0u;
+  size_t num_blocks_at_finish_ = 0u;
+  size_t num_pages_before_finish_ = 0u;
+  uint64_t decompression_ns_ = 0u;
+
+  DISALLOW_COPY_AND_ASSIGN(LazyImageDecompressor);
+};
+
+}  // namespace space
+}  // namespace gc
+}  // namespace art
+
+#endif  // ART_RUNTIME_GC_SPACE_LAZY_IMAGE_DECOMPRESSOR_H_
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lazy_image_decompressor.h"
+
+#include <sys/mman.h>
+
+#include <vector>
+
+#include "base/common_art_test.h"
+#include "base/globals.h"
+
+namespace art {
+namespace gc {
+namespace space {
+
+class LazyImageDecompressorTest : public CommonArtTest {
+ protected:
+  // The header, then blocks with boundaries in the middle of pages, then a tail covered by no
+  // block which reads as zeros.
+  static constexpr size_t kHeaderSize = 100u;
+  static constexpr size_t kImageSize = 6 * kPageSize + 1000u;
+  static constexpr size_t kBlockEnds[] = {
+      kPageSize + kPageSize / 2, 4 * kPageSize + 200u, kImageSize - 50u};
+
+  void SetUp() override {
+    CommonArtTest::SetUp();
+    std::string error_msg;
+    expected_.resize(kImageSize, 0u);
+    for (size_t i = 0; i != kBlockEnds[arraysize(kBlockEnds) - 1u]; ++i) {
+      expected_[i] = static_cast<uint8_t>(i * 7u + i / kPageSize + 1u);
+    }
+    // The blocks are stored uncompressed at their image offset.
+    compressed_map_ = MemMap::MapAnonymous("compressed image",
+                                           kImageSize,
+                                           PROT_READ | PROT_WRITE,
+                                           /*low_4gb=*/ false,
+                                           &error_msg);
+    ASSERT_TRUE(compressed_map_.IsValid()) << error_msg;
+    memcpy(compressed_map_.Begin(), expected_.data(), kImageSize);
+    size_t offset = kHeaderSize;
+    for (size_t end : kBlockEnds) {
+      blocks_.emplace_back(ImageHeader::kStorageModeUncompressed, offset, end - offset, offset,
+                           end - offset);
+      offset = end;
+    }
+    image_map_ = MemMap::MapAnonymous("lazy image",
+                                      kImageSize,
+                                      PROT_READ | PROT_WRITE,
+                                      /*low_4gb=*/ false,
+                                      &error_msg);
+    ASSERT_TRUE(image_map_.IsValid()) << error_msg;
+  }
+
+  std::unique_ptr<LazyImageDecompressor> Create(ArrayRef<const ImageSection> hot_sections) {
+    std::string error_msg;
+    std::unique_ptr<LazyImageDecompressor> decompressor = LazyImageDecompressor::Create(
+        "lazy image",
+        &image_map_,
+        ArrayRef<const uint8_t>(expected_.data(), kHeaderSize),
+        ArrayRef<const ImageHeader::Block>(blocks_),
+        std::move(compressed_map_),
+        hot_sections,
+        &error_msg);
+    if (decompressor == nullptr) {
+      LOG(WARNING) << "Lazy image decompression is not available: " << error_msg;
+    }
+    return decompressor;
+  }
+
+  bool ImageMatches() const {
+    return memcmp(image_map_.Begin(), expected_.data(), kImageSize) == 0;
+  }
+
+  std::vector<uint8_t> expected_;
+  std::vector<ImageHeader::Block> blocks_;
+  MemMap compressed_map_;
+  MemMap image_map_;
+};
+
+TEST_F(LazyImageDecompressorTest, DecompressesOnTouch) {
+  std::unique_ptr<LazyImageDecompressor> decompressor = Create({});
+  if (decompressor == nullptr) {
+    GTEST_SKIP() << "userfaultfd is not available";
+  }
+  // A page straddling two blocks, then the tail.
+  EXPECT_EQ(expected_[4 * kPageSize + 100u], image_map_.Begin()[4 * kPageSize + 100u]);
+  EXPECT_EQ(0u, image_map_.Begin()[kImageSize - 1u]);
+  EXPECT_TRUE(ImageMatches());
+  EXPECT_FALSE(decompressor->IsFinished());
+  decompressor->Finish();
+  EXPECT_TRUE(decompressor->IsFinished());
+  EXPECT_TRUE(ImageMatches());
+}
+
+TEST_F(LazyImageDecompressorTest, FinishWithoutTouching) {
+  const ImageSection hot_sections[] = {ImageSection(2 * kPageSize, kPageSize)};
+  std::unique_ptr<LazyImageDecompressor> decompressor =
+      Create(ArrayRef<const ImageSection>(hot_sections));
+  if (decompressor == nullptr) {
+    GTEST_SKIP() << "userfaultfd is not available";
+  }
+  decompressor->Finish();
+  EXPECT_TRUE(ImageMatches());
+  decompressor->Finish();
+}
+
+TEST_F(LazyImageDecompressorTest, ReleasedPagesReadAsZeros) {
+  std::unique_ptr<LazyImageDecompressor> decompressor = Create({});
+  if (decompressor == nullptr) {
+    GTEST_SKIP() << "userfaultfd is not available";
+  }
+  ASSERT_TRUE(ImageMatches());
+  // Like ImageSpace::ReleaseMetadata().
+  ASSERT_EQ(0, madvise(image_map_.Begin() + 2 * kPageSize, kPageSize, MADV_DONTNEED));
+  std::fill_n(expected_.begin() + 2 * kPageSize, kPageSize, 0u);
+  EXPECT_TRUE(ImageMatches());
+  decompressor->Finish();
+  EXPECT_TRUE(ImageMatches());
+}
+
+TEST_F(LazyImageDecompressorTest, StopsWhenDestroyed) {
+  std::unique_ptr<LazyImageDecompressor> decompressor = Create({});
+  if (decompressor == nullptr) {
+    GTEST_SKIP() << "userfaultfd is not available";
+  }
+  EXPECT_EQ(expected_[kPageSize], image_map_.Begin()[kPageSize]);
+  decompressor.reset();
+  image_map_.Reset();
+}
+
+}  // namespace space
+}  // namespace gc
+}  // namespace art
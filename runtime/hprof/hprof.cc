@@ -26,17 +26,24 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sched.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/time.h>
 #include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
+#include <zlib.h>
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <set>
+#include <thread>
 
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
+#include <android-base/strings.h>
 
 #include "art_field-inl.h"
 #include "art_method-inl.h"
@@ -67,6 +74,7 @@
 #include "runtime_globals.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 
 namespace art {
 
@@ -80,6 +88,17 @@ static constexpr uint32_t kHprofNullThread = 0;
 static constexpr size_t kMaxObjectsPerSegment = 128;
 static constexpr size_t kMaxBytesPerSegment = 4096;
 
+// Dumps to files are streamed in blocks of this size, each compressed separately.
+static constexpr size_t kStreamBlockSize = 1 * MB;
+// Maximum number of blocks not yet written, bounds the memory used for streaming.
+static constexpr size_t kMaxPendingStreamBlocks = 16;
+// Maximum number of threads compressing and writing the dump.
+static constexpr size_t kMaxStreamWorkers = 4;
+// Favor speed, heap dumps compress well even at the lowest level.
+static constexpr int kStreamCompressionLevel = Z_BEST_SPEED;
+// Dumps to files with this suffix are compressed.
+static constexpr const char* kCompressedSuffix = ".gz";
+
 // The static field-name for the synthetic object generated to account for class static overhead.
 static constexpr const char* kClassOverheadName = "$classOverhead";
 
@@ -388,56 +407,255 @@ class EndianOutputBuffered : public EndianOutput {
   std::vector<uint8_t> buffer_;
 };
 
-class FileEndianOutput final : public EndianOutputBuffered {
+class VectorEndianOuputput final : public EndianOutputBuffered {
+ public:
+  VectorEndianOuputput(std::vector<uint8_t>& data, size_t reserved_size)
+      : EndianOutputBuffered(reserved_size), full_data_(data) {}
+  ~VectorEndianOuputput() {}
+
+ protected:
+  void HandleFlush(const uint8_t* buf, size_t length) override {
+    size_t old_size = full_data_.size();
+    full_data_.resize(old_size + length);
+    memcpy(full_data_.data() + old_size, buf, length);
+  }
+
+ private:
+  std::vector<uint8_t>& full_data_;
+};
+
+// Streams the dump to a file in blocks, optionally compressing each block into a separate gzip
+// member. Concatenated members make a valid gzip file. Blocks are compressed and written by the
+// workers of a thread pool, in the order they were produced, while the heap is still being
+// visited. Finish() completes the remaining blocks and does not need the mutators suspended.
+class StreamingFileEndianOutput final : public EndianOutputBuffered {
  public:
-  FileEndianOutput(File* fp, size_t reserved_size)
-      : EndianOutputBuffered(reserved_size), fp_(fp), errors_(false) {
+  StreamingFileEndianOutput(File* fp, size_t reserved_size, ThreadPool* thread_pool, bool compress)
+      : EndianOutputBuffered(reserved_size),
+        fp_(fp),
+        thread_pool_(thread_pool),
+        compress_(compress),
+        lock_("hprof stream lock", kGenericBottomLock),
+        writing_(false),
+        errors_(false),
+        bytes_written_(0u) {
     DCHECK(fp != nullptr);
   }
-  ~FileEndianOutput() {
+  ~StreamingFileEndianOutput() {
+    DCHECK(blocks_.empty());
+  }
+
+  // Process and write the remaining blocks. Returns false if anything failed.
+  bool Finish(Thread* self) {
+    if (current_ != nullptr) {
+      Submit(self);
+    }
+    while (HelpOrYield(self)) {}
+    if (thread_pool_ != nullptr) {
+      // Tasks for blocks processed by other threads may still reference this output.
+      thread_pool_->Wait(self, /* do_work= */ true, /* may_hold_locks= */ false);
+    }
+    return !errors_.load(std::memory_order_relaxed);
   }
 
-  bool Errors() {
-    return errors_;
+  // Number of bytes written to the file, after compression.
+  size_t BytesWritten() const {
+    return bytes_written_.load(std::memory_order_relaxed);
   }
 
  protected:
   void HandleFlush(const uint8_t* buffer, size_t length) override {
-    if (!errors_) {
-      errors_ = !fp_->WriteFully(buffer, length);
+    if (current_ == nullptr) {
+      current_ = std::make_shared<Block>();
+      current_->data.reserve(kStreamBlockSize);
+    }
+    current_->data.insert(current_->data.end(), buffer, buffer + length);
+    if (current_->data.size() >= kStreamBlockSize) {
+      Submit(Thread::Current());
     }
   }
 
  private:
-  File* fp_;
-  bool errors_;
-};
+  enum BlockState : uint32_t {
+    kQueued,
+    kClaimed,
+    kProcessed,
+  };
 
-class VectorEndianOuputput final : public EndianOutputBuffered {
- public:
-  VectorEndianOuputput(std::vector<uint8_t>& data, size_t reserved_size)
-      : EndianOutputBuffered(reserved_size), full_data_(data) {}
-  ~VectorEndianOuputput() {}
+  struct Block {
+    // The dump data, replaced by the compressed data when processed.
+    std::vector<uint8_t> data;
+    std::atomic<uint32_t> state{kQueued};
+  };
 
- protected:
-  void HandleFlush(const uint8_t* buf, size_t length) override {
-    size_t old_size = full_data_.size();
-    full_data_.resize(old_size + length);
-    memcpy(full_data_.data() + old_size, buf, length);
+  class BlockTask final : public Task {
+   public:
+    BlockTask(StreamingFileEndianOutput* output, std::shared_ptr<Block> block)
+        : output_(output), block_(std::move(block)) {}
+
+    void Run(Thread* self) override {
+      output_->ProcessBlock(self, block_.get());
+    }
+
+    void Finalize() override {
+      delete this;
+    }
+
+   private:
+    StreamingFileEndianOutput* const output_;
+    const std::shared_ptr<Block> block_;
+  };
+
+  void Submit(Thread* self) {
+    std::shared_ptr<Block> block = std::move(current_);
+    size_t pending;
+    {
+      MutexLock mu(self, lock_);
+      blocks_.push_back(block);
+      pending = blocks_.size();
+    }
+    if (thread_pool_ != nullptr && thread_pool_->GetThreadCount() != 0u) {
+      thread_pool_->AddTask(self, new BlockTask(this, std::move(block)));
+    } else {
+      ProcessBlock(self, block.get());
+    }
+    // Don't let the heap visit run too far ahead of the workers.
+    while (pending > kMaxPendingStreamBlocks && HelpOrYield(self)) {
+      MutexLock mu(self, lock_);
+      pending = blocks_.size();
+    }
   }
 
- private:
-  std::vector<uint8_t>& full_data_;
+  // Process the oldest block nobody claimed yet, or yield if there is none. Returns false once
+  // all the blocks are written.
+  bool HelpOrYield(Thread* self) {
+    std::shared_ptr<Block> queued;
+    {
+      MutexLock mu(self, lock_);
+      if (blocks_.empty()) {
+        return false;
+      }
+      for (const std::shared_ptr<Block>& block : blocks_) {
+        if (block->state.load(std::memory_order_relaxed) == kQueued) {
+          queued = block;
+          break;
+        }
+      }
+    }
+    if (queued != nullptr) {
+      ProcessBlock(self, queued.get());
+    } else {
+      sched_yield();
+    }
+    return true;
+  }
+
+  void ProcessBlock(Thread* self, Block* block) {
+    uint32_t expected = kQueued;
+    if (!block->state.compare_exchange_strong(expected, kClaimed, std::memory_order_relaxed)) {
+      // Another thread got to it first.
+      return;
+    }
+    if (compress_ && !errors_.load(std::memory_order_relaxed)) {
+      std::vector<uint8_t> compressed;
+      if (Compress(block->data, &compressed)) {
+        block->data.swap(compressed);
+      } else {
+        errors_.store(true, std::memory_order_relaxed);
+      }
+    }
+    block->state.store(kProcessed, std::memory_order_release);
+    WriteProcessedBlocks(self);
+  }
+
+  // Write the processed blocks at the front of the queue. Only one thread writes at a time, the
+  // others leave their blocks to it.
+  void WriteProcessedBlocks(Thread* self) {
+    {
+      MutexLock mu(self, lock_);
+      if (writing_) {
+        return;
+      }
+      writing_ = true;
+    }
+    while (true) {
+      std::shared_ptr<Block> block;
+      {
+        MutexLock mu(self, lock_);
+        // Checking and clearing `writing_` together ensures that a block processed meanwhile
+        // is seen by either this thread or the one that processed it.
+        if (blocks_.empty() ||
+            blocks_.front()->state.load(std::memory_order_acquire) != kProcessed) {
+          writing_ = false;
+          return;
+        }
+        block = std::move(blocks_.front());
+        blocks_.pop_front();
+      }
+      if (!errors_.load(std::memory_order_relaxed)) {
+        if (fp_->WriteFully(block->data.data(), block->data.size())) {
+          bytes_written_.fetch_add(block->data.size(), std::memory_order_relaxed);
+        } else {
+          errors_.store(true, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  static bool Compress(const std::vector<uint8_t>& in, std::vector<uint8_t>* out) {
+    z_stream stream = {};
+    // Window bits of 15 + 16 for a gzip header and trailer.
+    if (deflateInit2(&stream,
+                     kStreamCompressionLevel,
+                     Z_DEFLATED,
+                     15 + 16,
+                     /* memLevel= */ 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      return false;
+    }
+    out->resize(deflateBound(&stream, in.size()));
+    stream.next_in = const_cast<uint8_t*>(in.data());
+    stream.avail_in = in.size();
+    stream.next_out = out->data();
+    stream.avail_out = out->size();
+    int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+      return false;
+    }
+    out->resize(stream.total_out);
+    return true;
+  }
+
+  File* const fp_;
+  ThreadPool* const thread_pool_;
+  const bool compress_;
+
+  // The block being filled by the heap visit.
+  std::shared_ptr<Block> current_;
+
+  Mutex lock_;
+  // Blocks not written yet, in the order of the dump.
+  std::deque<std::shared_ptr<Block>> blocks_ GUARDED_BY(lock_);
+  // Whether a thread is writing blocks.
+  bool writing_ GUARDED_BY(lock_);
+
+  std::atomic<bool> errors_;
+  std::atomic<size_t> bytes_written_;
 };
 
 #define __ output_->
 
 class Hprof : public SingleRootVisitor {
  public:
-  Hprof(const char* output_filename, int fd, bool direct_to_ddms)
+  // Dumps to files are compressed and written by the workers of "thread_pool", if not null.
+  Hprof(const char* output_filename, int fd, bool direct_to_ddms, ThreadPool* thread_pool)
       : filename_(output_filename),
         fd_(fd),
-        direct_to_ddms_(direct_to_ddms) {
+        direct_to_ddms_(direct_to_ddms),
+        compress_(!direct_to_ddms &&
+                  android::base::EndsWith(output_filename, kCompressedSuffix)),
+        thread_pool_(thread_pool) {
     LOG(INFO) << "hprof: heap dump \"" << filename_ << "\" starting...";
   }
 
@@ -472,7 +690,9 @@ class Hprof : public SingleRootVisitor {
         okay = DumpToDdmsBuffered(overall_size, max_length);
       }
     } else {
-      okay = DumpToFile(overall_size, max_length);
+      // Completed by FinishDump().
+      DumpToFile(overall_size, max_length);
+      return;
     }
 
     if (okay) {
@@ -484,6 +704,38 @@ class Hprof : public SingleRootVisitor {
     }
   }
 
+  // Write the rest of a dump to a file, after the mutators have been resumed.
+  void FinishDump(Thread* self) REQUIRES(!Locks::mutator_lock_) {
+    if (file_output_ == nullptr) {
+      // Dumped to DDMS, or failed to open the file.
+      return;
+    }
+    bool okay = file_output_->Finish(self);
+    const size_t bytes_written = file_output_->BytesWritten();
+    file_output_.reset();
+    if (okay) {
+      okay = file_->FlushCloseOrErase() == 0;
+    } else {
+      file_->Erase();
+    }
+    file_.reset();
+    if (!okay) {
+      std::string msg(android::base::StringPrintf("Couldn't dump heap; writing \"%s\" failed: %s",
+                                                  filename_.c_str(),
+                                                  strerror(errno)));
+      ScopedObjectAccess soa(self);
+      ThrowRuntimeException("%s", msg.c_str());
+      LOG(ERROR) << msg;
+      return;
+    }
+    const uint64_t duration = NanoTime() - start_ns_;
+    LOG(INFO) << "hprof: heap dump completed (" << PrettySize(RoundUp(overall_size_, KB))
+              << (compress_ ? ", compressed to " + PrettySize(RoundUp(bytes_written, KB)) : "")
+              << ") in " << PrettyDuration(duration)
+              << " objects " << total_objects_
+              << " objects with stack traces " << total_objects_with_stack_trace_;
+  }
+
  private:
   void DumpHeapObject(mirror::Object* obj)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -775,36 +1027,19 @@ class Hprof : public SingleRootVisitor {
       }
     }
 
-    std::unique_ptr<File> file(new File(out_fd, filename_, true));
-    bool okay;
-    {
-      FileEndianOutput file_output(file.get(), max_length);
-      output_ = &file_output;
-      ProcessHeap(true);
-      okay = !file_output.Errors();
-
-      if (okay) {
-        // Check for expected size. Output is expected to be less-or-equal than first phase, see
-        // b/23521263.
-        DCHECK_LE(file_output.SumLength(), overall_size);
-      }
-      output_ = nullptr;
-    }
-
-    if (okay) {
-      okay = file->FlushCloseOrErase() == 0;
-    } else {
-      file->Erase();
-    }
-    if (!okay) {
-      std::string msg(android::base::StringPrintf("Couldn't dump heap; writing \"%s\" failed: %s",
-                                                  filename_.c_str(),
-                                                  strerror(errno)));
-      ThrowRuntimeException("%s", msg.c_str());
-      LOG(ERROR) << msg;
-    }
-
-    return okay;
+    // The blocks are compressed and written while the heap is visited, and the ones left once
+    // done are written by FinishDump() without holding the mutators.
+    file_.reset(new File(out_fd, filename_, true));
+    file_output_.reset(
+        new StreamingFileEndianOutput(file_.get(), max_length, thread_pool_, compress_));
+    output_ = file_output_.get();
+    ProcessHeap(true);
+    // Check for expected size. Output is expected to be less-or-equal than first phase, see
+    // b/23521263.
+    DCHECK_LE(file_output_->SumLength(), overall_size);
+    output_ = nullptr;
+    overall_size_ = overall_size;
+    return true;
   }
 
   bool DumpToDdmsDirect(size_t overall_size, size_t max_length, uint32_t chunk_type)
@@ -876,6 +1111,14 @@ class Hprof : public SingleRootVisitor {
   std::string filename_;
   int fd_;
   bool direct_to_ddms_;
+  // Whether the dump to the file is compressed with gzip.
+  const bool compress_;
+  ThreadPool* const thread_pool_;
+
+  // The file being dumped to and its output, kept until FinishDump().
+  std::unique_ptr<File> file_;
+  std::unique_ptr<StreamingFileEndianOutput> file_output_;
+  size_t overall_size_ = 0u;
 
   uint64_t start_ns_ = NanoTime();
 
@@ -1601,14 +1844,27 @@ void Hprof::VisitRoot(mirror::Object* obj, const RootInfo& info) {
 void DumpHeap(const char* filename, int fd, bool direct_to_ddms) {
   CHECK(filename != nullptr);
   Thread* self = Thread::Current();
-  // Need to take a heap dump while GC isn't running. See the comment in Heap::VisitObjects().
-  // Also we need the critical section to avoid visiting the same object twice. See b/34967844
-  gc::ScopedGCCriticalSection gcs(self,
-                                  gc::kGcCauseHprof,
-                                  gc::kCollectorTypeHprof);
-  ScopedSuspendAll ssa(__FUNCTION__, true /* long suspend */);
-  Hprof hprof(filename, fd, direct_to_ddms);
-  hprof.Dump();
+  // Workers compressing and writing the dump while the heap is visited. Started before
+  // suspending so that they are attached, the visiting thread does the work if there are none.
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (!direct_to_ddms) {
+    size_t num_workers = std::min<size_t>(kMaxStreamWorkers, std::thread::hardware_concurrency());
+    num_workers = num_workers > 1u ? num_workers - 1u : 0u;
+    thread_pool.reset(new ThreadPool("Hprof thread pool", num_workers));
+    thread_pool->StartWorkers(self);
+    thread_pool->WaitForWorkersToBeCreated();
+  }
+  Hprof hprof(filename, fd, direct_to_ddms, thread_pool.get());
+  {
+    // Need to take a heap dump while GC isn't running. See the comment in Heap::VisitObjects().
+    // Also we need the critical section to avoid visiting the same object twice. See b/34967844
+    gc::ScopedGCCriticalSection gcs(self,
+                                    gc::kGcCauseHprof,
+                                    gc::kCollectorTypeHprof);
+    ScopedSuspendAll ssa(__FUNCTION__, true /* long suspend */);
+    hprof.Dump();
+  }
+  hprof.FinishDump(self);
 }
 
 }  // namespace hprof
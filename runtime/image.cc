@@ -21,6 +21,7 @@
 #include <sstream>
 #include <sys/stat.h>
 #include <zlib.h>
+#include <zstd.h>
 
 #include "android-base/stringprintf.h"
 
@@ -196,6 +197,61 @@ bool LZ4_decompress_safe_checked(const char* source,
   }
 }
 
+// Compression level used for kStorageModeZstd. Images are compressed on device by dex2oat,
+// where the high levels are too slow, and zstd decompression speed does not depend much on
+// the level.
+static constexpr int kZstdCompressionLevel = 3;
+
+static bool ZSTD_decompress_checked(const uint8_t* source,
+                                    uint8_t* dest,
+                                    size_t compressed_size,
+                                    size_t max_decompressed_size,
+                                    /*out*/ size_t* decompressed_size_checked,
+                                    /*out*/ std::string* error_msg) {
+  size_t decompressed_size = ZSTD_decompress(dest, max_decompressed_size, source, compressed_size);
+  if (UNLIKELY(ZSTD_isError(decompressed_size))) {
+    if (error_msg != nullptr) {
+      *error_msg = android::base::StringPrintf("ZSTD_decompress() failed: %s",
+                                               ZSTD_getErrorName(decompressed_size));
+    }
+    return false;
+  }
+  *decompressed_size_checked = decompressed_size;
+  return true;
+}
+
+// Decompress `source` stored with `image_storage_mode` into `dest`.
+static bool DecompressData(ArrayRef<const uint8_t> source,
+                           ImageHeader::StorageMode image_storage_mode,
+                           ArrayRef<uint8_t> dest,
+                           /*out*/ size_t* decompressed_size,
+                           /*out*/ std::string* error_msg) {
+  switch (image_storage_mode) {
+    case ImageHeader::kStorageModeLZ4:
+    case ImageHeader::kStorageModeLZ4HC:
+      // LZ4HC and LZ4 have same internal format, both use LZ4_decompress.
+      return LZ4_decompress_safe_checked(reinterpret_cast<const char*>(source.data()),
+                                         reinterpret_cast<char*>(dest.data()),
+                                         source.size(),
+                                         dest.size(),
+                                         decompressed_size,
+                                         error_msg);
+    case ImageHeader::kStorageModeZstd:
+      // Each block is an independent zstd frame, so blocks can be decompressed in parallel.
+      return ZSTD_decompress_checked(source.data(),
+                                     dest.data(),
+                                     source.size(),
+                                     dest.size(),
+                                     decompressed_size,
+                                     error_msg);
+    default:
+      if (error_msg != nullptr) {
+        *error_msg = (std::ostringstream() << "Invalid image format " << image_storage_mode).str();
+      }
+      return false;
+  }
+}
+
 bool ImageHeader::Block::Decompress(uint8_t* out_ptr,
                                     const uint8_t* in_ptr,
                                     std::string* error_msg) const {
@@ -206,16 +262,14 @@ bool ImageHeader::Block::Decompress(uint8_t* out_ptr,
       break;
     }
     case kStorageModeLZ4:
-    case kStorageModeLZ4HC: {
-      // LZ4HC and LZ4 have same internal format, both use LZ4_decompress.
+    case kStorageModeLZ4HC:
+    case kStorageModeZstd: {
       size_t decompressed_size;
-      bool ok = LZ4_decompress_safe_checked(
-          reinterpret_cast<const char*>(in_ptr) + data_offset_,
-          reinterpret_cast<char*>(out_ptr) + image_offset_,
-          data_size_,
-          image_size_,
-          &decompressed_size,
-          error_msg);
+      bool ok = DecompressData(ArrayRef<const uint8_t>(in_ptr + data_offset_, data_size_),
+                               storage_mode_,
+                               ArrayRef<uint8_t>(out_ptr + image_offset_, image_size_),
+                               &decompressed_size,
+                               error_msg);
       if (!ok) {
         return false;
       }
@@ -281,6 +335,17 @@ static ArrayRef<const uint8_t> MaybeCompressData(ArrayRef<const uint8_t> source,
       storage->resize(data_size);
       break;
     }
+    case ImageHeader::kStorageModeZstd: {
+      storage->resize(ZSTD_compressBound(source.size()));
+      size_t data_size = ZSTD_compress(storage->data(),
+                                       storage->size(),
+                                       source.data(),
+                                       source.size(),
+                                       kZstdCompressionLevel);
+      CHECK(!ZSTD_isError(data_size)) << ZSTD_getErrorName(data_size);
+      storage->resize(data_size);
+      break;
+    }
     case ImageHeader::kStorageModeUncompressed: {
       return source;
     }
@@ -291,20 +356,19 @@ static ArrayRef<const uint8_t> MaybeCompressData(ArrayRef<const uint8_t> source,
   }
 
   DCHECK(image_storage_mode == ImageHeader::kStorageModeLZ4 ||
-         image_storage_mode == ImageHeader::kStorageModeLZ4HC);
+         image_storage_mode == ImageHeader::kStorageModeLZ4HC ||
+         image_storage_mode == ImageHeader::kStorageModeZstd);
   VLOG(image) << "Compressed from " << source.size() << " to " << storage->size() << " in "
               << PrettyDuration(NanoTime() - compress_start_time);
   if (kIsDebugBuild) {
     dchecked_vector<uint8_t> decompressed(source.size());
     size_t decompressed_size;
     std::string error_msg;
-    bool ok = LZ4_decompress_safe_checked(
-        reinterpret_cast<char*>(storage->data()),
-        reinterpret_cast<char*>(decompressed.data()),
-        storage->size(),
-        decompressed.size(),
-        &decompressed_size,
-        &error_msg);
+    bool ok = DecompressData(ArrayRef<const uint8_t>(*storage),
+                             image_storage_mode,
+                             ArrayRef<uint8_t>(decompressed),
+                             &decompressed_size,
+                             &error_msg);
     if (!ok) {
       LOG(FATAL) << error_msg;
       UNREACHABLE();
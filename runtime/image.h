@@ -82,6 +82,7 @@ class PACKED(8) ImageHeader {
     kStorageModeUncompressed,
     kStorageModeLZ4,
     kStorageModeLZ4HC,
+    kStorageModeZstd,
     kStorageModeCount,  // Number of elements in enum.
   };
   static constexpr StorageMode kDefaultStorageMode = kStorageModeUncompressed;
@@ -110,6 +111,10 @@ class PACKED(8) ImageHeader {
       return data_size_;
     }
 
+    uint32_t GetImageOffset() const {
+      return image_offset_;
+    }
+
     uint32_t GetImageSize() const {
       return image_size_;
     }
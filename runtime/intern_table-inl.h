@@ -88,6 +88,42 @@ inline bool InternTable::StringEquals::operator()(const GcRoot<mirror::String>&
   }
 }
 
+template <typename Key>
+inline ObjPtr<mirror::String> InternTable::LookupCache::Find(const Key& key,
+                                                             uint32_t hash,
+                                                             bool include_weak) const {
+  const Storage* storage = storage_.load(std::memory_order_acquire);
+  if (storage == nullptr) {
+    return nullptr;
+  }
+  const size_t mask = storage->capacity - 1u;
+  const uint32_t expected_tag = MakeTag(hash, kEmpty);
+  for (size_t i = FirstIndex(hash, storage->capacity), probes = 0u;
+       probes != storage->capacity;
+       i = (i + 1u) & mask, ++probes) {
+    const Entry& entry = storage->entries[i];
+    // Pairs with the release store publishing the root in Add().
+    const uint32_t tag = entry.tag.load(std::memory_order_acquire);
+    const Kind kind = GetKind(tag);
+    if (kind == kEmpty) {
+      return nullptr;
+    }
+    if ((tag & ~kKindMask) != expected_tag ||
+        kind == kTombstone ||
+        (kind == kWeak && !include_weak)) {
+      continue;
+    }
+    // Compare the string reached through the read barrier, the slot may be a stale from-space
+    // reference. The slot may also have been reused since reading the tag, the comparison
+    // guarantees that we never return an unequal string.
+    ObjPtr<mirror::String> s = entry.root.Read();
+    if (s != nullptr && StringEquals()(GcRoot<mirror::String>(s), key)) {
+      return s;
+    }
+  }
+  return nullptr;
+}
+
 template <typename Visitor>
 inline void InternTable::AddImageStringsToTable(gc::space::ImageSpace* image_space,
                                                 const Visitor& visitor) {
@@ -16,8 +16,10 @@
 
 #include "intern_table-inl.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "base/bit_utils.h"
 #include "dex/utf.h"
 #include "gc/collector/garbage_collector.h"
 #include "gc/space/image_space.h"
@@ -39,7 +41,8 @@ namespace art {
 InternTable::InternTable()
     : log_new_roots_(false),
       weak_intern_condition_("New intern condition", *Locks::intern_table_lock_),
-      weak_root_state_(gc::kWeakRootStateNormal) {
+      weak_root_state_(gc::kWeakRootStateNormal),
+      weak_roots_readable_(true) {
 }
 
 size_t InternTable::Size() const {
@@ -65,6 +68,7 @@ void InternTable::VisitRoots(RootVisitor* visitor, VisitRootFlags flags) {
   MutexLock mu(Thread::Current(), *Locks::intern_table_lock_);
   if ((flags & kVisitRootFlagAllRoots) != 0) {
     strong_interns_.VisitRoots(visitor);
+    lookup_cache_.VisitRoots(visitor);
   } else if ((flags & kVisitRootFlagNewRoots) != 0) {
     for (auto& root : new_strong_intern_roots_) {
       ObjPtr<mirror::String> old_ref = root.Read<kWithoutReadBarrier>();
@@ -114,16 +118,34 @@ ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self, ObjPtr<mirror::St
   DCHECK(s != nullptr);
   // `String::GetHashCode()` ensures that the stored hash is calculated.
   uint32_t hash = static_cast<uint32_t>(s->GetHashCode());
+  ObjPtr<mirror::String> cached =
+      lookup_cache_.Find(GcRoot<mirror::String>(s), hash, /*include_weak=*/ false);
+  if (cached != nullptr) {
+    return cached;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
-  return strong_interns_.Find(s, hash);
+  ObjPtr<mirror::String> strong = strong_interns_.Find(s, hash);
+  if (strong != nullptr) {
+    lookup_cache_.Add(strong, hash, /*is_weak=*/ false);
+  }
+  return strong;
 }
 
 ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self,
                                                  uint32_t utf16_length,
                                                  const char* utf8_data) {
   uint32_t hash = Utf8String::Hash(utf16_length, utf8_data);
+  Utf8String string(utf16_length, utf8_data);
+  ObjPtr<mirror::String> cached = lookup_cache_.Find(string, hash, /*include_weak=*/ false);
+  if (cached != nullptr) {
+    return cached;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
-  return strong_interns_.Find(Utf8String(utf16_length, utf8_data), hash);
+  ObjPtr<mirror::String> strong = strong_interns_.Find(string, hash);
+  if (strong != nullptr) {
+    lookup_cache_.Add(strong, hash, /*is_weak=*/ false);
+  }
+  return strong;
 }
 
 ObjPtr<mirror::String> InternTable::LookupWeakLocked(ObjPtr<mirror::String> s) {
@@ -155,6 +177,7 @@ ObjPtr<mirror::String> InternTable::InsertStrong(ObjPtr<mirror::String> s, uint3
     new_strong_intern_roots_.push_back(GcRoot<mirror::String>(s));
   }
   strong_interns_.Insert(s, hash);
+  lookup_cache_.Add(s, hash, /*is_weak=*/ false);
   return s;
 }
 
@@ -164,10 +187,12 @@ ObjPtr<mirror::String> InternTable::InsertWeak(ObjPtr<mirror::String> s, uint32_
     runtime->RecordWeakStringInsertion(s);
   }
   weak_interns_.Insert(s, hash);
+  lookup_cache_.Add(s, hash, /*is_weak=*/ true);
   return s;
 }
 
 void InternTable::RemoveStrong(ObjPtr<mirror::String> s, uint32_t hash) {
+  lookup_cache_.Remove(s, hash);
   strong_interns_.Remove(s, hash);
 }
 
@@ -176,6 +201,7 @@ void InternTable::RemoveWeak(ObjPtr<mirror::String> s, uint32_t hash) {
   if (runtime->IsActiveTransaction()) {
     runtime->RecordWeakStringRemoval(s);
   }
+  lookup_cache_.Remove(s, hash);
   weak_interns_.Remove(s, hash);
 }
 
@@ -198,6 +224,11 @@ void InternTable::WaitUntilAccessible(Thread* self) {
   Locks::intern_table_lock_->ExclusiveLock(self);
 }
 
+bool InternTable::CanReadWeaksLockFree(Thread* self) const {
+  return gUseReadBarrier ? self->GetWeakRefAccessEnabled()
+                         : weak_roots_readable_.load(std::memory_order_acquire);
+}
+
 ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
                                            uint32_t hash,
                                            bool is_strong,
@@ -206,6 +237,12 @@ ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
   DCHECK_EQ(hash, static_cast<uint32_t>(s->GetStoredHashCode()));
   DCHECK_IMPLIES(hash == 0u, s->ComputeHashCode() == 0);
   Thread* const self = Thread::Current();
+  // A string interned in the weak table needs to be promoted to satisfy a strong intern.
+  ObjPtr<mirror::String> cached = lookup_cache_.Find(
+      GcRoot<mirror::String>(s), hash, /*include_weak=*/ !is_strong && CanReadWeaksLockFree(self));
+  if (cached != nullptr) {
+    return cached;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
   if (kDebugLocking) {
     Locks::mutator_lock_->AssertSharedHeld(self);
@@ -216,6 +253,7 @@ ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
     ObjPtr<mirror::String> strong =
         strong_interns_.Find(s, hash, num_searched_strong_frozen_tables);
     if (strong != nullptr) {
+      lookup_cache_.Add(strong, hash, /*is_weak=*/ false);
       return strong;
     }
     if (gUseReadBarrier ? self->GetWeakRefAccessEnabled()
@@ -243,6 +281,7 @@ ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
       RemoveWeak(weak, hash);
       return InsertStrong(weak, hash);
     }
+    lookup_cache_.Add(weak, hash, /*is_weak=*/ true);
     return weak;
   }
   // No match in the strong table or the weak table. Insert into the strong / weak table.
@@ -253,7 +292,11 @@ ObjPtr<mirror::String> InternTable::InternStrong(uint32_t utf16_length, const ch
   DCHECK(utf8_data != nullptr);
   uint32_t hash = Utf8String::Hash(utf16_length, utf8_data);
   Thread* self = Thread::Current();
-  ObjPtr<mirror::String> s;
+  ObjPtr<mirror::String> s =
+      lookup_cache_.Find(Utf8String(utf16_length, utf8_data), hash, /*include_weak=*/ false);
+  if (s != nullptr) {
+    return s;
+  }
   size_t num_searched_strong_frozen_tables;
   {
     // Try to avoid allocation. If we need to allocate, release the mutex before the allocation.
@@ -261,6 +304,9 @@ ObjPtr<mirror::String> InternTable::InternStrong(uint32_t utf16_length, const ch
     DCHECK(!strong_interns_.tables_.empty());
     num_searched_strong_frozen_tables = strong_interns_.tables_.size() - 1u;
     s = strong_interns_.Find(Utf8String(utf16_length, utf8_data), hash);
+    if (s != nullptr) {
+      lookup_cache_.Add(s, hash, /*is_weak=*/ false);
+    }
   }
   if (s != nullptr) {
     return s;
@@ -314,8 +360,14 @@ ObjPtr<mirror::String> InternTable::InternWeak(ObjPtr<mirror::String> s) {
 }
 
 void InternTable::SweepInternTableWeaks(IsMarkedVisitor* visitor) {
-  MutexLock mu(Thread::Current(), *Locks::intern_table_lock_);
-  weak_interns_.SweepWeaks(visitor);
+  Thread* self = Thread::Current();
+  MutexLock mu(self, *Locks::intern_table_lock_);
+  // The visitor must see every weak intern exactly once, so the lookup cache is updated from
+  // the outcome of sweeping the table instead of being swept on its own.
+  std::vector<std::pair<mirror::Object*, mirror::Object*>> swept;
+  weak_interns_.SweepWeaks(visitor, lookup_cache_.HasWeakEntries() ? &swept : nullptr);
+  std::sort(swept.begin(), swept.end());
+  lookup_cache_.SweepWeaks(swept, /*paused=*/ Locks::mutator_lock_->IsExclusiveHeld(self));
 }
 
 void InternTable::Table::Remove(ObjPtr<mirror::String> s, uint32_t hash) {
@@ -391,17 +443,24 @@ void InternTable::Table::VisitRoots(RootVisitor* visitor) {
   }
 }
 
-void InternTable::Table::SweepWeaks(IsMarkedVisitor* visitor) {
+void InternTable::Table::SweepWeaks(
+    IsMarkedVisitor* visitor, std::vector<std::pair<mirror::Object*, mirror::Object*>>* swept) {
   for (InternalTable& table : tables_) {
-    SweepWeaks(&table.set_, visitor);
+    SweepWeaks(&table.set_, visitor, swept);
   }
 }
 
-void InternTable::Table::SweepWeaks(UnorderedSet* set, IsMarkedVisitor* visitor) {
+void InternTable::Table::SweepWeaks(
+    UnorderedSet* set,
+    IsMarkedVisitor* visitor,
+    std::vector<std::pair<mirror::Object*, mirror::Object*>>* swept) {
   for (auto it = set->begin(), end = set->end(); it != end;) {
     // This does not need a read barrier because this is called by GC.
     mirror::Object* object = it->Read<kWithoutReadBarrier>();
     mirror::Object* new_object = visitor->IsMarked(object);
+    if (swept != nullptr && new_object != object) {
+      swept->emplace_back(object, new_object);
+    }
     if (new_object == nullptr) {
       it = set->erase(it);
     } else {
@@ -431,6 +490,8 @@ void InternTable::ChangeWeakRootState(gc::WeakRootState new_state) {
 void InternTable::ChangeWeakRootStateLocked(gc::WeakRootState new_state) {
   CHECK(!gUseReadBarrier);
   weak_root_state_ = new_state;
+  weak_roots_readable_.store(new_state != gc::kWeakRootStateNoReadsOrWrites,
+                             std::memory_order_release);
   if (new_state != gc::kWeakRootStateNoReadsOrWrites) {
     weak_intern_condition_.Broadcast(Thread::Current());
   }
@@ -444,4 +505,201 @@ InternTable::Table::Table() {
   tables_.push_back(std::move(initial_table));
 }
 
+InternTable::LookupCache::LookupCache()
+    : storage_(nullptr),
+      num_entries_(0u),
+      num_weak_entries_(0u),
+      num_tombstones_(0u) {}
+
+InternTable::LookupCache::~LookupCache() {
+  delete storage_.load(std::memory_order_relaxed);
+  for (Storage* storage : retired_) {
+    delete storage;
+  }
+  for (Storage* storage : retired_before_last_sweep_) {
+    delete storage;
+  }
+}
+
+InternTable::LookupCache::Entry* InternTable::LookupCache::FindEntry(Storage* storage,
+                                                                      ObjPtr<mirror::String> s,
+                                                                      uint32_t hash) {
+  const size_t mask = storage->capacity - 1u;
+  const uint32_t expected_tag = MakeTag(hash, kEmpty);
+  for (size_t i = FirstIndex(hash, storage->capacity), probes = 0u;
+       probes != storage->capacity;
+       i = (i + 1u) & mask, ++probes) {
+    Entry& entry = storage->entries[i];
+    const uint32_t tag = entry.tag.load(std::memory_order_relaxed);
+    const Kind kind = GetKind(tag);
+    if (kind == kEmpty) {
+      break;
+    }
+    // No read barrier, we hold the lock that the GC takes to sweep the entries.
+    if (kind != kTombstone &&
+        (tag & ~kKindMask) == expected_tag &&
+        StringEquals()(entry.root, GcRoot<mirror::String>(s))) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void InternTable::LookupCache::Add(ObjPtr<mirror::String> s, uint32_t hash, bool is_weak) {
+  Storage* storage = storage_.load(std::memory_order_relaxed);
+  if (storage != nullptr) {
+    Entry* entry = FindEntry(storage, s, hash);
+    if (entry != nullptr) {
+      const bool was_weak = GetKind(entry->tag.load(std::memory_order_relaxed)) == kWeak;
+      if (was_weak && !is_weak) {
+        --num_weak_entries_;
+      } else if (!was_weak && is_weak) {
+        ++num_weak_entries_;
+      }
+      entry->root = GcRoot<mirror::String>(s);
+      entry->tag.store(MakeTag(hash, is_weak ? kWeak : kStrong), std::memory_order_release);
+      return;
+    }
+  }
+  // Keep the load factor, counting tombstones, under 1/2.
+  if (storage == nullptr || 2u * (num_entries_ + num_tombstones_ + 1u) > storage->capacity) {
+    size_t capacity = (storage == nullptr) ? kMinCapacity : storage->capacity;
+    if (storage != nullptr && 4u * (num_entries_ + 1u) > capacity) {
+      if (capacity == kMaxCapacity) {
+        // The index is full, leave this string to the tables.
+        return;
+      }
+      capacity *= 2u;
+    }
+    Resize(capacity);
+    storage = storage_.load(std::memory_order_relaxed);
+  }
+  const size_t mask = storage->capacity - 1u;
+  size_t i = FirstIndex(hash, storage->capacity);
+  while (GetKind(storage->entries[i].tag.load(std::memory_order_relaxed)) >= kStrong) {
+    i = (i + 1u) & mask;
+  }
+  Entry& entry = storage->entries[i];
+  if (GetKind(entry.tag.load(std::memory_order_relaxed)) == kTombstone) {
+    --num_tombstones_;
+  }
+  entry.root = GcRoot<mirror::String>(s);
+  // Publish the root to lock-free readers.
+  entry.tag.store(MakeTag(hash, is_weak ? kWeak : kStrong), std::memory_order_release);
+  ++num_entries_;
+  if (is_weak) {
+    ++num_weak_entries_;
+  }
+}
+
+void InternTable::LookupCache::Remove(ObjPtr<mirror::String> s, uint32_t hash) {
+  Storage* storage = storage_.load(std::memory_order_relaxed);
+  Entry* entry = (storage != nullptr) ? FindEntry(storage, s, hash) : nullptr;
+  if (entry == nullptr) {
+    return;
+  }
+  if (GetKind(entry->tag.load(std::memory_order_relaxed)) == kWeak) {
+    --num_weak_entries_;
+  }
+  // Keep the root, a concurrent reader may still compare it.
+  entry->tag.store(MakeTag(hash, kTombstone), std::memory_order_release);
+  --num_entries_;
+  ++num_tombstones_;
+}
+
+void InternTable::LookupCache::Resize(size_t capacity) {
+  DCHECK(IsPowerOfTwo(capacity));
+  DCHECK_LT(2u * num_entries_, capacity);
+  Storage* old_storage = storage_.load(std::memory_order_relaxed);
+  Storage* new_storage = new Storage(capacity);
+  if (old_storage != nullptr) {
+    const size_t mask = capacity - 1u;
+    for (size_t j = 0; j != old_storage->capacity; ++j) {
+      const Entry& old_entry = old_storage->entries[j];
+      const uint32_t tag = old_entry.tag.load(std::memory_order_relaxed);
+      if (GetKind(tag) < kStrong) {
+        continue;
+      }
+      size_t i = FirstIndex(tag, capacity);
+      while (new_storage->entries[i].tag.load(std::memory_order_relaxed) != 0u) {
+        i = (i + 1u) & mask;
+      }
+      new_storage->entries[i].root = old_entry.root;
+      new_storage->entries[i].tag.store(tag, std::memory_order_relaxed);
+    }
+    // Readers may still be probing the old storage.
+    retired_.push_back(old_storage);
+  }
+  // Publish the entries together with the storage.
+  storage_.store(new_storage, std::memory_order_release);
+  num_tombstones_ = 0u;
+}
+
+void InternTable::LookupCache::VisitRoots(RootVisitor* visitor) {
+  Storage* storage = storage_.load(std::memory_order_relaxed);
+  if (storage == nullptr) {
+    return;
+  }
+  BufferedRootVisitor<kDefaultBufferedRootCount> buffered_visitor(
+      visitor, RootInfo(kRootInternedString));
+  for (size_t i = 0; i != storage->capacity; ++i) {
+    Entry& entry = storage->entries[i];
+    if (GetKind(entry.tag.load(std::memory_order_relaxed)) == kStrong) {
+      buffered_visitor.VisitRoot(entry.root);
+    }
+  }
+}
+
+void InternTable::LookupCache::SweepWeaks(
+    const std::vector<std::pair<mirror::Object*, mirror::Object*>>& swept, bool paused) {
+  Storage* storage = storage_.load(std::memory_order_relaxed);
+  if (storage != nullptr && !swept.empty()) {
+    DCHECK(std::is_sorted(swept.begin(), swept.end()));
+    for (size_t i = 0; i != storage->capacity; ++i) {
+      Entry& entry = storage->entries[i];
+      const uint32_t tag = entry.tag.load(std::memory_order_relaxed);
+      if (GetKind(tag) != kWeak) {
+        continue;
+      }
+      // Don't read the object, its content may not be there yet with the userfaultfd GC.
+      mirror::Object* object = entry.root.Read<kWithoutReadBarrier>().Ptr();
+      auto it = std::lower_bound(swept.begin(),
+                                 swept.end(),
+                                 object,
+                                 [](const std::pair<mirror::Object*, mirror::Object*>& pair,
+                                    mirror::Object* obj) { return pair.first < obj; });
+      if (it == swept.end() || it->first != object) {
+        continue;
+      }
+      if (it->second == nullptr) {
+        entry.tag.store(MakeTag(tag, kTombstone), std::memory_order_relaxed);
+        --num_entries_;
+        --num_weak_entries_;
+        ++num_tombstones_;
+      } else {
+        entry.root = GcRoot<mirror::String>(ObjPtr<mirror::String>::DownCast(it->second));
+      }
+    }
+  }
+  // Purge tombstones left by cleared weak interns, shrinking the storage if it is mostly unused.
+  if (storage != nullptr && 4u * num_tombstones_ > storage->capacity) {
+    size_t capacity =
+        std::clamp(RoundUpToPowerOfTwo(4u * num_entries_ + 1u), kMinCapacity, kMaxCapacity);
+    Resize(capacity);
+  }
+  for (Storage* retired : retired_before_last_sweep_) {
+    delete retired;
+  }
+  retired_before_last_sweep_.clear();
+  if (paused) {
+    // No reader can be in the middle of a lookup.
+    for (Storage* retired : retired_) {
+      delete retired;
+    }
+    retired_.clear();
+  } else {
+    retired_before_last_sweep_.swap(retired_);
+  }
+}
+
 }  // namespace art
@@ -17,8 +17,14 @@
 #ifndef ART_RUNTIME_INTERN_TABLE_H_
 #define ART_RUNTIME_INTERN_TABLE_H_
 
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "base/allocator.h"
 #include "base/dchecked_vector.h"
+#include "base/globals.h"
 #include "base/hash_set.h"
 #include "base/mutex.h"
 #include "gc/weak_root_state.h"
@@ -203,6 +209,106 @@ class InternTable {
       REQUIRES(!Locks::intern_table_lock_);
 
  private:
+  // Lock-free index of interned strings in front of the strong and weak tables, so that looking
+  // up strings that are already interned does not need `Locks::intern_table_lock_`. It is an
+  // open-addressed table with linear probing where each slot holds a hash-derived tag and the
+  // string. Only a bounded number of recently used interns is indexed, a miss falls back to the
+  // tables under the lock.
+  //
+  // Readers must be runnable and read the slots without any synchronization but acquire loads
+  // of the tags. Writers hold `Locks::intern_table_lock_`, never turn a used slot back to empty
+  // and publish a new storage to grow or to purge removed entries. Replaced storage is freed
+  // once every mutator has passed a suspend point, which is the case in a GC pause or at the
+  // second weak sweep after it was replaced, as there is a pause or checkpoint in between.
+  class LookupCache {
+   public:
+    LookupCache();
+    ~LookupCache();
+
+    // Returns the indexed string equal to `key`, or null. Weak interns are only returned if
+    // `include_weak` is true, which requires being able to read weak roots.
+    template <typename Key>
+    ObjPtr<mirror::String> Find(const Key& key, uint32_t hash, bool include_weak) const
+        REQUIRES_SHARED(Locks::mutator_lock_);
+
+    // Index a string interned in the strong or weak table, or update the strength of the
+    // entry if it is already indexed.
+    void Add(ObjPtr<mirror::String> s, uint32_t hash, bool is_weak)
+        REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
+    void Remove(ObjPtr<mirror::String> s, uint32_t hash)
+        REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
+
+    // Visit the strong entries, as done for the strong table.
+    void VisitRoots(RootVisitor* visitor)
+        REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
+
+    bool HasWeakEntries() const REQUIRES(Locks::intern_table_lock_) {
+      return num_weak_entries_ != 0u;
+    }
+
+    // Apply the outcome of sweeping the weak table, given as pairs of old and new addresses
+    // (null for cleared strings) sorted by old address. Also frees retired storage when safe.
+    void SweepWeaks(const std::vector<std::pair<mirror::Object*, mirror::Object*>>& swept,
+                    bool paused)
+        REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
+
+   private:
+    enum Kind : uint32_t {
+      kEmpty = 0u,
+      kTombstone = 1u,
+      kStrong = 2u,
+      kWeak = 3u,
+    };
+    static constexpr uint32_t kKindMask = 3u;
+    static constexpr size_t kMinCapacity = 1024u;
+    // Bounds the index to 512KiB.
+    static constexpr size_t kMaxCapacity = 64 * KB;
+
+    struct Entry {
+      std::atomic<uint32_t> tag{0u};
+      GcRoot<mirror::String> root;
+    };
+
+    struct Storage {
+      explicit Storage(size_t c) : capacity(c), entries(new Entry[c]) {}
+
+      const size_t capacity;
+      const std::unique_ptr<Entry[]> entries;
+    };
+
+    static uint32_t MakeTag(uint32_t hash, Kind kind) {
+      return (hash & ~kKindMask) | kind;
+    }
+
+    static Kind GetKind(uint32_t tag) {
+      return static_cast<Kind>(tag & kKindMask);
+    }
+
+    static size_t FirstIndex(uint32_t hash, size_t capacity) {
+      // The kind bits are not part of the tag hash and must not select the slot.
+      hash &= ~kKindMask;
+      return (hash ^ (hash >> 15)) & (capacity - 1u);
+    }
+
+    // Returns the slot holding a string equal to `s`, or null.
+    Entry* FindEntry(Storage* storage, ObjPtr<mirror::String> s, uint32_t hash)
+        REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
+
+    // Publish a new storage of `capacity` slots with the live entries, retiring the old one.
+    void Resize(size_t capacity)
+        REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
+
+    std::atomic<Storage*> storage_;
+    size_t num_entries_ GUARDED_BY(Locks::intern_table_lock_);
+    size_t num_weak_entries_ GUARDED_BY(Locks::intern_table_lock_);
+    size_t num_tombstones_ GUARDED_BY(Locks::intern_table_lock_);
+    // Storage replaced since the last weak sweep, and storage replaced before it.
+    std::vector<Storage*> retired_ GUARDED_BY(Locks::intern_table_lock_);
+    std::vector<Storage*> retired_before_last_sweep_ GUARDED_BY(Locks::intern_table_lock_);
+
+    DISALLOW_COPY_AND_ASSIGN(LookupCache);
+  };
+
   // Table which holds pre zygote and post zygote interned strings. There is one instance for
   // weak interns and strong interns.
   class Table {
@@ -248,7 +354,9 @@ class InternTable {
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
     void VisitRoots(RootVisitor* visitor)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
-    void SweepWeaks(IsMarkedVisitor* visitor)
+    // If `swept` is not null, record there the strings that were moved or cleared.
+    void SweepWeaks(IsMarkedVisitor* visitor,
+                    std::vector<std::pair<mirror::Object*, mirror::Object*>>* swept)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
     // Add a new intern table that will only be inserted into from now on.
     void AddNewTable() REQUIRES(Locks::intern_table_lock_);
@@ -262,7 +370,9 @@ class InternTable {
         REQUIRES(!Locks::intern_table_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
 
    private:
-    void SweepWeaks(UnorderedSet* set, IsMarkedVisitor* visitor)
+    void SweepWeaks(UnorderedSet* set,
+                    IsMarkedVisitor* visitor,
+                    std::vector<std::pair<mirror::Object*, mirror::Object*>>* swept)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
 
     // Add a table to the front of the tables vector.
@@ -308,6 +418,9 @@ class InternTable {
   void WaitUntilAccessible(Thread* self)
       REQUIRES(Locks::intern_table_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Whether `self` may read weak interns without holding `Locks::intern_table_lock_`.
+  bool CanReadWeaksLockFree(Thread* self) const REQUIRES_SHARED(Locks::mutator_lock_);
+
   bool log_new_roots_ GUARDED_BY(Locks::intern_table_lock_);
   ConditionVariable weak_intern_condition_ GUARDED_BY(Locks::intern_table_lock_);
   // Since this contains (strong) roots, they need a read barrier to
@@ -323,6 +436,10 @@ class InternTable {
   Table weak_interns_ GUARDED_BY(Locks::intern_table_lock_);
   // Weak root state, used for concurrent system weak processing and more.
   gc::WeakRootState weak_root_state_ GUARDED_BY(Locks::intern_table_lock_);
+  // Whether `weak_root_state_` allows reading weak roots, for lock-free lookups. Only turned
+  // off in a GC pause, so it cannot change during a lookup by a runnable thread.
+  std::atomic<bool> weak_roots_readable_;
+  LookupCache lookup_cache_;
 
   friend class gc::space::ImageSpace;
   friend class linker::ImageWriter;
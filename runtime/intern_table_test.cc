@@ -16,7 +16,14 @@
 
 #include "intern_table-inl.h"
 
+#include <string>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+
+#include "base/atomic.h"
 #include "base/hash_set.h"
+#include "base/time_utils.h"
 #include "common_runtime_test.h"
 #include "dex/utf.h"
 #include "gc_root-inl.h"
@@ -24,6 +31,7 @@
 #include "mirror/object.h"
 #include "mirror/string.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art {
 
@@ -152,6 +160,31 @@ TEST_F(InternTableTest, SweepInternTableWeaks) {
   EXPECT_EQ(3U, t.Size());
 }
 
+// Check that interns cleared by the GC are not found by the lock-free lookups anymore.
+TEST_F(InternTableTest, SweepInternTableWeaksLookupCache) {
+  ScopedObjectAccess soa(Thread::Current());
+  InternTable t;
+  StackHandleScope<3> hs(soa.Self());
+  Handle<mirror::String> hello_1(
+      hs.NewHandle(mirror::String::AllocFromModifiedUtf8(soa.Self(), "hello")));
+  Handle<mirror::String> hello_2(
+      hs.NewHandle(mirror::String::AllocFromModifiedUtf8(soa.Self(), "hello")));
+  Handle<mirror::String> interned(hs.NewHandle(t.InternWeak(hello_1.Get())));
+  ASSERT_EQ(hello_1.Get(), interned.Get());
+  // Served by the lookup cache.
+  EXPECT_OBJ_PTR_EQ(t.InternWeak(hello_2.Get()), hello_1.Get());
+
+  TestPredicate p;
+  p.Expect(hello_1.Get());
+  {
+    ReaderMutexLock mu(soa.Self(), *Locks::heap_bitmap_lock_);
+    t.SweepInternTableWeaks(&p);
+  }
+
+  EXPECT_EQ(0U, t.Size());
+  EXPECT_OBJ_PTR_EQ(t.InternWeak(hello_2.Get()), hello_2.Get());
+}
+
 TEST_F(InternTableTest, ContainsWeak) {
   ScopedObjectAccess soa(Thread::Current());
   auto ContainsWeak = [&](InternTable& t, ObjPtr<mirror::String> s)
@@ -263,4 +296,73 @@ TEST_F(InternTableTest, InternStrongFrozenWeak) {
   ASSERT_TRUE(strong_foo == foo.Get());
 }
 
+class InternLookupTask : public Task {
+ public:
+  InternLookupTask(InternTable* intern_table,
+                   const std::vector<std::string>* strings,
+                   size_t iterations,
+                   AtomicInteger* mismatches)
+      : intern_table_(intern_table),
+        strings_(strings),
+        iterations_(iterations),
+        mismatches_(mismatches) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    for (size_t i = 0; i != iterations_; ++i) {
+      for (const std::string& string : *strings_) {
+        ObjPtr<mirror::String> s = intern_table_->InternStrong(string.length(), string.c_str());
+        if (s == nullptr || !s->Equals(string.c_str())) {
+          ++*mismatches_;
+        }
+      }
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  InternTable* const intern_table_;
+  const std::vector<std::string>* const strings_;
+  const size_t iterations_;
+  AtomicInteger* const mismatches_;
+};
+
+// Microbenchmark for interning already interned strings from many threads, as done when loading
+// classes or parsing JSON.
+TEST_F(InternTableTest, ConcurrentInternBenchmark) {
+  static constexpr size_t kNumStrings = 4096;
+  static constexpr size_t kIterations = 16;
+  Thread* self = Thread::Current();
+  InternTable* intern_table = Runtime::Current()->GetInternTable();
+  std::vector<std::string> strings;
+  for (size_t i = 0; i != kNumStrings; ++i) {
+    strings.push_back(android::base::StringPrintf("field%zu", i));
+  }
+  {
+    ScopedObjectAccess soa(self);
+    for (const std::string& string : strings) {
+      ASSERT_TRUE(intern_table->InternStrong(string.length(), string.c_str()) != nullptr);
+    }
+  }
+  for (size_t num_threads : {1u, 2u, 4u, 8u}) {
+    ThreadPool thread_pool("Intern table test thread pool", num_threads);
+    AtomicInteger mismatches(0);
+    for (size_t i = 0; i != num_threads; ++i) {
+      thread_pool.AddTask(
+          self, new InternLookupTask(intern_table, &strings, kIterations, &mismatches));
+    }
+    const uint64_t start = NanoTime();
+    thread_pool.StartWorkers(self);
+    thread_pool.Wait(self, false, false);
+    const uint64_t duration = NanoTime() - start;
+    EXPECT_EQ(0, mismatches.load(std::memory_order_seq_cst));
+    LOG(INFO) << "Threads: " << num_threads
+              << " interns: " << num_threads * kIterations * kNumStrings
+              << " time: " << PrettyDuration(duration);
+  }
+}
+
 }  // namespace art
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "allocation_site_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+#include "android-base/logging.h"
+#include "art_method-inl.h"
+#include "base/utils.h"
+#include "mirror/class-inl.h"
+
+namespace art {
+
+void AllocationSiteProfiler::Record(ArtMethod* method,
+                                    uint32_t dex_pc,
+                                    ObjPtr<mirror::Class> klass,
+                                    size_t byte_count,
+                                    size_t sampling_interval) {
+  // An allocation of `byte_count` bytes is sampled with probability
+  // 1 - exp(-byte_count / sampling_interval), weigh the sample by the inverse.
+  double probability = (sampling_interval <= 1u)
+      ? 1.0
+      : -std::expm1(-static_cast<double>(byte_count) / static_cast<double>(sampling_interval));
+  double weight = 1.0 / std::max(probability, 1e-9);
+  uint64_t objects = static_cast<uint64_t>(std::llround(weight));
+  uint64_t bytes = static_cast<uint64_t>(std::llround(weight * static_cast<double>(byte_count)));
+
+  auto add = [&](Site* site) {
+    site->samples.fetch_add(1u, std::memory_order_relaxed);
+    site->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    site->objects.fetch_add(objects, std::memory_order_relaxed);
+  };
+
+  // Key on the method pointer and the descriptor hash rather than the class pointer, which a
+  // moving GC may change.
+  Site* site = sites_.FindOrClaim(
+      Mix64(Mix64(reinterpret_cast<uintptr_t>(method)) ^ dex_pc),
+      [&](Site* new_site) REQUIRES_SHARED(Locks::mutator_lock_) {
+        // Formatting the name is the only expensive part, and is done once per site.
+        new_site->name = (method != nullptr) ? method->PrettyMethod() : "<runtime>";
+        new_site->dex_pc = dex_pc;
+      });
+  if (site != nullptr) {
+    add(site);
+  }
+
+  Site* klass_site = classes_.FindOrClaim(
+      Mix64(klass->DescriptorHash()),
+      [&](Site* new_site) REQUIRES_SHARED(Locks::mutator_lock_) {
+        std::string temp;
+        new_site->name = klass->GetDescriptor(&temp);
+      });
+  if (klass_site != nullptr) {
+    add(klass_site);
+  }
+}
+
+std::vector<AllocationSiteProfiler::AllocationSite>
+AllocationSiteProfiler::GetTopAllocationSites(size_t n) const {
+  return sites_.GetTop<AllocationSite>(
+      n,
+      [](const Site& site) { return AllocationSite{site.name, site.dex_pc, site.GetStats()}; },
+      [](const AllocationSite& lhs, const AllocationSite& rhs) {
+        return lhs.stats.bytes > rhs.stats.bytes;
+      });
+}
+
+std::vector<AllocationSiteProfiler::AllocatedClass>
+AllocationSiteProfiler::GetTopAllocatedClasses(size_t n) const {
+  return classes_.GetTop<AllocatedClass>(
+      n,
+      [](const Site& site) { return AllocatedClass{site.name, site.GetStats()}; },
+      [](const AllocatedClass& lhs, const AllocatedClass& rhs) {
+        return lhs.stats.bytes > rhs.stats.bytes;
+      });
+}
+
+void AllocationSiteProfiler::Dump(std::ostream& os, size_t n) const {
+  os << "Allocation sites (estimated from sampled allocations, "
+     << sites_.GetDroppedSamples() + classes_.GetDroppedSamples() << " samples dropped):\n";
+  for (const AllocationSite& site : GetTopAllocationSites(n)) {
+    os << "  " << site.method << " @ dex pc " << site.dex_pc << ": "
+       << PrettySize(site.stats.bytes) << " in " << site.stats.objects << " objects ("
+       << site.stats.samples << " samples)\n";
+  }
+  os << "Allocated classes:\n";
+  for (const AllocatedClass& klass : GetTopAllocatedClasses(n)) {
+    os << "  " << klass.descriptor << ": " << PrettySize(klass.stats.bytes) << " in "
+       << klass.stats.objects << " objects (" << klass.stats.samples << " samples)\n";
+  }
+}
+
+void AllocationSiteProfiler::Reset() {
+  sites_.Reset();
+  classes_.Reset();
+}
+
+}  // namespace art
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_PROFILER_H_
+#define ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "base/sampled_site_table.h"
+#include "obj_ptr.h"
+
+namespace art {
+
+class ArtMethod;
+
+namespace mirror {
+class Class;
+}  // namespace mirror
+
+// Aggregates sampled allocations by allocation site (method and dex pc) and by allocated class.
+// The samples come from the HeapSampler, which picks allocations with a probability proportional
+// to their size (on average one every sampling interval bytes) and places the sampling points at
+// TLAB boundaries, so that unsampled allocations stay on the TLAB fast path. Unlike the
+// AllocRecordObjectMap, no stack trace is kept and nothing is allocated for a known site, so the
+// profiler is cheap enough to leave enabled in production.
+//
+// Each sample is scaled by the inverse of its sampling probability, so the reported bytes and
+// objects are unbiased estimates of what was allocated at a site.
+class AllocationSiteProfiler {
+ public:
+  AllocationSiteProfiler() {}
+
+  // Record a sampled allocation of `byte_count` bytes of class `klass`, made by `method` at
+  // `dex_pc`. `method` may be null for allocations made by the runtime itself.
+  void Record(ArtMethod* method,
+              uint32_t dex_pc,
+              ObjPtr<mirror::Class> klass,
+              size_t byte_count,
+              size_t sampling_interval)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  struct Stats {
+    uint64_t samples;
+    // Estimated number of bytes and objects allocated.
+    uint64_t bytes;
+    uint64_t objects;
+  };
+
+  struct AllocationSite {
+    std::string method;
+    uint32_t dex_pc;
+    Stats stats;
+  };
+
+  struct AllocatedClass {
+    std::string descriptor;
+    Stats stats;
+  };
+
+  // Return up to `n` published sites or classes, ordered by decreasing estimated bytes.
+  std::vector<AllocationSite> GetTopAllocationSites(size_t n) const;
+  std::vector<AllocatedClass> GetTopAllocatedClasses(size_t n) const;
+
+  // Print the top sites and classes, used for SIGQUIT.
+  void Dump(std::ostream& os, size_t n = kDefaultDumpedEntries) const;
+
+  // Clear all the recorded data. Not safe to call concurrently with Record().
+  void Reset();
+
+  static constexpr size_t kSiteTableSize = 4096;
+  static constexpr size_t kClassTableSize = 1024;
+  static constexpr size_t kMaxProbes = 32;
+  static constexpr size_t kDefaultDumpedEntries = 10;
+
+ private:
+  // An allocation site or an allocated class.
+  struct Site {
+    std::atomic<uint64_t> samples{0u};
+    std::atomic<uint64_t> bytes{0u};
+    std::atomic<uint64_t> objects{0u};
+    std::string name;
+    uint32_t dex_pc = 0u;
+
+    Stats GetStats() const {
+      return Stats{samples.load(std::memory_order_relaxed),
+                   bytes.load(std::memory_order_relaxed),
+                   objects.load(std::memory_order_relaxed)};
+    }
+
+    void Reset() {
+      samples.store(0u, std::memory_order_relaxed);
+      bytes.store(0u, std::memory_order_relaxed);
+      objects.store(0u, std::memory_order_relaxed);
+    }
+  };
+
+  SampledSiteTable<Site, kSiteTableSize, kMaxProbes> sites_;
+  SampledSiteTable<Site, kClassTableSize, kMaxProbes> classes_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSiteProfiler);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_PROFILER_H_
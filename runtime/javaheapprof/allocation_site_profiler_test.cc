@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "allocation_site_profiler.h"
+
+#include <limits>
+#include <sstream>
+
+#include "art_method-inl.h"
+#include "class_linker.h"
+#include "common_runtime_test.h"
+#include "gc/heap.h"
+#include "mirror/array.h"
+#include "mirror/class-inl.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-current-inl.h"
+
+namespace art {
+
+class AllocationSiteProfilerTest : public CommonRuntimeTest {};
+
+TEST_F(AllocationSiteProfilerTest, AggregatesSitesAndClasses) {
+  ScopedObjectAccess soa(Thread::Current());
+  ObjPtr<mirror::Class> object_class = class_linker_->FindSystemClass(soa.Self(),
+                                                                      "Ljava/lang/Object;");
+  ObjPtr<mirror::Class> string_class = class_linker_->FindSystemClass(soa.Self(),
+                                                                      "Ljava/lang/String;");
+  ASSERT_TRUE(object_class != nullptr);
+  ASSERT_TRUE(string_class != nullptr);
+  ArtMethod* to_string =
+      object_class->FindClassMethod("toString", "()Ljava/lang/String;", kRuntimePointerSize);
+  ASSERT_TRUE(to_string != nullptr);
+
+  AllocationSiteProfiler profiler;
+  // With a sampling interval of 1 every allocation is sampled, so the estimates are exact.
+  profiler.Record(to_string, /*dex_pc=*/ 3u, string_class, /*byte_count=*/ 24u, 1u);
+  profiler.Record(to_string, /*dex_pc=*/ 3u, string_class, /*byte_count=*/ 32u, 1u);
+  profiler.Record(to_string, /*dex_pc=*/ 7u, object_class, /*byte_count=*/ 8u, 1u);
+  profiler.Record(/*method=*/ nullptr, /*dex_pc=*/ 0u, string_class, /*byte_count=*/ 100u, 1u);
+
+  std::vector<AllocationSiteProfiler::AllocationSite> sites = profiler.GetTopAllocationSites(10);
+  ASSERT_EQ(3u, sites.size());
+  EXPECT_EQ("<runtime>", sites[0].method);
+  EXPECT_EQ(100u, sites[0].stats.bytes);
+  EXPECT_EQ("java.lang.String java.lang.Object.toString()", sites[1].method);
+  EXPECT_EQ(3u, sites[1].dex_pc);
+  EXPECT_EQ(2u, sites[1].stats.samples);
+  EXPECT_EQ(2u, sites[1].stats.objects);
+  EXPECT_EQ(56u, sites[1].stats.bytes);
+  EXPECT_EQ(7u, sites[2].dex_pc);
+  EXPECT_EQ(8u, sites[2].stats.bytes);
+
+  std::vector<AllocationSiteProfiler::AllocatedClass> classes = profiler.GetTopAllocatedClasses(10);
+  ASSERT_EQ(2u, classes.size());
+  EXPECT_EQ("Ljava/lang/String;", classes[0].descriptor);
+  EXPECT_EQ(3u, classes[0].stats.objects);
+  EXPECT_EQ(156u, classes[0].stats.bytes);
+  EXPECT_EQ("Ljava/lang/Object;", classes[1].descriptor);
+  EXPECT_EQ(1u, classes[1].stats.objects);
+
+  EXPECT_EQ(1u, profiler.GetTopAllocationSites(1).size());
+
+  std::ostringstream oss;
+  profiler.Dump(oss);
+  EXPECT_NE(std::string::npos, oss.str().find("Ljava/lang/String;"));
+}
+
+TEST_F(AllocationSiteProfilerTest, ScalesSamples) {
+  ScopedObjectAccess soa(Thread::Current());
+  ObjPtr<mirror::Class> object_class = class_linker_->FindSystemClass(soa.Self(),
+                                                                      "Ljava/lang/Object;");
+  ASSERT_TRUE(object_class != nullptr);
+
+  AllocationSiteProfiler profiler;
+  // A 16 byte allocation is sampled with probability 1 - exp(-16 / 4096), so it stands for
+  // about 256.5 allocations.
+  profiler.Record(/*method=*/ nullptr, /*dex_pc=*/ 0u, object_class, 16u, 4096u);
+  std::vector<AllocationSiteProfiler::AllocatedClass> classes = profiler.GetTopAllocatedClasses(10);
+  ASSERT_EQ(1u, classes.size());
+  EXPECT_EQ(1u, classes[0].stats.samples);
+  EXPECT_EQ(257u, classes[0].stats.objects);
+  EXPECT_EQ(4104u, classes[0].stats.bytes);
+}
+
+class AllocationSiteProfilerHeapTest : public CommonRuntimeTest {
+ protected:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    CommonRuntimeTest::SetUpRuntimeOptions(options);
+    // Sample every allocation.
+    options->push_back(std::make_pair("-Xallocsitesampling:1", nullptr));
+  }
+
+  static uint64_t SampledObjects(const AllocationSiteProfiler* profiler,
+                                 const std::string& descriptor) {
+    for (const AllocationSiteProfiler::AllocatedClass& allocated_class :
+         profiler->GetTopAllocatedClasses(std::numeric_limits<size_t>::max())) {
+      if (allocated_class.descriptor == descriptor) {
+        return allocated_class.stats.objects;
+      }
+    }
+    return 0u;
+  }
+};
+
+TEST_F(AllocationSiteProfilerHeapTest, RecordsHeapAllocations) {
+  static constexpr size_t kNumArrays = 100;
+  const AllocationSiteProfiler* profiler =
+      Runtime::Current()->GetHeap()->GetAllocationSiteProfiler();
+  ASSERT_TRUE(profiler != nullptr);
+
+  ScopedObjectAccess soa(Thread::Current());
+  uint64_t sampled_before = SampledObjects(profiler, "[J");
+  for (size_t i = 0; i != kNumArrays; ++i) {
+    ObjPtr<mirror::LongArray> array = mirror::LongArray::Alloc(soa.Self(), 64);
+    ASSERT_TRUE(array != nullptr);
+    ASSERT_FALSE(soa.Self()->IsExceptionPending());
+  }
+  // The allocations are sampled by the heap and attributed to their class once initialized.
+  EXPECT_GT(SampledObjects(profiler, "[J"), sampled_before);
+}
+
+}  // namespace art
@@ -66,8 +66,14 @@ void HeapSampler::ReportSample(art::mirror::Object* obj, size_t allocation_size)
   uint64_t perf_alloc_id = reinterpret_cast<uint64_t>(obj);
   VLOG(heap) << "JHP:***Report Perfetto Allocation: obj: " << perf_alloc_id;
 #ifdef ART_TARGET_ANDROID
-  AHeapProfile_reportSample(perfetto_heap_id_, perf_alloc_id, allocation_size);
+  if (enabled_.load(std::memory_order_acquire)) {
+    AHeapProfile_reportSample(perfetto_heap_id_, perf_alloc_id, allocation_size);
+  }
 #endif
+  if (allocation_site_profiler_ != nullptr && obj != nullptr) {
+    // The object may not be initialized yet, the heap records the site once it is.
+    *GetPendingSiteSample() = allocation_size;
+  }
 }
 
 // Check whether we should take a sample or not at this allocation and calculate the sample
@@ -132,7 +138,7 @@ void HeapSampler::AdjustSampleOffset(size_t adjustment) {
 }
 
 bool HeapSampler::IsEnabled() {
-  return enabled_.load(std::memory_order_acquire);
+  return enabled_.load(std::memory_order_acquire) || allocation_site_profiler_ != nullptr;
 }
 
 int HeapSampler::GetSamplingInterval() {
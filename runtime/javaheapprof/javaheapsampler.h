@@ -24,6 +24,8 @@
 
 namespace art {
 
+class AllocationSiteProfiler;
+
 class HeapSampler {
  public:
   HeapSampler() : rng_(/*seed=*/std::minstd_rand::default_seed),
@@ -51,8 +53,22 @@ class HeapSampler {
   void DisableHeapSampler() {
     enabled_.store(false, std::memory_order_release);
   }
-  // Report a sample to Perfetto.
+  // Also take samples for `profiler`, even when Perfetto is not enabled. Must be called
+  // before any allocation that could be sampled.
+  void SetAllocationSiteProfiler(AllocationSiteProfiler* profiler) {
+    allocation_site_profiler_ = profiler;
+  }
+  // Report a sample to Perfetto. When an allocation site profiler is set, also remember the
+  // sample until the object is initialized, see TakePendingSiteSample().
   void ReportSample(art::mirror::Object* obj, size_t allocation_size);
+  // Return the size of the allocation last reported on this thread, or 0 if there is none,
+  // and clear it.
+  size_t TakePendingSiteSample() {
+    size_t* pending = GetPendingSiteSample();
+    size_t allocation_size = *pending;
+    *pending = 0u;
+    return allocation_size;
+  }
   // Check whether we should take a sample or not at this allocation, and return the
   // number of bytes from current pos to the next sample to use in the expand Tlab
   // calculation.
@@ -67,7 +83,7 @@ class HeapSampler {
   // Adjust the sample offset value with the adjustment usually (pos - start)
   // of new Tlab after Reset.
   void AdjustSampleOffset(size_t adjustment);
-  // Is heap sampler enabled?
+  // Is heap sampler enabled, for Perfetto or for the allocation site profiler?
   bool IsEnabled();
   // Set the sampling interval.
   void SetSamplingInterval(int sampling_interval) REQUIRES(!geo_dist_rng_lock_);
@@ -75,6 +91,10 @@ class HeapSampler {
   int GetSamplingInterval();
 
  private:
+  size_t* GetPendingSiteSample() {
+    thread_local size_t pending_site_sample = 0;
+    return &pending_site_sample;
+  }
   size_t NextGeoDistRandSample() REQUIRES(!geo_dist_rng_lock_);
   // Choose, save, and return the number of bytes until the next sample,
   // possibly decreasing sample intervals by sample_adj_bytes.
@@ -85,6 +105,8 @@ class HeapSampler {
   // Writes guarded by geo_dist_rng_lock_.
   std::atomic<int> p_sampling_interval_{4 * 1024};
   uint32_t perfetto_heap_id_ = 0;
+  // Set once at heap creation, if enabled.
+  AllocationSiteProfiler* allocation_site_profiler_ = nullptr;
   // std random number generator.
   std::minstd_rand rng_ GUARDED_BY(geo_dist_rng_lock_);  // Holds the state
   // std geometric distribution
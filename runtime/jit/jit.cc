@@ -18,18 +18,23 @@
 
 #include <dlfcn.h>
 
+#include <map>
+
 #include "art_method-inl.h"
 #include "base/enums.h"
 #include "base/file_utils.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/memfd.h"
 #include "base/memory_tool.h"
+#include "base/os.h"
 #include "base/runtime_debug.h"
 #include "base/scoped_flock.h"
+#include "base/systrace.h"
 #include "base/utils.h"
 #include "class_root-inl.h"
 #include "compilation_kind.h"
 #include "debugger.h"
+#include "dex/dex_file_loader.h"
 #include "dex/type_lookup_table.h"
 #include "gc/space/image_space.h"
 #include "entrypoints/entrypoint_utils-inl.h"
@@ -48,6 +53,7 @@
 #include "profile/profile_compilation_info.h"
 #include "profile_saver.h"
 #include "runtime.h"
+#include "runtime_image.h"
 #include "runtime_options.h"
 #include "stack.h"
 #include "stack_map.h"
@@ -90,6 +96,8 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
   jit_options->use_jit_compilation_ = options.GetOrDefault(RuntimeArgumentMap::UseJitCompilation);
   jit_options->use_profiled_jit_compilation_ =
       options.GetOrDefault(RuntimeArgumentMap::UseProfiledJitCompilation);
+  jit_options->persist_compiled_methods_ =
+      options.GetOrDefault(RuntimeArgumentMap::PersistJitCompiledMethods);
 
   jit_options->code_cache_initial_capacity_ =
       options.GetOrDefault(RuntimeArgumentMap::JITCodeCacheInitialCapacity);
@@ -103,6 +111,8 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
       options.GetOrDefault(RuntimeArgumentMap::JITPoolThreadPthreadPriority);
   jit_options->zygote_thread_pool_pthread_priority_ =
       options.GetOrDefault(RuntimeArgumentMap::JITZygotePoolThreadPthreadPriority);
+  jit_options->thread_pool_thread_count_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITPoolThreads);
 
   // Set default optimize threshold to aid with checking defaults.
   jit_options->optimize_threshold_ =
@@ -179,6 +189,7 @@ void Jit::AddTimingLogger(const TimingLogger& logger) {
 Jit::Jit(JitCodeCache* code_cache, JitOptions* options)
     : code_cache_(code_cache),
       options_(options),
+      persisted_locations_lock_("Jit::persisted_locations_lock_"),
       boot_completed_lock_("Jit::boot_completed_lock_"),
       cumulative_timings_("JIT timings"),
       memory_use_("Memory used for compilation", 16),
@@ -352,7 +363,7 @@ void Jit::WaitForWorkersToBeCreated() {
 void Jit::DeleteThreadPool() {
   Thread* self = Thread::Current();
   if (thread_pool_ != nullptr) {
-    std::unique_ptr<ThreadPool> pool;
+    std::unique_ptr<JitThreadPool> pool;
     {
       ScopedSuspendAll ssa(__FUNCTION__);
       // Clear thread_pool_ field while the threads are suspended.
@@ -794,6 +805,74 @@ class ScopedCompilation {
   bool owns_compilation_;
 };
 
+JitThreadPool::~JitThreadPool() {
+  // The base class destructor cannot reach the queues of this class, so we need to stop the
+  // workers and finalize pending tasks here.
+  DeleteThreads();
+  RemoveAllTasks(Thread::Current());
+}
+
+void JitThreadPool::AddTask(Thread* self,
+                            Task* task,
+                            CompilationKind compilation_kind,
+                            bool urgent) {
+  MutexLock mu(self, task_queue_lock_);
+  std::deque<Task*>* queue = GetQueueFor(compilation_kind);
+  if (urgent) {
+    queue->push_front(task);
+  } else {
+    queue->push_back(task);
+  }
+  NotifyTaskAddedLocked(self);
+}
+
+void JitThreadPool::CreateThreads(size_t num_threads) {
+  DCHECK_NE(num_threads, 0u);
+  {
+    MutexLock mu(Thread::Current(), task_queue_lock_);
+    CHECK(threads_.empty());
+    max_active_workers_ = num_threads;
+  }
+  ThreadPool::CreateThreads();
+}
+
+std::deque<Task*>* JitThreadPool::GetQueueFor(CompilationKind compilation_kind) {
+  switch (compilation_kind) {
+    case CompilationKind::kOsr:
+      return &osr_queue_;
+    case CompilationKind::kBaseline:
+      return &baseline_queue_;
+    case CompilationKind::kOptimized:
+      return &optimized_queue_;
+  }
+}
+
+Task* JitThreadPool::DequeueTaskLocked() {
+  if (!tasks_.empty()) {
+    return ThreadPool::DequeueTaskLocked();
+  }
+  for (std::deque<Task*>* queue : { &osr_queue_, &baseline_queue_, &optimized_queue_ }) {
+    if (!queue->empty()) {
+      Task* task = queue->front();
+      queue->pop_front();
+      return task;
+    }
+  }
+  LOG(FATAL) << "Unreachable: no task to dequeue";
+  UNREACHABLE();
+}
+
+size_t JitThreadPool::QueuedTaskCountLocked() const {
+  return tasks_.size() + osr_queue_.size() + baseline_queue_.size() + optimized_queue_.size();
+}
+
+void JitThreadPool::ClearQueuedTasksLocked() {
+  ThreadPool::ClearQueuedTasksLocked();
+  osr_queue_.clear();
+  baseline_queue_.clear();
+  optimized_queue_.clear();
+}
+
 class JitCompileTask final : public Task {
  public:
   enum class TaskKind {
@@ -1062,6 +1141,63 @@ class JitProfileTask final : public Task {
   DISALLOW_COPY_AND_ASSIGN(JitProfileTask);
 };
 
+// Compiles the methods a previous process persisted for the given dex files,
+// see Jit::PersistCompiledMethods.
+class JitPersistedMethodsTask final : public Task {
+ public:
+  JitPersistedMethodsTask(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+                          jobject class_loader,
+                          const std::string& path)
+      : path_(path) {
+    ScopedObjectAccess soa(Thread::Current());
+    StackHandleScope<1> hs(soa.Self());
+    Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
+        soa.Decode<mirror::ClassLoader>(class_loader)));
+    ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+    for (const auto& dex_file : dex_files) {
+      dex_files_.push_back(dex_file.get());
+      // Register the dex file so that we can guarantee it doesn't get deleted
+      // while reading it during the task.
+      class_linker->RegisterDexFile(*dex_file.get(), h_loader.Get());
+    }
+    class_loader_ = soa.Vm()->AddGlobalRef(soa.Self(), h_loader.Get());
+  }
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    StackHandleScope<1> hs(self);
+    Handle<mirror::ClassLoader> loader = hs.NewHandle<mirror::ClassLoader>(
+        soa.Decode<mirror::ClassLoader>(class_loader_));
+    // Dex files whose checksum changed since the methods were persisted are skipped
+    // by the profile lookup. The code is compiled again, so it relies on the current
+    // class hierarchy rather than on the one of the previous process.
+    uint32_t added_to_queue = Runtime::Current()->GetJit()->CompileMethodsFromProfile(
+        self,
+        dex_files_,
+        path_,
+        loader,
+        /* add_to_queue= */ true,
+        /* compile_after_boot= */ false);
+    VLOG(jit) << "Queued " << added_to_queue << " persisted methods from " << path_;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+  ~JitPersistedMethodsTask() {
+    ScopedObjectAccess soa(Thread::Current());
+    soa.Vm()->DeleteGlobalRef(soa.Self(), class_loader_);
+  }
+
+ private:
+  std::vector<const DexFile*> dex_files_;
+  jobject class_loader_;
+  const std::string path_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitPersistedMethodsTask);
+};
+
 static void CopyIfDifferent(void* s1, const void* s2, size_t n) {
   if (memcmp(s1, s2, n) != 0) {
     memcpy(s1, s2, n);
@@ -1203,9 +1339,12 @@ void Jit::CreateThreadPool() {
 
   // We need peers as we may report the JIT thread, e.g., in the debugger.
   constexpr bool kJitPoolNeedsPeers = true;
-  thread_pool_.reset(new ThreadPool("Jit thread pool", 1, kJitPoolNeedsPeers));
-
   Runtime* runtime = Runtime::Current();
+  // The zygote relies on its profile compilation tasks completing in the order they were
+  // queued (see `JitZygoteDoneCompilingTask`), so it always uses a single worker.
+  size_t num_threads = runtime->IsZygote() ? 1u : options_->GetThreadPoolThreadCount();
+  thread_pool_.reset(new JitThreadPool("Jit thread pool", num_threads, kJitPoolNeedsPeers));
+
   thread_pool_->SetPthreadPriority(
       runtime->IsZygote()
           ? options_->GetZygoteThreadPoolPthreadPriority()
@@ -1328,6 +1467,70 @@ void Jit::RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& de
     //   system server (though we are in the system server process).
     thread_pool_->AddTask(Thread::Current(), new JitProfileTask(dex_files, class_loader));
   }
+
+  if (options_->PersistCompiledMethods() &&
+      UseJitCompilation() &&
+      !runtime->IsZygote() &&
+      !runtime->IsJavaDebuggable()) {
+    std::string base_location = DexFileLoader::GetBaseLocation(dex_files[0]->GetLocation());
+    {
+      MutexLock mu(Thread::Current(), persisted_locations_lock_);
+      persisted_locations_.insert(base_location);
+    }
+    std::string path = RuntimeImage::GetRuntimeJitMethodsPath(base_location);
+    if (OS::FileExists(path.c_str())) {
+      thread_pool_->AddTask(Thread::Current(),
+                            new JitPersistedMethodsTask(dex_files, class_loader, path));
+    }
+  }
+}
+
+void Jit::PersistCompiledMethods(Thread* self) {
+  if (!options_->PersistCompiledMethods()) {
+    return;
+  }
+  std::set<std::string> locations;
+  {
+    MutexLock mu(self, persisted_locations_lock_);
+    locations = persisted_locations_;
+  }
+  if (locations.empty()) {
+    return;
+  }
+  ScopedTrace trace(__FUNCTION__);
+  // Write one profile per base location, to be validated against its dex files only.
+  std::map<std::string, ProfileCompilationInfo> profiles;
+  {
+    // Hold the mutator lock while using the dex files of the methods, so that they
+    // cannot be unloaded. The profiles only keep copies of what they need from them.
+    ScopedObjectAccess soa(self);
+    std::vector<ProfileMethodInfo> methods;
+    code_cache_->GetOptimizedMethods(locations, methods);
+    std::map<std::string, std::vector<ProfileMethodInfo>> methods_per_location;
+    for (const ProfileMethodInfo& method : methods) {
+      std::string location = DexFileLoader::GetBaseLocation(method.ref.dex_file->GetLocation());
+      methods_per_location[location].push_back(method);
+    }
+    for (const auto& [location, location_methods] : methods_per_location) {
+      if (!profiles[location].AddMethods(location_methods,
+                                         ProfileCompilationInfo::MethodHotness::kFlagHot)) {
+        LOG(WARNING) << "Could not collect JIT compiled methods of " << location;
+        profiles.erase(location);
+        continue;
+      }
+      VLOG(jit) << "Persisting " << location_methods.size() << " compiled methods of "
+                << location;
+    }
+  }
+
+  // Do the I/O without holding the mutator lock.
+  for (auto& [location, info] : profiles) {
+    std::string error_msg;
+    if (!RuntimeImage::WriteJitMethodsToDisk(location, info, &error_msg)) {
+      LOG(WARNING) << "Could not persist JIT compiled methods of " << location << ": "
+                   << error_msg;
+    }
+  }
 }
 
 void Jit::AddCompileTask(Thread* self,
@@ -1341,8 +1544,10 @@ void Jit::AddCompileTask(Thread* self,
   JitCompileTask::TaskKind task_kind = precompile
       ? JitCompileTask::TaskKind::kPreCompile
       : JitCompileTask::TaskKind::kCompile;
-  thread_pool_->AddTask(
-      self, new JitCompileTask(method, task_kind, compilation_kind, std::move(sc)));
+  thread_pool_->AddTask(self,
+                        new JitCompileTask(method, task_kind, compilation_kind, std::move(sc)),
+                        compilation_kind,
+                        /* urgent= */ self->IsJitSensitiveThread());
 }
 
 bool Jit::CompileMethodFromProfile(Thread* self,
@@ -1444,7 +1649,8 @@ uint32_t Jit::CompileMethodsFromProfile(
     const std::vector<const DexFile*>& dex_files,
     const std::string& profile_file,
     Handle<mirror::ClassLoader> class_loader,
-    bool add_to_queue) {
+    bool add_to_queue,
+    bool compile_after_boot) {
 
   if (profile_file.empty()) {
     LOG(WARNING) << "Expected a profile file in JIT zygote mode";
@@ -1492,14 +1698,16 @@ uint32_t Jit::CompileMethodsFromProfile(
                                    dex_cache,
                                    class_loader,
                                    add_to_queue,
-                                   /*compile_after_boot=*/true)) {
+                                   compile_after_boot)) {
         ++added_to_queue;
       }
     }
   }
 
-  // Add a task to run when all compilation is done.
-  AddPostBootTask(self, new JitDoneCompilingProfileTask(dex_files));
+  if (compile_after_boot) {
+    // Add a task to run when all compilation is done.
+    AddPostBootTask(self, new JitDoneCompilingProfileTask(dex_files));
+  }
   return added_to_queue;
 }
 
@@ -1715,7 +1923,7 @@ void Jit::PostZygoteFork() {
     NotifyZygoteCompilationDone();
     CHECK(code_cache_->GetZygoteMap()->IsCompilationNotified());
   }
-  thread_pool_->CreateThreads();
+  thread_pool_->CreateThreads(runtime->IsZygote() ? 1u : options_->GetThreadPoolThreadCount());
   thread_pool_->SetPthreadPriority(
       runtime->IsZygote()
           ? options_->GetZygoteThreadPoolPthreadPriority()
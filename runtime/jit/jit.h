@@ -17,6 +17,9 @@
 #ifndef ART_RUNTIME_JIT_JIT_H_
 #define ART_RUNTIME_JIT_JIT_H_
 
+#include <set>
+#include <string>
+
 #include <android-base/unique_fd.h>
 
 #include "base/histogram-inl.h"
@@ -66,6 +69,10 @@ static constexpr int kJitPoolThreadPthreadDefaultPriority = 9;
 // 19 is the lowest background priority on device.
 // See android/os/Process.java.
 static constexpr int kJitZygotePoolThreadPthreadDefaultPriority = 19;
+// Default number of JIT compiler threads.
+static constexpr unsigned int kJitPoolDefaultThreadCount = 1;
+// Maximum number of JIT compiler threads.
+static constexpr unsigned int kJitPoolMaxThreadCount = 16;
 
 class JitOptions {
  public:
@@ -115,6 +122,10 @@ class JitOptions {
     return zygote_thread_pool_pthread_priority_;
   }
 
+  size_t GetThreadPoolThreadCount() const {
+    return thread_pool_thread_count_;
+  }
+
   bool UseJitCompilation() const {
     return use_jit_compilation_;
   }
@@ -123,6 +134,10 @@ class JitOptions {
     return use_profiled_jit_compilation_;
   }
 
+  bool PersistCompiledMethods() const {
+    return persist_compiled_methods_;
+  }
+
   void SetUseJitCompilation(bool b) {
     use_jit_compilation_ = b;
   }
@@ -155,6 +170,7 @@ class JitOptions {
 
   bool use_jit_compilation_;
   bool use_profiled_jit_compilation_;
+  bool persist_compiled_methods_;
   bool use_baseline_compiler_;
   size_t code_cache_initial_capacity_;
   size_t code_cache_max_capacity_;
@@ -165,11 +181,13 @@ class JitOptions {
   bool dump_info_on_shutdown_;
   int thread_pool_pthread_priority_;
   int zygote_thread_pool_pthread_priority_;
+  size_t thread_pool_thread_count_;
   ProfileSaverOptions profile_saver_options_;
 
   JitOptions()
       : use_jit_compilation_(false),
         use_profiled_jit_compilation_(false),
+        persist_compiled_methods_(false),
         use_baseline_compiler_(false),
         code_cache_initial_capacity_(0),
         code_cache_max_capacity_(0),
@@ -179,7 +197,8 @@ class JitOptions {
         invoke_transition_weight_(0),
         dump_info_on_shutdown_(false),
         thread_pool_pthread_priority_(kJitPoolThreadPthreadDefaultPriority),
-        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority) {}
+        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority),
+        thread_pool_thread_count_(kJitPoolDefaultThreadCount) {}
 
   DISALLOW_COPY_AND_ASSIGN(JitOptions);
 };
@@ -228,6 +247,44 @@ struct OsrData {
   }
 };
 
+// Thread pool used by the JIT. Compilation tasks are not processed in FIFO order: generic
+// tasks (profile and zygote work) come first, then OSR requests since a thread is likely stuck
+// in a loop in the interpreter, then baseline compilations, then optimized compilations.
+// Within a kind, requests coming from JIT sensitive threads (e.g. the UI thread) are processed
+// before others.
+class JitThreadPool : public ThreadPool {
+ public:
+  JitThreadPool(const char* name, size_t num_threads, bool create_peers)
+      : ThreadPool(name, num_threads, create_peers) {}
+  ~JitThreadPool();
+
+  using ThreadPool::AddTask;
+  using ThreadPool::CreateThreads;
+
+  // Create `num_threads` workers. Used after a zygote fork, where the child process may use a
+  // different number of workers than the zygote.
+  void CreateThreads(size_t num_threads) REQUIRES(!task_queue_lock_);
+
+  // Add a compilation task of the given kind. If `urgent`, the task is processed before
+  // tasks of the same kind already queued.
+  void AddTask(Thread* self, Task* task, CompilationKind compilation_kind, bool urgent)
+      REQUIRES(!task_queue_lock_);
+
+ protected:
+  Task* DequeueTaskLocked() override REQUIRES(task_queue_lock_);
+  size_t QueuedTaskCountLocked() const override REQUIRES(task_queue_lock_);
+  void ClearQueuedTasksLocked() override REQUIRES(task_queue_lock_);
+
+ private:
+  std::deque<Task*>* GetQueueFor(CompilationKind compilation_kind) REQUIRES(task_queue_lock_);
+
+  std::deque<Task*> osr_queue_ GUARDED_BY(task_queue_lock_);
+  std::deque<Task*> baseline_queue_ GUARDED_BY(task_queue_lock_);
+  std::deque<Task*> optimized_queue_ GUARDED_BY(task_queue_lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(JitThreadPool);
+};
+
 class Jit {
  public:
   static constexpr size_t kDefaultPriorityThreadWeightRatio = 1000;
@@ -367,7 +424,7 @@ class Jit {
   // Load the compiler library.
   static bool LoadCompilerLibrary(std::string* error_msg);
 
-  ThreadPool* GetThreadPool() const {
+  JitThreadPool* GetThreadPool() const {
     return thread_pool_.get();
   }
 
@@ -399,11 +456,13 @@ class Jit {
   // is true, methods in the profile are added to the JIT queue. Otherwise they are compiled
   // directly.
   // Return the number of methods added to the queue.
+  // If `compile_after_boot` is true, queued methods are only compiled once the boot completed.
   uint32_t CompileMethodsFromProfile(Thread* self,
                                      const std::vector<const DexFile*>& dex_files,
                                      const std::string& profile_path,
                                      Handle<mirror::ClassLoader> class_loader,
-                                     bool add_to_queue);
+                                     bool add_to_queue,
+                                     bool compile_after_boot = true);
 
   // Compile methods from the given boot profile (.bprof extension). If `add_to_queue`
   // is true, methods in the profile are added to the JIT queue. Otherwise they are compiled
@@ -420,6 +479,11 @@ class Jit {
   void RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
                         jobject class_loader);
 
+  // Write the optimized methods of the dex files registered so far, so that the next process
+  // registering the same dex files compiles them eagerly instead of waiting for them to get
+  // hot again. Only done with -Xjitpersistmethods:true.
+  void PersistCompiledMethods(Thread* self) REQUIRES(!persisted_locations_lock_);
+
   // Called by the compiler to know whether it can directly encode the
   // method/class/string.
   bool CanEncodeMethod(ArtMethod* method, bool is_for_shared_region) const
@@ -484,9 +548,13 @@ class Jit {
   jit::JitCodeCache* const code_cache_;
   const JitOptions* const options_;
 
-  std::unique_ptr<ThreadPool> thread_pool_;
+  std::unique_ptr<JitThreadPool> thread_pool_;
   std::vector<std::unique_ptr<OatDexFile>> type_lookup_tables_;
 
+  // Base locations of the registered dex files whose compiled methods are persisted.
+  Mutex persisted_locations_lock_;
+  std::set<std::string> persisted_locations_ GUARDED_BY(persisted_locations_lock_);
+
   Mutex boot_completed_lock_;
   bool boot_completed_ GUARDED_BY(boot_completed_lock_) = false;
   std::deque<Task*> tasks_after_boot_ GUARDED_BY(boot_completed_lock_);
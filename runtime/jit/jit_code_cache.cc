@@ -16,6 +16,8 @@
 
 #include "jit_code_cache.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 #include <android-base/logging.h>
@@ -56,6 +58,7 @@
 #include "profile/profile_compilation_info.h"
 #include "scoped_thread_state_change-inl.h"
 #include "stack.h"
+#include "stack_map_cache.h"
 #include "thread-current-inl.h"
 #include "thread-inl.h"
 #include "thread_list.h"
@@ -455,6 +458,10 @@ void JitCodeCache::SweepRootTables(IsMarkedVisitor* visitor) {
           mirror::Class* new_klass = down_cast<mirror::Class*>(visitor->IsMarked(klass));
           if (new_klass != klass) {
             cache->classes_[j] = GcRoot<mirror::Class>(new_klass);
+            if (new_klass == nullptr) {
+              // Do not attribute the calls to the next class stored in this entry.
+              cache->counts_[j] = 0u;
+            }
           }
         }
       }
@@ -474,6 +481,8 @@ void JitCodeCache::FreeCodeAndData(const void* code_ptr) {
   }  // else this is a JNI stub without any data.
 
   FreeLocked(&private_region_, reinterpret_cast<uint8_t*>(allocation), data);
+  // The memory may be reused for other code, drop the stack maps cached for its PCs.
+  Runtime::Current()->GetStackMapCache()->Invalidate();
 }
 
 void JitCodeCache::FreeAllMethodHeaders(
@@ -611,22 +620,52 @@ void JitCodeCache::DisallowInlineCacheAccess() {
   is_weak_access_enabled_.store(false, std::memory_order_seq_cst);
 }
 
-void JitCodeCache::CopyInlineCacheInto(
+bool JitCodeCache::CopyInlineCacheInto(
     const InlineCache& ic,
-    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes) {
+    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+    /*out*/std::array<uint32_t, InlineCache::kIndividualCacheSize>* counts) {
   static_assert(arraysize(ic.classes_) == InlineCache::kIndividualCacheSize);
   DCHECK_EQ(classes->NumberOfReferences(), InlineCache::kIndividualCacheSize);
   DCHECK_EQ(classes->RemainingSlots(), InlineCache::kIndividualCacheSize);
   WaitUntilInlineCacheAccessible(Thread::Current());
   // Note that we don't need to lock `lock_` here, the compiler calling
   // this method has already ensured the inline cache will not be deleted.
-  for (const GcRoot<mirror::Class>& root : ic.classes_) {
-    mirror::Class* object = root.Read();
-    if (object != nullptr) {
+  constexpr size_t kLast = InlineCache::kIndividualCacheSize - 1u;
+  size_t number_of_classes = 0u;
+  for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
+    mirror::Class* object = ic.classes_[i].Read();
+    if (object == nullptr) {
+      continue;
+    }
+    // Racing updates around an eviction can record a receiver type twice, merge the entries.
+    // The last entry counts the calls of all the types missing from the others, keep it apart.
+    size_t index = 0u;
+    if (i != kLast) {
+      while (index != number_of_classes && classes->GetReference(index).Ptr() != object) {
+        ++index;
+      }
+    } else {
+      index = number_of_classes;
+    }
+    if (index == number_of_classes) {
       DCHECK_NE(classes->RemainingSlots(), 0u);
       classes->NewHandle(object);
+      if (counts != nullptr) {
+        (*counts)[number_of_classes] = ic.counts_[i];
+      }
+      ++number_of_classes;
+    } else if (counts != nullptr) {
+      (*counts)[index] = static_cast<uint32_t>(
+          std::min<uint64_t>(static_cast<uint64_t>((*counts)[index]) + ic.counts_[i],
+                             std::numeric_limits<uint32_t>::max()));
     }
   }
+  if (counts != nullptr) {
+    std::fill(counts->begin() + number_of_classes, counts->end(), 0u);
+  }
+  // The last entry is only used once the other entries are full. They may have been cleared
+  // since, to make room for hotter receiver types.
+  return ic.classes_[InlineCache::kIndividualCacheSize - 1].Read() != nullptr;
 }
 
 static void ClearMethodCounter(ArtMethod* method, bool was_warm)
@@ -681,6 +720,18 @@ bool JitCodeCache::Commit(Thread* self,
   // We need to make sure that there will be no jit-gcs going on and wait for any ongoing one to
   // finish.
   WaitForPotentialCollectionToCompleteRunnable(self);
+  if (compilation_kind == CompilationKind::kBaseline && !method->IsNative()) {
+    // With multiple JIT workers, an optimized compilation of this method may have been
+    // committed while this baseline compilation was running. Don't downgrade the code.
+    const void* entry_point = method->GetEntryPointFromQuickCompiledCode();
+    if (ContainsPc(entry_point) &&
+        !CodeInfo::IsBaseline(
+            OatQuickMethodHeader::FromEntryPoint(entry_point)->GetOptimizedCodeInfoPtr())) {
+      VLOG(jit) << "Not committing baseline code for " << method->PrettyMethod()
+                << " as optimized code has been committed concurrently";
+      return false;
+    }
+  }
   const uint8_t* code_ptr = region->CommitCode(
       reserved_code, code, stack_map_data, has_should_deoptimize_flag);
   if (code_ptr == nullptr) {
@@ -1535,6 +1586,33 @@ void* JitCodeCache::MoreCore(const void* mspace, intptr_t increment) {
       : private_region_.MoreCore(mspace, increment);
 }
 
+void JitCodeCache::GetOptimizedMethods(const std::set<std::string>& dex_base_locations,
+                                       std::vector<ProfileMethodInfo>& methods) {
+  Thread* self = Thread::Current();
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto add_method = [&](const void* code_ptr, ArtMethod* method)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (method->IsObsolete() ||
+        CodeInfo::IsBaseline(
+            OatQuickMethodHeader::FromCodePointer(code_ptr)->GetOptimizedCodeInfoPtr())) {
+      return;
+    }
+    const DexFile* dex_file = method->GetDexFile();
+    const std::string base_location = DexFileLoader::GetBaseLocation(dex_file->GetLocation());
+    if (ContainsElement(dex_base_locations, base_location)) {
+      methods.emplace_back(MethodReference(dex_file, method->GetDexMethodIndex()));
+    }
+  };
+  for (const auto& entry : method_code_map_) {  // Includes OSR methods.
+    // Code saved for a pre-compiled method whose class never got initialized has not been used
+    // by this process, don't carry it over to the next one.
+    if (saved_compiled_methods_map_.find(entry.second) != saved_compiled_methods_map_.end()) {
+      continue;
+    }
+    add_method(entry.first, entry.second);
+  }
+}
+
 void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_locations,
                                       std::vector<ProfileMethodInfo>& methods) {
   Thread* self = Thread::Current();
@@ -1572,10 +1650,14 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
       const InlineCache& cache = info->cache_[i];
       ArtMethod* caller = info->GetMethod();
       bool is_missing_types = false;
+      // Entries of megamorphic inline caches may have been cleared to make room for
+      // hotter receiver types, so look at all of them.
+      bool is_megamorphic =
+          cache.classes_[InlineCache::kIndividualCacheSize - 1].Read() != nullptr;
       for (size_t k = 0; k < InlineCache::kIndividualCacheSize; k++) {
         mirror::Class* cls = cache.classes_[k].Read();
         if (cls == nullptr) {
-          break;
+          continue;
         }
 
         // Check if the receiver is in the boot class path or if it's in the
@@ -1615,9 +1697,9 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
           is_missing_types = true;
         }
       }
-      if (!profile_classes.empty()) {
+      if (!profile_classes.empty() || is_megamorphic) {
         inline_caches.emplace_back(/*ProfileMethodInfo::ProfileInlineCache*/
-            cache.dex_pc_, is_missing_types, profile_classes);
+            cache.dex_pc_, is_missing_types, profile_classes, is_megamorphic);
       }
     }
     methods.emplace_back(/*ProfileMethodInfo*/
@@ -1706,6 +1788,20 @@ bool JitCodeCache::NotifyCompilationOf(ArtMethod* method,
     }
   }
 
+  if (compilation_kind == CompilationKind::kBaseline) {
+    // An optimized compilation may be running concurrently on another JIT worker, in which
+    // case the baseline code would be superseded (or discarded in `Commit`) anyway. Note that
+    // this compilation may itself have been registered as optimized and adjusted to baseline
+    // by the caller, so only bail if it is registered as baseline too.
+    MutexLock mu(self, *Locks::jit_lock_);
+    if (IsMethodBeingCompiled(method, CompilationKind::kBaseline) &&
+        IsMethodBeingCompiled(method, CompilationKind::kOptimized)) {
+      VLOG(jit) << "Not compiling " << method->PrettyMethod()
+                << " baseline as it is being compiled optimized";
+      return false;
+    }
+  }
+
   if (UNLIKELY(method->IsNative())) {
     MutexLock mu(self, *Locks::jit_lock_);
     JniStubKey key(method);
@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_JIT_JIT_CODE_CACHE_H_
 #define ART_RUNTIME_JIT_JIT_CODE_CACHE_H_
 
+#include <array>
 #include <iosfwd>
 #include <memory>
 #include <set>
@@ -309,8 +310,13 @@ class JitCodeCache {
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  void CopyInlineCacheInto(const InlineCache& ic,
-                           /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes)
+  // Copy the classes of the inline cache into `classes`, skipping empty entries. If `counts`
+  // is not null, also copy the number of calls seen for each of the copied classes.
+  // Return whether the inline cache has seen more receiver types than it can hold.
+  bool CopyInlineCacheInto(
+      const InlineCache& ic,
+      /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+      /*out*/std::array<uint32_t, InlineCache::kIndividualCacheSize>* counts = nullptr)
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -333,6 +339,14 @@ class JitCodeCache {
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Adds to `methods` all methods which are part of any of the given dex locations and
+  // have optimized (non-baseline) code in the private region, including OSR code. Code
+  // saved for pre-compiled methods that were never used is not included.
+  void GetOptimizedMethods(const std::set<std::string>& dex_base_locations,
+                           std::vector<ProfileMethodInfo>& methods)
+      REQUIRES(!Locks::jit_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void InvalidateAllCompiledCode()
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -16,6 +16,8 @@
 
 #include "profiling_info.h"
 
+#include <limits>
+
 #include "art_method-inl.h"
 #include "dex/dex_instruction.h"
 #include "jit/jit.h"
@@ -80,13 +82,29 @@ InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
   UNREACHABLE();
 }
 
+static void CountCall(uint32_t* count) {
+  if (LIKELY(*count != std::numeric_limits<uint32_t>::max())) {
+    ++*count;
+  }
+}
+
 void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   InlineCache* cache = GetInlineCache(dex_pc);
+  // Evictions leave holes in the entries, so look for `cls` in all of them before claiming
+  // an empty one, like the art_quick_update_inline_cache stub.
+  for (size_t i = 0; i < InlineCache::kIndividualCacheSize - 1u; ++i) {
+    mirror::Class* existing = cache->classes_[i].Read<kWithoutReadBarrier>();
+    if (existing != nullptr && ReadBarrier::IsMarked(existing) == cls) {
+      CountCall(&cache->counts_[i]);
+      return;
+    }
+  }
   for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
     mirror::Class* existing = cache->classes_[i].Read<kWithoutReadBarrier>();
     mirror::Class* marked = ReadBarrier::IsMarked(existing);
     if (marked == cls) {
-      // Receiver type is already in the cache, nothing else to do.
+      // Receiver type is already in the cache, only count the call.
+      CountCall(&cache->counts_[i]);
       return;
     } else if (marked == nullptr) {
       // Cache entry is empty, try to put `cls` in it.
@@ -101,13 +119,29 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
         // entry in case the entry contains `cls`.
         --i;
       } else {
-        // We successfully set `cls`, just return.
+        // We successfully set `cls`, count the call and return.
+        CountCall(&cache->counts_[i]);
         return;
       }
     }
   }
   // Unsuccessfull - cache is full, making it megamorphic. We do not DCHECK it though,
-  // as the garbage collector might clear the entries concurrently.
+  // as the garbage collector might clear the entries concurrently. Like the
+  // art_quick_update_inline_cache stub, record `cls` in the last entry and age the other
+  // entries once enough calls did not match them.
+  constexpr size_t kLast = InlineCache::kIndividualCacheSize - 1;
+  cache->classes_[kLast] = GcRoot<mirror::Class>(cls);
+  if (++cache->counts_[kLast] < InlineCache::kMissesPerAging) {
+    return;
+  }
+  cache->counts_[kLast] = 0u;
+  for (size_t i = 0; i < kLast; ++i) {
+    cache->counts_[i] >>= 1;
+    if (cache->counts_[i] < InlineCache::kEvictionCount) {
+      cache->classes_[i] = GcRoot<mirror::Class>(nullptr);
+      cache->counts_[i] = 0u;
+    }
+  }
 }
 
 ScopedProfilingInfoUse::ScopedProfilingInfoUse(jit::Jit* jit, ArtMethod* method, Thread* self)
@@ -46,13 +46,28 @@ class InlineCache {
   // This is hard coded in the assembly stub art_quick_update_inline_cache.
   static constexpr uint8_t kIndividualCacheSize = 5;
 
+  // Once the cache is megamorphic, the counts of the first entries are halved every
+  // `kMissesPerAging` calls with other receiver types, and the entries left with fewer than
+  // `kEvictionCount` calls are cleared so that hotter receiver types can take their place.
+  static constexpr uint32_t kMissesPerAging = 256u;
+  static constexpr uint32_t kEvictionCount = 64u;
+
   static constexpr MemberOffset ClassesOffset() {
     return MemberOffset(OFFSETOF_MEMBER(InlineCache, classes_));
   }
 
+  static constexpr MemberOffset CountsOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(InlineCache, counts_));
+  }
+
  private:
   uint32_t dex_pc_;
   GcRoot<mirror::Class> classes_[kIndividualCacheSize];
+  // Number of calls seen for the receiver type in the corresponding entry of `classes_`.
+  // The last entry gets overwritten by every new type once the cache is megamorphic, so
+  // its count is for all the types that did not fit, since the last aging. The counts are
+  // updated without synchronization by baseline compiled code and may be slightly off.
+  uint32_t counts_[kIndividualCacheSize];
 
   friend class jit::JitCodeCache;
   friend class ProfilingInfo;
@@ -192,6 +192,18 @@ constexpr std::optional<int32_t> EncodeDatumId(DatumId datum_id) {
       return std::make_optional(
           statsd::
               ART_DATUM_DELTA_REPORTED__KIND__ART_DATUM_DELTA_GC_FULL_HEAP_COLLECTION_DURATION_MS);
+    case DatumId::kTimeToSuspendAll:
+    case DatumId::kTimeToSuspendThreadFlip:
+    case DatumId::kTimeToSuspendThread:
+    case DatumId::kTimeToRunCheckpoint:
+    case DatumId::kSlowSuspendAllCount:
+    case DatumId::kSlowSuspendAllTime:
+      // There are no atoms for the time to suspend yet.
+      return std::nullopt;
+    case DatumId::kMonitorContentionCount:
+    case DatumId::kMonitorContentionTime:
+      // There are no atoms for monitor contention yet.
+      return std::nullopt;
   }
 }
 
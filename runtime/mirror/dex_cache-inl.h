@@ -28,6 +28,7 @@
 #include "base/enums.h"
 #include "class_linker.h"
 #include "dex/dex_file.h"
+#include "dex_cache_miss_profiler.h"
 #include "gc_root-inl.h"
 #include "linear_alloc-inl.h"
 #include "mirror/call_site.h"
@@ -36,6 +37,7 @@
 #include "obj_ptr.h"
 #include "object-inl.h"
 #include "runtime.h"
+#include "thread-current-inl.h"
 #include "write_barrier-inl.h"
 
 #include <atomic>
@@ -83,6 +85,21 @@ T* DexCache::AllocArray(MemberOffset obj_offset, size_t num, LinearAllocKind kin
   return array;
 }
 
+template <typename PairArray>
+inline void DexCache::SampleLookup(DexCacheArrayKind kind,
+                                   PairArray* pairs,
+                                   uint32_t index,
+                                   bool hit) {
+  DexCacheMissProfiler* profiler = Runtime::Current()->GetDexCacheMissProfiler();
+  if (UNLIKELY(profiler != nullptr) &&
+      Thread::Current()->SampleDexCacheLookup(profiler->GetSamplingInterval())) {
+    DexCacheLookup lookup = hit ? DexCacheLookup::kHit
+        : pairs->HoldsOtherIndex(index) ? DexCacheLookup::kConflictMiss
+        : DexCacheLookup::kMiss;
+    profiler->RecordLookup(GetDexFile(), kind, lookup);
+  }
+}
+
 template <typename T>
 inline DexCachePair<T>::DexCachePair(ObjPtr<T> object, uint32_t index)
     : object(object), index(index) {}
@@ -18,6 +18,7 @@
 
 #include "art_method-inl.h"
 #include "class_linker.h"
+#include "class_loader.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/heap.h"
 #include "jit/profile_saver.h"
@@ -202,6 +203,34 @@ bool DexCache::ShouldAllocateFullArrayAtStartup() {
   return true;
 }
 
+bool DexCache::ShouldPromoteToFullArray(DexCacheArrayKind kind) {
+  Runtime* runtime = Runtime::Current();
+  DexCacheMissProfiler* profiler = runtime->GetDexCacheMissProfiler();
+  if (profiler == nullptr) {
+    return false;
+  }
+  // Only promote once startup is completed. Unlinking the startup caches keeps the arrays
+  // promoted before it, see IsPromotedArray().
+  if (!runtime->GetStartupCompleted()) {
+    return false;
+  }
+  return profiler->ConsumePromotionRequest(GetDexFile(), kind);
+}
+
+bool DexCache::IsPromotedArray(void* array) {
+  if (array == nullptr) {
+    return false;
+  }
+  // Startup arrays are in the startup LinearAlloc or in the app image, while promoted arrays
+  // are allocated with the LinearAlloc of the class loader. The class loader may not have
+  // one yet when registering the dex caches of an app image.
+  ObjPtr<ClassLoader> class_loader = GetClassLoader();
+  LinearAlloc* alloc = (class_loader == nullptr)
+      ? Runtime::Current()->GetLinearAlloc()
+      : class_loader->GetAllocator();
+  return alloc != nullptr && alloc->Contains(array);
+}
+
 void DexCache::UnlinkStartupCaches() {
   if (GetDexFile() == nullptr) {
     // Unused dex cache.
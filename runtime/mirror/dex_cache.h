@@ -24,6 +24,7 @@
 #include "base/locks.h"
 #include "dex/dex_file.h"
 #include "dex/dex_file_types.h"
+#include "dex_cache_miss_profiler.h"
 #include "gc_root.h"  // Note: must not use -inl here to avoid circular dependency.
 #include "linear_alloc.h"
 #include "object.h"
@@ -136,6 +137,12 @@ template <typename T, size_t size> class NativeDexCachePairArray {
     return GetNativePair(entries_, SlotIndex(index));
   }
 
+  // Returns whether the slot of `index` holds the entry of another index.
+  bool HoldsOtherIndex(uint32_t index) REQUIRES_SHARED(Locks::mutator_lock_) {
+    size_t stored_index = GetNativePair(index).index;
+    return stored_index != index && stored_index % size == SlotIndex(index);
+  }
+
   void SetNativePair(uint32_t index, NativeDexCachePair<T> value) {
     SetNativePair(entries_, SlotIndex(index), value);
   }
@@ -185,6 +192,12 @@ template <typename T, size_t size> class DexCachePairArray {
     entries_[SlotIndex(index)].store(value, std::memory_order_relaxed);
   }
 
+  // Returns whether the slot of `index` holds the entry of another index.
+  bool HoldsOtherIndex(uint32_t index) {
+    uint32_t stored_index = GetPair(index).index;
+    return stored_index != index && SlotIndex(stored_index) == SlotIndex(index);
+  }
+
   void Clear(uint32_t index) {
     uint32_t slot = SlotIndex(index);
     // This is racy but should only be called from the transactional interpreter.
@@ -445,7 +458,7 @@ class MANAGED DexCache final : public Object {
 
 #define DEFINE_DUAL_CACHE( \
     name, pair_kind, getter_setter, type, pair_size, alloc_pair_kind, \
-    array_kind, component_type, ids, alloc_array_kind) \
+    array_kind, component_type, ids, alloc_array_kind, profiled_kind) \
   DEFINE_PAIR_ARRAY( \
       name, pair_kind, getter_setter, type, pair_size, alloc_pair_kind) \
   DEFINE_ARRAY( \
@@ -458,7 +471,9 @@ class MANAGED DexCache final : public Object {
     } \
     auto* pairs = Get ##getter_setter(); \
     if (pairs != nullptr) { \
-      return pairs->Get(index); \
+      type* resolved = pairs->Get(index); \
+      SampleLookup(profiled_kind, pairs, index, resolved != nullptr); \
+      return resolved; \
     } \
     return nullptr; \
   } \
@@ -479,14 +494,30 @@ class MANAGED DexCache final : public Object {
           pairs = Allocate ##getter_setter(); \
           pairs->Set(index, resolved); \
         } \
+      } else if (UNLIKELY(ShouldPromoteToFullArray(profiled_kind))) { \
+        array = Promote ##getter_setter ##ToArray(); \
+        array->Set(index, resolved); \
       } else { \
         pairs->Set(index, resolved); \
       } \
     } \
   } \
+  array_kind* Promote ##getter_setter ##ToArray() \
+      REQUIRES_SHARED(Locks::mutator_lock_) { \
+    auto* pairs = Get ##getter_setter(); \
+    auto* array = Allocate ##getter_setter ##Array(); \
+    for (uint32_t i = 0, num = GetDexFile()->ids(); i != num; ++i) { \
+      type* resolved = pairs->Get(i); \
+      if (resolved != nullptr) { \
+        array->Set(i, resolved); \
+      } \
+    } \
+    return array; \
+  } \
   void Unlink ##getter_setter ##ArrayIfStartup() \
       REQUIRES_SHARED(Locks::mutator_lock_) { \
-    if (!ShouldAllocateFullArray(GetDexFile()->ids(), pair_size)) { \
+    if (!ShouldAllocateFullArray(GetDexFile()->ids(), pair_size) && \
+        !IsPromotedArray(Get ##getter_setter ##Array())) { \
       Set ##getter_setter ##Array(nullptr) ; \
     } \
   }
@@ -507,7 +538,8 @@ class MANAGED DexCache final : public Object {
                     NativeArray<ArtField>,
                     ArtField,
                     NumFieldIds,
-                    LinearAllocKind::kNoGCRoots)
+                    LinearAllocKind::kNoGCRoots,
+                    DexCacheArrayKind::kFields)
 
   DEFINE_DUAL_CACHE(resolved_method_types_,
                     DexCachePair,
@@ -518,7 +550,8 @@ class MANAGED DexCache final : public Object {
                     GcRootArray<mirror::MethodType>,
                     GcRoot<mirror::MethodType>,
                     NumProtoIds,
-                    LinearAllocKind::kGCRootArray);
+                    LinearAllocKind::kGCRootArray,
+                    DexCacheArrayKind::kMethodTypes);
 
   DEFINE_DUAL_CACHE(resolved_methods_,
                     NativeDexCachePair,
@@ -529,7 +562,8 @@ class MANAGED DexCache final : public Object {
                     NativeArray<ArtMethod>,
                     ArtMethod,
                     NumMethodIds,
-                    LinearAllocKind::kNoGCRoots)
+                    LinearAllocKind::kNoGCRoots,
+                    DexCacheArrayKind::kMethods)
 
   DEFINE_DUAL_CACHE(resolved_types_,
                     DexCachePair,
@@ -540,7 +574,8 @@ class MANAGED DexCache final : public Object {
                     GcRootArray<mirror::Class>,
                     GcRoot<mirror::Class>,
                     NumTypeIds,
-                    LinearAllocKind::kGCRootArray);
+                    LinearAllocKind::kGCRootArray,
+                    DexCacheArrayKind::kTypes);
 
   DEFINE_DUAL_CACHE(strings_,
                     DexCachePair,
@@ -551,7 +586,8 @@ class MANAGED DexCache final : public Object {
                     GcRootArray<mirror::String>,
                     GcRoot<mirror::String>,
                     NumStringIds,
-                    LinearAllocKind::kGCRootArray);
+                    LinearAllocKind::kGCRootArray,
+                    DexCacheArrayKind::kStrings);
 
 // NOLINTEND(bugprone-macro-parentheses)
 
@@ -573,6 +609,21 @@ class MANAGED DexCache final : public Object {
   // the runtime and oat files.
   bool ShouldAllocateFullArrayAtStartup() REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record a lookup of `index` in the pair array `pairs` of `kind` if it is sampled, see
+  // DexCacheMissProfiler.
+  template <typename PairArray>
+  ALWAYS_INLINE void SampleLookup(DexCacheArrayKind kind,
+                                  PairArray* pairs,
+                                  uint32_t index,
+                                  bool hit) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns whether the pair array of `kind` misses often enough to be replaced by a full array.
+  bool ShouldPromoteToFullArray(DexCacheArrayKind kind) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns whether `array`, a full array of a dex file with more ids than its pair array size,
+  // replaced the pair array after startup, as opposed to being a startup array.
+  bool IsPromotedArray(void* array) REQUIRES_SHARED(Locks::mutator_lock_);
+
   HeapReference<ClassLoader> class_loader_;
   HeapReference<String> location_;
 
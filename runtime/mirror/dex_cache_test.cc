@@ -61,6 +61,48 @@ TEST_F(DexCacheTest, Open) {
   EXPECT_EQ(0u, dex_cache->NumResolvedMethodTypes());
 }
 
+TEST_F(DexCacheTest, PromoteResolvedTypesToArray) {
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<2> hs(soa.Self());
+  ASSERT_TRUE(java_lang_dex_file_ != nullptr);
+  ASSERT_GT(java_lang_dex_file_->NumTypeIds(), DexCache::kDexCacheTypeCacheSize);
+  Handle<DexCache> dex_cache(
+      hs.NewHandle(class_linker_->AllocAndInitializeDexCache(
+          soa.Self(), *java_lang_dex_file_, /*class_loader=*/nullptr)));
+  ASSERT_TRUE(dex_cache != nullptr);
+  Handle<Class> object_class =
+      hs.NewHandle(class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;"));
+  ASSERT_TRUE(object_class != nullptr);
+  const dex::TypeId* type_id = java_lang_dex_file_->FindTypeId("Ljava/lang/Object;");
+  ASSERT_TRUE(type_id != nullptr);
+  dex::TypeIndex type_idx = java_lang_dex_file_->GetIndexForTypeId(*type_id);
+
+  // The dex file has too many types for a full array, so the hashed pair array is used.
+  dex_cache->SetResolvedType(type_idx, object_class.Get());
+  EXPECT_EQ(DexCache::kDexCacheTypeCacheSize, dex_cache->NumResolvedTypes());
+  EXPECT_EQ(0u, dex_cache->NumResolvedTypesArray());
+
+  // Misses on the other type indexes of the slot are conflict misses, unlike misses on the
+  // indexes of empty slots.
+  uint32_t conflicting_index = (type_idx.index_ >= DexCache::kDexCacheTypeCacheSize)
+      ? type_idx.index_ - DexCache::kDexCacheTypeCacheSize
+      : type_idx.index_ + DexCache::kDexCacheTypeCacheSize;
+  EXPECT_TRUE(dex_cache->GetResolvedTypes()->HoldsOtherIndex(conflicting_index));
+  EXPECT_FALSE(dex_cache->GetResolvedTypes()->HoldsOtherIndex(type_idx.index_));
+  EXPECT_FALSE(dex_cache->GetResolvedTypes()->HoldsOtherIndex(type_idx.index_ ^ 1u));
+
+  // The promoted array keeps the resolved types and is used for lookups.
+  dex_cache->PromoteResolvedTypesToArray();
+  EXPECT_EQ(java_lang_dex_file_->NumTypeIds(), dex_cache->NumResolvedTypesArray());
+  EXPECT_OBJ_PTR_EQ(object_class.Get(), dex_cache->GetResolvedTypesArray()->Get(type_idx.index_));
+  EXPECT_OBJ_PTR_EQ(object_class.Get(), dex_cache->GetResolvedType(type_idx));
+
+  // Unlinking the startup caches keeps the promoted array.
+  dex_cache->UnlinkStartupCaches();
+  EXPECT_EQ(java_lang_dex_file_->NumTypeIds(), dex_cache->NumResolvedTypesArray());
+  EXPECT_OBJ_PTR_EQ(object_class.Get(), dex_cache->GetResolvedType(type_idx));
+}
+
 TEST_F(DexCacheMethodHandlesTest, Open) {
   ScopedObjectAccess soa(Thread::Current());
   StackHandleScope<1> hs(soa.Self());
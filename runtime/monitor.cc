@@ -16,11 +16,14 @@
 
 #include "monitor-inl.h"
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "android-base/stringprintf.h"
 
 #include "art_method-inl.h"
+#include "base/casts.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/mutex.h"
 #include "base/quasi_atomic.h"
@@ -35,6 +38,7 @@
 #include "lock_word-inl.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
+#include "monitor_contention_profiler.h"
 #include "object_callbacks.h"
 #include "scoped_thread_state_change-inl.h"
 #include "stack.h"
@@ -83,6 +87,7 @@ static constexpr uint64_t kLongWaitMs = 100 * kDebugThresholdFudgeFactor;
 
 uint32_t Monitor::lock_profiling_threshold_ = 0;
 uint32_t Monitor::stack_dump_lock_profiling_threshold_ = 0;
+std::atomic<uint32_t> Monitor::idle_epoch_(0);
 
 void Monitor::Init(uint32_t lock_profiling_threshold,
                    uint32_t stack_dump_lock_profiling_threshold) {
@@ -103,6 +108,10 @@ Monitor::Monitor(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_
       wait_set_(nullptr),
       wake_set_(nullptr),
       hash_code_(hash_code),
+      average_hold_time_ns_(0),
+      hold_start_ns_(0),
+      last_acquired_epoch_(idle_epoch_.load(std::memory_order_relaxed)),
+      cached_owner_state_(0u),
       lock_owner_(nullptr),
       lock_owner_method_(nullptr),
       lock_owner_dex_pc_(0),
@@ -137,6 +146,10 @@ Monitor::Monitor(Thread* self,
       wait_set_(nullptr),
       wake_set_(nullptr),
       hash_code_(hash_code),
+      average_hold_time_ns_(0),
+      hold_start_ns_(0),
+      last_acquired_epoch_(idle_epoch_.load(std::memory_order_relaxed)),
+      cached_owner_state_(0u),
       lock_owner_(nullptr),
       lock_owner_method_(nullptr),
       lock_owner_dex_pc_(0),
@@ -420,20 +433,88 @@ std::string Monitor::PrettyContentionInfo(const std::string& owner_name,
   return oss.str();
 }
 
+// Returns whether the thread returned by `get_owner` is runnable, and therefore may release the
+// lock it holds soon. Spinning for a suspended or blocked owner is wasted work. The thread list
+// lock keeps the owner alive while we look at it. We don't want to wait for it here, so if it's
+// not available we assume the owner is runnable.
+template <typename GetOwner>
+static bool IsLockOwnerRunnable(Thread* self, GetOwner get_owner) NO_THREAD_SAFETY_ANALYSIS {
+  if (!Locks::thread_list_lock_->ExclusiveTryLock(self)) {
+    return true;
+  }
+  Thread* owner = get_owner();
+  bool runnable = owner == nullptr || owner->GetState() == ThreadState::kRunnable;
+  Locks::thread_list_lock_->ExclusiveUnlock(self);
+  return runnable;
+}
+
+bool Monitor::ShouldSpin(Thread* self) {
+  if (GetAverageHoldTimeNs() > kMaxSpinHoldTimeNs) {
+    return false;
+  }
+  // Only the first contender of a hold looks at the owner's state, the others use its answer.
+  Thread* owner = owner_.load(std::memory_order_relaxed);
+  uintptr_t cached = cached_owner_state_.load(std::memory_order_relaxed);
+  if (owner != nullptr && (cached & ~kOwnerRunnableBit) == reinterpret_cast<uintptr_t>(owner)) {
+    return (cached & kOwnerRunnableBit) != 0u;
+  }
+  Thread* checked_owner = nullptr;
+  bool runnable = IsLockOwnerRunnable(self, [this, &checked_owner]() {
+    checked_owner = owner_.load(std::memory_order_relaxed);
+    return checked_owner;
+  });
+  if (checked_owner != nullptr) {
+    uintptr_t state = reinterpret_cast<uintptr_t>(checked_owner);
+    cached_owner_state_.store(runnable ? (state | kOwnerRunnableBit) : state,
+                              std::memory_order_relaxed);
+  }
+  return runnable;
+}
+
+void Monitor::NoteAcquired(bool contended) {
+  uint32_t epoch = idle_epoch_.load(std::memory_order_relaxed);
+  if (last_acquired_epoch_.load(std::memory_order_relaxed) != epoch) {
+    last_acquired_epoch_.store(epoch, std::memory_order_relaxed);
+  }
+  // The owner state cached by contenders of the previous hold is stale.
+  if (cached_owner_state_.load(std::memory_order_relaxed) != 0u) {
+    cached_owner_state_.store(0u, std::memory_order_relaxed);
+  }
+  // Only time holds that other threads are waiting for.
+  bool timed = contended || num_waiters_.load(std::memory_order_relaxed) != 0;
+  hold_start_ns_ = timed ? NanoTime() : 0;
+}
+
+void Monitor::NoteReleased() {
+  if (hold_start_ns_ == 0) {
+    return;
+  }
+  uint32_t hold_ns = dchecked_integral_cast<uint32_t>(
+      std::min<uint64_t>(NanoTime() - hold_start_ns_, std::numeric_limits<uint32_t>::max()));
+  hold_start_ns_ = 0;
+  uint32_t average = average_hold_time_ns_.load(std::memory_order_relaxed);
+  // Give the new sample a weight of 1/8, or use it as is if it is the first one.
+  average = (average == 0) ? hold_ns : average - average / 8 + hold_ns / 8;
+  average_hold_time_ns_.store(std::max(average, 1u), std::memory_order_relaxed);
+}
+
 bool Monitor::TryLock(Thread* self, bool spin) {
   Thread *owner = owner_.load(std::memory_order_relaxed);
   if (owner == self) {
     lock_count_++;
     CHECK_NE(lock_count_, 0u);  // Abort on overflow.
   } else {
-    bool success = spin ? monitor_lock_.ExclusiveTryLockWithSpinning(self)
-        : monitor_lock_.ExclusiveTryLock(self);
+    bool success = monitor_lock_.ExclusiveTryLock(self);
+    if (!success && spin && ShouldSpin(self)) {
+      success = monitor_lock_.ExclusiveTryLockWithSpinning(self);
+    }
     if (!success) {
       return false;
     }
     DCHECK(owner_.load(std::memory_order_relaxed) == nullptr);
     owner_.store(self, std::memory_order_relaxed);
     CHECK_EQ(lock_count_, 0u);
+    NoteAcquired(/*contended=*/ false);
     if (ATraceEnabled()) {
       SetLockingMethodNoProxy(self);
     }
@@ -457,6 +538,17 @@ void Monitor::Lock(Thread* self) {
   // Contended; not reentrant. We hold no locks, so tread carefully.
   const bool log_contention = (lock_profiling_threshold_ != 0);
   uint64_t wait_start_ms = log_contention ? MilliTime() : 0;
+  Runtime* const runtime = Runtime::Current();
+  MonitorContentionProfiler* const contention_profiler = runtime->GetMonitorContentionProfiler();
+  // Avoid the shared counter cache line on every contended acquisition unless someone looks.
+  if (runtime->IsMetricsReportingEnabled() || contention_profiler != nullptr) {
+    runtime->GetMetrics()->MonitorContentionCount()->AddOne();
+  }
+  const bool sample_contention =
+      contention_profiler != nullptr && contention_profiler->ShouldSample();
+  uint64_t wait_start_ns = sample_contention ? NanoTime() : 0;
+  uint64_t sampled_wait_ns = 0;
+  ArtMethod* sampled_owners_method = nullptr;
 
   Thread *orig_owner = nullptr;
   ArtMethod* owners_method;
@@ -498,7 +590,7 @@ void Monitor::Lock(Thread* self) {
       Locks::thread_list_lock_->ExclusiveUnlock(self);
     }
   }
-  if (log_contention) {
+  if (log_contention || sample_contention) {
     // Request the current holder to set lock_owner_info.
     // Do this even if tracing is enabled, so we semi-consistently get the information
     // corresponding to MonitorExit.
@@ -523,6 +615,13 @@ void Monitor::Lock(Thread* self) {
     // touching monitors shortly after we suspend, so don't spin again here.
     monitor_lock_.ExclusiveLock(self);
 
+    if (sample_contention) {
+      sampled_wait_ns = NanoTime() - wait_start_ns;
+      if (orig_owner != nullptr) {
+        uint32_t sampled_owners_dex_pc;
+        GetLockOwnerInfo(&sampled_owners_method, &sampled_owners_dex_pc, orig_owner);
+      }
+    }
     if (log_contention && orig_owner != nullptr) {
       // Woken from contention.
       uint64_t wait_ms = MilliTime() - wait_start_ms;
@@ -627,10 +726,18 @@ void Monitor::Lock(Thread* self) {
   // We avoided touching monitor fields while suspended, so set owner_ here.
   owner_.store(self, std::memory_order_relaxed);
   DCHECK_EQ(lock_count_, 0u);
+  NoteAcquired(/*contended=*/ true);
 
   if (ATraceEnabled()) {
     SetLockingMethodNoProxy(self);
   }
+  if (sample_contention) {
+    contention_profiler->Record(sampled_owners_method,
+                                self->GetCurrentMethod(/*dex_pc=*/ nullptr),
+                                GetObject()->GetClass(),
+                                sampled_wait_ns);
+    runtime->GetMetrics()->MonitorContentionTime()->Add(NsToUs(sampled_wait_ns));
+  }
   if (started_trace) {
     ATraceEnd();
   }
@@ -751,6 +858,7 @@ bool Monitor::Unlock(Thread* self) {
     CheckLockOwnerRequest(self);
     AtraceMonitorUnlock();
     if (lock_count_ == 0) {
+      NoteReleased();
       owner_.store(nullptr, std::memory_order_relaxed);
       SignalWaiterAndReleaseMonitorLock(self);
     } else {
@@ -868,6 +976,7 @@ void Monitor::Wait(Thread* self, int64_t ms, int32_t ns,
   bool was_interrupted = false;
   bool timed_out = false;
   // Update monitor state now; it's not safe once we're "suspended".
+  NoteReleased();
   owner_.store(nullptr, std::memory_order_relaxed);
   num_waiters_.fetch_add(1, std::memory_order_relaxed);
   {
@@ -1165,7 +1274,15 @@ ObjPtr<mirror::Object> Monitor::MonitorEnter(Thread* self,
           // Contention.
           contention_count++;
           Runtime* runtime = Runtime::Current();
-          if (contention_count
+          if (contention_count == kExtraSpinIters + 1 &&
+              !IsLockOwnerRunnable(self, [runtime, owner_thread_id]() NO_THREAD_SAFETY_ANALYSIS {
+                return runtime->GetThreadList()->FindThreadByThreadId(owner_thread_id);
+              })) {
+            // The owner did not release the lock while we busy-waited, and is not running.
+            // Yielding to it is unlikely to help, and suspending it for inflation is cheap.
+            contention_count = 0;
+            InflateThinLocked(self, h_obj, lock_word, 0);
+          } else if (contention_count
               <= kExtraSpinIters + runtime->GetMaxSpinsBeforeThinLockInflation()) {
             // TODO: Consider switching the thread state to kWaitingForLockInflation when we are
             // yielding.  Use sched_yield instead of NanoSleep since NanoSleep can wait much longer
@@ -1676,10 +1793,18 @@ size_t MonitorList::Size() {
 
 class MonitorDeflateVisitor : public IsMarkedVisitor {
  public:
-  MonitorDeflateVisitor() : self_(Thread::Current()), deflate_count_(0) {}
+  explicit MonitorDeflateVisitor(bool only_idle)
+      : self_(Thread::Current()), only_idle_(only_idle), deflate_count_(0) {}
 
   mirror::Object* IsMarked(mirror::Object* object) override
       REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (only_idle_) {
+      LockWord lock_word = object->GetLockWord(false);
+      if (lock_word.GetState() == LockWord::kFatLocked &&
+          !lock_word.FatLockMonitor()->IsIdle()) {
+        return object;  // Recently used, keep the monitor.
+      }
+    }
     if (Monitor::Deflate(self_, object)) {
       DCHECK_NE(object->GetLockWord(true).GetState(), LockWord::kFatLocked);
       ++deflate_count_;
@@ -1690,16 +1815,21 @@ class MonitorDeflateVisitor : public IsMarkedVisitor {
   }
 
   Thread* const self_;
+  const bool only_idle_;
   size_t deflate_count_;
 };
 
-size_t MonitorList::DeflateMonitors() {
-  MonitorDeflateVisitor visitor;
+size_t MonitorList::DeflateMonitors(bool only_idle) {
+  MonitorDeflateVisitor visitor(only_idle);
   Locks::mutator_lock_->AssertExclusiveHeld(visitor.self_);
   SweepMonitorList(&visitor);
   return visitor.deflate_count_;
 }
 
+void MonitorList::StartIdleInterval() {
+  Monitor::idle_epoch_.fetch_add(1u, std::memory_order_relaxed);
+}
+
 MonitorInfo::MonitorInfo(ObjPtr<mirror::Object> obj) : owner_(nullptr), entry_count_(0) {
   DCHECK(obj != nullptr);
   LockWord lock_word = obj->GetLockWord(true);
@@ -67,6 +67,11 @@ class Monitor {
 
   static constexpr int kMonitorTimeoutMaxMs = 1000;  // 1 second
 
+  // Contending threads park right away, instead of spinning, on a monitor whose average contended
+  // hold time exceeds this. It is roughly what spinning in Mutex::ExclusiveTryLockWithSpinning
+  // costs at most, and comparable to a futex wait and wake.
+  static constexpr uint32_t kMaxSpinHoldTimeNs = 10'000;
+
   ~Monitor();
 
   static void Init(uint32_t lock_profiling_threshold, uint32_t stack_dump_lock_profiling_threshold);
@@ -164,6 +169,17 @@ class Monitor {
   static bool Deflate(Thread* self, ObjPtr<mirror::Object> obj)
       REQUIRES_SHARED(Locks::mutator_lock_) NO_THREAD_SAFETY_ANALYSIS;
 
+  // Average time the monitor was held for, over recent contended acquisitions. Zero if unknown.
+  uint32_t GetAverageHoldTimeNs() const {
+    return average_hold_time_ns_.load(std::memory_order_relaxed);
+  }
+
+  // Returns true if nobody acquired the monitor since the last MonitorList::StartIdleInterval().
+  bool IsIdle() const {
+    return last_acquired_epoch_.load(std::memory_order_relaxed) !=
+        idle_epoch_.load(std::memory_order_relaxed);
+  }
+
 #ifndef __LP64__
   void* operator new(size_t size) {
     // Align Monitor* as per the monitor ID field size in the lock word.
@@ -299,6 +315,14 @@ class Monitor {
   void SetLockingMethodNoProxy(Thread* owner) REQUIRES(monitor_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Bookkeeping for the adaptive spinning and idle deflation, done by the new owner when it
+  // acquires monitor_lock_ and before it releases it.
+  void NoteAcquired(bool contended) REQUIRES(monitor_lock_);
+  void NoteReleased() REQUIRES(monitor_lock_);
+
+  // Should a thread that failed to acquire the monitor spin before parking?
+  bool ShouldSpin(Thread* self) REQUIRES(!monitor_lock_);
+
   // Support for systrace output of monitor operations.
   ALWAYS_INLINE static void AtraceMonitorLock(Thread* self,
                                               ObjPtr<mirror::Object> obj,
@@ -314,6 +338,10 @@ class Monitor {
   static uint32_t stack_dump_lock_profiling_threshold_;
   static bool capture_method_eagerly_;
 
+  // Incremented by MonitorList::StartIdleInterval(). A monitor whose last_acquired_epoch_ differs
+  // has not been acquired in the current interval.
+  static std::atomic<uint32_t> idle_epoch_;
+
   // Holding the monitor N times is represented by holding monitor_lock_ N times.
   Mutex monitor_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
@@ -348,6 +376,21 @@ class Monitor {
   // Stored object hash code, generated lazily by GetHashCode.
   AtomicInteger hash_code_;
 
+  // Exponential moving average of the time the monitor is held, in nanoseconds. Only holds that
+  // begin with other threads contending are timed, so the uncontended path doesn't read the clock.
+  std::atomic<uint32_t> average_hold_time_ns_;
+
+  // When the current hold started, or zero if it is not being timed.
+  uint64_t hold_start_ns_ GUARDED_BY(monitor_lock_);
+
+  // The idle_epoch_ at the last acquisition.
+  std::atomic<uint32_t> last_acquired_epoch_;
+
+  // The owner seen by the first contender of the current hold, with kOwnerRunnableBit set if it
+  // was runnable. Saves the other contenders the thread list lock. Cleared on acquisition.
+  std::atomic<uintptr_t> cached_owner_state_;
+  static constexpr uintptr_t kOwnerRunnableBit = 1u;
+
   // Data structure used to remember the method and dex pc of a recent holder of the
   // lock. Used for tracing and contention reporting. Setting these is expensive, since it
   // involves a partial stack walk. We set them only as follows, to minimize the cost:
@@ -433,6 +476,7 @@ class Monitor {
   friend class MonitorList;
   friend class MonitorPool;
   friend class mirror::Object;
+  ART_FRIEND_TEST(MonitorTest, ShouldSpin);  // For ShouldSpin and average_hold_time_ns_.
   DISALLOW_COPY_AND_ASSIGN(Monitor);
 };
 
@@ -448,8 +492,12 @@ class MonitorList {
   void DisallowNewMonitors() REQUIRES(!monitor_list_lock_);
   void AllowNewMonitors() REQUIRES(!monitor_list_lock_);
   void BroadcastForNewMonitors() REQUIRES(!monitor_list_lock_);
-  // Returns how many monitors were deflated.
-  size_t DeflateMonitors() REQUIRES(!monitor_list_lock_) REQUIRES(Locks::mutator_lock_);
+  // Returns how many monitors were deflated. If `only_idle`, monitors that were acquired since the
+  // last StartIdleInterval() are kept.
+  size_t DeflateMonitors(bool only_idle = false)
+      REQUIRES(!monitor_list_lock_) REQUIRES(Locks::mutator_lock_);
+  // Start a new interval for the idle monitor tracking.
+  static void StartIdleInterval();
   size_t Size() REQUIRES(!monitor_list_lock_);
 
   using Monitors = std::list<Monitor*, TrackingAllocator<Monitor*, kAllocatorTagMonitorList>>;
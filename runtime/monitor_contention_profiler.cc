@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor_contention_profiler.h"
+
+#include <ostream>
+
+#include "android-base/logging.h"
+#include "art_method-inl.h"
+#include "base/time_utils.h"
+#include "mirror/class-inl.h"
+
+namespace art {
+
+namespace {
+
+std::string MethodName(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_) {
+  return method != nullptr ? method->PrettyMethod() : "<unknown>";
+}
+
+}  // namespace
+
+MonitorContentionProfiler::MonitorContentionProfiler(uint32_t sampling_interval)
+    : sampling_interval_(sampling_interval) {
+  CHECK_NE(sampling_interval_, 0u);
+}
+
+void MonitorContentionProfiler::Record(ArtMethod* owner_method,
+                                       ArtMethod* waiter_method,
+                                       ObjPtr<mirror::Class> klass,
+                                       uint64_t wait_ns) {
+  // Key on the method pointers and the descriptor hash rather than the class pointer, which a
+  // moving GC may change.
+  uint64_t key = Mix64(reinterpret_cast<uintptr_t>(owner_method));
+  key = Mix64(key ^ reinterpret_cast<uintptr_t>(waiter_method));
+  key = Mix64(key ^ klass->DescriptorHash());
+
+  Site* site = sites_.FindOrClaim(key, [&](Site* new_site) REQUIRES_SHARED(Locks::mutator_lock_) {
+    // Formatting the names is the only expensive part, and is done once per site.
+    new_site->owner_method = MethodName(owner_method);
+    new_site->waiter_method = MethodName(waiter_method);
+    std::string temp;
+    new_site->class_descriptor = klass->GetDescriptor(&temp);
+  });
+  if (site == nullptr) {
+    return;
+  }
+  site->samples.fetch_add(1u, std::memory_order_relaxed);
+  site->total_wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+  uint64_t max_wait_ns = site->max_wait_ns.load(std::memory_order_relaxed);
+  while (wait_ns > max_wait_ns &&
+         !site->max_wait_ns.compare_exchange_weak(
+             max_wait_ns, wait_ns, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<MonitorContentionProfiler::ContendedSite>
+MonitorContentionProfiler::GetTopContendedSites(size_t n) const {
+  return sites_.GetTop<ContendedSite>(
+      n,
+      [](const Site& site) {
+        return ContendedSite{site.owner_method,
+                             site.waiter_method,
+                             site.class_descriptor,
+                             site.samples.load(std::memory_order_relaxed),
+                             site.total_wait_ns.load(std::memory_order_relaxed),
+                             site.max_wait_ns.load(std::memory_order_relaxed)};
+      },
+      [](const ContendedSite& lhs, const ContendedSite& rhs) {
+        return lhs.total_wait_ns > rhs.total_wait_ns;
+      });
+}
+
+void MonitorContentionProfiler::Dump(std::ostream& os, size_t n) const {
+  std::vector<ContendedSite> sites = GetTopContendedSites(n);
+  os << "Monitor contention (1 in " << sampling_interval_ << " of "
+     << contended_events_.load(std::memory_order_relaxed) << " contended acquisitions sampled, "
+     << sites_.GetDroppedSamples() << " samples dropped):\n";
+  for (const ContendedSite& site : sites) {
+    os << "  " << site.class_descriptor << " held by " << site.owner_method
+       << " blocking " << site.waiter_method << ": " << site.samples << " samples, total "
+       << PrettyDuration(site.total_wait_ns) << ", max " << PrettyDuration(site.max_wait_ns)
+       << "\n";
+  }
+}
+
+void MonitorContentionProfiler::Reset() {
+  sites_.Reset();
+  contended_events_.store(0u, std::memory_order_relaxed);
+}
+
+}  // namespace art
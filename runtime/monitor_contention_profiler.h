@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_MONITOR_CONTENTION_PROFILER_H_
+#define ART_RUNTIME_MONITOR_CONTENTION_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "base/sampled_site_table.h"
+#include "obj_ptr.h"
+
+namespace art {
+
+class ArtMethod;
+
+namespace mirror {
+class Class;
+}  // namespace mirror
+
+// Aggregates sampled monitor contention events by (lock owner method, waiting method, class of
+// the locked object). Unlike the -Xlockprofthreshold logging in monitor.cc, nothing is formatted
+// on the contended path for an already known site, so the profiler is cheap enough to leave on.
+class MonitorContentionProfiler {
+ public:
+  // Record one in every `sampling_interval` contended monitor acquisitions.
+  explicit MonitorContentionProfiler(uint32_t sampling_interval);
+
+  // Called on the contended path before blocking. Returns whether this event should be recorded.
+  bool ShouldSample() {
+    return contended_events_.fetch_add(1u, std::memory_order_relaxed) % sampling_interval_ == 0u;
+  }
+
+  // Record a sampled event. `owner_method` may be null if the owner did not report its method in
+  // time, `klass` is the class of the locked object.
+  void Record(ArtMethod* owner_method,
+              ArtMethod* waiter_method,
+              ObjPtr<mirror::Class> klass,
+              uint64_t wait_ns)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  struct ContendedSite {
+    std::string owner_method;
+    std::string waiter_method;
+    std::string class_descriptor;
+    uint64_t samples;
+    uint64_t total_wait_ns;
+    uint64_t max_wait_ns;
+  };
+
+  // Return up to `n` published sites, ordered by decreasing total wait time.
+  std::vector<ContendedSite> GetTopContendedSites(size_t n) const;
+
+  // Print the top contended sites, used for SIGQUIT.
+  void Dump(std::ostream& os, size_t n = kDefaultDumpedSites) const;
+
+  // Clear all the recorded sites. Not safe to call concurrently with Record().
+  void Reset();
+
+  uint32_t GetSamplingInterval() const {
+    return sampling_interval_;
+  }
+
+  static constexpr size_t kTableSize = 1024;
+  static constexpr size_t kMaxProbes = 32;
+  static constexpr size_t kDefaultDumpedSites = 10;
+
+ private:
+  struct Site {
+    std::atomic<uint64_t> samples{0u};
+    std::atomic<uint64_t> total_wait_ns{0u};
+    std::atomic<uint64_t> max_wait_ns{0u};
+    std::string owner_method;
+    std::string waiter_method;
+    std::string class_descriptor;
+
+    void Reset() {
+      samples.store(0u, std::memory_order_relaxed);
+      total_wait_ns.store(0u, std::memory_order_relaxed);
+      max_wait_ns.store(0u, std::memory_order_relaxed);
+    }
+  };
+
+  const uint32_t sampling_interval_;
+  std::atomic<uint64_t> contended_events_{0u};
+  SampledSiteTable<Site, kTableSize, kMaxProbes> sites_;
+
+  DISALLOW_COPY_AND_ASSIGN(MonitorContentionProfiler);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_MONITOR_CONTENTION_PROFILER_H_
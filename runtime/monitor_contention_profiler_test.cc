@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor_contention_profiler.h"
+
+#include <sstream>
+
+#include "art_method-inl.h"
+#include "class_linker.h"
+#include "common_runtime_test.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-current-inl.h"
+
+namespace art {
+
+class MonitorContentionProfilerTest : public CommonRuntimeTest {};
+
+TEST_F(MonitorContentionProfilerTest, SamplingInterval) {
+  MonitorContentionProfiler profiler(/*sampling_interval=*/ 4u);
+  size_t sampled = 0;
+  for (size_t i = 0; i != 16; ++i) {
+    if (profiler.ShouldSample()) {
+      ++sampled;
+    }
+  }
+  EXPECT_EQ(4u, sampled);
+}
+
+TEST_F(MonitorContentionProfilerTest, AggregatesSites) {
+  ScopedObjectAccess soa(Thread::Current());
+  ObjPtr<mirror::Class> object_class = class_linker_->FindSystemClass(soa.Self(),
+                                                                      "Ljava/lang/Object;");
+  ObjPtr<mirror::Class> string_class = class_linker_->FindSystemClass(soa.Self(),
+                                                                      "Ljava/lang/String;");
+  ASSERT_TRUE(object_class != nullptr);
+  ASSERT_TRUE(string_class != nullptr);
+  ArtMethod* to_string =
+      object_class->FindClassMethod("toString", "()Ljava/lang/String;", kRuntimePointerSize);
+  ArtMethod* hash_code = object_class->FindClassMethod("hashCode", "()I", kRuntimePointerSize);
+  ASSERT_TRUE(to_string != nullptr);
+  ASSERT_TRUE(hash_code != nullptr);
+
+  MonitorContentionProfiler profiler(/*sampling_interval=*/ 1u);
+  profiler.Record(to_string, hash_code, object_class, /*wait_ns=*/ 100u);
+  profiler.Record(to_string, hash_code, object_class, /*wait_ns=*/ 300u);
+  profiler.Record(hash_code, to_string, object_class, /*wait_ns=*/ 50u);
+  profiler.Record(/*owner_method=*/ nullptr, hash_code, string_class, /*wait_ns=*/ 1000u);
+
+  std::vector<MonitorContentionProfiler::ContendedSite> sites = profiler.GetTopContendedSites(10);
+  ASSERT_EQ(3u, sites.size());
+  EXPECT_EQ("java.lang.String java.lang.Object.toString()", sites[1].owner_method);
+  EXPECT_EQ("int java.lang.Object.hashCode()", sites[1].waiter_method);
+  EXPECT_EQ("Ljava/lang/Object;", sites[1].class_descriptor);
+  EXPECT_EQ(2u, sites[1].samples);
+  EXPECT_EQ(400u, sites[1].total_wait_ns);
+  EXPECT_EQ(300u, sites[1].max_wait_ns);
+
+  EXPECT_EQ("<unknown>", sites[0].owner_method);
+  EXPECT_EQ("Ljava/lang/String;", sites[0].class_descriptor);
+  EXPECT_EQ(1000u, sites[0].total_wait_ns);
+  EXPECT_EQ(50u, sites[2].total_wait_ns);
+
+  sites = profiler.GetTopContendedSites(1);
+  ASSERT_EQ(1u, sites.size());
+  EXPECT_EQ(1000u, sites[0].total_wait_ns);
+
+  std::ostringstream oss;
+  profiler.Dump(oss);
+  EXPECT_NE(std::string::npos, oss.str().find("Ljava/lang/String; held by <unknown>"));
+}
+
+}  // namespace art
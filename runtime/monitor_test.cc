@@ -16,6 +16,8 @@
 
 #include "monitor.h"
 
+#include <unistd.h>
+
 #include <memory>
 #include <string>
 
@@ -30,6 +32,7 @@
 #include "mirror/string-inl.h"  // Strings are easiest to allocate
 #include "object_lock.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_list.h"
 #include "thread_pool.h"
 
 namespace art {
@@ -391,5 +394,137 @@ TEST_F(MonitorTest, TestTryLock) {
   thread_pool.StopWorkers(self);
 }
 
+TEST_F(MonitorTest, DeflateIdleMonitors) {
+  Thread* const self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  StackHandleScope<2> hs(self);
+  Handle<mirror::Object> used(
+      hs.NewHandle<mirror::Object>(mirror::String::AllocFromModifiedUtf8(self, "used")));
+  Handle<mirror::Object> idle(
+      hs.NewHandle<mirror::Object>(mirror::String::AllocFromModifiedUtf8(self, "idle")));
+  // Hashing a locked object inflates its monitor.
+  for (Handle<mirror::Object> obj : {used, idle}) {
+    ObjectLock<mirror::Object> lock(self, obj);
+    obj->IdentityHashCode();
+    ASSERT_EQ(LockWord::kFatLocked, obj->GetLockWord(true).GetState());
+  }
+
+  MonitorList::StartIdleInterval();
+  {
+    ObjectLock<mirror::Object> lock(self, used);
+  }
+  EXPECT_FALSE(used->GetLockWord(true).FatLockMonitor()->IsIdle());
+  EXPECT_TRUE(idle->GetLockWord(true).FatLockMonitor()->IsIdle());
+
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    ScopedSuspendAll ssa(__FUNCTION__);
+    EXPECT_GE(Runtime::Current()->GetMonitorList()->DeflateMonitors(/*only_idle=*/ true), 1u);
+  }
+  EXPECT_EQ(LockWord::kFatLocked, used->GetLockWord(true).GetState());
+  EXPECT_EQ(LockWord::kHashCode, idle->GetLockWord(true).GetState());
+}
+
+TEST_F(MonitorTest, ShouldSpin) {
+  Thread* const self = Thread::Current();
+  ThreadPool thread_pool("the pool", 1);
+  ScopedObjectAccess soa(self);
+  StackHandleScope<1> hs(self);
+  Handle<mirror::Object> obj(
+      hs.NewHandle<mirror::Object>(mirror::String::AllocFromModifiedUtf8(self, "hello, world!")));
+  {
+    ObjectLock<mirror::Object> lock(self, obj);
+    obj->IdentityHashCode();
+  }
+  ASSERT_EQ(LockWord::kFatLocked, obj->GetLockWord(true).GetState());
+  Monitor* monitor = obj->GetLockWord(true).FatLockMonitor();
+
+  // Without an owner, only the average hold time matters.
+  monitor->average_hold_time_ns_.store(Monitor::kMaxSpinHoldTimeNs, std::memory_order_relaxed);
+  EXPECT_TRUE(monitor->ShouldSpin(self));
+  monitor->average_hold_time_ns_.store(Monitor::kMaxSpinHoldTimeNs + 1u,
+                                       std::memory_order_relaxed);
+  EXPECT_FALSE(monitor->ShouldSpin(self));
+  monitor->average_hold_time_ns_.store(0u, std::memory_order_relaxed);
+
+  // Contenders don't spin while the owner is suspended.
+  jobject g_obj = soa.Vm()->AddGlobalRef(self, obj.Get());
+  Barrier owner_suspended(2);
+  Barrier release(2);
+  thread_pool.AddTask(self, new FunctionTask([&](Thread* worker) {
+    ScopedObjectAccess worker_soa(worker);
+    StackHandleScope<1> worker_hs(worker);
+    Handle<mirror::Object> worker_obj(
+        worker_hs.NewHandle(worker_soa.Decode<mirror::Object>(g_obj)));
+    ObjectLock<mirror::Object> lock(worker, worker_obj);
+    ScopedThreadSuspension sts(worker, ThreadState::kSuspended);
+    owner_suspended.Increment<Barrier::kAllowHoldingLocks>(worker, -1);
+    release.Increment<Barrier::kAllowHoldingLocks>(worker, -1);
+  }));
+  thread_pool.StartWorkers(self);
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    owner_suspended.Wait(self);
+  }
+  EXPECT_FALSE(monitor->ShouldSpin(self));
+  // The answer is cached for the other contenders of the same hold.
+  EXPECT_FALSE(monitor->ShouldSpin(self));
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    release.Wait(self);
+    thread_pool.Wait(self, /*do_work=*/ false, /*may_hold_locks=*/ false);
+  }
+  thread_pool.StopWorkers(self);
+  soa.Vm()->DeleteGlobalRef(self, g_obj);
+}
+
+class MonitorInflationTest : public MonitorTest {
+ protected:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    MonitorTest::SetUpRuntimeOptions(options);
+    // Only inflate early, the contender would otherwise yield for a very long time.
+    options->push_back(
+        std::make_pair("-XX:MaxSpinsBeforeThinLockInflation=100000000", nullptr));
+  }
+};
+
+// Test that a thin lock is inflated right after the initial spinning when its owner is suspended.
+TEST_F(MonitorInflationTest, InflateThinLockOfSuspendedOwner) {
+  Thread* const self = Thread::Current();
+  ThreadPool thread_pool("the pool", 1);
+  ScopedObjectAccess soa(self);
+  StackHandleScope<1> hs(self);
+  Handle<mirror::Object> obj(
+      hs.NewHandle<mirror::Object>(mirror::String::AllocFromModifiedUtf8(self, "hello, world!")));
+  jobject g_obj = soa.Vm()->AddGlobalRef(self, obj.Get());
+  {
+    ObjectLock<mirror::Object> lock(self, obj);
+    ASSERT_EQ(LockWord::kThinLocked, obj->GetLockWord(true).GetState());
+    thread_pool.AddTask(self, new FunctionTask([g_obj](Thread* worker) {
+      ScopedObjectAccess worker_soa(worker);
+      StackHandleScope<1> worker_hs(worker);
+      Handle<mirror::Object> worker_obj(
+          worker_hs.NewHandle(worker_soa.Decode<mirror::Object>(g_obj)));
+      ObjectLock<mirror::Object> worker_lock(worker, worker_obj);
+    }));
+    thread_pool.StartWorkers(self);
+    // Stay suspended most of the time, for the contender to see a suspended owner.
+    bool inflated = false;
+    for (size_t i = 0; i != 10'000u && !inflated; ++i) {
+      {
+        ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+        usleep(1000);
+      }
+      inflated = obj->GetLockWord(true).GetState() == LockWord::kFatLocked;
+    }
+    EXPECT_TRUE(inflated);
+  }
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    thread_pool.Wait(self, /*do_work=*/ false, /*may_hold_locks=*/ false);
+  }
+  thread_pool.StopWorkers(self);
+  soa.Vm()->DeleteGlobalRef(self, g_obj);
+}
 
 }  // namespace art
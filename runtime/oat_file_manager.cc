@@ -16,15 +16,19 @@
 
 #include "oat_file_manager.h"
 
+#include <atomic>
 #include <memory>
 #include <queue>
+#include <set>
 #include <vector>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "android-base/file.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 
+#include "app_info.h"
 #include "art_field-inl.h"
 #include "base/bit_vector-inl.h"
 #include "base/file_utils.h"
@@ -33,6 +37,7 @@
 #include "base/sdk_version.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
+#include "base/time_utils.h"
 #include "class_linker.h"
 #include "class_loader_context.h"
 #include "dex/art_dex_file_loader.h"
@@ -50,8 +55,10 @@
 #include "oat_file.h"
 #include "oat_file_assistant.h"
 #include "obj_ptr-inl.h"
+#include "profile/profile_compilation_info.h"
 #include "runtime_image.h"
 #include "scoped_thread_state_change-inl.h"
+#include "stack_map_cache.h"
 #include "thread-current-inl.h"
 #include "thread_list.h"
 #include "thread_pool.h"
@@ -105,6 +112,8 @@ void OatFileManager::UnRegisterAndDeleteOatFile(const OatFile* oat_file) {
   CHECK(it != oat_files_.end());
   oat_files_.erase(it);
   compare.release();  // NOLINT b/117926937
+  // The oat file is about to be unmapped, drop the stack maps cached for its code.
+  Runtime::Current()->GetStackMapCache()->Invalidate();
 }
 
 const OatFile* OatFileManager::FindOpenedOatFileFromDexLocation(
@@ -672,13 +681,23 @@ static bool UnlinkLeastRecentlyUsedVdexIfNeeded(const std::string& vdex_path_to_
   return true;
 }
 
-class BackgroundVerificationTask final : public Task {
+// The classes of `dex_files` being verified in the background. Each task verifies the
+// classes it claims from a shared list with its own VerifierDeps, so that the tasks never
+// wait for each other. Once all the tasks are done, or were dropped by the deletion of the
+// thread pool, the VerifierDeps are merged and written to the vdex. A thread loading a class
+// that a task is verifying simply waits for the result in ClassLinker::VerifyClass.
+class BackgroundVerification {
  public:
-  BackgroundVerificationTask(const std::vector<const DexFile*>& dex_files,
-                             jobject class_loader,
-                             const std::string& vdex_path)
+  BackgroundVerification(const std::vector<const DexFile*>& dex_files,
+                         jobject class_loader,
+                         const std::string& vdex_path,
+                         size_t num_tasks,
+                         bool use_reference_profile)
       : dex_files_(dex_files),
-        vdex_path_(vdex_path) {
+        vdex_path_(vdex_path),
+        num_tasks_(num_tasks),
+        use_reference_profile_(use_reference_profile),
+        lock_("Background verification lock") {
     Thread* const self = Thread::Current();
     ScopedObjectAccess soa(self);
     // Create a global ref for `class_loader` because it will be accessed from a different thread.
@@ -686,61 +705,142 @@ class BackgroundVerificationTask final : public Task {
     CHECK(class_loader_ != nullptr);
   }
 
-  ~BackgroundVerificationTask() {
+  // Runs when the last task is done or dropped, so no task accesses `finished_deps_` anymore.
+  ~BackgroundVerification() {
     Thread* const self = Thread::Current();
-    ScopedObjectAccess soa(self);
-    soa.Vm()->DeleteGlobalRef(self, class_loader_);
+    {
+      ScopedObjectAccess soa(self);
+      soa.Vm()->DeleteGlobalRef(self, class_loader_);
+    }
+    // A task that started only finishes once it found no class left to verify, so all
+    // the classes are verified unless no task ever ran.
+    if (finished_deps_.empty()) {
+      return;
+    }
+    VLOG(verifier) << "Verified " << classes_.size() << " classes of "
+                   << dex_files_[0]->GetLocation() << " in the background with "
+                   << finished_deps_.size() << " of " << num_tasks_ << " tasks in "
+                   << PrettyDuration(NanoTime() - start_ns_);
+    for (size_t i = 1; i < finished_deps_.size(); ++i) {
+      finished_deps_[0]->MergeWith(std::move(finished_deps_[i]), dex_files_);
+    }
+    WriteVdex(*finished_deps_[0]);
   }
 
-  void Run(Thread* self) override {
-    std::string error_msg;
+  void VerifyClasses(Thread* self) {
+    InitializeClassOrder(self);
+
     ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
-    verifier::VerifierDeps verifier_deps(dex_files_);
+    std::unique_ptr<verifier::VerifierDeps> verifier_deps(
+        new verifier::VerifierDeps(dex_files_));
+
+    for (size_t i = next_class_.fetch_add(1u, std::memory_order_relaxed);
+         i < classes_.size();
+         i = next_class_.fetch_add(1u, std::memory_order_relaxed)) {
+      const DexFile* dex_file = dex_files_[classes_[i].first];
+      const dex::ClassDef& class_def = dex_file->GetClassDef(classes_[i].second);
+
+      // Take handles inside the loop. The background verification is low priority
+      // and we want to minimize the risk of blocking anyone else.
+      ScopedObjectAccess soa(self);
+      StackHandleScope<2> hs(self);
+      Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
+          soa.Decode<mirror::ClassLoader>(class_loader_)));
+      Handle<mirror::Class> h_class(hs.NewHandle<mirror::Class>(class_linker->FindClass(
+          self,
+          dex_file->GetClassDescriptor(class_def),
+          h_loader)));
+
+      if (h_class == nullptr) {
+        DCHECK(self->IsExceptionPending());
+        self->ClearException();
+        continue;
+      }
 
-    // Iterate over all classes and verify them.
-    for (const DexFile* dex_file : dex_files_) {
-      for (uint32_t cdef_idx = 0; cdef_idx < dex_file->NumClassDefs(); cdef_idx++) {
-        const dex::ClassDef& class_def = dex_file->GetClassDef(cdef_idx);
+      if (&h_class->GetDexFile() != dex_file) {
+        // There is a different class in the class path or a parent class loader
+        // with the same descriptor. This `h_class` is not resolvable, skip it.
+        continue;
+      }
 
-        // Take handles inside the loop. The background verification is low priority
-        // and we want to minimize the risk of blocking anyone else.
-        ScopedObjectAccess soa(self);
-        StackHandleScope<2> hs(self);
-        Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
-            soa.Decode<mirror::ClassLoader>(class_loader_)));
-        Handle<mirror::Class> h_class(hs.NewHandle<mirror::Class>(class_linker->FindClass(
-            self,
-            dex_file->GetClassDescriptor(class_def),
-            h_loader)));
-
-        if (h_class == nullptr) {
-          DCHECK(self->IsExceptionPending());
-          self->ClearException();
-          continue;
-        }
+      DCHECK(h_class->IsResolved()) << h_class->PrettyDescriptor();
+      class_linker->VerifyClass(self, verifier_deps.get(), h_class);
+      if (self->IsExceptionPending()) {
+        // ClassLinker::VerifyClass can throw, but the exception isn't useful here.
+        self->ClearException();
+      }
 
-        if (&h_class->GetDexFile() != dex_file) {
-          // There is a different class in the class path or a parent class loader
-          // with the same descriptor. This `h_class` is not resolvable, skip it.
-          continue;
-        }
+      DCHECK(h_class->IsVerified() || h_class->IsErroneous())
+          << h_class->PrettyDescriptor() << ": state=" << h_class->GetStatus();
 
-        DCHECK(h_class->IsResolved()) << h_class->PrettyDescriptor();
-        class_linker->VerifyClass(self, &verifier_deps, h_class);
-        if (self->IsExceptionPending()) {
-          // ClassLinker::VerifyClass can throw, but the exception isn't useful here.
-          self->ClearException();
-        }
+      if (h_class->IsVerified()) {
+        verifier_deps->RecordClassVerified(*dex_file, class_def);
+      }
+    }
 
-        DCHECK(h_class->IsVerified() || h_class->IsErroneous())
-            << h_class->PrettyDescriptor() << ": state=" << h_class->GetStatus();
+    MutexLock mu(self, lock_);
+    finished_deps_.push_back(std::move(verifier_deps));
+  }
 
-        if (h_class->IsVerified()) {
-          verifier_deps.RecordClassVerified(*dex_file, class_def);
+ private:
+  // Order the classes to verify: first the classes of the primary APK's reference profile,
+  // which are the ones used at startup, then all the other ones in dex file order. The
+  // profile does not cover secondary dex files, so they are not looked up in it.
+  void InitializeClassOrder(Thread* self) {
+    MutexLock mu(self, lock_);
+    if (start_ns_ != 0u) {
+      return;
+    }
+    start_ns_ = NanoTime();
+
+    ProfileCompilationInfo profile;
+    bool has_profile = false;
+    if (use_reference_profile_) {
+      std::string profile_file =
+          Runtime::Current()->GetAppInfo()->GetPrimaryApkReferenceProfile();
+      if (!profile_file.empty() && OS::FileExists(profile_file.c_str())) {
+        has_profile = profile.Load(profile_file, /*clear_if_invalid=*/ false);
+      }
+    }
+
+    for (uint32_t dex_file_index = 0; dex_file_index != dex_files_.size(); ++dex_file_index) {
+      const DexFile* dex_file = dex_files_[dex_file_index];
+      std::vector<bool> added(dex_file->NumClassDefs(), false);
+      std::set<dex::TypeIndex> profile_classes;
+      std::set<uint16_t> unused_methods;
+      if (has_profile &&
+          profile.GetClassesAndMethods(*dex_file,
+                                       &profile_classes,
+                                       &unused_methods,
+                                       &unused_methods,
+                                       &unused_methods)) {
+        for (dex::TypeIndex type_index : profile_classes) {
+          if (type_index.index_ >= dex_file->NumTypeIds()) {
+            continue;  // An artificial type index for a class not defined in this dex file.
+          }
+          const dex::ClassDef* class_def = dex_file->FindClassDef(type_index);
+          if (class_def != nullptr) {
+            uint16_t class_def_index = dex_file->GetIndexForClassDef(*class_def);
+            classes_.emplace_back(dex_file_index, class_def_index);
+            added[class_def_index] = true;
+          }
+        }
+      }
+      for (uint32_t class_def_index = 0;
+           class_def_index != dex_file->NumClassDefs();
+           ++class_def_index) {
+        if (!added[class_def_index]) {
+          classes_.emplace_back(dex_file_index, class_def_index);
         }
       }
     }
+  }
 
+  void WriteVdex(const verifier::VerifierDeps& verifier_deps) {
+    if (vdex_path_.empty()) {
+      return;
+    }
+    std::string error_msg;
     // Delete old vdex files if there are too many in the folder.
     if (!UnlinkLeastRecentlyUsedVdexIfNeeded(vdex_path_, &error_msg)) {
       LOG(ERROR) << "Could not unlink old vdex files " << vdex_path_ << ": " << error_msg;
@@ -757,14 +857,39 @@ class BackgroundVerificationTask final : public Task {
     }
   }
 
+  const std::vector<const DexFile*> dex_files_;
+  jobject class_loader_;
+  const std::string vdex_path_;
+  const size_t num_tasks_;
+  const bool use_reference_profile_;
+
+  Mutex lock_;
+  // Set by the first task to run, which also computes `classes_`.
+  uint64_t start_ns_ GUARDED_BY(lock_) = 0u;
+  // Pairs of dex file index and class def index, in verification order.
+  // Read-only once initialized.
+  std::vector<std::pair<uint32_t, uint16_t>> classes_;
+  std::atomic<size_t> next_class_{0u};
+  std::vector<std::unique_ptr<verifier::VerifierDeps>> finished_deps_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundVerification);
+};
+
+class BackgroundVerificationTask final : public Task {
+ public:
+  explicit BackgroundVerificationTask(std::shared_ptr<BackgroundVerification> verification)
+      : verification_(std::move(verification)) {}
+
+  void Run(Thread* self) override {
+    verification_->VerifyClasses(self);
+  }
+
   void Finalize() override {
     delete this;
   }
 
  private:
-  const std::vector<const DexFile*> dex_files_;
-  jobject class_loader_;
-  const std::string vdex_path_;
+  const std::shared_ptr<BackgroundVerification> verification_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundVerificationTask);
 };
@@ -812,8 +937,9 @@ void OatFileManager::RunBackgroundVerification(const std::vector<const DexFile*>
 
   std::string dex_location = dex_files[0]->GetLocation();
   const std::string& data_dir = Runtime::Current()->GetProcessDataDirectory();
-  if (!android::base::StartsWith(dex_location, data_dir)) {
-    // For now, we only run background verification for secondary dex files.
+  const bool is_secondary_dex = android::base::StartsWith(dex_location, data_dir);
+  if (!is_secondary_dex && !runtime->ShouldBackgroundVerifyApks()) {
+    // By default, we only run background verification for secondary dex files.
     // Running it for primary or split APKs could have some undesirable
     // side-effects, like overloading the device on app startup.
     return;
@@ -834,18 +960,29 @@ void OatFileManager::RunBackgroundVerification(const std::vector<const DexFile*>
     return;
   }
 
+  std::string vdex_path = GetVdexFilename(odex_filename);
+  if (!is_secondary_dex && access(android::base::Dirname(vdex_path).c_str(), W_OK) != 0) {
+    // APKs usually live in a read-only location. Still verify the classes so that the
+    // app does not have to do it on its main thread, but do not try to write the vdex.
+    vdex_path.clear();
+  }
+
+  size_t num_tasks;
   {
     WriterMutexLock mu(self, *Locks::oat_file_manager_lock_);
     if (verification_thread_pool_ == nullptr) {
-      verification_thread_pool_.reset(
-          new ThreadPool("Verification thread pool", /* num_threads= */ 1));
+      verification_thread_pool_.reset(new ThreadPool(
+          "Verification thread pool", runtime->GetBackgroundVerificationThreads()));
       verification_thread_pool_->StartWorkers(self);
     }
+    // Use as many tasks as the pool has threads, whoever created it.
+    num_tasks = verification_thread_pool_->GetThreadCount();
+  }
+  auto verification = std::make_shared<BackgroundVerification>(
+      dex_files, class_loader, vdex_path, num_tasks, /*use_reference_profile=*/ !is_secondary_dex);
+  for (size_t i = 0; i != num_tasks; ++i) {
+    verification_thread_pool_->AddTask(self, new BackgroundVerificationTask(verification));
   }
-  verification_thread_pool_->AddTask(self, new BackgroundVerificationTask(
-      dex_files,
-      class_loader,
-      GetVdexFilename(odex_filename)));
 }
 
 void OatFileManager::WaitForWorkersToBeCreated() {
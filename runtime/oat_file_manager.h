@@ -123,7 +123,9 @@ class OatFileManager {
   void SetOnlyUseTrustedOatFiles();
   void ClearOnlyUseTrustedOatFiles();
 
-  // Spawn a background thread which verifies all classes in the given dex files.
+  // Verify all classes in the given dex files on background threads, starting with the
+  // classes of the reference profile, and record the results in a vdex when possible.
+  // Runs for secondary dex files, and for APKs with -Xbackgroundverifyapks:true.
   void RunBackgroundVerification(const std::vector<const DexFile*>& dex_files,
                                  jobject class_loader);
 
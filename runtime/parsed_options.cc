@@ -16,6 +16,7 @@
 
 #include "parsed_options.h"
 
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -257,12 +258,28 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XMadviseWillNeedVdexFileSize:_")
           .WithType<unsigned int>()
           .IntoKey(M::MadviseWillNeedVdexFileSize)
+      .Define("-Xbackgroundverifyapks:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .WithHelp("Also verify the classes of APKs loaded without a vdex in the background,\n"
+                    "not only the ones of secondary dex files.")
+          .IntoKey(M::BackgroundVerifyApks)
+      .Define("-Xbackgroundverificationthreads:_")
+          .WithType<unsigned int>()
+          .WithHelp("Number of threads verifying the classes of a class loader in the background.")
+          .IntoKey(M::BackgroundVerificationThreads)
       .Define("-XMadviseWillNeedOdexFileSize:_")
           .WithType<unsigned int>()
           .IntoKey(M::MadviseWillNeedOdexFileSize)
       .Define("-XMadviseWillNeedArtFileSize:_")
           .WithType<unsigned int>()
           .IntoKey(M::MadviseWillNeedArtFileSize)
+      .Define("-Xlazyimagedecompression:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .WithHelp("Decompress the blocks of compressed images mapped without relocation on\n"
+                    "first touch, through userfaultfd, rather than when loading them.")
+          .IntoKey(M::LazyImageDecompression)
       .Define("-Xusejit:_")
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
@@ -271,6 +288,12 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
           .IntoKey(M::UseProfiledJitCompilation)
+      .Define("-Xjitpersistmethods:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .WithHelp("Remember the JIT-compiled methods of the application dex files, and\n"
+                    "compile them eagerly in the next process loading these dex files.")
+          .IntoKey(M::PersistJitCompiledMethods)
       .Define("-Xjitinitialsize:_")
           .WithType<MemoryKiB>()
           .IntoKey(M::JITCodeCacheInitialCapacity)
@@ -292,6 +315,10 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xjitzygotepthreadpriority:_")
           .WithType<int>()
           .IntoKey(M::JITZygotePoolThreadPthreadPriority)
+      .Define("-Xjitthreads:_")
+          .WithType<unsigned int>()
+          .WithRange(1u, jit::kJitPoolMaxThreadCount)
+          .IntoKey(M::JITPoolThreads)
       .Define("-Xjitsaveprofilinginfo")
           .WithType<ProfileSaverOptions>()
           .AppendValues()
@@ -347,6 +374,20 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xstackdumplockprofthreshold:_")
           .WithType<unsigned int>()
           .IntoKey(M::StackDumpLockProfThreshold)
+      .Define("-Xlockcontentionsampling:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::LockContentionSamplingInterval)
+      .Define("-Xdexcachesampling:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::DexCacheSamplingInterval)
+      .Define("-Xdexcachepromotionmissrate:_")
+          .WithType<unsigned int>()
+          .WithRange(0, 100)
+          .IntoKey(M::DexCachePromotionMissRate)
+      .Define("-Xallocsitesampling:_")
+          .WithType<unsigned int>()
+          .WithRange(0u, static_cast<unsigned int>(std::numeric_limits<int>::max()))
+          .IntoKey(M::AllocationSiteSamplingInterval)
       .Define("-Xmethod-trace")
           .IntoKey(M::MethodTrace)
       .Define("-Xmethod-trace-file:_")
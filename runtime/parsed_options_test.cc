@@ -152,6 +152,83 @@ TEST_F(ParsedOptionsTest, ParsedOptionsGenerationalCC) {
   ASSERT_TRUE(xgc.generational_cc);
 }
 
+TEST_F(ParsedOptionsTest, ParsedOptionsGenerationalCMC) {
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xgc:generational_cmc", nullptr));
+
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  ASSERT_NE(0u, map.Size());
+
+  using Opt = RuntimeArgumentMap;
+
+  EXPECT_TRUE(map.Exists(Opt::GcOption));
+
+  XGcOption xgc = map.GetOrDefault(Opt::GcOption);
+  ASSERT_TRUE(xgc.generational_cmc);
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsPersistJitCompiledMethods) {
+  using Opt = RuntimeArgumentMap;
+
+  {
+    RuntimeOptions options;
+    RuntimeArgumentMap map;
+    bool parsed = ParsedOptions::Parse(options, false, &map);
+    ASSERT_TRUE(parsed);
+    EXPECT_FALSE(map.GetOrDefault(Opt::PersistJitCompiledMethods));
+  }
+
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xjitpersistmethods:true", nullptr));
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  EXPECT_TRUE(map.GetOrDefault(Opt::PersistJitCompiledMethods));
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsBackgroundVerification) {
+  using Opt = RuntimeArgumentMap;
+
+  {
+    RuntimeOptions options;
+    RuntimeArgumentMap map;
+    bool parsed = ParsedOptions::Parse(options, false, &map);
+    ASSERT_TRUE(parsed);
+    EXPECT_FALSE(map.GetOrDefault(Opt::BackgroundVerifyApks));
+    EXPECT_EQ(1u, map.GetOrDefault(Opt::BackgroundVerificationThreads));
+  }
+
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xbackgroundverifyapks:true", nullptr));
+  options.push_back(std::make_pair("-Xbackgroundverificationthreads:4", nullptr));
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  EXPECT_TRUE(map.GetOrDefault(Opt::BackgroundVerifyApks));
+  EXPECT_EQ(4u, map.GetOrDefault(Opt::BackgroundVerificationThreads));
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsAllocationSiteSampling) {
+  using Opt = RuntimeArgumentMap;
+
+  {
+    RuntimeOptions options;
+    RuntimeArgumentMap map;
+    bool parsed = ParsedOptions::Parse(options, false, &map);
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(0u, map.GetOrDefault(Opt::AllocationSiteSamplingInterval));
+  }
+
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xallocsitesampling:4096", nullptr));
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(4096u, map.GetOrDefault(Opt::AllocationSiteSamplingInterval));
+}
+
 TEST_F(ParsedOptionsTest, ParsedOptionsInstructionSet) {
   using Opt = RuntimeArgumentMap;
 
@@ -75,6 +75,7 @@
 #include "debugger.h"
 #include "dex/art_dex_file_loader.h"
 #include "dex/dex_file_loader.h"
+#include "dex_cache_miss_profiler.h"
 #include "elf_file.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
 #include "entrypoints/entrypoint_utils-inl.h"
@@ -118,6 +119,7 @@
 #include "mirror/throwable.h"
 #include "mirror/var_handle.h"
 #include "monitor.h"
+#include "monitor_contention_profiler.h"
 #include "native/dalvik_system_DexFile.h"
 #include "native/dalvik_system_BaseDexClassLoader.h"
 #include "native/dalvik_system_VMDebug.h"
@@ -172,6 +174,7 @@
 #include "sigchain.h"
 #include "signal_catcher.h"
 #include "signal_set.h"
+#include "stack_map_cache.h"
 #include "thread.h"
 #include "thread_list.h"
 #include "ti/agent.h"
@@ -301,6 +304,9 @@ Runtime::Runtime()
       madvise_willneed_total_dex_size_(0),
       madvise_willneed_odex_filesize_(0),
       madvise_willneed_art_filesize_(0),
+      lazy_image_decompression_(false),
+      background_verify_apks_(false),
+      background_verification_threads_(1),
       safe_mode_(false),
       hidden_api_policy_(hiddenapi::EnforcementPolicy::kDisabled),
       core_platform_api_policy_(hiddenapi::EnforcementPolicy::kDisabled),
@@ -315,7 +321,8 @@ Runtime::Runtime()
       verifier_missing_kthrow_fatal_(false),
       perfetto_hprof_enabled_(false),
       perfetto_javaheapprof_enabled_(false),
-      out_of_memory_error_hook_(nullptr) {
+      out_of_memory_error_hook_(nullptr),
+      metrics_reporting_enabled_(false) {
   static_assert(Runtime::kCalleeSaveSize ==
                     static_cast<uint32_t>(CalleeSaveType::kLastCalleeSaveType), "Unexpected size");
   CheckConstants();
@@ -407,6 +414,8 @@ Runtime::~Runtime() {
     // The saver will try to dump the profiles before being sopped and that
     // requires holding the mutator lock.
     jit_->StopProfileSaver();
+    // Like the profile saver, this requires holding the mutator lock.
+    jit_->PersistCompiledMethods(self);
     // Delete thread pool before the thread list since we don't want to wait forever on the
     // JIT compiler threads. Also this should be run before marking the runtime
     // as shutting down as some tasks may require mutator access.
@@ -745,6 +754,10 @@ class UpdateMethodsPreFirstForkVisitor : public ClassVisitor {
 };
 
 void Runtime::PreZygoteFork() {
+  // The child processes would see the pages not decompressed yet as zeros.
+  for (gc::space::ImageSpace* space : heap_->GetBootImageSpaces()) {
+    space->FinishLazyDecompression();
+  }
   if (GetJit() != nullptr) {
     GetJit()->PreZygoteFork();
   }
@@ -1195,7 +1208,7 @@ void Runtime::InitNonZygoteOrPostFork(
     // (better for debugability)
     session_data.session_id = GetRandomNumber<int64_t>(1, std::numeric_limits<int64_t>::max());
     // TODO: set session_data.compilation_reason and session_data.compiler_filter
-    metrics_reporter_->MaybeStartBackgroundThread(session_data);
+    metrics_reporting_enabled_ = metrics_reporter_->MaybeStartBackgroundThread(session_data);
     // Also notify about any updates to the app info.
     metrics_reporter_->NotifyAppInfoUpdated(&app_info_);
   }
@@ -1534,6 +1547,19 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
 
   monitor_list_ = new MonitorList;
   monitor_pool_ = MonitorPool::Create();
+  uint32_t lock_contention_sampling_interval =
+      runtime_options.GetOrDefault(Opt::LockContentionSamplingInterval);
+  if (lock_contention_sampling_interval != 0u) {
+    monitor_contention_profiler_ =
+        std::make_unique<MonitorContentionProfiler>(lock_contention_sampling_interval);
+  }
+  stack_map_cache_ = std::make_unique<StackMapCache>();
+  uint32_t dex_cache_sampling_interval =
+      runtime_options.GetOrDefault(Opt::DexCacheSamplingInterval);
+  if (dex_cache_sampling_interval != 0u && !IsAotCompiler()) {
+    dex_cache_miss_profiler_ = std::make_unique<DexCacheMissProfiler>(
+        dex_cache_sampling_interval, runtime_options.GetOrDefault(Opt::DexCachePromotionMissRate));
+  }
   thread_list_ = new ThreadList(runtime_options.GetOrDefault(Opt::ThreadSuspendTimeout));
   intern_table_ = new InternTable;
 
@@ -1588,6 +1614,10 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   madvise_willneed_total_dex_size_ = runtime_options.GetOrDefault(Opt::MadviseWillNeedVdexFileSize);
   madvise_willneed_odex_filesize_ = runtime_options.GetOrDefault(Opt::MadviseWillNeedOdexFileSize);
   madvise_willneed_art_filesize_ = runtime_options.GetOrDefault(Opt::MadviseWillNeedArtFileSize);
+  lazy_image_decompression_ = runtime_options.GetOrDefault(Opt::LazyImageDecompression);
+  background_verify_apks_ = runtime_options.GetOrDefault(Opt::BackgroundVerifyApks);
+  background_verification_threads_ =
+      std::max(1u, runtime_options.GetOrDefault(Opt::BackgroundVerificationThreads));
 
   jni_ids_indirection_ = runtime_options.GetOrDefault(Opt::OpaqueJniIds);
   automatically_set_jni_ids_indirection_ =
@@ -1615,6 +1645,8 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
 
   // Generational CC collection is currently only compatible with Baker read barriers.
   bool use_generational_cc = kUseBakerReadBarrier && xgc_option.generational_cc;
+  // Generational CMC collection requires the userfaultfd-based mark-compact collector.
+  bool use_generational_cmc = gUseUserfaultfd && xgc_option.generational_cmc;
 
   // Cache the apex versions.
   InitializeApexVersions();
@@ -1664,9 +1696,15 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                        xgc_option.measure_,
                        runtime_options.GetOrDefault(Opt::EnableHSpaceCompactForOOM),
                        use_generational_cc,
+                       use_generational_cmc,
                        runtime_options.GetOrDefault(Opt::HSpaceCompactForOOMMinIntervalsMs),
                        runtime_options.Exists(Opt::DumpRegionInfoBeforeGC),
                        runtime_options.Exists(Opt::DumpRegionInfoAfterGC));
+  uint32_t alloc_site_sampling_interval =
+      runtime_options.GetOrDefault(Opt::AllocationSiteSamplingInterval);
+  if (alloc_site_sampling_interval != 0u) {
+    heap_->StartAllocationSiteProfiler(alloc_site_sampling_interval);
+  }
 
   dump_gc_performance_on_shutdown_ = runtime_options.Exists(Opt::DumpGCPerformanceOnShutdown);
 
@@ -2334,6 +2372,12 @@ void Runtime::DumpForSigQuit(std::ostream& os) {
   DumpDeoptimizations(os);
   TrackedAllocators::Dump(os);
   GetMetrics()->DumpForSigQuit(os);
+  if (monitor_contention_profiler_ != nullptr) {
+    monitor_contention_profiler_->Dump(os);
+  }
+  if (dex_cache_miss_profiler_ != nullptr) {
+    dex_cache_miss_profiler_->Dump(os);
+  }
   os << "\n";
 
   BaseMutex::DumpAll(os);
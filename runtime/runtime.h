@@ -96,12 +96,14 @@ enum class CalleeSaveType: uint32_t;
 class ClassLinker;
 class CompilerCallbacks;
 class Dex2oatImageTest;
+class DexCacheMissProfiler;
 class DexFile;
 enum class InstructionSet;
 class InternTable;
 class IsMarkedVisitor;
 class JavaVMExt;
 class LinearAlloc;
+class MonitorContentionProfiler;
 class MonitorList;
 class MonitorPool;
 class NullPointerHandler;
@@ -111,6 +113,7 @@ class Plugin;
 struct RuntimeArgumentMap;
 class RuntimeCallbacks;
 class SignalCatcher;
+class StackMapCache;
 class StackOverflowHandler;
 class SuspensionHandler;
 class ThreadList;
@@ -414,6 +417,20 @@ class Runtime {
     return monitor_pool_;
   }
 
+  // Returns null unless -Xlockcontentionsampling was given.
+  MonitorContentionProfiler* GetMonitorContentionProfiler() const {
+    return monitor_contention_profiler_.get();
+  }
+
+  StackMapCache* GetStackMapCache() const {
+    return stack_map_cache_.get();
+  }
+
+  // Returns null unless -Xdexcachesampling was given.
+  DexCacheMissProfiler* GetDexCacheMissProfiler() const {
+    return dex_cache_miss_profiler_.get();
+  }
+
   // Is the given object the special object used to mark a cleared JNI weak global?
   bool IsClearedJniWeakGlobal(ObjPtr<mirror::Object> obj) REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -1016,6 +1033,18 @@ class Runtime {
     return madvise_willneed_art_filesize_;
   }
 
+  bool IsLazyImageDecompressionEnabled() const {
+    return lazy_image_decompression_;
+  }
+
+  bool ShouldBackgroundVerifyApks() const {
+    return background_verify_apks_;
+  }
+
+  size_t GetBackgroundVerificationThreads() const {
+    return background_verification_threads_;
+  }
+
   const std::string& GetJdwpOptions() {
     return jdwp_options_;
   }
@@ -1121,6 +1150,11 @@ class Runtime {
 
   metrics::ArtMetrics* GetMetrics() { return &metrics_; }
 
+  // Whether the metrics reporter is reporting metrics for this session.
+  bool IsMetricsReportingEnabled() const {
+    return metrics_reporting_enabled_;
+  }
+
   AppInfo* GetAppInfo() { return &app_info_; }
 
   void RequestMetricsReport(bool synchronous = true);
@@ -1310,6 +1344,9 @@ class Runtime {
   size_t max_spins_before_thin_lock_inflation_;
   MonitorList* monitor_list_;
   MonitorPool* monitor_pool_;
+  std::unique_ptr<MonitorContentionProfiler> monitor_contention_profiler_;
+  std::unique_ptr<StackMapCache> stack_map_cache_;
+  std::unique_ptr<DexCacheMissProfiler> dex_cache_miss_profiler_;
 
   ThreadList* thread_list_;
 
@@ -1482,6 +1519,16 @@ class Runtime {
   // A 0 for this will turn off madvising to MADV_WILLNEED
   size_t madvise_willneed_art_filesize_;
 
+  // Whether to decompress the blocks of compressed images on first touch.
+  bool lazy_image_decompression_;
+
+  // Whether to verify the classes of APKs loaded without a vdex in the background,
+  // like we do for secondary dex files.
+  bool background_verify_apks_;
+
+  // Number of threads verifying the classes of a class loader in the background.
+  size_t background_verification_threads_;
+
   // Whether the application should run in safe mode, that is, interpreter only.
   bool safe_mode_;
 
@@ -1582,6 +1629,7 @@ class Runtime {
 
   metrics::ArtMetrics metrics_;
   std::unique_ptr<metrics::MetricsReporter> metrics_reporter_;
+  bool metrics_reporting_enabled_;
 
   // Apex versions of boot classpath jars concatenated in a string. The format
   // is of the type:
@@ -1828,6 +1828,13 @@ std::string RuntimeImage::GetRuntimeImagePath(const std::string& dex_location) {
   return GetOatPath() + GetInstructionSetString(kRuntimeISA) + "/" + filename;
 }
 
+std::string RuntimeImage::GetRuntimeJitMethodsPath(const std::string& dex_location) {
+  std::string basename = android::base::Basename(dex_location);
+  std::string filename = ReplaceFileExtension(basename, "jit.prof");
+
+  return GetOatPath() + GetInstructionSetString(kRuntimeISA) + "/" + filename;
+}
+
 static bool EnsureDirectoryExists(const std::string& directory, std::string* error_msg) {
   if (!OS::DirectoryExists(directory.c_str())) {
     static constexpr mode_t kDirectoryMode = S_IRWXU | S_IRGRP | S_IXGRP| S_IROTH | S_IXOTH;
@@ -1911,4 +1918,43 @@ bool RuntimeImage::WriteImageToDisk(std::string* error_msg) {
   return true;
 }
 
+bool RuntimeImage::WriteJitMethodsToDisk(const std::string& dex_location,
+                                         ProfileCompilationInfo& methods,
+                                         std::string* error_msg) {
+  std::string oat_path = GetOatPath();
+  if (!oat_path.empty() && !EnsureDirectoryExists(oat_path, error_msg)) {
+    return false;
+  }
+  const std::string path = GetRuntimeJitMethodsPath(dex_location);
+  if (!EnsureDirectoryExists(android::base::Dirname(path), error_msg)) {
+    return false;
+  }
+
+  // Like for the image, write a temporary file and move it to `path`, so that a
+  // concurrently starting process never reads a partial file.
+  const std::string temp_path = path + "." + std::to_string(getpid()) + ".tmp";
+  std::unique_ptr<File> file(OS::CreateEmptyFileWriteOnly(temp_path.c_str()));
+  if (file == nullptr) {
+    *error_msg = "Could not open " + temp_path + " for writing";
+    return false;
+  }
+  if (!methods.Save(file->Fd())) {
+    *error_msg = "Could not write JIT methods to " + temp_path;
+    file->Erase(/*unlink=*/ true);
+    return false;
+  }
+  if (file->FlushCloseOrErase() != 0) {
+    *error_msg = "Could not flush " + temp_path + ": " + std::string(strerror(errno));
+    unlink(temp_path.c_str());
+    return false;
+  }
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    *error_msg =
+        "Failed to move JIT methods to " + path + ": " + std::string(strerror(errno));
+    unlink(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
 }  // namespace art
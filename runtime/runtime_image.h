@@ -21,6 +21,8 @@
 
 namespace art {
 
+class ProfileCompilationInfo;
+
 class RuntimeImage {
  public:
     // Writes an app image for the currently running process.
@@ -28,6 +30,15 @@ class RuntimeImage {
 
   // Gets the path where a runtime-generated app image is stored.
   static std::string GetRuntimeImagePath(const std::string& dex_location);
+
+  // Gets the path where the methods JIT-compiled for `dex_location` are persisted,
+  // see Jit::PersistCompiledMethods.
+  static std::string GetRuntimeJitMethodsPath(const std::string& dex_location);
+
+  // Writes `methods` to the path returned by GetRuntimeJitMethodsPath.
+  static bool WriteJitMethodsToDisk(const std::string& dex_location,
+                                    ProfileCompilationInfo& methods,
+                                    std::string* error_msg);
 };
 
 }  // namespace art
@@ -25,6 +25,7 @@
 #include "arch/instruction_set.h"
 #include "base/variant_map.h"
 #include "cmdline_types.h"  // TODO: don't need to include this file here
+#include "dex_cache_miss_profiler.h"
 #include "gc/collector_type.h"
 #include "gc/space/large_object_space.h"
 #include "hidden_api.h"
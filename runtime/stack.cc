@@ -44,6 +44,7 @@
 #include "obj_ptr-inl.h"
 #include "quick/quick_method_frame_info.h"
 #include "runtime.h"
+#include "stack_map_cache.h"
 #include "thread.h"
 #include "thread_list.h"
 
@@ -94,9 +95,15 @@ StackMap* StackVisitor::GetCurrentStackMap() const {
   DCHECK(!(*cur_quick_frame_)->IsNative());
   const OatQuickMethodHeader* header = GetCurrentOatQuickMethodHeader();
   if (cur_stack_map_.first != cur_quick_frame_pc_) {
-    uint32_t pc = header->NativeQuickPcOffset(cur_quick_frame_pc_);
-    cur_stack_map_ = std::make_pair(cur_quick_frame_pc_,
-                                    GetCurrentInlineInfo()->GetStackMapForNativePcOffset(pc));
+    // Use the stack map row found by an earlier stack walk, if any, to avoid the search.
+    StackMapCache::CachedStackMap cached_map;
+    CodeInfo* code_info = GetCurrentInlineInfo();
+    StackMap stack_map =
+        Runtime::Current()->GetStackMapCache()->Lookup(cur_quick_frame_pc_, &cached_map)
+            ? code_info->GetStackMapAt(cached_map.row)
+            : code_info->GetStackMapForNativePcOffset(
+                  header->NativeQuickPcOffset(cur_quick_frame_pc_));
+    cur_stack_map_ = std::make_pair(cur_quick_frame_pc_, stack_map);
   }
   return &cur_stack_map_.second;
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_map_cache.h"
+
+#include <algorithm>
+
+namespace art {
+
+void StackMapCache::Insert(uintptr_t pc,
+                           uint32_t row,
+                           uint32_t register_mask,
+                           BitMemoryRegion stack_mask) {
+  size_t stack_mask_size = stack_mask.size_in_bits();
+  if (stack_mask_size > kMaxStackMaskBits) {
+    return;
+  }
+  // Copy the mask in 32-bit chunks.
+  std::array<uint64_t, kStackMaskWords> words{};
+  for (size_t start = 0; start < stack_mask_size; start += BitSizeOf<uint32_t>()) {
+    size_t length = std::min(stack_mask_size - start, BitSizeOf<uint32_t>());
+    uint64_t bits = stack_mask.LoadBits<uint32_t>(start, length);
+    words[start / BitSizeOf<uint64_t>()] |= bits << (start % BitSizeOf<uint64_t>());
+  }
+
+  // Claim the entry by making its sequence odd. Do not wait for another writer.
+  Entry& entry = entries_[IndexOf(pc)];
+  uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1u) != 0u ||
+      !entry.sequence.compare_exchange_strong(sequence, sequence + 1u,
+                                              std::memory_order_relaxed)) {
+    return;
+  }
+  // Order the odd sequence before the writes of the entry, see Lookup().
+  std::atomic_thread_fence(std::memory_order_release);
+  entry.generation.store(generation_.load(std::memory_order_acquire), std::memory_order_relaxed);
+  entry.pc.store(pc, std::memory_order_relaxed);
+  entry.row.store(row, std::memory_order_relaxed);
+  entry.register_mask.store(register_mask, std::memory_order_relaxed);
+  entry.stack_mask_size.store(stack_mask_size, std::memory_order_relaxed);
+  for (size_t i = 0; i != kStackMaskWords; ++i) {
+    entry.stack_mask[i].store(words[i], std::memory_order_relaxed);
+  }
+  entry.sequence.store(sequence + 2u, std::memory_order_release);
+}
+
+}  // namespace art
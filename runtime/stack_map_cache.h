@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_STACK_MAP_CACHE_H_
+#define ART_RUNTIME_STACK_MAP_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include "base/bit_memory_region.h"
+#include "base/bit_utils.h"
+#include "base/macros.h"
+
+namespace art {
+
+// Process-wide cache of the stack maps found for the return PCs of compiled frames. Every
+// stack walk that visits GC roots decodes the CodeInfo of each compiled frame and searches it
+// for the stack map of the return PC, while the same return PCs show up in every GC. The cache
+// keeps the decoded stack map row, register mask and stack mask per PC, so that a root scan of
+// a deep stack mostly reads a few words per frame.
+//
+// The cache is a direct-mapped table with a bounded number of entries, and stack masks longer
+// than kMaxStackMaskBits are not cached. It is lock-free: each entry is guarded by a sequence
+// counter that is odd while the entry is written, and a reader discards an entry whose counter
+// changed while it was read. Writers never wait, a contended entry is simply not updated.
+//
+// Entries are only valid for the current generation. The generation is bumped whenever
+// compiled code may be freed (JIT code cache collection, unloading of an oat file), so that a
+// PC reused by new code never matches an entry recorded for the previous code.
+class StackMapCache {
+ public:
+  static constexpr size_t kNumEntries = 2048;
+  static constexpr size_t kMaxStackMaskBits = 128;
+  static constexpr size_t kStackMaskWords = kMaxStackMaskBits / BitSizeOf<uint64_t>();
+
+  struct CachedStackMap {
+    bool IsStackMaskBitSet(size_t index) const {
+      DCHECK_LT(index, stack_mask_size);
+      return ((stack_mask[index / BitSizeOf<uint64_t>()] >> (index % BitSizeOf<uint64_t>())) & 1u)
+          != 0u;
+    }
+
+    uint32_t row;
+    uint32_t register_mask;
+    uint32_t stack_mask_size;  // In bits.
+    std::array<uint64_t, kStackMaskWords> stack_mask;
+  };
+
+  StackMapCache() {}
+
+  // Returns true and fills `result` if the stack map of `pc` is cached.
+  ALWAYS_INLINE bool Lookup(uintptr_t pc, /*out*/ CachedStackMap* result) const;
+
+  // Records the stack map `row` found for `pc`, with its register mask and stack mask.
+  void Insert(uintptr_t pc, uint32_t row, uint32_t register_mask, BitMemoryRegion stack_mask);
+
+  // Drops all entries. Safe to call concurrently with Lookup() and Insert().
+  void Invalidate() {
+    generation_.fetch_add(1u, std::memory_order_release);
+  }
+
+ private:
+  struct Entry {
+    std::atomic<uint32_t> sequence{0u};
+    std::atomic<uint32_t> generation{0u};
+    std::atomic<uintptr_t> pc{0u};
+    std::atomic<uint32_t> row{0u};
+    std::atomic<uint32_t> register_mask{0u};
+    std::atomic<uint32_t> stack_mask_size{0u};
+    std::array<std::atomic<uint64_t>, kStackMaskWords> stack_mask{};
+  };
+
+  static constexpr size_t kNumEntriesBits = WhichPowerOf2(kNumEntries);
+
+  static size_t IndexOf(uintptr_t pc) {
+    // Fibonacci hashing, which spreads nearby return PCs over the table.
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(pc) * UINT64_C(0x9e3779b97f4a7c15)) >> (64u - kNumEntriesBits));
+  }
+
+  // Generation 0 marks the never written entries.
+  std::atomic<uint32_t> generation_{1u};
+  std::array<Entry, kNumEntries> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(StackMapCache);
+};
+
+inline bool StackMapCache::Lookup(uintptr_t pc, /*out*/ CachedStackMap* result) const {
+  const Entry& entry = entries_[IndexOf(pc)];
+  uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+  if ((sequence & 1u) != 0u ||
+      entry.pc.load(std::memory_order_relaxed) != pc ||
+      entry.generation.load(std::memory_order_relaxed) !=
+          generation_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  result->row = entry.row.load(std::memory_order_relaxed);
+  result->register_mask = entry.register_mask.load(std::memory_order_relaxed);
+  result->stack_mask_size = entry.stack_mask_size.load(std::memory_order_relaxed);
+  for (size_t i = 0; i != kStackMaskWords; ++i) {
+    result->stack_mask[i] = entry.stack_mask[i].load(std::memory_order_relaxed);
+  }
+  // Discard the entry if it was overwritten while we read it.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return entry.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_STACK_MAP_CACHE_H_
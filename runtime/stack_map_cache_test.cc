@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_map_cache.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace art {
+
+class StackMapCacheTest : public testing::Test {};
+
+TEST_F(StackMapCacheTest, InsertAndLookup) {
+  // The table is too big for the stack.
+  auto cache = std::make_unique<StackMapCache>();
+  // Bits 0, 2, 31 and 64 are set.
+  alignas(8) uint8_t data[16] = { 0x05, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00,
+                                  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  const uintptr_t pc = 0x7000123;
+  StackMapCache::CachedStackMap cached_map;
+  EXPECT_FALSE(cache->Lookup(pc, &cached_map));
+
+  cache->Insert(pc, /*row=*/ 7u, /*register_mask=*/ 0x30u, BitMemoryRegion(data, 0, 65));
+  ASSERT_TRUE(cache->Lookup(pc, &cached_map));
+  EXPECT_EQ(7u, cached_map.row);
+  EXPECT_EQ(0x30u, cached_map.register_mask);
+  EXPECT_EQ(65u, cached_map.stack_mask_size);
+  for (size_t i = 0; i != 65u; ++i) {
+    EXPECT_EQ(i == 0u || i == 2u || i == 31u || i == 64u, cached_map.IsStackMaskBitSet(i)) << i;
+  }
+  EXPECT_FALSE(cache->Lookup(pc + 4u, &cached_map));
+
+  cache->Invalidate();
+  EXPECT_FALSE(cache->Lookup(pc, &cached_map));
+  cache->Insert(pc, /*row=*/ 8u, /*register_mask=*/ 0u, BitMemoryRegion(data, 8, 3));
+  ASSERT_TRUE(cache->Lookup(pc, &cached_map));
+  EXPECT_EQ(8u, cached_map.row);
+  EXPECT_EQ(3u, cached_map.stack_mask_size);
+  EXPECT_FALSE(cached_map.IsStackMaskBitSet(0u));
+  EXPECT_FALSE(cached_map.IsStackMaskBitSet(2u));
+}
+
+TEST_F(StackMapCacheTest, LongStackMaskIsNotCached) {
+  auto cache = std::make_unique<StackMapCache>();
+  alignas(8) uint8_t data[32] = {};
+  const uintptr_t pc = 0x7000200;
+  cache->Insert(pc,
+                /*row=*/ 1u,
+                /*register_mask=*/ 0u,
+                BitMemoryRegion(data, 0, StackMapCache::kMaxStackMaskBits + 1u));
+  StackMapCache::CachedStackMap cached_map;
+  EXPECT_FALSE(cache->Lookup(pc, &cached_map));
+}
+
+}  // namespace art
@@ -23,6 +23,7 @@
 #include "gc/space/image_space.h"
 #include "gc/space/space-inl.h"
 #include "handle_scope-inl.h"
+#include "jit/jit.h"
 #include "linear_alloc-inl.h"
 #include "mirror/dex_cache.h"
 #include "mirror/object-inl.h"
@@ -64,6 +65,11 @@ void StartupCompletedTask::Run(Thread* self) {
       }
     }
 
+    // Remember what was compiled during startup for the next process.
+    if (runtime->GetJit() != nullptr) {
+      runtime->GetJit()->PersistCompiledMethods(self);
+    }
+
     ScopedObjectAccess soa(self);
     DeleteStartupDexCaches(self, /* called_by_gc= */ false);
   }
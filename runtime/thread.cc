@@ -106,6 +106,7 @@
 #include "scoped_disable_public_sdk_checker.h"
 #include "stack.h"
 #include "stack_map.h"
+#include "stack_map_cache.h"
 #include "thread-inl.h"
 #include "thread_list.h"
 #include "trace.h"
@@ -1566,6 +1567,7 @@ bool Thread::PassActiveSuspendBarriers(Thread* self) {
     AtomicClearFlag(ThreadFlag::kActiveSuspendBarrier);
   }
 
+  suspend_barrier_pass_time_ns_.store(NanoTime(), std::memory_order_relaxed);
   uint32_t barrier_count = 0;
   for (uint32_t i = 0; i < kMaxSuspendBarriers; i++) {
     AtomicInteger* pending_threads = pass_barriers[i];
@@ -1628,9 +1630,11 @@ void Thread::RunCheckpointFunction() {
   // Grab the suspend_count lock, get the next checkpoint and update all the checkpoint fields. If
   // there are no more checkpoints we will also clear the kCheckpointRequest flag.
   Closure* checkpoint;
+  uint64_t request_time;
   {
     MutexLock mu(this, *Locks::thread_suspend_count_lock_);
     checkpoint = tlsPtr_.checkpoint_function;
+    request_time = checkpoint_request_time_ns_;
     if (!checkpoint_overflow_.empty()) {
       // Overflow list not empty, copy the first one out and continue.
       tlsPtr_.checkpoint_function = checkpoint_overflow_.front();
@@ -1641,6 +1645,12 @@ void Thread::RunCheckpointFunction() {
       AtomicClearFlag(ThreadFlag::kCheckpointRequest);
     }
   }
+  // Only record the time it took a running thread to honor the request, not the time it took
+  // another thread to notice that this one is suspended.
+  if (Thread::Current() == this) {
+    Runtime::Current()->GetMetrics()->TimeToRunCheckpoint()->Add(
+        NsToUs(NanoTime() - request_time));
+  }
   // Outside the lock, run the checkpoint function.
   ScopedTrace trace("Run checkpoint function");
   CHECK(checkpoint != nullptr) << "Checkpoint flag set without pending checkpoint";
@@ -1671,6 +1681,7 @@ bool Thread::RequestCheckpoint(Closure* function) {
     // Succeeded setting checkpoint flag, now insert the actual checkpoint.
     if (tlsPtr_.checkpoint_function == nullptr) {
       tlsPtr_.checkpoint_function = function;
+      checkpoint_request_time_ns_ = NanoTime();
     } else {
       checkpoint_overflow_.push_back(function);
     }
@@ -4200,7 +4211,23 @@ class ReferenceMapVisitor : public StackVisitor {
       DCHECK(method_header->IsOptimized());
       StackReference<mirror::Object>* vreg_base =
           reinterpret_cast<StackReference<mirror::Object>*>(cur_quick_frame);
-      uintptr_t native_pc_offset = method_header->NativeQuickPcOffset(GetCurrentQuickFramePc());
+      uintptr_t quick_frame_pc = GetCurrentQuickFramePc();
+      StackMapCache* stack_map_cache = Runtime::Current()->GetStackMapCache();
+      if constexpr (!kPrecise) {
+        StackMapCache::CachedStackMap cached_map;
+        if (stack_map_cache->Lookup(quick_frame_pc, &cached_map)) {
+          // The masks were decoded by an earlier stack walk. The imprecise
+          // visitor does not look at the code info and stack map.
+          T vreg_info(m, CodeInfo(), StackMap(), visitor_);
+          VisitGcMasks(vreg_info,
+                       vreg_base,
+                       cached_map.stack_mask_size,
+                       [&](size_t i) { return cached_map.IsStackMaskBitSet(i); },
+                       cached_map.register_mask);
+          return;
+        }
+      }
+      uintptr_t native_pc_offset = method_header->NativeQuickPcOffset(quick_frame_pc);
       CodeInfo code_info = kPrecise
           ? CodeInfo(method_header)  // We will need dex register maps.
           : CodeInfo::DecodeGcMasksOnly(method_header);
@@ -4208,40 +4235,14 @@ class ReferenceMapVisitor : public StackVisitor {
       DCHECK(map.IsValid());
 
       T vreg_info(m, code_info, map, visitor_);
-
-      // Visit stack entries that hold pointers.
       BitMemoryRegion stack_mask = code_info.GetStackMaskOf(map);
-      for (size_t i = 0; i < stack_mask.size_in_bits(); ++i) {
-        if (stack_mask.LoadBit(i)) {
-          StackReference<mirror::Object>* ref_addr = vreg_base + i;
-          mirror::Object* ref = ref_addr->AsMirrorPtr();
-          if (ref != nullptr) {
-            mirror::Object* new_ref = ref;
-            vreg_info.VisitStack(&new_ref, i, this);
-            if (ref != new_ref) {
-              ref_addr->Assign(new_ref);
-            }
-          }
-        }
-      }
-      // Visit callee-save registers that hold pointers.
       uint32_t register_mask = code_info.GetRegisterMaskOf(map);
-      for (uint32_t i = 0; i < BitSizeOf<uint32_t>(); ++i) {
-        if (register_mask & (1 << i)) {
-          mirror::Object** ref_addr = reinterpret_cast<mirror::Object**>(GetGPRAddress(i));
-          if (kIsDebugBuild && ref_addr == nullptr) {
-            std::string thread_name;
-            GetThread()->GetThreadName(thread_name);
-            LOG(FATAL_WITHOUT_ABORT) << "On thread " << thread_name;
-            DescribeStack(GetThread());
-            LOG(FATAL) << "Found an unsaved callee-save register " << i << " (null GPRAddress) "
-                       << "set in register_mask=" << register_mask << " at " << DescribeLocation();
-          }
-          if (*ref_addr != nullptr) {
-            vreg_info.VisitRegister(ref_addr, i, this);
-          }
-        }
-      }
+      VisitGcMasks(vreg_info,
+                   vreg_base,
+                   stack_mask.size_in_bits(),
+                   [&](size_t i) { return stack_mask.LoadBit(i); },
+                   register_mask);
+      stack_map_cache->Insert(quick_frame_pc, map.Row(), register_mask, stack_mask);
     } else if (!m->IsRuntimeMethod() && m->IsProxyMethod()) {
       // If this is a proxy method, visit its reference arguments.
       DCHECK(!m->IsStatic());
@@ -4261,6 +4262,47 @@ class ReferenceMapVisitor : public StackVisitor {
     }
   }
 
+  // Visit the stack slots and callee-save registers that the masks mark as holding references.
+  template <typename T, typename StackMaskTest>
+  ALWAYS_INLINE
+  void VisitGcMasks(T& vreg_info,
+                    StackReference<mirror::Object>* vreg_base,
+                    size_t stack_mask_size,
+                    StackMaskTest&& is_stack_mask_bit_set,
+                    uint32_t register_mask) REQUIRES_SHARED(Locks::mutator_lock_) {
+    // Visit stack entries that hold pointers.
+    for (size_t i = 0; i < stack_mask_size; ++i) {
+      if (is_stack_mask_bit_set(i)) {
+        StackReference<mirror::Object>* ref_addr = vreg_base + i;
+        mirror::Object* ref = ref_addr->AsMirrorPtr();
+        if (ref != nullptr) {
+          mirror::Object* new_ref = ref;
+          vreg_info.VisitStack(&new_ref, i, this);
+          if (ref != new_ref) {
+            ref_addr->Assign(new_ref);
+          }
+        }
+      }
+    }
+    // Visit callee-save registers that hold pointers.
+    for (uint32_t i = 0; i < BitSizeOf<uint32_t>(); ++i) {
+      if (register_mask & (1 << i)) {
+        mirror::Object** ref_addr = reinterpret_cast<mirror::Object**>(GetGPRAddress(i));
+        if (kIsDebugBuild && ref_addr == nullptr) {
+          std::string thread_name;
+          GetThread()->GetThreadName(thread_name);
+          LOG(FATAL_WITHOUT_ABORT) << "On thread " << thread_name;
+          DescribeStack(GetThread());
+          LOG(FATAL) << "Found an unsaved callee-save register " << i << " (null GPRAddress) "
+                     << "set in register_mask=" << register_mask << " at " << DescribeLocation();
+        }
+        if (*ref_addr != nullptr) {
+          vreg_info.VisitRegister(ref_addr, i, this);
+        }
+      }
+    }
+  }
+
   void VisitQuickFrame() REQUIRES_SHARED(Locks::mutator_lock_) {
     if (kPrecise) {
       VisitQuickFramePrecise();
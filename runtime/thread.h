@@ -1125,6 +1125,17 @@ class Thread {
     core_platform_api_cookie_ = cookie;
   }
 
+  // Returns true for one in every `sampling_interval` calls on this thread, used to sample the
+  // dex cache lookups, see DexCacheMissProfiler.
+  bool SampleDexCacheLookup(uint32_t sampling_interval) {
+    if (dex_cache_lookup_countdown_ != 0u) {
+      --dex_cache_lookup_countdown_;
+      return false;
+    }
+    dex_cache_lookup_countdown_ = sampling_interval - 1u;
+    return true;
+  }
+
   // Returns true if the thread is allowed to load java classes.
   bool CanLoadClasses() const;
 
@@ -1238,6 +1249,12 @@ class Thread {
   void ClearSuspendBarrier(AtomicInteger* target)
       REQUIRES(Locks::thread_suspend_count_lock_);
 
+  // Returns the time at which this thread last passed a suspend barrier, i.e. the last time it
+  // honored a suspend all request that it received while running.
+  uint64_t GetSuspendBarrierPassTime() const {
+    return suspend_barrier_pass_time_ns_.load(std::memory_order_relaxed);
+  }
+
   bool ReadFlag(ThreadFlag flag) const {
     return GetStateAndFlags(std::memory_order_relaxed).IsFlagSet(flag);
   }
@@ -2146,6 +2163,14 @@ class Thread {
   // Pending extra checkpoints if checkpoint_function_ is already used.
   std::list<Closure*> checkpoint_overflow_ GUARDED_BY(Locks::thread_suspend_count_lock_);
 
+  // Time at which the thread last passed a suspend barrier, used to find the last thread to
+  // suspend for a slow SuspendAll.
+  std::atomic<uint64_t> suspend_barrier_pass_time_ns_{0};
+
+  // Time at which the oldest pending checkpoint was requested, used to record the time it
+  // takes the thread to run its checkpoints.
+  uint64_t checkpoint_request_time_ns_ GUARDED_BY(Locks::thread_suspend_count_lock_) = 0u;
+
   // Custom TLS field that can be used by plugins or the runtime. Should not be accessed directly by
   // compiled code or entrypoints.
   SafeMap<std::string, std::unique_ptr<TLSData>, std::less<>> custom_tls_
@@ -2165,6 +2190,9 @@ class Thread {
   // the caller is allowed to access all fields and methods in the Core Platform API.
   uint32_t core_platform_api_cookie_ = 0;
 
+  // Number of dex cache lookups to skip before the next sampled one.
+  uint32_t dex_cache_lookup_countdown_ = 0;
+
   friend class gc::collector::SemiSpace;  // For getting stack traces.
   friend class Runtime;  // For CreatePeer.
   friend class QuickExceptionHandler;  // For dumping the stack.
@@ -20,6 +20,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <tuple>
@@ -31,6 +32,7 @@
 #include "unwindstack/AndroidUnwinder.h"
 
 #include "art_field-inl.h"
+#include "art_method.h"
 #include "base/aborting.h"
 #include "base/histogram-inl.h"
 #include "base/mutex-inl.h"
@@ -38,6 +40,7 @@
 #include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "debugger.h"
+#include "dex/dex_file_types.h"
 #include "gc/collector/concurrent_copying.h"
 #include "gc/gc_pause_listener.h"
 #include "gc/heap.h"
@@ -145,6 +148,19 @@ void ThreadList::DumpForSigQuit(std::ostream& os) {
       suspend_all_historam_.CreateHistogram(&data);
       suspend_all_historam_.PrintConfidenceIntervals(os, 0.99, data);  // Dump time to suspend.
     }
+    for (const auto& [cause, histogram] : suspend_all_cause_histograms_) {
+      Histogram<uint64_t>::CumulativeData data;
+      histogram->CreateHistogram(&data);
+      histogram->PrintConfidenceIntervals(os, 0.99, data);
+    }
+  }
+  {
+    MutexLock mu(Thread::Current(), *Locks::thread_list_lock_);
+    for (const SlowSuspendRecord& record : slow_suspend_records_) {
+      os << "Slow suspend all for " << record.cause << ": " << PrettyDuration(record.suspend_time_ns)
+         << ", last thread to suspend: \"" << record.thread_name << "\" tid=" << record.tid
+         << " at " << record.method << " dex_pc=" << record.dex_pc << "\n";
+    }
   }
   bool dump_native_stack = Runtime::Current()->GetDumpNativeStackOnSigQuit();
   Dump(os, dump_native_stack);
@@ -544,7 +560,15 @@ size_t ThreadList::FlipThreadRoots(Closure* thread_flip_visitor,
 
   // Run the flip callback for the collector.
   Locks::mutator_lock_->ExclusiveLock(self);
-  suspend_all_historam_.AdjustAndAddValue(NanoTime() - suspend_start_time);
+  const uint64_t suspend_time = NanoTime() - suspend_start_time;
+  suspend_all_historam_.AdjustAndAddValue(suspend_time);
+  AddSuspendAllTime("thread flip", suspend_time);
+  Runtime::Current()->GetMetrics()->TimeToSuspendThreadFlip()->Add(NsToUs(suspend_time));
+  if (suspend_time > kLongThreadSuspendThreshold) {
+    LOG(WARNING) << "Suspending all threads for thread flip took: "
+                 << PrettyDuration(suspend_time)
+                 << RecordSlowSuspend(self, "thread flip", suspend_start_time, suspend_time);
+  }
   flip_callback->Run(self);
   // Releasing mutator-lock *before* setting up flip function in the threads
   // leaves a gap for another thread trying to suspend all threads. That thread
@@ -661,8 +685,11 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
     const uint64_t end_time = NanoTime();
     const uint64_t suspend_time = end_time - start_time;
     suspend_all_historam_.AdjustAndAddValue(suspend_time);
+    AddSuspendAllTime(cause, suspend_time);
+    Runtime::Current()->GetMetrics()->TimeToSuspendAll()->Add(NsToUs(suspend_time));
     if (suspend_time > kLongThreadSuspendThreshold) {
-      LOG(WARNING) << "Suspending all threads took: " << PrettyDuration(suspend_time);
+      LOG(WARNING) << "Suspending all threads took: " << PrettyDuration(suspend_time)
+                   << RecordSlowSuspend(self, cause, start_time, suspend_time);
     }
 
     if (kDebugLocking) {
@@ -679,6 +706,80 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
   }
 }
 
+void ThreadList::AddSuspendAllTime(const char* cause, uint64_t suspend_time) {
+  auto it = suspend_all_cause_histograms_.find(std::string_view(cause));
+  if (it == suspend_all_cause_histograms_.end()) {
+    if (suspend_all_cause_histograms_.size() >= kMaxSuspendAllCauses) {
+      cause = kOtherSuspendAllCause;
+      it = suspend_all_cause_histograms_.find(std::string_view(cause));
+    }
+    if (it == suspend_all_cause_histograms_.end()) {
+      std::string name = std::string("suspend all histogram for ") + cause;
+      auto histogram = std::make_unique<Histogram<uint64_t>>(name.c_str(), 16, 64);
+      it = suspend_all_cause_histograms_.emplace(cause, std::move(histogram)).first;
+    }
+  }
+  it->second->AdjustAndAddValue(suspend_time);
+}
+
+std::string ThreadList::RecordSlowSuspend(Thread* self,
+                                          const char* cause,
+                                          uint64_t start_time,
+                                          uint64_t suspend_time) {
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics->SlowSuspendAllCount()->AddOne();
+  metrics->SlowSuspendAllTime()->Add(NsToUs(suspend_time));
+  MutexLock mu(self, *Locks::thread_list_lock_);
+  // The last thread to honor the request is the one that passed its suspend barrier last. If no
+  // thread passed a barrier since the start of the request, all threads were already suspended
+  // and the time was spent waiting for the mutator lock.
+  Thread* last_thread = nullptr;
+  uint64_t last_pass_time = start_time;
+  for (Thread* thread : list_) {
+    uint64_t pass_time = thread->GetSuspendBarrierPassTime();
+    if (thread != self && pass_time >= last_pass_time) {
+      last_thread = thread;
+      last_pass_time = pass_time;
+    }
+  }
+  if (last_thread == nullptr) {
+    return "";
+  }
+
+  SlowSuspendRecord record;
+  record.cause = cause;
+  record.suspend_time_ns = suspend_time;
+  record.tid = last_thread->GetTid();
+  last_thread->GetThreadName(record.thread_name);
+  uint32_t dex_pc = dex::kDexNoIndex;
+  ArtMethod* method = last_thread->GetCurrentMethod(&dex_pc,
+                                                    /* check_suspended= */ true,
+                                                    /* abort_on_error= */ false);
+  record.method = (method != nullptr) ? method->PrettyMethod() : "<unknown>";
+  record.dex_pc = dex_pc;
+  std::string description = StringPrintf(", last thread to suspend: \"%s\" tid=%d at %s dex_pc=%u",
+                                         record.thread_name.c_str(),
+                                         record.tid,
+                                         record.method.c_str(),
+                                         record.dex_pc);
+
+  // Keep the slowest requests only.
+  if (slow_suspend_records_.size() < kMaxSlowSuspendRecords) {
+    slow_suspend_records_.push_back(std::move(record));
+  } else {
+    auto fastest = std::min_element(
+        slow_suspend_records_.begin(),
+        slow_suspend_records_.end(),
+        [](const SlowSuspendRecord& lhs, const SlowSuspendRecord& rhs) {
+          return lhs.suspend_time_ns < rhs.suspend_time_ns;
+        });
+    if (fastest->suspend_time_ns < suspend_time) {
+      *fastest = std::move(record);
+    }
+  }
+  return description;
+}
+
 // Ensures all threads running Java suspend and that those not running Java don't start.
 void ThreadList::SuspendAllInternal(Thread* self,
                                     Thread* ignore1,
@@ -966,6 +1067,8 @@ Thread* ThreadList::SuspendThreadByPeer(jobject peer,
         // done.
         if (thread->IsSuspended()) {
           VLOG(threads) << "SuspendThreadByPeer thread suspended: " << *thread;
+          Runtime::Current()->GetMetrics()->TimeToSuspendThread()->Add(
+              NsToUs(NanoTime() - start_time));
           if (ATraceEnabled()) {
             std::string name;
             thread->GetThreadName(name);
@@ -1088,6 +1191,8 @@ Thread* ThreadList::SuspendThreadByThreadId(uint32_t thread_id,
                                       name.c_str(), thread_id).c_str());
           }
           VLOG(threads) << "SuspendThreadByThreadId thread suspended: " << *thread;
+          Runtime::Current()->GetMetrics()->TimeToSuspendThread()->Add(
+              NsToUs(NanoTime() - start_time));
           return thread;
         }
         const uint64_t total_delay = NanoTime() - start_time;
@@ -27,6 +27,9 @@
 
 #include <bitset>
 #include <list>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace art {
@@ -208,6 +211,37 @@ class ThreadList {
   void AssertThreadsAreSuspended(Thread* self, Thread* ignore1, Thread* ignore2 = nullptr)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
+  // Record the last thread to suspend for a slow suspend all request that started at
+  // `start_time` and took `suspend_time` nanoseconds, and return a description of it.
+  std::string RecordSlowSuspend(Thread* self,
+                                const char* cause,
+                                uint64_t start_time,
+                                uint64_t suspend_time)
+      REQUIRES(Locks::mutator_lock_, !Locks::thread_list_lock_);
+
+  // Add `suspend_time` to the time to suspend histogram of `cause`.
+  void AddSuspendAllTime(const char* cause, uint64_t suspend_time)
+      REQUIRES(Locks::mutator_lock_);
+
+  // A slow suspend all request and the last thread to honor it.
+  struct SlowSuspendRecord {
+    std::string cause;
+    uint64_t suspend_time_ns;
+    pid_t tid;
+    std::string thread_name;
+    // Method and dex pc the thread was suspended at.
+    std::string method;
+    uint32_t dex_pc;
+  };
+
+  // Maximum number of slow suspend records kept, only the slowest requests are kept.
+  static constexpr size_t kMaxSlowSuspendRecords = 8;
+
+  // Maximum number of causes with their own time to suspend histogram, later causes share the
+  // histogram of kOtherSuspendAllCause.
+  static constexpr size_t kMaxSuspendAllCauses = 32;
+  static constexpr const char* kOtherSuspendAllCause = "other";
+
   std::bitset<kMaxThreadId> allocated_ids_ GUARDED_BY(Locks::allocated_thread_ids_lock_);
 
   // The actual list of all threads.
@@ -223,6 +257,14 @@ class ThreadList {
   // by mutator lock ensures no thread can read when another thread is modifying it.
   Histogram<uint64_t> suspend_all_historam_ GUARDED_BY(Locks::mutator_lock_);
 
+  // Thread suspend time histograms by cause of the suspend all request, guarded like
+  // suspend_all_historam_.
+  std::map<std::string, std::unique_ptr<Histogram<uint64_t>>, std::less<>>
+      suspend_all_cause_histograms_ GUARDED_BY(Locks::mutator_lock_);
+
+  // The slowest suspend all requests, see RecordSlowSuspend().
+  std::vector<SlowSuspendRecord> slow_suspend_records_ GUARDED_BY(Locks::thread_list_lock_);
+
   // Whether or not the current thread suspension is long.
   bool long_suspend_;
 
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_list.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "barrier.h"
+#include "base/metrics/metrics_test.h"
+#include "base/time_utils.h"
+#include "common_runtime_test.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-inl.h"
+#include "thread_pool.h"
+
+namespace art {
+
+using metrics::test::CounterValue;
+using metrics::test::GetBuckets;
+
+template <typename Histogram>
+static uint64_t SampleCount(const Histogram& histogram) {
+  std::vector<uint32_t> buckets = GetBuckets(histogram);
+  return std::accumulate(buckets.begin(), buckets.end(), uint64_t{0});
+}
+
+class ThreadListTest : public CommonRuntimeTest {
+ protected:
+  ThreadListTest() {
+    use_boot_image_ = true;  // Make the Runtime creation cheaper.
+  }
+};
+
+// Keeps a worker thread runnable, checking for suspend and checkpoint requests until stopped.
+// When asked to, it stalls once without checking for requests.
+class SpinTask : public Task {
+ public:
+  SpinTask(std::atomic<Thread*>* worker,
+           std::atomic<bool>* stop,
+           std::atomic<bool>* stall,
+           std::atomic<bool>* stalling)
+      : worker_(worker), stop_(stop), stall_(stall), stalling_(stalling) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    worker_->store(self);
+    while (!stop_->load()) {
+      if (stall_->exchange(false)) {
+        stalling_->store(true);
+        usleep(MsToUs(20));
+      }
+      self->AllowThreadSuspension();
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  std::atomic<Thread*>* const worker_;
+  std::atomic<bool>* const stop_;
+  std::atomic<bool>* const stall_;
+  std::atomic<bool>* const stalling_;
+};
+
+class CheckpointClosure : public Closure {
+ public:
+  CheckpointClosure(Thread* worker, Barrier* barrier) : worker_(worker), barrier_(barrier) {}
+
+  void Run(Thread* thread) override {
+    if (thread == worker_) {
+      run_by_worker_.store(Thread::Current() == worker_);
+    }
+    barrier_->Pass(Thread::Current());
+  }
+
+  bool RunByWorker() const {
+    return run_by_worker_.load();
+  }
+
+ private:
+  Thread* const worker_;
+  Barrier* const barrier_;
+  std::atomic<bool> run_by_worker_{false};
+};
+
+TEST_F(ThreadListTest, SuspendAllCauseHistogram) {
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  const uint64_t suspend_all_count = SampleCount(*metrics->TimeToSuspendAll());
+  {
+    ScopedSuspendAll ssa("ThreadListTest cause");
+  }
+  EXPECT_GT(SampleCount(*metrics->TimeToSuspendAll()), suspend_all_count);
+
+  std::ostringstream os;
+  Runtime::Current()->GetThreadList()->DumpForSigQuit(os);
+  EXPECT_NE(os.str().find("suspend all histogram for ThreadListTest cause"), std::string::npos);
+}
+
+TEST_F(ThreadListTest, TimeToRunCheckpoint) {
+  Thread* self = Thread::Current();
+  std::atomic<Thread*> worker(nullptr);
+  std::atomic<bool> stop(false);
+  std::atomic<bool> stall(false);
+  std::atomic<bool> stalling(false);
+  ThreadPool thread_pool("ThreadListTest thread pool", 1);
+  thread_pool.AddTask(self, new SpinTask(&worker, &stop, &stall, &stalling));
+  thread_pool.StartWorkers(self);
+  while (worker.load() == nullptr) {
+    usleep(1000);
+  }
+
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  const uint64_t checkpoint_count = SampleCount(*metrics->TimeToRunCheckpoint());
+  Barrier barrier(0);
+  CheckpointClosure closure(worker.load(), &barrier);
+  size_t count = Runtime::Current()->GetThreadList()->RunCheckpoint(&closure);
+  {
+    ScopedThreadStateChange tsc(self, ThreadState::kWaitingForCheckPointsToRun);
+    barrier.Increment(self, count);
+  }
+  // The worker stays runnable, so it runs the checkpoint itself and records the time it took.
+  EXPECT_TRUE(closure.RunByWorker());
+  EXPECT_GT(SampleCount(*metrics->TimeToRunCheckpoint()), checkpoint_count);
+
+  stop.store(true);
+  thread_pool.Wait(self, /*do_work=*/ false, /*may_hold_locks=*/ false);
+}
+
+TEST_F(ThreadListTest, SlowSuspendAll) {
+  Thread* self = Thread::Current();
+  std::atomic<Thread*> worker(nullptr);
+  std::atomic<bool> stop(false);
+  std::atomic<bool> stall(false);
+  std::atomic<bool> stalling(false);
+  ThreadPool thread_pool("ThreadListTest thread pool", 1);
+  thread_pool.AddTask(self, new SpinTask(&worker, &stop, &stall, &stalling));
+  thread_pool.StartWorkers(self);
+  while (worker.load() == nullptr) {
+    usleep(1000);
+  }
+
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  const uint64_t slow_suspend_count = CounterValue(*metrics->SlowSuspendAllCount());
+  const uint64_t slow_suspend_time = CounterValue(*metrics->SlowSuspendAllTime());
+  stall.store(true);
+  while (!stalling.load()) {
+    usleep(100);
+  }
+  {
+    // The worker stalls for longer than the slow suspend threshold before it suspends.
+    ScopedSuspendAll ssa("ThreadListTest slow");
+  }
+  EXPECT_GT(CounterValue(*metrics->SlowSuspendAllCount()), slow_suspend_count);
+  EXPECT_GT(CounterValue(*metrics->SlowSuspendAllTime()), slow_suspend_time);
+
+  std::ostringstream os;
+  Runtime::Current()->GetThreadList()->DumpForSigQuit(os);
+  std::string dump = os.str();
+  size_t record = dump.find("Slow suspend all for ThreadListTest slow: ");
+  ASSERT_NE(record, std::string::npos);
+  std::string line = dump.substr(record, dump.find('\n', record) - record);
+  EXPECT_NE(line.find(" tid=" + std::to_string(worker.load()->GetTid()) + " "), std::string::npos)
+      << line;
+
+  stop.store(true);
+  thread_pool.Wait(self, /*do_work=*/ false, /*may_hold_locks=*/ false);
+}
+
+}  // namespace art
@@ -23,6 +23,9 @@
 
 #include <pthread.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
 
@@ -46,10 +49,16 @@ static constexpr bool kUseCustomThreadPoolStack = false;
 static constexpr bool kUseCustomThreadPoolStack = true;
 #endif
 
-ThreadPoolWorker::ThreadPoolWorker(ThreadPool* thread_pool, const std::string& name,
-                                   size_t stack_size)
+// The worker running on the current thread, set for the duration of ThreadPoolWorker::Run().
+static thread_local ThreadPoolWorker* current_worker = nullptr;
+
+ThreadPoolWorker::ThreadPoolWorker(ThreadPool* thread_pool,
+                                   const std::string& name,
+                                   size_t stack_size,
+                                   size_t index)
     : thread_pool_(thread_pool),
-      name_(name) {
+      name_(name),
+      index_(index) {
   std::string error_msg;
   // On Bionic, we know pthreads will give us a big-enough stack with
   // a guard page, so don't do anything special on Bionic libc.
@@ -106,14 +115,20 @@ int ThreadPoolWorker::GetPthreadPriority() {
 #endif
 }
 
+ThreadPoolWorker* ThreadPoolWorker::Current() {
+  return current_worker;
+}
+
 void ThreadPoolWorker::Run() {
   Thread* self = Thread::Current();
   Task* task = nullptr;
+  current_worker = this;
   thread_pool_->creation_barier_.Pass(self);
   while ((task = thread_pool_->GetTask(self)) != nullptr) {
     task->Run(self);
     task->Finalize();
   }
+  current_worker = nullptr;
 }
 
 void* ThreadPoolWorker::Callback(void* arg) {
@@ -148,7 +163,11 @@ void* ThreadPoolWorker::Callback(void* arg) {
 
 void ThreadPool::AddTask(Thread* self, Task* task) {
   MutexLock mu(self, task_queue_lock_);
-  tasks_.push_back(task);
+  EnqueueTaskLocked(task);
+  NotifyTaskAddedLocked(self);
+}
+
+void ThreadPool::NotifyTaskAddedLocked(Thread* self) {
   // If we have any waiters, signal one.
   if (started_ && waiting_count_ != 0) {
     task_queue_condition_.Signal(self);
@@ -163,7 +182,7 @@ void ThreadPool::RemoveAllTasks(Thread* self) {
     task->Finalize();
   }
   MutexLock mu(self, task_queue_lock_);
-  tasks_.clear();
+  ClearQueuedTasksLocked();
 }
 
 ThreadPool::ThreadPool(const char* name,
@@ -198,7 +217,7 @@ void ThreadPool::CreateThreads() {
       const std::string worker_name = StringPrintf("%s worker thread %zu", name_.c_str(),
                                                    GetThreadCount());
       threads_.push_back(
-          new ThreadPoolWorker(this, worker_name, worker_stack_size_));
+          new ThreadPoolWorker(this, worker_name, worker_stack_size_, GetThreadCount()));
     }
   }
 }
@@ -297,13 +316,18 @@ Task* ThreadPool::TryGetTask(Thread* self) {
 
 Task* ThreadPool::TryGetTaskLocked() {
   if (HasOutstandingTasks()) {
-    Task* task = tasks_.front();
-    tasks_.pop_front();
-    return task;
+    return DequeueTaskLocked();
   }
   return nullptr;
 }
 
+Task* ThreadPool::DequeueTaskLocked() {
+  DCHECK(!tasks_.empty());
+  Task* task = tasks_.front();
+  tasks_.pop_front();
+  return task;
+}
+
 void ThreadPool::Wait(Thread* self, bool do_work, bool may_hold_locks) {
   if (do_work) {
     CHECK(!create_peers_);
@@ -326,7 +350,7 @@ void ThreadPool::Wait(Thread* self, bool do_work, bool may_hold_locks) {
 
 size_t ThreadPool::GetTaskCount(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
-  return tasks_.size();
+  return QueuedTaskCountLocked();
 }
 
 void ThreadPool::SetPthreadPriority(int priority) {
@@ -345,4 +369,339 @@ void ThreadPool::CheckPthreadPriority(int priority) {
 #endif
 }
 
+bool WorkStealingDeque::Push(Task* task) {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_acquire);
+  if (bottom - top >= static_cast<int64_t>(kCapacity)) {
+    return false;
+  }
+  buffer_[bottom & (kCapacity - 1)].store(task, std::memory_order_relaxed);
+  // Publish the task before making it visible to thieves.
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(bottom + 1, std::memory_order_relaxed);
+  return true;
+}
+
+Task* WorkStealingDeque::Pop() {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(bottom, std::memory_order_relaxed);
+  // Order the update of `bottom_` against the load of `top_`, thieves do the opposite.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    // The deque was empty.
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  Task* task = buffer_[bottom & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    // Last task, race against thieves for it.
+    if (!top_.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+Task* WorkStealingDeque::Steal() {
+  int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return nullptr;
+  }
+  Task* task = buffer_[top & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (!top_.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return task;
+}
+
+size_t WorkStealingDeque::Size() const {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0u;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(const char* name,
+                                               size_t num_threads,
+                                               bool create_peers,
+                                               size_t worker_stack_size)
+    : ThreadPool(name, /*num_threads=*/ 0u, create_peers, worker_stack_size),
+      num_queues_(num_threads),
+      queues_(new WorkerQueues[num_threads]),
+      num_queued_(0u),
+      num_sleeping_(0u),
+      accepting_tasks_(false),
+      num_active_workers_(num_threads),
+      next_inbox_(0u) {
+  // The base class didn't create any worker, as they would have started looking for tasks
+  // before the queues are ready.
+  {
+    MutexLock mu(Thread::Current(), task_queue_lock_);
+    max_active_workers_ = num_threads;
+  }
+  CreateThreads();
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  // The base class destructor cannot reach the queues of this class, so we need to stop the
+  // workers and finalize pending tasks here.
+  DeleteThreads();
+  RemoveAllTasks(Thread::Current());
+}
+
+size_t WorkStealingThreadPool::GetWorkerIndex(Thread* self) const {
+  ThreadPoolWorker* worker = ThreadPoolWorker::Current();
+  if (worker == nullptr || worker->GetThreadPool() != this) {
+    return kNotAWorker;
+  }
+  DCHECK_EQ(worker->GetThread(), self);
+  DCHECK_LT(worker->GetIndex(), num_queues_);
+  return worker->GetIndex();
+}
+
+void WorkStealingThreadPool::AddTask(Thread* self, Task* task) {
+  if (UNLIKELY(num_queues_ == 0u)) {
+    ThreadPool::AddTask(self, task);
+    return;
+  }
+  size_t index = GetWorkerIndex(self);
+  if (index != kNotAWorker) {
+    PushToDeque(self, index, task);
+  } else {
+    size_t num_inboxes =
+        std::max<size_t>(std::min(num_active_workers_.load(std::memory_order_relaxed),
+                                  num_queues_),
+                         1u);
+    PushToInbox(self, next_inbox_.fetch_add(1u, std::memory_order_relaxed) % num_inboxes, task);
+  }
+}
+
+void WorkStealingThreadPool::AddTask(Thread* self, Task* task, size_t worker_hint) {
+  if (UNLIKELY(num_queues_ == 0u)) {
+    ThreadPool::AddTask(self, task);
+    return;
+  }
+  size_t target = worker_hint % num_queues_;
+  if (GetWorkerIndex(self) == target) {
+    PushToDeque(self, target, task);
+  } else {
+    PushToInbox(self, target, task);
+  }
+}
+
+void WorkStealingThreadPool::PushToDeque(Thread* self, size_t index, Task* task) {
+  if (UNLIKELY(!queues_[index].deque.Push(task))) {
+    // The deque is full, fall back to the shared queue.
+    MutexLock mu(self, task_queue_lock_);
+    EnqueueTaskLocked(task);
+    NotifyTaskAddedLocked(self);
+    return;
+  }
+  NotifyTaskQueued(self);
+}
+
+void WorkStealingThreadPool::PushToInbox(Thread* self, size_t index, Task* task) {
+  std::atomic<InboxNode*>& inbox = queues_[index].inbox;
+  InboxNode* node = new InboxNode{task, inbox.load(std::memory_order_relaxed)};
+  while (!inbox.compare_exchange_weak(
+             node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  NotifyTaskQueued(self);
+}
+
+void WorkStealingThreadPool::NotifyTaskQueued(Thread* self) {
+  // Pairs with the check of a worker about to sleep in GetTask(): either the worker sees the
+  // new task, or we see the worker and wake it up.
+  num_queued_.fetch_add(1u, std::memory_order_seq_cst);
+  if (num_sleeping_.load(std::memory_order_seq_cst) != 0u) {
+    MutexLock mu(self, task_queue_lock_);
+    if (num_active_workers_.load(std::memory_order_relaxed) < num_queues_) {
+      // A single signal could be consumed by an inactive worker going back to sleep.
+      if (started_) {
+        task_queue_condition_.Broadcast(self);
+      }
+    } else {
+      NotifyTaskAddedLocked(self);
+    }
+  }
+}
+
+Task* WorkStealingThreadPool::TakeInbox(InboxNode* head, std::vector<Task*>* rest) {
+  if (head == nullptr) {
+    return nullptr;
+  }
+  // The inbox is a stack, so the oldest task is the last one.
+  rest->clear();
+  while (head != nullptr) {
+    rest->push_back(head->task);
+    InboxNode* next = head->next;
+    delete head;
+    head = next;
+  }
+  Task* task = rest->back();
+  rest->pop_back();
+  std::reverse(rest->begin(), rest->end());
+  return task;
+}
+
+Task* WorkStealingThreadPool::FindTask(Thread* self, size_t index) {
+  WorkerQueues& own = queues_[index];
+  Task* task = own.deque.Pop();
+  if (task == nullptr && own.inbox.load(std::memory_order_relaxed) != nullptr) {
+    std::vector<Task*> rest;
+    task = TakeInbox(own.inbox.exchange(nullptr, std::memory_order_acquire), &rest);
+    for (Task* other : rest) {
+      if (UNLIKELY(!own.deque.Push(other))) {
+        MutexLock mu(self, task_queue_lock_);
+        EnqueueTaskLocked(other);
+        num_queued_.fetch_sub(1u, std::memory_order_relaxed);
+      }
+    }
+  }
+  if (task == nullptr) {
+    return StealTask(self, index);
+  }
+  num_queued_.fetch_sub(1u, std::memory_order_relaxed);
+  return task;
+}
+
+Task* WorkStealingThreadPool::StealFromOthers(size_t thief,
+                                              size_t start,
+                                              std::vector<Task*>* rest) {
+  rest->clear();
+  for (size_t i = 0; i != num_queues_; ++i) {
+    size_t victim = (start + i) % num_queues_;
+    if (victim == thief) {
+      continue;
+    }
+    WorkerQueues& queues = queues_[victim];
+    Task* task = queues.deque.Steal();
+    if (task == nullptr && queues.inbox.load(std::memory_order_relaxed) != nullptr) {
+      task = TakeInbox(queues.inbox.exchange(nullptr, std::memory_order_acquire), rest);
+    }
+    if (task != nullptr) {
+      num_queued_.fetch_sub(1u, std::memory_order_relaxed);
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+Task* WorkStealingThreadPool::StealTask(Thread* self, size_t thief) {
+  DCHECK_LT(thief, num_queues_);
+  // Workers start with their neighbour.
+  std::vector<Task*> rest;
+  Task* task = StealFromOthers(thief, thief + 1u, &rest);
+  for (Task* other : rest) {
+    if (UNLIKELY(!queues_[thief].deque.Push(other))) {
+      MutexLock mu(self, task_queue_lock_);
+      EnqueueTaskLocked(other);
+      num_queued_.fetch_sub(1u, std::memory_order_relaxed);
+    }
+  }
+  return task;
+}
+
+Task* WorkStealingThreadPool::StealTaskLocked() {
+  // Other threads rotate to spread the load.
+  std::vector<Task*> rest;
+  Task* task =
+      StealFromOthers(kNotAWorker, next_inbox_.load(std::memory_order_relaxed), &rest);
+  for (Task* other : rest) {
+    EnqueueTaskLocked(other);
+    num_queued_.fetch_sub(1u, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+Task* WorkStealingThreadPool::GetTask(Thread* self) {
+  const size_t index = GetWorkerIndex(self);
+  DCHECK_LT(index, num_queues_);
+  while (true) {
+    if (accepting_tasks_.load(std::memory_order_acquire) &&
+        index < num_active_workers_.load(std::memory_order_relaxed)) {
+      Task* task = FindTask(self, index);
+      if (task != nullptr) {
+        if (LIKELY(accepting_tasks_.load(std::memory_order_acquire))) {
+          return task;
+        }
+        // The pool was stopped meanwhile, put the task back.
+        PushToDeque(self, index, task);
+      }
+    }
+
+    MutexLock mu(self, task_queue_lock_);
+    if (IsShuttingDown()) {
+      // Return null to tell the worker thread to stop looping.
+      return nullptr;
+    }
+    const bool active = started_ && index < max_active_workers_;
+    if (active && !tasks_.empty()) {
+      return ThreadPool::DequeueTaskLocked();
+    }
+    ++waiting_count_;
+    num_sleeping_.fetch_add(1u, std::memory_order_seq_cst);
+    if (!active || num_queued_.load(std::memory_order_seq_cst) == 0u) {
+      if (waiting_count_ == GetThreadCount() && !HasOutstandingTasks()) {
+        // We may be done, lets broadcast to the completion condition.
+        completion_condition_.Broadcast(self);
+      }
+      const uint64_t wait_start = kMeasureWaitTime ? NanoTime() : 0;
+      task_queue_condition_.Wait(self);
+      if (kMeasureWaitTime) {
+        const uint64_t wait_end = NanoTime();
+        total_wait_time_ += wait_end - std::max(wait_start, start_time_);
+      }
+    }
+    num_sleeping_.fetch_sub(1u, std::memory_order_relaxed);
+    --waiting_count_;
+  }
+}
+
+Task* WorkStealingThreadPool::DequeueTaskLocked() {
+  if (!tasks_.empty()) {
+    return ThreadPool::DequeueTaskLocked();
+  }
+  // May return null if other threads won all the races for the queued tasks.
+  return StealTaskLocked();
+}
+
+size_t WorkStealingThreadPool::QueuedTaskCountLocked() const {
+  return tasks_.size() + num_queued_.load(std::memory_order_seq_cst);
+}
+
+void WorkStealingThreadPool::ClearQueuedTasksLocked() {
+  ThreadPool::ClearQueuedTasksLocked();
+  std::vector<Task*> rest;
+  for (size_t i = 0; i != num_queues_; ++i) {
+    while (queues_[i].deque.Steal() != nullptr) {
+      num_queued_.fetch_sub(1u, std::memory_order_relaxed);
+    }
+    if (TakeInbox(queues_[i].inbox.exchange(nullptr, std::memory_order_acquire), &rest) !=
+        nullptr) {
+      num_queued_.fetch_sub(1u + rest.size(), std::memory_order_relaxed);
+    }
+  }
+}
+
+void WorkStealingThreadPool::StartWorkers(Thread* self) {
+  accepting_tasks_.store(true, std::memory_order_release);
+  ThreadPool::StartWorkers(self);
+}
+
+void WorkStealingThreadPool::StopWorkers(Thread* self) {
+  ThreadPool::StopWorkers(self);
+  accepting_tasks_.store(false, std::memory_order_seq_cst);
+}
+
+void WorkStealingThreadPool::SetMaxActiveWorkers(size_t max_workers) {
+  ThreadPool::SetMaxActiveWorkers(max_workers);
+  num_active_workers_.store(max_workers, std::memory_order_relaxed);
+}
+
 }  // namespace art
@@ -17,11 +17,14 @@
 #ifndef ART_RUNTIME_THREAD_POOL_H_
 #define ART_RUNTIME_THREAD_POOL_H_
 
+#include <atomic>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "barrier.h"
+#include "base/bit_utils.h"
 #include "base/mem_map.h"
 #include "base/mutex.h"
 
@@ -91,13 +94,25 @@ class ThreadPoolWorker {
 
   Thread* GetThread() const { return thread_; }
 
+  ThreadPool* GetThreadPool() const { return thread_pool_; }
+
+  // Index of this worker among the workers of its pool.
+  size_t GetIndex() const { return index_; }
+
+  // Returns the worker running on the current thread, or null if it isn't a thread pool worker.
+  static ThreadPoolWorker* Current();
+
  protected:
-  ThreadPoolWorker(ThreadPool* thread_pool, const std::string& name, size_t stack_size);
+  ThreadPoolWorker(ThreadPool* thread_pool,
+                   const std::string& name,
+                   size_t stack_size,
+                   size_t index);
   static void* Callback(void* arg) REQUIRES(!Locks::mutator_lock_);
   virtual void Run();
 
   ThreadPool* const thread_pool_;
   const std::string name_;
+  const size_t index_;
   MemMap stack_;
   pthread_t pthread_;
   Thread* thread_;
@@ -118,17 +133,17 @@ class ThreadPool {
   const std::vector<ThreadPoolWorker*>& GetWorkers();
 
   // Broadcast to the workers and tell them to empty out the work queue.
-  void StartWorkers(Thread* self) REQUIRES(!task_queue_lock_);
+  virtual void StartWorkers(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Do not allow workers to grab any new tasks.
-  void StopWorkers(Thread* self) REQUIRES(!task_queue_lock_);
+  virtual void StopWorkers(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Returns if the thread pool has started.
   bool HasStarted(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Add a new task, the first available started worker will process it. Does not delete the task
   // after running it, it is the caller's responsibility.
-  void AddTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
+  virtual void AddTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
 
   // Remove all tasks in the queue.
   void RemoveAllTasks(Thread* self) REQUIRES(!task_queue_lock_);
@@ -164,7 +179,7 @@ class ThreadPool {
 
   // Provides a way to bound the maximum number of worker threads, threads must be less the the
   // thread count of the thread pool.
-  void SetMaxActiveWorkers(size_t threads) REQUIRES(!task_queue_lock_);
+  virtual void SetMaxActiveWorkers(size_t threads) REQUIRES(!task_queue_lock_);
 
   // Set the "nice" priority for threads in the pool.
   void SetPthreadPriority(int priority);
@@ -184,13 +199,29 @@ class ThreadPool {
   Task* TryGetTask(Thread* self) REQUIRES(!task_queue_lock_);
   Task* TryGetTaskLocked() REQUIRES(task_queue_lock_);
 
+  // Wake up a waiting worker, if any, after a task has been queued.
+  void NotifyTaskAddedLocked(Thread* self) REQUIRES(task_queue_lock_);
+
+  // Queue management. Subclasses can override these to implement a different scheduling
+  // policy than the default FIFO order.
+  virtual void EnqueueTaskLocked(Task* task) REQUIRES(task_queue_lock_) {
+    tasks_.push_back(task);
+  }
+  virtual Task* DequeueTaskLocked() REQUIRES(task_queue_lock_);
+  virtual size_t QueuedTaskCountLocked() const REQUIRES(task_queue_lock_) {
+    return tasks_.size();
+  }
+  virtual void ClearQueuedTasksLocked() REQUIRES(task_queue_lock_) {
+    tasks_.clear();
+  }
+
   // Are we shutting down?
   bool IsShuttingDown() const REQUIRES(task_queue_lock_) {
     return shutting_down_;
   }
 
   bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) {
-    return started_ && !tasks_.empty();
+    return started_ && QueuedTaskCountLocked() != 0;
   }
 
   const std::string name_;
@@ -213,10 +244,121 @@ class ThreadPool {
 
  private:
   friend class ThreadPoolWorker;
-  friend class WorkStealingWorker;
   DISALLOW_COPY_AND_ASSIGN(ThreadPool);
 };
 
+// A bounded Chase-Lev deque of tasks. Only the owning worker pushes and pops at the bottom,
+// any other thread may steal from the top. None of the operations block.
+class WorkStealingDeque {
+ public:
+  static constexpr size_t kCapacity = 256;
+
+  WorkStealingDeque() : top_(0), bottom_(0) {}
+
+  // Owner only. Returns false if the deque is full.
+  bool Push(Task* task);
+  // Owner only. Returns the most recently pushed task, or null if the deque is empty.
+  Task* Pop();
+  // Returns the oldest task, or null if the deque is empty or another thread won the race.
+  Task* Steal();
+
+  size_t Size() const;
+
+ private:
+  static_assert(IsPowerOfTwo(kCapacity));
+
+  std::atomic<int64_t> top_;
+  std::atomic<int64_t> bottom_;
+  std::atomic<Task*> buffer_[kCapacity];
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+// A thread pool where every worker has its own deque of tasks instead of all of them contending
+// on `task_queue_lock_`. Tasks added by a worker go to its own deque and are processed in LIFO
+// order, idle workers steal the oldest tasks from the others. Tasks added by other threads are
+// handed to the workers through lock-free per-worker inboxes, either in a round-robin fashion or
+// as per an affinity hint. `task_queue_lock_` is only taken to put workers to sleep, to wake
+// them up and for overflowing deques.
+//
+// There is no ordering guarantee between tasks, so this is not a drop-in replacement for pools
+// relying on the FIFO order of `ThreadPool`.
+class WorkStealingThreadPool : public ThreadPool {
+ public:
+  WorkStealingThreadPool(const char* name,
+                         size_t num_threads,
+                         bool create_peers = false,
+                         size_t worker_stack_size = ThreadPoolWorker::kDefaultStackSize);
+  ~WorkStealingThreadPool();
+
+  void AddTask(Thread* self, Task* task) override REQUIRES(!task_queue_lock_);
+
+  // Add a task preferably processed by the worker at index `worker_hint` (modulo the number of
+  // workers). Other workers may still steal it if they run out of work.
+  void AddTask(Thread* self, Task* task, size_t worker_hint) REQUIRES(!task_queue_lock_);
+
+  void StartWorkers(Thread* self) override REQUIRES(!task_queue_lock_);
+  void StopWorkers(Thread* self) override REQUIRES(!task_queue_lock_);
+  void SetMaxActiveWorkers(size_t threads) override REQUIRES(!task_queue_lock_);
+
+ protected:
+  Task* GetTask(Thread* self) override REQUIRES(!task_queue_lock_);
+  Task* DequeueTaskLocked() override REQUIRES(task_queue_lock_);
+  size_t QueuedTaskCountLocked() const override REQUIRES(task_queue_lock_);
+  void ClearQueuedTasksLocked() override REQUIRES(task_queue_lock_);
+
+ private:
+  static constexpr size_t kNotAWorker = static_cast<size_t>(-1);
+
+  struct InboxNode {
+    Task* task;
+    InboxNode* next;
+  };
+
+  struct alignas(64) WorkerQueues {
+    WorkStealingDeque deque;
+    // Treiber stack of tasks added by other threads. It's only ever emptied as a whole, which
+    // avoids the ABA problem.
+    std::atomic<InboxNode*> inbox{nullptr};
+  };
+
+  // Returns the index of `self` among the workers of this pool, or kNotAWorker.
+  size_t GetWorkerIndex(Thread* self) const;
+
+  void PushToInbox(Thread* self, size_t index, Task* task) REQUIRES(!task_queue_lock_);
+  void PushToDeque(Thread* self, size_t index, Task* task) REQUIRES(!task_queue_lock_);
+  // Count a newly queued task and wake up a sleeping worker, if any.
+  void NotifyTaskQueued(Thread* self) REQUIRES(!task_queue_lock_);
+
+  // Take a task from the worker's own deque or inbox, or steal one from the others.
+  Task* FindTask(Thread* self, size_t index) REQUIRES(!task_queue_lock_);
+  // Steal a task from any worker but `thief`. If a whole inbox is taken, the remaining tasks
+  // are moved to the deque of `thief`, or to `tasks_` when that deque is full.
+  Task* StealTask(Thread* self, size_t thief) REQUIRES(!task_queue_lock_);
+  // Same as above for threads that aren't workers, the remaining tasks are moved to `tasks_`.
+  Task* StealTaskLocked() REQUIRES(task_queue_lock_);
+  // Steal a task from any worker but `thief`, starting with the worker at index `start`. The
+  // remaining tasks of a taken inbox are returned in `rest`, oldest first.
+  Task* StealFromOthers(size_t thief, size_t start, std::vector<Task*>* rest);
+  // Returns the first task of a detached inbox and frees its nodes. The other tasks are returned
+  // in `rest`, oldest first.
+  static Task* TakeInbox(InboxNode* head, std::vector<Task*>* rest);
+
+  const size_t num_queues_;
+  std::unique_ptr<WorkerQueues[]> queues_;
+  // Number of tasks in deques and inboxes.
+  std::atomic<size_t> num_queued_;
+  // Number of workers about to wait, or waiting, on `task_queue_condition_`.
+  std::atomic<size_t> num_sleeping_;
+  // Mirrors of `started_` and `max_active_workers_` for the lock-free paths.
+  std::atomic<bool> accepting_tasks_;
+  std::atomic<size_t> num_active_workers_;
+  // Used to spread tasks added by other threads over the workers.
+  std::atomic<size_t> next_inbox_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingThreadPool);
+};
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_THREAD_POOL_H_
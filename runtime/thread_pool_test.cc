@@ -17,9 +17,13 @@
 #include "thread_pool.h"
 
 #include <string>
+#include <vector>
 
+#include "barrier.h"
 #include "base/atomic.h"
+#include "base/time_utils.h"
 #include "common_runtime_test.h"
+#include "jit/jit.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread-inl.h"
 
@@ -211,4 +215,211 @@ TEST_F(ThreadPoolTest, PeerTest) {
   }
 }
 
+class RecordOrderTask : public Task {
+ public:
+  RecordOrderTask(std::vector<int>* order, int id) : order_(order), id_(id) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) override {
+    // Only used with a single worker, so no synchronization is needed.
+    order_->push_back(id_);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  std::vector<int>* const order_;
+  const int id_;
+};
+
+// Test that the JIT thread pool processes tasks by kind rather than in FIFO order.
+TEST_F(ThreadPoolTest, JitThreadPoolOrder) {
+  Thread* self = Thread::Current();
+  std::vector<int> order;
+  {
+    jit::JitThreadPool thread_pool("Jit thread pool test thread pool", 1, false);
+    thread_pool.AddTask(self, new RecordOrderTask(&order, 5), CompilationKind::kOptimized, false);
+    thread_pool.AddTask(self, new RecordOrderTask(&order, 3), CompilationKind::kBaseline, false);
+    thread_pool.AddTask(self, new RecordOrderTask(&order, 1), CompilationKind::kOsr, false);
+    thread_pool.AddTask(self, new RecordOrderTask(&order, 0));
+    thread_pool.AddTask(self, new RecordOrderTask(&order, 4), CompilationKind::kOptimized, true);
+    thread_pool.AddTask(self, new RecordOrderTask(&order, 2), CompilationKind::kBaseline, true);
+    EXPECT_EQ(6u, thread_pool.GetTaskCount(self));
+    thread_pool.StartWorkers(self);
+    thread_pool.Wait(self, false, false);
+    EXPECT_EQ(0u, thread_pool.GetTaskCount(self));
+  }
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5}), order);
+}
+
+// Check that the work-stealing thread pool runs tasks added from outside of the pool.
+TEST_F(ThreadPoolTest, WorkStealingCheckRun) {
+  Thread* self = Thread::Current();
+  WorkStealingThreadPool thread_pool("Work stealing thread pool test thread pool", num_threads);
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 4;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    thread_pool.AddTask(self, new CountTask(&count));
+  }
+  EXPECT_EQ(static_cast<size_t>(num_tasks), thread_pool.GetTaskCount(self));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, true, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+  EXPECT_EQ(0u, thread_pool.GetTaskCount(self));
+}
+
+TEST_F(ThreadPoolTest, WorkStealingStopStart) {
+  Thread* self = Thread::Current();
+  WorkStealingThreadPool thread_pool("Work stealing thread pool test thread pool", num_threads);
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 4;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    thread_pool.AddTask(self, new CountTask(&count));
+  }
+  usleep(200);
+  // Check that no threads started prematurely.
+  EXPECT_EQ(0, count.load(std::memory_order_seq_cst));
+  thread_pool.StartWorkers(self);
+  usleep(200);
+  thread_pool.StopWorkers(self);
+  AtomicInteger bad_count(0);
+  thread_pool.AddTask(self, new CountTask(&bad_count));
+  usleep(200);
+  // Ensure that the task added after the workers were stopped doesn't get run.
+  EXPECT_EQ(0, bad_count.load(std::memory_order_seq_cst));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+  EXPECT_EQ(1, bad_count.load(std::memory_order_seq_cst));
+}
+
+// Test that tasks spawned by workers, which stay in the local deques, all get processed.
+TEST_F(ThreadPoolTest, WorkStealingRecursiveTest) {
+  Thread* self = Thread::Current();
+  WorkStealingThreadPool thread_pool("Work stealing thread pool test thread pool", num_threads);
+  AtomicInteger count(0);
+  // Deep enough for the local deques to overflow.
+  static const int depth = 12;
+  thread_pool.AddTask(self, new TreeTask(&thread_pool, &count, depth));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, true, false);
+  EXPECT_EQ((1 << depth) - 1, count.load(std::memory_order_seq_cst));
+}
+
+class RecordWorkerTask : public Task {
+ public:
+  RecordWorkerTask(std::vector<Thread*>* workers, size_t index, Barrier* barrier)
+      : workers_(workers), index_(index), barrier_(barrier) {}
+
+  void Run(Thread* self) override {
+    // Each task writes its own slot.
+    (*workers_)[index_] = self;
+    // Keep the worker busy until every task has started, so that it cannot steal the tasks
+    // meant for the other workers.
+    barrier_->Wait(self);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  std::vector<Thread*>* const workers_;
+  const size_t index_;
+  Barrier* const barrier_;
+};
+
+// Test that tasks with an affinity hint run on the requested worker when it is not busy.
+// The pool is re-created at the same address, which must not confuse the worker indices.
+TEST_F(ThreadPoolTest, WorkStealingAffinity) {
+  Thread* self = Thread::Current();
+  for (size_t round = 0; round != 3u; ++round) {
+    WorkStealingThreadPool thread_pool("Work stealing thread pool test thread pool", num_threads);
+    std::vector<Thread*> workers(num_threads, nullptr);
+    Barrier barrier(num_threads);
+    for (int32_t i = 0; i < num_threads; ++i) {
+      thread_pool.AddTask(self, new RecordWorkerTask(&workers, i, &barrier), i);
+    }
+    thread_pool.StartWorkers(self);
+    thread_pool.Wait(self, false, false);
+    const std::vector<ThreadPoolWorker*>& pool_workers = thread_pool.GetWorkers();
+    for (int32_t i = 0; i < num_threads; ++i) {
+      EXPECT_EQ(pool_workers[i]->GetThread(), workers[i]);
+      EXPECT_EQ(static_cast<size_t>(i), pool_workers[i]->GetIndex());
+    }
+  }
+  EXPECT_TRUE(ThreadPoolWorker::Current() == nullptr);
+}
+
+class SpinTask : public Task {
+ public:
+  explicit SpinTask(AtomicInteger* count) : count_(count) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) override {
+    // Short tasks, so that the cost of handing them out dominates.
+    ++*count_;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  AtomicInteger* const count_;
+};
+
+class SpawnTask : public Task {
+ public:
+  SpawnTask(ThreadPool* thread_pool, AtomicInteger* count, int32_t num_children)
+      : thread_pool_(thread_pool), count_(count), num_children_(num_children) {}
+
+  void Run(Thread* self) override {
+    for (int32_t i = 0; i < num_children_; ++i) {
+      thread_pool_->AddTask(self, new SpinTask(count_));
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  ThreadPool* const thread_pool_;
+  AtomicInteger* const count_;
+  const int32_t num_children_;
+};
+
+template <typename Pool>
+static uint64_t TimeContendedTasks(size_t workers, int32_t num_spawners, int32_t num_children) {
+  Thread* self = Thread::Current();
+  Pool thread_pool("Thread pool contention test thread pool", workers);
+  AtomicInteger count(0);
+  for (int32_t i = 0; i < num_spawners; ++i) {
+    thread_pool.AddTask(self, new SpawnTask(&thread_pool, &count, num_children));
+  }
+  const uint64_t start = NanoTime();
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+  const uint64_t duration = NanoTime() - start;
+  EXPECT_EQ(num_spawners * num_children, count.load(std::memory_order_seq_cst));
+  return duration;
+}
+
+// Microbenchmark for the contention on the task queue: many small tasks added and processed
+// by the workers themselves, as done by the GC. Sized to run with the other tests, the timings
+// are only logged.
+TEST_F(ThreadPoolTest, ContentionBenchmark) {
+  static constexpr int32_t kNumSpawners = 64;
+  static constexpr int32_t kNumChildren = 100;
+  for (size_t workers : {1u, 4u, 16u}) {
+    uint64_t locked_ns = TimeContendedTasks<ThreadPool>(workers, kNumSpawners, kNumChildren);
+    uint64_t stealing_ns =
+        TimeContendedTasks<WorkStealingThreadPool>(workers, kNumSpawners, kNumChildren);
+    LOG(INFO) << "Workers: " << workers
+              << " ThreadPool: " << PrettyDuration(locked_ns)
+              << " WorkStealingThreadPool: " << PrettyDuration(stealing_ns);
+  }
+}
+
 }  // namespace art
@@ -23,6 +23,7 @@
 #include "android-base/stringprintf.h"
 
 #include "art_method-inl.h"
+#include "barrier.h"
 #include "base/casts.h"
 #include "base/enums.h"
 #include "base/os.h"
@@ -73,7 +74,7 @@ TraceClockSource Trace::default_clock_source_ = kDefaultTraceClockSource;
 
 Trace* volatile Trace::the_trace_ = nullptr;
 pthread_t Trace::sampling_pthread_ = 0U;
-std::unique_ptr<std::vector<ArtMethod*>> Trace::temp_stack_trace_;
+std::atomic<std::vector<ArtMethod*>*> Trace::temp_stack_trace_(nullptr);
 
 // The key identifying the tracer to update instrumentation.
 static constexpr const char* kTracerInstrumentationKey = "Tracer";
@@ -224,13 +225,16 @@ uint32_t Trace::EncodeTraceMethod(ArtMethod* method) {
 }
 
 std::vector<ArtMethod*>* Trace::AllocStackTrace() {
-  return (temp_stack_trace_.get() != nullptr)  ? temp_stack_trace_.release() :
-      new std::vector<ArtMethod*>();
+  // Samples are taken concurrently by the threads running the sampling checkpoint, so
+  // the cached stack trace is exchanged atomically.
+  std::vector<ArtMethod*>* stack_trace =
+      temp_stack_trace_.exchange(nullptr, std::memory_order_acquire);
+  return (stack_trace != nullptr) ? stack_trace : new std::vector<ArtMethod*>();
 }
 
 void Trace::FreeStackTrace(std::vector<ArtMethod*>* stack_trace) {
   stack_trace->clear();
-  temp_stack_trace_.reset(stack_trace);
+  delete temp_stack_trace_.exchange(stack_trace, std::memory_order_acq_rel);
 }
 
 void Trace::SetDefaultClockSource(TraceClockSource clock_source) {
@@ -336,6 +340,38 @@ static void GetSample(Thread* thread, void* arg) REQUIRES_SHARED(Locks::mutator_
   the_trace->CompareAndUpdateStackTrace(thread, stack_trace);
 }
 
+// Checkpoint taking a stack trace sample of each thread. Running threads sample themselves at
+// their next suspend point, and the sampling thread samples the threads that are already
+// suspended, so that sampling does not need to suspend all threads.
+class SampleCheckpoint final : public Closure {
+ public:
+  explicit SampleCheckpoint(Trace* trace) : barrier_(0), trace_(trace) {}
+
+  void Run(Thread* thread) override {
+    // Note thread and self may not be equal if thread was already suspended at
+    // the point of the request.
+    Thread* self = Thread::Current();
+    {
+      ScopedObjectAccess soa(self);
+      GetSample(thread, trace_);
+    }
+    barrier_.Pass(self);
+  }
+
+  void WaitForThreadsToRunThroughCheckpoint(size_t threads_running_checkpoint) {
+    Thread* self = Thread::Current();
+    ScopedThreadStateChange tsc(self, ThreadState::kWaitingForCheckPointsToRun);
+    barrier_.Increment(self, threads_running_checkpoint);
+  }
+
+ private:
+  // The barrier to be passed through and for the requestor to wait upon.
+  Barrier barrier_;
+  Trace* const trace_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleCheckpoint);
+};
+
 static void ClearThreadStackTraceAndClockBase(Thread* thread, void* arg ATTRIBUTE_UNUSED) {
   thread->SetTraceClockBase(0);
   std::vector<ArtMethod*>* stack_trace = thread->GetStackTraceSample();
@@ -345,7 +381,9 @@ static void ClearThreadStackTraceAndClockBase(Thread* thread, void* arg ATTRIBUT
 
 void Trace::CompareAndUpdateStackTrace(Thread* thread,
                                        std::vector<ArtMethod*>* stack_trace) {
-  CHECK_EQ(pthread_self(), sampling_pthread_);
+  // Either the sampled thread itself or the sampling thread on behalf of a suspended thread
+  // updates the sample, never both at the same time.
+  DCHECK(thread == Thread::Current() || pthread_self() == sampling_pthread_);
   std::vector<ArtMethod*>* old_stack_trace = thread->GetStackTraceSample();
   // Update the thread's stack trace sample.
   thread->SetStackTraceSample(stack_trace);
@@ -407,9 +445,14 @@ void* Trace::RunSamplingThread(void* arg) {
       gc::ScopedGCCriticalSection gcs(self,
                                       art::gc::kGcCauseInstrumentation,
                                       art::gc::kCollectorTypeInstrumentation);
-      ScopedSuspendAll ssa(__FUNCTION__);
-      MutexLock mu(self, *Locks::thread_list_lock_);
-      runtime->GetThreadList()->ForEach(GetSample, the_trace);
+      // Sample the threads through a checkpoint rather than suspending all threads on every
+      // tick. Wait for all threads to have been sampled so that a thread's sample is never
+      // updated by two ticks at the same time.
+      SampleCheckpoint checkpoint(the_trace);
+      size_t threads_running_checkpoint = runtime->GetThreadList()->RunCheckpoint(&checkpoint);
+      if (threads_running_checkpoint != 0) {
+        checkpoint.WaitForThreadsToRunThroughCheckpoint(threads_running_checkpoint);
+      }
     }
   }
 
@@ -1210,9 +1253,8 @@ void Trace::LogMethodTraceEvent(Thread* thread,
                                 TraceAction action,
                                 uint32_t thread_clock_diff,
                                 uint64_t timestamp_counter) {
-  // This method is called in both tracing modes (method and sampling). In sampling mode, this
-  // method is only called by the sampling thread. In method tracing mode, it can be called
-  // concurrently.
+  // This method is called in both tracing modes (method and sampling). In both modes, it can be
+  // called concurrently: in sampling mode, each thread records the events of its own samples.
 
   // Ensure we always use the non-obsolete version of the method so that entry/exit events have the
   // same pointer value.
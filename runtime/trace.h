@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_TRACE_H_
 #define ART_RUNTIME_TRACE_H_
 
+#include <atomic>
 #include <bitset>
 #include <map>
 #include <memory>
@@ -340,7 +341,7 @@ class Trace final : public instrumentation::InstrumentationListener {
   static pthread_t sampling_pthread_;
 
   // Used to remember an unused stack trace to avoid re-allocation during sampling.
-  static std::unique_ptr<std::vector<ArtMethod*>> temp_stack_trace_;
+  static std::atomic<std::vector<ArtMethod*>*> temp_stack_trace_;
 
   // File to write trace data out to, null if direct to ddms.
   std::unique_ptr<File> trace_file_;
@@ -384,9 +385,9 @@ class Trace final : public instrumentation::InstrumentationListener {
   // so cur_offset_ can move forwards and backwards.
   //
   // When not in streaming mode, the buf_ writes can come from
-  // multiple threads when the trace mode is kMethodTracing. When
-  // trace mode is kSampling, writes only come from the sampling
-  // thread.
+  // multiple threads: in kMethodTracing mode from the traced
+  // threads, in kSampling mode from the threads running the
+  // sampling checkpoint.
   //
   // Reads to the buffer happen after the event sources writing to the
   // buffer have been shutdown and all stores have completed. The
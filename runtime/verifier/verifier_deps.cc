@@ -63,14 +63,30 @@ void VerifierDeps::MergeWith(std::unique_ptr<VerifierDeps> other,
   for (const DexFile* dex_file : dex_files) {
     DexFileDeps* my_deps = GetDexFileDeps(*dex_file);
     DexFileDeps& other_deps = *other->GetDexFileDeps(*dex_file);
-    // We currently collect extra strings only on the main `VerifierDeps`,
-    // which should be the one passed as `this` in this method.
-    DCHECK(other_deps.strings_.empty());
     // Size is the number of class definitions in the dex file, and must be the
     // same between the two `VerifierDeps`.
     DCHECK_EQ(my_deps->assignable_types_.size(), other_deps.assignable_types_.size());
-    for (uint32_t i = 0; i < my_deps->assignable_types_.size(); ++i) {
-      my_deps->assignable_types_[i].merge(other_deps.assignable_types_[i]);
+    if (other_deps.strings_.empty()) {
+      // The compiler collects extra strings only on the main `VerifierDeps`,
+      // which should be the one passed as `this` in this method.
+      for (uint32_t i = 0; i < my_deps->assignable_types_.size(); ++i) {
+        my_deps->assignable_types_[i].merge(other_deps.assignable_types_[i]);
+      }
+    } else {
+      // Outside of the compiler, each `VerifierDeps` collects its own extra strings,
+      // see GetMainVerifierDeps(). Give them ids in this `VerifierDeps`.
+      DCHECK(!Runtime::Current()->IsAotCompiler());
+      auto remap = [&](dex::StringIndex id) {
+        return (id.index_ < dex_file->NumStringIds())
+            ? id
+            : GetIdFromString(*dex_file, other->GetStringFromId(*dex_file, id));
+      };
+      for (uint32_t i = 0; i < my_deps->assignable_types_.size(); ++i) {
+        for (const TypeAssignability& entry : other_deps.assignable_types_[i]) {
+          my_deps->assignable_types_[i].emplace(remap(entry.GetDestination()),
+                                                remap(entry.GetSource()));
+        }
+      }
     }
     BitVectorOr(my_deps->verified_classes_, other_deps.verified_classes_);
   }
@@ -546,11 +562,19 @@ bool VerifierDeps::DecodeDexFileDeps(DexFileDeps& deps,
 }
 
 bool VerifierDeps::ParseStoredData(const std::vector<const DexFile*>& dex_files,
-                                   ArrayRef<const uint8_t> data) {
+                                   ArrayRef<const uint8_t> data,
+                                   const std::vector<bool>* dex_files_to_parse) {
+  DCHECK(dex_files_to_parse == nullptr || dex_files_to_parse->size() == dex_files.size());
+  auto should_parse = [dex_files_to_parse](uint32_t dex_file_index) {
+    return dex_files_to_parse == nullptr || (*dex_files_to_parse)[dex_file_index];
+  };
   if (data.empty()) {
     // Return eagerly, as the first thing we expect from VerifierDeps data is
     // the number of created strings, even if there is no dependency.
     // Currently, only the boot image does not have any VerifierDeps data.
+    for (uint32_t i = 0; i != dex_files.size(); ++i) {
+      GetDexFileDeps(*dex_files[i])->from_stored_data_ = should_parse(i);
+    }
     return true;
   }
   const uint8_t* data_start = data.data();
@@ -558,6 +582,10 @@ bool VerifierDeps::ParseStoredData(const std::vector<const DexFile*>& dex_files,
   const uint8_t* cursor = data_start;
   uint32_t dex_file_index = 0;
   for (const DexFile* dex_file : dex_files) {
+    if (!should_parse(dex_file_index)) {
+      ++dex_file_index;
+      continue;
+    }
     DexFileDeps* deps = GetDexFileDeps(*dex_file);
     // Fetch the offset of this dex file's verifier data.
     cursor = data_start + reinterpret_cast<const uint32_t*>(data_start)[dex_file_index++];
@@ -567,6 +595,7 @@ bool VerifierDeps::ParseStoredData(const std::vector<const DexFile*>& dex_files,
       LOG(ERROR) << "Failed to parse dex file dependencies for " << dex_file->GetLocation();
       return false;
     }
+    deps->from_stored_data_ = true;
   }
   // TODO: We should check that `data_start == data_end`. Why are we passing excessive data?
   return true;
@@ -67,7 +67,11 @@ class VerifierDeps {
   static uint32_t constexpr kNotVerifiedMarker = std::numeric_limits<uint32_t>::max();
 
   // Fill dependencies from stored data. Returns true on success, false on failure.
-  bool ParseStoredData(const std::vector<const DexFile*>& dex_files, ArrayRef<const uint8_t> data);
+  // If `dex_files_to_parse` is not null, the data of the dex files it does not mark is skipped,
+  // and these dex files are left without dependencies and verified classes.
+  bool ParseStoredData(const std::vector<const DexFile*>& dex_files,
+                       ArrayRef<const uint8_t> data,
+                       const std::vector<bool>* dex_files_to_parse = nullptr);
 
   // Merge `other` into this `VerifierDeps`'. `other` and `this` must be for the
   // same set of dex files.
@@ -137,6 +141,12 @@ class VerifierDeps {
     return GetDexFileDeps(dex_file) != nullptr;
   }
 
+  // Whether the dependencies of `dex_file` come from ParseStoredData(), and can be
+  // validated instead of verifying the dex file again.
+  bool HasStoredData(const DexFile& dex_file) const {
+    return GetDexFileDeps(dex_file)->from_stored_data_;
+  }
+
   // Resets the data related to the given dex files.
   void ClearData(const std::vector<const DexFile*>& dex_files);
 
@@ -179,6 +189,9 @@ class VerifierDeps {
     // class was successfully verified.
     std::vector<bool> verified_classes_;
 
+    // Whether the above were read by ParseStoredData().
+    bool from_stored_data_ = false;
+
     bool Equals(const DexFileDeps& rhs) const;
   };
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+    private static final int NUM_MUTATORS = 4;
+    private static final int TREES_PER_MUTATOR = 16;
+    // Each tree has 2^TREE_DEPTH - 1 nodes, so that the mark stack gets big
+    // enough to be processed by the GC's thread pool.
+    private static final int TREE_DEPTH = 13;
+    private static final int GC_ROUNDS = 10;
+
+    static class Node {
+        Node left;
+        Node right;
+        Object payload;
+
+        Node(Node left, Node right) {
+            this.left = left;
+            this.right = right;
+            this.payload = new int[1];
+        }
+    }
+
+    private static volatile boolean done;
+
+    private static Node buildTree(int depth) {
+        if (depth == 0) {
+            return null;
+        }
+        return new Node(buildTree(depth - 1), buildTree(depth - 1));
+    }
+
+    private static int countNodes(Node node) {
+        if (node == null) {
+            return 0;
+        }
+        if (!(node.payload instanceof int[])) {
+            throw new Error("Unexpected payload " + node.payload);
+        }
+        return 1 + countNodes(node.left) + countNodes(node.right);
+    }
+
+    // Replaces a subtree of the given tree with a new one of the same size, so
+    // that the collections race with old objects being made to refer new ones.
+    private static void replaceSubtree(Node tree, int round) {
+        int depth = 1 + round % (TREE_DEPTH - 2);
+        Node parent = tree;
+        for (int level = 1; level < depth; ++level) {
+            parent = ((round >> level) & 1) == 0 ? parent.left : parent.right;
+        }
+        if ((round & 1) == 0) {
+            parent.left = buildTree(TREE_DEPTH - depth);
+        } else {
+            parent.right = buildTree(TREE_DEPTH - depth);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        final Node[][] forests = new Node[NUM_MUTATORS][TREES_PER_MUTATOR];
+        Thread[] mutators = new Thread[NUM_MUTATORS];
+        for (int i = 0; i < NUM_MUTATORS; ++i) {
+            final Node[] forest = forests[i];
+            for (int j = 0; j < TREES_PER_MUTATOR; ++j) {
+                forest[j] = buildTree(TREE_DEPTH);
+            }
+            mutators[i] = new Thread(() -> {
+                for (int round = 0; !done; ++round) {
+                    replaceSubtree(forest[round % TREES_PER_MUTATOR], round);
+                }
+            });
+        }
+        for (Thread mutator : mutators) {
+            mutator.start();
+        }
+        for (int round = 0; round < GC_ROUNDS; ++round) {
+            Runtime.getRuntime().gc();
+        }
+        done = true;
+        for (Thread mutator : mutators) {
+            mutator.join();
+        }
+        Runtime.getRuntime().gc();
+
+        final int expectedNodes = (1 << TREE_DEPTH) - 1;
+        for (Node[] forest : forests) {
+            for (Node tree : forest) {
+                int nodes = countNodes(tree);
+                if (nodes != expectedNodes) {
+                    throw new Error("Expected " + expectedNodes + " nodes, found " + nodes);
+                }
+            }
+        }
+        System.out.println("passed");
+    }
+}
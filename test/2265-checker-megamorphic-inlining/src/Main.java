@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+abstract class Base {
+  abstract int value();
+}
+
+class Cold1 extends Base { int value() { return 11; } }
+class Cold2 extends Base { int value() { return 12; } }
+class Cold3 extends Base { int value() { return 13; } }
+class Cold4 extends Base { int value() { return 14; } }
+class Cold5 extends Base { int value() { return 15; } }
+class Cold6 extends Base { int value() { return 16; } }
+class Hot1 extends Base { int value() { return 101; } }
+class Hot2 extends Base { int value() { return 102; } }
+
+public class Main {
+
+  // The call site is megamorphic and its first receiver types are the cold ones. The two
+  // types with the most calls are inlined, and the invoke is kept for all other types.
+
+  /// CHECK-START: int Main.$noinline$value(Base) inliner (before)
+  /// CHECK:       InvokeVirtual method_name:Base.value
+
+  /// CHECK-START: int Main.$noinline$value(Base) inliner (after)
+  /// CHECK-DAG:   IntConstant 101
+  /// CHECK-DAG:   IntConstant 102
+  /// CHECK-DAG:   InvokeVirtual method_name:Base.value
+
+  /// CHECK-START: int Main.$noinline$value(Base) inliner (after)
+  /// CHECK-NOT:   Deoptimize
+
+  /// CHECK-START: int Main.$noinline$value(Base) inliner (after)
+  /// CHECK-NOT:   IntConstant 11
+  /// CHECK-NOT:   IntConstant 12
+  /// CHECK-NOT:   IntConstant 13
+  /// CHECK-NOT:   IntConstant 14
+
+  public static int $noinline$value(Base b) {
+    return b.value();
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    Base[] cold = {
+        new Cold1(), new Cold2(), new Cold3(), new Cold4(), new Cold5(), new Cold6() };
+    Base[] hot = { new Hot1(), new Hot2() };
+
+    ensureJitBaselineCompiled(Main.class, "$noinline$value");
+    // Fill the inline cache with the cold types first.
+    for (Base b : cold) {
+      $noinline$value(b);
+    }
+    // Then make 90% of the calls to the hot types.
+    for (int i = 0; i < 100000; ++i) {
+      Base b = (i % 10 == 0) ? cold[(i / 10) % cold.length] : hot[i & 1];
+      $noinline$value(b);
+    }
+    ensureJitCompiled(Main.class, "$noinline$value");
+
+    assertEquals(11, $noinline$value(cold[0]));
+    assertEquals(16, $noinline$value(cold[5]));
+    assertEquals(101, $noinline$value(hot[0]));
+    assertEquals(102, $noinline$value(hot[1]));
+    System.out.println("Passed");
+  }
+
+  private static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected + ", got " + actual);
+    }
+  }
+
+  private static native void ensureJitBaselineCompiled(Class<?> itf, String method_name);
+  private static native void ensureJitCompiled(Class<?> itf, String method_name);
+}
@@ -0,0 +1,30 @@
+# Copyright (C) 2026 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+def run(ctx, args):
+  # Only verify the app, so that the persisted methods need the JIT.
+  ctx.default_run(
+      args,
+      jit=True,
+      runtime_option=["-Xjitpersistmethods:true"],
+      Xcompiler_option=["--compiler-filter=verify"])
+  # Pass another argument to let the test know it should now expect the methods
+  # persisted by the first run to be compiled.
+  ctx.default_run(
+      args,
+      jit=True,
+      runtime_option=["-Xjitpersistmethods:true"],
+      Xcompiler_option=["--compiler-filter=verify"],
+      test_args=["--second-run"])
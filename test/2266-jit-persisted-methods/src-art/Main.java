@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import dalvik.system.VMRuntime;
+import java.io.File;
+
+public class Main {
+  public static void main(String[] args) throws Exception {
+    System.loadLibrary(args[0]);
+
+    String instructionSet = VMRuntime.getCurrentInstructionSet();
+    File methods =
+        new File(DEX_LOCATION + "/" + instructionSet + "/2266-jit-persisted-methods.jit.prof");
+
+    if (args.length == 2 && "--second-run".equals(args[1])) {
+      if (!methods.exists()) {
+        throw new Error("Expected the first run to persist its compiled methods");
+      }
+      // The method was never called by this process, so it can only get compiled
+      // because the first run persisted it.
+      while (!hasJitCompiledCode(Main.class, "$noinline$compute")) {
+        Thread.sleep(10);
+      }
+      if (sum != 0) {
+        throw new Error("Expected $noinline$compute to not be called");
+      }
+      return;
+    }
+
+    // Remove the methods persisted by a previous invocation of the test.
+    methods.delete();
+
+    for (int i = 0; i < 100; ++i) {
+      $noinline$compute(i);
+    }
+    ensureJitCompiled(Main.class, "$noinline$compute");
+
+    // The methods are persisted at startup completion.
+    VMRuntime.getRuntime().notifyStartupCompleted();
+    while (!methods.exists()) {
+      Thread.sleep(10);
+    }
+  }
+
+  public static void $noinline$compute(int value) {
+    sum += value * 31;
+  }
+
+  private static int sum;
+
+  private static final String DEX_LOCATION = System.getenv("DEX_LOCATION");
+
+  private static native boolean hasJitCompiledCode(Class<?> cls, String methodName);
+  private static native void ensureJitCompiled(Class<?> cls, String methodName);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for loops vectorized with 256-bit YMM registers on AVX2 capable x86-64 CPUs.
+ */
+public class Main {
+
+  static final int N = 100;
+
+  /// CHECK-START-X86_64: void Main.add(int[], int[]) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("avx2")
+  ///   CHECK-DAG: VecLoad  loop:<<Loop:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecAdd   loop:<<Loop>>      outer_loop:none
+  ///   CHECK-DAG: VecStore loop:<<Loop>>      outer_loop:none
+  /// CHECK-FI:
+  //
+  /// CHECK-START-X86_64: void Main.add(int[], int[]) disassembly (after)
+  /// CHECK-IF: hasIsaFeature("avx2")
+  //
+  //    The loop uses 256-bit vectors, and the upper halves are cleared before returning.
+  ///   CHECK:      VecLoad
+  ///   CHECK:      vmovdq{{[au]}} ymm{{\d+}}, [{{[^\]]+}}]
+  ///   CHECK:      VecAdd
+  ///   CHECK-NEXT: vpaddd ymm{{\d+}}, ymm{{\d+}}, ymm{{\d+}}
+  ///   CHECK:      VecStore
+  ///   CHECK-NEXT: vmovdq{{[au]}} [{{[^\]]+}}], ymm{{\d+}}
+  ///   CHECK:      ReturnVoid
+  ///   CHECK:      vzeroupper
+  ///   CHECK-NEXT: ret
+  //
+  /// CHECK-ELSE:
+  ///   CHECK-NOT:  ymm
+  ///   CHECK-NOT:  vzeroupper
+  //
+  /// CHECK-FI:
+  static void add(int[] a, int[] b) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] += b[i];
+    }
+  }
+
+  /// CHECK-START-X86_64: int Main.sum(int[]) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("avx2")
+  ///   CHECK-DAG: VecAdd    loop:<<Loop:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecReduce loop:none
+  /// CHECK-FI:
+  //
+  /// CHECK-START-X86_64: int Main.sum(int[]) disassembly (after)
+  /// CHECK-IF: hasIsaFeature("avx2")
+  //
+  //    The upper half of the accumulator is folded first. The suspend check slow path saves
+  //    and restores all 256 bits of the live accumulator.
+  ///   CHECK:      VecReduce
+  ///   CHECK:      vextracti128 xmm{{\d+}}, ymm{{\d+}}, 1
+  ///   CHECK:      vzeroupper
+  ///   CHECK-NEXT: ret
+  ///   CHECK:      SuspendCheckSlowPathX86_64
+  ///   CHECK:      vmovups [rsp{{( \+ \d+)?}}], ymm{{\d+}}
+  ///   CHECK:      vmovups ymm{{\d+}}, [rsp{{( \+ \d+)?}}]
+  //
+  /// CHECK-FI:
+  static int sum(int[] a) {
+    int s = 0;
+    for (int i = 0; i < a.length; i++) {
+      s += a[i];
+    }
+    return s;
+  }
+
+  // More vectors are live in the loop than there are YMM registers, so some are spilled to and
+  // reloaded from 256-bit stack slots.
+  //
+  /// CHECK-START-X86_64: int Main.spill(int[], int[], int[], int[]) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("avx2")
+  ///   CHECK-DAG: VecAdd    loop:<<Loop:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecReduce loop:none
+  /// CHECK-FI:
+  //
+  /// CHECK-START-X86_64: int Main.spill(int[], int[], int[], int[]) disassembly (after)
+  /// CHECK-IF: hasIsaFeature("avx2")
+  ///   CHECK:      ParallelMove
+  ///   CHECK:      vmovups [rsp{{( \+ \d+)?}}], ymm{{\d+}}
+  ///   CHECK:      ParallelMove
+  ///   CHECK:      vmovups ymm{{\d+}}, [rsp{{( \+ \d+)?}}]
+  /// CHECK-FI:
+  static int spill(int[] a, int[] b, int[] c, int[] d) {
+    int s0 = 0;
+    int s1 = 0;
+    int s2 = 0;
+    int s3 = 0;
+    int s4 = 0;
+    int s5 = 0;
+    int s6 = 0;
+    int s7 = 0;
+    int s8 = 0;
+    int s9 = 0;
+    int s10 = 0;
+    int s11 = 0;
+    int s12 = 0;
+    int s13 = 0;
+    int s14 = 0;
+    int s15 = 0;
+    int s16 = 0;
+    int s17 = 0;
+    int s18 = 0;
+    int s19 = 0;
+    for (int i = 0; i < N; i++) {
+      s0 += a[i];
+      s1 += b[i];
+      s2 += c[i];
+      s3 += d[i];
+      s4 += a[i];
+      s5 += b[i];
+      s6 += c[i];
+      s7 += d[i];
+      s8 += a[i];
+      s9 += b[i];
+      s10 += c[i];
+      s11 += d[i];
+      s12 += a[i];
+      s13 += b[i];
+      s14 += c[i];
+      s15 += d[i];
+      s16 += a[i];
+      s17 += b[i];
+      s18 += c[i];
+      s19 += d[i];
+    }
+    return s0 + s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 +
+           s10 + s11 + s12 + s13 + s14 + s15 + s16 + s17 + s18 + s19;
+  }
+
+  public static void main(String[] args) {
+    int[] a = new int[N];
+    int[] b = new int[N];
+    int[] c = new int[N];
+    int[] d = new int[N];
+    for (int i = 0; i < N; i++) {
+      a[i] = i;
+      b[i] = 2 * i;
+      c[i] = N - i;
+      d[i] = 1;
+    }
+
+    add(a, b);
+    for (int i = 0; i < N; i++) {
+      expectEquals(3 * i, a[i]);
+    }
+    // 3 * (0 + 1 + ... + 99)
+    expectEquals(14850, sum(a));
+    // 5 * (14850 + 9900 + 5050 + 100)
+    expectEquals(149500, spill(a, b, c, d));
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for loops with if-then-else bodies, which are vectorized with vector selects.
+ */
+public class Main {
+
+  static final int N = 100;
+
+  // Selecting between single instructions.
+  //
+  /// CHECK-START: void Main.select(int[]) loop_optimization (before)
+  /// CHECK-DAG: Select loop:<<Loop:B\d+>> outer_loop:none
+  //
+  /// CHECK-START-{ARM,ARM64}: void Main.select(int[]) loop_optimization (after)
+  /// CHECK-DAG: VecLoad                          loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecSelect cond:Cond{{(GT|LE)}}   loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: VecStore                         loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START-X86_64: void Main.select(int[]) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("sse4.1")
+  ///   CHECK-DAG: VecLoad                        loop:<<Loop:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecSelect cond:Cond{{(GT|LE)}} loop:<<Loop>>      outer_loop:none
+  ///   CHECK-DAG: VecStore                       loop:<<Loop>>      outer_loop:none
+  /// CHECK-FI:
+  static void select(int[] a) {
+    for (int i = 0; i < a.length; i++) {
+      int x = a[i];
+      a[i] = x > 0 ? x ^ 3 : x + 7;
+    }
+  }
+
+  // Selecting between branches of more than one instruction, which are flattened first.
+  //
+  /// CHECK-START: void Main.branches(int[], int[]) loop_optimization (before)
+  /// CHECK-NOT: Select
+  //
+  /// CHECK-START-{ARM,ARM64}: void Main.branches(int[], int[]) loop_optimization (after)
+  /// CHECK-DAG: VecLoad                          loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecSelect cond:Cond{{(LT|GE)}}   loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: VecStore                         loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START-X86_64: void Main.branches(int[], int[]) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("sse4.1")
+  ///   CHECK-DAG: VecLoad                        loop:<<Loop:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecSelect cond:Cond{{(LT|GE)}} loop:<<Loop>>      outer_loop:none
+  ///   CHECK-DAG: VecStore                       loop:<<Loop>>      outer_loop:none
+  /// CHECK-FI:
+  static void branches(int[] a, int[] b) {
+    for (int i = 0; i < a.length; i++) {
+      int x = a[i];
+      int y;
+      if (x < b[i]) {
+        y = (x << 2) + 1;
+      } else {
+        y = (x ^ 5) - 3;
+      }
+      a[i] = y;
+    }
+  }
+
+  // A conditional accumulation remains a reduction.
+  //
+  /// CHECK-START-{ARM,ARM64}: int Main.conditionalSum(int[]) loop_optimization (after)
+  /// CHECK-DAG: VecSelect loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecAdd    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: VecReduce loop:none
+  //
+  /// CHECK-START-X86_64: int Main.conditionalSum(int[]) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("sse4.1")
+  ///   CHECK-DAG: VecSelect loop:<<Loop:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecAdd    loop:<<Loop>>      outer_loop:none
+  ///   CHECK-DAG: VecReduce loop:none
+  /// CHECK-FI:
+  static int conditionalSum(int[] a) {
+    int sum = 0;
+    for (int i = 0; i < a.length; i++) {
+      if (a[i] > 0) {
+        sum += 2 * a[i] + 1;
+      }
+    }
+    return sum;
+  }
+
+  // The strided read prevents vectorization, so the if-then-else is left as is.
+  //
+  /// CHECK-START: void Main.notVectorized(int[], int[]) loop_optimization (before)
+  /// CHECK-DAG: If loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: If loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START: void Main.notVectorized(int[], int[]) loop_optimization (before)
+  /// CHECK-NOT: Select
+  //
+  /// CHECK-START: void Main.notVectorized(int[], int[]) loop_optimization (after)
+  /// CHECK-DAG: If loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: If loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START: void Main.notVectorized(int[], int[]) loop_optimization (after)
+  /// CHECK-NOT: Select
+  /// CHECK-NOT: Vec{{[A-Za-z]+}}
+  static void notVectorized(int[] a, int[] b) {
+    for (int i = 0; i < b.length; i++) {
+      int x = a[2 * i];
+      int y;
+      if (x < b[i]) {
+        y = (x << 2) + 1;
+      } else {
+        y = (x ^ 5) - 3;
+      }
+      b[i] = y;
+    }
+  }
+
+  public static void main(String[] args) {
+    int[] a = new int[N];
+    int[] b = new int[N];
+    int[] c = new int[2 * N];
+
+    init(a, b, c);
+    select(a);
+    for (int i = 0; i < N; i++) {
+      int x = i - N / 2;
+      expectEquals(x > 0 ? x ^ 3 : x + 7, a[i]);
+    }
+
+    init(a, b, c);
+    branches(a, b);
+    for (int i = 0; i < N; i++) {
+      expectEquals(branch(i - N / 2, 3 - i % 7), a[i]);
+    }
+
+    init(a, b, c);
+    // 3 + 5 + ... + 99
+    expectEquals(2499, conditionalSum(a));
+
+    init(a, b, c);
+    notVectorized(c, b);
+    for (int i = 0; i < N; i++) {
+      expectEquals(branch(2 * i, 3 - i % 7), b[i]);
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void init(int[] a, int[] b, int[] c) {
+    for (int i = 0; i < N; i++) {
+      a[i] = i - N / 2;
+      b[i] = 3 - i % 7;
+    }
+    for (int i = 0; i < 2 * N; i++) {
+      c[i] = i;
+    }
+  }
+
+  private static int branch(int x, int y) {
+    return x < y ? (x << 2) + 1 : (x ^ 5) - 3;
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
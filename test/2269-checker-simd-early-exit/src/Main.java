@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for search loops, which are vectorized by a vector loop that skips the vectors
+ * without a match in front of the original loop.
+ */
+public class Main {
+
+  // Odd, so that the original loop runs a scalar tail whatever the vector length.
+  static final int N = 101;
+
+  /// CHECK-START: int Main.indexOf(int[], int) loop_optimization (before)
+  /// CHECK-DAG: ArrayGet loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: If       loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START: int Main.indexOf(int[], int) loop_optimization (before)
+  /// CHECK-NOT: Vec{{[A-Za-z]+}}
+  //
+  /// CHECK-START-{ARM,ARM64}: int Main.indexOf(int[], int) loop_optimization (after)
+  /// CHECK-DAG: VecLoad                    loop:<<Loop1:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecCompareAny cond:CondEQ  loop:<<Loop1>>      outer_loop:none
+  /// CHECK-DAG: ArrayGet                   loop:<<Loop2:B\d+>> outer_loop:none
+  /// CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  //
+  /// CHECK-START-X86_64: int Main.indexOf(int[], int) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("sse4.1")
+  ///   CHECK-DAG: VecLoad                    loop:<<Loop1:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecCompareAny cond:CondEQ  loop:<<Loop1>>      outer_loop:none
+  ///   CHECK-DAG: ArrayGet                   loop:<<Loop2:B\d+>> outer_loop:none
+  ///   CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  /// CHECK-FI:
+  static int indexOf(int[] a, int x) {
+    for (int i = 0; i < a.length; i++) {
+      if (a[i] == x) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /// CHECK-START-{ARM,ARM64}: int Main.indexOf(char[], char) loop_optimization (after)
+  /// CHECK-DAG: VecLoad                    loop:<<Loop1:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecCompareAny cond:CondEQ  loop:<<Loop1>>      outer_loop:none
+  /// CHECK-DAG: ArrayGet                   loop:<<Loop2:B\d+>> outer_loop:none
+  /// CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  //
+  /// CHECK-START-X86_64: int Main.indexOf(char[], char) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("sse4.1")
+  ///   CHECK-DAG: VecLoad                    loop:<<Loop1:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecCompareAny cond:CondEQ  loop:<<Loop1>>      outer_loop:none
+  ///   CHECK-DAG: ArrayGet                   loop:<<Loop2:B\d+>> outer_loop:none
+  ///   CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  /// CHECK-FI:
+  static int indexOf(char[] a, char x) {
+    for (int i = 0; i < a.length; i++) {
+      if (a[i] == x) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /// CHECK-START-{ARM,ARM64}: int Main.firstAbove(int[], int) loop_optimization (after)
+  /// CHECK-DAG: VecLoad                              loop:<<Loop1:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecCompareAny cond:Cond{{(GT|LT)}}   loop:<<Loop1>>      outer_loop:none
+  /// CHECK-DAG: ArrayGet                             loop:<<Loop2:B\d+>> outer_loop:none
+  /// CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  //
+  /// CHECK-START-X86_64: int Main.firstAbove(int[], int) loop_optimization (after)
+  /// CHECK-IF: hasIsaFeature("sse4.1")
+  ///   CHECK-DAG: VecLoad                            loop:<<Loop1:B\d+>> outer_loop:none
+  ///   CHECK-DAG: VecCompareAny cond:Cond{{(GT|LT)}} loop:<<Loop1>>      outer_loop:none
+  ///   CHECK-DAG: ArrayGet                           loop:<<Loop2:B\d+>> outer_loop:none
+  ///   CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  /// CHECK-FI:
+  static int firstAbove(int[] a, int x) {
+    for (int i = 0; i < a.length; i++) {
+      if (a[i] > x) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  public static void main(String[] args) {
+    int[] a = new int[N];
+    char[] c = new char[N];
+    for (int i = 0; i < N; i++) {
+      a[i] = i;
+      c[i] = (char) ('a' + i);
+    }
+
+    // Found at index 0, in the first vector.
+    expectEquals(0, indexOf(a, 0));
+    expectEquals(0, indexOf(c, 'a'));
+    expectEquals(0, firstAbove(a, -1));
+    // Found in the last vector: 99 for vectors of 4 ints, 95 for vectors of 8 ints or more.
+    expectEquals(95, indexOf(a, 95));
+    expectEquals(99, indexOf(a, 99));
+    expectEquals(95, indexOf(c, (char) ('a' + 95)));
+    expectEquals(99, indexOf(c, (char) ('a' + 99)));
+    expectEquals(95, firstAbove(a, 94));
+    expectEquals(99, firstAbove(a, 98));
+    // Found in the scalar tail.
+    expectEquals(N - 1, indexOf(a, N - 1));
+    expectEquals(N - 1, indexOf(c, (char) ('a' + N - 1)));
+    expectEquals(N - 1, firstAbove(a, N - 2));
+    // Not found.
+    expectEquals(-1, indexOf(a, N));
+    expectEquals(-1, indexOf(a, -1));
+    expectEquals(-1, indexOf(c, 'A'));
+    expectEquals(-1, firstAbove(a, N - 1));
+
+    // Found at every index, which covers each vector whatever the vector length.
+    for (int i = 0; i < N; i++) {
+      expectEquals(i, indexOf(a, i));
+      expectEquals(i, indexOf(c, (char) ('a' + i)));
+      expectEquals(i, firstAbove(a, i - 1));
+    }
+
+    // The first of several matches is found, within a vector and across vectors.
+    for (int i = 0; i < N; i++) {
+      a[i] = i % 3;
+    }
+    expectEquals(2, indexOf(a, 2));
+    expectEquals(2, firstAbove(a, 1));
+    for (int i = 0; i < N; i++) {
+      a[i] = i / 40;
+    }
+    expectEquals(40, indexOf(a, 1));
+    expectEquals(80, firstAbove(a, 1));
+
+    // Searches of empty and short arrays only run the original loop.
+    expectEquals(-1, indexOf(new int[0], 0));
+    expectEquals(1, indexOf(new int[] { 5, 7, 9 }, 7));
+    expectEquals(-1, indexOf(new char[] { 'x' }, 'y'));
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -22,3 +22,9 @@ def run(ctx, args):
   # Set low RAM to hit the Madvise code which used to crash
   ctx.default_run(
       args, runtime_option=["-XX:LowMemoryMode"], secondary_compilation=False)
+
+  # Verify with several threads, whose results need to be merged into the vdex.
+  ctx.default_run(
+      args,
+      runtime_option=["-Xbackgroundverificationthreads:4"],
+      secondary_compilation=False)
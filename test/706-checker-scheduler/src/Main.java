@@ -140,6 +140,41 @@ public class Main {
   /// CHECK:                           ArraySet
   /// CHECK:                           ArraySet
   /// CHECK:                           ArraySet
+  /// CHECK-START-{X86,X86_64}: void Main.arrayAccessVariable(int) scheduler (before)
+  /// CHECK-DAG: <<Param:i\d+>>        ParameterValue
+  /// CHECK-DAG: <<Const1:i\d+>>       IntConstant 1
+  /// CHECK-DAG: <<Const2:i\d+>>       IntConstant 2
+  /// CHECK-DAG: <<Const3:i\d+>>       IntConstant -1
+  /// CHECK-DAG: <<Add1:i\d+>>         Add [<<Param>>,<<Const1>>]
+  /// CHECK-DAG: <<Add2:i\d+>>         Add [<<Param>>,<<Const2>>]
+  /// CHECK-DAG: <<Add3:i\d+>>         Add [<<Param>>,<<Const3>>]
+  /// CHECK-DAG: <<ArrayGet1:i\d+>>    ArrayGet [<<Array:l\d+>>,<<Add1>>]
+  /// CHECK-DAG: <<ArrayGet2:i\d+>>    ArrayGet [<<Array>>,<<Add2>>]
+  /// CHECK-DAG: <<ArrayGet3:i\d+>>    ArrayGet [<<Array>>,<<Add3>>]
+  /// CHECK-DAG: <<AddArray1:i\d+>>    Add [<<ArrayGet1>>,<<Const2>>]
+  /// CHECK-DAG: {{v\d+}}              ArraySet [<<Array>>,<<Add1>>,<<AddArray1>>]
+  /// CHECK-DAG: <<AddArray2:i\d+>>    Add [<<ArrayGet2>>,<<Const2>>]
+  /// CHECK-DAG: {{v\d+}}              ArraySet [<<Array>>,<<Add2>>,<<AddArray2>>]
+  /// CHECK-DAG: <<AddArray3:i\d+>>    Add [<<ArrayGet3>>,<<Const2>>]
+  /// CHECK-DAG: {{v\d+}}              ArraySet [<<Array>>,<<Add3>>,<<AddArray3>>]
+
+  /// CHECK-START-{X86,X86_64}: void Main.arrayAccessVariable(int) scheduler (after)
+  /// CHECK:     <<Param:i\d+>>        ParameterValue
+  /// CHECK-DAG: <<Const1:i\d+>>       IntConstant 1
+  /// CHECK-DAG: <<Const2:i\d+>>       IntConstant 2
+  /// CHECK-DAG: <<Const3:i\d+>>       IntConstant -1
+  /// CHECK:     <<Add1:i\d+>>         Add [<<Param>>,<<Const1>>]
+  /// CHECK:     <<Add2:i\d+>>         Add [<<Param>>,<<Const2>>]
+  /// CHECK:     <<Add3:i\d+>>         Add [<<Param>>,<<Const3>>]
+  /// CHECK:                           ArrayGet [{{l\d+}},{{i\d+}}]
+  /// CHECK:                           ArrayGet [{{l\d+}},{{i\d+}}]
+  /// CHECK:                           ArrayGet [{{l\d+}},{{i\d+}}]
+  /// CHECK:                           Add
+  /// CHECK:                           Add
+  /// CHECK:                           Add
+  /// CHECK:                           ArraySet
+  /// CHECK:                           ArraySet
+  /// CHECK:                           ArraySet
   public static void arrayAccessVariable(int i) {
     int [] array = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     for (int j = 0; j < 100; j++) {
@@ -587,14 +622,14 @@ public class Main {
   // Check that instructions having cross iteration dependencies are not
   // reordered.
   //
-  /// CHECK-START-{ARM,ARM64}: void Main.testCrossItersDependencies() scheduler (before)
+  /// CHECK-START-{ARM,ARM64,X86,X86_64}: void Main.testCrossItersDependencies() scheduler (before)
   /// CHECK:     <<ID1:i\d+>>  Phi [{{i\d+}},<<ID3:i\d+>>]
   /// CHECK:     <<ID2:i\d+>>  Phi [{{i\d+}},<<ID4:i\d+>>]
   //
   /// CHECK:     <<ID3>>  Sub [<<ID1>>,<<ID2>>]
   /// CHECK:     <<ID4>>  Add [<<ID2>>,{{i\d+}}]
 
-  /// CHECK-START-{ARM,ARM64}: void Main.testCrossItersDependencies() scheduler (after)
+  /// CHECK-START-{ARM,ARM64,X86,X86_64}: void Main.testCrossItersDependencies() scheduler (after)
   /// CHECK:     <<ID1:i\d+>>  Phi [{{i\d+}},<<ID3:i\d+>>]
   /// CHECK:     <<ID2:i\d+>>  Phi [{{i\d+}},<<ID4:i\d+>>]
   //
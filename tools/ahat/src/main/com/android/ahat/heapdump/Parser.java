@@ -20,11 +20,15 @@ import com.android.ahat.progress.NullProgress;
 import com.android.ahat.progress.Progress;
 import com.android.ahat.proguard.ProguardMap;
 import java.io.File;
+import java.io.FileInputStream;
 import java.io.IOException;
+import java.io.InputStream;
 import java.nio.BufferUnderflowException;
 import java.nio.ByteBuffer;
 import java.nio.channels.FileChannel;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
 import java.nio.file.StandardOpenOption;
 import java.util.ArrayList;
 import java.util.Comparator;
@@ -33,6 +37,7 @@ import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
 import java.util.Objects;
+import java.util.zip.GZIPInputStream;
 
 /**
  * Provides methods for parsing heap dumps.
@@ -70,6 +75,8 @@ public class Parser {
 
   /**
    * Creates an hprof Parser that parses a heap dump from a file.
+   * The file may be compressed with gzip, as written by the runtime for heap
+   * dumps with a .gz suffix.
    *
    * @param hprof file to parse the heap dump from.
    * @throws IOException if the file cannot be accessed.
@@ -909,11 +916,40 @@ public class Parser {
     private final ByteBuffer mBuffer;
 
     public HprofBuffer(File path) throws IOException {
+      if (isGzipped(path)) {
+        path = decompress(path);
+      }
       FileChannel channel = FileChannel.open(path.toPath(), StandardOpenOption.READ);
       mBuffer = channel.map(FileChannel.MapMode.READ_ONLY, 0, channel.size());
       channel.close();
     }
 
+    /**
+     * Returns true if the file starts with the gzip magic number.
+     */
+    private static boolean isGzipped(File path) throws IOException {
+      try (InputStream is = new FileInputStream(path)) {
+        int b0 = is.read();
+        int b1 = is.read();
+        return b0 == (GZIPInputStream.GZIP_MAGIC & 0xff)
+            && b1 == (GZIPInputStream.GZIP_MAGIC >> 8);
+      }
+    }
+
+    /**
+     * Decompresses a gzipped heap dump to a temporary file, so that it can be
+     * mapped like an uncompressed one. GZIPInputStream reads all the
+     * concatenated members of the file.
+     */
+    private static File decompress(File path) throws IOException {
+      File decompressed = File.createTempFile("ahat", ".hprof");
+      decompressed.deleteOnExit();
+      try (InputStream is = new GZIPInputStream(new FileInputStream(path))) {
+        Files.copy(is, decompressed.toPath(), StandardCopyOption.REPLACE_EXISTING);
+      }
+      return decompressed;
+    }
+
     public HprofBuffer(ByteBuffer buffer) {
       mBuffer = buffer;
     }
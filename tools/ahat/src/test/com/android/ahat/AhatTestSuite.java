@@ -31,6 +31,7 @@ import org.junit.runners.Suite;
   ObjectHandlerTest.class,
   ObjectsHandlerTest.class,
   OverviewHandlerTest.class,
+  ParserTest.class,
   PerformanceTest.class,
   ProguardMapTest.class,
   RootedHandlerTest.class,
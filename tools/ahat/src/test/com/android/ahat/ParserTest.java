@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.android.ahat;
+
+import com.android.ahat.heapdump.AhatHeap;
+import com.android.ahat.heapdump.AhatSnapshot;
+import com.android.ahat.heapdump.HprofFormatException;
+import com.android.ahat.heapdump.Parser;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.util.List;
+import java.util.zip.GZIPOutputStream;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+
+public class ParserTest {
+  private static byte[] readResource(String name) throws IOException {
+    ClassLoader loader = ParserTest.class.getClassLoader();
+    try (InputStream is = loader.getResourceAsStream(name)) {
+      ByteArrayOutputStream baos = new ByteArrayOutputStream();
+      byte[] buf = new byte[4096];
+      int read;
+      while ((read = is.read(buf)) != -1) {
+        baos.write(buf, 0, read);
+      }
+      return baos.toByteArray();
+    }
+  }
+
+  @Test
+  public void gzipCompressed() throws IOException, HprofFormatException {
+    byte[] hprof = readResource("test-dump.hprof");
+    AhatSnapshot expected = new Parser(ByteBuffer.wrap(hprof)).parse();
+
+    // The runtime compresses heap dumps in blocks, each written as a separate
+    // gzip member.
+    File gzipped = File.createTempFile("ahat-test", ".hprof.gz");
+    gzipped.deleteOnExit();
+    try (OutputStream os = new FileOutputStream(gzipped)) {
+      int split = hprof.length / 2;
+      try (GZIPOutputStream gzos = new GZIPOutputStream(new NonClosingOutputStream(os))) {
+        gzos.write(hprof, 0, split);
+      }
+      try (GZIPOutputStream gzos = new GZIPOutputStream(new NonClosingOutputStream(os))) {
+        gzos.write(hprof, split, hprof.length - split);
+      }
+    }
+    AhatSnapshot snapshot = new Parser(gzipped).parse();
+
+    List<AhatHeap> expectedHeaps = expected.getHeaps();
+    List<AhatHeap> heaps = snapshot.getHeaps();
+    assertEquals(expectedHeaps.size(), heaps.size());
+    for (int i = 0; i < heaps.size(); ++i) {
+      assertEquals(expectedHeaps.get(i).getName(), heaps.get(i).getName());
+      assertEquals(expectedHeaps.get(i).getSize().getSize(), heaps.get(i).getSize().getSize());
+    }
+    assertEquals(expected.getRooted().size(), snapshot.getRooted().size());
+  }
+
+  private static class NonClosingOutputStream extends OutputStream {
+    private final OutputStream mOut;
+
+    public NonClosingOutputStream(OutputStream out) {
+      mOut = out;
+    }
+
+    @Override
+    public void write(int b) throws IOException {
+      mOut.write(b);
+    }
+
+    @Override
+    public void write(byte[] b, int off, int len) throws IOException {
+      mOut.write(b, off, len);
+    }
+
+    @Override
+    public void close() throws IOException {
+      mOut.flush();
+    }
+  }
+}